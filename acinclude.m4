@@ -63,6 +63,12 @@ AC_DEFUN([AX_LIBEWF_CHECK_LOCAL],
 
   dnl Check for internationalization functions in libewf/libewf_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
+
+  dnl Headers included in libewf/libewf_direct_file_io_handle.c
+  AC_CHECK_HEADERS([errno.h fcntl.h unistd.h])
+
+  dnl File input/output functions used in libewf/libewf_direct_file_io_handle.c
+  AC_CHECK_FUNCS([close fallocate ftruncate lseek open posix_fadvise read write])
 ])
 
 dnl Function to detect if ewftools dependencies are available
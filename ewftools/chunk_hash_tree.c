@@ -0,0 +1,1319 @@
+/*
+ * Chunk hash tree
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "chunk_hash_tree.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcfile.h"
+#include "ewftools_libhmac.h"
+
+/* The chunk hash tree file consists of:
+ * a 32-byte header that contains:
+ *   the signature "ewfhtree"
+ *   the format version (32-bit little-endian)
+ *   the leaf size (32-bit little-endian)
+ *   the media size (64-bit little-endian)
+ *   the number of leaves (64-bit little-endian)
+ * the SHA256 hash of every leaf
+ * the SHA256 root hash
+ *
+ * A leaf hash is the SHA256 of leaf size bytes of media data, the last leaf
+ * can be smaller. A node hash is the SHA256 of the left and right child hashes,
+ * a node without a right child carries the hash of its left child.
+ */
+
+const uint8_t chunk_hash_tree_file_signature[ 8 ] = {
+	'e', 'w', 'f', 'h', 't', 'r', 'e', 'e' };
+
+/* Calculates the leaf size for a specific chunk size
+ * A leaf contains CHUNK_HASH_TREE_NUMBER_OF_CHUNKS_PER_LEAF chunks, for large chunks
+ * the number of chunks per leaf is halved until the leaf size does not exceed
+ * CHUNK_HASH_TREE_MAXIMUM_LEAF_SIZE
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_hash_tree_calculate_leaf_size(
+     size32_t chunk_size,
+     size32_t *leaf_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "chunk_hash_tree_calculate_leaf_size";
+	uint64_t chunks_per_leaf = 0;
+
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size32_t) CHUNK_HASH_TREE_MAXIMUM_LEAF_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( leaf_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid leaf size.",
+		 function );
+
+		return( -1 );
+	}
+	chunks_per_leaf = CHUNK_HASH_TREE_NUMBER_OF_CHUNKS_PER_LEAF;
+
+	while( ( chunks_per_leaf > 1 )
+	    && ( ( (uint64_t) chunk_size * chunks_per_leaf ) > (uint64_t) CHUNK_HASH_TREE_MAXIMUM_LEAF_SIZE ) )
+	{
+		chunks_per_leaf /= 2;
+	}
+	*leaf_size = (size32_t) ( (uint64_t) chunk_size * chunks_per_leaf );
+
+	return( 1 );
+}
+
+/* Creates a chunk hash tree
+ * Make sure the value chunk_hash_tree is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_hash_tree_initialize(
+     chunk_hash_tree_t **chunk_hash_tree,
+     size64_t media_size,
+     size32_t leaf_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "chunk_hash_tree_initialize";
+	uint64_t number_of_leaves = 0;
+
+	if( chunk_hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_hash_tree != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk hash tree value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( media_size == 0 )
+	 || ( media_size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( leaf_size == 0 )
+	 || ( leaf_size > (size32_t) CHUNK_HASH_TREE_MAXIMUM_LEAF_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid leaf size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_leaves = media_size / leaf_size;
+
+	if( ( media_size % leaf_size ) != 0 )
+	{
+		number_of_leaves += 1;
+	}
+	if( number_of_leaves > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / CHUNK_HASH_TREE_HASH_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of leaves value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_hash_tree = memory_allocate_structure(
+	                    chunk_hash_tree_t );
+
+	if( *chunk_hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk hash tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_hash_tree,
+	     0,
+	     sizeof( chunk_hash_tree_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk hash tree.",
+		 function );
+
+		memory_free(
+		 *chunk_hash_tree );
+
+		*chunk_hash_tree = NULL;
+
+		return( -1 );
+	}
+	( *chunk_hash_tree )->leaf_hashes = (uint8_t *) memory_allocate(
+	                                                 sizeof( uint8_t ) * (size_t) number_of_leaves * CHUNK_HASH_TREE_HASH_SIZE );
+
+	if( ( *chunk_hash_tree )->leaf_hashes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create leaf hashes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_hash_tree )->leaf_hashes,
+	     0,
+	     sizeof( uint8_t ) * (size_t) number_of_leaves * CHUNK_HASH_TREE_HASH_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear leaf hashes.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_hash_tree )->media_size       = media_size;
+	( *chunk_hash_tree )->leaf_size        = leaf_size;
+	( *chunk_hash_tree )->number_of_leaves = number_of_leaves;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_hash_tree != NULL )
+	{
+		if( ( *chunk_hash_tree )->leaf_hashes != NULL )
+		{
+			memory_free(
+			 ( *chunk_hash_tree )->leaf_hashes );
+		}
+		memory_free(
+		 *chunk_hash_tree );
+
+		*chunk_hash_tree = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk hash tree
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_hash_tree_free(
+     chunk_hash_tree_t **chunk_hash_tree,
+     libcerror_error_t **error )
+{
+	static char *function = "chunk_hash_tree_free";
+	int result            = 1;
+
+	if( chunk_hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_hash_tree != NULL )
+	{
+		if( ( *chunk_hash_tree )->sha256_context != NULL )
+		{
+			if( libhmac_sha256_free(
+			     &( ( *chunk_hash_tree )->sha256_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA256 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 ( *chunk_hash_tree )->leaf_hashes );
+
+		memory_free(
+		 *chunk_hash_tree );
+
+		*chunk_hash_tree = NULL;
+	}
+	return( result );
+}
+
+/* Updates the chunk hash tree with media data
+ * The media data must be provided in order, starting at offset 0
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_hash_tree_update(
+     chunk_hash_tree_t *chunk_hash_tree,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function   = "chunk_hash_tree_update";
+	size64_t remaining_size = 0;
+	size_t buffer_offset    = 0;
+	size_t update_size      = 0;
+	size32_t leaf_data_size = 0;
+
+	if( chunk_hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		if( chunk_hash_tree->current_leaf_index >= chunk_hash_tree->number_of_leaves )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid buffer size value exceeds media size.",
+			 function );
+
+			return( -1 );
+		}
+		remaining_size = chunk_hash_tree->media_size
+		               - ( chunk_hash_tree->current_leaf_index * chunk_hash_tree->leaf_size );
+
+		leaf_data_size = chunk_hash_tree->leaf_size;
+
+		if( remaining_size < (size64_t) leaf_data_size )
+		{
+			leaf_data_size = (size32_t) remaining_size;
+		}
+		if( chunk_hash_tree->sha256_context == NULL )
+		{
+			if( libhmac_sha256_initialize(
+			     &( chunk_hash_tree->sha256_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize SHA256 context.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		update_size = buffer_size - buffer_offset;
+
+		if( update_size > (size_t) ( leaf_data_size - chunk_hash_tree->current_leaf_data_size ) )
+		{
+			update_size = (size_t) ( leaf_data_size - chunk_hash_tree->current_leaf_data_size );
+		}
+		if( libhmac_sha256_update(
+		     chunk_hash_tree->sha256_context,
+		     &( buffer[ buffer_offset ] ),
+		     update_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 hash of leaf: %" PRIu64 ".",
+			 function,
+			 chunk_hash_tree->current_leaf_index );
+
+			return( -1 );
+		}
+		buffer_offset                           += update_size;
+		chunk_hash_tree->current_leaf_data_size += (size32_t) update_size;
+
+		if( chunk_hash_tree->current_leaf_data_size == leaf_data_size )
+		{
+			if( libhmac_sha256_finalize(
+			     chunk_hash_tree->sha256_context,
+			     &( chunk_hash_tree->leaf_hashes[ chunk_hash_tree->current_leaf_index * CHUNK_HASH_TREE_HASH_SIZE ] ),
+			     CHUNK_HASH_TREE_HASH_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to finalize SHA256 hash of leaf: %" PRIu64 ".",
+				 function,
+				 chunk_hash_tree->current_leaf_index );
+
+				return( -1 );
+			}
+			/* The SHA256 context cannot be reused after it was finalized
+			 */
+			if( libhmac_sha256_free(
+			     &( chunk_hash_tree->sha256_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA256 context.",
+				 function );
+
+				return( -1 );
+			}
+			chunk_hash_tree->current_leaf_index    += 1;
+			chunk_hash_tree->current_leaf_data_size = 0;
+		}
+	}
+	return( 1 );
+}
+
+/* Finalizes the chunk hash tree
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_hash_tree_finalize(
+     chunk_hash_tree_t *chunk_hash_tree,
+     libcerror_error_t **error )
+{
+	static char *function = "chunk_hash_tree_finalize";
+
+	if( chunk_hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_hash_tree->current_leaf_index != chunk_hash_tree->number_of_leaves )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk hash tree - missing media data of leaf: %" PRIu64 ".",
+		 function,
+		 chunk_hash_tree->current_leaf_index );
+
+		return( -1 );
+	}
+	if( chunk_hash_tree_calculate_root_hash(
+	     chunk_hash_tree,
+	     chunk_hash_tree->root_hash,
+	     CHUNK_HASH_TREE_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate root hash.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Calculates the root hash from the leaf hashes
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_hash_tree_calculate_root_hash(
+     chunk_hash_tree_t *chunk_hash_tree,
+     uint8_t *root_hash,
+     size_t root_hash_size,
+     libcerror_error_t **error )
+{
+	uint8_t *node_hashes     = NULL;
+	static char *function    = "chunk_hash_tree_calculate_root_hash";
+	uint64_t node_index      = 0;
+	uint64_t number_of_nodes = 0;
+
+	if( chunk_hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_hash_tree->leaf_hashes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk hash tree - missing leaf hashes.",
+		 function );
+
+		return( -1 );
+	}
+	if( root_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid root hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( root_hash_size < CHUNK_HASH_TREE_HASH_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid root hash size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_nodes = chunk_hash_tree->number_of_leaves;
+
+	node_hashes = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * (size_t) number_of_nodes * CHUNK_HASH_TREE_HASH_SIZE );
+
+	if( node_hashes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create node hashes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     node_hashes,
+	     chunk_hash_tree->leaf_hashes,
+	     (size_t) number_of_nodes * CHUNK_HASH_TREE_HASH_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy leaf hashes.",
+		 function );
+
+		goto on_error;
+	}
+	/* Reduce the nodes level by level, a parent node replaces its children in place
+	 */
+	while( number_of_nodes > 1 )
+	{
+		for( node_index = 0;
+		     ( node_index + 1 ) < number_of_nodes;
+		     node_index += 2 )
+		{
+			if( libhmac_sha256_calculate(
+			     &( node_hashes[ node_index * CHUNK_HASH_TREE_HASH_SIZE ] ),
+			     2 * CHUNK_HASH_TREE_HASH_SIZE,
+			     &( node_hashes[ ( node_index / 2 ) * CHUNK_HASH_TREE_HASH_SIZE ] ),
+			     CHUNK_HASH_TREE_HASH_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to calculate SHA256 hash of node.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( node_index < number_of_nodes )
+		{
+			if( memory_copy(
+			     &( node_hashes[ ( node_index / 2 ) * CHUNK_HASH_TREE_HASH_SIZE ] ),
+			     &( node_hashes[ node_index * CHUNK_HASH_TREE_HASH_SIZE ] ),
+			     CHUNK_HASH_TREE_HASH_SIZE ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy node hash.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		number_of_nodes = ( number_of_nodes + 1 ) / 2;
+	}
+	if( memory_copy(
+	     root_hash,
+	     node_hashes,
+	     CHUNK_HASH_TREE_HASH_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy root hash.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 node_hashes );
+
+	return( 1 );
+
+on_error:
+	if( node_hashes != NULL )
+	{
+		memory_free(
+		 node_hashes );
+	}
+	return( -1 );
+}
+
+/* Retrieves the media range of a specific leaf
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_hash_tree_get_leaf_range(
+     chunk_hash_tree_t *chunk_hash_tree,
+     uint64_t leaf_index,
+     off64_t *leaf_offset,
+     size32_t *leaf_data_size,
+     libcerror_error_t **error )
+{
+	static char *function   = "chunk_hash_tree_get_leaf_range";
+	size64_t remaining_size = 0;
+
+	if( chunk_hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( leaf_index >= chunk_hash_tree->number_of_leaves )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid leaf index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( leaf_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid leaf offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( leaf_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid leaf data size.",
+		 function );
+
+		return( -1 );
+	}
+	*leaf_offset   = (off64_t) ( leaf_index * chunk_hash_tree->leaf_size );
+	remaining_size = chunk_hash_tree->media_size - (size64_t) *leaf_offset;
+
+	if( remaining_size < (size64_t) chunk_hash_tree->leaf_size )
+	{
+		*leaf_data_size = (size32_t) remaining_size;
+	}
+	else
+	{
+		*leaf_data_size = chunk_hash_tree->leaf_size;
+	}
+	return( 1 );
+}
+
+/* Compares a hash with the stored hash of a specific leaf
+ * Returns 1 if the hashes are equal, 0 if not or -1 on error
+ */
+int chunk_hash_tree_compare_leaf_hash(
+     chunk_hash_tree_t *chunk_hash_tree,
+     uint64_t leaf_index,
+     const uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	static char *function = "chunk_hash_tree_compare_leaf_hash";
+
+	if( chunk_hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( leaf_index >= chunk_hash_tree->number_of_leaves )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid leaf index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_size != CHUNK_HASH_TREE_HASH_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported hash size.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     &( chunk_hash_tree->leaf_hashes[ leaf_index * CHUNK_HASH_TREE_HASH_SIZE ] ),
+	     hash,
+	     CHUNK_HASH_TREE_HASH_SIZE ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Writes the chunk hash tree to a file
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_hash_tree_write_file(
+     chunk_hash_tree_t *chunk_hash_tree,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	uint8_t file_header[ CHUNK_HASH_TREE_FILE_HEADER_SIZE ];
+
+	libcfile_file_t *file = NULL;
+	static char *function = "chunk_hash_tree_write_file";
+	size_t write_size     = 0;
+	ssize_t write_count   = 0;
+	int result            = 0;
+
+	if( chunk_hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_hash_tree->current_leaf_index != chunk_hash_tree->number_of_leaves )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk hash tree - not finalized.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     file_header,
+	     chunk_hash_tree_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header[ 8 ] ),
+	 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header[ 12 ] ),
+	 chunk_hash_tree->leaf_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 16 ] ),
+	 chunk_hash_tree->media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 24 ] ),
+	 chunk_hash_tree->number_of_leaves );
+
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_open_wide(
+		  file,
+		  filename,
+		  LIBCFILE_OPEN_WRITE,
+		  error );
+#else
+	result = libcfile_file_open(
+		  file,
+		  filename,
+		  LIBCFILE_OPEN_WRITE,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               file_header,
+	               CHUNK_HASH_TREE_FILE_HEADER_SIZE,
+	               error );
+
+	if( write_count != (ssize_t) CHUNK_HASH_TREE_FILE_HEADER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		goto on_error;
+	}
+	write_size = (size_t) chunk_hash_tree->number_of_leaves * CHUNK_HASH_TREE_HASH_SIZE;
+
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               chunk_hash_tree->leaf_hashes,
+	               write_size,
+	               error );
+
+	if( write_count != (ssize_t) write_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write leaf hashes.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               chunk_hash_tree->root_hash,
+	               CHUNK_HASH_TREE_HASH_SIZE,
+	               error );
+
+	if( write_count != (ssize_t) CHUNK_HASH_TREE_HASH_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write root hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates a chunk hash tree from a file
+ * Make sure the value chunk_hash_tree is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_hash_tree_initialize_from_file(
+     chunk_hash_tree_t **chunk_hash_tree,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	uint8_t calculated_root_hash[ CHUNK_HASH_TREE_HASH_SIZE ];
+	uint8_t file_header[ CHUNK_HASH_TREE_FILE_HEADER_SIZE ];
+
+	libcfile_file_t *file     = NULL;
+	static char *function     = "chunk_hash_tree_initialize_from_file";
+	size64_t file_size        = 0;
+	size64_t media_size       = 0;
+	size_t read_size          = 0;
+	ssize_t read_count        = 0;
+	uint64_t number_of_leaves = 0;
+	uint32_t format_version   = 0;
+	uint32_t leaf_size        = 0;
+	int result                = 0;
+
+	if( chunk_hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_hash_tree != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk hash tree value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_open_wide(
+		  file,
+		  filename,
+		  LIBCFILE_OPEN_READ,
+		  error );
+#else
+	result = libcfile_file_open(
+		  file,
+		  filename,
+		  LIBCFILE_OPEN_READ,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_get_size(
+	     file,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libcfile_file_read_buffer(
+	              file,
+	              file_header,
+	              CHUNK_HASH_TREE_FILE_HEADER_SIZE,
+	              error );
+
+	if( read_count != (ssize_t) CHUNK_HASH_TREE_FILE_HEADER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     file_header,
+	     chunk_hash_tree_file_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( file_header[ 8 ] ),
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( file_header[ 12 ] ),
+	 leaf_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header[ 16 ] ),
+	 media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header[ 24 ] ),
+	 number_of_leaves );
+
+	if( format_version != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		goto on_error;
+	}
+	if( chunk_hash_tree_initialize(
+	     chunk_hash_tree,
+	     media_size,
+	     leaf_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk hash tree.",
+		 function );
+
+		goto on_error;
+	}
+	read_size = (size_t) ( *chunk_hash_tree )->number_of_leaves * CHUNK_HASH_TREE_HASH_SIZE;
+
+	if( ( number_of_leaves != ( *chunk_hash_tree )->number_of_leaves )
+	 || ( file_size != (size64_t) ( CHUNK_HASH_TREE_FILE_HEADER_SIZE + read_size + CHUNK_HASH_TREE_HASH_SIZE ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of leaves value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libcfile_file_read_buffer(
+	              file,
+	              ( *chunk_hash_tree )->leaf_hashes,
+	              read_size,
+	              error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read leaf hashes.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libcfile_file_read_buffer(
+	              file,
+	              ( *chunk_hash_tree )->root_hash,
+	              CHUNK_HASH_TREE_HASH_SIZE,
+	              error );
+
+	if( read_count != (ssize_t) CHUNK_HASH_TREE_HASH_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read root hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	/* The leaf hashes are only trusted if they produce the stored root hash
+	 */
+	if( chunk_hash_tree_calculate_root_hash(
+	     *chunk_hash_tree,
+	     calculated_root_hash,
+	     CHUNK_HASH_TREE_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate root hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     ( *chunk_hash_tree )->root_hash,
+	     calculated_root_hash,
+	     CHUNK_HASH_TREE_HASH_SIZE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: mismatch in root hash.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_hash_tree )->current_leaf_index = ( *chunk_hash_tree )->number_of_leaves;
+
+	return( 1 );
+
+on_error:
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	if( *chunk_hash_tree != NULL )
+	{
+		chunk_hash_tree_free(
+		 chunk_hash_tree,
+		 NULL );
+	}
+	return( -1 );
+}
+
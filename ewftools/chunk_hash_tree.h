@@ -0,0 +1,148 @@
+/*
+ * Chunk hash tree
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _CHUNK_HASH_TREE_H )
+#define _CHUNK_HASH_TREE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of chunks that are hashed into a single leaf
+ */
+#define CHUNK_HASH_TREE_NUMBER_OF_CHUNKS_PER_LEAF	256
+
+/* The maximum size of a leaf
+ */
+#define CHUNK_HASH_TREE_MAXIMUM_LEAF_SIZE		INT32_MAX
+
+/* The size of a node hash
+ */
+#define CHUNK_HASH_TREE_HASH_SIZE			32
+
+/* The size of the chunk hash tree file header
+ */
+#define CHUNK_HASH_TREE_FILE_HEADER_SIZE		32
+
+typedef struct chunk_hash_tree chunk_hash_tree_t;
+
+struct chunk_hash_tree
+{
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The leaf size
+	 */
+	size32_t leaf_size;
+
+	/* The number of leaves
+	 */
+	uint64_t number_of_leaves;
+
+	/* The leaf hashes
+	 */
+	uint8_t *leaf_hashes;
+
+	/* The root hash
+	 */
+	uint8_t root_hash[ CHUNK_HASH_TREE_HASH_SIZE ];
+
+	/* The SHA256 context of the current leaf
+	 */
+	libhmac_sha256_context_t *sha256_context;
+
+	/* The index of the current leaf
+	 */
+	uint64_t current_leaf_index;
+
+	/* The size of the data of the current leaf that was hashed
+	 */
+	size32_t current_leaf_data_size;
+};
+
+int chunk_hash_tree_calculate_leaf_size(
+     size32_t chunk_size,
+     size32_t *leaf_size,
+     libcerror_error_t **error );
+
+int chunk_hash_tree_initialize(
+     chunk_hash_tree_t **chunk_hash_tree,
+     size64_t media_size,
+     size32_t leaf_size,
+     libcerror_error_t **error );
+
+int chunk_hash_tree_free(
+     chunk_hash_tree_t **chunk_hash_tree,
+     libcerror_error_t **error );
+
+int chunk_hash_tree_update(
+     chunk_hash_tree_t *chunk_hash_tree,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int chunk_hash_tree_finalize(
+     chunk_hash_tree_t *chunk_hash_tree,
+     libcerror_error_t **error );
+
+int chunk_hash_tree_calculate_root_hash(
+     chunk_hash_tree_t *chunk_hash_tree,
+     uint8_t *root_hash,
+     size_t root_hash_size,
+     libcerror_error_t **error );
+
+int chunk_hash_tree_get_leaf_range(
+     chunk_hash_tree_t *chunk_hash_tree,
+     uint64_t leaf_index,
+     off64_t *leaf_offset,
+     size32_t *leaf_data_size,
+     libcerror_error_t **error );
+
+int chunk_hash_tree_compare_leaf_hash(
+     chunk_hash_tree_t *chunk_hash_tree,
+     uint64_t leaf_index,
+     const uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+int chunk_hash_tree_write_file(
+     chunk_hash_tree_t *chunk_hash_tree,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int chunk_hash_tree_initialize_from_file(
+     chunk_hash_tree_t **chunk_hash_tree,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _CHUNK_HASH_TREE_H ) */
+
@@ -0,0 +1,604 @@
+/*
+ * Digest threads
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_threads.h"
+#include "ewftools_atomic.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates digest threads
+ * Make sure the value digest_threads is referencing, is set to NULL
+ * The buffer done callback function is called, on the thread of the last digest
+ * that was updated, when all digests have been updated with a buffer
+ * Returns 1 if successful or -1 on error
+ */
+int digest_threads_initialize(
+     digest_threads_t **digest_threads,
+     int maximum_number_of_queued_buffers,
+     int (*buffer_done_callback)(
+            storage_media_buffer_t *storage_media_buffer,
+            void *arguments ),
+     void *buffer_done_arguments,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_threads_initialize";
+
+	if( digest_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_threads != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest threads value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_queued_buffers <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of queued buffers value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_done_callback == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer done callback function.",
+		 function );
+
+		return( -1 );
+	}
+	*digest_threads = memory_allocate_structure(
+	                   digest_threads_t );
+
+	if( *digest_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *digest_threads,
+	     0,
+	     sizeof( digest_threads_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest threads.",
+		 function );
+
+		memory_free(
+		 *digest_threads );
+
+		*digest_threads = NULL;
+
+		return( -1 );
+	}
+	( *digest_threads )->maximum_number_of_queued_buffers = maximum_number_of_queued_buffers;
+	( *digest_threads )->buffer_done_callback             = buffer_done_callback;
+	( *digest_threads )->buffer_done_arguments            = buffer_done_arguments;
+
+	return( 1 );
+}
+
+/* Frees digest threads
+ * Threads that were not joined are joined
+ * Returns 1 if successful or -1 on error
+ */
+int digest_threads_free(
+     digest_threads_t **digest_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_threads_free";
+	int digest_index      = 0;
+	int result            = 1;
+
+	if( digest_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_threads != NULL )
+	{
+		for( digest_index = 0;
+		     digest_index < ( *digest_threads )->number_of_digests;
+		     digest_index++ )
+		{
+			if( ( *digest_threads )->digests[ digest_index ].thread_pool != NULL )
+			{
+				if( libcthreads_thread_pool_join(
+				     &( ( *digest_threads )->digests[ digest_index ].thread_pool ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to join digest: %d thread pool.",
+					 function,
+					 digest_index );
+
+					result = -1;
+				}
+			}
+		}
+		memory_free(
+		 *digest_threads );
+
+		*digest_threads = NULL;
+	}
+	return( result );
+}
+
+/* Appends a digest that is updated on its own thread
+ * The update function is called with the context for every buffer in the order the buffers were pushed
+ * Returns 1 if successful or -1 on error
+ */
+int digest_threads_append_digest(
+     digest_threads_t *digest_threads,
+     int (*update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t buffer_size,
+            libcerror_error_t **error ),
+     intptr_t *context,
+     libcerror_error_t **error )
+{
+	digest_thread_t *digest_thread = NULL;
+	static char *function          = "digest_threads_append_digest";
+
+	if( digest_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_threads->number_of_digests >= DIGEST_THREADS_MAXIMUM_NUMBER_OF_DIGESTS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid digest threads - number of digests value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( update_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid update function.",
+		 function );
+
+		return( -1 );
+	}
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	digest_thread = &( digest_threads->digests[ digest_threads->number_of_digests ] );
+
+	digest_thread->digest_threads  = digest_threads;
+	digest_thread->context         = context;
+	digest_thread->update_function = update_function;
+
+	/* A single thread per digest keeps the buffers in the order they were pushed
+	 */
+	if( libcthreads_thread_pool_create(
+	     &( digest_thread->thread_pool ),
+	     NULL,
+	     1,
+	     digest_threads->maximum_number_of_queued_buffers,
+	     (int (*)(intptr_t *, void *)) &digest_threads_digest_storage_media_buffer_callback,
+	     (void *) digest_thread,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize digest thread pool.",
+		 function );
+
+		digest_thread->digest_threads  = NULL;
+		digest_thread->context         = NULL;
+		digest_thread->update_function = NULL;
+
+		return( -1 );
+	}
+	digest_threads->number_of_digests += 1;
+
+	return( 1 );
+}
+
+/* Releases a reference of a storage media buffer
+ * The buffer done callback function is called when the last reference is released
+ * Returns 1 if successful or -1 on error
+ */
+static int digest_threads_release_buffer_reference(
+            digest_threads_t *digest_threads,
+            storage_media_buffer_t *storage_media_buffer )
+{
+	if( ewftools_atomic_decrement_int(
+	     &( storage_media_buffer->reference_count ) ) != 0 )
+	{
+		return( 1 );
+	}
+	if( digest_threads->buffer_done_callback(
+	     storage_media_buffer,
+	     digest_threads->buffer_done_arguments ) != 1 )
+	{
+		digest_threads->has_error = 1;
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Updates a digest with a storage media buffer
+ * Callback function for the digest thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_threads_digest_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     digest_thread_t *digest_thread )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
+	static char *function    = "digest_threads_digest_storage_media_buffer_callback";
+	size_t data_size         = 0;
+	int result               = 1;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( digest_thread == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest thread.",
+		 function );
+
+		goto on_error;
+	}
+	/* Once a digest failed the buffers are only passed on
+	 */
+	if( digest_thread->digest_threads->has_error == 0 )
+	{
+		if( storage_media_buffer_get_data(
+		     storage_media_buffer,
+		     &data,
+		     &data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine storage media buffer data.",
+			 function );
+
+			result = -1;
+		}
+		else if( storage_media_buffer->digest_data_size > data_size )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid storage media buffer - digest data size value out of bounds.",
+			 function );
+
+			result = -1;
+		}
+		else if( digest_thread->update_function(
+		          digest_thread->context,
+		          data,
+		          storage_media_buffer->digest_data_size,
+		          &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest.",
+			 function );
+
+			result = -1;
+		}
+		if( result != 1 )
+		{
+			digest_thread->digest_threads->has_error = 1;
+		}
+	}
+	/* The buffer is always passed on so that it is returned to its owner
+	 */
+	if( digest_threads_release_buffer_reference(
+	     digest_thread->digest_threads,
+	     storage_media_buffer ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to release storage media buffer reference.",
+		 function );
+
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Pushes a storage media buffer onto the digest threads
+ * The first data size bytes of the buffer data are digested
+ * Returns 1 if successful or -1 on error
+ */
+int digest_threads_push_buffer(
+     digest_threads_t *digest_threads,
+     storage_media_buffer_t *storage_media_buffer,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_threads_push_buffer";
+	int digest_index      = 0;
+
+	if( digest_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_threads->number_of_digests == 0 )
+	{
+		if( digest_threads->buffer_done_callback(
+		     storage_media_buffer,
+		     digest_threads->buffer_done_arguments ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pass on storage media buffer.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	storage_media_buffer->digest_data_size = data_size;
+
+	/* The reference count is set before the buffer is pushed onto any of the threads,
+	 * the thread pool push synchronizes the value with the digest threads
+	 */
+	storage_media_buffer->reference_count = digest_threads->number_of_digests;
+
+	for( digest_index = 0;
+	     digest_index < digest_threads->number_of_digests;
+	     digest_index++ )
+	{
+		if( libcthreads_thread_pool_push(
+		     digest_threads->digests[ digest_index ].thread_pool,
+		     (intptr_t *) storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto digest: %d thread pool queue.",
+			 function,
+			 digest_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	digest_threads->has_error = 1;
+
+	/* Release the references of the digests the buffer was not pushed onto
+	 * so that it is still passed on
+	 */
+	while( digest_index < digest_threads->number_of_digests )
+	{
+		digest_threads_release_buffer_reference(
+		 digest_threads,
+		 storage_media_buffer );
+
+		digest_index++;
+	}
+	return( -1 );
+}
+
+/* Joins the digest threads
+ * All pushed buffers are digested and passed on before the threads are joined
+ * Returns 1 if successful or -1 on error
+ */
+int digest_threads_join(
+     digest_threads_t *digest_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_threads_join";
+	int digest_index      = 0;
+	int result            = 1;
+
+	if( digest_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest threads.",
+		 function );
+
+		return( -1 );
+	}
+	for( digest_index = 0;
+	     digest_index < digest_threads->number_of_digests;
+	     digest_index++ )
+	{
+		if( digest_threads->digests[ digest_index ].thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( digest_threads->digests[ digest_index ].thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join digest: %d thread pool.",
+				 function,
+				 digest_index );
+
+				result = -1;
+			}
+		}
+	}
+	if( ( result == 1 )
+	 && ( digest_threads->has_error != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to update one or more digests.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
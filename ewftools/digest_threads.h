@@ -0,0 +1,142 @@
+/*
+ * Digest threads
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_THREADS_H )
+#define _DIGEST_THREADS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The maximum number of digests, MD5, SHA1, SHA256 and the chunk hash tree
+ */
+#define DIGEST_THREADS_MAXIMUM_NUMBER_OF_DIGESTS	4
+
+typedef struct digest_threads digest_threads_t;
+
+typedef struct digest_thread digest_thread_t;
+
+struct digest_thread
+{
+	/* The digest threads
+	 */
+	digest_threads_t *digest_threads;
+
+	/* The digest context
+	 */
+	intptr_t *context;
+
+	/* The update function
+	 */
+	int (*update_function)(
+	       intptr_t *context,
+	       const uint8_t *buffer,
+	       size_t buffer_size,
+	       libcerror_error_t **error );
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+};
+
+struct digest_threads
+{
+	/* The digest threads
+	 */
+	digest_thread_t digests[ DIGEST_THREADS_MAXIMUM_NUMBER_OF_DIGESTS ];
+
+	/* The number of digests
+	 */
+	int number_of_digests;
+
+	/* The maximum number of queued buffers
+	 */
+	int maximum_number_of_queued_buffers;
+
+	/* The function that is called when all digests have been updated with a buffer
+	 */
+	int (*buffer_done_callback)(
+	       storage_media_buffer_t *storage_media_buffer,
+	       void *arguments );
+
+	/* The arguments of the buffer done callback function
+	 */
+	void *buffer_done_arguments;
+
+	/* Value to indicate a digest thread failed
+	 */
+	volatile int has_error;
+};
+
+int digest_threads_initialize(
+     digest_threads_t **digest_threads,
+     int maximum_number_of_queued_buffers,
+     int (*buffer_done_callback)(
+            storage_media_buffer_t *storage_media_buffer,
+            void *arguments ),
+     void *buffer_done_arguments,
+     libcerror_error_t **error );
+
+int digest_threads_free(
+     digest_threads_t **digest_threads,
+     libcerror_error_t **error );
+
+int digest_threads_append_digest(
+     digest_threads_t *digest_threads,
+     int (*update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t buffer_size,
+            libcerror_error_t **error ),
+     intptr_t *context,
+     libcerror_error_t **error );
+
+int digest_threads_digest_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     digest_thread_t *digest_thread );
+
+int digest_threads_push_buffer(
+     digest_threads_t *digest_threads,
+     storage_media_buffer_t *storage_media_buffer,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int digest_threads_join(
+     digest_threads_t *digest_threads,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIGEST_THREADS_H ) */
+
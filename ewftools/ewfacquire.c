@@ -36,6 +36,7 @@
 
 #include "byte_size_string.h"
 #include "device_handle.h"
+#include "digest_threads.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_getopt.h"
@@ -123,12 +124,13 @@ void ewfacquire_usage_fprint(
 	                 "                  [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                  [ -C case_number ] [ -d digest_type ] [ -D description ]\n"
 	                 "                  [ -e examiner_name ] [ -E evidence_number ] [ -f format ]\n"
-	                 "                  [ -g number_of_sectors ] [ -j jobs ] [ -l log_filename ]\n"
+	                 "                  [ -g number_of_sectors ] [ -H hash_tree_filename ]\n"
+	                 "                  [ -j jobs ] [ -l log_filename ]\n"
 	                 "                  [ -m media_type ] [ -M media_flags ] [ -N notes ]\n"
 	                 "                  [ -o offset ] [ -p process_buffer_size ]\n"
 	                 "                  [ -P bytes_per_sector ] [ -r read_error_retries ]\n"
 	                 "                  [ -S segment_file_size ] [ -t target ] [ -T toc_file ]\n"
-	                 "                  [ -2 secondary_target ] [ -hqRsuvVwx ] source\n\n" );
+	                 "                  [ -2 secondary_target ] [ -hqRsuUvVwx ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file(s) or device\n\n" );
 
@@ -161,6 +163,9 @@ void ewfacquire_usage_fprint(
 	                 "\t        encase7, encase7-v2, linen5, linen6, linen7, ewfx\n" );
 	fprintf( stream, "\t-g      specify the number of sectors to be used as error granularity\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-H:     writes a SHA256 hash tree of the media data per 256 chunks to\n"
+	                 "\t        the hash_tree_filename (use with ewfverify -H to verify\n"
+	                 "\t        (ranges of) the image in parallel)\n" );
 	fprintf( stream, "\t-j:     the number of concurrent processing jobs (threads), where\n"
 	                 "\t        a number of 0 represents single-threaded mode (default is 4\n"
 	                 "\t        if multi-threaded mode is supported)\n" );
@@ -205,6 +210,8 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-T:     specify the file containing the table of contents (TOC) of\n"
 	                 "\t        an optical disc. The TOC file must be in the CUE format.\n" );
 	fprintf( stream, "\t-u:     unattended mode (disables user interaction)\n" );
+	fprintf( stream, "\t-U:     use direct (unbuffered) IO to write the target, bypassing\n"
+	                 "\t        the system page cache\n" );
 	fprintf( stream, "\t-v:     verbose output to stderr\n" );
 	fprintf( stream, "\t-V:     print version\n" );
 	fprintf( stream, "\t-w:     zero sectors on read error (mimic EnCase like behavior)\n" );
@@ -991,16 +998,19 @@ int ewfacquire_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( imaging_handle->number_of_threads > 0 )
 		{
-			if( libcthreads_thread_pool_push(
-			     imaging_handle->process_thread_pool,
-			     (intptr_t *) storage_media_buffer,
-			     error ) == -1 )
+			/* The digest threads pass the buffer on to the process thread pool
+			 */
+			if( digest_threads_push_buffer(
+			     imaging_handle->digest_threads,
+			     storage_media_buffer,
+			     (size_t) read_count,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to push storage media buffer onto process thread pool queue.",
+				 "%s: unable to push storage media buffer onto digest threads.",
 				 function );
 
 				return( -1 );
@@ -1231,6 +1241,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_additional_digest_types   = NULL;
 	system_character_t *option_bytes_per_sector          = NULL;
 	system_character_t *option_case_number               = NULL;
+	system_character_t *option_chunk_hash_tree_filename  = NULL;
 	system_character_t *option_compression_values        = NULL;
 	system_character_t *option_description               = NULL;
 	system_character_t *option_evidence_number           = NULL;
@@ -1261,6 +1272,7 @@ int main( int argc, char * const argv[] )
 	uint8_t resume_acquiry                               = 0;
 	uint8_t swap_byte_pairs                              = 0;
 	uint8_t use_data_chunk_functions                     = 0;
+	uint8_t use_direct_io                                = 0;
 	uint8_t verbose                                      = 0;
 	uint8_t zero_buffer_on_error                         = 0;
 	int8_t acquiry_parameters_confirmed                  = 0;
@@ -1300,7 +1312,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hH:j:l:m:M:N:o:p:P:qr:RsS:t:T:uUvVwx2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1385,6 +1397,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'H':
+				option_chunk_hash_tree_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'j':
 				option_number_of_jobs = optarg;
 
@@ -1465,6 +1482,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'U':
+				use_direct_io = 1;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -1665,6 +1687,9 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	ewfacquire_imaging_handle->use_direct_io            = use_direct_io;
+	ewfacquire_imaging_handle->chunk_hash_tree_filename = option_chunk_hash_tree_filename;
+
 	if( device_handle_get_media_size(
 	     ewfacquire_device_handle,
 	     &( ewfacquire_imaging_handle->input_media_size ),
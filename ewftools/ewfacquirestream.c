@@ -43,6 +43,7 @@
 #endif
 
 #include "byte_size_string.h"
+#include "digest_threads.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_getopt.h"
@@ -751,16 +752,19 @@ int ewfacquirestream_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( imaging_handle->number_of_threads > 0 )
 		{
-			if( libcthreads_thread_pool_push(
-			     imaging_handle->process_thread_pool,
-			     (intptr_t *) storage_media_buffer,
-			     error ) == -1 )
+			/* The digest threads pass the buffer on to the process thread pool
+			 */
+			if( digest_threads_push_buffer(
+			     imaging_handle->digest_threads,
+			     storage_media_buffer,
+			     (size_t) read_count,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to push storage media buffer onto process thread pool queue.",
+				 "%s: unable to push storage media buffer onto digest threads.",
 				 function );
 
 				return( -1 );
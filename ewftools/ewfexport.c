@@ -121,7 +121,8 @@ void usage_fprint(
 
 	fprintf( stream, "Usage: ewfexport [ -A codepage ] [ -b number_of_sectors ]\n"
 	                 "                 [ -B number_of_bytes ] [ -c compression_values ]\n"
-	                 "                 [ -d digest_type ] [ -f format ] [ -j jobs ] [ -l log_filename ]\n"
+	                 "                 [ -d digest_type ] [ -f format ] [ -H hash_tree_filename ]\n"
+	                 "                 [ -j jobs ] [ -l log_filename ]\n"
 	                 "                 [ -o offset ] [ -p process_buffer_size ]\n"
 	                 "                 [ -S segment_file_size ] [ -t target ] [ -hqsuvVwx ] ewf_files\n\n" );
 
@@ -153,6 +154,8 @@ void usage_fprint(
 	                 "\t           smart, encase1, encase2, encase3, encase4, encase5, encase6,\n"
 	                 "\t           encase7, encase7-v2, linen5, linen6, linen7, ewfx\n" );
 	fprintf( stream, "\t-h:        shows this help\n" );
+	fprintf( stream, "\t-H:        writes a SHA256 hash tree of the exported media data per\n"
+	                 "\t           256 chunks to the hash_tree_filename\n" );
 	fprintf( stream, "\t-j:        the number of concurrent processing jobs (threads), where\n"
 	                 "\t           a number of 0 represents single-threaded mode (default is 4\n"
 	                 "\t           if multi-threaded mode is supported)\n" );
@@ -256,34 +259,35 @@ int main( int argc, char * const argv[] )
 	struct rlimit limit_data;
 #endif
 
-	system_character_t * const *source_filenames       = NULL;
-	libcerror_error_t *error                           = NULL;
-	log_handle_t *log_handle                           = NULL;
-	system_character_t *acquiry_software_version       = NULL;
-	system_character_t *log_filename                   = NULL;
-	system_character_t *option_additional_digest_types = NULL;
-	system_character_t *option_compression_values      = NULL;
-	system_character_t *option_format                  = NULL;
-	system_character_t *option_header_codepage         = NULL;
-	system_character_t *option_maximum_segment_size    = NULL;
-	system_character_t *option_number_of_jobs          = NULL;
-	system_character_t *option_offset                  = NULL;
-	system_character_t *option_process_buffer_size     = NULL;
-	system_character_t *option_sectors_per_chunk       = NULL;
-	system_character_t *option_size                    = NULL;
-	system_character_t *option_target_path             = NULL;
-	system_character_t *program                        = _SYSTEM_STRING( "ewfexport" );
-	system_character_t *request_string                 = NULL;
-	system_integer_t option                            = 0;
-	uint8_t calculate_md5                              = 1;
-	uint8_t print_status_information                   = 1;
-	uint8_t swap_byte_pairs                            = 0;
-	uint8_t use_data_chunk_functions                   = 0;
-	uint8_t verbose                                    = 0;
-	uint8_t zero_chunk_on_error                        = 0;
-	int interactive_mode                               = 1;
-	int number_of_filenames                            = 0;
-	int result                                         = 1;
+	system_character_t * const *source_filenames        = NULL;
+	libcerror_error_t *error                            = NULL;
+	log_handle_t *log_handle                            = NULL;
+	system_character_t *acquiry_software_version        = NULL;
+	system_character_t *log_filename                    = NULL;
+	system_character_t *option_additional_digest_types  = NULL;
+	system_character_t *option_chunk_hash_tree_filename = NULL;
+	system_character_t *option_compression_values       = NULL;
+	system_character_t *option_format                   = NULL;
+	system_character_t *option_header_codepage          = NULL;
+	system_character_t *option_maximum_segment_size     = NULL;
+	system_character_t *option_number_of_jobs           = NULL;
+	system_character_t *option_offset                   = NULL;
+	system_character_t *option_process_buffer_size      = NULL;
+	system_character_t *option_sectors_per_chunk        = NULL;
+	system_character_t *option_size                     = NULL;
+	system_character_t *option_target_path              = NULL;
+	system_character_t *program                         = _SYSTEM_STRING( "ewfexport" );
+	system_character_t *request_string                  = NULL;
+	system_integer_t option                             = 0;
+	uint8_t calculate_md5                               = 1;
+	uint8_t print_status_information                    = 1;
+	uint8_t swap_byte_pairs                             = 0;
+	uint8_t use_data_chunk_functions                    = 0;
+	uint8_t verbose                                     = 0;
+	uint8_t zero_chunk_on_error                         = 0;
+	int interactive_mode                                = 1;
+	int number_of_filenames                             = 0;
+	int result                                          = 1;
 
 #if !defined( HAVE_GLOB_H )
 	ewftools_glob_t *glob                            = NULL;
@@ -346,7 +350,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:d:f:hj:l:o:p:qsS:t:uvVwx" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:d:f:hH:j:l:o:p:qsS:t:uvVwx" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -406,6 +410,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'H':
+				option_chunk_hash_tree_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'j':
 				option_number_of_jobs = optarg;
 
@@ -559,6 +568,8 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	ewfexport_export_handle->chunk_hash_tree_filename = option_chunk_hash_tree_filename;
+
 #if defined( HAVE_GETRLIMIT )
 	if( getrlimit(
             RLIMIT_NOFILE,
@@ -71,14 +71,24 @@ void usage_fprint(
 	}
 	fprintf( stream, "Use ewfmount to mount an Expert Witness Compression Format (EWF) image file\n\n" );
 
-	fprintf( stream, "Usage: ewfmount [ -f format ] [ -X extended_options ] [ -hvV ] image mount_point\n\n" );
+	fprintf( stream, "Usage: ewfmount [ -c cache_size ] [ -f format ] [ -r readers ]\n"
+	                 "                [ -X extended_options ] [ -hvV ]\n"
+	                 "                image mount_point\n\n" );
 
 	fprintf( stream, "\timage:       an Expert Witness Compression Format (EWF) image file\n\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
 
+	fprintf( stream, "\t-c:          the size of the cache used to read ahead of sequential reads\n"
+	                 "\t             of the media data, where a size of 0 disables read-ahead\n"
+	                 "\t             (default is 32 MiB if multi-threaded mode is supported,\n"
+	                 "\t             maximum is 128 MiB)\n" );
 	fprintf( stream, "\t-f:          specify the input format, options: raw (default), files (restricted to\n"
 	                 "\t             logical volume files)\n" );
 	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-r:          the number of reader handles used to serve concurrent reads\n"
+	                 "\t             of the media data, where a number of 0 represents serving\n"
+	                 "\t             reads one at a time (default is 4 if multi-threaded mode is\n"
+	                 "\t             supported)\n" );
 	fprintf( stream, "\t-v:          verbose output to stderr, while ewfmount will remain running in the\n"
 	                 "\t             foreground\n" );
 	fprintf( stream, "\t-V:          print version\n" );
@@ -141,29 +151,31 @@ int main( int argc, char * const argv[] )
 	struct rlimit limit_data;
 #endif
 
-	system_character_t * const *sources         = NULL;
-	libewf_error_t *error                       = NULL;
-	system_character_t *mount_point             = NULL;
-	system_character_t *option_extended_options = NULL;
-	system_character_t *option_format           = NULL;
-	const system_character_t *path_prefix       = NULL;
-	char *program                               = _SYSTEM_STRING( "ewfmount" );
-	system_integer_t option                     = 0;
-	size_t path_prefix_size                     = 0;
-	int number_of_sources                       = 0;
-	int result                                  = 0;
-	int verbose                                 = 0;
+	system_character_t * const *sources          = NULL;
+	libewf_error_t *error                        = NULL;
+	system_character_t *mount_point              = NULL;
+	system_character_t *option_cache_size        = NULL;
+	system_character_t *option_extended_options  = NULL;
+	system_character_t *option_format            = NULL;
+	system_character_t *option_number_of_readers = NULL;
+	const system_character_t *path_prefix        = NULL;
+	char *program                                = _SYSTEM_STRING( "ewfmount" );
+	system_integer_t option                      = 0;
+	size_t path_prefix_size                      = 0;
+	int number_of_sources                        = 0;
+	int result                                   = 0;
+	int verbose                                  = 0;
 
 #if !defined( HAVE_GLOB_H )
-	ewftools_glob_t *glob                       = NULL;
+	ewftools_glob_t *glob                        = NULL;
 #endif
 
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
 	struct fuse_operations ewfmount_fuse_operations;
 
-	struct fuse_args ewfmount_fuse_arguments    = FUSE_ARGS_INIT(0, NULL);
-	struct fuse_chan *ewfmount_fuse_channel     = NULL;
-	struct fuse *ewfmount_fuse_handle           = NULL;
+	struct fuse_args ewfmount_fuse_arguments     = FUSE_ARGS_INIT(0, NULL);
+	struct fuse_chan *ewfmount_fuse_channel      = NULL;
+	struct fuse *ewfmount_fuse_handle            = NULL;
 
 #elif defined( HAVE_LIBDOKAN )
 	DOKAN_OPERATIONS ewfmount_dokan_operations;
@@ -203,7 +215,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "f:hvVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "c:f:hr:vVX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -219,6 +231,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_FAILURE );
 
+			case (system_integer_t) 'c':
+				option_cache_size = optarg;
+
+				break;
+
 			case (system_integer_t) 'f':
 				option_format = optarg;
 
@@ -230,6 +247,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'r':
+				option_number_of_readers = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -351,6 +373,68 @@ int main( int argc, char * const argv[] )
 			 "Unsupported input format defaulting to: raw.\n" );
 		}
 	}
+	if( option_number_of_readers != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		result = mount_handle_set_number_of_reader_handles(
+			  ewfmount_mount_handle,
+			  option_number_of_readers,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of readers.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			ewfmount_mount_handle->number_of_reader_handles = 4;
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of readers defaulting to: %d.\n",
+			 ewfmount_mount_handle->number_of_reader_handles );
+		}
+#else
+		fprintf(
+		 stderr,
+		 "Unsupported number of readers defaulting to: 0.\n" );
+#endif
+	}
+	if( option_cache_size != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		result = mount_handle_set_read_ahead_cache_size(
+			  ewfmount_mount_handle,
+			  option_cache_size,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set read-ahead cache size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			ewfmount_mount_handle->read_ahead_cache_size = 32 * 1024 * 1024;
+
+			fprintf(
+			 stderr,
+			 "Unsupported read-ahead cache size defaulting to: %" PRIu64 ".\n",
+			 ewfmount_mount_handle->read_ahead_cache_size );
+		}
+#else
+		fprintf(
+		 stderr,
+		 "Unsupported read-ahead cache size defaulting to: 0.\n" );
+#endif
+	}
 #if defined( HAVE_GETRLIMIT )
 	if( getrlimit(
 	     RLIMIT_NOFILE,
@@ -520,9 +604,21 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	result = fuse_loop(
-	          ewfmount_fuse_handle );
-
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Serve the requests on multiple threads so that reads can be served
+	 * concurrently by the reader handles
+	 */
+	if( ewfmount_mount_handle->file_system->number_of_reader_handles > 0 )
+	{
+		result = fuse_loop_mt(
+		          ewfmount_fuse_handle );
+	}
+	else
+#endif
+	{
+		result = fuse_loop(
+		          ewfmount_fuse_handle );
+	}
 	if( result != 0 )
 	{
 		fprintf(
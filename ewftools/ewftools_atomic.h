@@ -0,0 +1,71 @@
+/*
+ * Definitions for atomic operations on values shared between threads
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWFTOOLS_ATOMIC_H )
+#define _EWFTOOLS_ATOMIC_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#if defined( WINAPI )
+
+/* The Interlocked functions imply a full memory barrier
+ */
+#define ewftools_atomic_load( value ) \
+	( (size_t) InterlockedCompareExchangePointer( (PVOID volatile *) ( value ), NULL, NULL ) )
+
+#define ewftools_atomic_store( value, new_value ) \
+	InterlockedExchangePointer( (PVOID volatile *) ( value ), (PVOID) ( new_value ) )
+
+#define ewftools_atomic_compare_exchange( value, expected_value, new_value ) \
+	( InterlockedCompareExchangePointer( (PVOID volatile *) ( value ), (PVOID) ( new_value ), (PVOID) ( expected_value ) ) == (PVOID) ( expected_value ) )
+
+#define ewftools_atomic_decrement_int( value ) \
+	( (int) InterlockedDecrement( (LONG volatile *) ( value ) ) )
+
+#define ewftools_atomic_memory_barrier() \
+	MemoryBarrier()
+
+#else
+
+#define ewftools_atomic_load( value ) \
+	__atomic_load_n( value, __ATOMIC_ACQUIRE )
+
+#define ewftools_atomic_store( value, new_value ) \
+	__atomic_store_n( value, new_value, __ATOMIC_RELEASE )
+
+#define ewftools_atomic_compare_exchange( value, expected_value, new_value ) \
+	__sync_bool_compare_and_swap( value, expected_value, new_value )
+
+#define ewftools_atomic_decrement_int( value ) \
+	__atomic_sub_fetch( value, 1, __ATOMIC_ACQ_REL )
+
+#define ewftools_atomic_memory_barrier() \
+	__atomic_thread_fence( __ATOMIC_SEQ_CST )
+
+#endif /* defined( WINAPI ) */
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#endif /* !defined( _EWFTOOLS_ATOMIC_H ) */
+
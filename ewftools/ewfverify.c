@@ -52,6 +52,7 @@
 #include "ewftools_libewf.h"
 #include "ewftools_output.h"
 #include "ewftools_signal.h"
+#include "ewftools_system_string.h"
 #include "ewftools_unused.h"
 #include "log_handle.h"
 #include "verification_handle.h"
@@ -71,9 +72,11 @@ void usage_fprint(
 	fprintf( stream, "Use ewfverify to verify data stored in the EWF format (Expert Witness\n"
 	                 "Compression Format).\n\n" );
 
-	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -d digest_type ] [ -f format ]\n"
-	                 "                 [ -j jobs ] [ -l log_filename ] [ -p process_buffer_size ]\n"
-	                 "                 [ -hqvVwx ] ewf_files\n\n" );
+	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -B number_of_bytes ] [ -d digest_type ]\n"
+	                 "                 [ -f format ] [ -H hash_tree_filename ] [ -j jobs ]\n"
+	                 "                 [ -l log_filename ] [ -o offset ]\n"
+	                 "                 [ -p process_buffer_size ] [ -r readers ] [ -ChqUvVwx ]\n"
+	                 "                 ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -82,19 +85,34 @@ void usage_fprint(
 	                 "\t           windows-950, windows-1250, windows-1251, windows-1252,\n"
 	                 "\t           windows-1253, windows-1254, windows-1255, windows-1256,\n"
 	                 "\t           windows-1257 or windows-1258\n" );
+	fprintf( stream, "\t-B:        specify the number of bytes to verify with the hash tree\n"
+	                 "\t           (default is all bytes). Requires -H\n" );
+	fprintf( stream, "\t-C:        only verify the checksums of the chunks and their compressed\n"
+	                 "\t           data instead of calculating the digest (hash) of all the media\n"
+	                 "\t           data\n" );
 	fprintf( stream, "\t-d:        calculate digest (hash) types, options: md5, sha1, sha256.\n"
 	                 "\t           By default ewfverify will calculate the digest (hash) types\n"
 	                 "\t           that are stored in the EWF segment files or MD5 if none.\n" );
 	fprintf( stream, "\t-f:        specify the input format, options: raw (default),\n"
 	                 "\t           files (restricted to logical volume files)\n" );
 	fprintf( stream, "\t-h:        shows this help\n" );
+	fprintf( stream, "\t-H:        verify the media data against the chunk hash tree stored\n"
+	                 "\t           in hash_tree_filename instead of calculating the digest\n"
+	                 "\t           (hash) of all the media data\n" );
 	fprintf( stream, "\t-j:        the number of concurrent processing jobs (threads), where\n"
 	                 "\t           a number of 0 represents single-threaded mode (default is 4\n"
 	                 "\t           if multi-threaded mode is supported)\n" );
 	fprintf( stream, "\t-l:        logs verification errors and the digest (hash) to the\n"
 	                 "\t           log_filename\n" );
+	fprintf( stream, "\t-o:        specify the offset to start verifying with the hash tree\n"
+	                 "\t           (default is 0). Requires -H\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
+	fprintf( stream, "\t-r:        the number of concurrent read jobs (reader threads), where\n"
+	                 "\t           a number of 0 represents reading on the main thread\n"
+	                 "\t           (default). Requires multi-threaded mode\n" );
+	fprintf( stream, "\t-U:        use direct (unbuffered) IO to read the EWF segment files,\n"
+	                 "\t           bypassing the system page cache\n" );
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
 	fprintf( stream, "\t-V:        print version\n" );
 	fprintf( stream, "\t-w:        zero sectors on checksum error (mimic EnCase like behavior)\n" );
@@ -164,14 +182,23 @@ int main( int argc, char * const argv[] )
 	system_character_t *log_filename               = NULL;
 	system_character_t *option_digest_types        = NULL;
 	system_character_t *option_format              = NULL;
+	system_character_t *option_hash_tree_filename  = NULL;
 	system_character_t *option_header_codepage     = NULL;
 	system_character_t *option_number_of_jobs      = NULL;
+	system_character_t *option_number_of_readers   = NULL;
+	system_character_t *option_offset              = NULL;
 	system_character_t *option_process_buffer_size = NULL;
+	system_character_t *option_size                = NULL;
 	system_character_t *program                    = _SYSTEM_STRING( "ewfverify" );
 	system_integer_t option                        = 0;
+	size_t string_length                           = 0;
+	uint64_t verify_offset                         = 0;
+	uint64_t verify_size                           = 0;
 	uint8_t print_status_information               = 1;
 	uint8_t use_data_chunk_functions               = 0;
+	uint8_t use_direct_io                          = 0;
 	uint8_t verbose                                = 0;
+	uint8_t verify_chunk_checksums                 = 0;
 	uint8_t zero_chunk_on_error                    = 0;
 	int number_of_filenames                        = 0;
 	int result                                     = 0;
@@ -213,7 +240,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:d:f:j:hl:p:qvVwx" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:B:Cd:f:hH:j:l:o:p:qr:UvVwx" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -234,6 +261,16 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'B':
+				option_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'C':
+				verify_chunk_checksums = 1;
+
+				break;
+
 			case (system_integer_t) 'd':
 				option_digest_types = optarg;
 
@@ -250,6 +287,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'H':
+				option_hash_tree_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'j':
 				option_number_of_jobs = optarg;
 
@@ -260,6 +302,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'o':
+				option_offset = optarg;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -270,6 +317,16 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'r':
+				option_number_of_readers = optarg;
+
+				break;
+
+			case (system_integer_t) 'U':
+				use_direct_io = 1;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -303,6 +360,19 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( ( option_hash_tree_filename == NULL )
+	 && ( ( option_offset != NULL )
+	  || ( option_size != NULL ) ) )
+	{
+		fprintf(
+		 stderr,
+		 "The offset (-o) and number of bytes (-B) options require a hash tree filename (-H).\n" );
+
+		usage_fprint(
+		 stdout );
+
+		goto on_error;
+	}
 	libcnotify_verbose_set(
 	 verbose );
 
@@ -324,6 +394,53 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	ewfverify_verification_handle->use_direct_io = use_direct_io;
+
+	if( option_offset != NULL )
+	{
+		string_length = system_string_length(
+		                 option_offset );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     option_offset,
+		     string_length + 1,
+		     &verify_offset,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported offset.\n" );
+
+			goto on_error;
+		}
+		if( verify_offset > (uint64_t) INT64_MAX )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported offset value out of bounds.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_size != NULL )
+	{
+		string_length = system_string_length(
+		                 option_size );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     option_size,
+		     string_length + 1,
+		     &verify_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of bytes.\n" );
+
+			goto on_error;
+		}
+	}
+
 	if( option_header_codepage != NULL )
 	{
 		result = verification_handle_set_header_codepage(
@@ -426,6 +543,47 @@ int main( int argc, char * const argv[] )
 		 stderr,
 		 "Unsupported number of jobs (threads) defaulting to: %d.\n",
 		 ewfverify_verification_handle->number_of_threads );
+#endif
+	}
+	if( option_number_of_readers != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		result = verification_handle_set_number_of_reader_threads(
+			  ewfverify_verification_handle,
+			  option_number_of_readers,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of read jobs (reader threads).\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			ewfverify_verification_handle->number_of_reader_threads = 0;
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of read jobs (reader threads) defaulting to: %d.\n",
+			 ewfverify_verification_handle->number_of_reader_threads );
+		}
+		else if( ( ewfverify_verification_handle->number_of_reader_threads > 0 )
+		      && ( ewfverify_verification_handle->number_of_threads == 0 ) )
+		{
+			ewfverify_verification_handle->number_of_reader_threads = 0;
+
+			fprintf(
+			 stderr,
+			 "Read jobs (reader threads) require multi-threaded mode defaulting to: %d.\n",
+			 ewfverify_verification_handle->number_of_reader_threads );
+		}
+#else
+		fprintf(
+		 stderr,
+		 "Unsupported number of read jobs (reader threads) defaulting to: 0.\n" );
 #endif
 	}
 	if( option_digest_types != NULL )
@@ -613,6 +771,49 @@ int main( int argc, char * const argv[] )
 			 &error );
 		}
 	}
+	else if( option_hash_tree_filename != NULL )
+	{
+		result = verification_handle_verify_chunk_hash_tree(
+		          ewfverify_verification_handle,
+		          option_hash_tree_filename,
+		          (off64_t) verify_offset,
+		          (size64_t) verify_size,
+		          print_status_information,
+		          log_handle,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to verify input with chunk hash tree.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	else if( verify_chunk_checksums != 0 )
+	{
+		result = verification_handle_verify_chunk_checksums(
+		          ewfverify_verification_handle,
+		          print_status_information,
+		          log_handle,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to verify chunk checksums of input.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
 	else
 	{
 		result = verification_handle_verify_input(
@@ -42,6 +42,7 @@
 #endif
 
 #include "byte_size_string.h"
+#include "chunk_hash_tree.h"
 #include "digest_hash.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
@@ -57,6 +58,7 @@
 #include "export_handle.h"
 #include "guid.h"
 #include "process_status.h"
+#include "reorder_ring.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
 
@@ -375,6 +377,22 @@ int export_handle_free(
 			memory_free(
 			 ( *export_handle )->calculated_sha256_hash_string );
 		}
+		if( ( *export_handle )->chunk_hash_tree != NULL )
+		{
+			if( chunk_hash_tree_free(
+			     &( ( *export_handle )->chunk_hash_tree ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk hash tree.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *export_handle );
 
@@ -1325,6 +1343,7 @@ int export_handle_initialize_integrity_hash(
      libcerror_error_t **error )
 {
 	static char *function = "export_handle_initialize_integrity_hash";
+	size32_t leaf_size    = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1388,9 +1407,47 @@ int export_handle_initialize_integrity_hash(
 		}
 		export_handle->sha256_context_initialized = 1;
 	}
+	if( export_handle->chunk_hash_tree_filename != NULL )
+	{
+		if( chunk_hash_tree_calculate_leaf_size(
+		     export_handle->input_chunk_size,
+		     &leaf_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine chunk hash tree leaf size.",
+			 function );
+
+			goto on_error;
+		}
+		if( chunk_hash_tree_initialize(
+		     &( export_handle->chunk_hash_tree ),
+		     (size64_t) export_handle->export_size,
+		     leaf_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk hash tree.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
+	if( export_handle->sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &( export_handle->sha256_context ),
+		 NULL );
+	}
 	if( export_handle->sha1_context != NULL )
 	{
 		libhmac_sha1_free(
@@ -1505,6 +1562,24 @@ int export_handle_update_integrity_hash(
 			return( -1 );
 		}
 	}
+	if( export_handle->chunk_hash_tree != NULL )
+	{
+		if( chunk_hash_tree_update(
+		     export_handle->chunk_hash_tree,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update chunk hash tree.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -4577,14 +4652,16 @@ int export_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle )
 {
-	libcdata_list_element_t *element                    = NULL;
-	libcdata_list_element_t *next_element               = NULL;
+	storage_media_buffer_t *released_buffers[ STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_BATCH_SIZE ];
+
         libcerror_error_t *error                            = NULL;
 	storage_media_buffer_t *output_storage_media_buffer = NULL;
 	uint8_t *data                                       = NULL;
-        static char *function                               = "export_handle_process_storage_media_buffer_callback";
+        static char *function                               = "export_handle_output_storage_media_buffer_callback";
 	size_t data_size                                    = 0;
+	size_t digest_data_size                             = 0;
 	ssize_t write_count                                 = 0;
+	int number_of_released_buffers                      = 0;
 	int result                                          = 0;
 
 	if( export_handle == NULL )
@@ -4613,72 +4690,47 @@ int export_handle_output_storage_media_buffer_callback(
 	{
 		return( 1 );
 	}
-	if( libcdata_list_insert_value(
-	     export_handle->output_list,
+	/* The buffers complete out of order, the reorder ring restores the order
+	 * in which they were read using the sequence number of the buffer
+	 */
+	if( reorder_ring_insert_value(
+	     export_handle->output_reorder_ring,
+	     storage_media_buffer->sequence_number,
 	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 "%s: unable to insert storage media buffer into output reorder ring.",
 		 function );
 
 		goto on_error;
 	}
 	storage_media_buffer = NULL;
 
-	if( libcdata_list_get_first_element(
-	     export_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	while( export_handle->abort == 0 )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		result = reorder_ring_get_next_value(
+		          export_handle->output_reorder_ring,
+		          (intptr_t **) &storage_media_buffer,
+		          &error );
 
-		goto on_error;
-	}
-	while( element != NULL )
-	{
-		if( export_handle->abort != 0 )
-		{
-			break;
-		}
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 "%s: unable to retrieve next storage media buffer from output reorder ring.",
 			 function );
 
 			storage_media_buffer = NULL;
 
 			goto on_error;
 		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer->storage_media_offset != export_handle->last_offset_hashed )
+		else if( result == 0 )
 		{
 			break;
 		}
@@ -4695,8 +4747,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine if storage media buffer is corrupted.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		else if( result != 0 )
@@ -4716,8 +4766,6 @@ int export_handle_output_storage_media_buffer_callback(
 				 "%s: unable to append read error.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
@@ -4734,8 +4782,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine storage media buffer data.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		/* Swap byte pairs
@@ -4755,18 +4801,22 @@ int export_handle_output_storage_media_buffer_callback(
 				 "%s: unable to swap byte pairs.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
 		/* Digest hashes are calcultated after swap
 		 */
-		if( export_handle_update_integrity_hash(
-		     export_handle,
-		     data,
-		     storage_media_buffer->processed_size,
-		     &error ) != 1 )
+		if( export_handle->digest_threads != NULL )
+		{
+			/* Writing the buffer can change its processed size
+			 */
+			digest_data_size = storage_media_buffer->processed_size;
+		}
+		else if( export_handle_update_integrity_hash(
+		          export_handle,
+		          data,
+		          storage_media_buffer->processed_size,
+		          &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
@@ -4775,8 +4825,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to update integrity hash(es).",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		export_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
@@ -4797,8 +4845,6 @@ int export_handle_output_storage_media_buffer_callback(
 				 "%s: unable to create output storage media buffer.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
@@ -4818,74 +4864,64 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to write to export handle.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
+/* TODO: if storage media buffer can be passed on do not release it */
+		if( export_handle->digest_threads != NULL )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+			/* The digest threads update the integrity hashes while the next buffer is written
+			 * and release the buffer onto the queue
+			 */
+			result = digest_threads_push_buffer(
+			          export_handle->digest_threads,
+			          storage_media_buffer,
+			          digest_data_size,
+			          &error );
 
 			storage_media_buffer = NULL;
 
-			goto on_error;
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push storage media buffer onto digest threads.",
+				 function );
+
+				goto on_error;
+			}
 		}
-		if( libcdata_list_remove_element(
-		     export_handle->output_list,
-		     element,
-		     &error ) != 1 )
+		else
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
+			/* The buffers are released onto the queue in batches
+			 */
+			released_buffers[ number_of_released_buffers++ ] = storage_media_buffer;
 
 			storage_media_buffer = NULL;
 
-			goto on_error;
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+			if( number_of_released_buffers == STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_BATCH_SIZE )
+			{
+				if( storage_media_buffer_queue_release_buffers(
+				     export_handle->storage_media_buffer_queue,
+				     released_buffers,
+				     number_of_released_buffers,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to release storage media buffers onto queue.",
+					 function );
 
-			goto on_error;
-		}
-/* TODO: if storage media buffer can be passed on do not release it */
-		if( storage_media_buffer_queue_release_buffer(
-		     export_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
+					number_of_released_buffers = 0;
 
-			goto on_error;
+					goto on_error;
+				}
+				number_of_released_buffers = 0;
+			}
 		}
-		storage_media_buffer = NULL;
 
 /* TODO: if storage media buffer can be passed on do not free it */
 		if( output_storage_media_buffer != NULL )
@@ -4904,8 +4940,6 @@ int export_handle_output_storage_media_buffer_callback(
 				goto on_error;
 			}
 		}
-		element = next_element;
-
 		if( process_status_update(
 		     export_handle->process_status,
 		     export_handle->last_offset_hashed,
@@ -4922,9 +4956,37 @@ int export_handle_output_storage_media_buffer_callback(
 			goto on_error;
 		}
 	}
+	if( number_of_released_buffers > 0 )
+	{
+		if( storage_media_buffer_queue_release_buffers(
+		     export_handle->storage_media_buffer_queue,
+		     released_buffers,
+		     number_of_released_buffers,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffers onto queue.",
+			 function );
+
+			number_of_released_buffers = 0;
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
+	if( number_of_released_buffers > 0 )
+	{
+		storage_media_buffer_queue_release_buffers(
+		 export_handle->storage_media_buffer_queue,
+		 released_buffers,
+		 number_of_released_buffers,
+		 NULL );
+	}
 	if( storage_media_buffer != NULL )
 	{
 		if( storage_media_buffer_queue_release_buffer(
@@ -4972,17 +5034,16 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Empties the output reorder ring
  * Returns 1 if successful or -1 on error
  */
-int export_handle_empty_output_list(
+int export_handle_empty_output_reorder_ring(
      export_handle_t *export_handle,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
 	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "export_handle_empty_output_list";
+        static char *function                        = "export_handle_empty_output_reorder_ring";
+	int result                                   = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4995,110 +5056,251 @@ int export_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     export_handle->output_list,
-	     &element,
-	     error ) != 1 )
+	do
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		result = reorder_ring_remove_value(
+		          export_handle->output_reorder_ring,
+		          (intptr_t **) &storage_media_buffer,
+		          error );
 
-		return( -1 );
-	}
-	while( element != NULL )
-	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove storage media buffer from output reorder ring.",
 			 function );
 
 			return( -1 );
 		}
-		if( storage_media_buffer == NULL )
+		else if( result != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
+			if( storage_media_buffer_queue_release_buffer(
+			     export_handle->storage_media_buffer_queue,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to release storage media buffer onto queue.",
+				 function );
 
-			return( -1 );
+				return( -1 );
+			}
+			storage_media_buffer = NULL;
 		}
-		if( storage_media_buffer_queue_release_buffer(
-		     export_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
+	}
+	while( result != 0 );
+
+	return( 1 );
+}
+
+/* Creates the digest threads
+ * Every integrity hash that is calculated and the chunk hash tree are updated on their own thread
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_initialize_digest_threads(
+     export_handle_t *export_handle,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_initialize_digest_threads";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->digest_threads != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - digest threads value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_handle->calculate_md5 == 0 )
+	 && ( export_handle->calculate_sha1 == 0 )
+	 && ( export_handle->calculate_sha256 == 0 )
+	 && ( export_handle->chunk_hash_tree == NULL ) )
+	{
+		return( 1 );
+	}
+	if( digest_threads_initialize(
+	     &( export_handle->digest_threads ),
+	     maximum_number_of_queued_items,
+	     (int (*)(storage_media_buffer_t *, void *)) &export_handle_digested_storage_media_buffer_callback,
+	     (void *) export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create digest threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->calculate_md5 != 0 )
+	{
+		if( digest_threads_append_digest(
+		     export_handle->digest_threads,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_md5_update,
+		     (intptr_t *) export_handle->md5_context,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append MD5 digest thread.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		storage_media_buffer = NULL;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
+	}
+	if( export_handle->calculate_sha1 != 0 )
+	{
+		if( digest_threads_append_digest(
+		     export_handle->digest_threads,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha1_update,
+		     (intptr_t *) export_handle->sha1_context,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append SHA1 digest thread.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( libcdata_list_remove_element(
-		     export_handle->output_list,
-		     element,
+	}
+	if( export_handle->calculate_sha256 != 0 )
+	{
+		if( digest_threads_append_digest(
+		     export_handle->digest_threads,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha256_update,
+		     (intptr_t *) export_handle->sha256_context,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append SHA256 digest thread.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
+	}
+	if( export_handle->chunk_hash_tree != NULL )
+	{
+		if( digest_threads_append_digest(
+		     export_handle->digest_threads,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &chunk_hash_tree_update,
+		     (intptr_t *) export_handle->chunk_hash_tree,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append chunk hash tree digest thread.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		element = next_element;
 	}
 	return( 1 );
+
+on_error:
+	if( export_handle->digest_threads != NULL )
+	{
+		digest_threads_free(
+		 &( export_handle->digest_threads ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases a storage media buffer onto the queue after the integrity hashes were updated
+ * Callback function for the digest threads
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_digested_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     export_handle_t *export_handle )
+{
+        libcerror_error_t *error = NULL;
+        static char *function    = "export_handle_digested_storage_media_buffer_callback";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( storage_media_buffer_queue_release_buffer(
+	     export_handle->storage_media_buffer_queue,
+	     storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to release storage media buffer onto queue.",
+		 function );
+
+		storage_media_buffer_free(
+		 &storage_media_buffer,
+		 NULL );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( ( export_handle != NULL )
+	 && ( export_handle->abort == 0 ) )
+	{
+		export_handle_signal_abort(
+		 export_handle,
+		 NULL );
+	}
+	return( -1 );
 }
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
@@ -5124,6 +5326,7 @@ int export_handle_export_input(
 	ssize_t process_count                               = 0;
 	ssize_t read_count                                  = 0;
 	ssize_t write_count                                 = 0;
+	uint64_t sequence_number                            = 0;
 	off64_t input_storage_media_offset                  = 0;
 	uint8_t storage_media_buffer_mode                   = 0;
 	int maximum_number_of_queued_items                  = 0;
@@ -5302,15 +5505,18 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( export_handle->output_list ),
+		/* There cannot be more buffers outstanding than there are buffers in the storage media buffer queue
+		 */
+		if( reorder_ring_initialize(
+		     &( export_handle->output_reorder_ring ),
+		     maximum_number_of_queued_items,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to create output reorder ring.",
 			 function );
 
 			goto on_error;
@@ -5350,6 +5556,26 @@ int export_handle_export_input(
 
 		goto on_error;
         }
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_threads != 0 )
+	{
+		if( export_handle_initialize_digest_threads(
+		     export_handle,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 	if( process_status_initialize(
 	     &( export_handle->process_status ),
 	     _SYSTEM_STRING( "Export" ),
@@ -5436,6 +5662,7 @@ int export_handle_export_input(
 
 				goto on_error;
 			}
+			input_storage_media_buffer->sequence_number = sequence_number++;
 		}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
@@ -5728,9 +5955,40 @@ int export_handle_export_input(
 			goto on_error;
 		}
 	}
-	if( export_handle->output_list != NULL )
+	/* The digest threads are joined after the output thread that feeds them
+	 */
+	if( export_handle->digest_threads != NULL )
+	{
+		if( digest_threads_join(
+		     export_handle->digest_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest threads.",
+			 function );
+
+			goto on_error;
+		}
+		if( digest_threads_free(
+		     &( export_handle->digest_threads ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->output_reorder_ring != NULL )
 	{
-		if( export_handle_empty_output_list(
+		if( export_handle_empty_output_reorder_ring(
 		     export_handle,
 		     error ) != 1 )
 		{
@@ -5738,21 +5996,20 @@ int export_handle_export_input(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to empty output reorder ring.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( export_handle->output_list ),
-		     NULL,
+		if( reorder_ring_free(
+		     &( export_handle->output_reorder_ring ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free output reorder ring.",
 			 function );
 
 			goto on_error;
@@ -5789,6 +6046,40 @@ int export_handle_export_input(
 
 		goto on_error;
 	}
+	/* The chunk hash tree is only written if all the media data was hashed
+	 */
+	if( ( export_handle->chunk_hash_tree != NULL )
+	 && ( export_handle->abort == 0 ) )
+	{
+		if( chunk_hash_tree_finalize(
+		     export_handle->chunk_hash_tree,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize chunk hash tree.",
+			 function );
+
+			goto on_error;
+		}
+		if( chunk_hash_tree_write_file(
+		     export_handle->chunk_hash_tree,
+		     export_handle->chunk_hash_tree_filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk hash tree file: %" PRIs_SYSTEM ".",
+			 function,
+			 export_handle->chunk_hash_tree_filename );
+
+			goto on_error;
+		}
+	}
 	write_count = export_handle_finalize(
 	               export_handle,
 	               error );
@@ -5938,14 +6229,19 @@ on_error:
 		 &( export_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( export_handle->output_list != NULL )
+	if( export_handle->digest_threads != NULL )
+	{
+		digest_threads_free(
+		 &( export_handle->digest_threads ),
+		 NULL );
+	}
+	if( export_handle->output_reorder_ring != NULL )
 	{
-		export_handle_empty_output_list(
+		export_handle_empty_output_reorder_ring(
 		 export_handle,
 		 NULL );
-		libcdata_list_free(
-		 &( export_handle->output_list ),
-		 NULL,
+		reorder_ring_free(
+		 &( export_handle->output_reorder_ring ),
 		 NULL );
 	}
 	if( export_handle->storage_media_buffer_queue != NULL )
@@ -25,7 +25,9 @@
 #include <common.h>
 #include <types.h>
 
+#include "chunk_hash_tree.h"
 #include "digest_hash.h"
+#include "digest_threads.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -34,7 +36,9 @@
 #include "ewftools_libsmraw.h"
 #include "log_handle.h"
 #include "process_status.h"
+#include "reorder_ring.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -155,6 +159,14 @@ struct export_handle
 	 */
 	system_character_t *calculated_sha256_hash_string;
 
+	/* The chunk hash tree filename
+	 */
+	const system_character_t *chunk_hash_tree_filename;
+
+	/* The chunk hash tree
+	 */
+	chunk_hash_tree_t *chunk_hash_tree;
+
 	/* Value to indicate if the data chunk functions instead of the buffered read and write functions should be used
 	 */
 	uint8_t use_data_chunk_functions;
@@ -177,13 +189,17 @@ struct export_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The output reorder ring
 	 */
-	libcdata_list_t *output_list;
+	reorder_ring_t *output_reorder_ring;
 
 	/* The storage media buffer queue
 	 */
-	libcthreads_queue_t *storage_media_buffer_queue;
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The digest threads
+	 */
+	digest_threads_t *digest_threads;
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
@@ -486,10 +502,19 @@ int export_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle );
 
-int export_handle_empty_output_list(
+int export_handle_empty_output_reorder_ring(
      export_handle_t *export_handle,
      libcerror_error_t **error );
 
+int export_handle_initialize_digest_threads(
+     export_handle_t *export_handle,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error );
+
+int export_handle_digested_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     export_handle_t *export_handle );
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 int export_handle_export_input(
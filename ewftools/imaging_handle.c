@@ -34,6 +34,7 @@
 #endif
 
 #include "byte_size_string.h"
+#include "chunk_hash_tree.h"
 #include "digest_hash.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
@@ -357,6 +358,22 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->calculated_sha256_hash_string );
 		}
+		if( ( *imaging_handle )->chunk_hash_tree != NULL )
+		{
+			if( chunk_hash_tree_free(
+			     &( ( *imaging_handle )->chunk_hash_tree ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk hash tree.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libewf_handle_free(
 		     &( ( *imaging_handle )->output_handle ),
 		     error ) != 1 )
@@ -646,6 +663,23 @@ int imaging_handle_open_output(
 		libewf_filenames = filenames;
 		access_flags     = LIBEWF_OPEN_WRITE;
 	}
+	if( imaging_handle->use_direct_io != 0 )
+	{
+		if( libewf_handle_set_use_direct_io(
+		     imaging_handle->output_handle,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set use direct IO.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     imaging_handle->output_handle,
@@ -819,6 +853,23 @@ int imaging_handle_open_secondary_output(
 
 		goto on_error;
 	}
+	if( imaging_handle->use_direct_io != 0 )
+	{
+		if( libewf_handle_set_use_direct_io(
+		     imaging_handle->secondary_output_handle,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set use direct IO of secondary output handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     imaging_handle->secondary_output_handle,
@@ -1293,6 +1344,8 @@ int imaging_handle_initialize_integrity_hash(
      libcerror_error_t **error )
 {
 	static char *function = "imaging_handle_initialize_integrity_hash";
+	uint64_t chunk_size   = 0;
+	size32_t leaf_size    = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1356,9 +1409,60 @@ int imaging_handle_initialize_integrity_hash(
 		}
 		imaging_handle->sha256_context_initialized = 1;
 	}
+	if( imaging_handle->chunk_hash_tree_filename != NULL )
+	{
+		chunk_size = (uint64_t) imaging_handle->bytes_per_sector * imaging_handle->sectors_per_chunk;
+
+		if( chunk_size > (uint64_t) UINT32_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( chunk_hash_tree_calculate_leaf_size(
+		     (size32_t) chunk_size,
+		     &leaf_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine chunk hash tree leaf size.",
+			 function );
+
+			goto on_error;
+		}
+		if( chunk_hash_tree_initialize(
+		     &( imaging_handle->chunk_hash_tree ),
+		     (size64_t) imaging_handle->acquiry_size,
+		     leaf_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk hash tree.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
+	if( imaging_handle->sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &( imaging_handle->sha256_context ),
+		 NULL );
+	}
 	if( imaging_handle->sha1_context != NULL )
 	{
 		libhmac_sha1_free(
@@ -1473,6 +1577,24 @@ int imaging_handle_update_integrity_hash(
 			return( -1 );
 		}
 	}
+	if( imaging_handle->chunk_hash_tree != NULL )
+	{
+		if( chunk_hash_tree_update(
+		     imaging_handle->chunk_hash_tree,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update chunk hash tree.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -1701,6 +1823,24 @@ int imaging_handle_threads_start(
 
 		goto on_error;
 	}
+	/* The digests are appended when the integrity hashes are initialized
+	 */
+	if( digest_threads_initialize(
+	     &( imaging_handle->digest_threads ),
+	     maximum_number_of_queued_items,
+	     (int (*)(storage_media_buffer_t *, void *)) &imaging_handle_digested_storage_media_buffer_callback,
+	     (void *) imaging_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create digest threads.",
+		 function );
+
+		goto on_error;
+	}
 	if( libcdata_list_initialize(
 	     &( imaging_handle->output_list ),
 	     error ) != 1 )
@@ -1734,6 +1874,12 @@ int imaging_handle_threads_start(
 	return( 1 );
 
 on_error:
+	if( imaging_handle->digest_threads != NULL )
+	{
+		digest_threads_free(
+		 &( imaging_handle->digest_threads ),
+		 NULL );
+	}
 	if( imaging_handle->process_thread_pool != NULL )
 	{
 		libcthreads_thread_pool_join(
@@ -1786,6 +1932,37 @@ int imaging_handle_threads_stop(
 
 		return( -1 );
 	}
+	/* The digest threads are joined before the process threads they feed
+	 */
+	if( imaging_handle->digest_threads != NULL )
+	{
+		if( digest_threads_join(
+		     imaging_handle->digest_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest threads.",
+			 function );
+
+			result = -1;
+		}
+		if( digest_threads_free(
+		     &( imaging_handle->digest_threads ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest threads.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( imaging_handle->process_thread_pool != NULL )
 	{
 		if( libcthreads_thread_pool_join(
@@ -1867,6 +2044,198 @@ int imaging_handle_threads_stop(
 	return( result );
 }
 
+/* Appends the digests to the digest threads
+ * Every integrity hash that is calculated and the chunk hash tree are updated on their own thread
+ * The integrity hashes must be initialized before the digests are appended
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_append_digest_threads(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_append_digest_threads";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->digest_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid imaging handle - missing digest threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->calculate_md5 != 0 )
+	{
+		if( digest_threads_append_digest(
+		     imaging_handle->digest_threads,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_md5_update,
+		     (intptr_t *) imaging_handle->md5_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append MD5 digest thread.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( imaging_handle->calculate_sha1 != 0 )
+	{
+		if( digest_threads_append_digest(
+		     imaging_handle->digest_threads,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha1_update,
+		     (intptr_t *) imaging_handle->sha1_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append SHA1 digest thread.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( imaging_handle->calculate_sha256 != 0 )
+	{
+		if( digest_threads_append_digest(
+		     imaging_handle->digest_threads,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha256_update,
+		     (intptr_t *) imaging_handle->sha256_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append SHA256 digest thread.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( imaging_handle->chunk_hash_tree != NULL )
+	{
+		if( digest_threads_append_digest(
+		     imaging_handle->digest_threads,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &chunk_hash_tree_update,
+		     (intptr_t *) imaging_handle->chunk_hash_tree,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append chunk hash tree digest thread.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Passes a storage media buffer on to the process thread pool after the integrity hashes were updated
+ * Callback function for the digest threads
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_digested_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle )
+{
+        libcerror_error_t *error = NULL;
+        static char *function    = "imaging_handle_digested_storage_media_buffer_callback";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* The integrity hashes are calculated before the buffer is processed
+	 * since processing can compress the data in place
+	 */
+	if( libcthreads_thread_pool_push(
+	     imaging_handle->process_thread_pool,
+	     (intptr_t *) storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto process thread pool queue.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( ( imaging_handle != NULL )
+	 && ( storage_media_buffer != NULL ) )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     imaging_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
+
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( ( imaging_handle != NULL )
+	 && ( imaging_handle->abort == 0 ) )
+	{
+		imaging_handle_signal_abort(
+		 imaging_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Prepares a storage media buffer for imaging
  * Callback function for the process thread pool
  * Returns 1 if successful or -1 on error
@@ -6077,6 +6446,25 @@ int imaging_handle_start(
 
 		goto on_error;
         }
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_threads != NULL )
+	{
+		if( imaging_handle_append_digest_threads(
+		     imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append digest threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 	if( process_status_initialize(
 	     &( imaging_handle->process_status ),
 	     _SYSTEM_STRING( "Acquiry" ),
@@ -6209,21 +6597,25 @@ int imaging_handle_update(
 		}
 	}
 	/* Integrity (digest) hashes are calcultated after swap
+	 * with threads the digest threads calculate them when the buffer is pushed
 	 */
-	if( imaging_handle_update_integrity_hash(
-	     imaging_handle,
-	     data,
-	     (size_t) read_count,
-	     error ) != 1 )
+	if( imaging_handle->number_of_threads == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GENERIC,
-		 "%s: unable to update integrity hash(es).",
-		 function );
+		if( imaging_handle_update_integrity_hash(
+		     imaging_handle,
+		     data,
+		     (size_t) read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to update integrity hash(es).",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
 	}
 	if( imaging_handle->last_offset_written < resume_acquiry_offset )
 	{
@@ -6335,6 +6727,41 @@ int imaging_handle_stop(
 
 		return( -1 );
 	}
+	/* The chunk hash tree is only written if all the media data was hashed
+	 */
+	if( ( imaging_handle->chunk_hash_tree != NULL )
+	 && ( imaging_handle->abort == 0 )
+	 && ( status == PROCESS_STATUS_COMPLETED ) )
+	{
+		if( chunk_hash_tree_finalize(
+		     imaging_handle->chunk_hash_tree,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize chunk hash tree.",
+			 function );
+
+			return( -1 );
+		}
+		if( chunk_hash_tree_write_file(
+		     imaging_handle->chunk_hash_tree,
+		     imaging_handle->chunk_hash_tree_filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk hash tree file: %" PRIs_SYSTEM ".",
+			 function,
+			 imaging_handle->chunk_hash_tree_filename );
+
+			return( -1 );
+		}
+	}
 	if( imaging_handle->last_offset_written >= resume_acquiry_offset )
 	{
 		if( imaging_handle->calculate_md5 != 0 )
@@ -26,6 +26,8 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "chunk_hash_tree.h"
+#include "digest_threads.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -33,6 +35,7 @@
 #include "ewftools_libhmac.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -202,10 +205,22 @@ struct imaging_handle
 	 */
 	system_character_t *calculated_sha256_hash_string;
 
+	/* The chunk hash tree filename
+	 */
+	const system_character_t *chunk_hash_tree_filename;
+
+	/* The chunk hash tree
+	 */
+	chunk_hash_tree_t *chunk_hash_tree;
+
 	/* Value to indicate if the data chunk functions instead of the buffered read and write functions should be used
 	 */
 	uint8_t use_data_chunk_functions;
 
+	/* Value to indicate if the output segment files should be written using direct (unbuffered) IO
+	 */
+	uint8_t use_direct_io;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -230,7 +245,11 @@ struct imaging_handle
 
 	/* The storage media buffer queue
 	 */
-	libcthreads_queue_t *storage_media_buffer_queue;
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The digest threads
+	 */
+	digest_threads_t *digest_threads;
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
@@ -352,6 +371,14 @@ int imaging_handle_threads_stop(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
 
+int imaging_handle_append_digest_threads(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
+int imaging_handle_digested_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle );
+
 int imaging_handle_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle );
@@ -34,6 +34,7 @@
 #include "ewftools_libewf.h"
 #include "mount_file_entry.h"
 #include "mount_file_system.h"
+#include "mount_read_ahead_cache.h"
 
 #if !defined( S_IFDIR )
 #define S_IFDIR 0x4000
@@ -1090,6 +1091,10 @@ on_error:
 }
 
 /* Reads data at a specific offset
+ * Reads of the media data use a reader handle of the file system if available
+ * so that multiple reads can be served concurrently
+ * Reads of the media data are served from the read-ahead cache of the file system
+ * if available, where sequential reads cause the following data to be read ahead
  * Returns the number of bytes read or -1 on error
  */
 ssize_t mount_file_entry_read_buffer_at_offset(
@@ -1099,8 +1104,15 @@ ssize_t mount_file_entry_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error )
 {
-	static char *function = "mount_file_entry_read_buffer_at_offset";
-	ssize_t read_count    = 0;
+	libewf_handle_t *ewf_handle = NULL;
+	static char *function       = "mount_file_entry_read_buffer_at_offset";
+	size_t buffer_offset        = 0;
+	ssize_t read_count          = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libewf_handle_t *reader_handle = NULL;
+	int result                     = 0;
+#endif
 
 	if( file_entry == NULL )
 	{
@@ -1138,13 +1150,90 @@ ssize_t mount_file_entry_read_buffer_at_offset(
 	}
 	else
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( file_entry->file_system->read_ahead_cache != NULL )
+		{
+			read_count = mount_read_ahead_cache_read_buffer_at_offset(
+			              file_entry->file_system->read_ahead_cache,
+			              &( file_entry->read_ahead_stream ),
+			              (uint8_t *) buffer,
+			              buffer_size,
+			              offset,
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from read-ahead cache.",
+				 function,
+				 offset,
+				 offset );
+
+				return( -1 );
+			}
+			buffer_offset = (size_t) read_count;
+
+			if( buffer_offset == buffer_size )
+			{
+				return( read_count );
+			}
+		}
+#endif
+		ewf_handle = file_entry->ewf_handle;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		result = mount_file_system_grab_reader_handle(
+		          file_entry->file_system,
+		          &reader_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab reader handle from file system.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			ewf_handle = reader_handle;
+		}
+#endif
+		/* The part of the buffer that was not available in the read-ahead cache
+		 */
 		read_count = libewf_handle_read_buffer_at_offset(
-		              file_entry->ewf_handle,
-		              buffer,
-		              buffer_size,
-		              offset,
+		              ewf_handle,
+		              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		              buffer_size - buffer_offset,
+		              offset + (off64_t) buffer_offset,
 		              error );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( reader_handle != NULL )
+		{
+			if( mount_file_system_release_reader_handle(
+			     file_entry->file_system,
+			     reader_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release reader handle to file system.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
 		if( read_count < 0 )
 		{
 			libcerror_error_set(
@@ -1158,6 +1247,7 @@ ssize_t mount_file_entry_read_buffer_at_offset(
 
 			return( -1 );
 		}
+		read_count += (ssize_t) buffer_offset;
 	}
 	return( read_count );
 }
@@ -28,6 +28,7 @@
 #include "ewftools_libcerror.h"
 #include "ewftools_libewf.h"
 #include "mount_file_system.h"
+#include "mount_read_ahead_cache.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -67,6 +68,14 @@ struct mount_file_entry
 	/* The file entry
 	 */
 	libewf_file_entry_t *ewf_file_entry;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	/* The access pattern of reads of the handle, used to detect sequential streams
+	 */
+	mount_read_ahead_stream_t read_ahead_stream;
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 };
 
 int mount_file_entry_initialize(
@@ -44,6 +44,7 @@
 #include "ewftools_libewf.h"
 #include "ewftools_libuna.h"
 #include "mount_file_system.h"
+#include "mount_read_ahead_cache.h"
 
 /* Creates a file system
  * Make sure the value file_system is referencing, is set to NULL
@@ -234,6 +235,34 @@ int mount_file_system_free(
 	}
 	if( *file_system != NULL )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( mount_file_system_free_read_ahead_cache(
+		     *file_system,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead cache.",
+			 function );
+
+			result = -1;
+		}
+		if( mount_file_system_free_reader_handles(
+		     *file_system,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reader handles.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		if( ( *file_system )->path_prefix != NULL )
 		{
 			memory_free(
@@ -349,6 +378,441 @@ int mount_file_system_get_handle(
 	return( 1 );
 }
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Initializes the reader handles
+ * Every reader handle shares the image state of the handle but has its own
+ * read IO handle, so that reads of the media data can be served concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_initialize_reader_handles(
+     mount_file_system_t *file_system,
+     int number_of_reader_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_initialize_reader_handles";
+	size_t handles_size   = 0;
+	int handle_index      = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->ewf_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system - missing handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->reader_handles != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file system - reader handles value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_reader_handles <= 0 )
+	 || ( number_of_reader_handles > MOUNT_FILE_SYSTEM_MAXIMUM_NUMBER_OF_READER_HANDLES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of reader handles value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	handles_size = sizeof( libewf_handle_t * ) * number_of_reader_handles;
+
+	file_system->reader_handles = (libewf_handle_t **) memory_allocate(
+	                                                    handles_size );
+
+	if( file_system->reader_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reader handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     file_system->reader_handles,
+	     0,
+	     handles_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reader handles.",
+		 function );
+
+		memory_free(
+		 file_system->reader_handles );
+
+		file_system->reader_handles = NULL;
+
+		return( -1 );
+	}
+	file_system->number_of_reader_handles = number_of_reader_handles;
+
+	if( libcthreads_queue_initialize(
+	     &( file_system->reader_handle_queue ),
+	     number_of_reader_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reader handle queue.",
+		 function );
+
+		goto on_error;
+	}
+	for( handle_index = 0;
+	     handle_index < number_of_reader_handles;
+	     handle_index++ )
+	{
+		if( libewf_handle_clone_reader(
+		     &( file_system->reader_handles[ handle_index ] ),
+		     file_system->ewf_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create reader handle: %d.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+		if( libcthreads_queue_push(
+		     file_system->reader_handle_queue,
+		     (intptr_t *) file_system->reader_handles[ handle_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push reader handle: %d onto queue.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	mount_file_system_free_reader_handles(
+	 file_system,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Frees the reader handles
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_free_reader_handles(
+     mount_file_system_t *file_system,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_free_reader_handles";
+	int handle_index      = 0;
+	int result            = 1;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	/* The reader handle queue does not manage the reader handles
+	 */
+	if( file_system->reader_handle_queue != NULL )
+	{
+		if( libcthreads_queue_free(
+		     &( file_system->reader_handle_queue ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reader handle queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( file_system->reader_handles != NULL )
+	{
+		for( handle_index = 0;
+		     handle_index < file_system->number_of_reader_handles;
+		     handle_index++ )
+		{
+			if( file_system->reader_handles[ handle_index ] == NULL )
+			{
+				continue;
+			}
+			if( libewf_handle_free(
+			     &( file_system->reader_handles[ handle_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free reader handle: %d.",
+				 function,
+				 handle_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 file_system->reader_handles );
+
+		file_system->reader_handles = NULL;
+	}
+	file_system->number_of_reader_handles = 0;
+
+	return( result );
+}
+
+/* Grabs a reader handle
+ * Blocks until a reader handle is available
+ * Returns 1 if successful, 0 if no reader handles are available or -1 on error
+ */
+int mount_file_system_grab_reader_handle(
+     mount_file_system_t *file_system,
+     libewf_handle_t **reader_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_grab_reader_handle";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( reader_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->reader_handle_queue == NULL )
+	{
+		return( 0 );
+	}
+	if( libcthreads_queue_pop(
+	     file_system->reader_handle_queue,
+	     (intptr_t **) reader_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to pop reader handle from queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases a reader handle
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_release_reader_handle(
+     mount_file_system_t *file_system,
+     libewf_handle_t *reader_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_release_reader_handle";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->reader_handle_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system - missing reader handle queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( reader_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_queue_push(
+	     file_system->reader_handle_queue,
+	     (intptr_t *) reader_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push reader handle onto queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Initializes the read-ahead cache
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_initialize_read_ahead_cache(
+     mount_file_system_t *file_system,
+     size64_t cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_initialize_read_ahead_cache";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->ewf_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system - missing handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_read_ahead_cache_initialize(
+	     &( file_system->read_ahead_cache ),
+	     file_system->ewf_handle,
+	     cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read-ahead cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Frees the read-ahead cache
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_free_read_ahead_cache(
+     mount_file_system_t *file_system,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_free_read_ahead_cache";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_read_ahead_cache_free(
+	     &( file_system->read_ahead_cache ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read-ahead cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* Sets the path prefix
  * Returns 1 if successful or -1 on error
  */
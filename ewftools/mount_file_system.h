@@ -26,12 +26,16 @@
 #include <types.h>
 
 #include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
+#include "mount_read_ahead_cache.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+#define MOUNT_FILE_SYSTEM_MAXIMUM_NUMBER_OF_READER_HANDLES	32
+
 typedef struct mount_file_system mount_file_system_t;
 
 struct mount_file_system
@@ -51,6 +55,26 @@ struct mount_file_system
 	/* The handle
 	 */
 	libewf_handle_t *ewf_handle;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	/* The number of reader handles
+	 */
+	int number_of_reader_handles;
+
+	/* The reader handles
+	 */
+	libewf_handle_t **reader_handles;
+
+	/* The reader handle queue
+	 */
+	libcthreads_queue_t *reader_handle_queue;
+
+	/* The read-ahead cache
+	 */
+	mount_read_ahead_cache_t *read_ahead_cache;
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 };
 
 int mount_file_system_initialize(
@@ -75,6 +99,38 @@ int mount_file_system_get_handle(
      libewf_handle_t **ewf_handle,
      libcerror_error_t **error );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int mount_file_system_initialize_reader_handles(
+     mount_file_system_t *file_system,
+     int number_of_reader_handles,
+     libcerror_error_t **error );
+
+int mount_file_system_free_reader_handles(
+     mount_file_system_t *file_system,
+     libcerror_error_t **error );
+
+int mount_file_system_grab_reader_handle(
+     mount_file_system_t *file_system,
+     libewf_handle_t **reader_handle,
+     libcerror_error_t **error );
+
+int mount_file_system_release_reader_handle(
+     mount_file_system_t *file_system,
+     libewf_handle_t *reader_handle,
+     libcerror_error_t **error );
+
+int mount_file_system_initialize_read_ahead_cache(
+     mount_file_system_t *file_system,
+     size64_t cache_size,
+     libcerror_error_t **error );
+
+int mount_file_system_free_read_ahead_cache(
+     mount_file_system_t *file_system,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 int mount_file_system_set_path_prefix(
      mount_file_system_t *file_system,
      const system_character_t *path_prefix,
@@ -26,9 +26,11 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "byte_size_string.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcpath.h"
 #include "ewftools_libewf.h"
+#include "ewftools_system_string.h"
 #include "mount_file_entry.h"
 #include "mount_file_system.h"
 #include "mount_handle.h"
@@ -108,6 +110,10 @@ int mount_handle_initialize(
 	}
 	( *mount_handle )->input_format = MOUNT_HANDLE_INPUT_FORMAT_RAW;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	( *mount_handle )->number_of_reader_handles = 4;
+	( *mount_handle )->read_ahead_cache_size    = 32 * 1024 * 1024;
+#endif
 	return( 1 );
 
 on_error:
@@ -252,6 +258,127 @@ int mount_handle_set_format(
 	return( result );
 }
 
+/* Sets the number of reader handles
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int mount_handle_set_number_of_reader_handles(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function             = "mount_handle_set_number_of_reader_handles";
+	size_t string_length              = 0;
+	uint64_t number_of_reader_handles = 0;
+	int result                        = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_reader_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of reader handles.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_reader_handles > MOUNT_FILE_SYSTEM_MAXIMUM_NUMBER_OF_READER_HANDLES )
+		{
+			result = 0;
+		}
+		else
+		{
+			mount_handle->number_of_reader_handles = (int) number_of_reader_handles;
+		}
+	}
+	return( result );
+}
+
+/* Sets the read-ahead cache size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int mount_handle_set_read_ahead_cache_size(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "mount_handle_set_read_ahead_cache_size";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine read-ahead cache size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( size_variable > (uint64_t) MOUNT_READ_AHEAD_CACHE_MAXIMUM_SIZE )
+		 || ( size_variable > (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+		{
+			result = 0;
+		}
+		else
+		{
+			mount_handle->read_ahead_cache_size = (size64_t) size_variable;
+		}
+#else
+		result = 0;
+#endif
+	}
+	return( result );
+}
+
 /* Sets the maximum number of (concurrent) open file handles
  * Returns 1 if successful or -1 on error
  */
@@ -465,6 +592,60 @@ int mount_handle_open(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The reader handles are only used to read the media data
+	 */
+	if( ( mount_handle->input_format == MOUNT_HANDLE_INPUT_FORMAT_RAW )
+	 && ( mount_handle->number_of_reader_handles > 0 ) )
+	{
+		if( mount_file_system_initialize_reader_handles(
+		     mount_handle->file_system,
+		     mount_handle->number_of_reader_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize reader handles in file system.",
+			 function );
+
+			mount_file_system_set_handle(
+			 mount_handle->file_system,
+			 NULL,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( ( mount_handle->input_format == MOUNT_HANDLE_INPUT_FORMAT_RAW )
+	 && ( mount_handle->read_ahead_cache_size > 0 ) )
+	{
+		if( mount_file_system_initialize_read_ahead_cache(
+		     mount_handle->file_system,
+		     mount_handle->read_ahead_cache_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize read-ahead cache in file system.",
+			 function );
+
+			mount_file_system_free_reader_handles(
+			 mount_handle->file_system,
+			 NULL );
+
+			mount_file_system_set_handle(
+			 mount_handle->file_system,
+			 NULL,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( globbed_filenames != NULL )
 	{
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -536,6 +717,38 @@ int mount_handle_close(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The reader handles, including the one of the read-ahead cache, share
+	 * the image state of the handle and therefore need to be freed before
+	 * the handle is closed
+	 */
+	if( mount_file_system_free_read_ahead_cache(
+	     mount_handle->file_system,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read-ahead cache in file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_file_system_free_reader_handles(
+	     mount_handle->file_system,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free reader handles in file system.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	if( mount_file_system_get_handle(
 	     mount_handle->file_system,
 	     &ewf_handle,
@@ -57,6 +57,14 @@ struct mount_handle
 	 */
 	int maximum_number_of_open_handles;
 
+	/* The number of reader handles used to read the media data concurrently
+	 */
+	int number_of_reader_handles;
+
+	/* The size of the read-ahead cache used for sequential reads of the media data
+	 */
+	size64_t read_ahead_cache_size;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -79,6 +87,16 @@ int mount_handle_set_format(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int mount_handle_set_number_of_reader_handles(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int mount_handle_set_read_ahead_cache_size(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int mount_handle_set_maximum_number_of_open_handles(
      mount_handle_t *mount_handle,
      int maximum_number_of_open_handles,
@@ -0,0 +1,903 @@
+/*
+ * Mount read-ahead cache
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "mount_read_ahead_cache.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a read-ahead cache
+ * Make sure the value read_ahead_cache is referencing, is set to NULL
+ * The cache consists of chunk sized blocks where the block of a chunk is
+ * determined by the chunk index modulo the number of blocks
+ * Returns 1 if successful or -1 on error
+ */
+int mount_read_ahead_cache_initialize(
+     mount_read_ahead_cache_t **read_ahead_cache,
+     libewf_handle_t *ewf_handle,
+     size64_t cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_read_ahead_cache_initialize";
+	size_t blocks_size    = 0;
+	size32_t chunk_size   = 0;
+	int block_index       = 0;
+
+	if( read_ahead_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read-ahead cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewf_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( cache_size > (size64_t) MOUNT_READ_AHEAD_CACHE_MAXIMUM_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid cache size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*read_ahead_cache = memory_allocate_structure(
+	                     mount_read_ahead_cache_t );
+
+	if( *read_ahead_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read-ahead cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_ahead_cache,
+	     0,
+	     sizeof( mount_read_ahead_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read-ahead cache.",
+		 function );
+
+		memory_free(
+		 *read_ahead_cache );
+
+		*read_ahead_cache = NULL;
+
+		return( -1 );
+	}
+	if( libewf_handle_get_chunk_size(
+	     ewf_handle,
+	     &chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size.",
+		 function );
+
+		goto on_error;
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     ewf_handle,
+	     &( ( *read_ahead_cache )->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_ahead_cache )->block_size       = (size_t) chunk_size;
+	( *read_ahead_cache )->number_of_blocks = (int) ( cache_size / chunk_size );
+
+	if( ( *read_ahead_cache )->number_of_blocks < MOUNT_READ_AHEAD_CACHE_MINIMUM_NUMBER_OF_BLOCKS )
+	{
+		( *read_ahead_cache )->number_of_blocks = MOUNT_READ_AHEAD_CACHE_MINIMUM_NUMBER_OF_BLOCKS;
+	}
+	/* Only read ahead up to half of the blocks so that the blocks just read
+	 * are not reused before a sequential read has copied them
+	 */
+	( *read_ahead_cache )->number_of_read_ahead_blocks = ( *read_ahead_cache )->number_of_blocks / 2;
+
+	if( ( *read_ahead_cache )->block_size > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / (size_t) ( *read_ahead_cache )->number_of_blocks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read-ahead cache - blocks data size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	blocks_size = sizeof( mount_read_ahead_cache_block_t ) * ( *read_ahead_cache )->number_of_blocks;
+
+	( *read_ahead_cache )->blocks = (mount_read_ahead_cache_block_t *) memory_allocate(
+	                                                                    blocks_size );
+
+	if( ( *read_ahead_cache )->blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create blocks.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *read_ahead_cache )->blocks,
+	     0,
+	     blocks_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear blocks.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_ahead_cache )->blocks_data = (uint8_t *) memory_allocate(
+	                                                  ( *read_ahead_cache )->block_size * ( *read_ahead_cache )->number_of_blocks );
+
+	if( ( *read_ahead_cache )->blocks_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create blocks data.",
+		 function );
+
+		goto on_error;
+	}
+	for( block_index = 0;
+	     block_index < ( *read_ahead_cache )->number_of_blocks;
+	     block_index++ )
+	{
+		( *read_ahead_cache )->blocks[ block_index ].data  = &( ( ( *read_ahead_cache )->blocks_data )[ ( *read_ahead_cache )->block_size * block_index ] );
+		( *read_ahead_cache )->blocks[ block_index ].state = MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_EMPTY;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_ahead_cache )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *read_ahead_cache )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_clone_reader(
+	     &( ( *read_ahead_cache )->reader_handle ),
+	     ewf_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reader handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* A single read thread is used since the reader handle is not shared
+	 * and at most every block can be pending hence a push never blocks
+	 */
+	if( libcthreads_thread_pool_create(
+	     &( ( *read_ahead_cache )->read_thread_pool ),
+	     NULL,
+	     1,
+	     ( *read_ahead_cache )->number_of_blocks,
+	     (int (*)(intptr_t *, void *)) &mount_read_ahead_cache_read_block_callback,
+	     (void *) *read_ahead_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *read_ahead_cache != NULL )
+	{
+		if( ( *read_ahead_cache )->reader_handle != NULL )
+		{
+			libewf_handle_free(
+			 &( ( *read_ahead_cache )->reader_handle ),
+			 NULL );
+		}
+		if( ( *read_ahead_cache )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *read_ahead_cache )->condition ),
+			 NULL );
+		}
+		if( ( *read_ahead_cache )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *read_ahead_cache )->mutex ),
+			 NULL );
+		}
+		if( ( *read_ahead_cache )->blocks_data != NULL )
+		{
+			memory_free(
+			 ( *read_ahead_cache )->blocks_data );
+		}
+		if( ( *read_ahead_cache )->blocks != NULL )
+		{
+			memory_free(
+			 ( *read_ahead_cache )->blocks );
+		}
+		memory_free(
+		 *read_ahead_cache );
+
+		*read_ahead_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read-ahead cache
+ * Returns 1 if successful or -1 on error
+ */
+int mount_read_ahead_cache_free(
+     mount_read_ahead_cache_t **read_ahead_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_read_ahead_cache_free";
+	int result            = 1;
+
+	if( read_ahead_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead_cache != NULL )
+	{
+		/* The read thread skips the blocks that are still queued
+		 * once abort is signalled
+		 */
+		( *read_ahead_cache )->abort = 1;
+
+		if( libcthreads_thread_pool_join(
+		     &( ( *read_ahead_cache )->read_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read thread pool.",
+			 function );
+
+			result = -1;
+		}
+		if( libewf_handle_free(
+		     &( ( *read_ahead_cache )->reader_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reader handle.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *read_ahead_cache )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *read_ahead_cache )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *read_ahead_cache )->blocks_data );
+
+		memory_free(
+		 ( *read_ahead_cache )->blocks );
+
+		memory_free(
+		 *read_ahead_cache );
+
+		*read_ahead_cache = NULL;
+	}
+	return( result );
+}
+
+/* Reads the data of a pending block
+ * Callback function for the read thread pool
+ * A block that cannot be read is marked empty so that the data is read
+ * directly by the file entry, which reports the error
+ * Returns 1 if successful or -1 on error
+ */
+int mount_read_ahead_cache_read_block_callback(
+     mount_read_ahead_cache_block_t *block,
+     mount_read_ahead_cache_t *read_ahead_cache )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "mount_read_ahead_cache_read_block_callback";
+	ssize_t read_count       = 0;
+	int result               = 1;
+
+	if( block == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_ahead_cache == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead cache.",
+		 function );
+
+		goto on_error;
+	}
+	/* The data of a pending block is only accessed by the read thread
+	 */
+	if( read_ahead_cache->abort == 0 )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              read_ahead_cache->reader_handle,
+		              block->data,
+		              read_ahead_cache->block_size,
+		              block->offset,
+		              &error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 block->offset,
+			 block->offset );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_print_error_backtrace(
+				 error );
+			}
+#endif
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead_cache->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		/* Mark the block empty and wake the waiting readers regardless
+		 * so that they do not wait for a block that will not become valid
+		 */
+		block->data_size = 0;
+		block->state     = MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_EMPTY;
+
+		libcthreads_condition_broadcast(
+		 read_ahead_cache->condition,
+		 NULL );
+
+		goto on_error;
+	}
+	if( read_count > 0 )
+	{
+		block->data_size = (size_t) read_count;
+		block->state     = MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_VALID;
+	}
+	else
+	{
+		block->data_size = 0;
+		block->state     = MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_EMPTY;
+	}
+	if( libcthreads_condition_broadcast(
+	     read_ahead_cache->condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead_cache->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Schedules the blocks following a sequential read to be read ahead
+ * The mutex must be held by the caller
+ * Blocks that are already valid or pending for the same offset are not scheduled again
+ * and a block that is pending for another offset is not reused
+ * Returns 1 if successful or -1 on error
+ */
+int mount_read_ahead_cache_schedule_blocks(
+     mount_read_ahead_cache_t *read_ahead_cache,
+     mount_read_ahead_stream_t *read_ahead_stream,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	mount_read_ahead_cache_block_t *block = NULL;
+	static char *function                 = "mount_read_ahead_cache_schedule_blocks";
+	off64_t block_offset                  = 0;
+	off64_t read_ahead_end_offset         = 0;
+	uint64_t block_number                 = 0;
+
+	if( read_ahead_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	read_ahead_end_offset = offset + (off64_t) ( read_ahead_cache->block_size * read_ahead_cache->number_of_read_ahead_blocks );
+
+	if( read_ahead_end_offset > (off64_t) read_ahead_cache->media_size )
+	{
+		read_ahead_end_offset = (off64_t) read_ahead_cache->media_size;
+	}
+	/* Only the blocks beyond the ones scheduled by the previous read of the stream are considered
+	 */
+	if( read_ahead_stream->read_ahead_offset > offset )
+	{
+		offset = read_ahead_stream->read_ahead_offset;
+	}
+	block_number = (uint64_t) offset / read_ahead_cache->block_size;
+	block_offset = (off64_t) ( block_number * read_ahead_cache->block_size );
+
+	while( block_offset < read_ahead_end_offset )
+	{
+		block = &( read_ahead_cache->blocks[ block_number % read_ahead_cache->number_of_blocks ] );
+
+		if( ( ( block->offset != block_offset )
+		  || ( block->state == MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_EMPTY ) )
+		 && ( block->state != MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_PENDING ) )
+		{
+			block->offset    = block_offset;
+			block->data_size = 0;
+			block->state     = MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_PENDING;
+
+			if( libcthreads_thread_pool_push(
+			     read_ahead_cache->read_thread_pool,
+			     (intptr_t *) block,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push block onto read thread pool queue.",
+				 function );
+
+				block->state = MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_EMPTY;
+
+				return( -1 );
+			}
+		}
+		block_number += 1;
+		block_offset += (off64_t) read_ahead_cache->block_size;
+	}
+	if( read_ahead_end_offset > read_ahead_stream->read_ahead_offset )
+	{
+		read_ahead_stream->read_ahead_offset = read_ahead_end_offset;
+	}
+	return( 1 );
+}
+
+/* Reads data at a specific offset from the read-ahead cache
+ * Updates the access pattern of the stream and, if the stream is sequential,
+ * schedules the blocks following the read to be read ahead
+ * Only the leading part of the buffer that is available in the cache is read,
+ * a block that is pending is waited for
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t mount_read_ahead_cache_read_buffer_at_offset(
+         mount_read_ahead_cache_t *read_ahead_cache,
+         mount_read_ahead_stream_t *read_ahead_stream,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	mount_read_ahead_cache_block_t *block = NULL;
+	static char *function                 = "mount_read_ahead_cache_read_buffer_at_offset";
+	size_t buffer_offset                  = 0;
+	size_t data_offset                    = 0;
+	size_t read_size                      = 0;
+	off64_t block_offset                  = 0;
+	off64_t current_offset                = 0;
+	uint64_t block_number                 = 0;
+	int result                            = 1;
+
+	if( read_ahead_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == read_ahead_stream->next_offset )
+	{
+		read_ahead_stream->number_of_sequential_reads += 1;
+	}
+	else
+	{
+		read_ahead_stream->number_of_sequential_reads = 0;
+		read_ahead_stream->read_ahead_offset          = 0;
+	}
+	read_ahead_stream->next_offset = offset + (off64_t) buffer_size;
+
+	/* The blocks are scheduled before the cached data is copied
+	 * so that the read thread can continue while this read waits
+	 */
+	if( read_ahead_stream->number_of_sequential_reads >= MOUNT_READ_AHEAD_CACHE_SEQUENTIAL_READ_THRESHOLD )
+	{
+		if( mount_read_ahead_cache_schedule_blocks(
+		     read_ahead_cache,
+		     read_ahead_stream,
+		     offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to schedule blocks.",
+			 function );
+
+			result = -1;
+		}
+	}
+	while( ( result == 1 )
+	    && ( buffer_offset < buffer_size ) )
+	{
+		current_offset = offset + (off64_t) buffer_offset;
+
+		if( current_offset >= (off64_t) read_ahead_cache->media_size )
+		{
+			break;
+		}
+		block_number = (uint64_t) current_offset / read_ahead_cache->block_size;
+		block_offset = (off64_t) ( block_number * read_ahead_cache->block_size );
+		block        = &( read_ahead_cache->blocks[ block_number % read_ahead_cache->number_of_blocks ] );
+
+		while( ( block->offset == block_offset )
+		    && ( block->state == MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_PENDING ) )
+		{
+			if( libcthreads_condition_wait(
+			     read_ahead_cache->condition,
+			     read_ahead_cache->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( ( result != 1 )
+		 || ( block->offset != block_offset )
+		 || ( block->state != MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_VALID ) )
+		{
+			break;
+		}
+		data_offset = (size_t) ( current_offset - block_offset );
+
+		if( data_offset >= block->data_size )
+		{
+			break;
+		}
+		read_size = block->data_size - data_offset;
+
+		if( read_size > ( buffer_size - buffer_offset ) )
+		{
+			read_size = buffer_size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( ( block->data )[ data_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block data.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		buffer_offset += read_size;
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
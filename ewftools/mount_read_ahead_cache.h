@@ -0,0 +1,183 @@
+/*
+ * Mount read-ahead cache
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _MOUNT_READ_AHEAD_CACHE_H )
+#define _MOUNT_READ_AHEAD_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The maximum size of the read-ahead cache
+ * The blocks data is allocated as a single buffer and therefore
+ * cannot exceed MEMORY_MAXIMUM_ALLOCATION_SIZE
+ */
+#define MOUNT_READ_AHEAD_CACHE_MAXIMUM_SIZE			( 128 * 1024 * 1024 )
+
+/* The minimum number of blocks of the read-ahead cache
+ */
+#define MOUNT_READ_AHEAD_CACHE_MINIMUM_NUMBER_OF_BLOCKS		2
+
+/* The number of consecutive sequential reads after which a stream is read ahead
+ */
+#define MOUNT_READ_AHEAD_CACHE_SEQUENTIAL_READ_THRESHOLD	2
+
+enum MOUNT_READ_AHEAD_CACHE_BLOCK_STATES
+{
+	MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_EMPTY,
+	MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_PENDING,
+	MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_VALID
+};
+
+typedef struct mount_read_ahead_cache_block mount_read_ahead_cache_block_t;
+
+struct mount_read_ahead_cache_block
+{
+	/* The media offset
+	 */
+	off64_t offset;
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The state
+	 */
+	int state;
+};
+
+typedef struct mount_read_ahead_stream mount_read_ahead_stream_t;
+
+/* The access pattern of an open file
+ */
+struct mount_read_ahead_stream
+{
+	/* The offset of the next read if the stream is sequential
+	 */
+	off64_t next_offset;
+
+	/* The offset up to which the stream has been scheduled for read-ahead
+	 */
+	off64_t read_ahead_offset;
+
+	/* The number of consecutive sequential reads
+	 */
+	int number_of_sequential_reads;
+};
+
+typedef struct mount_read_ahead_cache mount_read_ahead_cache_t;
+
+struct mount_read_ahead_cache
+{
+	/* The reader handle used to read ahead
+	 */
+	libewf_handle_t *reader_handle;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The number of blocks
+	 */
+	int number_of_blocks;
+
+	/* The number of blocks read ahead of a sequential read
+	 */
+	int number_of_read_ahead_blocks;
+
+	/* The blocks
+	 */
+	mount_read_ahead_cache_block_t *blocks;
+
+	/* The blocks data
+	 */
+	uint8_t *blocks_data;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a pending block is no longer pending
+	 */
+	libcthreads_condition_t *condition;
+
+	/* The read thread pool
+	 */
+	libcthreads_thread_pool_t *read_thread_pool;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int mount_read_ahead_cache_initialize(
+     mount_read_ahead_cache_t **read_ahead_cache,
+     libewf_handle_t *ewf_handle,
+     size64_t cache_size,
+     libcerror_error_t **error );
+
+int mount_read_ahead_cache_free(
+     mount_read_ahead_cache_t **read_ahead_cache,
+     libcerror_error_t **error );
+
+int mount_read_ahead_cache_read_block_callback(
+     mount_read_ahead_cache_block_t *block,
+     mount_read_ahead_cache_t *read_ahead_cache );
+
+int mount_read_ahead_cache_schedule_blocks(
+     mount_read_ahead_cache_t *read_ahead_cache,
+     mount_read_ahead_stream_t *read_ahead_stream,
+     off64_t offset,
+     libcerror_error_t **error );
+
+ssize_t mount_read_ahead_cache_read_buffer_at_offset(
+         mount_read_ahead_cache_t *read_ahead_cache,
+         mount_read_ahead_stream_t *read_ahead_stream,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _MOUNT_READ_AHEAD_CACHE_H ) */
+
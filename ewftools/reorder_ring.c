@@ -0,0 +1,373 @@
+/*
+ * Reorder ring
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "reorder_ring.h"
+
+/* Creates a reorder ring
+ * Make sure the value reorder_ring is referencing, is set to NULL
+ * The number of slots must be at least the maximum number of values that can be outstanding
+ * Returns 1 if successful or -1 on error
+ */
+int reorder_ring_initialize(
+     reorder_ring_t **reorder_ring,
+     int number_of_slots,
+     libcerror_error_t **error )
+{
+	static char *function = "reorder_ring_initialize";
+	size_t values_size    = 0;
+
+	if( reorder_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reorder_ring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid reorder ring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_slots <= 0 )
+	 || ( (size_t) number_of_slots > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( intptr_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of slots value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*reorder_ring = memory_allocate_structure(
+	                 reorder_ring_t );
+
+	if( *reorder_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reorder ring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *reorder_ring,
+	     0,
+	     sizeof( reorder_ring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reorder ring.",
+		 function );
+
+		memory_free(
+		 *reorder_ring );
+
+		*reorder_ring = NULL;
+
+		return( -1 );
+	}
+	values_size = sizeof( intptr_t * ) * (size_t) number_of_slots;
+
+	( *reorder_ring )->values = (intptr_t **) memory_allocate(
+	                                           values_size );
+
+	if( ( *reorder_ring )->values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create values.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *reorder_ring )->values,
+	     0,
+	     values_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear values.",
+		 function );
+
+		goto on_error;
+	}
+	( *reorder_ring )->number_of_slots = number_of_slots;
+
+	return( 1 );
+
+on_error:
+	if( *reorder_ring != NULL )
+	{
+		if( ( *reorder_ring )->values != NULL )
+		{
+			memory_free(
+			 ( *reorder_ring )->values );
+		}
+		memory_free(
+		 *reorder_ring );
+
+		*reorder_ring = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a reorder ring
+ * The values are not managed by the reorder ring and are not freed
+ * Returns 1 if successful or -1 on error
+ */
+int reorder_ring_free(
+     reorder_ring_t **reorder_ring,
+     libcerror_error_t **error )
+{
+	static char *function = "reorder_ring_free";
+
+	if( reorder_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reorder_ring != NULL )
+	{
+		memory_free(
+		 ( *reorder_ring )->values );
+
+		memory_free(
+		 *reorder_ring );
+
+		*reorder_ring = NULL;
+	}
+	return( 1 );
+}
+
+/* Inserts a value into the reorder ring
+ * The sequence number must be within the number of slots of the next sequence number
+ * Returns 1 if successful or -1 on error
+ */
+int reorder_ring_insert_value(
+     reorder_ring_t *reorder_ring,
+     uint64_t sequence_number,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	static char *function = "reorder_ring_insert_value";
+	int slot_index        = 0;
+
+	if( reorder_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sequence_number < reorder_ring->next_sequence_number )
+	 || ( ( sequence_number - reorder_ring->next_sequence_number ) >= (uint64_t) reorder_ring->number_of_slots ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sequence number: %" PRIu64 " value out of bounds.",
+		 function,
+		 sequence_number );
+
+		return( -1 );
+	}
+	slot_index = (int) ( sequence_number % (uint64_t) reorder_ring->number_of_slots );
+
+	if( reorder_ring->values[ slot_index ] != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid reorder ring - value for sequence number: %" PRIu64 " already set.",
+		 function,
+		 sequence_number );
+
+		return( -1 );
+	}
+	reorder_ring->values[ slot_index ] = value;
+
+	reorder_ring->number_of_values += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the value with the next sequence number and removes it from the reorder ring
+ * Returns 1 if successful, 0 if the value with the next sequence number is not available or -1 on error
+ */
+int reorder_ring_get_next_value(
+     reorder_ring_t *reorder_ring,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "reorder_ring_get_next_value";
+	int slot_index        = 0;
+
+	if( reorder_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	slot_index = (int) ( reorder_ring->next_sequence_number % (uint64_t) reorder_ring->number_of_slots );
+
+	if( reorder_ring->values[ slot_index ] == NULL )
+	{
+		return( 0 );
+	}
+	*value = reorder_ring->values[ slot_index ];
+
+	reorder_ring->values[ slot_index ] = NULL;
+
+	reorder_ring->number_of_values     -= 1;
+	reorder_ring->next_sequence_number += 1;
+
+	return( 1 );
+}
+
+/* Removes any value from the reorder ring regardless of its sequence number
+ * This function is intended to empty the reorder ring, for example on abort
+ * Returns 1 if successful, 0 if the reorder ring is empty or -1 on error
+ */
+int reorder_ring_remove_value(
+     reorder_ring_t *reorder_ring,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "reorder_ring_remove_value";
+	int slot_index        = 0;
+
+	if( reorder_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( reorder_ring->number_of_values == 0 )
+	{
+		return( 0 );
+	}
+	for( slot_index = 0;
+	     slot_index < reorder_ring->number_of_slots;
+	     slot_index++ )
+	{
+		if( reorder_ring->values[ slot_index ] != NULL )
+		{
+			*value = reorder_ring->values[ slot_index ];
+
+			reorder_ring->values[ slot_index ] = NULL;
+
+			reorder_ring->number_of_values -= 1;
+
+			return( 1 );
+		}
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+	 "%s: invalid reorder ring - number of values out of bounds.",
+	 function );
+
+	return( -1 );
+}
+
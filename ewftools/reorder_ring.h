@@ -0,0 +1,85 @@
+/*
+ * Reorder ring
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _REORDER_RING_H )
+#define _REORDER_RING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct reorder_ring reorder_ring_t;
+
+struct reorder_ring
+{
+	/* The values
+	 */
+	intptr_t **values;
+
+	/* The number of slots
+	 */
+	int number_of_slots;
+
+	/* The number of values
+	 */
+	int number_of_values;
+
+	/* The sequence number of the next value
+	 */
+	uint64_t next_sequence_number;
+};
+
+int reorder_ring_initialize(
+     reorder_ring_t **reorder_ring,
+     int number_of_slots,
+     libcerror_error_t **error );
+
+int reorder_ring_free(
+     reorder_ring_t **reorder_ring,
+     libcerror_error_t **error );
+
+int reorder_ring_insert_value(
+     reorder_ring_t *reorder_ring,
+     uint64_t sequence_number,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+int reorder_ring_get_next_value(
+     reorder_ring_t *reorder_ring,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+int reorder_ring_remove_value(
+     reorder_ring_t *reorder_ring,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _REORDER_RING_H ) */
+
@@ -431,6 +431,105 @@ ssize_t storage_media_buffer_read_from_handle(
 	return( read_count );
 }
 
+/* Reads a storage media buffer from the input handle at a specific offset
+ * In buffered mode this function does not change the current offset of the input handle and
+ * can therefore be called from multiple threads. In chunk data mode the handle is first
+ * positioned at the offset, hence the handle should not be shared with other threads
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t storage_media_buffer_read_from_handle_at_offset(
+         storage_media_buffer_t *storage_media_buffer,
+         libewf_handle_t *handle,
+         size_t read_size,
+         off64_t storage_media_offset,
+         libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_read_from_handle_at_offset";
+	ssize_t read_count    = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_BUFFERED )
+	 && ( read_size > storage_media_buffer->raw_buffer_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size == 0 )
+	{
+		return( 0 );
+	}
+	if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	{
+		if( libewf_handle_seek_offset(
+		     handle,
+		     storage_media_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 storage_media_offset,
+			 storage_media_offset );
+
+			return( -1 );
+		}
+		read_count = libewf_handle_read_data_chunk(
+		              handle,
+		              storage_media_buffer->data_chunk,
+		              error );
+	}
+	else
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              storage_media_buffer->raw_buffer,
+		              read_size,
+		              storage_media_offset,
+		              error );
+	}
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read storage media buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 storage_media_offset,
+		 storage_media_offset );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_BUFFERED )
+	{
+		storage_media_buffer->raw_buffer_data_size = (size_t) read_count;
+	}
+	storage_media_buffer->storage_media_offset = storage_media_offset;
+	storage_media_buffer->requested_size       = read_size;
+
+	return( read_count );
+}
+
 /* Processes a storage media buffer after read
  * Returns the resulting buffer size or -1 on error
  */
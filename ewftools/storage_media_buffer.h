@@ -50,6 +50,10 @@ struct storage_media_buffer
 	 */
 	off64_t storage_media_offset;
 
+	/* The sequence number in which the buffer was read
+	 */
+	uint64_t sequence_number;
+
 	/* The raw buffer
 	 */
 	uint8_t *raw_buffer;
@@ -77,6 +81,14 @@ struct storage_media_buffer
 	/* Value to indicate the data is corrupted
 	 */
 	uint8_t is_corrupted;
+
+	/* The size of the data to digest
+	 */
+	size_t digest_data_size;
+
+	/* The number of digest threads that still reference the buffer
+	 */
+	volatile int reference_count;
 };
 
 int storage_media_buffer_initialize(
@@ -111,6 +123,13 @@ ssize_t storage_media_buffer_read_from_handle(
          size_t read_size,
          libcerror_error_t **error );
 
+ssize_t storage_media_buffer_read_from_handle_at_offset(
+         storage_media_buffer_t *storage_media_buffer,
+         libewf_handle_t *handle,
+         size_t read_size,
+         off64_t storage_media_offset,
+         libcerror_error_t **error );
+
 ssize_t storage_media_buffer_read_process(
          storage_media_buffer_t *storage_media_buffer,
          libcerror_error_t **error );
@@ -21,7 +21,9 @@
 
 #include <common.h>
 #include <memory.h>
+#include <types.h>
 
+#include "ewftools_atomic.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
@@ -30,12 +32,19 @@
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
+/* The queue is a bounded ring of slots where every slot carries a sequence
+ * that indicates if the slot can be pushed or popped at a specific position.
+ * Pushing and popping only requires a compare-and-exchange of the position
+ * hence the mutex and condition are only used when a thread has to wait
+ * for a buffer to be released.
+ */
+
 /* Creates a storage media buffer queue
  * Make sure the value queue is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_initialize(
-     libcthreads_queue_t **queue,
+     storage_media_buffer_queue_t **queue,
      libewf_handle_t *handle,
      int maximum_number_of_values,
      uint8_t storage_media_buffer_mode,
@@ -44,6 +53,8 @@ int storage_media_buffer_queue_initialize(
 {
 	storage_media_buffer_t *buffer = NULL;
 	static char *function          = "storage_media_buffer_queue_initialize";
+	size_t number_of_slots         = 1;
+	size_t slot_index              = 0;
 	int value_index                = 0;
 
 	if( queue == NULL )
@@ -80,16 +91,102 @@ int storage_media_buffer_queue_initialize(
 
 		return( -1 );
 	}
-	if( libcthreads_queue_initialize(
-	     queue,
-	     maximum_number_of_values,
+	/* The number of slots is rounded up to a power of 2 so that the slot
+	 * of a position can be determined with a mask
+	 */
+	while( number_of_slots < (size_t) maximum_number_of_values )
+	{
+		number_of_slots <<= 1;
+	}
+	if( number_of_slots > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( storage_media_buffer_queue_slot_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of slots value exceeds maximum allocation size.",
+		 function );
+
+		return( -1 );
+	}
+	*queue = memory_allocate_structure(
+	          storage_media_buffer_queue_t );
+
+	if( *queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *queue,
+	     0,
+	     sizeof( storage_media_buffer_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear queue.",
+		 function );
+
+		memory_free(
+		 *queue );
+
+		*queue = NULL;
+
+		return( -1 );
+	}
+	( *queue )->slots = (storage_media_buffer_queue_slot_t *) memory_allocate(
+	                                                           sizeof( storage_media_buffer_queue_slot_t ) * number_of_slots );
+
+	if( ( *queue )->slots == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slots.",
+		 function );
+
+		goto on_error;
+	}
+	for( slot_index = 0;
+	     slot_index < number_of_slots;
+	     slot_index++ )
+	{
+		( *queue )->slots[ slot_index ].sequence = slot_index;
+		( *queue )->slots[ slot_index ].buffer   = NULL;
+	}
+	( *queue )->number_of_slots = number_of_slots;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *queue )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *queue )->buffer_released_condition ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize storage media buffer queue.",
+		 "%s: unable to create buffer released condition.",
 		 function );
 
 		goto on_error;
@@ -116,10 +213,10 @@ int storage_media_buffer_queue_initialize(
 
 			goto on_error;
 		}
-		if( libcthreads_queue_push(
+		if( storage_media_buffer_queue_release_buffer(
 		     *queue,
-		     (intptr_t *) buffer,
-		     error ) == -1 )
+		     buffer,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -151,14 +248,17 @@ on_error:
 }
 
 /* Frees a storage media buffer queue
+ * Buffers that are not released onto the queue are not freed
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_free(
-     libcthreads_queue_t **queue,
+     storage_media_buffer_queue_t **queue,
      libcerror_error_t **error )
 {
-	static char *function = "storage_media_buffer_queue_free";
-	int result            = 1;
+	storage_media_buffer_t *buffer = NULL;
+	static char *function          = "storage_media_buffer_queue_free";
+	size_t slot_index              = 0;
+	int result                     = 1;
 
 	if( queue == NULL )
 	{
@@ -173,37 +273,409 @@ int storage_media_buffer_queue_free(
 	}
 	if( *queue != NULL )
 	{
-		if( libcthreads_queue_free(
-		     queue,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &storage_media_buffer_free,
+		if( ( *queue )->slots != NULL )
+		{
+			/* The slots between the pop and push position contain the buffers in the queue
+			 */
+			for( slot_index = ( *queue )->pop_position;
+			     slot_index != ( *queue )->push_position;
+			     slot_index++ )
+			{
+				buffer = ( *queue )->slots[ slot_index & ( ( *queue )->number_of_slots - 1 ) ].buffer;
+
+				if( buffer == NULL )
+				{
+					continue;
+				}
+				if( storage_media_buffer_free(
+				     &buffer,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free storage media buffer.",
+					 function );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *queue )->slots );
+		}
+		if( ( *queue )->buffer_released_condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *queue )->buffer_released_condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free buffer released condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *queue )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *queue )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *queue );
+
+		*queue = NULL;
+	}
+	return( result );
+}
+
+/* Pops storage media buffers from the queue without waiting
+ * Returns the number of buffers popped, which is 0 if the queue is empty
+ */
+static int storage_media_buffer_queue_pop_buffers(
+            storage_media_buffer_queue_t *queue,
+            storage_media_buffer_t **buffers,
+            int number_of_buffers )
+{
+	storage_media_buffer_queue_slot_t *slot = NULL;
+	size_t last_position                    = 0;
+	size_t position                         = 0;
+	size_t sequence                         = 0;
+	size_t slot_index_mask                  = 0;
+	int buffer_index                        = 0;
+	int number_of_popped_buffers            = 0;
+
+	slot_index_mask = queue->number_of_slots - 1;
+	position        = ewftools_atomic_load(
+	                   &( queue->pop_position ) );
+
+	while( number_of_buffers > 0 )
+	{
+		/* Determine how many consecutive slots are ready to be popped
+		 */
+		for( number_of_popped_buffers = 0;
+		     number_of_popped_buffers < number_of_buffers;
+		     number_of_popped_buffers++ )
+		{
+			slot     = &( queue->slots[ ( position + number_of_popped_buffers ) & slot_index_mask ] );
+			sequence = ewftools_atomic_load(
+			            &( slot->sequence ) );
+
+			if( sequence != ( position + number_of_popped_buffers + 1 ) )
+			{
+				break;
+			}
+		}
+		if( number_of_popped_buffers == 0 )
+		{
+			/* If the sequence is behind the position the slot was not pushed yet
+			 * which means the queue is empty unless another thread popped the slot
+			 * in the meantime, hence the position is reloaded to check
+			 */
+			last_position = position;
+			position      = ewftools_atomic_load(
+			                 &( queue->pop_position ) );
+
+			if( ( (ssize_t) ( sequence - ( last_position + 1 ) ) < 0 )
+			 && ( position == last_position ) )
+			{
+				break;
+			}
+			continue;
+		}
+		if( ewftools_atomic_compare_exchange(
+		     &( queue->pop_position ),
+		     position,
+		     position + number_of_popped_buffers ) )
+		{
+			for( buffer_index = 0;
+			     buffer_index < number_of_popped_buffers;
+			     buffer_index++ )
+			{
+				slot = &( queue->slots[ ( position + buffer_index ) & slot_index_mask ] );
+
+				buffers[ buffer_index ] = slot->buffer;
+				slot->buffer            = NULL;
+
+				/* Mark the slot free to push in the next round of the ring
+				 */
+				ewftools_atomic_store(
+				 &( slot->sequence ),
+				 position + buffer_index + queue->number_of_slots );
+			}
+			return( number_of_popped_buffers );
+		}
+		position = ewftools_atomic_load(
+		            &( queue->pop_position ) );
+	}
+	return( 0 );
+}
+
+/* Pushes storage media buffers onto the queue without waiting
+ * Returns the number of buffers pushed, which is 0 if the queue is full
+ */
+static int storage_media_buffer_queue_push_buffers(
+            storage_media_buffer_queue_t *queue,
+            storage_media_buffer_t **buffers,
+            int number_of_buffers )
+{
+	storage_media_buffer_queue_slot_t *slot = NULL;
+	size_t pop_position                     = 0;
+	size_t position                         = 0;
+	size_t sequence                         = 0;
+	size_t slot_index_mask                  = 0;
+	int buffer_index                        = 0;
+	int number_of_pushed_buffers            = 0;
+
+	slot_index_mask = queue->number_of_slots - 1;
+	position        = ewftools_atomic_load(
+	                   &( queue->push_position ) );
+
+	while( number_of_buffers > 0 )
+	{
+		/* Determine how many consecutive slots are ready to be pushed
+		 */
+		for( number_of_pushed_buffers = 0;
+		     number_of_pushed_buffers < number_of_buffers;
+		     number_of_pushed_buffers++ )
+		{
+			slot     = &( queue->slots[ ( position + number_of_pushed_buffers ) & slot_index_mask ] );
+			sequence = ewftools_atomic_load(
+			            &( slot->sequence ) );
+
+			if( sequence != ( position + number_of_pushed_buffers ) )
+			{
+				break;
+			}
+		}
+		if( number_of_pushed_buffers == 0 )
+		{
+			/* If the sequence is behind the position the slot was not popped yet
+			 * which means either the queue is full or another thread is still popping the slot
+			 * otherwise another thread pushed the slot and the position is reloaded
+			 */
+			if( (ssize_t) ( sequence - position ) < 0 )
+			{
+				pop_position = ewftools_atomic_load(
+				                &( queue->pop_position ) );
+
+				if( (ssize_t) ( position - pop_position ) >= (ssize_t) queue->number_of_slots )
+				{
+					break;
+				}
+			}
+			position = ewftools_atomic_load(
+			            &( queue->push_position ) );
+
+			continue;
+		}
+		if( ewftools_atomic_compare_exchange(
+		     &( queue->push_position ),
+		     position,
+		     position + number_of_pushed_buffers ) )
+		{
+			for( buffer_index = 0;
+			     buffer_index < number_of_pushed_buffers;
+			     buffer_index++ )
+			{
+				slot = &( queue->slots[ ( position + buffer_index ) & slot_index_mask ] );
+
+				slot->buffer = buffers[ buffer_index ];
+
+				/* Mark the slot free to pop
+				 */
+				ewftools_atomic_store(
+				 &( slot->sequence ),
+				 position + buffer_index + 1 );
+			}
+			return( number_of_pushed_buffers );
+		}
+		position = ewftools_atomic_load(
+		            &( queue->push_position ) );
+	}
+	return( 0 );
+}
+
+/* Grabs one or more storage media buffers from the queue
+ * Waits until at least one buffer is available
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_grab_buffers(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t **buffers,
+     int number_of_buffers,
+     int *number_of_grabbed_buffers,
+     libcerror_error_t **error )
+{
+	static char *function            = "storage_media_buffer_queue_grab_buffers";
+	size_t number_of_waiting_threads = 0;
+	int number_of_popped_buffers     = 0;
+	int result                       = 1;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_buffers <= 0 )
+	 || ( number_of_buffers > STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_BATCH_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_grabbed_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of grabbed buffers.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_popped_buffers = storage_media_buffer_queue_pop_buffers(
+	                            queue,
+	                            buffers,
+	                            number_of_buffers );
+
+	if( number_of_popped_buffers == 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     queue->mutex,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free storage media buffer queue.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		/* The number of waiting threads is only changed while holding the mutex.
+		 * The memory barrier makes sure that either this thread sees the buffer
+		 * that is released or the releasing thread sees this thread waiting.
+		 */
+		number_of_waiting_threads = queue->number_of_waiting_threads;
+
+		ewftools_atomic_store(
+		 &( queue->number_of_waiting_threads ),
+		 number_of_waiting_threads + 1 );
+
+		ewftools_atomic_memory_barrier();
+
+		do
+		{
+			number_of_popped_buffers = storage_media_buffer_queue_pop_buffers(
+			                            queue,
+			                            buffers,
+			                            number_of_buffers );
+
+			if( number_of_popped_buffers != 0 )
+			{
+				break;
+			}
+			if( libcthreads_condition_wait(
+			     queue->buffer_released_condition,
+			     queue->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for buffer released condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		while( result == 1 );
+
+		ewftools_atomic_store(
+		 &( queue->number_of_waiting_threads ),
+		 queue->number_of_waiting_threads - 1 );
+
+		if( libcthreads_mutex_release(
+		     queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
 			 function );
 
 			result = -1;
 		}
+		if( result != 1 )
+		{
+			return( -1 );
+		}
 	}
-	return( result );
+	*number_of_grabbed_buffers = number_of_popped_buffers;
+
+	return( 1 );
 }
 
 /* Grabs a storage media buffer from the queue
+ * Waits until a buffer is available
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_grab_buffer(
-     libcthreads_queue_t *queue,
+     storage_media_buffer_queue_t *queue,
      storage_media_buffer_t **buffer,
      libcerror_error_t **error )
 {
-	static char *function = "storage_media_buffer_queue_grab_buffer";
+	static char *function         = "storage_media_buffer_queue_grab_buffer";
+	int number_of_grabbed_buffers = 0;
 
-	if( libcthreads_queue_pop(
+	if( storage_media_buffer_queue_grab_buffers(
 	     queue,
-	     (intptr_t **) buffer,
+	     buffer,
+	     1,
+	     &number_of_grabbed_buffers,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -218,19 +690,158 @@ int storage_media_buffer_queue_grab_buffer(
 	return( 1 );
 }
 
+/* Releases one or more storage media buffers onto the queue
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_release_buffers(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t **buffers,
+     int number_of_buffers,
+     libcerror_error_t **error )
+{
+	static char *function        = "storage_media_buffer_queue_release_buffers";
+	int buffer_index             = 0;
+	int number_of_pushed_buffers = 0;
+	int result                   = 1;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_buffers <= 0 )
+	 || ( number_of_buffers > STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_BATCH_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( buffers[ buffer_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffers - missing buffer: %d.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+	}
+	buffer_index = 0;
+
+	/* The queue has at least as many slots as there are buffers
+	 * hence it can only be full if a buffer is released more than once
+	 */
+	while( buffer_index < number_of_buffers )
+	{
+		number_of_pushed_buffers = storage_media_buffer_queue_push_buffers(
+		                            queue,
+		                            &( buffers[ buffer_index ] ),
+		                            number_of_buffers - buffer_index );
+
+		if( number_of_pushed_buffers == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: unable to push storage media buffer onto queue - queue is full.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_index += number_of_pushed_buffers;
+	}
+	ewftools_atomic_memory_barrier();
+
+	if( ewftools_atomic_load(
+	     &( queue->number_of_waiting_threads ) ) != 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_condition_broadcast(
+		     queue->buffer_released_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast buffer released condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
 /* Releases a storage media buffer onto the queue
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_release_buffer(
-     libcthreads_queue_t *queue,
+     storage_media_buffer_queue_t *queue,
      storage_media_buffer_t *buffer,
      libcerror_error_t **error )
 {
 	static char *function = "storage_media_buffer_queue_release_buffer";
 
-	if( libcthreads_queue_push(
+	if( storage_media_buffer_queue_release_buffers(
 	     queue,
-	     (intptr_t *) buffer,
+	     &buffer,
+	     1,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
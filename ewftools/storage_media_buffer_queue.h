@@ -36,8 +36,61 @@ extern "C" {
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
+/* The maximum number of buffers grabbed or released in a single operation
+ */
+#define STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_BATCH_SIZE	16
+
+typedef struct storage_media_buffer_queue_slot storage_media_buffer_queue_slot_t;
+
+struct storage_media_buffer_queue_slot
+{
+	/* The sequence of the slot
+	 * equals the position when the slot is free to push
+	 * and the position + 1 when the slot is free to pop
+	 */
+	volatile size_t sequence;
+
+	/* The buffer
+	 */
+	storage_media_buffer_t *buffer;
+};
+
+typedef struct storage_media_buffer_queue storage_media_buffer_queue_t;
+
+struct storage_media_buffer_queue
+{
+	/* The slots
+	 */
+	storage_media_buffer_queue_slot_t *slots;
+
+	/* The number of slots, which is a power of 2
+	 */
+	size_t number_of_slots;
+
+	/* The push position
+	 */
+	volatile size_t push_position;
+
+	/* The pop position
+	 */
+	volatile size_t pop_position;
+
+	/* The number of threads waiting for a buffer
+	 */
+	volatile size_t number_of_waiting_threads;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition signalled when a buffer is released
+	 * while threads are waiting
+	 */
+	libcthreads_condition_t *buffer_released_condition;
+};
+
 int storage_media_buffer_queue_initialize(
-     libcthreads_queue_t **queue,
+     storage_media_buffer_queue_t **queue,
      libewf_handle_t *handle,
      int maximum_number_of_values,
      uint8_t storage_media_buffer_mode,
@@ -45,16 +98,29 @@ int storage_media_buffer_queue_initialize(
      libcerror_error_t **error );
 
 int storage_media_buffer_queue_free(
-     libcthreads_queue_t **queue,
+     storage_media_buffer_queue_t **queue,
+     libcerror_error_t **error );
+
+int storage_media_buffer_queue_grab_buffers(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t **buffers,
+     int number_of_buffers,
+     int *number_of_grabbed_buffers,
      libcerror_error_t **error );
 
 int storage_media_buffer_queue_grab_buffer(
-     libcthreads_queue_t *queue,
+     storage_media_buffer_queue_t *queue,
      storage_media_buffer_t **buffer,
      libcerror_error_t **error );
 
+int storage_media_buffer_queue_release_buffers(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t **buffers,
+     int number_of_buffers,
+     libcerror_error_t **error );
+
 int storage_media_buffer_queue_release_buffer(
-     libcthreads_queue_t *queue,
+     storage_media_buffer_queue_t *queue,
      storage_media_buffer_t *buffer,
      libcerror_error_t **error );
 
@@ -41,6 +41,7 @@
 #include "ewftools_system_string.h"
 #include "log_handle.h"
 #include "process_status.h"
+#include "reorder_ring.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
 #include "verification_handle.h"
@@ -49,6 +50,7 @@
 #define VERIFICATION_HANDLE_VALUE_IDENTIFIER_SIZE		32
 #define VERIFICATION_HANDLE_NOTIFY_STREAM			stdout
 #define VERIFICATION_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE	64 * 1024 * 1024
+#define VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_READER_THREADS	32
 
 /* Creates a verification handle
  * Make sure the value verification_handle is referencing, is set to NULL
@@ -346,6 +348,27 @@ int verification_handle_free(
 			memory_free(
 			 ( *verification_handle )->stored_sha256_hash_string );
 		}
+		if( ( *verification_handle )->chunk_hash_tree != NULL )
+		{
+			if( chunk_hash_tree_free(
+			     &( ( *verification_handle )->chunk_hash_tree ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk hash tree.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *verification_handle )->leaf_results != NULL )
+		{
+			memory_free(
+			 ( *verification_handle )->leaf_results );
+		}
 		memory_free(
 		 *verification_handle );
 
@@ -530,6 +553,23 @@ int verification_handle_open_input(
 			goto on_error;
 		}
 	}
+	if( verification_handle->use_direct_io != 0 )
+	{
+		if( libewf_handle_set_use_direct_io(
+		     verification_handle->input_handle,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set use direct IO.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     verification_handle->input_handle,
@@ -1137,140 +1177,234 @@ on_error:
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
-/* Prepares a storage media buffer for verification
- * Callback function for the process thread pool
+/* Creates the reader handles
+ * Every reader handle shares the image state of the input handle but has its own current offset
  * Returns 1 if successful or -1 on error
  */
-int verification_handle_process_storage_media_buffer_callback(
-     storage_media_buffer_t *storage_media_buffer,
-     verification_handle_t *verification_handle )
+int verification_handle_initialize_reader_handles(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
 {
-        libcerror_error_t *error = NULL;
-        static char *function    = "verification_handle_process_storage_media_buffer_callback";
-	ssize_t process_count    = 0;
+	static char *function = "verification_handle_initialize_reader_handles";
+	size_t handles_size   = 0;
+	int handle_index      = 0;
 
-	if( storage_media_buffer == NULL )
+	if( verification_handle == NULL )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
+		 "%s: invalid verification handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( verification_handle->abort != 0 )
+	if( verification_handle->reader_handles != NULL )
 	{
-		return( 1 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - reader handles value already set.",
+		 function );
+
+		return( -1 );
 	}
-	process_count = storage_media_buffer_read_process(
-			 storage_media_buffer,
-			 &error );
+	if( ( verification_handle->number_of_reader_threads <= 0 )
+	 || ( verification_handle->number_of_reader_threads > VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_READER_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid verification handle - number of reader threads value out of bounds.",
+		 function );
 
-	if( process_count < 0 )
+		return( -1 );
+	}
+	handles_size = sizeof( libewf_handle_t * ) * verification_handle->number_of_reader_threads;
+
+	verification_handle->reader_handles = (libewf_handle_t **) memory_allocate(
+	                                                            handles_size );
+
+	if( verification_handle->reader_handles == NULL )
 	{
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( ( libcnotify_verbose != 0 )
-		 && ( error != NULL ) )
-		{
-			libcnotify_print_error_backtrace(
-			 error );
-		}
-#endif
-		libcerror_error_free(
-		 &error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reader handles.",
+		 function );
 
-		process_count = verification_handle->chunk_size;
+		goto on_error;
+	}
+	if( memory_set(
+	     verification_handle->reader_handles,
+	     0,
+	     handles_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reader handles.",
+		 function );
 
-		storage_media_buffer->is_corrupted = 1;
+		memory_free(
+		 verification_handle->reader_handles );
+
+		verification_handle->reader_handles = NULL;
+
+		return( -1 );
 	}
-	if( libcthreads_thread_pool_push(
-	     verification_handle->output_thread_pool,
-	     (intptr_t *) storage_media_buffer,
-	     &error ) != 1 )
+	if( libcthreads_queue_initialize(
+	     &( verification_handle->reader_handle_queue ),
+	     verification_handle->number_of_reader_threads,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to push storage media buffer onto output thread pool queue.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reader handle queue.",
 		 function );
 
 		goto on_error;
 	}
-	storage_media_buffer = NULL;
-
-	return( 1 );
-
-on_error:
-	if( storage_media_buffer != NULL )
+	for( handle_index = 0;
+	     handle_index < verification_handle->number_of_reader_threads;
+	     handle_index++ )
 	{
-		if( storage_media_buffer_queue_release_buffer(
-		     verification_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
+		if( libewf_handle_clone_reader(
+		     &( verification_handle->reader_handles[ handle_index ] ),
+		     verification_handle->input_handle,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create reader handle: %d.",
+			 function,
+			 handle_index );
 
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
+			goto on_error;
 		}
-	}
-	if( error != NULL )
-	{
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		if( libcthreads_queue_push(
+		     verification_handle->reader_handle_queue,
+		     (intptr_t *) verification_handle->reader_handles[ handle_index ],
+		     error ) != 1 )
 		{
-			libcnotify_print_error_backtrace(
-			 error );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push reader handle: %d onto queue.",
+			 function,
+			 handle_index );
+
+			goto on_error;
 		}
-#endif
-		libcerror_error_free(
-		 &error );
-	}
-	if( verification_handle->abort == 0 )
-	{
-		verification_handle_signal_abort(
-		 verification_handle,
-		 NULL );
 	}
+	return( 1 );
+
+on_error:
+	verification_handle_free_reader_handles(
+	 verification_handle,
+	 NULL );
+
 	return( -1 );
 }
 
-/* Prepares a storage media buffer for verification
- * Callback function for the process thread pool
+/* Frees the reader handles
  * Returns 1 if successful or -1 on error
  */
-int verification_handle_output_storage_media_buffer_callback(
-     storage_media_buffer_t *storage_media_buffer,
-     verification_handle_t *verification_handle )
+int verification_handle_free_reader_handles(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-	uint8_t *data                         = NULL;
-        static char *function                 = "verification_handle_process_storage_media_buffer_callback";
-	size_t data_size                      = 0;
-	int result                            = 0;
+	static char *function = "verification_handle_free_reader_handles";
+	int handle_index      = 0;
+	int result            = 1;
 
 	if( verification_handle == NULL )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
 		 "%s: invalid verification handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	/* The reader handle queue does not manage the reader handles
+	 */
+	if( verification_handle->reader_handle_queue != NULL )
+	{
+		if( libcthreads_queue_free(
+		     &( verification_handle->reader_handle_queue ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reader handle queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( verification_handle->reader_handles != NULL )
+	{
+		for( handle_index = 0;
+		     handle_index < verification_handle->number_of_reader_threads;
+		     handle_index++ )
+		{
+			if( verification_handle->reader_handles[ handle_index ] == NULL )
+			{
+				continue;
+			}
+			if( libewf_handle_free(
+			     &( verification_handle->reader_handles[ handle_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free reader handle: %d.",
+				 function,
+				 handle_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 verification_handle->reader_handles );
+
+		verification_handle->reader_handles = NULL;
 	}
+	return( result );
+}
+
+/* Reads a storage media buffer from the input
+ * The storage media offset and requested size of the storage media buffer must be set
+ * Callback function for the read thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_read_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle )
+{
+	libcerror_error_t *error       = NULL;
+	libewf_handle_t *reader_handle = NULL;
+	static char *function          = "verification_handle_read_storage_media_buffer_callback";
+	ssize_t read_count             = 0;
+
 	if( storage_media_buffer == NULL )
 	{
 		libcerror_error_set(
@@ -1284,234 +1418,180 @@ int verification_handle_output_storage_media_buffer_callback(
 	}
 	if( verification_handle->abort != 0 )
 	{
+		/* Release the storage media buffer so that the main thread does not block on the queue
+		 */
+		storage_media_buffer_queue_release_buffer(
+		 verification_handle->storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
+
 		return( 1 );
 	}
-	if( libcdata_list_insert_value(
-	     verification_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+	/* There are as many reader handles as read threads hence a reader handle is always available
+	 */
+	if( libcthreads_queue_pop(
+	     verification_handle->reader_handle_queue,
+	     (intptr_t **) &reader_handle,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to pop reader handle from queue.",
 		 function );
 
 		goto on_error;
 	}
-	storage_media_buffer = NULL;
+	read_count = storage_media_buffer_read_from_handle_at_offset(
+	              storage_media_buffer,
+	              reader_handle,
+	              storage_media_buffer->requested_size,
+	              storage_media_buffer->storage_media_offset,
+	              &error );
 
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
+	if( libcthreads_queue_push(
+	     verification_handle->reader_handle_queue,
+	     (intptr_t *) reader_handle,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push reader handle onto queue.",
 		 function );
 
 		goto on_error;
 	}
-	while( element != NULL )
+	if( read_count < 0 )
 	{
-		if( verification_handle->abort != 0 )
-		{
-			break;
-		}
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
-
-			storage_media_buffer = NULL;
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data at offset: %" PRIi64 ".",
+		 function,
+		 storage_media_buffer->storage_media_offset );
 
-			goto on_error;
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
+		goto on_error;
+	}
+	if( read_count == 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unexpected end of data at offset: %" PRIi64 ".",
+		 function,
+		 storage_media_buffer->storage_media_offset );
 
-			goto on_error;
-		}
-		if( storage_media_buffer->storage_media_offset != verification_handle->last_offset_hashed )
-		{
-			break;
-		}
-		result = storage_media_buffer_is_corrupted(
-		          storage_media_buffer,
-		          &error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if storage media buffer is corrupted.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		else if( result != 0 )
-		{
-			/* Append a read error
-			 */
-			if( verification_handle_append_read_error(
-			     verification_handle,
-			     storage_media_buffer->storage_media_offset,
-			     (size_t) verification_handle->chunk_size,
-			     &error ) != 1 )
-			{
-				libcerror_error_set(
-				 &error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append read error.",
-				 function );
-
-				storage_media_buffer = NULL;
-
-				goto on_error;
-			}
-		}
-		if( storage_media_buffer_get_data(
-		     storage_media_buffer,
-		     &data,
-		     &data_size,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine storage media buffer data.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( verification_handle_update_integrity_hash(
-		     verification_handle,
-		     data,
-		     storage_media_buffer->processed_size,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to update integrity hash(es).",
-			 function );
-
-			storage_media_buffer = NULL;
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_push(
+	     verification_handle->process_thread_pool,
+	     (intptr_t *) storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto process thread pool queue.",
+		 function );
 
-			goto on_error;
-		}
-		verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
+		goto on_error;
+	}
+	return( 1 );
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+on_error:
+	if( storage_media_buffer != NULL )
+	{
+		storage_media_buffer_queue_release_buffer(
+		 verification_handle->storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( verification_handle->abort == 0 )
+	{
+		verification_handle_signal_abort(
+		 verification_handle,
+		 NULL );
+	}
+	return( -1 );
+}
 
-			storage_media_buffer = NULL;
+/* Prepares a storage media buffer for verification
+ * Callback function for the process thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_process_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle )
+{
+        libcerror_error_t *error = NULL;
+        static char *function    = "verification_handle_process_storage_media_buffer_callback";
+	ssize_t process_count    = 0;
 
-			goto on_error;
-		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
 
-			storage_media_buffer = NULL;
+		goto on_error;
+	}
+	if( verification_handle->abort != 0 )
+	{
+		return( 1 );
+	}
+	process_count = storage_media_buffer_read_process(
+			 storage_media_buffer,
+			 &error );
 
-			goto on_error;
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
+	if( process_count < 0 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( ( libcnotify_verbose != 0 )
+		 && ( error != NULL ) )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
-			goto on_error;
+			libcnotify_print_error_backtrace(
+			 error );
 		}
-		element = next_element;
-
-		if( storage_media_buffer_queue_release_buffer(
-		     verification_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
+#endif
+		libcerror_error_free(
+		 &error );
 
-			goto on_error;
-		}
-		storage_media_buffer = NULL;
+		process_count = verification_handle->chunk_size;
 
-		if( process_status_update(
-		     verification_handle->process_status,
-		     verification_handle->last_offset_hashed,
-		     verification_handle->media_size,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update process status.",
-			 function );
+		storage_media_buffer->is_corrupted = 1;
+	}
+	if( libcthreads_thread_pool_push(
+	     verification_handle->output_thread_pool,
+	     (intptr_t *) storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto output thread pool queue.",
+		 function );
 
-			goto on_error;
-		}
+		goto on_error;
 	}
+	storage_media_buffer = NULL;
+
 	return( 1 );
 
 on_error:
@@ -1555,164 +1635,2718 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Prepares a storage media buffer for verification
+ * Callback function for the process thread pool
  * Returns 1 if successful or -1 on error
  */
-int verification_handle_empty_output_list(
-     verification_handle_t *verification_handle,
-     libcerror_error_t **error )
+int verification_handle_output_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
-	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "verification_handle_empty_output_list";
+	storage_media_buffer_t *released_buffers[ STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_BATCH_SIZE ];
+
+        libcerror_error_t *error       = NULL;
+	uint8_t *data                  = NULL;
+        static char *function          = "verification_handle_output_storage_media_buffer_callback";
+	size_t data_size               = 0;
+	int number_of_released_buffers = 0;
+	int result                     = 0;
 
 	if( verification_handle == NULL )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
 		 "%s: invalid verification handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
-	     error ) != 1 )
+	if( storage_media_buffer == NULL )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->abort != 0 )
+	{
+		return( 1 );
+	}
+	/* The buffers complete out of order, the reorder ring restores the order
+	 * in which they were read using the sequence number of the buffer
+	 */
+	if( reorder_ring_insert_value(
+	     verification_handle->output_reorder_ring,
+	     storage_media_buffer->sequence_number,
+	     (intptr_t *) storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert storage media buffer into output reorder ring.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	while( element != NULL )
+	storage_media_buffer = NULL;
+
+	while( verification_handle->abort == 0 )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
+		result = reorder_ring_get_next_value(
+		          verification_handle->output_reorder_ring,
+		          (intptr_t **) &storage_media_buffer,
+		          &error );
+
+		if( result == -1 )
+		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 "%s: unable to retrieve next storage media buffer from output reorder ring.",
 			 function );
 
-			return( -1 );
+			storage_media_buffer = NULL;
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
 		}
-		if( storage_media_buffer == NULL )
+		result = storage_media_buffer_is_corrupted(
+		          storage_media_buffer,
+		          &error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if storage media buffer is corrupted.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( storage_media_buffer_queue_release_buffer(
+		else if( result != 0 )
+		{
+			/* Append a read error
+			 */
+			if( verification_handle_append_read_error(
+			     verification_handle,
+			     storage_media_buffer->storage_media_offset,
+			     (size_t) verification_handle->chunk_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append read error.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
+
+		if( verification_handle->digest_threads != NULL )
+		{
+			/* The digest threads update the integrity hashes and release the buffer onto the queue
+			 */
+			result = digest_threads_push_buffer(
+			          verification_handle->digest_threads,
+			          storage_media_buffer,
+			          storage_media_buffer->processed_size,
+			          &error );
+
+			storage_media_buffer = NULL;
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push storage media buffer onto digest threads.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			if( storage_media_buffer_get_data(
+			     storage_media_buffer,
+			     &data,
+			     &data_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine storage media buffer data.",
+				 function );
+
+				goto on_error;
+			}
+			if( verification_handle_update_integrity_hash(
+			     verification_handle,
+			     data,
+			     storage_media_buffer->processed_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to update integrity hash(es).",
+				 function );
+
+				goto on_error;
+			}
+			/* The buffers are released onto the queue in batches
+			 */
+			released_buffers[ number_of_released_buffers++ ] = storage_media_buffer;
+
+			storage_media_buffer = NULL;
+
+			if( number_of_released_buffers == STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_BATCH_SIZE )
+			{
+				if( storage_media_buffer_queue_release_buffers(
+				     verification_handle->storage_media_buffer_queue,
+				     released_buffers,
+				     number_of_released_buffers,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to release storage media buffers onto queue.",
+					 function );
+
+					number_of_released_buffers = 0;
+
+					goto on_error;
+				}
+				number_of_released_buffers = 0;
+			}
+		}
+
+		if( process_status_update(
+		     verification_handle->process_status,
+		     verification_handle->last_offset_hashed,
+		     verification_handle->media_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( number_of_released_buffers > 0 )
+	{
+		if( storage_media_buffer_queue_release_buffers(
 		     verification_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     error ) != 1 )
+		     released_buffers,
+		     number_of_released_buffers,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 "%s: unable to release storage media buffers onto queue.",
 			 function );
 
-			return( -1 );
+			number_of_released_buffers = 0;
+
+			goto on_error;
 		}
-		storage_media_buffer = NULL;
+	}
+	return( 1 );
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
+on_error:
+	if( number_of_released_buffers > 0 )
+	{
+		storage_media_buffer_queue_release_buffers(
+		 verification_handle->storage_media_buffer_queue,
+		 released_buffers,
+		 number_of_released_buffers,
+		 NULL );
+	}
+	if( storage_media_buffer != NULL )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     verification_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
+			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
-			return( -1 );
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
 		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     error ) != 1 )
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( verification_handle->abort == 0 )
+	{
+		verification_handle_signal_abort(
+		 verification_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Empties the output reorder ring
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_empty_output_reorder_ring(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+        static char *function                        = "verification_handle_empty_output_reorder_ring";
+	int result                                   = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		result = reorder_ring_remove_value(
+		          verification_handle->output_reorder_ring,
+		          (intptr_t **) &storage_media_buffer,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
+			 "%s: unable to remove storage media buffer from output reorder ring.",
 			 function );
 
 			return( -1 );
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
+		else if( result != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+			if( storage_media_buffer_queue_release_buffer(
+			     verification_handle->storage_media_buffer_queue,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to release storage media buffer onto queue.",
+				 function );
 
-			return( -1 );
+				return( -1 );
+			}
+			storage_media_buffer = NULL;
 		}
-		element = next_element;
 	}
-	return( 1 );
+	while( result != 0 );
+
+	return( 1 );
+}
+
+/* Creates the digest threads
+ * Every integrity hash that is calculated is updated on its own thread
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_initialize_digest_threads(
+     verification_handle_t *verification_handle,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_initialize_digest_threads";
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->digest_threads != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - digest threads value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( verification_handle->calculate_md5 == 0 )
+	 && ( verification_handle->calculate_sha1 == 0 )
+	 && ( verification_handle->calculate_sha256 == 0 ) )
+	{
+		return( 1 );
+	}
+	if( digest_threads_initialize(
+	     &( verification_handle->digest_threads ),
+	     maximum_number_of_queued_items,
+	     (int (*)(storage_media_buffer_t *, void *)) &verification_handle_digested_storage_media_buffer_callback,
+	     (void *) verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create digest threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->calculate_md5 != 0 )
+	{
+		if( digest_threads_append_digest(
+		     verification_handle->digest_threads,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_md5_update,
+		     (intptr_t *) verification_handle->md5_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append MD5 digest thread.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->calculate_sha1 != 0 )
+	{
+		if( digest_threads_append_digest(
+		     verification_handle->digest_threads,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha1_update,
+		     (intptr_t *) verification_handle->sha1_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append SHA1 digest thread.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->calculate_sha256 != 0 )
+	{
+		if( digest_threads_append_digest(
+		     verification_handle->digest_threads,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha256_update,
+		     (intptr_t *) verification_handle->sha256_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append SHA256 digest thread.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( verification_handle->digest_threads != NULL )
+	{
+		digest_threads_free(
+		 &( verification_handle->digest_threads ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases a storage media buffer onto the queue after the integrity hashes were updated
+ * Callback function for the digest threads
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_digested_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle )
+{
+        libcerror_error_t *error = NULL;
+        static char *function    = "verification_handle_digested_storage_media_buffer_callback";
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( storage_media_buffer_queue_release_buffer(
+	     verification_handle->storage_media_buffer_queue,
+	     storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to release storage media buffer onto queue.",
+		 function );
+
+		storage_media_buffer_free(
+		 &storage_media_buffer,
+		 NULL );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( ( verification_handle != NULL )
+	 && ( verification_handle->abort == 0 ) )
+	{
+		verification_handle_signal_abort(
+		 verification_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Verifies the input
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_input(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	uint8_t *data                                = NULL;
+	static char *function                        = "verification_handle_verify_input";
+	size64_t remaining_media_size                = 0;
+	size_t data_size                             = 0;
+	size_t process_buffer_size                   = 0;
+	size_t read_size                             = 0;
+	ssize_t process_count                        = 0;
+	ssize_t read_count                           = 0;
+	off64_t storage_media_offset                 = 0;
+	uint64_t sequence_number                     = 0;
+	uint32_t number_of_checksum_errors           = 0;
+	uint8_t storage_media_buffer_mode            = 0;
+	int is_corrupted                             = 0;
+	int maximum_number_of_queued_items           = 0;
+	int md5_hash_compare                         = 0;
+	int result                                   = 0;
+	int sha1_hash_compare                        = 0;
+	int sha256_hash_compare                      = 0;
+	int status                                   = PROCESS_STATUS_COMPLETED;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size > (size32_t) INT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid process buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_handle_get_media_size(
+	     verification_handle->input_handle,
+	     &( verification_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->use_data_chunk_functions != 0 )
+	{
+		process_buffer_size       = verification_handle->chunk_size;
+		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA;
+	}
+	else
+	{
+		if( verification_handle->process_buffer_size == 0 )
+		{
+			process_buffer_size = verification_handle->chunk_size;
+		}
+		else
+		{
+			process_buffer_size = verification_handle->process_buffer_size;
+		}
+		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		maximum_number_of_queued_items = 1 + (int) ( VERIFICATION_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE / process_buffer_size );
+
+		if( libcthreads_thread_pool_create(
+		     &( verification_handle->process_thread_pool ),
+		     NULL,
+		     verification_handle->number_of_threads,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &verification_handle_process_storage_media_buffer_callback,
+		     (void *) verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize process thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_thread_pool_create(
+		     &( verification_handle->output_thread_pool ),
+		     NULL,
+		     1,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &verification_handle_output_storage_media_buffer_callback,
+		     (void *) verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize output thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		/* There cannot be more buffers outstanding than there are buffers in the storage media buffer queue
+		 */
+		if( reorder_ring_initialize(
+		     &( verification_handle->output_reorder_ring ),
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create output reorder ring.",
+			 function );
+
+			goto on_error;
+		}
+		if( storage_media_buffer_queue_initialize(
+		     &( verification_handle->storage_media_buffer_queue ),
+		     verification_handle->input_handle,
+		     maximum_number_of_queued_items,
+		     storage_media_buffer_mode,
+		     process_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage media buffer queue.",
+			 function );
+
+			goto on_error;
+		}
+		/* The reader threads read from different offsets of the input concurrently
+		 * so that more than a single read is outstanding
+		 */
+		if( verification_handle->number_of_reader_threads > 0 )
+		{
+			if( verification_handle_initialize_reader_handles(
+			     verification_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create reader handles.",
+				 function );
+
+				goto on_error;
+			}
+			if( libcthreads_thread_pool_create(
+			     &( verification_handle->read_thread_pool ),
+			     NULL,
+			     verification_handle->number_of_reader_threads,
+			     maximum_number_of_queued_items,
+			     (int (*)(intptr_t *, void *)) &verification_handle_read_storage_media_buffer_callback,
+			     (void *) verification_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize read thread pool.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	/* Get the integrity hashes from the input first to determine
+	 * which digest (hash) types are used.
+	 */
+	if( verification_handle_get_integrity_hash_from_input(
+	     verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to retrieve integrity hash(es) from input.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle_initialize_integrity_hash(
+	     verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize integrity hash(es).",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		if( verification_handle_initialize_digest_threads(
+		     verification_handle,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	if( process_status_initialize(
+	     &( verification_handle->process_status ),
+	     _SYSTEM_STRING( "Verify" ),
+	     _SYSTEM_STRING( "verified" ),
+	     _SYSTEM_STRING( "Read" ),
+	     verification_handle->notify_stream,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_start(
+	     verification_handle->process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->number_of_threads == 0 )
+	{
+		if( storage_media_buffer_initialize(
+		     &storage_media_buffer,
+		     verification_handle->input_handle,
+		     storage_media_buffer_mode,
+		     process_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	remaining_media_size = verification_handle->media_size;
+
+	while( remaining_media_size > 0 )
+	{
+		if( verification_handle->abort != 0 )
+		{
+			break;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->number_of_threads != 0 )
+		{
+			if( storage_media_buffer_queue_grab_buffer(
+			     verification_handle->storage_media_buffer_queue,
+			     &storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to grab storage media buffer from queue.",
+				 function );
+
+				goto on_error;
+			}
+			if( storage_media_buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing storage media buffer.",
+				 function );
+
+				goto on_error;
+			}
+			storage_media_buffer->sequence_number = sequence_number++;
+		}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+		read_size = process_buffer_size;
+
+		if( remaining_media_size < read_size )
+		{
+			read_size = (size_t) remaining_media_size;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->read_thread_pool != NULL )
+		{
+			storage_media_buffer->storage_media_offset = storage_media_offset;
+			storage_media_buffer->requested_size       = read_size;
+
+			if( libcthreads_thread_pool_push(
+			     verification_handle->read_thread_pool,
+			     (intptr_t *) storage_media_buffer,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push storage media buffer onto read thread pool queue.",
+				 function );
+
+				goto on_error;
+			}
+			storage_media_buffer = NULL;
+
+			storage_media_offset += read_size;
+			remaining_media_size -= read_size;
+
+			continue;
+		}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+		read_count = storage_media_buffer_read_from_handle(
+		              storage_media_buffer,
+		              verification_handle->input_handle,
+		              read_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data.",
+			 function );
+
+			goto on_error;
+		}
+		if( read_count == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of data.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer->storage_media_offset = storage_media_offset;
+
+		storage_media_offset += read_count;
+		remaining_media_size -= read_count;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->number_of_threads != 0 )
+		{
+			if( libcthreads_thread_pool_push(
+			     verification_handle->process_thread_pool,
+			     (intptr_t *) storage_media_buffer,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push storage media buffer onto process thread pool queue.",
+				 function );
+
+				goto on_error;
+			}
+			storage_media_buffer = NULL;
+		}
+		else
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+		{
+			process_count = storage_media_buffer_read_process(
+			                 storage_media_buffer,
+		        	         error );
+
+			if( process_count < 0 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( ( libcnotify_verbose != 0 )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+#endif
+				libcerror_error_free(
+				 error );
+
+				process_count = verification_handle->chunk_size;
+
+				storage_media_buffer->is_corrupted = 1;
+			}
+			result = storage_media_buffer_is_corrupted(
+			          storage_media_buffer,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if storage media buffer is corrupted.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				/* Append a read error
+				 */
+				if( verification_handle_append_read_error(
+				     verification_handle,
+				     storage_media_buffer->storage_media_offset,
+				     (size_t) verification_handle->chunk_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append read error.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( storage_media_buffer_get_data(
+			     storage_media_buffer,
+			     &data,
+			     &data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine storage media buffer data.",
+				 function );
+
+				goto on_error;
+			}
+			if( verification_handle_update_integrity_hash(
+			     verification_handle,
+			     data,
+			     storage_media_buffer->processed_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to update integrity hash(es).",
+				 function );
+
+				goto on_error;
+			}
+			verification_handle->last_offset_hashed += (off64_t) process_count;
+
+			if( process_status_update(
+			     verification_handle->process_status,
+			     verification_handle->last_offset_hashed,
+			     verification_handle->media_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update process status.",
+				 function );
+
+				goto on_error;
+			}
+		}
+  	}
+	if( verification_handle->number_of_threads == 0 )
+	{
+		if( storage_media_buffer_free(
+		     &storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->read_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( verification_handle->read_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->reader_handles != NULL )
+	{
+		if( verification_handle_free_reader_handles(
+		     verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reader handles.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->process_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( verification_handle->process_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join process thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->output_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( verification_handle->output_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join output thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The digest threads are joined after the output thread that feeds them
+	 */
+	if( verification_handle->digest_threads != NULL )
+	{
+		if( digest_threads_join(
+		     verification_handle->digest_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest threads.",
+			 function );
+
+			goto on_error;
+		}
+		if( digest_threads_free(
+		     &( verification_handle->digest_threads ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->output_reorder_ring != NULL )
+	{
+		if( verification_handle_empty_output_reorder_ring(
+		     verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty output reorder ring.",
+			 function );
+
+			goto on_error;
+		}
+		if( reorder_ring_free(
+		     &( verification_handle->output_reorder_ring ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output reorder ring.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->storage_media_buffer_queue != NULL )
+	{
+		if( storage_media_buffer_queue_free(
+		     &( verification_handle->storage_media_buffer_queue ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage media buffer queue.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	if( verification_handle_finalize_integrity_hash(
+	     verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize integrity hash(es).",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->abort != 0 )
+	{
+		status = PROCESS_STATUS_ABORTED;
+	}
+	if( process_status_stop(
+	     verification_handle->process_status,
+	     verification_handle->last_offset_hashed,
+	     status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_free(
+	     &( verification_handle->process_status ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->abort == 0 )
+	{
+		fprintf(
+		 verification_handle->notify_stream,
+		 "\n" );
+
+		if( verification_handle_checksum_errors_fprint(
+		     verification_handle,
+		     verification_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print checksum errors.",
+			 function );
+
+			goto on_error;
+		}
+		if( verification_handle_hash_values_fprint(
+		     verification_handle,
+		     verification_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print hash values.",
+			 function );
+
+			goto on_error;
+		}
+		if( verification_handle_additional_hash_values_fprint(
+		     verification_handle,
+		     verification_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print additional hash values.",
+			 function );
+
+			goto on_error;
+		}
+		fprintf(
+		 verification_handle->notify_stream,
+		 "\n" );
+
+		if( log_handle != NULL )
+		{
+			if( verification_handle_checksum_errors_fprint(
+			     verification_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print checksum errors in log handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( verification_handle_hash_values_fprint(
+			     verification_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print hash values in log handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( verification_handle_additional_hash_values_fprint(
+			     verification_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print additional hash values in log handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	is_corrupted = libewf_handle_segment_files_corrupted(
+	                verification_handle->input_handle,
+	                error );
+
+	if( is_corrupted == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if segment files are corrupted.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_number_of_checksum_errors(
+	     verification_handle->input_handle,
+	     &number_of_checksum_errors,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of checksum errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( verification_handle->calculate_md5 != 0 )
+	 && ( verification_handle->stored_md5_hash_available != 0 ) )
+	{
+		md5_hash_compare = system_string_compare(
+		                    verification_handle->stored_md5_hash_string,
+		                    verification_handle->calculated_md5_hash_string,
+		                    33 );
+	}
+	if( ( verification_handle->calculate_sha1 != 0 )
+	 && ( verification_handle->stored_sha1_hash_available != 0 ) )
+	{
+		sha1_hash_compare = system_string_compare(
+		                     verification_handle->stored_sha1_hash_string,
+		                     verification_handle->calculated_sha1_hash_string,
+		                     41 );
+	}
+	if( ( verification_handle->calculate_sha256 != 0 )
+	 && ( verification_handle->stored_sha256_hash_available != 0 ) )
+	{
+		sha256_hash_compare = system_string_compare(
+		                       verification_handle->stored_sha256_hash_string,
+		                       verification_handle->calculated_sha256_hash_string,
+		                       65 );
+	}
+	/* Note that a set of EWF files can be verified without an integrity hash
+	 */
+	if( ( is_corrupted == 0 )
+	 && ( number_of_checksum_errors == 0 )
+	 && ( md5_hash_compare == 0 )
+	 && ( sha1_hash_compare == 0 )
+	 && ( sha256_hash_compare == 0 ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+
+on_error:
+	if( ( verification_handle->number_of_threads == 0 )
+	 && ( storage_media_buffer != NULL ) )
+	{
+		storage_media_buffer_free(
+		 &storage_media_buffer,
+		 NULL );
+	}
+	if( verification_handle->process_status != NULL )
+	{
+		process_status_stop(
+		 verification_handle->process_status,
+		 verification_handle->last_offset_hashed,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &( verification_handle->process_status ),
+		 NULL );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->read_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( verification_handle->read_thread_pool ),
+		 NULL );
+	}
+	if( verification_handle->reader_handles != NULL )
+	{
+		verification_handle_free_reader_handles(
+		 verification_handle,
+		 NULL );
+	}
+	if( verification_handle->process_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( verification_handle->process_thread_pool ),
+		 NULL );
+	}
+	if( verification_handle->output_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( verification_handle->output_thread_pool ),
+		 NULL );
+	}
+	if( verification_handle->digest_threads != NULL )
+	{
+		digest_threads_free(
+		 &( verification_handle->digest_threads ),
+		 NULL );
+	}
+	if( verification_handle->output_reorder_ring != NULL )
+	{
+		verification_handle_empty_output_reorder_ring(
+		 verification_handle,
+		 NULL );
+		reorder_ring_free(
+		 &( verification_handle->output_reorder_ring ),
+		 NULL );
+	}
+	if( verification_handle->storage_media_buffer_queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &( verification_handle->storage_media_buffer_queue ),
+		 NULL );
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( -1 );
+}
+
+/* Verifies a chunk hash tree leaf
+ * The storage media offset of the storage media buffer must be set to the offset of the leaf
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_verify_chunk_hash_tree_leaf(
+     verification_handle_t *verification_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	uint8_t calculated_hash[ CHUNK_HASH_TREE_HASH_SIZE ];
+
+	static char *function   = "verification_handle_verify_chunk_hash_tree_leaf";
+	ssize_t read_count      = 0;
+	off64_t leaf_offset     = 0;
+	uint64_t leaf_index     = 0;
+	size32_t leaf_data_size = 0;
+	int result              = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing chunk hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->leaf_results == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing leaf results.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->storage_media_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid storage media buffer - storage media offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	leaf_index = (uint64_t) storage_media_buffer->storage_media_offset / verification_handle->chunk_hash_tree->leaf_size;
+
+	if( ( leaf_index < verification_handle->first_leaf_index )
+	 || ( ( leaf_index - verification_handle->first_leaf_index ) >= verification_handle->number_of_leaves ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid leaf index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_hash_tree_get_leaf_range(
+	     verification_handle->chunk_hash_tree,
+	     leaf_index,
+	     &leaf_offset,
+	     &leaf_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range of leaf: %" PRIu64 ".",
+		 function,
+		 leaf_index );
+
+		return( -1 );
+	}
+	read_count = storage_media_buffer_read_from_handle_at_offset(
+	              storage_media_buffer,
+	              verification_handle->input_handle,
+	              (size_t) leaf_data_size,
+	              leaf_offset,
+	              error );
+
+	if( read_count != (ssize_t) leaf_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data of leaf: %" PRIu64 ".",
+		 function,
+		 leaf_index );
+
+		return( -1 );
+	}
+	if( libhmac_sha256_calculate(
+	     storage_media_buffer->raw_buffer,
+	     (size_t) read_count,
+	     calculated_hash,
+	     CHUNK_HASH_TREE_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate SHA256 hash of leaf: %" PRIu64 ".",
+		 function,
+		 leaf_index );
+
+		return( -1 );
+	}
+	result = chunk_hash_tree_compare_leaf_hash(
+	          verification_handle->chunk_hash_tree,
+	          leaf_index,
+	          calculated_hash,
+	          CHUNK_HASH_TREE_HASH_SIZE,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compare hash of leaf: %" PRIu64 ".",
+		 function,
+		 leaf_index );
+
+		return( -1 );
+	}
+	/* Every leaf has its own result value hence no locking is needed
+	 */
+	verification_handle->leaf_results[ leaf_index - verification_handle->first_leaf_index ] = (uint8_t) result;
+
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Verifies a chunk hash tree leaf on a worker thread
+ * Callback function for the process thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_verify_chunk_hash_tree_leaf_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "verification_handle_verify_chunk_hash_tree_leaf_callback";
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->abort == 0 )
+	{
+		if( verification_handle_verify_chunk_hash_tree_leaf(
+		     verification_handle,
+		     storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to verify chunk hash tree leaf.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( storage_media_buffer_queue_release_buffer(
+	     verification_handle->storage_media_buffer_queue,
+	     storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release storage media buffer onto queue.",
+		 function );
+
+		storage_media_buffer = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( storage_media_buffer != NULL )
+	{
+		storage_media_buffer_queue_release_buffer(
+		 verification_handle->storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( verification_handle->abort == 0 )
+	{
+		verification_handle_signal_abort(
+		 verification_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Verifies the input against a chunk hash tree file
+ * Only the leaves that overlap with the range are read and verified,
+ * a range size of 0 represents the remainder of the media data
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_chunk_hash_tree(
+     verification_handle_t *verification_handle,
+     const system_character_t *filename,
+     off64_t range_offset,
+     size64_t range_size,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "verification_handle_verify_chunk_hash_tree";
+	size64_t verified_size                       = 0;
+	size64_t verify_size                         = 0;
+	size_t leaf_results_size                     = 0;
+	off64_t leaf_offset                          = 0;
+	uint64_t leaf_index                          = 0;
+	uint64_t last_leaf_index                     = 0;
+	uint64_t number_of_mismatches                = 0;
+	uint32_t number_of_checksum_errors           = 0;
+	size32_t leaf_data_size                      = 0;
+	int maximum_number_of_queued_items           = 0;
+	int status                                   = PROCESS_STATUS_COMPLETED;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_hash_tree != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - chunk hash tree value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_handle_get_media_size(
+	     verification_handle->input_handle,
+	     &( verification_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( chunk_hash_tree_initialize_from_file(
+	     &( verification_handle->chunk_hash_tree ),
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk hash tree file.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->chunk_hash_tree->media_size != verification_handle->media_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: mismatch in media size of chunk hash tree: %" PRIu64 " and input: %" PRIu64 ".",
+		 function,
+		 verification_handle->chunk_hash_tree->media_size,
+		 verification_handle->media_size );
+
+		goto on_error;
+	}
+	if( (size64_t) range_offset >= verification_handle->media_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range offset value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( range_size == 0 )
+	 || ( range_size > ( verification_handle->media_size - (size64_t) range_offset ) ) )
+	{
+		range_size = verification_handle->media_size - (size64_t) range_offset;
+	}
+	verification_handle->first_leaf_index = (uint64_t) range_offset / verification_handle->chunk_hash_tree->leaf_size;
+	last_leaf_index                       = ( (uint64_t) range_offset + range_size - 1 ) / verification_handle->chunk_hash_tree->leaf_size;
+	verification_handle->number_of_leaves = last_leaf_index - verification_handle->first_leaf_index + 1;
+
+	/* Whole leaves are verified hence the range is extended to the leaf boundaries
+	 */
+	verify_size = ( last_leaf_index + 1 ) * verification_handle->chunk_hash_tree->leaf_size;
+
+	if( verify_size > verification_handle->media_size )
+	{
+		verify_size = verification_handle->media_size;
+	}
+	verify_size -= verification_handle->first_leaf_index * verification_handle->chunk_hash_tree->leaf_size;
+
+	if( verification_handle->number_of_leaves > (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of leaves value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	leaf_results_size = (size_t) verification_handle->number_of_leaves;
+
+	verification_handle->leaf_results = (uint8_t *) memory_allocate(
+	                                                 sizeof( uint8_t ) * leaf_results_size );
+
+	if( verification_handle->leaf_results == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create leaf results.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     verification_handle->leaf_results,
+	     0,
+	     sizeof( uint8_t ) * leaf_results_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear leaf results.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		/* The leaves are read and hashed by the worker threads
+		 */
+		maximum_number_of_queued_items = 1 + (int) ( VERIFICATION_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE / verification_handle->chunk_hash_tree->leaf_size );
+
+		if( maximum_number_of_queued_items < verification_handle->number_of_threads )
+		{
+			maximum_number_of_queued_items = verification_handle->number_of_threads;
+		}
+		if( libcthreads_thread_pool_create(
+		     &( verification_handle->process_thread_pool ),
+		     NULL,
+		     verification_handle->number_of_threads,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &verification_handle_verify_chunk_hash_tree_leaf_callback,
+		     (void *) verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize process thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( storage_media_buffer_queue_initialize(
+		     &( verification_handle->storage_media_buffer_queue ),
+		     verification_handle->input_handle,
+		     maximum_number_of_queued_items,
+		     STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+		     (size_t) verification_handle->chunk_hash_tree->leaf_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage media buffer queue.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	if( process_status_initialize(
+	     &( verification_handle->process_status ),
+	     _SYSTEM_STRING( "Verify" ),
+	     _SYSTEM_STRING( "verified" ),
+	     _SYSTEM_STRING( "Read" ),
+	     verification_handle->notify_stream,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_start(
+	     verification_handle->process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->number_of_threads == 0 )
+	{
+		if( storage_media_buffer_initialize(
+		     &storage_media_buffer,
+		     verification_handle->input_handle,
+		     STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+		     (size_t) verification_handle->chunk_hash_tree->leaf_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( leaf_index = verification_handle->first_leaf_index;
+	     leaf_index <= last_leaf_index;
+	     leaf_index++ )
+	{
+		if( verification_handle->abort != 0 )
+		{
+			break;
+		}
+		if( chunk_hash_tree_get_leaf_range(
+		     verification_handle->chunk_hash_tree,
+		     leaf_index,
+		     &leaf_offset,
+		     &leaf_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range of leaf: %" PRIu64 ".",
+			 function,
+			 leaf_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->number_of_threads != 0 )
+		{
+			if( storage_media_buffer_queue_grab_buffer(
+			     verification_handle->storage_media_buffer_queue,
+			     &storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to grab storage media buffer from queue.",
+				 function );
+
+				goto on_error;
+			}
+			if( storage_media_buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing storage media buffer.",
+				 function );
+
+				goto on_error;
+			}
+			storage_media_buffer->storage_media_offset = leaf_offset;
+
+			if( libcthreads_thread_pool_push(
+			     verification_handle->process_thread_pool,
+			     (intptr_t *) storage_media_buffer,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push storage media buffer onto process thread pool queue.",
+				 function );
+
+				storage_media_buffer_queue_release_buffer(
+				 verification_handle->storage_media_buffer_queue,
+				 storage_media_buffer,
+				 NULL );
+
+				storage_media_buffer = NULL;
+
+				goto on_error;
+			}
+			storage_media_buffer = NULL;
+		}
+		else
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+		{
+			storage_media_buffer->storage_media_offset = leaf_offset;
+
+			if( verification_handle_verify_chunk_hash_tree_leaf(
+			     verification_handle,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to verify leaf: %" PRIu64 ".",
+				 function,
+				 leaf_index );
+
+				goto on_error;
+			}
+		}
+		verified_size += leaf_data_size;
+
+		if( process_status_update(
+		     verification_handle->process_status,
+		     verified_size,
+		     verify_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->number_of_threads == 0 )
+	{
+		if( storage_media_buffer_free(
+		     &storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->process_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( verification_handle->process_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join process thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->storage_media_buffer_queue != NULL )
+	{
+		if( storage_media_buffer_queue_free(
+		     &( verification_handle->storage_media_buffer_queue ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage media buffer queue.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	if( verification_handle->abort != 0 )
+	{
+		status = PROCESS_STATUS_ABORTED;
+	}
+	if( process_status_stop(
+	     verification_handle->process_status,
+	     verified_size,
+	     status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_free(
+	     &( verification_handle->process_status ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	for( leaf_index = 0;
+	     leaf_index < verification_handle->number_of_leaves;
+	     leaf_index++ )
+	{
+		if( verification_handle->leaf_results[ leaf_index ] == 0 )
+		{
+			number_of_mismatches++;
+		}
+	}
+	fprintf(
+	 verification_handle->notify_stream,
+	 "\n" );
+
+	if( verification_handle_checksum_errors_fprint(
+	     verification_handle,
+	     verification_handle->notify_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print checksum errors.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle_chunk_hash_tree_mismatches_fprint(
+	     verification_handle,
+	     verification_handle->notify_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print chunk hash tree mismatches.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 verification_handle->notify_stream,
+	 "\n" );
+
+	if( log_handle != NULL )
+	{
+		if( verification_handle_checksum_errors_fprint(
+		     verification_handle,
+		     log_handle->log_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print checksum errors in log handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( verification_handle_chunk_hash_tree_mismatches_fprint(
+		     verification_handle,
+		     log_handle->log_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print chunk hash tree mismatches in log handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_get_number_of_checksum_errors(
+	     verification_handle->input_handle,
+	     &number_of_checksum_errors,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of checksum errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_mismatches == 0 )
+	 && ( number_of_checksum_errors == 0 ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+
+on_error:
+	if( ( verification_handle->number_of_threads == 0 )
+	 && ( storage_media_buffer != NULL ) )
+	{
+		storage_media_buffer_free(
+		 &storage_media_buffer,
+		 NULL );
+	}
+	if( verification_handle->process_status != NULL )
+	{
+		process_status_stop(
+		 verification_handle->process_status,
+		 verified_size,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &( verification_handle->process_status ),
+		 NULL );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->process_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( verification_handle->process_thread_pool ),
+		 NULL );
+	}
+	if( verification_handle->storage_media_buffer_queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &( verification_handle->storage_media_buffer_queue ),
+		 NULL );
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( -1 );
+}
+
+/* Prints the chunk hash tree leaves that did not match to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_chunk_hash_tree_mismatches_fprint(
+     verification_handle_t *verification_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function         = "verification_handle_chunk_hash_tree_mismatches_fprint";
+	off64_t leaf_offset           = 0;
+	uint64_t leaf_index           = 0;
+	uint64_t number_of_mismatches = 0;
+	uint64_t result_index         = 0;
+	size32_t leaf_data_size       = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->leaf_results == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing leaf results.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	for( result_index = 0;
+	     result_index < verification_handle->number_of_leaves;
+	     result_index++ )
+	{
+		if( verification_handle->leaf_results[ result_index ] == 0 )
+		{
+			number_of_mismatches++;
+		}
+	}
+	fprintf(
+	 stream,
+	 "Chunk hash tree leaves verified:\t%" PRIu64 "\n",
+	 verification_handle->number_of_leaves );
+
+	if( number_of_mismatches > 0 )
+	{
+		fprintf(
+		 stream,
+		 "Chunk hash tree mismatches:\n" );
+		fprintf(
+		 stream,
+		 "\ttotal number: %" PRIu64 "\n",
+		 number_of_mismatches );
+
+		for( result_index = 0;
+		     result_index < verification_handle->number_of_leaves;
+		     result_index++ )
+		{
+			if( verification_handle->leaf_results[ result_index ] != 0 )
+			{
+				continue;
+			}
+			leaf_index = verification_handle->first_leaf_index + result_index;
+
+			if( chunk_hash_tree_get_leaf_range(
+			     verification_handle->chunk_hash_tree,
+			     leaf_index,
+			     &leaf_offset,
+			     &leaf_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve range of leaf: %" PRIu64 ".",
+				 function,
+				 leaf_index );
+
+				return( -1 );
+			}
+			fprintf(
+			 stream,
+			 "\tat offset: %" PRIi64 " - %" PRIi64 " (size: %" PRIu32 ")\n",
+			 leaf_offset,
+			 leaf_offset + leaf_data_size - 1,
+			 leaf_data_size );
+		}
+	}
+	return( 1 );
+}
+
+/* Verifies the chunks of a storage media buffer
+ * The chunks are read and unpacked which validates their checksums and compressed data,
+ * chunks that fail to validate are added to the checksum errors of the input handle
+ * The storage media offset and requested size of the storage media buffer must be set
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_verify_chunks(
+     verification_handle_t *verification_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_verify_chunks";
+	ssize_t read_count    = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_BUFFERED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid storage media buffer - unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	/* The input handle supports reads at an offset from multiple threads
+	 */
+	read_count = storage_media_buffer_read_from_handle_at_offset(
+	              storage_media_buffer,
+	              verification_handle->input_handle,
+	              storage_media_buffer->requested_size,
+	              storage_media_buffer->storage_media_offset,
+	              error );
+
+	if( read_count != (ssize_t) storage_media_buffer->requested_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunks at offset: %" PRIi64 ".",
+		 function,
+		 storage_media_buffer->storage_media_offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Verifies the chunks of a storage media buffer on a worker thread
+ * Callback function for the process thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_verify_chunks_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "verification_handle_verify_chunks_callback";
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->abort == 0 )
+	{
+		if( verification_handle_verify_chunks(
+		     verification_handle,
+		     storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to verify chunks.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( storage_media_buffer_queue_release_buffer(
+	     verification_handle->storage_media_buffer_queue,
+	     storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release storage media buffer onto queue.",
+		 function );
+
+		storage_media_buffer = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( storage_media_buffer != NULL )
+	{
+		storage_media_buffer_queue_release_buffer(
+		 verification_handle->storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( verification_handle->abort == 0 )
+	{
+		verification_handle_signal_abort(
+		 verification_handle,
+		 NULL );
+	}
+	return( -1 );
 }
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
-/* Verifies the input
+/* Verifies the chunk checksums of the input
+ * Every chunk is read and unpacked to validate its checksum and compressed data
+ * without calculating the digest (hash) of the media data. Since the chunks
+ * are verified independently of each other they are verified in any order
  * Returns 1 if successful, 0 if not or -1 on error
  */
-int verification_handle_verify_input(
+int verification_handle_verify_chunk_checksums(
      verification_handle_t *verification_handle,
      uint8_t print_status_information,
      log_handle_t *log_handle,
      libcerror_error_t **error )
 {
 	storage_media_buffer_t *storage_media_buffer = NULL;
-	uint8_t *data                                = NULL;
-	static char *function                        = "verification_handle_verify_input";
+	static char *function                        = "verification_handle_verify_chunk_checksums";
 	size64_t remaining_media_size                = 0;
-	size_t data_size                             = 0;
 	size_t process_buffer_size                   = 0;
 	size_t read_size                             = 0;
-	ssize_t process_count                        = 0;
-	ssize_t read_count                           = 0;
 	off64_t storage_media_offset                 = 0;
 	uint32_t number_of_checksum_errors           = 0;
-	uint8_t storage_media_buffer_mode            = 0;
 	int is_corrupted                             = 0;
 	int maximum_number_of_queued_items           = 0;
-	int md5_hash_compare                         = 0;
-	int result                                   = 0;
-	int sha1_hash_compare                        = 0;
-	int sha256_hash_compare                      = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
 	if( verification_handle == NULL )
@@ -1737,17 +4371,6 @@ int verification_handle_verify_input(
 
 		return( -1 );
 	}
-	if( verification_handle->chunk_size > (size32_t) INT32_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk size value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
 	if( verification_handle->process_buffer_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
@@ -1786,34 +4409,32 @@ int verification_handle_verify_input(
 
 		goto on_error;
 	}
-	if( verification_handle->use_data_chunk_functions != 0 )
-	{
-		process_buffer_size       = verification_handle->chunk_size;
-		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA;
-	}
-	else
+	/* Chunk aligned reads of entire chunks are unpacked directly into the buffer
+	 * hence the process buffer size is rounded down to a multiple of the chunk size
+	 */
+	process_buffer_size = verification_handle->process_buffer_size;
+
+	if( process_buffer_size < (size_t) verification_handle->chunk_size )
 	{
-		if( verification_handle->process_buffer_size == 0 )
-		{
-			process_buffer_size = verification_handle->chunk_size;
-		}
-		else
-		{
-			process_buffer_size = verification_handle->process_buffer_size;
-		}
-		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
+		process_buffer_size = (size_t) verification_handle->chunk_size;
 	}
+	process_buffer_size -= process_buffer_size % verification_handle->chunk_size;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( verification_handle->number_of_threads != 0 )
 	{
 		maximum_number_of_queued_items = 1 + (int) ( VERIFICATION_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE / process_buffer_size );
 
+		if( maximum_number_of_queued_items < verification_handle->number_of_threads )
+		{
+			maximum_number_of_queued_items = verification_handle->number_of_threads;
+		}
 		if( libcthreads_thread_pool_create(
 		     &( verification_handle->process_thread_pool ),
 		     NULL,
 		     verification_handle->number_of_threads,
 		     maximum_number_of_queued_items,
-		     (int (*)(intptr_t *, void *)) &verification_handle_process_storage_media_buffer_callback,
+		     (int (*)(intptr_t *, void *)) &verification_handle_verify_chunks_callback,
 		     (void *) verification_handle,
 		     error ) != 1 )
 		{
@@ -1826,42 +4447,11 @@ int verification_handle_verify_input(
 
 			goto on_error;
 		}
-		if( libcthreads_thread_pool_create(
-		     &( verification_handle->output_thread_pool ),
-		     NULL,
-		     1,
-		     maximum_number_of_queued_items,
-		     (int (*)(intptr_t *, void *)) &verification_handle_output_storage_media_buffer_callback,
-		     (void *) verification_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize output thread pool.",
-			 function );
-
-			goto on_error;
-		}
-		if( libcdata_list_initialize(
-		     &( verification_handle->output_list ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
-			 function );
-
-			goto on_error;
-		}
 		if( storage_media_buffer_queue_initialize(
 		     &( verification_handle->storage_media_buffer_queue ),
 		     verification_handle->input_handle,
 		     maximum_number_of_queued_items,
-		     storage_media_buffer_mode,
+		     STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
 		     process_buffer_size,
 		     error ) != 1 )
 		{
@@ -1877,35 +4467,6 @@ int verification_handle_verify_input(
 	}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
-	/* Get the integrity hashes from the input first to determine
-	 * which digest (hash) types are used.
-	 */
-	if( verification_handle_get_integrity_hash_from_input(
-	     verification_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to retrieve integrity hash(es) from input.",
-		 function );
-
-		goto on_error;
-	}
-	if( verification_handle_initialize_integrity_hash(
-	     verification_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize integrity hash(es).",
-		 function );
-
-		goto on_error;
-	}
 	if( process_status_initialize(
 	     &( verification_handle->process_status ),
 	     _SYSTEM_STRING( "Verify" ),
@@ -1942,7 +4503,7 @@ int verification_handle_verify_input(
 		if( storage_media_buffer_initialize(
 		     &storage_media_buffer,
 		     verification_handle->input_handle,
-		     storage_media_buffer_mode,
+		     STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
 		     process_buffer_size,
 		     error ) != 1 )
 		{
@@ -1964,6 +4525,12 @@ int verification_handle_verify_input(
 		{
 			break;
 		}
+		read_size = process_buffer_size;
+
+		if( remaining_media_size < read_size )
+		{
+			read_size = (size_t) remaining_media_size;
+		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( verification_handle->number_of_threads != 0 )
 		{
@@ -1992,51 +4559,9 @@ int verification_handle_verify_input(
 
 				goto on_error;
 			}
-		}
-#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
-
-		read_size = process_buffer_size;
-
-		if( remaining_media_size < read_size )
-		{
-			read_size = (size_t) remaining_media_size;
-		}
-		read_count = storage_media_buffer_read_from_handle(
-		              storage_media_buffer,
-		              verification_handle->input_handle,
-		              read_size,
-		              error );
-
-		if( read_count < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read data.",
-			 function );
-
-			goto on_error;
-		}
-		if( read_count == 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unexpected end of data.",
-			 function );
-
-			goto on_error;
-		}
-		storage_media_buffer->storage_media_offset = storage_media_offset;
-
-		storage_media_offset += read_count;
-		remaining_media_size -= read_count;
+			storage_media_buffer->storage_media_offset = storage_media_offset;
+			storage_media_buffer->requested_size       = read_size;
 
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-		if( verification_handle->number_of_threads != 0 )
-		{
 			if( libcthreads_thread_pool_push(
 			     verification_handle->process_thread_pool,
 			     (intptr_t *) storage_media_buffer,
@@ -2049,6 +4574,13 @@ int verification_handle_verify_input(
 				 "%s: unable to push storage media buffer onto process thread pool queue.",
 				 function );
 
+				storage_media_buffer_queue_release_buffer(
+				 verification_handle->storage_media_buffer_queue,
+				 storage_media_buffer,
+				 NULL );
+
+				storage_media_buffer = NULL;
+
 				goto on_error;
 			}
 			storage_media_buffer = NULL;
@@ -2056,185 +4588,72 @@ int verification_handle_verify_input(
 		else
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 		{
-			process_count = storage_media_buffer_read_process(
-			                 storage_media_buffer,
-		        	         error );
-
-			if( process_count < 0 )
-			{
-#if defined( HAVE_VERBOSE_OUTPUT )
-				if( ( libcnotify_verbose != 0 )
-				 && ( *error != NULL ) )
-				{
-					libcnotify_print_error_backtrace(
-					 *error );
-				}
-#endif
-				libcerror_error_free(
-				 error );
-
-				process_count = verification_handle->chunk_size;
-
-				storage_media_buffer->is_corrupted = 1;
-			}
-			result = storage_media_buffer_is_corrupted(
-			          storage_media_buffer,
-			          error );
-
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if storage media buffer is corrupted.",
-				 function );
-
-				goto on_error;
-			}
-			else if( result != 0 )
-			{
-				/* Append a read error
-				 */
-				if( verification_handle_append_read_error(
-				     verification_handle,
-				     storage_media_buffer->storage_media_offset,
-				     (size_t) verification_handle->chunk_size,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-					 "%s: unable to append read error.",
-					 function );
-
-					goto on_error;
-				}
-			}
-			if( storage_media_buffer_get_data(
-			     storage_media_buffer,
-			     &data,
-			     &data_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine storage media buffer data.",
-				 function );
+			storage_media_buffer->storage_media_offset = storage_media_offset;
+			storage_media_buffer->requested_size       = read_size;
 
-				goto on_error;
-			}
-			if( verification_handle_update_integrity_hash(
+			if( verification_handle_verify_chunks(
 			     verification_handle,
-			     data,
-			     storage_media_buffer->processed_size,
+			     storage_media_buffer,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to update integrity hash(es).",
-				 function );
-
-				goto on_error;
-			}
-			verification_handle->last_offset_hashed += (off64_t) process_count;
-
-			if( process_status_update(
-			     verification_handle->process_status,
-			     verification_handle->last_offset_hashed,
-			     verification_handle->media_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to update process status.",
-				 function );
+				 "%s: unable to verify chunks at offset: %" PRIi64 ".",
+				 function,
+				 storage_media_offset );
 
 				goto on_error;
 			}
 		}
-  	}
-	if( verification_handle->number_of_threads == 0 )
-	{
-		if( storage_media_buffer_free(
-		     &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free storage media buffer.",
-			 function );
+		storage_media_offset += read_size;
+		remaining_media_size -= read_size;
 
-			goto on_error;
-		}
-	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( verification_handle->process_thread_pool != NULL )
-	{
-		if( libcthreads_thread_pool_join(
-		     &( verification_handle->process_thread_pool ),
+		if( process_status_update(
+		     verification_handle->process_status,
+		     (size64_t) storage_media_offset,
+		     verification_handle->media_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join process thread pool.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( verification_handle->output_thread_pool != NULL )
+	if( verification_handle->number_of_threads == 0 )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( verification_handle->output_thread_pool ),
+		if( storage_media_buffer_free(
+		     &storage_media_buffer,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join output thread pool.",
+			 "%s: unable to free storage media buffer.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( verification_handle->output_list != NULL )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->process_thread_pool != NULL )
 	{
-		if( verification_handle_empty_output_list(
-		     verification_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
-			 function );
-
-			goto on_error;
-		}
-		if( libcdata_list_free(
-		     &( verification_handle->output_list ),
-		     NULL,
+		if( libcthreads_thread_pool_join(
+		     &( verification_handle->process_thread_pool ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to join process thread pool.",
 			 function );
 
 			goto on_error;
@@ -2258,26 +4677,13 @@ int verification_handle_verify_input(
 	}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
-	if( verification_handle_finalize_integrity_hash(
-	     verification_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to finalize integrity hash(es).",
-		 function );
-
-		goto on_error;
-	}
 	if( verification_handle->abort != 0 )
 	{
 		status = PROCESS_STATUS_ABORTED;
 	}
 	if( process_status_stop(
 	     verification_handle->process_status,
-	     verification_handle->last_offset_hashed,
+	     (size64_t) storage_media_offset,
 	     status,
 	     error ) != 1 )
 	{
@@ -2303,103 +4709,48 @@ int verification_handle_verify_input(
 
 		goto on_error;
 	}
-	if( verification_handle->abort == 0 )
+	if( verification_handle->abort != 0 )
 	{
-		fprintf(
-		 verification_handle->notify_stream,
-		 "\n" );
+		return( 0 );
+	}
+	fprintf(
+	 verification_handle->notify_stream,
+	 "\n" );
 
-		if( verification_handle_checksum_errors_fprint(
-		     verification_handle,
-		     verification_handle->notify_stream,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print checksum errors.",
-			 function );
+	if( verification_handle_checksum_errors_fprint(
+	     verification_handle,
+	     verification_handle->notify_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print checksum errors.",
+		 function );
 
-			goto on_error;
-		}
-		if( verification_handle_hash_values_fprint(
-		     verification_handle,
-		     verification_handle->notify_stream,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print hash values.",
-			 function );
+		goto on_error;
+	}
+	fprintf(
+	 verification_handle->notify_stream,
+	 "\n" );
 
-			goto on_error;
-		}
-		if( verification_handle_additional_hash_values_fprint(
+	if( log_handle != NULL )
+	{
+		if( verification_handle_checksum_errors_fprint(
 		     verification_handle,
-		     verification_handle->notify_stream,
+		     log_handle->log_stream,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print additional hash values.",
+			 "%s: unable to print checksum errors in log handle.",
 			 function );
 
 			goto on_error;
 		}
-		fprintf(
-		 verification_handle->notify_stream,
-		 "\n" );
-
-		if( log_handle != NULL )
-		{
-			if( verification_handle_checksum_errors_fprint(
-			     verification_handle,
-			     log_handle->log_stream,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print checksum errors in log handle.",
-				 function );
-
-				goto on_error;
-			}
-			if( verification_handle_hash_values_fprint(
-			     verification_handle,
-			     log_handle->log_stream,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print hash values in log handle.",
-				 function );
-
-				goto on_error;
-			}
-			if( verification_handle_additional_hash_values_fprint(
-			     verification_handle,
-			     log_handle->log_stream,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print additional hash values in log handle.",
-				 function );
-
-				goto on_error;
-			}
-		}
 	}
 	is_corrupted = libewf_handle_segment_files_corrupted(
 	                verification_handle->input_handle,
@@ -2430,37 +4781,8 @@ int verification_handle_verify_input(
 
 		return( -1 );
 	}
-	if( ( verification_handle->calculate_md5 != 0 )
-	 && ( verification_handle->stored_md5_hash_available != 0 ) )
-	{
-		md5_hash_compare = system_string_compare(
-		                    verification_handle->stored_md5_hash_string,
-		                    verification_handle->calculated_md5_hash_string,
-		                    33 );
-	}
-	if( ( verification_handle->calculate_sha1 != 0 )
-	 && ( verification_handle->stored_sha1_hash_available != 0 ) )
-	{
-		sha1_hash_compare = system_string_compare(
-		                     verification_handle->stored_sha1_hash_string,
-		                     verification_handle->calculated_sha1_hash_string,
-		                     41 );
-	}
-	if( ( verification_handle->calculate_sha256 != 0 )
-	 && ( verification_handle->stored_sha256_hash_available != 0 ) )
-	{
-		sha256_hash_compare = system_string_compare(
-		                       verification_handle->stored_sha256_hash_string,
-		                       verification_handle->calculated_sha256_hash_string,
-		                       65 );
-	}
-	/* Note that a set of EWF files can be verified without an integrity hash
-	 */
 	if( ( is_corrupted == 0 )
-	 && ( number_of_checksum_errors == 0 )
-	 && ( md5_hash_compare == 0 )
-	 && ( sha1_hash_compare == 0 )
-	 && ( sha256_hash_compare == 0 ) )
+	 && ( number_of_checksum_errors == 0 ) )
 	{
 		return( 1 );
 	}
@@ -2478,7 +4800,7 @@ on_error:
 	{
 		process_status_stop(
 		 verification_handle->process_status,
-		 verification_handle->last_offset_hashed,
+		 (size64_t) storage_media_offset,
 		 PROCESS_STATUS_FAILED,
 		 NULL );
 		process_status_free(
@@ -2492,22 +4814,6 @@ on_error:
 		 &( verification_handle->process_thread_pool ),
 		 NULL );
 	}
-	if( verification_handle->output_thread_pool != NULL )
-	{
-		libcthreads_thread_pool_join(
-		 &( verification_handle->output_thread_pool ),
-		 NULL );
-	}
-	if( verification_handle->output_list != NULL )
-	{
-		verification_handle_empty_output_list(
-		 verification_handle,
-		 NULL );
-		libcdata_list_free(
-		 &( verification_handle->output_list ),
-		 NULL,
-		 NULL );
-	}
 	if( verification_handle->storage_media_buffer_queue != NULL )
 	{
 		storage_media_buffer_queue_free(
@@ -3780,6 +6086,64 @@ int verification_handle_set_number_of_threads(
 	return( result );
 }
 
+/* Sets the number of reader threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_handle_set_number_of_reader_threads(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function             = "verification_handle_set_number_of_reader_threads";
+	size_t string_length              = 0;
+	uint64_t number_of_reader_threads = 0;
+	int result                        = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_reader_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of reader threads.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_reader_threads > VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_READER_THREADS )
+		{
+			result = 0;
+		}
+		else
+		{
+			verification_handle->number_of_reader_threads = (int) number_of_reader_threads;
+		}
+	}
+	return( result );
+}
+
 /* Sets the digest (hash) types
  * Returns 1 if successful or -1 on error
  */
@@ -25,7 +25,9 @@
 #include <common.h>
 #include <types.h>
 
+#include "chunk_hash_tree.h"
 #include "digest_hash.h"
+#include "digest_threads.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -33,7 +35,9 @@
 #include "ewftools_libhmac.h"
 #include "log_handle.h"
 #include "process_status.h"
+#include "reorder_ring.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -137,6 +141,10 @@ struct verification_handle
 	 */
 	uint8_t use_data_chunk_functions;
 
+	/* Value to indicate if the segment files should be read using direct (unbuffered) IO
+	 */
+	uint8_t use_direct_io;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -145,8 +153,24 @@ struct verification_handle
 	 */
 	int number_of_threads;
 
+	/* The number of threads in the read thread pool
+	 */
+	int number_of_reader_threads;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
+	/* The read thread pool
+	 */
+	libcthreads_thread_pool_t *read_thread_pool;
+
+	/* The reader handles
+	 */
+	libewf_handle_t **reader_handles;
+
+	/* The reader handle queue
+	 */
+	libcthreads_queue_t *reader_handle_queue;
+
 	/* The process thread pool
 	 */
 	libcthreads_thread_pool_t *process_thread_pool;
@@ -155,13 +179,17 @@ struct verification_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The output reorder ring
 	 */
-	libcdata_list_t *output_list;
+	reorder_ring_t *output_reorder_ring;
 
 	/* The storage media buffer queue
 	 */
-	libcthreads_queue_t *storage_media_buffer_queue;
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The digest threads
+	 */
+	digest_threads_t *digest_threads;
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
@@ -185,6 +213,23 @@ struct verification_handle
 	 */
 	off64_t last_offset_hashed;
 
+	/* The chunk hash tree
+	 */
+	chunk_hash_tree_t *chunk_hash_tree;
+
+	/* The index of the first chunk hash tree leaf that is verified
+	 */
+	uint64_t first_leaf_index;
+
+	/* The number of chunk hash tree leaves that are verified
+	 */
+	uint64_t number_of_leaves;
+
+	/* The chunk hash tree leaf results, contains 1 for every leaf
+	 * that was verified and matched and 0 otherwise
+	 */
+	uint8_t *leaf_results;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -247,6 +292,18 @@ int verification_handle_finalize_integrity_hash(
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
+int verification_handle_initialize_reader_handles(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+int verification_handle_free_reader_handles(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+int verification_handle_read_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle );
+
 int verification_handle_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      verification_handle_t *verification_handle );
@@ -255,10 +312,19 @@ int verification_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      verification_handle_t *verification_handle );
 
-int verification_handle_empty_output_list(
+int verification_handle_empty_output_reorder_ring(
      verification_handle_t *verification_handle,
      libcerror_error_t **error );
 
+int verification_handle_initialize_digest_threads(
+     verification_handle_t *verification_handle,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error );
+
+int verification_handle_digested_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle );
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 int verification_handle_verify_input(
@@ -267,6 +333,52 @@ int verification_handle_verify_input(
      log_handle_t *log_handle,
      libcerror_error_t **error );
 
+int verification_handle_verify_chunk_hash_tree_leaf(
+     verification_handle_t *verification_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int verification_handle_verify_chunk_hash_tree_leaf_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int verification_handle_verify_chunk_hash_tree(
+     verification_handle_t *verification_handle,
+     const system_character_t *filename,
+     off64_t range_offset,
+     size64_t range_size,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+int verification_handle_chunk_hash_tree_mismatches_fprint(
+     verification_handle_t *verification_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
+int verification_handle_verify_chunks(
+     verification_handle_t *verification_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int verification_handle_verify_chunks_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int verification_handle_verify_chunk_checksums(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
 int verification_handle_verify_single_files(
      verification_handle_t *verification_handle,
      uint8_t print_status_information,
@@ -318,6 +430,11 @@ int verification_handle_set_number_of_threads(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int verification_handle_set_number_of_reader_threads(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int verification_handle_set_digest_types(
      verification_handle_t *verification_handle,
      const system_character_t *string,
@@ -0,0 +1,271 @@
+/*
+ * Index file of the EWF chunk tables
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWF_INDEX_H )
+#define _EWF_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The index file header
+ */
+typedef struct ewf_index_file_header ewf_index_file_header_t;
+
+struct ewf_index_file_header
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * "EWFINDEX"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The chunk size
+	 * Consists of 4 bytes
+	 */
+	uint8_t chunk_size[ 4 ];
+
+	/* The number of segments
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_segments[ 4 ];
+
+	/* The checksum of the segments data
+	 * Consists of 4 bytes
+	 */
+	uint8_t segments_data_checksum[ 4 ];
+
+	/* The segments data offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t segments_data_offset[ 8 ];
+
+	/* The segments data size
+	 * Consists of 8 bytes
+	 */
+	uint8_t segments_data_size[ 8 ];
+
+	/* Padding
+	 * Consists of 16 bytes
+	 */
+	uint8_t padding[ 16 ];
+
+	/* The checksum of all (previous) header data
+	 * Consists of 4 bytes
+	 */
+	uint8_t checksum[ 4 ];
+};
+
+/* The index file segment
+ * Followed by the section offsets and the chunk groups
+ */
+typedef struct ewf_index_segment ewf_index_segment_t;
+
+struct ewf_index_segment
+{
+	/* The segment file size
+	 * Consists of 8 bytes
+	 */
+	uint8_t segment_file_size[ 8 ];
+
+	/* The segment number
+	 * Consists of 4 bytes
+	 */
+	uint8_t segment_number[ 4 ];
+
+	/* The checksum of the last section descriptor data
+	 * Consists of 4 bytes
+	 */
+	uint8_t last_section_checksum[ 4 ];
+
+	/* The last section offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_section_offset[ 8 ];
+
+	/* The segment file type
+	 * Consists of 1 byte
+	 */
+	uint8_t type;
+
+	/* The major version
+	 * Consists of 1 byte
+	 */
+	uint8_t major_version;
+
+	/* The minor version
+	 * Consists of 1 byte
+	 */
+	uint8_t minor_version;
+
+	/* The segment file flags
+	 * Consists of 1 byte
+	 */
+	uint8_t flags;
+
+	/* The compression method
+	 * Consists of 2 bytes
+	 */
+	uint8_t compression_method[ 2 ];
+
+	/* Padding
+	 * Consists of 2 bytes
+	 */
+	uint8_t padding1[ 2 ];
+
+	/* The set identifier
+	 * Consists of 16 bytes
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The device information section index
+	 * Consists of 4 bytes
+	 * Contains -1 if not set
+	 */
+	uint8_t device_information_section_index[ 4 ];
+
+	/* The number of sections
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_sections[ 4 ];
+
+	/* The number of chunk groups
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_chunk_groups[ 4 ];
+
+	/* Padding
+	 * Consists of 4 bytes
+	 */
+	uint8_t padding2[ 4 ];
+
+	/* The storage media size
+	 * Consists of 8 bytes
+	 */
+	uint8_t storage_media_size[ 8 ];
+
+	/* The number of chunks
+	 * Consists of 8 bytes
+	 */
+	uint8_t number_of_chunks[ 8 ];
+
+	/* The last chunk that was filled
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_chunk_filled[ 8 ];
+};
+
+/* The index file section
+ */
+typedef struct ewf_index_section ewf_index_section_t;
+
+struct ewf_index_section
+{
+	/* The section descriptor offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t offset[ 8 ];
+};
+
+/* The index file chunk group
+ */
+typedef struct ewf_index_chunk_group ewf_index_chunk_group_t;
+
+struct ewf_index_chunk_group
+{
+	/* The chunk group data offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t data_offset[ 8 ];
+
+	/* The chunk group data size
+	 * Consists of 8 bytes
+	 */
+	uint8_t data_size[ 8 ];
+
+	/* The chunk group mapped size
+	 * Consists of 8 bytes
+	 */
+	uint8_t mapped_size[ 8 ];
+
+	/* The chunk group range flags
+	 * Consists of 4 bytes
+	 */
+	uint8_t range_flags[ 4 ];
+
+	/* The number of chunks
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_chunks[ 4 ];
+
+	/* The offset of the chunks in the index file
+	 * Consists of 8 bytes
+	 * Contains 0 if the chunks are not stored
+	 */
+	uint8_t chunks_offset[ 8 ];
+
+	/* The checksum of the chunks data
+	 * Consists of 4 bytes
+	 */
+	uint8_t chunks_checksum[ 4 ];
+
+	/* Padding
+	 * Consists of 4 bytes
+	 */
+	uint8_t padding[ 4 ];
+};
+
+/* The index file chunk
+ */
+typedef struct ewf_index_chunk ewf_index_chunk_t;
+
+struct ewf_index_chunk
+{
+	/* The chunk data offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t chunk_data_offset[ 8 ];
+
+	/* The chunk data size
+	 * Consists of 4 bytes
+	 */
+	uint8_t chunk_data_size[ 4 ];
+
+	/* The chunk data range flags
+	 * Consists of 4 bytes
+	 */
+	uint8_t range_flags[ 4 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EWF_INDEX_H ) */
+
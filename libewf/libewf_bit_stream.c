@@ -20,14 +20,13 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <memory.h>
 #include <types.h>
 
 #include "libewf_bit_stream.h"
 #include "libewf_libcerror.h"
 
-/* TODO use memory alignment in bit stream */
-
 /* Creates a bit stream
  * Make sure the value bit_stream is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -185,6 +184,81 @@ int libewf_bit_stream_free(
 	return( 1 );
 }
 
+/* Fills the bit buffer with as many whole bytes from the byte stream as fit
+ * The bit buffer can contain less bits than requested at the end of the byte stream
+ * Returns 1 on success or -1 on error
+ */
+int libewf_bit_stream_fill_bit_buffer(
+     libewf_bit_stream_t *bit_stream,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_bit_stream_fill_bit_buffer";
+	uint64_t value_64bit   = 0;
+	uint8_t number_of_bits = 0;
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( bit_stream->bit_buffer_size == 0 )
+	{
+		bit_stream->bit_buffer = 0;
+	}
+	if( ( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+	 && ( bit_stream->bit_buffer_size <= 56 )
+	 && ( ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) >= 8 ) )
+	{
+		/* Read 8 bytes at once and keep the whole bytes that fit in the bit buffer
+		 */
+		byte_stream_copy_to_uint64_little_endian(
+		 &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
+		 value_64bit );
+
+		number_of_bits = ( 64 - bit_stream->bit_buffer_size ) & 0xf8;
+
+		bit_stream->bit_buffer |= value_64bit << bit_stream->bit_buffer_size;
+
+		bit_stream->bit_buffer_size    += number_of_bits;
+		bit_stream->byte_stream_offset += number_of_bits / 8;
+
+		if( bit_stream->bit_buffer_size < 64 )
+		{
+			bit_stream->bit_buffer &= ( (uint64_t) 1 << bit_stream->bit_buffer_size ) - 1;
+		}
+	}
+	else if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+	{
+		while( ( bit_stream->bit_buffer_size <= 56 )
+		    && ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size ) )
+		{
+			bit_stream->bit_buffer |= (uint64_t) bit_stream->byte_stream[ bit_stream->byte_stream_offset ] << bit_stream->bit_buffer_size;
+
+			bit_stream->bit_buffer_size    += 8;
+			bit_stream->byte_stream_offset += 1;
+		}
+	}
+	else if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
+	{
+		while( ( bit_stream->bit_buffer_size <= 56 )
+		    && ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size ) )
+		{
+			bit_stream->bit_buffer <<= 8;
+			bit_stream->bit_buffer  |= bit_stream->byte_stream[ bit_stream->byte_stream_offset ];
+
+			bit_stream->bit_buffer_size    += 8;
+			bit_stream->byte_stream_offset += 1;
+		}
+	}
+	return( 1 );
+}
+
 /* Retrieves a value from the bit stream
  * Returns 1 on success or -1 on error
  */
@@ -194,11 +268,9 @@ int libewf_bit_stream_get_value(
      uint32_t *value_32bit,
      libcerror_error_t **error )
 {
-	static char *function            = "libewf_bit_stream_get_value";
-	uint32_t read_value_32bit        = 0;
-	uint32_t safe_value_32bit        = 0;
-	uint8_t read_number_of_bits      = 0;
-	uint8_t remaining_number_of_bits = 0;
+	static char *function     = "libewf_bit_stream_get_value";
+	uint64_t value_mask       = 0;
+	uint32_t safe_value_32bit = 0;
 
 	if( bit_stream == NULL )
 	{
@@ -233,78 +305,57 @@ int libewf_bit_stream_get_value(
 
 		return( -1 );
 	}
-	remaining_number_of_bits = number_of_bits;
-
-	while( remaining_number_of_bits > 0 )
+	if( bit_stream->bit_buffer_size == 0 )
 	{
-		while( ( remaining_number_of_bits > bit_stream->bit_buffer_size )
-		    && ( bit_stream->bit_buffer_size <= 24 ) )
-		{
-			if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid byte stream offset value out of bounds.",
-				 function );
-
-				return( -1 );
-			}
-			if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
-			{
-				bit_stream->bit_buffer |= (uint32_t) bit_stream->byte_stream[ bit_stream->byte_stream_offset ] << bit_stream->bit_buffer_size;
-			}
-			else if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
-			{
-				bit_stream->bit_buffer <<= 8;
-				bit_stream->bit_buffer  |= bit_stream->byte_stream[ bit_stream->byte_stream_offset ];
-			}
-			bit_stream->bit_buffer_size    += 8;
-			bit_stream->byte_stream_offset += 1;
-		}
-		if( remaining_number_of_bits < bit_stream->bit_buffer_size )
-		{
-			read_number_of_bits = remaining_number_of_bits;
-		}
-		else
-		{
-			read_number_of_bits = bit_stream->bit_buffer_size;
-		}
-		read_value_32bit = bit_stream->bit_buffer;
-
-		if( remaining_number_of_bits < number_of_bits )
+		bit_stream->bit_buffer = 0;
+	}
+	/* The bit buffer is 64-bit hence it can hold the requested bits
+	 * and the remaining bits of a previously read byte
+	 */
+	while( bit_stream->bit_buffer_size < number_of_bits )
+	{
+		if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
 		{
-			safe_value_32bit <<= remaining_number_of_bits;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid byte stream offset value out of bounds.",
+			 function );
+
+			return( -1 );
 		}
 		if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
 		{
-			if( read_number_of_bits < 32 )
-			{
-				/* On VS 2008 32-bit "~( 0xfffffffUL << 32 )" does not behave as expected
-				 */
-				read_value_32bit &= ~( 0xffffffffUL << read_number_of_bits );
-
-				bit_stream->bit_buffer >>= read_number_of_bits;
-			}
-			bit_stream->bit_buffer_size -= read_number_of_bits;
+			bit_stream->bit_buffer |= (uint64_t) bit_stream->byte_stream[ bit_stream->byte_stream_offset ] << bit_stream->bit_buffer_size;
 		}
 		else if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
 		{
-			bit_stream->bit_buffer_size -= read_number_of_bits;
-			read_value_32bit           >>= bit_stream->bit_buffer_size;
-
-			if( bit_stream->bit_buffer_size > 0 )
-			{
-				bit_stream->bit_buffer &= 0xffffffffUL >> ( 32 - bit_stream->bit_buffer_size );
-			}
+			bit_stream->bit_buffer <<= 8;
+			bit_stream->bit_buffer  |= bit_stream->byte_stream[ bit_stream->byte_stream_offset ];
 		}
-		if( bit_stream->bit_buffer_size == 0 )
+		bit_stream->bit_buffer_size    += 8;
+		bit_stream->byte_stream_offset += 1;
+	}
+	value_mask = ( (uint64_t) 1 << number_of_bits ) - 1;
+
+	if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+	{
+		safe_value_32bit = (uint32_t) ( bit_stream->bit_buffer & value_mask );
+
+		bit_stream->bit_buffer     >>= number_of_bits;
+		bit_stream->bit_buffer_size -= number_of_bits;
+	}
+	else if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
+	{
+		bit_stream->bit_buffer_size -= number_of_bits;
+
+		safe_value_32bit = (uint32_t) ( ( bit_stream->bit_buffer >> bit_stream->bit_buffer_size ) & value_mask );
+
+		if( bit_stream->bit_buffer_size < 64 )
 		{
-			bit_stream->bit_buffer = 0;
+			bit_stream->bit_buffer &= ( (uint64_t) 1 << bit_stream->bit_buffer_size ) - 1;
 		}
-		safe_value_32bit         |= read_value_32bit;
-		remaining_number_of_bits -= read_number_of_bits;
 	}
 	*value_32bit = safe_value_32bit;
 
@@ -28,13 +28,360 @@
 #endif
 
 #include "libewf_checksum.h"
+#include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 #include "libewf_types.h"
 
-#if defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD )
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+
+#elif defined( HAVE_LIBEWF_CHECKSUM_NEON )
+#include <arm_neon.h>
+
+#endif
+
+/* The SIMD Adler-32 functions process the data in blocks of 32 bytes
+ * The modulo calculation is needed per 5552 bytes, which is 173 blocks
+ */
+#define LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE		32
+#define LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS	173
+
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD )
+
+/* Determines the SIMD instruction set supported by the CPU
+ * Returns a LIBEWF_CHECKSUM_SIMD_TYPE value
+ */
+int libewf_checksum_get_simd_type(
+     void )
+{
+#if defined( _MSC_VER )
+	static int simd_type = -1;
+	int cpu_information[ 4 ];
+	int safe_simd_type   = LIBEWF_CHECKSUM_SIMD_TYPE_NONE;
+
+	if( simd_type != -1 )
+	{
+		return( simd_type );
+	}
+	__cpuid(
+	 cpu_information,
+	 0 );
+
+	if( cpu_information[ 0 ] >= 1 )
+	{
+		__cpuid(
+		 cpu_information,
+		 1 );
+
+		/* ECX bit 9 indicates SSSE3 support
+		 */
+		if( ( cpu_information[ 2 ] & 0x00000200L ) != 0 )
+		{
+			safe_simd_type = LIBEWF_CHECKSUM_SIMD_TYPE_SSSE3;
+		}
+		/* ECX bit 27 indicates OSXSAVE and bit 28 AVX support
+		 * XCR0 bits 1 and 2 indicate the OS saves the XMM and YMM registers
+		 */
+		if( ( ( cpu_information[ 2 ] & 0x18000000L ) == 0x18000000L )
+		 && ( ( _xgetbv( 0 ) & 0x06 ) == 0x06 ) )
+		{
+			__cpuid(
+			 cpu_information,
+			 0 );
+
+			if( cpu_information[ 0 ] >= 7 )
+			{
+				__cpuidex(
+				 cpu_information,
+				 7,
+				 0 );
+
+				/* EBX bit 5 indicates AVX2 support
+				 */
+				if( ( cpu_information[ 1 ] & 0x00000020L ) != 0 )
+				{
+					safe_simd_type = LIBEWF_CHECKSUM_SIMD_TYPE_AVX2;
+				}
+			}
+		}
+	}
+	/* Concurrent callers determine the same value
+	 */
+	simd_type = safe_simd_type;
+
+	return( simd_type );
+#else
+	if( __builtin_cpu_supports( "avx2" ) )
+	{
+		return( LIBEWF_CHECKSUM_SIMD_TYPE_AVX2 );
+	}
+	if( __builtin_cpu_supports( "ssse3" ) )
+	{
+		return( LIBEWF_CHECKSUM_SIMD_TYPE_SSSE3 );
+	}
+	return( LIBEWF_CHECKSUM_SIMD_TYPE_NONE );
+#endif
+}
+
+/* Calculates the Adler-32 of blocks of 32 bytes using SSSE3
+ * It uses the initial value to calculate a new Adler-32
+ * Returns the Adler-32
+ */
+LIBEWF_CHECKSUM_TARGET_SSSE3
+uint32_t libewf_checksum_calculate_adler32_ssse3(
+          const uint8_t *buffer,
+          size_t number_of_blocks,
+          uint32_t initial_value )
+{
+	__m128i bytes_vector          = _mm_setzero_si128();
+	__m128i lower_word_vector     = _mm_setzero_si128();
+	__m128i previous_words_vector = _mm_setzero_si128();
+	__m128i upper_word_vector     = _mm_setzero_si128();
+	size_t block_index            = 0;
+	uint32_t lower_word           = 0;
+	uint32_t upper_word           = 0;
+
+	const __m128i first_factors  = _mm_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17 );
+	const __m128i second_factors = _mm_setr_epi8( 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	const __m128i ones           = _mm_set1_epi16( 1 );
+	const __m128i zeros          = _mm_setzero_si128();
+
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( number_of_blocks > 0 )
+	{
+		block_index = number_of_blocks;
+
+		if( block_index > LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS )
+		{
+			block_index = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS;
+		}
+		number_of_blocks -= block_index;
+
+		/* The lower word before each block is added 32 times to the upper word
+		 * hence previous_words_vector is multiplied by 32 afterwards
+		 */
+		previous_words_vector = _mm_set_epi32( 0, 0, 0, (int) ( lower_word * block_index ) );
+		upper_word_vector     = _mm_set_epi32( 0, 0, 0, (int) upper_word );
+		lower_word_vector     = _mm_setzero_si128();
+
+		while( block_index > 0 )
+		{
+			previous_words_vector = _mm_add_epi32( previous_words_vector, lower_word_vector );
+
+			bytes_vector      = _mm_loadu_si128( (const __m128i *) buffer );
+			lower_word_vector = _mm_add_epi32( lower_word_vector, _mm_sad_epu8( bytes_vector, zeros ) );
+			upper_word_vector = _mm_add_epi32( upper_word_vector, _mm_madd_epi16( _mm_maddubs_epi16( bytes_vector, first_factors ), ones ) );
+
+			bytes_vector      = _mm_loadu_si128( (const __m128i *) &( buffer[ 16 ] ) );
+			lower_word_vector = _mm_add_epi32( lower_word_vector, _mm_sad_epu8( bytes_vector, zeros ) );
+			upper_word_vector = _mm_add_epi32( upper_word_vector, _mm_madd_epi16( _mm_maddubs_epi16( bytes_vector, second_factors ), ones ) );
+
+			buffer      += LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE;
+			block_index -= 1;
+		}
+		upper_word_vector = _mm_add_epi32( upper_word_vector, _mm_slli_epi32( previous_words_vector, 5 ) );
+
+		lower_word_vector = _mm_add_epi32( lower_word_vector, _mm_shuffle_epi32( lower_word_vector, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		lower_word       += (uint32_t) _mm_cvtsi128_si32( lower_word_vector );
+
+		upper_word_vector = _mm_add_epi32( upper_word_vector, _mm_shuffle_epi32( upper_word_vector, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		upper_word_vector = _mm_add_epi32( upper_word_vector, _mm_shuffle_epi32( upper_word_vector, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		upper_word        = (uint32_t) _mm_cvtsi128_si32( upper_word_vector );
+
+		lower_word %= 65521;
+		upper_word %= 65521;
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+/* Calculates the Adler-32 of blocks of 32 bytes using AVX2
+ * It uses the initial value to calculate a new Adler-32
+ * Returns the Adler-32
+ */
+LIBEWF_CHECKSUM_TARGET_AVX2
+uint32_t libewf_checksum_calculate_adler32_avx2(
+          const uint8_t *buffer,
+          size_t number_of_blocks,
+          uint32_t initial_value )
+{
+	__m256i bytes_vector          = _mm256_setzero_si256();
+	__m256i lower_word_vector     = _mm256_setzero_si256();
+	__m256i previous_words_vector = _mm256_setzero_si256();
+	__m256i upper_word_vector     = _mm256_setzero_si256();
+	__m128i sum_vector            = _mm_setzero_si128();
+	size_t block_index            = 0;
+	uint32_t lower_word           = 0;
+	uint32_t upper_word           = 0;
+
+	const __m256i factors = _mm256_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	const __m256i ones    = _mm256_set1_epi16( 1 );
+	const __m256i zeros   = _mm256_setzero_si256();
+
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( number_of_blocks > 0 )
+	{
+		block_index = number_of_blocks;
+
+		if( block_index > LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS )
+		{
+			block_index = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS;
+		}
+		number_of_blocks -= block_index;
+
+		previous_words_vector = _mm256_setr_epi32( (int) ( lower_word * block_index ), 0, 0, 0, 0, 0, 0, 0 );
+		upper_word_vector     = _mm256_setr_epi32( (int) upper_word, 0, 0, 0, 0, 0, 0, 0 );
+		lower_word_vector     = _mm256_setzero_si256();
+
+		while( block_index > 0 )
+		{
+			previous_words_vector = _mm256_add_epi32( previous_words_vector, lower_word_vector );
+
+			bytes_vector      = _mm256_loadu_si256( (const __m256i *) buffer );
+			lower_word_vector = _mm256_add_epi32( lower_word_vector, _mm256_sad_epu8( bytes_vector, zeros ) );
+			upper_word_vector = _mm256_add_epi32( upper_word_vector, _mm256_madd_epi16( _mm256_maddubs_epi16( bytes_vector, factors ), ones ) );
+
+			buffer      += LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE;
+			block_index -= 1;
+		}
+		upper_word_vector = _mm256_add_epi32( upper_word_vector, _mm256_slli_epi32( previous_words_vector, 5 ) );
+
+		sum_vector  = _mm_add_epi32( _mm256_castsi256_si128( lower_word_vector ), _mm256_extracti128_si256( lower_word_vector, 1 ) );
+		sum_vector  = _mm_add_epi32( sum_vector, _mm_shuffle_epi32( sum_vector, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		lower_word += (uint32_t) _mm_cvtsi128_si32( sum_vector );
+
+		sum_vector = _mm_add_epi32( _mm256_castsi256_si128( upper_word_vector ), _mm256_extracti128_si256( upper_word_vector, 1 ) );
+		sum_vector = _mm_add_epi32( sum_vector, _mm_shuffle_epi32( sum_vector, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		sum_vector = _mm_add_epi32( sum_vector, _mm_shuffle_epi32( sum_vector, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		upper_word = (uint32_t) _mm_cvtsi128_si32( sum_vector );
+
+		lower_word %= 65521;
+		upper_word %= 65521;
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+#elif defined( HAVE_LIBEWF_CHECKSUM_NEON )
+
+/* Determines the SIMD instruction set supported by the CPU
+ * Returns a LIBEWF_CHECKSUM_SIMD_TYPE value
+ */
+int libewf_checksum_get_simd_type(
+     void )
+{
+	return( LIBEWF_CHECKSUM_SIMD_TYPE_NEON );
+}
+
+/* Calculates the Adler-32 of blocks of 32 bytes using NEON
+ * It uses the initial value to calculate a new Adler-32
+ * Returns the Adler-32
+ */
+uint32_t libewf_checksum_calculate_adler32_neon(
+          const uint8_t *buffer,
+          size_t number_of_blocks,
+          uint32_t initial_value )
+{
+	static const uint16_t factors[ 32 ] = {
+		32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+		16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+
+	uint8x16_t first_bytes_vector  = vdupq_n_u8( 0 );
+	uint8x16_t second_bytes_vector = vdupq_n_u8( 0 );
+	uint16x8_t column_sums_vector1 = vdupq_n_u16( 0 );
+	uint16x8_t column_sums_vector2 = vdupq_n_u16( 0 );
+	uint16x8_t column_sums_vector3 = vdupq_n_u16( 0 );
+	uint16x8_t column_sums_vector4 = vdupq_n_u16( 0 );
+	uint32x4_t lower_word_vector   = vdupq_n_u32( 0 );
+	uint32x4_t upper_word_vector   = vdupq_n_u32( 0 );
+	uint32x2_t sum_vector          = vdup_n_u32( 0 );
+	size_t block_index             = 0;
+	uint32_t lower_word            = 0;
+	uint32_t upper_word            = 0;
+
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( number_of_blocks > 0 )
+	{
+		block_index = number_of_blocks;
+
+		if( block_index > LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS )
+		{
+			block_index = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS;
+		}
+		number_of_blocks -= block_index;
+
+		/* The upper word vector contains the sum of the lower word before each block
+		 * and is multiplied by 32 afterwards
+		 */
+		upper_word_vector   = vsetq_lane_u32( lower_word * (uint32_t) block_index, vdupq_n_u32( 0 ), 0 );
+		lower_word_vector   = vdupq_n_u32( 0 );
+		column_sums_vector1 = vdupq_n_u16( 0 );
+		column_sums_vector2 = vdupq_n_u16( 0 );
+		column_sums_vector3 = vdupq_n_u16( 0 );
+		column_sums_vector4 = vdupq_n_u16( 0 );
+
+		while( block_index > 0 )
+		{
+			first_bytes_vector  = vld1q_u8( buffer );
+			second_bytes_vector = vld1q_u8( &( buffer[ 16 ] ) );
+
+			upper_word_vector = vaddq_u32( upper_word_vector, lower_word_vector );
+			lower_word_vector = vpadalq_u16( lower_word_vector, vpadalq_u8( vpaddlq_u8( first_bytes_vector ), second_bytes_vector ) );
+
+			column_sums_vector1 = vaddw_u8( column_sums_vector1, vget_low_u8( first_bytes_vector ) );
+			column_sums_vector2 = vaddw_u8( column_sums_vector2, vget_high_u8( first_bytes_vector ) );
+			column_sums_vector3 = vaddw_u8( column_sums_vector3, vget_low_u8( second_bytes_vector ) );
+			column_sums_vector4 = vaddw_u8( column_sums_vector4, vget_high_u8( second_bytes_vector ) );
+
+			buffer      += LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE;
+			block_index -= 1;
+		}
+		upper_word_vector = vshlq_n_u32( upper_word_vector, 5 );
+
+		upper_word_vector = vmlal_u16( upper_word_vector, vget_low_u16( column_sums_vector1 ), vld1_u16( &( factors[ 0 ] ) ) );
+		upper_word_vector = vmlal_u16( upper_word_vector, vget_high_u16( column_sums_vector1 ), vld1_u16( &( factors[ 4 ] ) ) );
+		upper_word_vector = vmlal_u16( upper_word_vector, vget_low_u16( column_sums_vector2 ), vld1_u16( &( factors[ 8 ] ) ) );
+		upper_word_vector = vmlal_u16( upper_word_vector, vget_high_u16( column_sums_vector2 ), vld1_u16( &( factors[ 12 ] ) ) );
+		upper_word_vector = vmlal_u16( upper_word_vector, vget_low_u16( column_sums_vector3 ), vld1_u16( &( factors[ 16 ] ) ) );
+		upper_word_vector = vmlal_u16( upper_word_vector, vget_high_u16( column_sums_vector3 ), vld1_u16( &( factors[ 20 ] ) ) );
+		upper_word_vector = vmlal_u16( upper_word_vector, vget_low_u16( column_sums_vector4 ), vld1_u16( &( factors[ 24 ] ) ) );
+		upper_word_vector = vmlal_u16( upper_word_vector, vget_high_u16( column_sums_vector4 ), vld1_u16( &( factors[ 28 ] ) ) );
+
+		sum_vector  = vpadd_u32( vget_low_u32( lower_word_vector ), vget_high_u32( lower_word_vector ) );
+		lower_word += vget_lane_u32( vpadd_u32( sum_vector, sum_vector ), 0 );
+
+		sum_vector  = vpadd_u32( vget_low_u32( upper_word_vector ), vget_high_u32( upper_word_vector ) );
+		upper_word += vget_lane_u32( vpadd_u32( sum_vector, sum_vector ), 0 );
+
+		lower_word %= 65521;
+		upper_word %= 65521;
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+#else
+
+/* Determines the SIMD instruction set supported by the CPU
+ * Returns a LIBEWF_CHECKSUM_SIMD_TYPE value
+ */
+int libewf_checksum_get_simd_type(
+     void )
+{
+	return( LIBEWF_CHECKSUM_SIMD_TYPE_NONE );
+}
+
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD ) */
 
 /* Calculates the little-endian Adler-32 of a buffer
  * It uses the initial value to calculate a new Adler-32
+ * The SIMD instruction set supported by the CPU is used if available
  * Returns 1 if successful or -1 on error
  */
 int libewf_checksum_calculate_adler32(
@@ -44,7 +391,9 @@ int libewf_checksum_calculate_adler32(
      uint32_t initial_value,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_checksum_calculate_adler32";
+	static char *function   = "libewf_checksum_calculate_adler32";
+	size_t number_of_blocks = 0;
+	uint32_t safe_checksum  = 0;
 
 	if( checksum_value == NULL )
 	{
@@ -68,8 +417,7 @@ int libewf_checksum_calculate_adler32(
 
 		return( -1 );
 	}
-	if( ( size > (size_t) UINT_MAX )
-	 || ( size > (size_t) SSIZE_MAX ) )
+	if( size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
@@ -80,13 +428,83 @@ int libewf_checksum_calculate_adler32(
 
 		return( -1 );
 	}
-	*checksum_value = adler32(
-	                   (uLong) initial_value,
-	                   (const Bytef *) buffer,
-	                   (uInt) size );
+	safe_checksum    = initial_value;
+	number_of_blocks = size / LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE;
 
-	return( 1 );
-}
+	if( number_of_blocks > 0 )
+	{
+		switch( libewf_checksum_get_simd_type() )
+		{
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD )
+			case LIBEWF_CHECKSUM_SIMD_TYPE_AVX2:
+				safe_checksum = libewf_checksum_calculate_adler32_avx2(
+				                 buffer,
+				                 number_of_blocks,
+				                 safe_checksum );
+				break;
+
+			case LIBEWF_CHECKSUM_SIMD_TYPE_SSSE3:
+				safe_checksum = libewf_checksum_calculate_adler32_ssse3(
+				                 buffer,
+				                 number_of_blocks,
+				                 safe_checksum );
+				break;
 
+#elif defined( HAVE_LIBEWF_CHECKSUM_NEON )
+			case LIBEWF_CHECKSUM_SIMD_TYPE_NEON:
+				safe_checksum = libewf_checksum_calculate_adler32_neon(
+				                 buffer,
+				                 number_of_blocks,
+				                 safe_checksum );
+				break;
+
+#endif
+			default:
+				number_of_blocks = 0;
+				break;
+		}
+		buffer += number_of_blocks * LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE;
+		size   -= number_of_blocks * LIBEWF_CHECKSUM_ADLER32_BLOCK_SIZE;
+	}
+	if( size > 0 )
+	{
+#if defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+		if( size > (size_t) UINT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		safe_checksum = (uint32_t) adler32(
+		                            (uLong) safe_checksum,
+		                            (const Bytef *) buffer,
+		                            (uInt) size );
+#else
+		if( libewf_deflate_calculate_adler32(
+		     &safe_checksum,
+		     buffer,
+		     size,
+		     safe_checksum,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate checksum.",
+			 function );
+
+			return( -1 );
+		}
 #endif /* defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
+	}
+	*checksum_value = safe_checksum;
+
+	return( 1 );
+}
 
@@ -25,14 +25,54 @@
 #include <common.h>
 #include <types.h>
 
-#include "libewf_deflate.h"
+#include "libewf_definitions.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
-#if defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+/* The SIMD Adler-32 functions require GCC 4.9 or later, Clang or Visual Studio 2012 or later
+ * on x86 or a compiler that targets NEON on ARM
+ */
+#if ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 9 ) ) ) ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define HAVE_LIBEWF_CHECKSUM_X86_SIMD	1
+#define LIBEWF_CHECKSUM_TARGET_SSSE3	__attribute__( ( target( "ssse3" ) ) )
+#define LIBEWF_CHECKSUM_TARGET_AVX2	__attribute__( ( target( "avx2" ) ) )
+
+#elif defined( _MSC_VER ) && ( _MSC_VER >= 1700 ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#define HAVE_LIBEWF_CHECKSUM_X86_SIMD	1
+#define LIBEWF_CHECKSUM_TARGET_SSSE3
+#define LIBEWF_CHECKSUM_TARGET_AVX2
+
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ ) || defined( _M_ARM64 )
+#define HAVE_LIBEWF_CHECKSUM_NEON	1
+
+#endif
+
+int libewf_checksum_get_simd_type(
+     void );
+
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD )
+
+uint32_t libewf_checksum_calculate_adler32_ssse3(
+          const uint8_t *buffer,
+          size_t number_of_blocks,
+          uint32_t initial_value );
+
+uint32_t libewf_checksum_calculate_adler32_avx2(
+          const uint8_t *buffer,
+          size_t number_of_blocks,
+          uint32_t initial_value );
+
+#elif defined( HAVE_LIBEWF_CHECKSUM_NEON )
+
+uint32_t libewf_checksum_calculate_adler32_neon(
+          const uint8_t *buffer,
+          size_t number_of_blocks,
+          uint32_t initial_value );
+
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD ) */
 
 int libewf_checksum_calculate_adler32(
      uint32_t *checksum_value,
@@ -41,12 +81,6 @@ int libewf_checksum_calculate_adler32(
      uint32_t initial_value,
      libcerror_error_t **error );
 
-#else
-#define libewf_checksum_calculate_adler32( checksum_value, buffer, size, initial_value, error ) \
-	libewf_deflate_calculate_adler32( checksum_value, buffer, size, initial_value, error )
-
-#endif /* defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
-
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,1008 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+/* Prepends an entry to a chunk cache queue
+ */
+static void libewf_chunk_cache_queue_prepend_entry(
+             libewf_chunk_cache_queue_t *queue,
+             libewf_chunk_cache_entry_t *entry )
+{
+	entry->previous_entry = NULL;
+	entry->next_entry     = queue->first_entry;
+
+	if( queue->first_entry != NULL )
+	{
+		queue->first_entry->previous_entry = entry;
+	}
+	else
+	{
+		queue->last_entry = entry;
+	}
+	queue->first_entry = entry;
+
+	queue->number_of_entries += 1;
+	queue->data_size         += entry->data_size;
+}
+
+/* Removes an entry from a chunk cache queue
+ */
+static void libewf_chunk_cache_queue_remove_entry(
+             libewf_chunk_cache_queue_t *queue,
+             libewf_chunk_cache_entry_t *entry )
+{
+	if( entry->previous_entry != NULL )
+	{
+		entry->previous_entry->next_entry = entry->next_entry;
+	}
+	else
+	{
+		queue->first_entry = entry->next_entry;
+	}
+	if( entry->next_entry != NULL )
+	{
+		entry->next_entry->previous_entry = entry->previous_entry;
+	}
+	else
+	{
+		queue->last_entry = entry->previous_entry;
+	}
+	entry->previous_entry = NULL;
+	entry->next_entry     = NULL;
+
+	queue->number_of_entries -= 1;
+	queue->data_size         -= entry->data_size;
+}
+
+/* Retrieves the queue of a specific chunk cache entry
+ * Returns the queue or NULL if not available
+ */
+static libewf_chunk_cache_queue_t *libewf_chunk_cache_get_queue(
+                                    libewf_chunk_cache_t *chunk_cache,
+                                    uint8_t queue )
+{
+	switch( queue )
+	{
+		case LIBEWF_CHUNK_CACHE_QUEUE_RECENT:
+			return( &( chunk_cache->recent_queue ) );
+
+		case LIBEWF_CHUNK_CACHE_QUEUE_FREQUENT:
+			return( &( chunk_cache->frequent_queue ) );
+
+		case LIBEWF_CHUNK_CACHE_QUEUE_GHOST:
+			return( &( chunk_cache->ghost_queue ) );
+
+		default:
+			break;
+	}
+	return( NULL );
+}
+
+/* Creates a chunk cache
+ * Make sure the value chunk_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     size64_t budget,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_initialize";
+	size_t buckets_size   = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_cache = memory_allocate_structure(
+	                libewf_chunk_cache_t );
+
+	if( *chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_cache,
+	     0,
+	     sizeof( libewf_chunk_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk cache.",
+		 function );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+
+		return( -1 );
+	}
+	buckets_size = sizeof( libewf_chunk_cache_entry_t * ) * LIBEWF_CHUNK_CACHE_NUMBER_OF_HASH_BUCKETS;
+
+	( *chunk_cache )->buckets = (libewf_chunk_cache_entry_t **) memory_allocate(
+	                                                             buckets_size );
+
+	if( ( *chunk_cache )->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->buckets,
+	     0,
+	     buckets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_cache )->budget = budget;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_cache != NULL )
+	{
+		if( ( *chunk_cache )->buckets != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->buckets );
+		}
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_free";
+	int result            = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		if( libewf_chunk_cache_empty(
+		     *chunk_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty chunk cache.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *chunk_cache )->buckets );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( result );
+}
+
+/* Empties a chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_empty";
+	int result            = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	while( chunk_cache->recent_queue.last_entry != NULL )
+	{
+		if( libewf_chunk_cache_remove_entry(
+		     chunk_cache,
+		     chunk_cache->recent_queue.last_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry from recent queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	while( chunk_cache->frequent_queue.last_entry != NULL )
+	{
+		if( libewf_chunk_cache_remove_entry(
+		     chunk_cache,
+		     chunk_cache->frequent_queue.last_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry from frequent queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	while( chunk_cache->ghost_queue.last_entry != NULL )
+	{
+		if( libewf_chunk_cache_remove_entry(
+		     chunk_cache,
+		     chunk_cache->ghost_queue.last_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry from ghost queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the budget
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_budget(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t *budget,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_budget";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid budget.",
+		 function );
+
+		return( -1 );
+	}
+	*budget = chunk_cache->budget;
+
+	return( 1 );
+}
+
+/* Sets the budget
+ * Chunks are evicted from the cache when it exceeds the budget
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_set_budget(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t budget,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_set_budget";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_cache->budget = budget;
+
+	/* Evict chunks if the budget was reduced below the size of the cached chunks
+	 */
+	if( ( chunk_cache->recent_queue.data_size + chunk_cache->frequent_queue.data_size ) > budget )
+	{
+		if( libewf_chunk_cache_reclaim(
+		     chunk_cache,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to reclaim chunk cache.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of cache hits
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_number_of_hits(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_number_of_hits";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_hits = chunk_cache->number_of_hits;
+
+	return( 1 );
+}
+
+/* Retrieves the number of cache misses
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_number_of_misses(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_number_of_misses";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_misses = chunk_cache->number_of_misses;
+
+	return( 1 );
+}
+
+/* Retrieves the entry of a specific chunk
+ * Returns 1 if successful, 0 if no such entry or -1 on error
+ */
+int libewf_chunk_cache_get_entry_by_chunk_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_cache_entry_t **entry,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *bucket_entry = NULL;
+	static char *function                    = "libewf_chunk_cache_get_entry_by_chunk_index";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_entry = chunk_cache->buckets[ chunk_index % LIBEWF_CHUNK_CACHE_NUMBER_OF_HASH_BUCKETS ];
+
+	while( bucket_entry != NULL )
+	{
+		if( bucket_entry->chunk_index == chunk_index )
+		{
+			*entry = bucket_entry;
+
+			return( 1 );
+		}
+		bucket_entry = bucket_entry->next_bucket_entry;
+	}
+	return( 0 );
+}
+
+/* Removes an entry from the chunk cache and frees it
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_remove_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_entry_t *entry,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t **bucket_entry = NULL;
+	libewf_chunk_cache_queue_t *queue         = NULL;
+	static char *function                     = "libewf_chunk_cache_remove_entry";
+	int result                                = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	queue = libewf_chunk_cache_get_queue(
+	         chunk_cache,
+	         entry->queue );
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported entry queue: %" PRIu8 ".",
+		 function,
+		 entry->queue );
+
+		return( -1 );
+	}
+	libewf_chunk_cache_queue_remove_entry(
+	 queue,
+	 entry );
+
+	bucket_entry = &( chunk_cache->buckets[ entry->chunk_index % LIBEWF_CHUNK_CACHE_NUMBER_OF_HASH_BUCKETS ] );
+
+	while( *bucket_entry != NULL )
+	{
+		if( *bucket_entry == entry )
+		{
+			*bucket_entry = entry->next_bucket_entry;
+
+			break;
+		}
+		bucket_entry = &( ( *bucket_entry )->next_bucket_entry );
+	}
+	if( entry->chunk_data != NULL )
+	{
+		if( libewf_chunk_data_free(
+		     &( entry->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
+			 function,
+			 entry->chunk_index );
+
+			result = -1;
+		}
+	}
+	memory_free(
+	 entry );
+
+	return( result );
+}
+
+/* Evicts entries until the chunk cache can hold an additional required size within its budget
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_reclaim(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t required_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_reclaim";
+	size64_t recent_queue_budget      = 0;
+	int maximum_number_of_ghosts      = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	recent_queue_budget = chunk_cache->budget / 4;
+
+	while( ( chunk_cache->recent_queue.data_size + chunk_cache->frequent_queue.data_size + required_size ) > chunk_cache->budget )
+	{
+		/* Evict from the recent queue while it exceeds its share of the budget,
+		 * otherwise evict the least recently used chunk from the frequent queue
+		 */
+		entry = chunk_cache->frequent_queue.last_entry;
+
+		if( ( chunk_cache->recent_queue.data_size > recent_queue_budget )
+		 || ( entry == NULL ) )
+		{
+			entry = chunk_cache->recent_queue.last_entry;
+		}
+		if( entry == NULL )
+		{
+			break;
+		}
+		if( entry->queue == LIBEWF_CHUNK_CACHE_QUEUE_RECENT )
+		{
+			/* Keep the chunk index as a ghost entry
+			 */
+			libewf_chunk_cache_queue_remove_entry(
+			 &( chunk_cache->recent_queue ),
+			 entry );
+
+			entry->data_size = 0;
+			entry->queue     = LIBEWF_CHUNK_CACHE_QUEUE_GHOST;
+
+			libewf_chunk_cache_queue_prepend_entry(
+			 &( chunk_cache->ghost_queue ),
+			 entry );
+
+			if( libewf_chunk_data_free(
+			     &( entry->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk: %" PRIu64 " data.",
+				 function,
+				 entry->chunk_index );
+
+				return( -1 );
+			}
+		}
+		else if( libewf_chunk_cache_remove_entry(
+		          chunk_cache,
+		          entry,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry from frequent queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The ghost queue remembers about as many chunk indexes as there are chunks cached
+	 */
+	maximum_number_of_ghosts = chunk_cache->recent_queue.number_of_entries
+	                         + chunk_cache->frequent_queue.number_of_entries;
+
+	if( maximum_number_of_ghosts < LIBEWF_CHUNK_CACHE_MINIMUM_NUMBER_OF_GHOST_ENTRIES )
+	{
+		maximum_number_of_ghosts = LIBEWF_CHUNK_CACHE_MINIMUM_NUMBER_OF_GHOST_ENTRIES;
+	}
+	while( chunk_cache->ghost_queue.number_of_entries > maximum_number_of_ghosts )
+	{
+		if( libewf_chunk_cache_remove_entry(
+		     chunk_cache,
+		     chunk_cache->ghost_queue.last_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry from ghost queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the chunk data of a specific chunk
+ * The chunk data remains managed by the chunk cache and is valid until the next chunk data is inserted
+ * Returns 1 if successful, 0 if not cached or -1 on error
+ */
+int libewf_chunk_cache_get_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_get_chunk_data";
+	int result                        = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          chunk_index,
+	          &entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( ( result == 0 )
+	      || ( entry->queue == LIBEWF_CHUNK_CACHE_QUEUE_GHOST ) )
+	{
+		chunk_cache->number_of_misses += 1;
+
+		return( 0 );
+	}
+	if( entry->queue == LIBEWF_CHUNK_CACHE_QUEUE_FREQUENT )
+	{
+		libewf_chunk_cache_queue_remove_entry(
+		 &( chunk_cache->frequent_queue ),
+		 entry );
+
+		libewf_chunk_cache_queue_prepend_entry(
+		 &( chunk_cache->frequent_queue ),
+		 entry );
+	}
+	/* A chunk in the recent queue keeps its position so that a sequential scan passes through the queue
+	 */
+	chunk_cache->number_of_hits += 1;
+
+	*chunk_data = entry->chunk_data;
+
+	return( 1 );
+}
+
+/* Inserts the chunk data of a specific chunk
+ * The chunk cache takes over management of the chunk data if successful
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_insert_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_insert_chunk_data";
+	size_t bucket_index               = 0;
+	size_t data_size                  = 0;
+	uint8_t queue                     = LIBEWF_CHUNK_CACHE_QUEUE_RECENT;
+	int result                        = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          chunk_index,
+	          &entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( entry->queue != LIBEWF_CHUNK_CACHE_QUEUE_GHOST )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid chunk: %" PRIu64 " data value already set.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		/* A chunk that is read again after it was evicted from the recent queue is considered frequently used
+		 */
+		queue = LIBEWF_CHUNK_CACHE_QUEUE_FREQUENT;
+	}
+	data_size = sizeof( libewf_chunk_data_t ) + chunk_data->allocated_data_size;
+
+	if( chunk_data->compressed_data != NULL )
+	{
+		data_size += chunk_data->compressed_data_size;
+	}
+	if( entry != NULL )
+	{
+		/* Detach the ghost entry so that it is not evicted while reclaiming
+		 */
+		libewf_chunk_cache_queue_remove_entry(
+		 &( chunk_cache->ghost_queue ),
+		 entry );
+	}
+	if( libewf_chunk_cache_reclaim(
+	     chunk_cache,
+	     (size64_t) data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to reclaim chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( entry == NULL )
+	{
+		entry = memory_allocate_structure(
+		         libewf_chunk_cache_entry_t );
+
+		if( entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entry.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     entry,
+		     0,
+		     sizeof( libewf_chunk_cache_entry_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entry.",
+			 function );
+
+			memory_free(
+			 entry );
+
+			return( -1 );
+		}
+		entry->chunk_index = chunk_index;
+
+		bucket_index = (size_t) ( chunk_index % LIBEWF_CHUNK_CACHE_NUMBER_OF_HASH_BUCKETS );
+
+		entry->next_bucket_entry             = chunk_cache->buckets[ bucket_index ];
+		chunk_cache->buckets[ bucket_index ] = entry;
+	}
+	entry->chunk_data = chunk_data;
+	entry->data_size  = data_size;
+	entry->queue      = queue;
+
+	if( queue == LIBEWF_CHUNK_CACHE_QUEUE_FREQUENT )
+	{
+		libewf_chunk_cache_queue_prepend_entry(
+		 &( chunk_cache->frequent_queue ),
+		 entry );
+	}
+	else
+	{
+		libewf_chunk_cache_queue_prepend_entry(
+		 &( chunk_cache->recent_queue ),
+		 entry );
+	}
+	return( 1 );
+
+on_error:
+	if( entry != NULL )
+	{
+		libewf_chunk_cache_queue_prepend_entry(
+		 &( chunk_cache->ghost_queue ),
+		 entry );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,195 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_CACHE_H )
+#define _LIBEWF_CHUNK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_cache_entry libewf_chunk_cache_entry_t;
+
+struct libewf_chunk_cache_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 * This value is NULL for a ghost entry
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The size of the chunk data in memory
+	 */
+	size_t data_size;
+
+	/* The queue that contains the entry
+	 */
+	uint8_t queue;
+
+	/* The previous (more recently used) entry in the queue
+	 */
+	libewf_chunk_cache_entry_t *previous_entry;
+
+	/* The next (less recently used) entry in the queue
+	 */
+	libewf_chunk_cache_entry_t *next_entry;
+
+	/* The next entry in the hash table bucket
+	 */
+	libewf_chunk_cache_entry_t *next_bucket_entry;
+};
+
+typedef struct libewf_chunk_cache_queue libewf_chunk_cache_queue_t;
+
+struct libewf_chunk_cache_queue
+{
+	/* The first (most recently used) entry
+	 */
+	libewf_chunk_cache_entry_t *first_entry;
+
+	/* The last (least recently used) entry
+	 */
+	libewf_chunk_cache_entry_t *last_entry;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The size of the chunk data of the entries in memory
+	 */
+	size64_t data_size;
+};
+
+typedef struct libewf_chunk_cache libewf_chunk_cache_t;
+
+/* The chunk cache uses the 2Q replacement policy
+ * Chunks that are accessed once are kept in the recent queue, which is limited to a quarter of the budget,
+ * so that a sequential scan cannot evict chunks that were accessed more than once from the frequent queue.
+ * The indexes of chunks evicted from the recent queue are remembered in the ghost queue and
+ * a chunk that is read again while its index is in the ghost queue is promoted to the frequent queue.
+ */
+struct libewf_chunk_cache
+{
+	/* The budget, which is the maximum number of bytes of chunk data to cache
+	 */
+	size64_t budget;
+
+	/* The hash table buckets
+	 */
+	libewf_chunk_cache_entry_t **buckets;
+
+	/* The recent (A1in) queue
+	 */
+	libewf_chunk_cache_queue_t recent_queue;
+
+	/* The frequent (Am) queue
+	 */
+	libewf_chunk_cache_queue_t frequent_queue;
+
+	/* The ghost (A1out) queue
+	 */
+	libewf_chunk_cache_queue_t ghost_queue;
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+};
+
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     size64_t budget,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_budget(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t *budget,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_set_budget(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t budget,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_number_of_hits(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_number_of_misses(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_entry_by_chunk_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_cache_entry_t **entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_remove_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_entry_t *entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_reclaim(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t required_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_insert_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_CACHE_H ) */
+
@@ -27,6 +27,7 @@
 #include "libewf_checksum.h"
 #include "libewf_chunk_data.h"
 #include "libewf_compression.h"
+#include "libewf_compression_context.h"
 #include "libewf_definitions.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -735,10 +736,11 @@ int libewf_chunk_data_pack_with_compression(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function            = "libewf_chunk_data_pack_with_compression";
-	size_t safe_compressed_data_size = 0;
-	int8_t compression_level         = 0;
-	int result                       = 0;
+	libewf_compression_context_t *compression_context = NULL;
+	static char *function                             = "libewf_chunk_data_pack_with_compression";
+	size_t safe_compressed_data_size                  = 0;
+	int8_t compression_level                          = 0;
+	int result                                        = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -820,7 +822,22 @@ int libewf_chunk_data_pack_with_compression(
 	{
 		compression_level = LIBEWF_COMPRESSION_LEVEL_DEFAULT;
 	}
-	result = libewf_compress_data(
+	if( libewf_io_handle_get_compression_context(
+	     io_handle,
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compression context.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_compression_context_compress_data(
+		  compression_context,
 		  chunk_data->compressed_data,
 		  &safe_compressed_data_size,
 		  io_handle->compression_method,
@@ -840,7 +857,21 @@ int libewf_chunk_data_pack_with_compression(
 
 		goto on_error;
 	}
-	else if( result != 0 )
+	if( libewf_io_handle_release_compression_context(
+	     io_handle,
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release compression context.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 0 )
 	{
 		if( ( safe_compressed_data_size < 4 )
 		 || ( safe_compressed_data_size > chunk_data->compressed_data_size ) )
@@ -886,6 +917,12 @@ int libewf_chunk_data_pack_with_compression(
 	return( result );
 
 on_error:
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
 	if( chunk_data->compressed_data != NULL )
 	{
 		memory_free(
@@ -1156,9 +1193,10 @@ int libewf_chunk_data_unpack(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function        = "libewf_chunk_data_unpack";
-	size_t remaining_chunk_size  = 0;
-	uint32_t calculated_checksum = 0;
+	libewf_compression_context_t *compression_context = NULL;
+	static char *function                             = "libewf_chunk_data_unpack";
+	size_t remaining_chunk_size                       = 0;
+	uint32_t calculated_checksum                      = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -1327,7 +1365,22 @@ int libewf_chunk_data_unpack(
 		}
 		else
 		{
-			if( libewf_decompress_data(
+			if( libewf_io_handle_get_compression_context(
+			     io_handle,
+			     &compression_context,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve compression context.",
+				 function );
+
+				goto on_error;
+			}
+			if( libewf_compression_context_decompress_data(
+			     compression_context,
 			     chunk_data->compressed_data,
 			     chunk_data->compressed_data_size,
 			     io_handle->compression_method,
@@ -1359,6 +1412,20 @@ int libewf_chunk_data_unpack(
 				chunk_data->data_size    = (size_t) chunk_data->chunk_size;
 				chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
 			}
+			if( libewf_io_handle_release_compression_context(
+			     io_handle,
+			     &compression_context,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release compression context.",
+				 function );
+
+				goto on_error;
+			}
 		}
 	}
 	else if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
@@ -1451,6 +1518,12 @@ int libewf_chunk_data_unpack(
 	return( 1 );
 
 on_error:
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
 	if( chunk_data->compressed_data != NULL )
 	{
 		if( chunk_data->data != NULL )
@@ -1722,6 +1795,110 @@ ssize_t libewf_chunk_data_write(
 	return( total_write_count );
 }
 
+/* Copies a chunk to a buffer in the same layout as libewf_chunk_data_write
+ * Returns the number of bytes copied or -1 on error
+ */
+ssize_t libewf_chunk_data_copy_to_write_buffer(
+         libewf_chunk_data_t *chunk_data,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_copy_to_write_buffer";
+	size_t copy_size      = 0;
+	size_t write_size     = 0;
+	uint8_t copy_checksum = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	copy_size  = chunk_data->data_size + chunk_data->padding_size;
+	write_size = copy_size;
+
+	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+	 && ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+	 && ( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 ) )
+	{
+		copy_checksum = 1;
+		write_size   += 4;
+	}
+	if( write_size > buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid buffer size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     buffer,
+	     chunk_data->data,
+	     copy_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk data to buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* The checksum is stored separately when it is not aligned with the chunk data
+	 */
+	if( copy_checksum != 0 )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( buffer[ copy_size ] ),
+		 chunk_data->checksum );
+	}
+	return( (ssize_t) write_size );
+}
+
 /* Retrieves the write size of the chunk
  * Returns 1 if successful or -1 on error
  */
@@ -172,6 +172,12 @@ ssize_t libewf_chunk_data_write(
          int file_io_pool_entry,
          libcerror_error_t **error );
 
+ssize_t libewf_chunk_data_copy_to_write_buffer(
+         libewf_chunk_data_t *chunk_data,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
 int libewf_chunk_data_get_write_size(
      libewf_chunk_data_t *chunk_data,
      uint32_t *write_size,
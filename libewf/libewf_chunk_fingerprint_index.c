@@ -0,0 +1,498 @@
+/*
+ * Chunk fingerprint index functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_fingerprint_index.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+/* Creates a chunk fingerprint index
+ * Make sure the value fingerprint_index is referencing, is set to NULL
+ * The number of entries must be a power of 2
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_fingerprint_index_initialize(
+     libewf_chunk_fingerprint_index_t **fingerprint_index,
+     int number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_fingerprint_index_initialize";
+
+	if( fingerprint_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fingerprint index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *fingerprint_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid fingerprint index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_entries <= 0 )
+	 || ( ( number_of_entries & ( number_of_entries - 1 ) ) != 0 )
+	 || ( (size_t) number_of_entries > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / LIBEWF_CHUNK_FINGERPRINT_SIZE ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*fingerprint_index = memory_allocate_structure(
+	                      libewf_chunk_fingerprint_index_t );
+
+	if( *fingerprint_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create fingerprint index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *fingerprint_index,
+	     0,
+	     sizeof( libewf_chunk_fingerprint_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear fingerprint index.",
+		 function );
+
+		memory_free(
+		 *fingerprint_index );
+
+		*fingerprint_index = NULL;
+
+		return( -1 );
+	}
+	( *fingerprint_index )->fingerprints = (uint8_t *) memory_allocate(
+	                                                    sizeof( uint8_t ) * LIBEWF_CHUNK_FINGERPRINT_SIZE * number_of_entries );
+
+	if( ( *fingerprint_index )->fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create fingerprints.",
+		 function );
+
+		goto on_error;
+	}
+	( *fingerprint_index )->chunks_data_offset = (off64_t *) memory_allocate(
+	                                                          sizeof( off64_t ) * number_of_entries );
+
+	if( ( *fingerprint_index )->chunks_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunks data offset.",
+		 function );
+
+		goto on_error;
+	}
+	( *fingerprint_index )->chunks_data_size = (uint32_t *) memory_allocate(
+	                                                         sizeof( uint32_t ) * number_of_entries );
+
+	if( ( *fingerprint_index )->chunks_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunks data size.",
+		 function );
+
+		goto on_error;
+	}
+	( *fingerprint_index )->chunks_range_flags = (uint32_t *) memory_allocate(
+	                                                           sizeof( uint32_t ) * number_of_entries );
+
+	if( ( *fingerprint_index )->chunks_range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunks range flags.",
+		 function );
+
+		goto on_error;
+	}
+	( *fingerprint_index )->number_of_entries = number_of_entries;
+
+	if( libewf_chunk_fingerprint_index_empty(
+	     *fingerprint_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to empty fingerprint index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *fingerprint_index != NULL )
+	{
+		libewf_chunk_fingerprint_index_free(
+		 fingerprint_index,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a chunk fingerprint index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_fingerprint_index_free(
+     libewf_chunk_fingerprint_index_t **fingerprint_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_fingerprint_index_free";
+
+	if( fingerprint_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fingerprint index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *fingerprint_index != NULL )
+	{
+		if( ( *fingerprint_index )->chunks_range_flags != NULL )
+		{
+			memory_free(
+			 ( *fingerprint_index )->chunks_range_flags );
+		}
+		if( ( *fingerprint_index )->chunks_data_size != NULL )
+		{
+			memory_free(
+			 ( *fingerprint_index )->chunks_data_size );
+		}
+		if( ( *fingerprint_index )->chunks_data_offset != NULL )
+		{
+			memory_free(
+			 ( *fingerprint_index )->chunks_data_offset );
+		}
+		if( ( *fingerprint_index )->fingerprints != NULL )
+		{
+			memory_free(
+			 ( *fingerprint_index )->fingerprints );
+		}
+		memory_free(
+		 *fingerprint_index );
+
+		*fingerprint_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Empties a chunk fingerprint index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_fingerprint_index_empty(
+     libewf_chunk_fingerprint_index_t *fingerprint_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_fingerprint_index_empty";
+
+	if( fingerprint_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fingerprint index.",
+		 function );
+
+		return( -1 );
+	}
+	if( fingerprint_index->chunks_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid fingerprint index - missing chunks data size.",
+		 function );
+
+		return( -1 );
+	}
+	/* Only the chunk data sizes need to be cleared to mark the entries as unused
+	 */
+	if( memory_set(
+	     fingerprint_index->chunks_data_size,
+	     0,
+	     sizeof( uint32_t ) * fingerprint_index->number_of_entries ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunks data size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the data range of the chunk with a specific fingerprint
+ * Returns 1 if successful, 0 if no such chunk or -1 on error
+ */
+int libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+     libewf_chunk_fingerprint_index_t *fingerprint_index,
+     const uint8_t *fingerprint,
+     size_t fingerprint_size,
+     off64_t *chunk_data_offset,
+     uint32_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_fingerprint_index_get_chunk_by_fingerprint";
+	uint32_t entry_index  = 0;
+
+	if( fingerprint_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fingerprint index.",
+		 function );
+
+		return( -1 );
+	}
+	if( fingerprint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fingerprint.",
+		 function );
+
+		return( -1 );
+	}
+	if( fingerprint_size != LIBEWF_CHUNK_FINGERPRINT_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported fingerprint size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	/* The fingerprint is a cryptographic hash so its first bytes are already evenly distributed
+	 */
+	byte_stream_copy_to_uint32_little_endian(
+	 fingerprint,
+	 entry_index );
+
+	entry_index &= (uint32_t) ( fingerprint_index->number_of_entries - 1 );
+
+	if( fingerprint_index->chunks_data_size[ entry_index ] == 0 )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     &( fingerprint_index->fingerprints[ entry_index * LIBEWF_CHUNK_FINGERPRINT_SIZE ] ),
+	     fingerprint,
+	     LIBEWF_CHUNK_FINGERPRINT_SIZE ) != 0 )
+	{
+		return( 0 );
+	}
+	*chunk_data_offset = fingerprint_index->chunks_data_offset[ entry_index ];
+	*chunk_data_size   = fingerprint_index->chunks_data_size[ entry_index ];
+	*range_flags       = fingerprint_index->chunks_range_flags[ entry_index ];
+
+	return( 1 );
+}
+
+/* Sets the data range of the chunk with a specific fingerprint
+ * The index is bounded, a chunk with a different fingerprint that maps to the same entry is replaced
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_fingerprint_index_set_chunk_by_fingerprint(
+     libewf_chunk_fingerprint_index_t *fingerprint_index,
+     const uint8_t *fingerprint,
+     size_t fingerprint_size,
+     off64_t chunk_data_offset,
+     uint32_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_fingerprint_index_set_chunk_by_fingerprint";
+	uint32_t entry_index  = 0;
+
+	if( fingerprint_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fingerprint index.",
+		 function );
+
+		return( -1 );
+	}
+	if( fingerprint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fingerprint.",
+		 function );
+
+		return( -1 );
+	}
+	if( fingerprint_size != LIBEWF_CHUNK_FINGERPRINT_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported fingerprint size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid chunk data offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chunk data size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 fingerprint,
+	 entry_index );
+
+	entry_index &= (uint32_t) ( fingerprint_index->number_of_entries - 1 );
+
+	if( memory_copy(
+	     &( fingerprint_index->fingerprints[ entry_index * LIBEWF_CHUNK_FINGERPRINT_SIZE ] ),
+	     fingerprint,
+	     LIBEWF_CHUNK_FINGERPRINT_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy fingerprint.",
+		 function );
+
+		return( -1 );
+	}
+	fingerprint_index->chunks_data_offset[ entry_index ] = chunk_data_offset;
+	fingerprint_index->chunks_data_size[ entry_index ]   = chunk_data_size;
+	fingerprint_index->chunks_range_flags[ entry_index ] = range_flags;
+
+	return( 1 );
+}
+
@@ -0,0 +1,95 @@
+/*
+ * Chunk fingerprint index functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_FINGERPRINT_INDEX_H )
+#define _LIBEWF_CHUNK_FINGERPRINT_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_fingerprint_index libewf_chunk_fingerprint_index_t;
+
+struct libewf_chunk_fingerprint_index
+{
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The fingerprints
+	 */
+	uint8_t *fingerprints;
+
+	/* The chunks data offsets
+	 */
+	off64_t *chunks_data_offset;
+
+	/* The chunks data sizes, where 0 represents an unused entry
+	 */
+	uint32_t *chunks_data_size;
+
+	/* The chunks range flags
+	 */
+	uint32_t *chunks_range_flags;
+};
+
+int libewf_chunk_fingerprint_index_initialize(
+     libewf_chunk_fingerprint_index_t **fingerprint_index,
+     int number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_chunk_fingerprint_index_free(
+     libewf_chunk_fingerprint_index_t **fingerprint_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_fingerprint_index_empty(
+     libewf_chunk_fingerprint_index_t *fingerprint_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+     libewf_chunk_fingerprint_index_t *fingerprint_index,
+     const uint8_t *fingerprint,
+     size_t fingerprint_size,
+     off64_t *chunk_data_offset,
+     uint32_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_fingerprint_index_set_chunk_by_fingerprint(
+     libewf_chunk_fingerprint_index_t *fingerprint_index,
+     const uint8_t *fingerprint,
+     size_t fingerprint_size,
+     off64_t chunk_data_offset,
+     uint32_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_FINGERPRINT_INDEX_H ) */
+
@@ -24,17 +24,15 @@
 #include <memory.h>
 #include <types.h>
 
-#include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
-#include "libewf_libfcache.h"
-#include "libewf_libfdata.h"
 #include "libewf_section.h"
 #include "libewf_section_descriptor.h"
 
+#include "ewf_index.h"
 #include "ewf_table.h"
 
 /* Creates a chunk group
@@ -93,7 +91,7 @@ int libewf_chunk_group_initialize(
 		 "%s: unable to create chunk group.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( memory_set(
 	     *chunk_group,
@@ -114,36 +112,9 @@ int libewf_chunk_group_initialize(
 
 		return( -1 );
 	}
-	if( libfdata_list_initialize(
-	     &( ( *chunk_group )->chunks_list ),
-	     (intptr_t *) io_handle,
-	     NULL,
-	     NULL,
-	     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libewf_chunk_data_read_element_data,
-	     NULL,
-	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunks list.",
-		 function );
+	( *chunk_group )->file_io_pool_entry = -1;
 
-		goto on_error;
-	}
 	return( 1 );
-
-on_error:
-	if( *chunk_group != NULL )
-	{
-		memory_free(
-		 *chunk_group );
-
-		*chunk_group = NULL;
-	}
-	return( -1 );
 }
 
 /* Frees a chunk group
@@ -154,7 +125,6 @@ int libewf_chunk_group_free(
      libcerror_error_t **error )
 {
         static char *function = "libewf_chunk_group_free";
-	int result            = 1;
 
 	if( chunk_group == NULL )
 	{
@@ -169,25 +139,27 @@ int libewf_chunk_group_free(
 	}
 	if( *chunk_group != NULL )
 	{
-		if( libfdata_list_free(
-		     &( ( *chunk_group )->chunks_list ),
-		     error ) != 1 )
+		if( ( *chunk_group )->chunks_range_flags != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunks list.",
-			 function );
-
-			result = -1;
+			memory_free(
+			 ( *chunk_group )->chunks_range_flags );
+		}
+		if( ( *chunk_group )->chunks_data_size != NULL )
+		{
+			memory_free(
+			 ( *chunk_group )->chunks_data_size );
+		}
+		if( ( *chunk_group )->chunks_data_offset != NULL )
+		{
+			memory_free(
+			 ( *chunk_group )->chunks_data_offset );
 		}
 		memory_free(
 		 *chunk_group );
 
 		*chunk_group = NULL;
 	}
-	return( result );
+	return( 1 );
 }
 
 /* Clones the chunk group
@@ -261,19 +233,80 @@ int libewf_chunk_group_clone(
 
 		return( -1 );
 	}
-	( *destination_chunk_group )->chunks_list = NULL;
+	( *destination_chunk_group )->chunks_data_offset         = NULL;
+	( *destination_chunk_group )->chunks_data_size           = NULL;
+	( *destination_chunk_group )->chunks_range_flags         = NULL;
+	( *destination_chunk_group )->number_of_chunks           = 0;
+	( *destination_chunk_group )->number_of_allocated_chunks = 0;
+
+	if( source_chunk_group->number_of_chunks > 0 )
+	{
+		if( libewf_chunk_group_resize(
+		     *destination_chunk_group,
+		     source_chunk_group->number_of_chunks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize destination chunk group.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_chunk_group )->chunks_data_offset,
+		     source_chunk_group->chunks_data_offset,
+		     sizeof( off64_t ) * source_chunk_group->number_of_chunks ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunks data offset.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_chunk_group )->chunks_data_size,
+		     source_chunk_group->chunks_data_size,
+		     sizeof( uint32_t ) * source_chunk_group->number_of_chunks ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunks data size.",
+			 function );
 
-/* TODO clone chunks_list */
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_chunk_group )->chunks_range_flags,
+		     source_chunk_group->chunks_range_flags,
+		     sizeof( uint32_t ) * source_chunk_group->number_of_chunks ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunks range flags.",
+			 function );
 
+			goto on_error;
+		}
+		( *destination_chunk_group )->number_of_chunks = source_chunk_group->number_of_chunks;
+	}
 	return( 1 );
 
 on_error:
 	if( *destination_chunk_group != NULL )
 	{
-		memory_free(
-		 *destination_chunk_group );
-
-		*destination_chunk_group = NULL;
+		libewf_chunk_group_free(
+		 destination_chunk_group,
+		 NULL );
 	}
 	return( -1 );
 }
@@ -298,53 +331,116 @@ int libewf_chunk_group_empty(
 
 		return( -1 );
 	}
-	if( libfdata_list_empty(
-	     chunk_group->chunks_list,
-	     error ) != 1 )
+	chunk_group->number_of_chunks   = 0;
+	chunk_group->file_io_pool_entry = -1;
+
+	return( 1 );
+}
+
+/* Resizes the chunks arrays of a chunk group
+ * The arrays are only grown, the number of chunks is not changed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_resize(
+     libewf_chunk_group_t *chunk_group,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	void *reallocation    = NULL;
+	static char *function = "libewf_chunk_group_resize";
+
+	if( chunk_group == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to empty chunks list.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunks < 0 )
+	 || ( (size_t) number_of_chunks > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( off64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks <= chunk_group->number_of_allocated_chunks )
+	{
+		return( 1 );
+	}
+	reallocation = memory_reallocate(
+	                chunk_group->chunks_data_offset,
+	                sizeof( off64_t ) * number_of_chunks );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize chunks data offset.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_group->chunks_data_offset = (off64_t *) reallocation;
+
+	reallocation = memory_reallocate(
+	                chunk_group->chunks_data_size,
+	                sizeof( uint32_t ) * number_of_chunks );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize chunks data size.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_group->chunks_data_size = (uint32_t *) reallocation;
+
+	reallocation = memory_reallocate(
+	                chunk_group->chunks_range_flags,
+	                sizeof( uint32_t ) * number_of_chunks );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize chunks range flags.",
 		 function );
 
 		return( -1 );
 	}
+	chunk_group->chunks_range_flags = (uint32_t *) reallocation;
+
+	chunk_group->number_of_allocated_chunks = number_of_chunks;
+
 	return( 1 );
 }
 
-/* Fills the chunks list from the EWF version 1 sector table entries
+/* Retrieves the number of chunks in a chunk group
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_group_fill_v1(
+int libewf_chunk_group_get_number_of_chunks(
      libewf_chunk_group_t *chunk_group,
-     uint64_t chunk_index,
-     size32_t chunk_size,
-     int file_io_pool_entry,
-     libewf_section_descriptor_t *table_section,
-     off64_t base_offset,
-     uint32_t number_of_entries,
-     const uint8_t *table_entries_data,
-     size_t table_entries_data_size,
-     uint8_t tainted,
+     int *number_of_chunks,
      libcerror_error_t **error )
 {
-	static char *function          = "libewf_chunk_group_fill_v1";
-	size_t data_offset             = 0;
-	off64_t chunk_data_end_offset  = 0;
-	off64_t last_chunk_data_offset = 0;
-	off64_t last_chunk_data_size   = 0;
-	uint32_t chunk_data_size       = 0;
-	uint32_t current_offset        = 0;
-	uint32_t next_offset           = 0;
-	uint32_t range_flags           = 0;
-	uint32_t stored_offset         = 0;
-	uint32_t table_entry_index     = 0;
-	uint8_t corrupted              = 0;
-	uint8_t is_compressed          = 0;
-	uint8_t overflow               = 0;
-	int element_index              = 0;
+	static char *function = "libewf_chunk_group_get_number_of_chunks";
 
 	if( chunk_group == NULL )
 	{
@@ -357,144 +453,1141 @@ int libewf_chunk_group_fill_v1(
 
 		return( -1 );
 	}
-	if( table_section == NULL )
+	if( number_of_chunks == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid table section.",
+		 "%s: invalid number of chunks.",
 		 function );
 
 		return( -1 );
 	}
-	if( base_offset < 0 )
+	*number_of_chunks = chunk_group->number_of_chunks;
+
+	return( 1 );
+}
+
+/* Retrieves the data range of a specific chunk in a chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_get_chunk_by_index(
+     libewf_chunk_group_t *chunk_group,
+     int chunk_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_get_chunk_by_index";
+
+	if( chunk_group == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
-		 "%s: invalid base offset.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
 		 function );
 
 		return( -1 );
 	}
-	if( table_entries_data == NULL )
+	if( ( chunk_index < 0 )
+	 || ( chunk_index >= chunk_group->number_of_chunks ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid table entries data.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( table_entries_data_size > (size_t) SSIZE_MAX )
+	if( file_io_pool_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid table entries data size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
 		 function );
 
 		return( -1 );
 	}
-	byte_stream_copy_to_uint32_little_endian(
-	 &( table_entries_data[ data_offset ] ),
-	 stored_offset );
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
 
-	data_offset += sizeof( ewf_table_entry_v1_t );
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
 
-	for( table_entry_index = 0;
-	     table_entry_index < ( number_of_entries - 1 );
-	     table_entry_index++ )
+		return( -1 );
+	}
+	if( range_flags == NULL )
 	{
-		if( overflow == 0 )
-		{
-			is_compressed  = (uint8_t) ( stored_offset >> 31 );
-			current_offset = stored_offset & 0x7fffffffUL;
-		}
-		else
-		{
-			current_offset = stored_offset;
-		}
-		byte_stream_copy_to_uint32_little_endian(
-		 &( table_entries_data[ data_offset ] ),
-		 stored_offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
 
-		data_offset += sizeof( ewf_table_entry_v1_t );
+		return( -1 );
+	}
+	*file_io_pool_entry = chunk_group->file_io_pool_entry;
+	*chunk_data_offset  = chunk_group->chunks_data_offset[ chunk_index ];
+	*chunk_data_size    = (size64_t) chunk_group->chunks_data_size[ chunk_index ];
+	*range_flags        = chunk_group->chunks_range_flags[ chunk_index ];
 
-		if( overflow == 0 )
-		{
-			next_offset = stored_offset & 0x7fffffffUL;
-		}
-		else
-		{
-			next_offset = stored_offset;
-		}
-		corrupted = 0;
+	return( 1 );
+}
 
-		/* This is to compensate for the crappy > 2 GiB segment file solution in EnCase 6.7
-		 */
-		if( next_offset < current_offset )
-		{
-			if( stored_offset < current_offset )
-			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: entry: %" PRIu32 " offset: %" PRIu32 " larger than stored offset: %" PRIu32 ".\n",
-					 function,
-					 table_entry_index,
-					 current_offset,
-					 stored_offset );
-				}
-#endif
-				corrupted = 1;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			else if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: entry: %" PRIu32 " offset: %" PRIu32 " larger than next offset: %" PRIu32 ".\n",
-				 function,
-				 table_entry_index,
-				 current_offset,
-				 next_offset );
-			}
+/* Sets the data range of a specific chunk in a chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_set_chunk_by_index(
+     libewf_chunk_group_t *chunk_group,
+     int chunk_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_set_chunk_by_index";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_index < 0 )
+	 || ( chunk_index >= chunk_group->number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* All the chunks of a chunk group are stored in the same segment file
+	 */
+	if( file_io_pool_entry != chunk_group->file_io_pool_entry )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( chunk_data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid chunk data offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* A chunk data size that does not fit is only possible for a corrupted table entry
+	 */
+	if( chunk_data_size > (size64_t) UINT32_MAX )
+	{
+		chunk_data_size = (size64_t) UINT32_MAX;
+		range_flags    |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+	}
+	chunk_group->chunks_data_offset[ chunk_index ] = chunk_data_offset;
+	chunk_group->chunks_data_size[ chunk_index ]   = (uint32_t) chunk_data_size;
+	chunk_group->chunks_range_flags[ chunk_index ] = range_flags;
+
+	return( 1 );
+}
+
+/* Appends a chunk to a chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_append_chunk(
+     libewf_chunk_group_t *chunk_group,
+     int *chunk_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	static char *function           = "libewf_chunk_group_append_chunk";
+	int number_of_allocated_chunks  = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file IO pool entry value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->number_of_chunks == INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk group - number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->number_of_chunks == 0 )
+	{
+		chunk_group->file_io_pool_entry = file_io_pool_entry;
+	}
+	if( chunk_group->number_of_chunks >= chunk_group->number_of_allocated_chunks )
+	{
+		if( chunk_group->number_of_allocated_chunks < ( INT_MAX / 2 ) )
+		{
+			number_of_allocated_chunks = chunk_group->number_of_allocated_chunks * 2;
+		}
+		else
+		{
+			number_of_allocated_chunks = INT_MAX;
+		}
+		if( number_of_allocated_chunks < LIBEWF_CHUNK_GROUP_MINIMUM_NUMBER_OF_ALLOCATED_CHUNKS )
+		{
+			number_of_allocated_chunks = LIBEWF_CHUNK_GROUP_MINIMUM_NUMBER_OF_ALLOCATED_CHUNKS;
+		}
+		if( libewf_chunk_group_resize(
+		     chunk_group,
+		     number_of_allocated_chunks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize chunk group.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	chunk_group->number_of_chunks += 1;
+
+	if( libewf_chunk_group_set_chunk_by_index(
+	     chunk_group,
+	     chunk_group->number_of_chunks - 1,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     chunk_data_size,
+	     range_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %d.",
+		 function,
+		 chunk_group->number_of_chunks - 1 );
+
+		chunk_group->number_of_chunks -= 1;
+
+		return( -1 );
+	}
+	*chunk_index = chunk_group->number_of_chunks - 1;
+
+	return( 1 );
+}
+
+/* Fills the chunk group from the EWF version 1 sector table entries
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_fill_v1(
+     libewf_chunk_group_t *chunk_group,
+     uint64_t chunk_index,
+     size32_t chunk_size,
+     int file_io_pool_entry,
+     libewf_section_descriptor_t *table_section,
+     off64_t base_offset,
+     uint32_t number_of_entries,
+     const uint8_t *table_entries_data,
+     size_t table_entries_data_size,
+     uint8_t tainted,
+     libcerror_error_t **error )
+{
+	static char *function          = "libewf_chunk_group_fill_v1";
+	size_t data_offset             = 0;
+	off64_t chunk_data_end_offset  = 0;
+	off64_t last_chunk_data_offset = 0;
+	off64_t last_chunk_data_size   = 0;
+	uint32_t chunk_data_size       = 0;
+	uint32_t current_offset        = 0;
+	uint32_t next_offset           = 0;
+	uint32_t range_flags           = 0;
+	uint32_t stored_offset         = 0;
+	uint32_t table_entry_index     = 0;
+	uint8_t corrupted              = 0;
+	uint8_t is_compressed          = 0;
+	uint8_t overflow               = 0;
+	int group_chunk_index          = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_section == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table section.",
+		 function );
+
+		return( -1 );
+	}
+	if( base_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid base offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_entries_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table entries data.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_entries_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid table entries data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries > (uint32_t) ( INT_MAX - chunk_group->number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_group_resize(
+	     chunk_group,
+	     chunk_group->number_of_chunks + (int) number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( table_entries_data[ data_offset ] ),
+	 stored_offset );
+
+	data_offset += sizeof( ewf_table_entry_v1_t );
+
+	for( table_entry_index = 0;
+	     table_entry_index < ( number_of_entries - 1 );
+	     table_entry_index++ )
+	{
+		if( overflow == 0 )
+		{
+			is_compressed  = (uint8_t) ( stored_offset >> 31 );
+			current_offset = stored_offset & 0x7fffffffUL;
+		}
+		else
+		{
+			current_offset = stored_offset;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( table_entries_data[ data_offset ] ),
+		 stored_offset );
+
+		data_offset += sizeof( ewf_table_entry_v1_t );
+
+		if( overflow == 0 )
+		{
+			next_offset = stored_offset & 0x7fffffffUL;
+		}
+		else
+		{
+			next_offset = stored_offset;
+		}
+		corrupted = 0;
+
+		/* This is to compensate for the crappy > 2 GiB segment file solution in EnCase 6.7
+		 */
+		if( next_offset < current_offset )
+		{
+			if( stored_offset < current_offset )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: entry: %" PRIu32 " offset: %" PRIu32 " larger than stored offset: %" PRIu32 ".\n",
+					 function,
+					 table_entry_index,
+					 current_offset,
+					 stored_offset );
+				}
+#endif
+				corrupted = 1;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			else if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: entry: %" PRIu32 " offset: %" PRIu32 " larger than next offset: %" PRIu32 ".\n",
+				 function,
+				 table_entry_index,
+				 current_offset,
+				 next_offset );
+			}
 #endif
 			chunk_data_size = stored_offset - current_offset;
 		}
 		else
 		{
-			chunk_data_size = next_offset - current_offset;
+			chunk_data_size = next_offset - current_offset;
+		}
+		if( chunk_data_size == 0 )
+		{
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: invalid entry: %" PRIu32 " size value is zero.\n",
+				 function,
+				 table_entry_index );
+			}
+			corrupted = 1;
+		}
+		if( chunk_data_size > (uint32_t) INT32_MAX )
+		{
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: invalid entry: %" PRIu32 " size value exceeds maximum.\n",
+				 function,
+				 table_entry_index );
+			}
+			corrupted = 1;
+		}
+		if( is_compressed != 0 )
+		{
+			range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+		}
+		else
+		{
+			range_flags = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+		}
+		if( corrupted != 0 )
+		{
+			range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+		}
+		if( tainted != 0 )
+		{
+			range_flags |= LIBEWF_RANGE_FLAG_IS_TAINTED;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: table entry: %05" PRIu32 " chunk\t\t\t: %" PRIu64 "\n",
+			 function,
+			 table_entry_index,
+			 chunk_index );
+
+			libcnotify_printf(
+			 "%s: table entry: %05" PRIu32 " base offset\t\t: 0x%08" PRIx64 "\n",
+			 function,
+			 table_entry_index,
+			 base_offset );
+
+			libcnotify_printf(
+			 "%s: table entry: %05" PRIu32 " chunk data offset\t: %" PRIu32 " (0x%08" PRIx32 ") (file offset: 0x%08" PRIx64 ")\n",
+			 function,
+			 table_entry_index,
+			 current_offset,
+			 current_offset,
+			 base_offset + current_offset );
+
+			libcnotify_printf(
+			 "%s: table entry: %05" PRIu32 " chunk data size\t\t: %" PRIu32 "\n",
+			 function,
+			 table_entry_index,
+			 chunk_data_size );
+
+			libcnotify_printf(
+			 "%s: table entry: %05" PRIu32 " chunk data flags:\n",
+			 function,
+			 table_entry_index );
+
+			if( is_compressed != 0 )
+			{
+				libcnotify_printf(
+				 "\tIs compressed\n" );
+			}
+			else
+			{
+				libcnotify_printf(
+				 "\tHas checksum\n" );
+			}
+			if( corrupted != 0 )
+			{
+				libcnotify_printf(
+				 "\tIs corrupted\n" );
+			}
+			else if( tainted != 0 )
+			{
+				libcnotify_printf(
+				 "\tIs tainted\n" );
+			}
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+		chunk_index++;
+
+		if( libewf_chunk_group_append_chunk(
+		     chunk_group,
+		     &group_chunk_index,
+		     file_io_pool_entry,
+		     base_offset + current_offset,
+		     (size64_t) chunk_data_size,
+		     range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append chunk: %" PRIu32 " to chunk group.",
+			 function,
+			 table_entry_index );
+
+			return( -1 );
+		}
+		/* This is to compensate for the crappy > 2 GiB segment file solution in EnCase 6.7
+		 */
+		if( ( overflow == 0 )
+		 && ( ( current_offset + chunk_data_size ) > (uint32_t) INT32_MAX ) )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: entry: %" PRIu64 " offset overflow at: %" PRIu32 ".\n",
+				 function,
+				 table_entry_index,
+				 current_offset );
+			}
+#endif
+			overflow      = 1;
+			is_compressed = 0;
+		}
+	}
+	if( overflow == 0 )
+	{
+		is_compressed  = (uint8_t) ( stored_offset >> 31 );
+		current_offset = stored_offset & 0x7fffffffUL;
+	}
+	else
+	{
+		current_offset = stored_offset;
+	}
+	corrupted = 0;
+
+	/* There is no indication how large the last chunk is.
+	 * The only thing known is where it starts.
+	 * However it can be determined using the offset of the next section.
+	 * The size of the last chunk is determined by subtracting the last offset from the offset of the next section.
+	 *
+	 * The offset of the next section is either table_section->end_offset for original EWF and EWF-S01
+	 * or table_section->start_offset for other types of EWF
+	 */
+	last_chunk_data_offset = (off64_t) base_offset + current_offset;
+
+	if( last_chunk_data_offset > (off64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid last entry: %" PRIu32 " offset value exceeds maximum.",
+		 function,
+		 table_entry_index );
+
+		return( -1 );
+	}
+	/* A table2 section where the chunk data is stored 2 sections before
+	 */
+	if( ( table_section->type_string_length == 6 )
+	 && ( memory_compare(
+	       (void *) table_section->type_string,
+	       (void *) "table2",
+	       6 ) == 0 ) )
+	{
+		chunk_data_end_offset = table_section->start_offset - table_section->size;
+	}
+	/* A table2 section where the chunk data is stored 1 section before
+	 */
+	else if( last_chunk_data_offset < table_section->start_offset )
+	{
+		chunk_data_end_offset = table_section->start_offset;
+	}
+	/* A table section that contains the chunk data
+	 */
+	else if( last_chunk_data_offset < table_section->end_offset )
+	{
+		chunk_data_end_offset = table_section->end_offset;
+	}
+	if( last_chunk_data_offset < chunk_data_end_offset )
+	{
+		last_chunk_data_size = chunk_data_end_offset - last_chunk_data_offset;
+	}
+	else
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: invalid last entry: %" PRIu32 " offset value exceeds table section end offset.\n",
+			 function,
+			 table_entry_index );
+		}
+#endif
+		corrupted = 1;
+	}
+	if( last_chunk_data_size <= 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: invalid last entry: %" PRIu32 " size value is zero or less.\n",
+			 function,
+			 table_entry_index );
+		}
+#endif
+		corrupted = 1;
+	}
+	if( last_chunk_data_size > (off64_t) INT32_MAX )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: invalid last entry: %" PRIu32 " size value exceeds maximum.\n",
+			 function,
+			 table_entry_index );
+		}
+#endif
+		corrupted = 1;
+	}
+	if( is_compressed != 0 )
+	{
+		range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+	}
+	else
+	{
+		range_flags = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+	}
+	if( corrupted != 0 )
+	{
+		range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+	}
+	if( tainted != 0 )
+	{
+		range_flags |= LIBEWF_RANGE_FLAG_IS_TAINTED;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: table entry: %05" PRIu32 " chunk\t\t\t: %" PRIu64 "\n",
+		 function,
+		 table_entry_index,
+		 chunk_index );
+
+		libcnotify_printf(
+		 "%s: table entry: %05" PRIu32 " base offset\t\t: 0x%08" PRIx64 "\n",
+		 function,
+		 table_entry_index,
+		 base_offset );
+
+		libcnotify_printf(
+		 "%s: table entry: %05" PRIu32 " chunk data offset\t: %" PRIu32 " (0x%08" PRIx32 ")\n",
+		 function,
+		 table_entry_index,
+		 current_offset,
+		 current_offset );
+
+		libcnotify_printf(
+		 "%s: table entry: %05" PRIu32 " chunk data size\t\t: %" PRIu32 " (calculated)\n",
+		 function,
+		 table_entry_index,
+		 last_chunk_data_size );
+
+		libcnotify_printf(
+		 "%s: table entry: %05" PRIu32 " chunk data flags:\n",
+		 function,
+		 table_entry_index );
+
+		if( is_compressed != 0 )
+		{
+			libcnotify_printf(
+			 "\tIs compressed\n" );
+		}
+		else
+		{
+			libcnotify_printf(
+			 "\tHas checksum\n" );
 		}
-		if( chunk_data_size == 0 )
+		if( corrupted != 0 )
 		{
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: invalid entry: %" PRIu32 " size value is zero.\n",
-				 function,
-				 table_entry_index );
-			}
-			corrupted = 1;
+			libcnotify_printf(
+			 "\tIs corrupted\n" );
 		}
-		if( chunk_data_size > (uint32_t) INT32_MAX )
+		else if( tainted != 0 )
+		{
+			libcnotify_printf(
+			 "\tIs tainted\n" );
+		}
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	if( libewf_chunk_group_append_chunk(
+	     chunk_group,
+	     &group_chunk_index,
+	     file_io_pool_entry,
+	     last_chunk_data_offset,
+	     (size64_t) last_chunk_data_size,
+	     range_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append chunk: %" PRIu32 " to chunk group.",
+		 function,
+		 table_entry_index );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	return( 1 );
+}
+
+/* Determines if the EWF version 1 sector table entries contain references
+ *
+ * An entry that refers to the chunk data of a preceding entry has an offset
+ * that does not exceed the largest offset of the preceding entries. An offset
+ * that is smaller than that of the preceding entry is also used by EnCase 6.7
+ * for chunk data beyond 2 GiB, where the offset uses the full 32 bits. The latter
+ * is distinguished by the full 32-bit offset following the preceding chunk data
+ * within twice the chunk size.
+ * Returns 1 if the entries contain references, 0 if not or -1 on error
+ */
+int libewf_chunk_group_has_v1_references(
+     size32_t chunk_size,
+     uint32_t number_of_entries,
+     const uint8_t *table_entries_data,
+     size_t table_entries_data_size,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_chunk_group_has_v1_references";
+	size_t data_offset         = 0;
+	uint32_t current_offset    = 0;
+	uint32_t last_offset       = 0;
+	uint32_t stored_offset     = 0;
+	uint32_t table_entry_index = 0;
+
+	if( table_entries_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table entries data.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_entries_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid table entries data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) number_of_entries > ( table_entries_data_size / sizeof( ewf_table_entry_v1_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( table_entry_index = 0;
+	     table_entry_index < number_of_entries;
+	     table_entry_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( table_entries_data[ data_offset ] ),
+		 stored_offset );
+
+		data_offset += sizeof( ewf_table_entry_v1_t );
+
+		current_offset = stored_offset & 0x7fffffffUL;
+
+		if( ( table_entry_index == 0 )
+		 || ( current_offset > last_offset ) )
+		{
+			last_offset = current_offset;
+
+			continue;
+		}
+		/* This is to compensate for the crappy > 2 GiB segment file solution in EnCase 6.7
+		 */
+		if( ( stored_offset > last_offset )
+		 && ( (uint64_t) ( stored_offset - last_offset ) <= ( (uint64_t) chunk_size * 2 ) ) )
+		{
+			return( 0 );
+		}
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Fills the chunk group from the EWF version 1 sector table entries
+ * where an entry can refer to the chunk data of a preceding entry
+ *
+ * A deduplicated EWFX chunks section stores identical chunk data only once.
+ * The table entry of a duplicate chunk contains the offset of the chunk data
+ * that was stored for a preceding entry in the same table. The chunk data
+ * of the other entries is stored in order, hence the size of a chunk is
+ * determined from the offset of the next entry that does not refer to
+ * preceding chunk data.
+ *
+ * Entries without references are filled by libewf_chunk_group_fill_v1
+ * that also handles the EnCase 6.7 offsets beyond 2 GiB and corrupted entries.
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_fill_v1_with_references(
+     libewf_chunk_group_t *chunk_group,
+     uint64_t chunk_index,
+     size32_t chunk_size,
+     int file_io_pool_entry,
+     libewf_section_descriptor_t *table_section,
+     off64_t base_offset,
+     uint32_t number_of_entries,
+     const uint8_t *table_entries_data,
+     size_t table_entries_data_size,
+     uint8_t tainted,
+     libcerror_error_t **error )
+{
+	int *referenced_chunk_indexes    = NULL;
+	int *stored_chunk_indexes        = NULL;
+	static char *function            = "libewf_chunk_group_fill_v1_with_references";
+	size_t data_offset               = 0;
+	off64_t chunk_data_end_offset    = 0;
+	off64_t chunk_data_offset        = 0;
+	off64_t last_chunk_data_offset   = 0;
+	off64_t stored_chunk_data_offset = 0;
+	uint32_t current_offset          = 0;
+	uint32_t last_stored_offset      = 0;
+	uint32_t range_flags             = 0;
+	uint32_t stored_offset           = 0;
+	uint32_t table_entry_index       = 0;
+	int first_group_chunk_index      = 0;
+	int group_chunk_index            = 0;
+	int number_of_stored_chunks      = 0;
+	int referenced_chunk_index       = 0;
+	int result                       = 0;
+	int search_end_index             = 0;
+	int search_index                 = 0;
+	int search_start_index           = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_section == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table section.",
+		 function );
+
+		return( -1 );
+	}
+	if( base_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid base offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_entries_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table entries data.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_entries_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid table entries data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_entries == 0 )
+	 || ( number_of_entries > (uint32_t) ( INT_MAX - chunk_group->number_of_chunks ) )
+	 || ( (size_t) number_of_entries > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( int ) ) )
+	 || ( (size_t) number_of_entries > ( table_entries_data_size / sizeof( ewf_table_entry_v1_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_group_has_v1_references(
+	          chunk_size,
+	          number_of_entries,
+	          table_entries_data,
+	          table_entries_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if table entries contain references.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		if( libewf_chunk_group_fill_v1(
+		     chunk_group,
+		     chunk_index,
+		     chunk_size,
+		     file_io_pool_entry,
+		     table_section,
+		     base_offset,
+		     number_of_entries,
+		     table_entries_data,
+		     table_entries_data_size,
+		     tainted,
+		     error ) != 1 )
 		{
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: invalid entry: %" PRIu32 " size value exceeds maximum.\n",
-				 function,
-				 table_entry_index );
-			}
-			corrupted = 1;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill chunk group.",
+			 function );
+
+			return( -1 );
 		}
-		if( is_compressed != 0 )
+		return( 1 );
+	}
+	if( libewf_chunk_group_resize(
+	     chunk_group,
+	     chunk_group->number_of_chunks + (int) number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize chunk group.",
+		 function );
+
+		goto on_error;
+	}
+	/* The chunk group indexes of the entries that contain the offset of stored chunk data
+	 * in order of their offset
+	 */
+	stored_chunk_indexes = (int *) memory_allocate(
+	                                sizeof( int ) * number_of_entries );
+
+	if( stored_chunk_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stored chunk indexes.",
+		 function );
+
+		goto on_error;
+	}
+	/* The chunk group index of the entry that is referred to by an entry
+	 * where -1 represents an entry that does not refer to a preceding entry
+	 */
+	referenced_chunk_indexes = (int *) memory_allocate(
+	                                    sizeof( int ) * number_of_entries );
+
+	if( referenced_chunk_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create referenced chunk indexes.",
+		 function );
+
+		goto on_error;
+	}
+	first_group_chunk_index = chunk_group->number_of_chunks;
+
+	for( table_entry_index = 0;
+	     table_entry_index < number_of_entries;
+	     table_entry_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( table_entries_data[ data_offset ] ),
+		 stored_offset );
+
+		data_offset += sizeof( ewf_table_entry_v1_t );
+
+		current_offset = stored_offset & 0x7fffffffUL;
+
+		if( ( stored_offset >> 31 ) != 0 )
 		{
 			range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
 		}
@@ -502,317 +1595,206 @@ int libewf_chunk_group_fill_v1(
 		{
 			range_flags = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
 		}
-		if( corrupted != 0 )
-		{
-			range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
-		}
 		if( tainted != 0 )
 		{
 			range_flags |= LIBEWF_RANGE_FLAG_IS_TAINTED;
 		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: table entry: %05" PRIu32 " chunk\t\t\t: %" PRIu64 "\n",
-			 function,
-			 table_entry_index,
-			 chunk_index );
+		referenced_chunk_index = -1;
 
-			libcnotify_printf(
-			 "%s: table entry: %05" PRIu32 " base offset\t\t: 0x%08" PRIx64 "\n",
-			 function,
-			 table_entry_index,
-			 base_offset );
+		if( ( number_of_stored_chunks > 0 )
+		 && ( current_offset <= last_stored_offset ) )
+		{
+			/* The offsets of the stored chunk data are in increasing order
+			 */
+			search_start_index = 0;
+			search_end_index   = number_of_stored_chunks;
+			chunk_data_offset  = base_offset + current_offset;
 
-			libcnotify_printf(
-			 "%s: table entry: %05" PRIu32 " chunk data offset\t: %" PRIu32 " (0x%08" PRIx32 ") (file offset: 0x%08" PRIx64 ")\n",
-			 function,
-			 table_entry_index,
-			 current_offset,
-			 current_offset,
-			 base_offset + current_offset );
+			while( search_start_index < search_end_index )
+			{
+				search_index = search_start_index + ( ( search_end_index - search_start_index ) / 2 );
 
-			libcnotify_printf(
-			 "%s: table entry: %05" PRIu32 " chunk data size\t\t: %" PRIu32 "\n",
-			 function,
-			 table_entry_index,
-			 chunk_data_size );
+				stored_chunk_data_offset = chunk_group->chunks_data_offset[ stored_chunk_indexes[ search_index ] ];
 
-			libcnotify_printf(
-			 "%s: table entry: %05" PRIu32 " chunk data flags:\n",
-			 function,
-			 table_entry_index );
+				if( stored_chunk_data_offset == chunk_data_offset )
+				{
+					referenced_chunk_index = stored_chunk_indexes[ search_index ];
 
-			if( is_compressed != 0 )
-			{
-				libcnotify_printf(
-				 "\tIs compressed\n" );
-			}
-			else
-			{
-				libcnotify_printf(
-				 "\tHas checksum\n" );
-			}
-			if( corrupted != 0 )
-			{
-				libcnotify_printf(
-				 "\tIs corrupted\n" );
+					break;
+				}
+				else if( stored_chunk_data_offset < chunk_data_offset )
+				{
+					search_start_index = search_index + 1;
+				}
+				else
+				{
+					search_end_index = search_index;
+				}
 			}
-			else if( tainted != 0 )
+			if( referenced_chunk_index == -1 )
 			{
-				libcnotify_printf(
-				 "\tIs tainted\n" );
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: invalid entry: %" PRIu32 " offset: %" PRIu32 " does not refer to preceding chunk data.\n",
+					 function,
+					 table_entry_index,
+					 current_offset );
+				}
+#endif
+				range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+
+				/* Mark the entry as a reference without chunk data
+				 */
+				referenced_chunk_index = -2;
 			}
-			libcnotify_printf(
-			 "\n" );
 		}
-#endif /* defined( HAVE_DEBUG_OUTPUT ) */
-
-		chunk_index++;
-
-		if( libfdata_list_append_element_with_mapped_size(
-		     chunk_group->chunks_list,
-		     &element_index,
+		if( libewf_chunk_group_append_chunk(
+		     chunk_group,
+		     &group_chunk_index,
 		     file_io_pool_entry,
 		     base_offset + current_offset,
-		     (size64_t) chunk_data_size,
+		     0,
 		     range_flags,
-		     chunk_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
+			 "%s: unable to append chunk: %" PRIu32 " to chunk group.",
 			 function,
 			 table_entry_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		/* This is to compensate for the crappy > 2 GiB segment file solution in EnCase 6.7
-		 */
-		if( ( overflow == 0 )
-		 && ( ( current_offset + chunk_data_size ) > (uint32_t) INT32_MAX ) )
+		referenced_chunk_indexes[ table_entry_index ] = referenced_chunk_index;
+
+		if( referenced_chunk_index == -1 )
 		{
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
+			/* The chunk data of the preceding stored chunk ends where this chunk data starts
+			 */
+			if( number_of_stored_chunks > 0 )
 			{
-				libcnotify_printf(
-				 "%s: entry: %" PRIu64 " offset overflow at: %" PRIu32 ".\n",
-				 function,
-				 table_entry_index,
-				 current_offset );
+				chunk_group->chunks_data_size[ stored_chunk_indexes[ number_of_stored_chunks - 1 ] ] = current_offset - last_stored_offset;
 			}
-#endif
-			overflow      = 1;
-			is_compressed = 0;
-		}
-	}
-	if( overflow == 0 )
-	{
-		is_compressed  = (uint8_t) ( stored_offset >> 31 );
-		current_offset = stored_offset & 0x7fffffffUL;
-	}
-	else
-	{
-		current_offset = stored_offset;
-	}
-	corrupted = 0;
-
-	/* There is no indication how large the last chunk is.
-	 * The only thing known is where it starts.
-	 * However it can be determined using the offset of the next section.
-	 * The size of the last chunk is determined by subtracting the last offset from the offset of the next section.
-	 *
-	 * The offset of the next section is either table_section->end_offset for original EWF and EWF-S01
-	 * or table_section->start_offset for other types of EWF
-	 */
-	last_chunk_data_offset = (off64_t) base_offset + current_offset;
-
-	if( last_chunk_data_offset > (off64_t) INT64_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid last entry: %" PRIu32 " offset value exceeds maximum.",
-		 function,
-		 table_entry_index );
+			stored_chunk_indexes[ number_of_stored_chunks++ ] = group_chunk_index;
 
-		return( -1 );
-	}
-	/* A table2 section where the chunk data is stored 2 sections before
-	 */
-	if( ( table_section->type_string_length == 6 )
-	 && ( memory_compare(
-	       (void *) table_section->type_string,
-	       (void *) "table2",
-	       6 ) == 0 ) )
-	{
-		chunk_data_end_offset = table_section->start_offset - table_section->size;
-	}
-	/* A table2 section where the chunk data is stored 1 section before
-	 */
-	else if( last_chunk_data_offset < table_section->start_offset )
-	{
-		chunk_data_end_offset = table_section->start_offset;
-	}
-	/* A table section that contains the chunk data
-	 */
-	else if( last_chunk_data_offset < table_section->end_offset )
-	{
-		chunk_data_end_offset = table_section->end_offset;
-	}
-	if( last_chunk_data_offset < chunk_data_end_offset )
-	{
-		last_chunk_data_size = chunk_data_end_offset - last_chunk_data_offset;
-	}
-	else
-	{
+			last_stored_offset = current_offset;
+		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
 			libcnotify_printf(
-			 "%s: invalid last entry: %" PRIu32 " offset value exceeds table section end offset.\n",
+			 "%s: table entry: %05" PRIu32 " chunk\t\t\t: %" PRIu64 "\n",
 			 function,
-			 table_entry_index );
-		}
-#endif
-		corrupted = 1;
-	}
-	if( last_chunk_data_size <= 0 )
-	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
+			 table_entry_index,
+			 chunk_index );
+
 			libcnotify_printf(
-			 "%s: invalid last entry: %" PRIu32 " size value is zero or less.\n",
+			 "%s: table entry: %05" PRIu32 " chunk data offset\t: %" PRIu32 " (0x%08" PRIx32 ") (file offset: 0x%08" PRIx64 ")\n",
 			 function,
-			 table_entry_index );
-		}
-#endif
-		corrupted = 1;
-	}
-	if( last_chunk_data_size > (off64_t) INT32_MAX )
-	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
+			 table_entry_index,
+			 current_offset,
+			 current_offset,
+			 base_offset + current_offset );
+
+			if( referenced_chunk_index >= 0 )
+			{
+				libcnotify_printf(
+				 "%s: table entry: %05" PRIu32 " refers to chunk data of entry\t: %d\n",
+				 function,
+				 table_entry_index,
+				 referenced_chunk_index - first_group_chunk_index );
+			}
 			libcnotify_printf(
-			 "%s: invalid last entry: %" PRIu32 " size value exceeds maximum.\n",
-			 function,
-			 table_entry_index );
+			 "\n" );
 		}
-#endif
-		corrupted = 1;
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+		chunk_index++;
 	}
-	if( is_compressed != 0 )
+	/* There is no indication how large the last stored chunk is.
+	 * The size is determined by subtracting its offset from the offset of the next section
+	 * or from the start of the table section if it is preceded by the sectors section.
+	 */
+	group_chunk_index      = stored_chunk_indexes[ number_of_stored_chunks - 1 ];
+	last_chunk_data_offset = chunk_group->chunks_data_offset[ group_chunk_index ];
+
+	if( ( table_section->type_string_length == 6 )
+	 && ( memory_compare(
+	       (void *) table_section->type_string,
+	       (void *) "table2",
+	       6 ) == 0 ) )
 	{
-		range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+		chunk_data_end_offset = table_section->start_offset - table_section->size;
 	}
-	else
+	else if( last_chunk_data_offset < table_section->start_offset )
 	{
-		range_flags = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+		chunk_data_end_offset = table_section->start_offset;
 	}
-	if( corrupted != 0 )
+	else if( last_chunk_data_offset < table_section->end_offset )
 	{
-		range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+		chunk_data_end_offset = table_section->end_offset;
 	}
-	if( tainted != 0 )
+	if( ( last_chunk_data_offset < chunk_data_end_offset )
+	 && ( ( chunk_data_end_offset - last_chunk_data_offset ) <= (off64_t) INT32_MAX ) )
 	{
-		range_flags |= LIBEWF_RANGE_FLAG_IS_TAINTED;
+		chunk_group->chunks_data_size[ group_chunk_index ] = (uint32_t) ( chunk_data_end_offset - last_chunk_data_offset );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	else
 	{
-		libcnotify_printf(
-		 "%s: table entry: %05" PRIu32 " chunk\t\t\t: %" PRIu64 "\n",
-		 function,
-		 table_entry_index,
-		 chunk_index );
-
-		libcnotify_printf(
-		 "%s: table entry: %05" PRIu32 " base offset\t\t: 0x%08" PRIx64 "\n",
-		 function,
-		 table_entry_index,
-		 base_offset );
-
-		libcnotify_printf(
-		 "%s: table entry: %05" PRIu32 " chunk data offset\t: %" PRIu32 " (0x%08" PRIx32 ")\n",
-		 function,
-		 table_entry_index,
-		 current_offset,
-		 current_offset );
-
-		libcnotify_printf(
-		 "%s: table entry: %05" PRIu32 " chunk data size\t\t: %" PRIu32 " (calculated)\n",
-		 function,
-		 table_entry_index,
-		 last_chunk_data_size );
-
-		libcnotify_printf(
-		 "%s: table entry: %05" PRIu32 " chunk data flags:\n",
-		 function,
-		 table_entry_index );
-
-		if( is_compressed != 0 )
-		{
-			libcnotify_printf(
-			 "\tIs compressed\n" );
-		}
-		else
-		{
-			libcnotify_printf(
-			 "\tHas checksum\n" );
-		}
-		if( corrupted != 0 )
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
 		{
 			libcnotify_printf(
-			 "\tIs corrupted\n" );
+			 "%s: invalid last stored entry: %d size value out of bounds.\n",
+			 function,
+			 group_chunk_index - first_group_chunk_index );
 		}
-		else if( tainted != 0 )
+#endif
+		chunk_group->chunks_range_flags[ group_chunk_index ] |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+	}
+	/* The entries that refer to preceding chunk data share its size
+	 */
+	for( table_entry_index = 0;
+	     table_entry_index < number_of_entries;
+	     table_entry_index++ )
+	{
+		referenced_chunk_index = referenced_chunk_indexes[ table_entry_index ];
+
+		if( referenced_chunk_index >= 0 )
 		{
-			libcnotify_printf(
-			 "\tIs tainted\n" );
+			group_chunk_index = first_group_chunk_index + (int) table_entry_index;
+
+			chunk_group->chunks_data_size[ group_chunk_index ]    = chunk_group->chunks_data_size[ referenced_chunk_index ];
+			chunk_group->chunks_range_flags[ group_chunk_index ] |= chunk_group->chunks_range_flags[ referenced_chunk_index ] & LIBEWF_RANGE_FLAG_IS_CORRUPTED;
 		}
-		libcnotify_printf(
-		 "\n" );
 	}
-#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+	memory_free(
+	 referenced_chunk_indexes );
 
-	if( libfdata_list_append_element_with_mapped_size(
-	     chunk_group->chunks_list,
-	     &element_index,
-	     file_io_pool_entry,
-	     last_chunk_data_offset,
-	     (size64_t) last_chunk_data_size,
-	     range_flags,
-	     chunk_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
-		 function,
-		 table_entry_index );
+	memory_free(
+	 stored_chunk_indexes );
 
-		return( -1 );
+	return( 1 );
+
+on_error:
+	if( referenced_chunk_indexes != NULL )
+	{
+		memory_free(
+		 referenced_chunk_indexes );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( stored_chunk_indexes != NULL )
 	{
-		libcnotify_printf(
-		 "\n" );
+		memory_free(
+		 stored_chunk_indexes );
 	}
-#endif
-	return( 1 );
+	return( -1 );
 }
 
-/* Fills the chunks list from the EWF version 2 sector table entries
+/* Fills the chunk group from the EWF version 2 sector table entries
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_group_fill_v2(
@@ -827,14 +1809,14 @@ int libewf_chunk_group_fill_v2(
      uint8_t tainted,
      libcerror_error_t **error )
 {
-	static char *function      = "libewf_chunk_group_fill_v2";
-	size_t data_offset         = 0;
-	uint64_t chunk_data_offset = 0;
-	uint32_t chunk_data_flags  = 0;
-	uint32_t chunk_data_size   = 0;
-	uint32_t range_flags       = 0;
-	uint32_t table_entry_index = 0;
-	int element_index          = 0;
+	static char *function          = "libewf_chunk_group_fill_v2";
+	size_t data_offset             = 0;
+	uint64_t chunk_data_offset     = 0;
+	uint32_t chunk_data_flags      = 0;
+	uint32_t chunk_data_size       = 0;
+	uint32_t range_flags           = 0;
+	uint32_t table_entry_index     = 0;
+	int group_chunk_index          = 0;
 
 	if( chunk_group == NULL )
 	{
@@ -880,6 +1862,31 @@ int libewf_chunk_group_fill_v2(
 
 		return( -1 );
 	}
+	if( number_of_entries > (uint32_t) ( INT_MAX - chunk_group->number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_group_resize(
+	     chunk_group,
+	     chunk_group->number_of_chunks + (int) number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize chunk group.",
+		 function );
+
+		return( -1 );
+	}
 	for( table_entry_index = 0;
 	     table_entry_index < number_of_entries;
 	     table_entry_index++ )
@@ -1001,21 +2008,20 @@ int libewf_chunk_group_fill_v2(
 			chunk_data_offset = table_section->start_offset + sizeof( ewf_table_header_v2_t ) + data_offset - sizeof( ewf_table_entry_v2_t );
 			chunk_data_size   = 8;
 		}
-		if( libfdata_list_append_element_with_mapped_size(
-		     chunk_group->chunks_list,
-		     &element_index,
+		if( libewf_chunk_group_append_chunk(
+		     chunk_group,
+		     &group_chunk_index,
 		     file_io_pool_entry,
 		     chunk_data_offset,
 		     (size64_t) chunk_data_size,
 		     range_flags,
-		     chunk_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
+			 "%s: unable to append chunk: %" PRIu32 " to chunk group.",
 			 function,
 			 table_entry_index );
 
@@ -1034,7 +2040,162 @@ int libewf_chunk_group_fill_v2(
 	return( 1 );
 }
 
-/* Corrects the chunks list from the offsets
+/* Fills the chunk group from the index chunks data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_fill_index(
+     libewf_chunk_group_t *chunk_group,
+     uint64_t chunk_index,
+     size32_t chunk_size,
+     int file_io_pool_entry,
+     uint32_t number_of_entries,
+     const uint8_t *index_chunks_data,
+     size_t index_chunks_data_size,
+     libcerror_error_t **error )
+{
+	static char *function          = "libewf_chunk_group_fill_index";
+	size_t data_offset             = 0;
+	uint64_t chunk_data_offset     = 0;
+	uint32_t chunk_data_size       = 0;
+	uint32_t entry_index           = 0;
+	uint32_t range_flags           = 0;
+	int group_chunk_index          = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_chunks_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index chunks data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( index_chunks_data_size > (size_t) SSIZE_MAX )
+	 || ( index_chunks_data_size < ( (size_t) number_of_entries * sizeof( ewf_index_chunk_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid index chunks data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries > (uint32_t) ( INT_MAX - chunk_group->number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_group_resize(
+	     chunk_group,
+	     chunk_group->number_of_chunks + (int) number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_index_chunk_t *) &( index_chunks_data[ data_offset ] ) )->chunk_data_offset,
+		 chunk_data_offset );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_index_chunk_t *) &( index_chunks_data[ data_offset ] ) )->chunk_data_size,
+		 chunk_data_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_index_chunk_t *) &( index_chunks_data[ data_offset ] ) )->range_flags,
+		 range_flags );
+
+		data_offset += sizeof( ewf_index_chunk_t );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: index entry: %05" PRIu32 " chunk\t\t\t: %" PRIu64 "\n",
+			 function,
+			 entry_index,
+			 chunk_index );
+
+			libcnotify_printf(
+			 "%s: index entry: %05" PRIu32 " chunk data offset\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 entry_index,
+			 chunk_data_offset,
+			 chunk_data_offset );
+
+			libcnotify_printf(
+			 "%s: index entry: %05" PRIu32 " chunk data size\t\t: %" PRIu32 "\n",
+			 function,
+			 entry_index,
+			 chunk_data_size );
+
+			libcnotify_printf(
+			 "%s: index entry: %05" PRIu32 " range flags\t\t: 0x%08" PRIx32 "\n",
+			 function,
+			 entry_index,
+			 range_flags );
+
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+		if( libewf_chunk_group_append_chunk(
+		     chunk_group,
+		     &group_chunk_index,
+		     file_io_pool_entry,
+		     (off64_t) chunk_data_offset,
+		     (size64_t) chunk_data_size,
+		     range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append chunk: %" PRIu32 " to chunk group.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		chunk_index++;
+	}
+	return( 1 );
+}
+
+/* Corrects the chunk group from the offsets
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_group_correct_v1(
@@ -1283,8 +2444,8 @@ int libewf_chunk_group_correct_v1(
 		}
 #endif /* defined( HAVE_DEBUG_OUTPUT ) */
 
-		if( libfdata_list_get_element_by_index(
-		     chunk_group->chunks_list,
+		if( libewf_chunk_group_get_chunk_by_index(
+		     chunk_group,
 		     table_entry_index,
 		     &previous_file_io_pool_entry,
 		     &previous_chunk_data_offset,
@@ -1296,7 +2457,7 @@ int libewf_chunk_group_correct_v1(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve element: %" PRIu32 " from chunks list.",
+			 "%s: unable to retrieve chunk: %" PRIu32 " from chunk group.",
 			 function,
 			 table_entry_index );
 
@@ -1367,8 +2528,8 @@ int libewf_chunk_group_correct_v1(
 		}
 		if( update_data_range != 0 )
 		{
-			if( libfdata_list_set_element_by_index(
-			     chunk_group->chunks_list,
+			if( libewf_chunk_group_set_chunk_by_index(
+			     chunk_group,
 			     table_entry_index,
 			     file_io_pool_entry,
 			     base_offset + current_offset,
@@ -1380,7 +2541,7 @@ int libewf_chunk_group_correct_v1(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set element: %" PRIu32 " in chunks list.",
+				 "%s: unable to set chunk: %" PRIu32 " in chunk group.",
 				 function,
 				 table_entry_index );
 
@@ -1562,8 +2723,8 @@ int libewf_chunk_group_correct_v1(
 	}
 #endif /* defined( HAVE_DEBUG_OUTPUT ) */
 
-	if( libfdata_list_get_element_by_index(
-	     chunk_group->chunks_list,
+	if( libewf_chunk_group_get_chunk_by_index(
+	     chunk_group,
 	     table_entry_index,
 	     &previous_file_io_pool_entry,
 	     &previous_chunk_data_offset,
@@ -1575,7 +2736,7 @@ int libewf_chunk_group_correct_v1(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element: %" PRIu32 " from chunks list.",
+		 "%s: unable to retrieve chunk: %" PRIu32 " from chunk group.",
 		 function,
 		 table_entry_index );
 
@@ -1646,8 +2807,8 @@ int libewf_chunk_group_correct_v1(
 	}
 	if( update_data_range != 0 )
 	{
-		if( libfdata_list_set_element_by_index(
-		     chunk_group->chunks_list,
+		if( libewf_chunk_group_set_chunk_by_index(
+		     chunk_group,
 		     table_entry_index,
 		     file_io_pool_entry,
 		     base_offset + current_offset,
@@ -1659,7 +2820,7 @@ int libewf_chunk_group_correct_v1(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set element: %" PRIu32 " in chunks list.",
+			 "%s: unable to set chunk: %" PRIu32 " in chunk group.",
 			 function,
 			 table_entry_index );
 
@@ -27,7 +27,6 @@
 
 #include "libewf_io_handle.h"
 #include "libewf_libcerror.h"
-#include "libewf_libfdata.h"
 #include "libewf_section_descriptor.h"
 
 #if defined( __cplusplus )
@@ -38,9 +37,29 @@ typedef struct libewf_chunk_group libewf_chunk_group_t;
 
 struct libewf_chunk_group
 {
-	/* The chunks list
+	/* The file IO pool entry of the segment file that contains the chunks
 	 */
-	libfdata_list_t *chunks_list;
+	int file_io_pool_entry;
+
+	/* The number of chunks
+	 */
+	int number_of_chunks;
+
+	/* The number of allocated chunks
+	 */
+	int number_of_allocated_chunks;
+
+	/* The chunks data offsets
+	 */
+	off64_t *chunks_data_offset;
+
+	/* The chunks data sizes
+	 */
+	uint32_t *chunks_data_size;
+
+	/* The chunks range flags
+	 */
+	uint32_t *chunks_range_flags;
 
 	/* The range start offset
 	 */
@@ -69,6 +88,43 @@ int libewf_chunk_group_empty(
      libewf_chunk_group_t *chunk_group,
      libcerror_error_t **error );
 
+int libewf_chunk_group_resize(
+     libewf_chunk_group_t *chunk_group,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_number_of_chunks(
+     libewf_chunk_group_t *chunk_group,
+     int *number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_chunk_by_index(
+     libewf_chunk_group_t *chunk_group,
+     int chunk_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_set_chunk_by_index(
+     libewf_chunk_group_t *chunk_group,
+     int chunk_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_append_chunk(
+     libewf_chunk_group_t *chunk_group,
+     int *chunk_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
 int libewf_chunk_group_fill_v1(
      libewf_chunk_group_t *chunk_group,
      uint64_t chunk_index,
@@ -82,6 +138,26 @@ int libewf_chunk_group_fill_v1(
      uint8_t tainted,
      libcerror_error_t **error );
 
+int libewf_chunk_group_has_v1_references(
+     size32_t chunk_size,
+     uint32_t number_of_entries,
+     const uint8_t *table_entries_data,
+     size_t table_entries_data_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_fill_v1_with_references(
+     libewf_chunk_group_t *chunk_group,
+     uint64_t chunk_index,
+     size32_t chunk_size,
+     int file_io_pool_entry,
+     libewf_section_descriptor_t *table_section,
+     off64_t base_offset,
+     uint32_t number_of_entries,
+     const uint8_t *table_entries_data,
+     size_t table_entries_data_size,
+     uint8_t tainted,
+     libcerror_error_t **error );
+
 int libewf_chunk_group_fill_v2(
      libewf_chunk_group_t *chunk_group,
      uint64_t chunk_index,
@@ -94,6 +170,16 @@ int libewf_chunk_group_fill_v2(
      uint8_t tainted,
      libcerror_error_t **error );
 
+int libewf_chunk_group_fill_index(
+     libewf_chunk_group_t *chunk_group,
+     uint64_t chunk_index,
+     size32_t chunk_size,
+     int file_io_pool_entry,
+     uint32_t number_of_entries,
+     const uint8_t *index_chunks_data,
+     size_t index_chunks_data_size,
+     libcerror_error_t **error );
+
 int libewf_chunk_group_correct_v1(
      libewf_chunk_group_t *chunk_group,
      uint64_t chunk_index,
@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
@@ -154,6 +155,20 @@ int libewf_chunk_table_initialize(
 
 		goto on_error;
 	}
+	if( libewf_chunk_cache_initialize(
+	     &( ( *chunk_table )->chunk_cache ),
+	     LIBEWF_CHUNK_CACHE_DEFAULT_BUDGET,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		goto on_error;
+	}
 	( *chunk_table )->io_handle = io_handle;
 
 	return( 1 );
@@ -161,6 +176,12 @@ int libewf_chunk_table_initialize(
 on_error:
 	if( *chunk_table != NULL )
 	{
+		if( ( *chunk_table )->single_chunk_data_cache != NULL )
+		{
+			libfcache_cache_free(
+			 &( ( *chunk_table )->single_chunk_data_cache ),
+			 NULL );
+		}
 		if( ( *chunk_table )->chunk_data_cache != NULL )
 		{
 			libfcache_cache_free(
@@ -238,6 +259,19 @@ int libewf_chunk_table_free(
 
 			result = -1;
 		}
+		if( libewf_chunk_cache_free(
+		     &( ( *chunk_table )->chunk_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk cache.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *chunk_table );
 
@@ -322,6 +356,7 @@ int libewf_chunk_table_clone(
 	( *destination_chunk_table )->checksum_errors         = NULL;
 	( *destination_chunk_table )->chunk_data_cache        = NULL;
 	( *destination_chunk_table )->single_chunk_data_cache = NULL;
+	( *destination_chunk_table )->chunk_cache             = NULL;
 
 	if( libcdata_range_list_clone(
 	     &( ( *destination_chunk_table )->checksum_errors ),
@@ -367,11 +402,33 @@ int libewf_chunk_table_clone(
 
 		goto on_error;
 	}
+	/* The cached chunk data is not shared with the destination
+	 */
+	if( libewf_chunk_cache_initialize(
+	     &( ( *destination_chunk_table )->chunk_cache ),
+	     source_chunk_table->chunk_cache->budget,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination chunk cache.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
 	if( *destination_chunk_table != NULL )
 	{
+		if( ( *destination_chunk_table )->single_chunk_data_cache != NULL )
+		{
+			libfcache_cache_free(
+			 &( ( *destination_chunk_table )->single_chunk_data_cache ),
+			 NULL );
+		}
 		if( ( *destination_chunk_table )->chunk_data_cache != NULL )
 		{
 			libfcache_cache_free(
@@ -698,6 +755,248 @@ int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
 	return( result );
 }
 
+/* Retrieves the chunk data of a specific chunk in a chunk group
+ * The chunk data is read from the segment file if it is not in the chunk data cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_chunk_group_chunk_data(
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunk_data_cache,
+     libewf_chunk_group_t *chunk_group,
+     int group_chunk_index,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	libfcache_cache_value_t *cache_value = NULL;
+	static char *function                = "libewf_chunk_table_get_chunk_group_chunk_data";
+	size64_t chunk_data_size             = 0;
+	off64_t cache_value_offset           = 0;
+	off64_t chunk_data_offset            = 0;
+	ssize_t read_count                   = 0;
+	int64_t cache_value_timestamp        = 0;
+	uint32_t range_flags                 = 0;
+	int cache_entry_index                = 0;
+	int cache_value_file_index           = -1;
+	int file_io_pool_entry               = -1;
+	int number_of_cache_entries          = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_group_get_chunk_by_index(
+	     chunk_group,
+	     group_chunk_index,
+	     &file_io_pool_entry,
+	     &chunk_data_offset,
+	     &chunk_data_size,
+	     &range_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %d from chunk group.",
+		 function,
+		 group_chunk_index );
+
+		goto on_error;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported chunk: %" PRIu64 " range flags.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     chunk_data_cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunk data cache entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunk data cache entries value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	cache_entry_index = (int) ( chunk_index % (uint64_t) number_of_cache_entries );
+
+	/* The chunk index is stored as the cache value timestamp
+	 */
+	if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
+	{
+		if( libfcache_cache_get_value_by_index(
+		     chunk_data_cache,
+		     cache_entry_index,
+		     &cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache entry: %d from chunk data cache.",
+			 function,
+			 cache_entry_index );
+
+			goto on_error;
+		}
+		if( cache_value != NULL )
+		{
+			if( libfcache_cache_value_get_identifier(
+			     cache_value,
+			     &cache_value_file_index,
+			     &cache_value_offset,
+			     &cache_value_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve cache value identifier.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( cache_value_file_index == file_io_pool_entry )
+			 && ( cache_value_offset == chunk_data_offset )
+			 && ( cache_value_timestamp == (int64_t) chunk_index ) )
+			{
+				if( libfcache_cache_value_get_value(
+				     cache_value,
+				     (intptr_t **) chunk_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve chunk data from cache value.",
+					 function );
+
+					goto on_error;
+				}
+				return( 1 );
+			}
+		}
+	}
+	if( libewf_chunk_data_initialize(
+	     &safe_chunk_data,
+	     io_handle->chunk_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	read_count = libewf_chunk_data_read_from_file_io_pool(
+		      safe_chunk_data,
+		      file_io_pool,
+		      file_io_pool_entry,
+		      chunk_data_offset,
+		      chunk_data_size,
+		      range_flags,
+		      error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( libfcache_cache_set_value_by_index(
+	     chunk_data_cache,
+	     cache_entry_index,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     (int64_t) chunk_index,
+	     (intptr_t *) safe_chunk_data,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+	     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in cache entry: %d.",
+		 function,
+		 chunk_index,
+		 cache_entry_index );
+
+		goto on_error;
+	}
+	*chunk_data = safe_chunk_data;
+
+	return( 1 );
+
+on_error:
+	if( safe_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &safe_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Retrieves the chunk data of a chunk at a specific offset
  * Returns 1 if successful or -1 on error
  */
@@ -721,7 +1020,7 @@ int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
 	uint64_t chunk_index              = 0;
 	uint32_t segment_number           = 0;
 	int chunk_groups_list_index       = 0;
-	int chunks_list_index             = 0;
+	int group_chunk_index             = 0;
 	int result                        = 0;
 
 	if( chunk_table == NULL )
@@ -842,15 +1141,17 @@ int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
 				return( -1 );
 			}
 			chunk_index            = (uint64_t) offset / media_values->chunk_size;
-			chunks_list_index      = (int) ( chunk_group_data_offset / media_values->chunk_size );
-			safe_chunk_data_offset = chunk_group_data_offset - ( (off64_t) chunks_list_index * media_values->chunk_size );
-
-			if( libfdata_list_get_element_value_by_index(
-			     chunk_group->chunks_list,
-			     (intptr_t *) file_io_pool,
-			     (libfdata_cache_t *) chunk_data_cache,
-			     chunks_list_index,
-			     (intptr_t **) &( chunk_table->current_chunk_data ),
+			group_chunk_index      = (int) ( chunk_group_data_offset / media_values->chunk_size );
+			safe_chunk_data_offset = chunk_group_data_offset - ( (off64_t) group_chunk_index * media_values->chunk_size );
+
+			if( libewf_chunk_table_get_chunk_group_chunk_data(
+			     io_handle,
+			     file_io_pool,
+			     chunk_data_cache,
+			     chunk_group,
+			     group_chunk_index,
+			     chunk_index,
+			     &( chunk_table->current_chunk_data ),
 			     read_flags,
 			     error ) != 1 )
 			{
@@ -882,27 +1183,10 @@ int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
 			}
 			chunk_table->current_chunk_data->chunk_index = chunk_index;
 
-			if( libfdata_list_get_element_mapped_range(
-			     chunk_group->chunks_list,
-			     chunks_list_index,
-			     &( chunk_table->current_chunk_data->range_start_offset ),
-			     (size64_t *) &( chunk_table->current_chunk_data->range_end_offset ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve list element: %d mapped range for chunk group: %d in segment file: %" PRIu32 ".",
-				 function,
-				 chunks_list_index,
-				 chunk_groups_list_index,
-				 segment_number );
-
-				return( -1 );
-			}
-			chunk_table->current_chunk_data->range_start_offset += chunk_table->current_chunk_group->range_start_offset;
-			chunk_table->current_chunk_data->range_end_offset   += chunk_table->current_chunk_data->range_start_offset;
+			chunk_table->current_chunk_data->range_start_offset = chunk_group->range_start_offset
+			                                                    + ( (off64_t) group_chunk_index * media_values->chunk_size );
+			chunk_table->current_chunk_data->range_end_offset   = chunk_table->current_chunk_data->range_start_offset
+			                                                    + (off64_t) media_values->chunk_size;
 
 			if( (size64_t) chunk_table->current_chunk_data->range_end_offset > media_values->media_size )
 			{
@@ -918,8 +1202,280 @@ int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
 	return( result );
 }
 
+/* Retrieves the (packed) data range of a chunk at a specific offset
+ * This function does not read the chunk data
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_chunk_table_get_chunk_data_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_data_flags,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group = NULL;
+	static char *function             = "libewf_chunk_table_get_chunk_data_range_by_offset";
+	off64_t chunk_group_data_offset   = 0;
+	uint32_t segment_number           = 0;
+	int chunk_groups_list_index       = 0;
+	int group_chunk_index             = 0;
+	int result                        = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+		  chunk_table,
+		  file_io_pool,
+		  segment_table,
+		  offset,
+		  &segment_number,
+		  &chunk_groups_list_index,
+		  &chunk_group_data_offset,
+		  &chunk_group,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( chunk_group == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk group: %d.",
+			 function,
+			 chunk_groups_list_index );
+
+			return( -1 );
+		}
+		group_chunk_index = (int) ( chunk_group_data_offset / media_values->chunk_size );
+
+		if( libewf_chunk_group_get_chunk_by_index(
+		     chunk_group,
+		     group_chunk_index,
+		     file_io_pool_entry,
+		     chunk_data_offset,
+		     chunk_data_size,
+		     chunk_data_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %d from chunk group: %d in segment file: %" PRIu32 ".",
+			 function,
+			 group_chunk_index,
+			 chunk_groups_list_index,
+			 segment_number );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Updates chunk data retrieved for a specific offset
+ * Sets the range of the chunk data and unpacks it if necessary
+ * Adds a checksum error if the data is corrupted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_update_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     off64_t offset,
+     libewf_chunk_data_t *chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_chunk_table_update_chunk_data_by_offset";
+	uint64_t chunk_index       = 0;
+	uint64_t number_of_sectors = 0;
+	uint64_t start_sector      = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_index = (uint64_t) offset / media_values->chunk_size;
+
+	if( chunk_data != chunk_table->current_chunk_data )
+	{
+		/* The media size can change after the chunk data was cached
+		 */
+		chunk_data->chunk_index        = chunk_index;
+		chunk_data->range_start_offset = (off64_t) ( chunk_index * media_values->chunk_size );
+		chunk_data->range_end_offset   = chunk_data->range_start_offset + media_values->chunk_size;
+
+		if( (size64_t) chunk_data->range_end_offset > media_values->media_size )
+		{
+			chunk_data->range_end_offset = (off64_t) media_values->media_size;
+		}
+		*chunk_data_offset = offset - chunk_data->range_start_offset;
+	}
+	if( libewf_chunk_data_unpack(
+	     chunk_data,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		/* Add checksum error
+		 */
+		start_sector      = chunk_data->range_start_offset / media_values->bytes_per_sector;
+		number_of_sectors = media_values->sectors_per_chunk;
+
+		if( ( start_sector + number_of_sectors ) > (uint64_t) media_values->number_of_sectors )
+		{
+			number_of_sectors = (uint64_t) media_values->number_of_sectors - start_sector;
+		}
+		if( libcdata_range_list_insert_range(
+		     chunk_table->checksum_errors,
+		     start_sector,
+		     number_of_sectors,
+		     NULL,
+		     NULL,
+		     NULL,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert checksum error in range list.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
 /* Retrieves the chunk data of a chunk at a specific offset
  * Adds a checksum error if the data is corrupted
+ * The chunk data is cached in the chunk cache and remains valid until the next chunk data is retrieved
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_table_get_chunk_data_by_offset(
@@ -935,10 +1491,13 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 {
 	libewf_chunk_data_t *safe_chunk_data = NULL;
 	static char *function                = "libewf_chunk_table_get_chunk_data_by_offset";
+	size64_t packed_chunk_data_size      = 0;
+	ssize_t read_count                   = 0;
+	off64_t packed_chunk_data_offset     = 0;
 	off64_t safe_chunk_data_offset       = 0;
 	uint64_t chunk_index                 = 0;
-	uint64_t number_of_sectors           = 0;
-	uint64_t start_sector                = 0;
+	uint32_t packed_chunk_data_flags     = 0;
+	int file_io_pool_entry               = 0;
 	int result                           = 0;
 
 	if( chunk_table == NULL )
@@ -1007,18 +1566,13 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	result = libewf_chunk_table_get_segment_file_chunk_data_by_offset(
-		  chunk_table,
-		  io_handle,
-		  file_io_pool,
-	          chunk_table->chunk_data_cache,
-		  media_values,
-		  segment_table,
-		  offset,
-		  &safe_chunk_data_offset,
-		  &safe_chunk_data,
-		  0,
-		  error );
+	chunk_index = (uint64_t) offset / media_values->chunk_size;
+
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_table->chunk_cache,
+	          chunk_index,
+	          &safe_chunk_data,
+	          error );
 
 	if( result == -1 )
 	{
@@ -1026,67 +1580,183 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment file chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 "%s: unable to retrieve chunk: %" PRIu64 " data from cache.",
 		 function,
-		 offset,
-		 offset );
+		 chunk_index );
 
-		return( -1 );
+		goto on_error;
 	}
-	else if( result != 0 )
+	else if( result == 0 )
 	{
-		if( libewf_chunk_data_unpack(
-		     safe_chunk_data,
-		     io_handle,
-		     error ) != 1 )
+		result = libewf_chunk_table_get_chunk_data_range_by_offset(
+			  chunk_table,
+			  file_io_pool,
+			  media_values,
+			  segment_table,
+			  offset,
+			  &file_io_pool_entry,
+			  &packed_chunk_data_offset,
+			  &packed_chunk_data_size,
+			  &packed_chunk_data_flags,
+			  error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
 			 function,
 			 chunk_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( ( safe_chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+		else if( ( result != 0 )
+		      && ( ( packed_chunk_data_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) == 0 ) )
 		{
-			/* Add checksum error
-			 */
-			start_sector      = safe_chunk_data->range_start_offset / media_values->bytes_per_sector;
-			number_of_sectors = media_values->sectors_per_chunk;
+			if( libewf_chunk_data_initialize(
+			     &safe_chunk_data,
+			     media_values->chunk_size,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
 
-			if( ( start_sector + number_of_sectors ) > (uint64_t) media_values->number_of_sectors )
+				goto on_error;
+			}
+			read_count = libewf_chunk_data_read_from_file_io_pool(
+				      safe_chunk_data,
+				      file_io_pool,
+				      file_io_pool_entry,
+				      packed_chunk_data_offset,
+				      packed_chunk_data_size,
+				      packed_chunk_data_flags,
+				      error );
+
+			if( read_count < 0 )
 			{
-				number_of_sectors = (uint64_t) media_values->number_of_sectors - start_sector;
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			/* The chunk data is unpacked before it is cached so that its size in memory is known
+			 */
+			if( libewf_chunk_data_unpack(
+			     safe_chunk_data,
+			     io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
 			}
-			if( libcdata_range_list_insert_range(
-			     chunk_table->checksum_errors,
-			     start_sector,
-			     number_of_sectors,
-			     NULL,
-			     NULL,
-			     NULL,
-			     error ) == -1 )
+			if( libewf_chunk_cache_insert_chunk_data(
+			     chunk_table->chunk_cache,
+			     chunk_index,
+			     safe_chunk_data,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to insert checksum error in range list.",
-				 function );
+				 "%s: unable to insert chunk: %" PRIu64 " data into cache.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		else if( result != 0 )
+		{
+			/* The chunk data of a sparse chunk is not stored in the chunk cache,
+			 * it is retrieved from the segment file chunk group instead, which keeps
+			 * it in the libfcache chunk data cache
+			 */
+			result = libewf_chunk_table_get_segment_file_chunk_data_by_offset(
+				  chunk_table,
+				  io_handle,
+				  file_io_pool,
+				  chunk_table->chunk_data_cache,
+				  media_values,
+				  segment_table,
+				  offset,
+				  &safe_chunk_data_offset,
+				  &safe_chunk_data,
+				  0,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment file chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
 
 				return( -1 );
 			}
 		}
 	}
 	if( result != 0 )
+	{
+		if( libewf_chunk_table_update_chunk_data_by_offset(
+		     chunk_table,
+		     io_handle,
+		     media_values,
+		     offset,
+		     safe_chunk_data,
+		     &safe_chunk_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
+	if( result != 0 )
 	{
 		*chunk_data_offset = safe_chunk_data_offset;
 		*chunk_data        = safe_chunk_data;
 	}
 	return( result );
+
+on_error:
+	if( safe_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &safe_chunk_data,
+		 NULL );
+	}
+	return( -1 );
 }
 
 /* Retrieves the chunk data of a chunk at a specific offset
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_group.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
@@ -81,6 +82,10 @@ struct libewf_chunk_table
 	/* The single chunk data cache
 	 */
 	libfcache_cache_t *single_chunk_data_cache;
+
+	/* The (budgeted) chunk cache
+	 */
+	libewf_chunk_cache_t *chunk_cache;
 };
 
 int libewf_chunk_table_initialize(
@@ -126,6 +131,17 @@ int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
      libewf_chunk_group_t **chunk_group,
      libcerror_error_t **error );
 
+int libewf_chunk_table_get_chunk_group_chunk_data(
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunk_data_cache,
+     libewf_chunk_group_t *chunk_group,
+     int group_chunk_index,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
      libewf_chunk_table_t *chunk_table,
      libewf_io_handle_t *io_handle,
@@ -139,6 +155,27 @@ int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
      uint8_t read_flags,
      libcerror_error_t **error );
 
+int libewf_chunk_table_get_chunk_data_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_data_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_update_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     off64_t offset,
+     libewf_chunk_data_t *chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_chunk_data_by_offset(
      libewf_chunk_table_t *chunk_table,
      libewf_io_handle_t *io_handle,
@@ -0,0 +1,729 @@
+/*
+ * Compression context functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "libewf_compression.h"
+#include "libewf_compression_context.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+
+/* Creates a compression context
+ * The codec states are created on first use and reused by subsequent calls
+ * Make sure the value compression_context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_initialize(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_initialize";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_context = memory_allocate_structure(
+	                        libewf_compression_context_t );
+
+	if( *compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_context,
+	     0,
+	     sizeof( libewf_compression_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *compression_context != NULL )
+	{
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression context
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_free(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_free";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+		if( ( *compression_context )->deflate_stream != NULL )
+		{
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+			/* The return value is ignored since the stream is not finished on failure
+			 */
+			deflateEnd(
+			 (z_stream *) ( *compression_context )->deflate_stream );
+#endif
+			memory_free(
+			 ( *compression_context )->deflate_stream );
+		}
+		if( ( *compression_context )->inflate_stream != NULL )
+		{
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+			inflateEnd(
+			 (z_stream *) ( *compression_context )->inflate_stream );
+#endif
+			memory_free(
+			 ( *compression_context )->inflate_stream );
+		}
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( 1 );
+}
+
+/* Compresses data using the compression method
+ * Deflate compression reuses the deflate stream of the compression context, other methods
+ * are handled by libewf_compress_data
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compression_context_compress_data(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     uint16_t compression_method,
+     int8_t compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function         = "libewf_compression_context_compress_data";
+	int result                    = 0;
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	z_stream *deflate_stream      = NULL;
+	int zlib_compression_level    = 0;
+#endif
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	{
+		if( compressed_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid compressed data buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( compressed_data_size == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid compressed data size.",
+			 function );
+
+			return( -1 );
+		}
+		if( *compressed_data_size > (size_t) UINT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid compressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( uncompressed_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid uncompressed data buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( uncompressed_data_size > (size_t) UINT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid uncompressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( compressed_data == uncompressed_data )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid uncompressed data buffer equals compressed data buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( compression_level == LIBEWF_COMPRESSION_LEVEL_DEFAULT )
+		{
+			zlib_compression_level = Z_DEFAULT_COMPRESSION;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_LEVEL_FAST )
+		{
+			zlib_compression_level = Z_BEST_SPEED;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_LEVEL_BEST )
+		{
+			zlib_compression_level = Z_BEST_COMPRESSION;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_LEVEL_NONE )
+		{
+			zlib_compression_level = Z_NO_COMPRESSION;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported compression level.",
+			 function );
+
+			return( -1 );
+		}
+		deflate_stream = (z_stream *) compression_context->deflate_stream;
+
+		/* The deflate stream is set up for a specific compression level
+		 */
+		if( ( deflate_stream != NULL )
+		 && ( compression_context->deflate_stream_compression_level != compression_level ) )
+		{
+			deflateEnd(
+			 deflate_stream );
+
+			memory_free(
+			 deflate_stream );
+
+			compression_context->deflate_stream = NULL;
+			deflate_stream                      = NULL;
+		}
+		if( deflate_stream == NULL )
+		{
+			deflate_stream = memory_allocate_structure(
+			                  z_stream );
+
+			if( deflate_stream == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create deflate stream.",
+				 function );
+
+				return( -1 );
+			}
+			if( memory_set(
+			     deflate_stream,
+			     0,
+			     sizeof( z_stream ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear deflate stream.",
+				 function );
+
+				memory_free(
+				 deflate_stream );
+
+				return( -1 );
+			}
+			result = deflateInit(
+			          deflate_stream,
+			          zlib_compression_level );
+
+			if( result != Z_OK )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+				 "%s: unable to initialize deflate stream with error: %d.",
+				 function,
+				 result );
+
+				memory_free(
+				 deflate_stream );
+
+				return( -1 );
+			}
+			compression_context->deflate_stream                   = (intptr_t *) deflate_stream;
+			compression_context->deflate_stream_compression_level = compression_level;
+		}
+		else
+		{
+			result = deflateReset(
+			          deflate_stream );
+
+			if( result != Z_OK )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+				 "%s: unable to reset deflate stream with error: %d.",
+				 function,
+				 result );
+
+				return( -1 );
+			}
+		}
+		deflate_stream->next_in   = (Bytef *) uncompressed_data;
+		deflate_stream->avail_in  = (uInt) uncompressed_data_size;
+		deflate_stream->next_out  = (Bytef *) compressed_data;
+		deflate_stream->avail_out = (uInt) *compressed_data_size;
+
+		result = deflate(
+		          deflate_stream,
+		          Z_FINISH );
+
+		if( result == Z_STREAM_END )
+		{
+			*compressed_data_size = (size_t) deflate_stream->total_out;
+
+			result = 1;
+		}
+		else if( ( result == Z_OK )
+		      || ( result == Z_BUF_ERROR ) )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to write compressed data: target buffer too small.\n",
+				 function );
+			}
+#endif
+			/* The deflate stream is reset before its next use
+			 */
+			*compressed_data_size = (size_t) deflateBound(
+			                                  deflate_stream,
+			                                  (uLong) uncompressed_data_size );
+
+			result = 0;
+		}
+		else if( result == Z_MEM_ERROR )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to write compressed data: insufficient memory.",
+			 function );
+
+			*compressed_data_size = 0;
+
+			result = -1;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: zlib returned undefined error: %d.",
+			 function,
+			 result );
+
+			*compressed_data_size = 0;
+
+			result = -1;
+		}
+		return( result );
+	}
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+
+	result = libewf_compress_data(
+	          compressed_data,
+	          compressed_data_size,
+	          compression_method,
+	          compression_level,
+	          uncompressed_data,
+	          uncompressed_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress data.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Decompresses data using the compression method
+ * Deflate decompression reuses the inflate stream of the compression context, other methods
+ * are handled by libewf_decompress_data
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compression_context_decompress_data(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint16_t compression_method,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_compression_context_decompress_data";
+	int result               = 0;
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	z_stream *inflate_stream = NULL;
+#endif
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	{
+		if( compressed_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid compressed data buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( compressed_data_size > (size_t) UINT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid compressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( uncompressed_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid uncompressed data buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( uncompressed_data_size == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid uncompressed data size.",
+			 function );
+
+			return( -1 );
+		}
+		if( *uncompressed_data_size > (size_t) UINT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid uncompressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( uncompressed_data == compressed_data )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid compressed data buffer equals uncompressed data buffer.",
+			 function );
+
+			return( -1 );
+		}
+		inflate_stream = (z_stream *) compression_context->inflate_stream;
+
+		if( inflate_stream == NULL )
+		{
+			inflate_stream = memory_allocate_structure(
+			                  z_stream );
+
+			if( inflate_stream == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create inflate stream.",
+				 function );
+
+				return( -1 );
+			}
+			if( memory_set(
+			     inflate_stream,
+			     0,
+			     sizeof( z_stream ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear inflate stream.",
+				 function );
+
+				memory_free(
+				 inflate_stream );
+
+				return( -1 );
+			}
+			result = inflateInit(
+			          inflate_stream );
+
+			if( result != Z_OK )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+				 "%s: unable to initialize inflate stream with error: %d.",
+				 function,
+				 result );
+
+				memory_free(
+				 inflate_stream );
+
+				return( -1 );
+			}
+			compression_context->inflate_stream = (intptr_t *) inflate_stream;
+		}
+		else
+		{
+			result = inflateReset(
+			          inflate_stream );
+
+			if( result != Z_OK )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+				 "%s: unable to reset inflate stream with error: %d.",
+				 function,
+				 result );
+
+				return( -1 );
+			}
+		}
+		inflate_stream->next_in   = (Bytef *) compressed_data;
+		inflate_stream->avail_in  = (uInt) compressed_data_size;
+		inflate_stream->next_out  = (Bytef *) uncompressed_data;
+		inflate_stream->avail_out = (uInt) *uncompressed_data_size;
+
+		result = inflate(
+		          inflate_stream,
+		          Z_FINISH );
+
+		if( result == Z_STREAM_END )
+		{
+			*uncompressed_data_size = (size_t) inflate_stream->total_out;
+
+			result = 1;
+		}
+		/* Running out of input before the end of the stream is handled as a data error
+		 * like uncompress does
+		 */
+		else if( ( ( result == Z_OK )
+		        || ( result == Z_BUF_ERROR ) )
+		      && ( inflate_stream->avail_out == 0 ) )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				"%s: unable to read compressed data: target buffer too small.\n",
+				 function );
+			}
+#endif
+			/* Estimate that a factor 2 enlargement should suffice
+			 */
+			*uncompressed_data_size *= 2;
+
+			result = 0;
+		}
+		else if( result == Z_MEM_ERROR )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to read compressed data: insufficient memory.",
+			 function );
+
+			*uncompressed_data_size = 0;
+
+			result = -1;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to read compressed data: data error: %d.",
+			 function,
+			 result );
+
+			*uncompressed_data_size = 0;
+
+			result = -1;
+		}
+		return( result );
+	}
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+
+	result = libewf_decompress_data(
+	          compressed_data,
+	          compressed_data_size,
+	          compression_method,
+	          uncompressed_data,
+	          uncompressed_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to decompress data.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
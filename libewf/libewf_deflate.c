@@ -25,6 +25,7 @@
 #include <types.h>
 
 #include "libewf_bit_stream.h"
+#include "libewf_checksum.h"
 #include "libewf_deflate.h"
 #include "libewf_huffman_tree.h"
 #include "libewf_libcerror.h"
@@ -459,12 +460,49 @@ int libewf_deflate_decode_huffman(
 {
 	static char *function         = "libewf_deflate_decode_huffman";
 	size_t data_offset            = 0;
+	uint64_t value_64bit          = 0;
 	uint32_t extra_bits           = 0;
 	uint16_t compression_offset   = 0;
 	uint16_t compression_size     = 0;
+	uint16_t lookup_value         = 0;
 	uint16_t number_of_extra_bits = 0;
 	uint16_t symbol               = 0;
+	uint8_t code_size             = 0;
+	uint8_t number_of_bits        = 0;
 
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( literals_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid literals tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( distances_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid distances tree.",
+		 function );
+
+		return( -1 );
+	}
 	if( uncompressed_data == NULL )
 	{
 		libcerror_error_set(
@@ -502,11 +540,49 @@ int libewf_deflate_decode_huffman(
 
 	do
 	{
-		if( libewf_huffman_tree_get_symbol_from_bit_stream(
-		     literals_tree,
-		     bit_stream,
-		     &symbol,
-		     error ) != 1 )
+		/* A length and distance pair requires at most 48 bits, hence if the bit buffer
+		 * is refilled below 48 bits the codes that fit in the lookup tables and the extra
+		 * bits can be read from the bit buffer directly instead of by the more generic
+		 * bit stream and Huffman tree functions
+		 */
+		if( ( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+		 && ( bit_stream->bit_buffer_size < 48 )
+		 && ( ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) >= 8 ) )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
+			 value_64bit );
+
+			number_of_bits = ( 64 - bit_stream->bit_buffer_size ) & 0xf8;
+
+			bit_stream->bit_buffer     |= value_64bit << bit_stream->bit_buffer_size;
+			bit_stream->bit_buffer_size += number_of_bits;
+
+			bit_stream->byte_stream_offset += number_of_bits / 8;
+
+			if( bit_stream->bit_buffer_size < 64 )
+			{
+				bit_stream->bit_buffer &= ( (uint64_t) 1 << bit_stream->bit_buffer_size ) - 1;
+			}
+		}
+		lookup_value = literals_tree->lookup_table[ bit_stream->bit_buffer & ( ( 1 << LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_NUMBER_OF_BITS ) - 1 ) ];
+
+		code_size = (uint8_t) ( lookup_value & 0x000f );
+
+		if( ( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+		 && ( code_size != 0 )
+		 && ( code_size <= bit_stream->bit_buffer_size ) )
+		{
+			symbol = lookup_value >> 4;
+
+			bit_stream->bit_buffer     >>= code_size;
+			bit_stream->bit_buffer_size -= code_size;
+		}
+		else if( libewf_huffman_tree_get_symbol_from_bit_stream(
+		          literals_tree,
+		          bit_stream,
+		          &symbol,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -539,11 +615,19 @@ int libewf_deflate_decode_huffman(
 
 			number_of_extra_bits = libewf_deflate_literal_codes_number_of_extra_bits[ symbol ];
 
-			if( libewf_bit_stream_get_value(
-			     bit_stream,
-			     (uint8_t) number_of_extra_bits,
-			     &extra_bits,
-			     error ) != 1 )
+			if( ( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+			 && ( bit_stream->bit_buffer_size >= number_of_extra_bits ) )
+			{
+				extra_bits = (uint32_t) ( bit_stream->bit_buffer & ( ( (uint64_t) 1 << number_of_extra_bits ) - 1 ) );
+
+				bit_stream->bit_buffer     >>= number_of_extra_bits;
+				bit_stream->bit_buffer_size -= (uint8_t) number_of_extra_bits;
+			}
+			else if( libewf_bit_stream_get_value(
+			          bit_stream,
+			          (uint8_t) number_of_extra_bits,
+			          &extra_bits,
+			          error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -556,11 +640,24 @@ int libewf_deflate_decode_huffman(
 			}
 			compression_size = libewf_deflate_literal_codes_base[ symbol ] + (uint16_t) extra_bits;
 
-			if( libewf_huffman_tree_get_symbol_from_bit_stream(
-			     distances_tree,
-			     bit_stream,
-			     &symbol,
-			     error ) != 1 )
+			lookup_value = distances_tree->lookup_table[ bit_stream->bit_buffer & ( ( 1 << LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_NUMBER_OF_BITS ) - 1 ) ];
+
+			code_size = (uint8_t) ( lookup_value & 0x000f );
+
+			if( ( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+			 && ( code_size != 0 )
+			 && ( code_size <= bit_stream->bit_buffer_size ) )
+			{
+				symbol = lookup_value >> 4;
+
+				bit_stream->bit_buffer     >>= code_size;
+				bit_stream->bit_buffer_size -= code_size;
+			}
+			else if( libewf_huffman_tree_get_symbol_from_bit_stream(
+			          distances_tree,
+			          bit_stream,
+			          &symbol,
+			          error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -571,13 +668,33 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
+			if( symbol >= 30 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid distance code value: %" PRIu16 " out of bounds.",
+				 function,
+				 symbol );
+
+				return( -1 );
+			}
 			number_of_extra_bits = libewf_deflate_distance_codes_number_of_extra_bits[ symbol ];
 
-			if( libewf_bit_stream_get_value(
-			     bit_stream,
-			     (uint8_t) number_of_extra_bits,
-			     &extra_bits,
-			     error ) != 1 )
+			if( ( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+			 && ( bit_stream->bit_buffer_size >= number_of_extra_bits ) )
+			{
+				extra_bits = (uint32_t) ( bit_stream->bit_buffer & ( ( (uint64_t) 1 << number_of_extra_bits ) - 1 ) );
+
+				bit_stream->bit_buffer     >>= number_of_extra_bits;
+				bit_stream->bit_buffer_size -= (uint8_t) number_of_extra_bits;
+			}
+			else if( libewf_bit_stream_get_value(
+			          bit_stream,
+			          (uint8_t) number_of_extra_bits,
+			          &extra_bits,
+			          error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -612,6 +729,32 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
+			/* If the distance is at least 8 bytes the source and destination
+			 * of an 8-byte copy do not overlap hence copy 8 bytes at a time
+			 */
+			if( compression_offset == 1 )
+			{
+				memory_set(
+				 &( uncompressed_data[ data_offset ] ),
+				 uncompressed_data[ data_offset - 1 ],
+				 (size_t) compression_size );
+
+				data_offset     += compression_size;
+				compression_size = 0;
+			}
+			else if( compression_offset >= 8 )
+			{
+				while( compression_size >= 8 )
+				{
+					memory_copy(
+					 &( uncompressed_data[ data_offset ] ),
+					 &( uncompressed_data[ data_offset - compression_offset ] ),
+					 8 );
+
+					data_offset      += 8;
+					compression_size -= 8;
+				}
+			}
 			while( compression_size > 0 )
 			{
 				uncompressed_data[ data_offset ] = uncompressed_data[ data_offset - compression_offset ];
@@ -1221,6 +1364,13 @@ int libewf_deflate_read_block(
 
 				goto on_error;
 			}
+			/* Return the whole bytes remaining in the bit buffer to the byte stream
+			 * since the uncompressed data is copied from the byte stream
+			 */
+			bit_stream->byte_stream_offset -= bit_stream->bit_buffer_size / 8;
+			bit_stream->bit_buffer          = 0;
+			bit_stream->bit_buffer_size     = 0;
+
 			block_size_copy = ( block_size >> 16 ) ^ 0x0000ffffUL;
 			block_size     &= 0x0000ffffUL;
 
@@ -1280,11 +1430,6 @@ int libewf_deflate_read_block(
 			bit_stream->byte_stream_offset += block_size;
 			safe_uncompressed_data_offset  += block_size;
 
-			/* Flush the bit stream buffer
-			 */
-			bit_stream->bit_buffer      = 0;
-			bit_stream->bit_buffer_size = 0;
-
 			break;
 
 		case LIBEWF_DEFLATE_BLOCK_TYPE_HUFFMAN_FIXED:
@@ -1536,7 +1681,8 @@ int libewf_deflate_decompress(
 
 		goto on_error;
 	}
-	while( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	while( ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	    || ( bit_stream->bit_buffer_size >= 8 ) )
 	{
 		if( libewf_deflate_read_block_header(
 		     bit_stream,
@@ -1821,7 +1967,8 @@ int libewf_deflate_decompress_zlib(
 
 		goto on_error;
 	}
-	while( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	while( ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	    || ( bit_stream->bit_buffer_size >= 8 ) )
 	{
 		if( libewf_deflate_read_block_header(
 		     bit_stream,
@@ -1913,18 +2060,20 @@ int libewf_deflate_decompress_zlib(
 			break;
 		}
 	}
+	/* Return the whole bytes remaining in the bit buffer to the byte stream
+	 */
+	while( bit_stream->bit_buffer_size >= 8 )
+	{
+		bit_stream->byte_stream_offset -= 1;
+		bit_stream->bit_buffer_size    -= 8;
+	}
 	if( ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) >= 4 )
 	{
-		while( bit_stream->bit_buffer_size >= 8 )
-		{
-			bit_stream->byte_stream_offset -= 1;
-			bit_stream->bit_buffer_size    -= 8;
-		}
 		byte_stream_copy_to_uint32_big_endian(
 		 &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
 		 stored_checksum );
 
-		if( libewf_deflate_calculate_adler32(
+		if( libewf_checksum_calculate_adler32(
 		     &calculated_checksum,
 		     uncompressed_data,
 		     uncompressed_data_offset,
@@ -0,0 +1,2129 @@
+/*
+ * Direct file IO handle functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* O_DIRECT is only defined by glibc when _GNU_SOURCE is defined
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_definitions.h"
+#include "libewf_direct_file_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libclocale.h"
+#include "libewf_libuna.h"
+
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT )
+
+/* Creates a direct file IO handle
+ * Make sure the value file_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_initialize(
+     libewf_direct_file_io_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_initialize";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*file_io_handle = memory_allocate_structure(
+	                   libewf_direct_file_io_handle_t );
+
+	if( *file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_io_handle,
+	     0,
+	     sizeof( libewf_direct_file_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *file_io_handle )->descriptor    = -1;
+	( *file_io_handle )->buffer_size   = LIBEWF_DIRECT_FILE_IO_HANDLE_BUFFER_SIZE;
+	( *file_io_handle )->buffer_offset = -1;
+
+	return( 1 );
+
+on_error:
+	if( *file_io_handle != NULL )
+	{
+		memory_free(
+		 *file_io_handle );
+
+		*file_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a direct file handle
+ * Make sure the value handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_initialize(
+     libbfio_handle_t **handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	static char *function                          = "libewf_direct_file_initialize";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_direct_file_io_handle_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_direct_file_io_handle_set_name(
+	     file_io_handle,
+	     name,
+	     name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) file_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libewf_direct_file_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libewf_direct_file_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libewf_direct_file_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_direct_file_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libewf_direct_file_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libewf_direct_file_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libewf_direct_file_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_direct_file_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_direct_file_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libewf_direct_file_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libewf_direct_file_io_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Creates a direct file handle
+ * The name is converted to a narrow string using the system codepage
+ * Make sure the value handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_initialize_wide(
+     libbfio_handle_t **handle,
+     const wchar_t *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	char *narrow_name       = NULL;
+	static char *function   = "libewf_direct_file_initialize_wide";
+	size_t narrow_name_size = 0;
+	int result              = 0;
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf8_string_size_from_utf32(
+		          (libuna_utf32_character_t *) name,
+		          name_length + 1,
+		          &narrow_name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf8_string_size_from_utf16(
+		          (libuna_utf16_character_t *) name,
+		          name_length + 1,
+		          &narrow_name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_byte_stream_size_from_utf32(
+		          (libuna_utf32_character_t *) name,
+		          name_length + 1,
+		          libclocale_codepage,
+		          &narrow_name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_byte_stream_size_from_utf16(
+		          (libuna_utf16_character_t *) name,
+		          name_length + 1,
+		          libclocale_codepage,
+		          &narrow_name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine narrow name size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( narrow_name_size == 0 )
+	 || ( narrow_name_size > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( char ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid narrow name size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	narrow_name = narrow_string_allocate(
+	               narrow_name_size );
+
+	if( narrow_name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create narrow name.",
+		 function );
+
+		goto on_error;
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf8_string_copy_from_utf32(
+		          (libuna_utf8_character_t *) narrow_name,
+		          narrow_name_size,
+		          (libuna_utf32_character_t *) name,
+		          name_length + 1,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf8_string_copy_from_utf16(
+		          (libuna_utf8_character_t *) narrow_name,
+		          narrow_name_size,
+		          (libuna_utf16_character_t *) name,
+		          name_length + 1,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_byte_stream_copy_from_utf32(
+		          (uint8_t *) narrow_name,
+		          narrow_name_size,
+		          libclocale_codepage,
+		          (libuna_utf32_character_t *) name,
+		          name_length + 1,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_byte_stream_copy_from_utf16(
+		          (uint8_t *) narrow_name,
+		          narrow_name_size,
+		          libclocale_codepage,
+		          (libuna_utf16_character_t *) name,
+		          name_length + 1,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set narrow name.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_direct_file_initialize(
+	     handle,
+	     narrow_name,
+	     narrow_name_size - 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 narrow_name );
+
+	return( 1 );
+
+on_error:
+	if( narrow_name != NULL )
+	{
+		memory_free(
+		 narrow_name );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Frees a direct file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_free(
+     libewf_direct_file_io_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_free";
+	int result            = 1;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle != NULL )
+	{
+		if( ( *file_io_handle )->descriptor != -1 )
+		{
+			if( libewf_direct_file_io_handle_close(
+			     *file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *file_io_handle )->buffer_allocation != NULL )
+		{
+			memory_free(
+			 ( *file_io_handle )->buffer_allocation );
+		}
+		if( ( *file_io_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *file_io_handle )->name );
+		}
+		memory_free(
+		 *file_io_handle );
+
+		*file_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the direct file IO handle and its attributes
+ * The clone is not opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_clone(
+     libewf_direct_file_io_handle_t **destination_file_io_handle,
+     libewf_direct_file_io_handle_t *source_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_clone";
+
+	if( destination_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_file_io_handle == NULL )
+	{
+		*destination_file_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libewf_direct_file_io_handle_initialize(
+	     destination_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( source_file_io_handle->name != NULL )
+	{
+		if( libewf_direct_file_io_handle_set_name(
+		     *destination_file_io_handle,
+		     source_file_io_handle->name,
+		     source_file_io_handle->name_size - 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in destination file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *destination_file_io_handle )->buffer_size = source_file_io_handle->buffer_size;
+
+	return( 1 );
+
+on_error:
+	if( *destination_file_io_handle != NULL )
+	{
+		libewf_direct_file_io_handle_free(
+		 destination_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the name
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_set_name(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_set_name";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle - file already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name != NULL )
+	{
+		memory_free(
+		 file_io_handle->name );
+
+		file_io_handle->name      = NULL;
+		file_io_handle->name_size = 0;
+	}
+	file_io_handle->name = narrow_string_allocate(
+	                        name_length + 1 );
+
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     file_io_handle->name,
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		memory_free(
+		 file_io_handle->name );
+
+		file_io_handle->name = NULL;
+
+		return( -1 );
+	}
+	file_io_handle->name[ name_length ] = 0;
+
+	file_io_handle->name_size = name_length + 1;
+
+	return( 1 );
+}
+
+/* Opens the direct file IO handle
+ * Falls back to buffered IO if the file system does not support direct IO
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_open(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_open";
+	size_t alignment      = 0;
+	off64_t file_offset   = 0;
+	int file_io_flags     = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle - file already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & ( LIBBFIO_ACCESS_FLAG_READ | LIBBFIO_ACCESS_FLAG_WRITE ) ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_handle->buffer_size == 0 )
+	 || ( ( file_io_handle->buffer_size % LIBEWF_DIRECT_FILE_IO_HANDLE_ALIGNMENT ) != 0 )
+	 || ( file_io_handle->buffer_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - LIBEWF_DIRECT_FILE_IO_HANDLE_ALIGNMENT ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO handle - buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Partial blocks are read back before they are modified hence
+	 * the file is opened for reading when write access is requested
+	 */
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		file_io_flags = O_RDWR | O_CREAT;
+
+		if( ( access_flags & LIBBFIO_ACCESS_FLAG_TRUNCATE ) != 0 )
+		{
+			file_io_flags |= O_TRUNC;
+		}
+	}
+	else
+	{
+		file_io_flags = O_RDONLY;
+	}
+	file_io_handle->is_direct = 0;
+
+#if defined( O_DIRECT )
+	file_io_handle->descriptor = open(
+	                              file_io_handle->name,
+	                              file_io_flags | O_DIRECT,
+	                              0644 );
+
+	/* Not every file system supports direct IO
+	 */
+	if( file_io_handle->descriptor != -1 )
+	{
+		file_io_handle->is_direct = 1;
+	}
+	else if( errno == EINVAL )
+#endif
+	{
+		file_io_handle->descriptor = open(
+		                              file_io_handle->name,
+		                              file_io_flags,
+		                              0644 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 file_io_handle->name );
+
+		return( -1 );
+	}
+#if defined( F_NOCACHE )
+	if( file_io_handle->is_direct == 0 )
+	{
+		if( fcntl(
+		     file_io_handle->descriptor,
+		     F_NOCACHE,
+		     1 ) != -1 )
+		{
+			file_io_handle->is_direct = 1;
+		}
+	}
+#endif
+	file_offset = lseek(
+	               file_io_handle->descriptor,
+	               0,
+	               SEEK_END );
+
+	if( file_offset < 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 errno,
+		 "%s: unable to determine size of file: %s.",
+		 function,
+		 file_io_handle->name );
+
+		goto on_error;
+	}
+	if( file_io_handle->buffer_allocation == NULL )
+	{
+		alignment = LIBEWF_DIRECT_FILE_IO_HANDLE_ALIGNMENT;
+
+		file_io_handle->buffer_allocation = (uint8_t *) memory_allocate(
+		                                                 sizeof( uint8_t ) * ( file_io_handle->buffer_size + alignment ) );
+
+		if( file_io_handle->buffer_allocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			goto on_error;
+		}
+		file_io_handle->buffer = file_io_handle->buffer_allocation
+		                       + ( ( alignment - ( (intptr_t) file_io_handle->buffer_allocation % alignment ) ) % alignment );
+	}
+	file_io_handle->access_flags     = access_flags;
+	file_io_handle->file_size        = (size64_t) file_offset;
+	file_io_handle->current_offset   = 0;
+	file_io_handle->buffer_offset    = -1;
+	file_io_handle->buffer_data_size = 0;
+	file_io_handle->buffer_is_dirty  = 0;
+
+	return( 1 );
+
+on_error:
+	close(
+	 file_io_handle->descriptor );
+
+	file_io_handle->descriptor = -1;
+
+	return( -1 );
+}
+
+/* Closes the direct file IO handle
+ * Writes the buffered data and truncates the padding of the last block
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_close(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_close";
+	int result            = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_handle->access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		if( libewf_direct_file_io_handle_flush_buffer(
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush buffer.",
+			 function );
+
+			result = -1;
+		}
+		else if( ftruncate(
+		          file_io_handle->descriptor,
+		          (off_t) file_io_handle->file_size ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to truncate file: %s.",
+			 function,
+			 file_io_handle->name );
+
+			result = -1;
+		}
+	}
+	if( close(
+	     file_io_handle->descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file: %s.",
+		 function,
+		 file_io_handle->name );
+
+		result = -1;
+	}
+	file_io_handle->descriptor       = -1;
+	file_io_handle->access_flags     = 0;
+	file_io_handle->buffer_offset    = -1;
+	file_io_handle->buffer_data_size = 0;
+	file_io_handle->buffer_is_dirty  = 0;
+
+	/* The staging buffer is released so that closed handles in a pool do not hold on to memory
+	 */
+	if( file_io_handle->buffer_allocation != NULL )
+	{
+		memory_free(
+		 file_io_handle->buffer_allocation );
+
+		file_io_handle->buffer_allocation = NULL;
+		file_io_handle->buffer            = NULL;
+	}
+	return( result );
+}
+
+/* Writes the data in the staging buffer to the file
+ * The data is padded with zero bytes to the alignment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_flush_buffer(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_flush_buffer";
+	size_t buffer_index   = 0;
+	size_t write_size     = 0;
+	ssize_t write_count   = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->buffer_is_dirty == 0 )
+	{
+		return( 1 );
+	}
+	write_size = file_io_handle->buffer_data_size;
+
+	if( ( write_size % LIBEWF_DIRECT_FILE_IO_HANDLE_ALIGNMENT ) != 0 )
+	{
+		write_size += LIBEWF_DIRECT_FILE_IO_HANDLE_ALIGNMENT - ( write_size % LIBEWF_DIRECT_FILE_IO_HANDLE_ALIGNMENT );
+
+		if( memory_set(
+		     &( file_io_handle->buffer[ file_io_handle->buffer_data_size ] ),
+		     0,
+		     write_size - file_io_handle->buffer_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buffer padding.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( lseek(
+	     file_io_handle->descriptor,
+	     (off_t) file_io_handle->buffer_offset,
+	     SEEK_SET ) != (off_t) file_io_handle->buffer_offset )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 errno,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_io_handle->buffer_offset,
+		 file_io_handle->buffer_offset );
+
+		return( -1 );
+	}
+	while( buffer_index < write_size )
+	{
+		write_count = write(
+		               file_io_handle->descriptor,
+		               &( file_io_handle->buffer[ buffer_index ] ),
+		               write_size - buffer_index );
+
+		if( write_count <= 0 )
+		{
+			if( ( write_count == -1 )
+			 && ( errno == EINTR ) )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to write buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_io_handle->buffer_offset,
+			 file_io_handle->buffer_offset );
+
+			return( -1 );
+		}
+		buffer_index += (size_t) write_count;
+	}
+#if defined( HAVE_POSIX_FADVISE ) && defined( POSIX_FADV_DONTNEED )
+	/* Without direct IO at least ask the kernel not to keep the written data cached
+	 */
+	if( file_io_handle->is_direct == 0 )
+	{
+		posix_fadvise(
+		 file_io_handle->descriptor,
+		 (off_t) file_io_handle->buffer_offset,
+		 (off_t) write_size,
+		 POSIX_FADV_DONTNEED );
+	}
+#endif
+	file_io_handle->buffer_is_dirty = 0;
+
+	return( 1 );
+}
+
+/* Positions the staging buffer at the aligned block that contains the current offset
+ * Data already in the file is read into the buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_load_buffer(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_load_buffer";
+	size64_t data_size    = 0;
+	size_t buffer_index   = 0;
+	ssize_t read_count    = 0;
+	off64_t buffer_offset = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_direct_file_io_handle_flush_buffer(
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush buffer.",
+		 function );
+
+		return( -1 );
+	}
+	buffer_offset = file_io_handle->current_offset
+	              - ( file_io_handle->current_offset % LIBEWF_DIRECT_FILE_IO_HANDLE_ALIGNMENT );
+
+	file_io_handle->buffer_offset    = buffer_offset;
+	file_io_handle->buffer_data_size = 0;
+
+	if( (size64_t) buffer_offset >= file_io_handle->file_size )
+	{
+		return( 1 );
+	}
+	if( lseek(
+	     file_io_handle->descriptor,
+	     (off_t) buffer_offset,
+	     SEEK_SET ) != (off_t) buffer_offset )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 errno,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 buffer_offset,
+		 buffer_offset );
+
+		goto on_error;
+	}
+	data_size = file_io_handle->file_size - (size64_t) buffer_offset;
+
+	if( data_size > (size64_t) file_io_handle->buffer_size )
+	{
+		data_size = (size64_t) file_io_handle->buffer_size;
+	}
+	/* Direct IO reads must be a multiple of the alignment even at the end of the file
+	 */
+	while( buffer_index < (size_t) data_size )
+	{
+		read_count = read(
+		              file_io_handle->descriptor,
+		              &( file_io_handle->buffer[ buffer_index ] ),
+		              file_io_handle->buffer_size - buffer_index );
+
+		if( read_count == 0 )
+		{
+			break;
+		}
+		else if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 buffer_offset,
+			 buffer_offset );
+
+			goto on_error;
+		}
+		buffer_index += (size_t) read_count;
+	}
+	if( buffer_index > (size_t) data_size )
+	{
+		buffer_index = (size_t) data_size;
+	}
+	file_io_handle->buffer_data_size = buffer_index;
+
+	return( 1 );
+
+on_error:
+	file_io_handle->buffer_offset = -1;
+
+	return( -1 );
+}
+
+/* Reads a buffer from the direct file IO handle
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libewf_direct_file_io_handle_read(
+         libewf_direct_file_io_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_read";
+	size_t buffer_index   = 0;
+	size_t read_size      = 0;
+	size_t staging_index  = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_index < size )
+	{
+		if( (size64_t) file_io_handle->current_offset >= file_io_handle->file_size )
+		{
+			break;
+		}
+		if( ( file_io_handle->buffer_offset == -1 )
+		 || ( file_io_handle->current_offset < file_io_handle->buffer_offset )
+		 || ( file_io_handle->current_offset >= (off64_t) ( file_io_handle->buffer_offset + file_io_handle->buffer_data_size ) ) )
+		{
+			if( libewf_direct_file_io_handle_load_buffer(
+			     file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to load buffer.",
+				 function );
+
+				return( -1 );
+			}
+			if( file_io_handle->current_offset >= (off64_t) ( file_io_handle->buffer_offset + file_io_handle->buffer_data_size ) )
+			{
+				break;
+			}
+		}
+		staging_index = (size_t) ( file_io_handle->current_offset - file_io_handle->buffer_offset );
+		read_size     = file_io_handle->buffer_data_size - staging_index;
+
+		if( read_size > ( size - buffer_index ) )
+		{
+			read_size = size - buffer_index;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_index ] ),
+		     &( file_io_handle->buffer[ staging_index ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data from buffer.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_index                   += read_size;
+		file_io_handle->current_offset += (off64_t) read_size;
+	}
+	return( (ssize_t) buffer_index );
+}
+
+/* Writes a buffer to the direct file IO handle
+ * The data is written when the staging buffer is full, flushed or the handle is closed
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libewf_direct_file_io_handle_write(
+         libewf_direct_file_io_handle_t *file_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_write";
+	size_t buffer_index   = 0;
+	size_t staging_index  = 0;
+	size_t write_size     = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_handle->access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid file IO handle - file not opened for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_index < size )
+	{
+		/* The buffer can only be appended to when there is no gap between its data and the current offset
+		 */
+		if( ( file_io_handle->buffer_offset == -1 )
+		 || ( file_io_handle->current_offset < file_io_handle->buffer_offset )
+		 || ( file_io_handle->current_offset > (off64_t) ( file_io_handle->buffer_offset + file_io_handle->buffer_data_size ) )
+		 || ( file_io_handle->current_offset >= (off64_t) ( file_io_handle->buffer_offset + file_io_handle->buffer_size ) ) )
+		{
+			if( libewf_direct_file_io_handle_load_buffer(
+			     file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to load buffer.",
+				 function );
+
+				return( -1 );
+			}
+			staging_index = (size_t) ( file_io_handle->current_offset - file_io_handle->buffer_offset );
+
+			/* Writing beyond the end of the file fills the gap with zero bytes
+			 */
+			if( staging_index > file_io_handle->buffer_data_size )
+			{
+				if( memory_set(
+				     &( file_io_handle->buffer[ file_io_handle->buffer_data_size ] ),
+				     0,
+				     staging_index - file_io_handle->buffer_data_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear buffer.",
+					 function );
+
+					return( -1 );
+				}
+				file_io_handle->buffer_data_size = staging_index;
+			}
+		}
+		staging_index = (size_t) ( file_io_handle->current_offset - file_io_handle->buffer_offset );
+		write_size    = file_io_handle->buffer_size - staging_index;
+
+		if( write_size > ( size - buffer_index ) )
+		{
+			write_size = size - buffer_index;
+		}
+		if( memory_copy(
+		     &( file_io_handle->buffer[ staging_index ] ),
+		     &( buffer[ buffer_index ] ),
+		     write_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to buffer.",
+			 function );
+
+			return( -1 );
+		}
+		staging_index += write_size;
+
+		if( staging_index > file_io_handle->buffer_data_size )
+		{
+			file_io_handle->buffer_data_size = staging_index;
+		}
+		file_io_handle->buffer_is_dirty = 1;
+
+		buffer_index                   += write_size;
+		file_io_handle->current_offset += (off64_t) write_size;
+
+		if( (size64_t) file_io_handle->current_offset > file_io_handle->file_size )
+		{
+			file_io_handle->file_size = (size64_t) file_io_handle->current_offset;
+		}
+		/* Write the buffer once the end of the buffer has been reached
+		 */
+		if( staging_index == file_io_handle->buffer_size )
+		{
+			if( libewf_direct_file_io_handle_flush_buffer(
+			     file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( (ssize_t) buffer_index );
+}
+
+/* Seeks a certain offset within the direct file IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libewf_direct_file_io_handle_seek_offset(
+         libewf_direct_file_io_handle_t *file_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_seek_offset";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += file_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) file_io_handle->file_size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libewf_direct_file_io_handle_exists(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_exists";
+	int descriptor        = -1;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor != -1 )
+	{
+		return( 1 );
+	}
+	descriptor = open(
+	              file_io_handle->name,
+	              O_RDONLY );
+
+	if( descriptor == -1 )
+	{
+		if( errno == ENOENT )
+		{
+			return( 0 );
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 file_io_handle->name );
+
+		return( -1 );
+	}
+	close(
+	 descriptor );
+
+	return( 1 );
+}
+
+/* Check if the file is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libewf_direct_file_io_handle_is_open(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_is_open";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the file size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_get_size(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_get_size";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	*size = file_io_handle->file_size;
+
+	return( 1 );
+}
+
+/* Retrieves the name size of the direct file IO handle
+ * The name size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_get_name_size(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_get_name_size";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name size.",
+		 function );
+
+		return( -1 );
+	}
+	*name_size = file_io_handle->name_size;
+
+	return( 1 );
+}
+
+/* Retrieves the name of the direct file IO handle
+ * The name size should include the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_get_name(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     char *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_get_name";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_size < file_io_handle->name_size )
+	 || ( name_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     name,
+	     file_io_handle->name,
+	     file_io_handle->name_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the direct file IO handle of a direct file handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_get_io_handle(
+     libbfio_handle_t *handle,
+     libewf_direct_file_io_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_get_io_handle";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the name size of a direct file handle
+ * The name size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_get_name_size(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	static char *function                          = "libewf_direct_file_get_name_size";
+
+	if( libewf_direct_file_get_io_handle(
+	     handle,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_direct_file_io_handle_get_name_size(
+	     file_io_handle,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name size from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the name of a direct file handle
+ * The name size should include the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_get_name(
+     libbfio_handle_t *handle,
+     char *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	static char *function                          = "libewf_direct_file_get_name";
+
+	if( libewf_direct_file_get_io_handle(
+	     handle,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_direct_file_io_handle_get_name(
+	     file_io_handle,
+	     name,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Retrieves the wide name size of a direct file handle
+ * The name is converted from a narrow string using the system codepage
+ * The name size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_get_name_size_wide(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	static char *function                          = "libewf_direct_file_get_name_size_wide";
+	int result                                     = 0;
+
+	if( libewf_direct_file_get_io_handle(
+	     handle,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_size_from_utf8(
+		          (libuna_utf8_character_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_size_from_utf8(
+		          (libuna_utf8_character_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_size_from_byte_stream(
+		          (uint8_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          libclocale_codepage,
+		          name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_size_from_byte_stream(
+		          (uint8_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          libclocale_codepage,
+		          name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine name size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the wide name of a direct file handle
+ * The name is converted from a narrow string using the system codepage
+ * The name size should include the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_get_name_wide(
+     libbfio_handle_t *handle,
+     wchar_t *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	static char *function                          = "libewf_direct_file_get_name_wide";
+	int result                                     = 0;
+
+	if( libewf_direct_file_get_io_handle(
+	     handle,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_copy_from_utf8(
+		          (libuna_utf32_character_t *) name,
+		          name_size,
+		          (libuna_utf8_character_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_copy_from_utf8(
+		          (libuna_utf16_character_t *) name,
+		          name_size,
+		          (libuna_utf8_character_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_copy_from_byte_stream(
+		          (libuna_utf32_character_t *) name,
+		          name_size,
+		          (uint8_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          libclocale_codepage,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_copy_from_byte_stream(
+		          (libuna_utf16_character_t *) name,
+		          name_size,
+		          (uint8_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          libclocale_codepage,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set name.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+#endif /* defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT ) */
+
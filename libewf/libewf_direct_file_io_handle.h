@@ -0,0 +1,230 @@
+/*
+ * Direct file IO handle functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_DIRECT_FILE_IO_HANDLE_H )
+#define _LIBEWF_DIRECT_FILE_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( WINAPI ) && defined( HAVE_OPEN ) && defined( HAVE_CLOSE ) && defined( HAVE_LSEEK ) && defined( HAVE_READ ) && defined( HAVE_WRITE ) && defined( HAVE_FTRUNCATE )
+#define HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT
+#endif
+
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT )
+
+typedef struct libewf_direct_file_io_handle libewf_direct_file_io_handle_t;
+
+struct libewf_direct_file_io_handle
+{
+	/* The name
+	 */
+	char *name;
+
+	/* The name size
+	 */
+	size_t name_size;
+
+	/* The file descriptor
+	 */
+	int descriptor;
+
+	/* The access flags
+	 */
+	int access_flags;
+
+	/* Value to indicate the file was opened for direct IO
+	 */
+	uint8_t is_direct;
+
+	/* The (logical) file size
+	 */
+	size64_t file_size;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The staging buffer allocation
+	 */
+	uint8_t *buffer_allocation;
+
+	/* The staging buffer, aligned within the allocation
+	 */
+	uint8_t *buffer;
+
+	/* The staging buffer size
+	 */
+	size_t buffer_size;
+
+	/* The file offset of the staging buffer or -1 if not set
+	 */
+	off64_t buffer_offset;
+
+	/* The size of the data in the staging buffer
+	 */
+	size_t buffer_data_size;
+
+	/* Value to indicate the staging buffer contains data that was not written
+	 */
+	uint8_t buffer_is_dirty;
+};
+
+int libewf_direct_file_io_handle_initialize(
+     libewf_direct_file_io_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_file_initialize(
+     libbfio_handle_t **handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libewf_direct_file_initialize_wide(
+     libbfio_handle_t **handle,
+     const wchar_t *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libewf_direct_file_io_handle_free(
+     libewf_direct_file_io_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_clone(
+     libewf_direct_file_io_handle_t **destination_file_io_handle,
+     libewf_direct_file_io_handle_t *source_file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_set_name(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_open(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_close(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_flush_buffer(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_load_buffer(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+ssize_t libewf_direct_file_io_handle_read(
+         libewf_direct_file_io_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libewf_direct_file_io_handle_write(
+         libewf_direct_file_io_handle_t *file_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libewf_direct_file_io_handle_seek_offset(
+         libewf_direct_file_io_handle_t *file_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_exists(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_is_open(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_get_size(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_get_name_size(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_get_name(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     char *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+int libewf_direct_file_get_io_handle(
+     libbfio_handle_t *handle,
+     libewf_direct_file_io_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_file_get_name_size(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+int libewf_direct_file_get_name(
+     libbfio_handle_t *handle,
+     char *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libewf_direct_file_get_name_size_wide(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+int libewf_direct_file_get_name_wide(
+     libbfio_handle_t *handle,
+     wchar_t *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+#endif /* defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_DIRECT_FILE_IO_HANDLE_H ) */
+
@@ -0,0 +1,288 @@
+/*
+ * File allocation functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* fallocate and FALLOC_FL_KEEP_SIZE are only defined by glibc when _GNU_SOURCE is defined
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_file_allocation.h"
+#include "libewf_libcerror.h"
+#include "libewf_unused.h"
+
+/* Space is allocated without changing the file size, so that the file can be
+ * written as before and the allocated space that was not used can be released
+ * by truncating the file to its size
+ */
+#if !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) && defined( HAVE_OPEN ) && defined( HAVE_CLOSE ) && defined( HAVE_LSEEK ) && defined( HAVE_FTRUNCATE )
+#if ( defined( HAVE_FALLOCATE ) && defined( FALLOC_FL_KEEP_SIZE ) ) || defined( F_PREALLOCATE )
+#define HAVE_LIBEWF_FILE_ALLOCATION_SUPPORT
+#endif
+#endif
+
+/* Preallocates space for a file
+ * The file must exist and the file size is not changed
+ * Returns 1 if successful, 0 if space could not be preallocated or -1 on error
+ */
+int libewf_file_allocation_preallocate(
+     const system_character_t *filename,
+     size64_t allocation_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_allocation_preallocate";
+
+#if defined( HAVE_LIBEWF_FILE_ALLOCATION_SUPPORT )
+#if !defined( HAVE_FALLOCATE ) || !defined( FALLOC_FL_KEEP_SIZE )
+	fstore_t file_store;
+#endif
+
+	int file_descriptor   = -1;
+	int result            = 0;
+#endif
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid allocation size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_FILE_ALLOCATION_SUPPORT )
+	if( allocation_size == 0 )
+	{
+		return( 0 );
+	}
+	file_descriptor = open(
+	                   filename,
+	                   O_WRONLY );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	/* Preallocation is a hint, if the file system does not support it
+	 * or has insufficient free space the file is extended while it is written
+	 */
+#if defined( HAVE_FALLOCATE ) && defined( FALLOC_FL_KEEP_SIZE )
+	if( fallocate(
+	     file_descriptor,
+	     FALLOC_FL_KEEP_SIZE,
+	     0,
+	     (off_t) allocation_size ) == 0 )
+	{
+		result = 1;
+	}
+#else
+	file_store.fst_flags      = F_ALLOCATECONTIG | F_ALLOCATEALL;
+	file_store.fst_posmode    = F_PEOFPOSMODE;
+	file_store.fst_offset     = 0;
+	file_store.fst_length     = (off_t) allocation_size;
+	file_store.fst_bytesalloc = 0;
+
+	if( fcntl(
+	     file_descriptor,
+	     F_PREALLOCATE,
+	     &file_store ) != -1 )
+	{
+		result = 1;
+	}
+	else
+	{
+		/* Retry without requiring the space to be contiguous
+		 */
+		file_store.fst_flags = F_ALLOCATEALL;
+
+		if( fcntl(
+		     file_descriptor,
+		     F_PREALLOCATE,
+		     &file_store ) != -1 )
+		{
+			result = 1;
+		}
+	}
+#endif
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	return( result );
+#else
+	LIBEWF_UNREFERENCED_PARAMETER( allocation_size )
+
+	return( 0 );
+#endif
+}
+
+/* Releases the space allocated beyond the end of a file
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int libewf_file_allocation_release_unused(
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_allocation_release_unused";
+
+#if defined( HAVE_LIBEWF_FILE_ALLOCATION_SUPPORT )
+	off_t file_size       = 0;
+	int file_descriptor   = -1;
+#endif
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_FILE_ALLOCATION_SUPPORT )
+	file_descriptor = open(
+	                   filename,
+	                   O_WRONLY );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	file_size = lseek(
+	             file_descriptor,
+	             0,
+	             SEEK_END );
+
+	if( file_size < 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 errno,
+		 "%s: unable to determine size of file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	/* Truncating a file to its own size frees the blocks allocated beyond the end of the file
+	 */
+	if( ftruncate(
+	     file_descriptor,
+	     file_size ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 errno,
+		 "%s: unable to truncate file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	close(
+	 file_descriptor );
+
+	return( -1 );
+#else
+	return( 0 );
+#endif
+}
+
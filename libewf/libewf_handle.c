@@ -28,6 +28,7 @@
 #include "libewf_analytical_data.h"
 #include "libewf_case_data.h"
 #include "libewf_case_data_section.h"
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_table.h"
 #include "libewf_codepage.h"
@@ -37,14 +38,17 @@
 #include "libewf_definitions.h"
 #include "libewf_device_information.h"
 #include "libewf_device_information_section.h"
+#include "libewf_direct_file_io_handle.h"
 #include "libewf_digest_section.h"
 #include "libewf_error2_section.h"
 #include "libewf_file_entry.h"
 #include "libewf_handle.h"
 #include "libewf_hash_sections.h"
 #include "libewf_hash_values.h"
+#include "libewf_index_file.h"
 #include "libewf_header_sections.h"
 #include "libewf_header_values.h"
+#include "libewf_integrity_hash.h"
 #include "libewf_io_handle.h"
 #include "libewf_lef_file_entry.h"
 #include "libewf_libbfio.h"
@@ -63,6 +67,8 @@
 #include "libewf_sector_range.h"
 #include "libewf_sector_range_list.h"
 #include "libewf_segment_file.h"
+#include "libewf_segment_scanner.h"
+#include "libewf_segment_writer.h"
 #include "libewf_session_section.h"
 #include "libewf_sha1_hash_section.h"
 #include "libewf_single_file_tree.h"
@@ -71,6 +77,7 @@
 #include "libewf_unused.h"
 #include "libewf_value_table.h"
 #include "libewf_write_io_handle.h"
+#include "libewf_write_pipeline.h"
 
 #include "ewf_data.h"
 #include "ewf_file_header.h"
@@ -235,9 +242,24 @@ int libewf_handle_initialize(
 
 		goto on_error;
 	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_handle->chunk_table_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
 #endif
 	internal_handle->date_format                    = LIBEWF_DATE_FORMAT_CTIME;
 	internal_handle->maximum_number_of_open_handles = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	internal_handle->read_ahead_depth               = LIBEWF_READ_AHEAD_DEFAULT_DEPTH;
+	internal_handle->chunk_cache_budget             = LIBEWF_CHUNK_CACHE_DEFAULT_BUDGET;
 
 	*handle = (libewf_handle_t *) internal_handle;
 
@@ -246,6 +268,20 @@ int libewf_handle_initialize(
 on_error:
 	if( internal_handle != NULL )
 	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_handle->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_handle->read_write_lock ),
+			 NULL );
+		}
+#endif
+		if( internal_handle->segment_table != NULL )
+		{
+			libewf_segment_table_free(
+			 &( internal_handle->segment_table ),
+			 NULL );
+		}
 		if( internal_handle->acquiry_errors != NULL )
 		{
 			libcdata_range_list_free(
@@ -294,6 +330,7 @@ int libewf_handle_free(
 {
 	libewf_internal_handle_t *internal_handle = NULL;
 	static char *function                     = "libewf_internal_handle_free";
+	uint8_t free_pending                      = 0;
 	int result                                = 1;
 
 	if( handle == NULL )
@@ -311,6 +348,53 @@ int libewf_handle_free(
 	{
 		internal_handle = (libewf_internal_handle_t *) *handle;
 
+		if( internal_handle->parent_handle == NULL )
+		{
+			/* The handle is freed by the last reader handle that shares its image state
+			 */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			if( libcthreads_mutex_grab(
+			     internal_handle->chunk_table_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab chunk table mutex.",
+				 function );
+
+				return( -1 );
+			}
+#endif
+			if( internal_handle->number_of_reader_handles > 0 )
+			{
+				internal_handle->free_pending = 1;
+
+				free_pending = 1;
+			}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			if( libcthreads_mutex_release(
+			     internal_handle->chunk_table_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release chunk table mutex.",
+				 function );
+
+				return( -1 );
+			}
+#endif
+			if( free_pending != 0 )
+			{
+				*handle = NULL;
+
+				return( 1 );
+			}
+		}
 		if( internal_handle->file_io_pool != NULL )
 		{
 			if( libewf_handle_close(
@@ -343,6 +427,19 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( libcthreads_mutex_free(
+		     &( internal_handle->chunk_table_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk table mutex.",
+			 function );
+
+			result = -1;
+		}
 #endif
 		if( libewf_segment_table_free(
 		     &( internal_handle->segment_table ),
@@ -357,6 +454,22 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( internal_handle->index_file != NULL )
+		{
+			if( libewf_index_file_free(
+			     &( internal_handle->index_file ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free index file.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libcdata_range_list_free(
 		     &( internal_handle->acquiry_errors ),
 		     NULL,
@@ -735,8 +848,14 @@ int libewf_handle_clone(
 		}
 		internal_destination_handle->hash_values_parsed = internal_source_handle->hash_values_parsed;
 	}
-	internal_destination_handle->maximum_number_of_open_handles = internal_source_handle->maximum_number_of_open_handles;
-	internal_destination_handle->date_format                    = internal_source_handle->date_format;
+	internal_destination_handle->maximum_number_of_open_handles   = internal_source_handle->maximum_number_of_open_handles;
+	internal_destination_handle->read_ahead_depth                 = internal_source_handle->read_ahead_depth;
+	internal_destination_handle->read_ahead_number_of_threads     = internal_source_handle->read_ahead_number_of_threads;
+	internal_destination_handle->segment_scan_number_of_threads   = internal_source_handle->segment_scan_number_of_threads;
+	internal_destination_handle->write_pipeline_number_of_threads = internal_source_handle->write_pipeline_number_of_threads;
+	internal_destination_handle->segment_writer_buffer_size       = internal_source_handle->segment_writer_buffer_size;
+	internal_destination_handle->chunk_cache_budget               = internal_source_handle->chunk_cache_budget;
+	internal_destination_handle->date_format                      = internal_source_handle->date_format;
 
 	*destination_handle = (libewf_handle_t *) internal_destination_handle;
 
@@ -832,373 +951,259 @@ on_error:
 	return( -1 );
 }
 
-/* Signals the handle to abort its current activity
+/* Creates a reader handle that shares the image state of an opened handle
+ * The reader handle has its own current offset but shares the segment files,
+ * the chunk table, the chunk cache and the metadata of the source handle
+ * Functions that change the shared image state cannot be used on a reader handle
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_signal_abort(
-     libewf_handle_t *handle,
+int libewf_handle_clone_reader(
+     libewf_handle_t **destination_handle,
+     libewf_handle_t *source_handle,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_signal_abort";
+	libewf_internal_handle_t *internal_destination_handle = NULL;
+	libewf_internal_handle_t *parent_handle               = NULL;
+	static char *function                                 = "libewf_handle_clone_reader";
 
-	if( handle == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	uint8_t parent_handle_locked                          = 0;
+#endif
+
+	if( destination_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid destination handle.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->io_handle == NULL )
+	if( *destination_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination handle value already set.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->io_handle->abort = 1;
-
-	return( 1 );
-}
-
-/* Opens a set of EWF file(s)
- * For reading files should contain all filenames that make up an EWF image
- * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
- * Returns 1 if successful or -1 on error
- */
-int libewf_handle_open(
-     libewf_handle_t *handle,
-     char * const filenames[],
-     int number_of_filenames,
-     int access_flags,
-     libcerror_error_t **error )
-{
-	libbfio_handle_t *file_io_handle          = NULL;
-	libbfio_pool_t *file_io_pool              = NULL;
-	libewf_internal_handle_t *internal_handle = NULL;
-	char *first_segment_filename              = NULL;
-	static char *function                     = "libewf_handle_open";
-	size_t filename_length                    = 0;
-	int file_io_pool_entry                    = 0;
-	int filename_index                        = 0;
-	int maximum_number_of_open_handles        = 0;
-	int result                                = 0;
-
-	if( handle == NULL )
+	if( source_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid source handle.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	/* A reader handle of a reader handle shares the image state of the same parent handle
+	 */
+	parent_handle = ( (libewf_internal_handle_t *) source_handle )->parent_handle;
 
-	if( filenames == NULL )
+	if( parent_handle == NULL )
+	{
+		parent_handle = (libewf_internal_handle_t *) source_handle;
+	}
+	if( parent_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid filenames.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid source handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_filenames <= 0 )
+	internal_destination_handle = memory_allocate_structure(
+	                               libewf_internal_handle_t );
+
+	if( internal_destination_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
-		 "%s: invalid number of files zero or less.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if !defined( HAVE_WRITE_SUPPORT )
-	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	if( memory_set(
+	     internal_destination_handle,
+	     0,
+	     sizeof( libewf_internal_handle_t ) ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported - compiled without zlib.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear destination handle.",
 		 function );
 
+		memory_free(
+		 internal_destination_handle );
+
 		return( -1 );
 	}
-#endif
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_destination_handle->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     parent_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
+	parent_handle_locked = 1;
 #endif
-	maximum_number_of_open_handles = internal_handle->maximum_number_of_open_handles;
+	if( parent_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid source handle - missing file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_handle->read_io_handle == NULL )
+	 || ( ( parent_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
+		 function );
+
+		goto on_error;
+	}
+	/* The hash values are parsed on demand, make sure this does not
+	 * happen after the image state is shared
+	 */
+	if( parent_handle->hash_values_parsed == 0 )
+	{
+		if( libewf_internal_handle_parse_hash_values(
+		     parent_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to parse hash values.",
+			 function );
+
+			goto on_error;
+		}
+		parent_handle->hash_values_parsed = 1;
+	}
+	/* The reader handle has its own read IO handle, this also prevents
+	 * the shared media values from being changed by the reader handle
+	 */
+	if( libewf_read_io_handle_clone(
+	     &( internal_destination_handle->read_io_handle ),
+	     parent_handle->read_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination read IO handle.",
+		 function );
 
+		goto on_error;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
+	if( libcthreads_mutex_grab(
+	     parent_handle->chunk_table_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to grab chunk table mutex.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	if( libbfio_pool_initialize(
-	     &file_io_pool,
-	     0,
-	     maximum_number_of_open_handles,
+	parent_handle->number_of_reader_handles += 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     parent_handle->chunk_table_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
 		 function );
 
+		parent_handle->number_of_reader_handles -= 1;
+
 		goto on_error;
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
-	{
-		for( filename_index = 0;
-		     filename_index < number_of_filenames;
-		     filename_index++ )
-		{
-			filename_length = narrow_string_length(
-					   filenames[ filename_index ] );
+	internal_destination_handle->chunk_table_mutex = parent_handle->chunk_table_mutex;
+#endif
+	internal_destination_handle->parent_handle                  = parent_handle;
+	internal_destination_handle->io_handle                      = parent_handle->io_handle;
+	internal_destination_handle->media_values                   = parent_handle->media_values;
+	internal_destination_handle->sessions                       = parent_handle->sessions;
+	internal_destination_handle->tracks                         = parent_handle->tracks;
+	internal_destination_handle->acquiry_errors                 = parent_handle->acquiry_errors;
+	internal_destination_handle->file_io_pool                   = parent_handle->file_io_pool;
+	internal_destination_handle->segment_table                  = parent_handle->segment_table;
+	internal_destination_handle->chunk_table                    = parent_handle->chunk_table;
+	internal_destination_handle->hash_sections                  = parent_handle->hash_sections;
+	internal_destination_handle->header_values                  = parent_handle->header_values;
+	internal_destination_handle->header_values_parsed           = parent_handle->header_values_parsed;
+	internal_destination_handle->hash_values                    = parent_handle->hash_values;
+	internal_destination_handle->hash_values_parsed             = parent_handle->hash_values_parsed;
+	internal_destination_handle->single_files                   = parent_handle->single_files;
+	internal_destination_handle->maximum_number_of_open_handles = parent_handle->maximum_number_of_open_handles;
+	internal_destination_handle->read_ahead_depth               = parent_handle->read_ahead_depth;
+	internal_destination_handle->read_ahead_number_of_threads   = parent_handle->read_ahead_number_of_threads;
+	internal_destination_handle->segment_scan_number_of_threads = parent_handle->segment_scan_number_of_threads;
+	internal_destination_handle->chunk_cache_budget             = parent_handle->chunk_cache_budget;
+	internal_destination_handle->date_format                    = parent_handle->date_format;
 
-			/* Make sure there is more to the filename than the extension
-			 */
-			if( filename_length <= 4 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-				 "%s: filename: %s is too small.",
-				 function,
-				 filenames[ filename_index ] );
-
-				goto on_error;
-			}
-			if( libbfio_file_initialize(
-			     &file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create file IO handle.",
-				 function );
-
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libbfio_handle_set_track_offsets_read(
-			     file_io_handle,
-			     1,
-			     error ) != 1 )
-			{
-		                libcerror_error_set(
-		                 error,
-		                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		                 "%s: unable to set track offsets read in file IO handle.",
-		                 function );
-
-				goto on_error;
-			}
-#endif
-			if( libbfio_file_set_name(
-			     file_io_handle,
-			     filenames[ filename_index ],
-			     filename_length,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set name in file IO handle.",
-				 function );
-
-				goto on_error;
-			}
-			if( libbfio_pool_append_handle(
-			     file_io_pool,
-			     &file_io_pool_entry,
-			     file_io_handle,
-			     LIBBFIO_OPEN_READ,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append file IO handle to pool.",
-				 function );
-
-				goto on_error;
-			}
-			file_io_handle = NULL;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: added file IO pool entry: %d with filename: %s.\n",
-				 function,
-				 file_io_pool_entry,
-				 filenames[ filename_index ] );
-			}
-#endif
-			if( ( filenames[ filename_index ][ filename_length - 3 ] == 'e' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'E' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'l' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'L' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 's' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'S' ) )
-			{
-				if( ( filenames[ filename_index ][ filename_length - 2 ] == '0' )
-				 && ( filenames[ filename_index ][ filename_length - 1 ] == '1' ) )
-				{
-					first_segment_filename = filenames[ filename_index ];
-				}
-			}
-		}
-	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
-	{
-		/* Get the basename of the first segment file
-		 */
-		if( first_segment_filename != NULL )
-		{
-			filename_length = narrow_string_length(
-					   first_segment_filename );
-
-			/* Set segment table basename
-			 */
-			if( libewf_segment_table_set_basename(
-			     internal_handle->segment_table,
-			     first_segment_filename,
-			     filename_length - 4,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set basename in segment table.",
-				 function );
-
-				goto on_error;
-			}
-		}
-	}
-	else if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
-	{
-		/* Get the basename and store it in the segment tables
-		 */
-		filename_length = narrow_string_length(
-				   filenames[ 0 ] );
-
-		/* Set segment table basename
-		 */
-		if( libewf_segment_table_set_basename(
-		     internal_handle->segment_table,
-		     filenames[ 0 ],
-		     filename_length,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set basename in segment table.",
-			 function );
-
-			goto on_error;
-		}
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
-
-		goto on_error;
-	}
-#endif
-	result = libewf_internal_handle_open_file_io_pool(
-	          internal_handle,
-	          file_io_pool,
-	          access_flags,
-	          internal_handle->segment_table,
-	          error );
-
-	if( result != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open handle using a file IO pool.",
-		 function );
-
-		libbfio_pool_free(
-		 &file_io_pool,
-		 NULL );
+	parent_handle_locked = 0;
 
-		result = -1;
-	}
-	else
-	{
-		internal_handle->file_io_pool                    = file_io_pool;
-		internal_handle->file_io_pool_created_in_library = 1;
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
+	     parent_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -1208,58 +1213,57 @@ int libewf_handle_open(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		result = -1;
+		libewf_handle_free(
+		 (libewf_handle_t **) &internal_destination_handle,
+		 NULL );
+
+		return( -1 );
 	}
 #endif
-	if( result != 1 )
-	{
-		goto on_error;
-	}
+	*destination_handle = (libewf_handle_t *) internal_destination_handle;
+
 	return( 1 );
 
 on_error:
-	if( file_io_handle != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( parent_handle_locked != 0 )
 	{
-		libbfio_handle_free(
-		 &file_io_handle,
+		libcthreads_read_write_lock_release_for_write(
+		 parent_handle->read_write_lock,
 		 NULL );
 	}
-	if( file_io_pool != NULL )
+#endif
+	if( internal_destination_handle != NULL )
 	{
-		libbfio_pool_free(
-		 &file_io_pool,
-		 NULL );
+		if( internal_destination_handle->read_io_handle != NULL )
+		{
+			libewf_read_io_handle_free(
+			 &( internal_destination_handle->read_io_handle ),
+			 NULL );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_destination_handle->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_destination_handle->read_write_lock ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 internal_destination_handle );
 	}
-	internal_handle->file_io_pool                    = NULL;
-	internal_handle->file_io_pool_created_in_library = 0;
-
 	return( -1 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Opens a set of EWF file(s)
- * For reading files should contain all filenames that make up an EWF image
- * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
+/* Signals the handle to abort its current activity
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_open_wide(
+int libewf_handle_signal_abort(
      libewf_handle_t *handle,
-     wchar_t * const filenames[],
-     int number_of_filenames,
-     int access_flags,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle          = NULL;
-	libbfio_pool_t *file_io_pool              = NULL;
 	libewf_internal_handle_t *internal_handle = NULL;
-	wchar_t *first_segment_filename           = NULL;
-	static char *function                     = "libewf_handle_open_wide";
-	size_t filename_length                    = 0;
-	int file_io_pool_entry                    = 0;
-	int filename_index                        = 0;
-	int maximum_number_of_open_handles        = 0;
-	int result                                = 0;
+	static char *function                     = "libewf_handle_signal_abort";
 
 	if( handle == NULL )
 	{
@@ -1274,13 +1278,66 @@ int libewf_handle_open_wide(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( filenames == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid filenames.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->io_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Opens a set of EWF file(s)
+ * For reading files should contain all filenames that make up an EWF image
+ * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open(
+     libewf_handle_t *handle,
+     char * const filenames[],
+     int number_of_filenames,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle          = NULL;
+	libbfio_pool_t *file_io_pool              = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	char *first_segment_filename              = NULL;
+	static char *function                     = "libewf_handle_open";
+	size_t filename_length                    = 0;
+	int file_io_pool_entry                    = 0;
+	int filename_index                        = 0;
+	int maximum_number_of_open_handles        = 0;
+	int result                                = 0;
+	uint8_t use_direct_io                     = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
 		 function );
 
 		return( -1 );
@@ -1325,6 +1382,7 @@ int libewf_handle_open_wide(
 	}
 #endif
 	maximum_number_of_open_handles = internal_handle->maximum_number_of_open_handles;
+	use_direct_io                  = internal_handle->io_handle->use_direct_io;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -1340,6 +1398,16 @@ int libewf_handle_open_wide(
 
 		return( -1 );
 	}
+#endif
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT )
+	/* Every open direct file IO handle has its own staging buffer
+	 */
+	if( ( use_direct_io != 0 )
+	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 )
+	 && ( maximum_number_of_open_handles == LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES ) )
+	{
+		maximum_number_of_open_handles = LIBEWF_DIRECT_FILE_IO_HANDLE_MAXIMUM_NUMBER_OF_OPEN_HANDLES;
+	}
 #endif
 	if( libbfio_pool_initialize(
 	     &file_io_pool,
@@ -1363,7 +1431,7 @@ int libewf_handle_open_wide(
 		     filename_index < number_of_filenames;
 		     filename_index++ )
 		{
-			filename_length = wide_string_length(
+			filename_length = narrow_string_length(
 					   filenames[ filename_index ] );
 
 			/* Make sure there is more to the filename than the extension
@@ -1374,24 +1442,62 @@ int libewf_handle_open_wide(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-				 "%s: filename: %ls is too small.",
+				 "%s: filename: %s is too small.",
 				 function,
 				 filenames[ filename_index ] );
 
 				goto on_error;
 			}
-			if( libbfio_file_initialize(
-			     &file_io_handle,
-			     error ) != 1 )
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT )
+			if( use_direct_io != 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create file IO handle.",
-				 function );
+				if( libewf_direct_file_initialize(
+				     &file_io_handle,
+				     filenames[ filename_index ],
+				     filename_length,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create direct file IO handle.",
+					 function );
 
-				goto on_error;
+					goto on_error;
+				}
+			}
+			else
+#endif
+			{
+				if( libbfio_file_initialize(
+				     &file_io_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create file IO handle.",
+					 function );
+
+					goto on_error;
+				}
+				if( libbfio_file_set_name(
+				     file_io_handle,
+				     filenames[ filename_index ],
+				     filename_length,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set name in file IO handle.",
+					 function );
+
+					goto on_error;
+				}
 			}
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libbfio_handle_set_track_offsets_read(
@@ -1409,21 +1515,6 @@ int libewf_handle_open_wide(
 				goto on_error;
 			}
 #endif
-			if( libbfio_file_set_name_wide(
-			     file_io_handle,
-			     filenames[ filename_index ],
-			     filename_length,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set name in file IO handle.",
-				 function );
-
-				goto on_error;
-			}
 			if( libbfio_pool_append_handle(
 			     file_io_pool,
 			     &file_io_pool_entry,
@@ -1446,7 +1537,7 @@ int libewf_handle_open_wide(
 			if( libcnotify_verbose != 0 )
 			{
 				libcnotify_printf(
-				 "%s: added file IO pool entry: %d with filename: %ls.\n",
+				 "%s: added file IO pool entry: %d with filename: %s.\n",
 				 function,
 				 file_io_pool_entry,
 				 filenames[ filename_index ] );
@@ -1474,12 +1565,12 @@ int libewf_handle_open_wide(
 		 */
 		if( first_segment_filename != NULL )
 		{
-			filename_length = wide_string_length(
+			filename_length = narrow_string_length(
 					   first_segment_filename );
 
 			/* Set segment table basename
 			 */
-			if( libewf_segment_table_set_basename_wide(
+			if( libewf_segment_table_set_basename(
 			     internal_handle->segment_table,
 			     first_segment_filename,
 			     filename_length - 4,
@@ -1500,12 +1591,12 @@ int libewf_handle_open_wide(
 	{
 		/* Get the basename and store it in the segment tables
 		 */
-		filename_length = wide_string_length(
+		filename_length = narrow_string_length(
 				   filenames[ 0 ] );
 
 		/* Set segment table basename
 		 */
-		if( libewf_segment_table_set_basename_wide(
+		if( libewf_segment_table_set_basename(
 		     internal_handle->segment_table,
 		     filenames[ 0 ],
 		     filename_length,
@@ -1552,6 +1643,10 @@ int libewf_handle_open_wide(
 		 "%s: unable to open handle using a file IO pool.",
 		 function );
 
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+
 		result = -1;
 	}
 	else
@@ -1599,43 +1694,33 @@ on_error:
 	return( -1 );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-/* Reads the section data from a segment file
+/* Opens a set of EWF file(s)
+ * For reading files should contain all filenames that make up an EWF image
+ * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
  * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_open_read_segment_file_section_data(
-     libewf_internal_handle_t *internal_handle,
-     libewf_segment_file_t *segment_file,
-     libbfio_pool_t *file_io_pool,
-     int file_io_pool_entry,
+int libewf_handle_open_wide(
+     libewf_handle_t *handle,
+     wchar_t * const filenames[],
+     int number_of_filenames,
+     int access_flags,
      libcerror_error_t **error )
 {
-	libewf_header_sections_t *header_sections = NULL;
-	libewf_section_descriptor_t *section      = NULL;
-	libfcache_cache_t *sections_cache         = NULL;
-	uint8_t *single_files_data                = NULL;
-	uint8_t *single_files_section_data        = NULL;
-	uint8_t *string_data                      = NULL;
-	static char *function                     = "libewf_internal_handle_open_read_segment_file_section_data";
-	size_t single_files_data_size             = 0;
-	size_t single_files_section_data_size     = 0;
-	size_t string_data_size                   = 0;
-	ssize_t read_count                        = 0;
-	off64_t section_data_offset               = 0;
-	uint8_t header_section_found              = 0;
-	uint8_t initialize_chunk_values           = 0;
-	int number_of_sections                    = 0;
-	int read_table_sections                   = 0;
+	libbfio_handle_t *file_io_handle          = NULL;
+	libbfio_pool_t *file_io_pool              = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	wchar_t *first_segment_filename           = NULL;
+	static char *function                     = "libewf_handle_open_wide";
+	size_t filename_length                    = 0;
+	int file_io_pool_entry                    = 0;
+	int filename_index                        = 0;
+	int maximum_number_of_open_handles        = 0;
 	int result                                = 0;
-	int section_index                         = 0;
-	int set_identifier_change                 = 0;
+	uint8_t use_direct_io                     = 0;
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-	int known_section                         = 0;
-#endif
-
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1646,1160 +1731,4934 @@ int libewf_internal_handle_open_read_segment_file_section_data(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( filenames == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->read_io_handle == NULL )
+	if( number_of_filenames <= 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing read IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of files zero or less.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#if !defined( HAVE_WRITE_SUPPORT )
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported - compiled without zlib.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->single_files != NULL )
+#endif
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - single files value already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_file == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment file.",
-		 function );
+#endif
+	maximum_number_of_open_handles = internal_handle->maximum_number_of_open_handles;
+	use_direct_io                  = internal_handle->io_handle->use_direct_io;
 
-		return( -1 );
-	}
-	if( libfcache_cache_initialize(
-	     &sections_cache,
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sections cache.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_header_sections_initialize(
-	     &header_sections,
-	     error ) != 1 )
+#endif
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT )
+	/* Every open direct file IO handle has its own staging buffer
+	 */
+	if( ( use_direct_io != 0 )
+	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 )
+	 && ( maximum_number_of_open_handles == LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create header sections.",
-		 function );
-
-		goto on_error;
+		maximum_number_of_open_handles = LIBEWF_DIRECT_FILE_IO_HANDLE_MAXIMUM_NUMBER_OF_OPEN_HANDLES;
 	}
-	if( libfdata_list_get_number_of_elements(
-	     segment_file->sections_list,
-	     &number_of_sections,
+#endif
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     0,
+	     maximum_number_of_open_handles,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve the number of sections in the sections list.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
 		 function );
 
 		goto on_error;
 	}
-	for( section_index = 0;
-	     section_index < number_of_sections;
-	     section_index++ )
-	{
-		if( libfdata_list_get_element_value_by_index(
-		     segment_file->sections_list,
-		     (intptr_t *) file_io_pool,
-		     (libfdata_cache_t *) sections_cache,
-		     section_index,
-		     (intptr_t **) &section,
-		     0,
-		     error ) != 1 )
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		for( filename_index = 0;
+		     filename_index < number_of_filenames;
+		     filename_index++ )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve section: %d from sections list.",
-			 function,
-			 section_index );
+			filename_length = wide_string_length(
+					   filenames[ filename_index ] );
 
-			goto on_error;
-		}
-		result = libewf_section_get_data_offset(
-		          section,
-		          segment_file->major_version,
-		          &section_data_offset,
-		          error );
+			/* Make sure there is more to the filename than the extension
+			 */
+			if( filename_length <= 4 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: filename: %ls is too small.",
+				 function,
+				 filenames[ filename_index ] );
 
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve section: %d data offset.",
-			 function,
-			 section_index );
+				goto on_error;
+			}
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT )
+			if( use_direct_io != 0 )
+			{
+				if( libewf_direct_file_initialize_wide(
+				     &file_io_handle,
+				     filenames[ filename_index ],
+				     filename_length,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create direct file IO handle.",
+					 function );
 
-			goto on_error;
-		}
-		else if( result != 0 )
-		{
-			if( libewf_segment_file_seek_offset(
-			     segment_file,
+					goto on_error;
+				}
+			}
+			else
+#endif
+			{
+				if( libbfio_file_initialize(
+				     &file_io_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create file IO handle.",
+					 function );
+
+					goto on_error;
+				}
+				if( libbfio_file_set_name_wide(
+				     file_io_handle,
+				     filenames[ filename_index ],
+				     filename_length,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set name in file IO handle.",
+					 function );
+
+					goto on_error;
+				}
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libbfio_handle_set_track_offsets_read(
+			     file_io_handle,
+			     1,
+			     error ) != 1 )
+			{
+		                libcerror_error_set(
+		                 error,
+		                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		                 "%s: unable to set track offsets read in file IO handle.",
+		                 function );
+
+				goto on_error;
+			}
+#endif
+			if( libbfio_pool_append_handle(
 			     file_io_pool,
-			     file_io_pool_entry,
-			     section_data_offset,
-			     error ) == -1 )
+			     &file_io_pool_entry,
+			     file_io_handle,
+			     LIBBFIO_OPEN_READ,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_OPEN_FAILED,
-				 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
-				 function,
-				 section_index,
-				 section_data_offset );
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append file IO handle to pool.",
+				 function );
 
 				goto on_error;
 			}
+			file_io_handle = NULL;
+
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
 			{
-				if( segment_file->major_version == 1 )
-				{
-					libcnotify_printf(
-					 "%s: reading %s section data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-					 function,
-					 (char *) section->type_string,
-					 file_io_pool_entry,
-					 segment_file->current_offset,
-					 segment_file->current_offset );
-				}
-				else if( segment_file->major_version == 2 )
+				libcnotify_printf(
+				 "%s: added file IO pool entry: %d with filename: %ls.\n",
+				 function,
+				 file_io_pool_entry,
+				 filenames[ filename_index ] );
+			}
+#endif
+			if( ( filenames[ filename_index ][ filename_length - 3 ] == 'e' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'E' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'l' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'L' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 's' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'S' ) )
+			{
+				if( ( filenames[ filename_index ][ filename_length - 2 ] == '0' )
+				 && ( filenames[ filename_index ][ filename_length - 1 ] == '1' ) )
 				{
-					libcnotify_printf(
-					 "%s: reading 0x%08" PRIx32 " section data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-					 function,
-					 section->type,
-					 file_io_pool_entry,
-					 segment_file->current_offset,
-					 segment_file->current_offset );
+					first_segment_filename = filenames[ filename_index ];
 				}
 			}
-#endif /* defined( HAVE_DEBUG_OUTPUT ) */
 		}
-		if( section->type != 0 )
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		/* Get the basename of the first segment file
+		 */
+		if( first_segment_filename != NULL )
 		{
-			switch( section->type )
-			{
-				case LIBEWF_SECTION_TYPE_DEVICE_INFORMATION:
-					read_count = libewf_device_information_section_read_file_io_pool(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      internal_handle->read_io_handle,
-						      internal_handle->media_values,
-						      internal_handle->header_values,
-						      error );
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+			filename_length = wide_string_length(
+					   first_segment_filename );
 
-				case LIBEWF_SECTION_TYPE_CASE_DATA:
-					if( internal_handle->read_io_handle->case_data == NULL )
-					{
-						initialize_chunk_values = 1;
-					}
-					read_count = libewf_case_data_section_read_file_io_pool(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      internal_handle->read_io_handle,
-						      internal_handle->media_values,
-						      internal_handle->header_values,
-						      error );
+			/* Set segment table basename
+			 */
+			if( libewf_segment_table_set_basename_wide(
+			     internal_handle->segment_table,
+			     first_segment_filename,
+			     filename_length - 4,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set basename in segment table.",
+				 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+				goto on_error;
+			}
+		}
+	}
+	else if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		/* Get the basename and store it in the segment tables
+		 */
+		filename_length = wide_string_length(
+				   filenames[ 0 ] );
 
-				case LIBEWF_SECTION_TYPE_SECTOR_DATA:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-						{
-							libcnotify_printf(
-							 "%s: found sectors section in EWF-S01 format.\n",
-							 function );
-						}
-					}
-#endif
-					/* Nothing to do for the sectors section
-					 */
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+		/* Set segment table basename
+		 */
+		if( libewf_segment_table_set_basename_wide(
+		     internal_handle->segment_table,
+		     filenames[ 0 ],
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename in segment table.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	result = libewf_internal_handle_open_file_io_pool(
+	          internal_handle,
+	          file_io_pool,
+	          access_flags,
+	          internal_handle->segment_table,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle using a file IO pool.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->file_io_pool                    = file_io_pool;
+		internal_handle->file_io_pool_created_in_library = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	internal_handle->file_io_pool                    = NULL;
+	internal_handle->file_io_pool_created_in_library = 0;
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Reads the section data from a segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_read_segment_file_section_data(
+     libewf_internal_handle_t *internal_handle,
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	libewf_header_sections_t *header_sections = NULL;
+	libewf_section_descriptor_t *section      = NULL;
+	libfcache_cache_t *sections_cache         = NULL;
+	uint8_t *single_files_data                = NULL;
+	uint8_t *single_files_section_data        = NULL;
+	uint8_t *string_data                      = NULL;
+	static char *function                     = "libewf_internal_handle_open_read_segment_file_section_data";
+	size_t single_files_data_size             = 0;
+	size_t single_files_section_data_size     = 0;
+	size_t string_data_size                   = 0;
+	ssize_t read_count                        = 0;
+	off64_t section_data_offset               = 0;
+	uint8_t header_section_found              = 0;
+	uint8_t initialize_chunk_values           = 0;
+	int number_of_sections                    = 0;
+	int read_table_sections                   = 0;
+	int result                                = 0;
+	int section_index                         = 0;
+	int set_identifier_change                 = 0;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+	int known_section                         = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing read IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - single files value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_initialize(
+	     &sections_cache,
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sections cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_header_sections_initialize(
+	     &header_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create header sections.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of sections in the sections list.",
+		 function );
+
+		goto on_error;
+	}
+	for( section_index = 0;
+	     section_index < number_of_sections;
+	     section_index++ )
+	{
+		if( libfdata_list_get_element_value_by_index(
+		     segment_file->sections_list,
+		     (intptr_t *) file_io_pool,
+		     (libfdata_cache_t *) sections_cache,
+		     section_index,
+		     (intptr_t **) &section,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d from sections list.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		result = libewf_section_get_data_offset(
+		          section,
+		          segment_file->major_version,
+		          &section_data_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d data offset.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( libewf_segment_file_seek_offset(
+			     segment_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     section_data_offset,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
+				 function,
+				 section_index,
+				 section_data_offset );
+
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( segment_file->major_version == 1 )
+				{
+					libcnotify_printf(
+					 "%s: reading %s section data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+					 function,
+					 (char *) section->type_string,
+					 file_io_pool_entry,
+					 segment_file->current_offset,
+					 segment_file->current_offset );
+				}
+				else if( segment_file->major_version == 2 )
+				{
+					libcnotify_printf(
+					 "%s: reading 0x%08" PRIx32 " section data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+					 function,
+					 section->type,
+					 file_io_pool_entry,
+					 segment_file->current_offset,
+					 segment_file->current_offset );
+				}
+			}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+		}
+		if( section->type != 0 )
+		{
+			switch( section->type )
+			{
+				case LIBEWF_SECTION_TYPE_DEVICE_INFORMATION:
+					read_count = libewf_device_information_section_read_file_io_pool(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      internal_handle->read_io_handle,
+						      internal_handle->media_values,
+						      internal_handle->header_values,
+						      error );
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_CASE_DATA:
+					if( internal_handle->read_io_handle->case_data == NULL )
+					{
+						initialize_chunk_values = 1;
+					}
+					read_count = libewf_case_data_section_read_file_io_pool(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      internal_handle->read_io_handle,
+						      internal_handle->media_values,
+						      internal_handle->header_values,
+						      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_SECTOR_DATA:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+						{
+							libcnotify_printf(
+							 "%s: found sectors section in EWF-S01 format.\n",
+							 function );
+						}
+					}
+#endif
+					/* Nothing to do for the sectors section
+					 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
 
 				case LIBEWF_SECTION_TYPE_SECTOR_TABLE:
 					/* If the chunk_size was unknown when the segment file was opened we
 					 * have to read the chunk groups here
 					 */
-					if( segment_file->number_of_chunks == 0 )
+					if( segment_file->number_of_chunks == 0 )
+					{
+						read_table_sections = 1;
+					}
+					if( read_table_sections != 0 )
+					{
+						read_count = libewf_segment_file_read_table_section(
+							      segment_file,
+							      section,
+							      file_io_pool,
+							      file_io_pool_entry,
+							      internal_handle->media_values->chunk_size,
+							      error );
+					}
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_ERROR_TABLE:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+						{
+							libcnotify_printf(
+							 "%s: found error section in EWF-S01 format.\n",
+							 function );
+						}
+					}
+#endif
+					read_count = libewf_error2_section_read_file_io_pool(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      segment_file->major_version,
+						      internal_handle->acquiry_errors,
+						      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_SESSION_TABLE:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+						{
+							libcnotify_printf(
+							 "%s: found session section in EWF-S01 format.\n",
+							 function );
+						}
+					}
+#endif
+					read_count = libewf_session_section_read_file_io_pool(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      segment_file->major_version,
+						      internal_handle->media_values,
+						      internal_handle->sessions,
+						      internal_handle->tracks,
+						      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_INCREMENT_DATA:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_MD5_HASH:
+					read_count = libewf_md5_hash_section_read_file_io_pool(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      segment_file->major_version,
+						      internal_handle->hash_sections,
+						      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_SHA1_HASH:
+					read_count = libewf_sha1_hash_section_read_file_io_pool(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      internal_handle->hash_sections,
+						      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_RESTART_DATA:
+					read_count = libewf_section_compressed_string_read(
+						      section,
+					              internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+					              internal_handle->io_handle->compression_method,
+						      &string_data,
+						      &string_data_size,
+						      error );
+
+					if( read_count == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read restart data file object string.",
+						 function );
+
+						goto on_error;
+					}
+					if( libewf_restart_data_parse(
+					     string_data,
+					     string_data_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to parse restart data.",
+						 function );
+
+						goto on_error;
+					}
+					memory_free(
+					 string_data );
+
+					string_data = NULL;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_ENCRYPTION_KEYS:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_MEMORY_EXTENTS_TABLE:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_NEXT:
+					/* Nothing to do for the next section
+					 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_FINAL_INFORMATION:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_DONE:
+					/* Nothing to do for the done section
+					 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_ANALYTICAL_DATA:
+					read_count = libewf_section_compressed_string_read(
+						      section,
+					              internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+					              internal_handle->io_handle->compression_method,
+						      &string_data,
+						      &string_data_size,
+						      error );
+
+					if( read_count == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read analytical data file object string.",
+						 function );
+
+						goto on_error;
+					}
+					else if( read_count != 0 )
+					{
+						if( libewf_analytical_data_parse(
+						     string_data,
+						     string_data_size,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+							 "%s: unable to parse analytical data.",
+							 function );
+
+							goto on_error;
+						}
+						memory_free(
+						 string_data );
+
+						string_data = NULL;
+					}
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_SINGLE_FILES_DATA:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
+					 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+					{
+						if( libcnotify_verbose != 0 )
+						{
+							libcnotify_printf(
+							 "%s: found single files data section in none logical evidence format.\n",
+							 function );
+						}
+					}
+#endif
+					read_count = libewf_ltree_section_read_file_io_pool(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      segment_file->major_version,
+						      &single_files_section_data,
+						      &single_files_section_data_size,
+						      &single_files_data,
+						      &single_files_data_size,
+						      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+			}
+		}
+		else if( section->type_string_length == 4 )
+		{
+			if( memory_compare(
+			     (void *) section->type_string,
+			     (void *) "data",
+			     4 ) == 0 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+					{
+						libcnotify_printf(
+						 "%s: found data section in EWF-S01 format.\n",
+						 function );
+					}
+				}
+#endif
+				read_count = libewf_section_data_read(
+					      section,
+					      internal_handle->io_handle,
+					      file_io_pool,
+					      file_io_pool_entry,
+					      internal_handle->media_values,
+				              &set_identifier_change,
+				              error );
+
+				if( set_identifier_change != 0 )
+				{
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						libcnotify_printf(
+						 "%s: set identifier does not match.",
+						 function );
+					}
+#endif
+					segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED;
+				}
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+			else if( memory_compare(
+				  (void *) section->type_string,
+				  (void *) "disk",
+				  4 ) == 0 )
+			{
+				read_count = libewf_segment_file_read_volume_section(
+					      segment_file,
+					      section,
+					      file_io_pool,
+					      file_io_pool_entry,
+					      internal_handle->media_values,
+					      error );
+
+				initialize_chunk_values = 1;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+		}
+		else if( section->type_string_length == 5 )
+		{
+			if( memory_compare(
+			     (void *) section->type_string,
+			     (void *) "xhash",
+			     5 ) == 0 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+					{
+						libcnotify_printf(
+						 "%s: found xhash section in EWF-S01 format.\n",
+						 function );
+					}
+				}
+#endif
+				read_count = libewf_section_compressed_string_read(
+					      section,
+				              internal_handle->io_handle,
+					      file_io_pool,
+					      file_io_pool_entry,
+					      internal_handle->io_handle->compression_method,
+					      &string_data,
+					      &string_data_size,
+					      error );
+
+				if( read_count == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read xhash string.",
+					 function );
+
+					goto on_error;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					 if( libewf_debug_utf8_stream_print(
+					      "XHash",
+					      string_data,
+					      string_data_size,
+					      error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+						 "%s: unable to print xhash.",
+						 function );
+
+						goto on_error;
+					}
+				}
+#endif
+				if( internal_handle->hash_sections->xhash == NULL )
+				{
+					internal_handle->hash_sections->xhash      = string_data;
+					internal_handle->hash_sections->xhash_size = string_data_size;
+				}
+				else
+				{
+					memory_free(
+					 string_data );
+				}
+				string_data = NULL;
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+		}
+		else if( section->type_string_length == 6 )
+		{
+			if( memory_compare(
+			     (void *) section->type_string,
+			     (void *) "digest",
+			     6 ) == 0 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+					{
+						libcnotify_printf(
+						 "%s: found digest section in EWF-S01 format.\n",
+						 function );
+					}
+				}
+#endif
+				read_count = libewf_digest_section_read_file_io_pool(
+					      section,
+				              internal_handle->io_handle,
+					      file_io_pool,
+					      file_io_pool_entry,
+					      internal_handle->hash_sections,
+					      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+			else if( memory_compare(
+				  (void *) section->type_string,
+				  (void *) "header",
+				  6 ) == 0 )
+			{
+				read_count = libewf_section_compressed_string_read(
+					      section,
+				              internal_handle->io_handle,
+					      file_io_pool,
+					      file_io_pool_entry,
+				              internal_handle->io_handle->compression_method,
+					      &string_data,
+					      &string_data_size,
+					      error );
+
+				if( read_count == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read header file object string.",
+					 function );
+
+					goto on_error;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( libewf_debug_byte_stream_print(
+					     "Header",
+					     string_data,
+					     string_data_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+						 "%s: unable to print header.",
+						 function );
+
+						goto on_error;
+					}
+				}
+#endif
+				if( header_sections->header == NULL )
+				{
+					header_sections->header      = string_data;
+					header_sections->header_size = string_data_size;
+				}
+				else
+				{
+					memory_free(
+					 string_data );
+				}
+				string_data = NULL;
+
+				header_sections->number_of_header_sections += 1;
+
+				header_section_found = 1;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+			else if( memory_compare(
+				  (void *) section->type_string,
+				  (void *) "table2",
+				  6 ) == 0 )
+			{
+				if( read_table_sections != 0 )
+				{
+					read_count = libewf_segment_file_read_table2_section(
+						      segment_file,
+						      section,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      error );
+				}
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+			else if( memory_compare(
+				  (void *) section->type_string,
+				  (void *) "volume",
+				  6 ) == 0 )
+			{
+				read_count = libewf_segment_file_read_volume_section(
+					      segment_file,
+					      section,
+					      file_io_pool,
+					      file_io_pool_entry,
+					      internal_handle->media_values,
+					      error );
+
+				initialize_chunk_values = 1;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+		}
+		else if( section->type_string_length == 7 )
+		{
+			if( memory_compare(
+			     (void *) section->type_string,
+			     (void *) "header2",
+			     7 ) == 0 )
+			{
+				read_count = libewf_section_compressed_string_read(
+					      section,
+				              internal_handle->io_handle,
+					      file_io_pool,
+					      file_io_pool_entry,
+				              internal_handle->io_handle->compression_method,
+					      &string_data,
+					      &string_data_size,
+					      error );
+
+				if( read_count == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read header2 file object string.",
+					 function );
+
+					goto on_error;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( libewf_debug_utf16_stream_print(
+					     "Header2",
+					     string_data,
+					     string_data_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+						 "%s: unable to print header2.",
+						 function );
+
+						goto on_error;
+					}
+				}
+#endif
+				if( header_sections->header2 == NULL )
+				{
+					header_sections->header2      = string_data;
+					header_sections->header2_size = string_data_size;
+				}
+				else
+				{
+					memory_free(
+					 string_data );
+				}
+				string_data = NULL;
+
+				header_sections->number_of_header_sections += 1;
+
+				header_section_found = 1;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+			else if( memory_compare(
+				  (void *) section->type_string,
+				  (void *) "xheader",
+				  7 ) == 0 )
+			{
+				read_count = libewf_section_compressed_string_read(
+					      section,
+				              internal_handle->io_handle,
+					      file_io_pool,
+					      file_io_pool_entry,
+				              internal_handle->io_handle->compression_method,
+					      &string_data,
+					      &string_data_size,
+					      error );
+
+				if( read_count == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read xheader string.",
+					 function );
+
+					goto on_error;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( libewf_debug_utf8_stream_print(
+					     "XHeader",
+					     string_data,
+					     string_data_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+						 "%s: unable to print xheader.",
+						 function );
+
+						goto on_error;
+					}
+				}
+#endif
+				if( header_sections->xheader == NULL )
+				{
+					header_sections->xheader      = string_data;
+					header_sections->xheader_size = string_data_size;
+				}
+				else
+				{
+					memory_free(
+					 string_data );
+				}
+				string_data = NULL;
+
+				header_sections->number_of_header_sections += 1;
+
+				header_section_found = 1;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+		}
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( known_section == 0 )
+			{
+				if( segment_file->major_version == 1 )
+				{
+					libcnotify_printf(
+					 "%s: unsupported section type: %s.\n",
+					 function,
+					 (char *) section->type_string );
+				}
+				else if( segment_file->major_version == 2 )
+				{
+					libcnotify_printf(
+					 "%s: unsupported section type: 0x%08" PRIx32 ".\n",
+					 function,
+					 section->type );
+				}
+			}
+		}
+#endif
+		if( read_count == -1 )
+		{
+			if( section->type_string_length > 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read section: %s.",
+				 function,
+				 (char *) section->type_string );
+			}
+			else
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read section: 0x%08" PRIx32 ".",
+				 function,
+				 section->type );
+			}
+			goto on_error;
+		}
+		if( initialize_chunk_values != 0 )
+		{
+			if( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+			{
+				segment_file->io_handle->segment_file_type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+				segment_file->io_handle->format            = LIBEWF_FORMAT_SMART;
+			}
+			if( libewf_media_values_calculate_chunk_size(
+			     internal_handle->media_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate chunk size.",
+				 function );
+
+				goto on_error;
+			}
+/* TODO refactor */
+			internal_handle->io_handle->chunk_size = internal_handle->media_values->chunk_size;
+
+			/* Do a preliminary dection of the EWF format for reading the sector table section
+			 */
+			if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
+			{
+				if( header_sections->number_of_header_sections == 1 )
+				{
+					internal_handle->io_handle->format = LIBEWF_FORMAT_ENCASE1;
+				}
+				else if( internal_handle->media_values->error_granularity == 0 )
+				{
+					internal_handle->io_handle->format = LIBEWF_FORMAT_ENCASE2;
+				}
+			}
+			initialize_chunk_values = 0;
+		}
+	}
+	if( header_section_found != 0 )
+	{
+		if( libewf_header_sections_parse(
+		     header_sections,
+		     internal_handle->io_handle,
+		     internal_handle->header_values,
+		     &( internal_handle->io_handle->format ),
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to parse header sections.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( single_files_data != NULL )
+	{
+		if( libewf_single_files_initialize(
+		     &( internal_handle->single_files ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create single files.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_single_files_read_data(
+		     internal_handle->single_files,
+		     single_files_data,
+		     single_files_data_size,
+		     &( internal_handle->media_values->media_size ),
+		     &( internal_handle->io_handle->format ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to parse single files.",
+			 function );
+
+			goto on_error;
+		}
+		memory_free(
+		 single_files_section_data );
+
+		single_files_section_data = NULL;
+
+		if( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL )
+		{
+			if( internal_handle->io_handle->format == LIBEWF_FORMAT_LOGICAL_ENCASE7 )
+			{
+				internal_handle->io_handle->format = LIBEWF_FORMAT_V2_LOGICAL_ENCASE7;
+			}
+		}
+		internal_handle->media_values->number_of_sectors = internal_handle->media_values->media_size
+		                                                 / internal_handle->media_values->bytes_per_sector;
+
+		if( ( internal_handle->media_values->media_size % internal_handle->media_values->bytes_per_sector ) != 0 )
+		{
+			internal_handle->media_values->number_of_sectors += 1;
+		}
+	}
+	if( libewf_header_sections_free(
+	     &header_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free header sections.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfcache_cache_free(
+	     &sections_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sections cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( internal_handle->single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &( internal_handle->single_files ),
+		 NULL );
+	}
+	if( single_files_section_data != NULL )
+	{
+		memory_free(
+		 single_files_section_data );
+	}
+	if( string_data != NULL )
+	{
+		memory_free(
+		 string_data );
+	}
+	if( header_sections != NULL )
+	{
+		libewf_header_sections_free(
+		 &header_sections,
+		 NULL );
+	}
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens the segment files for reading
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_read_segment_files(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_open_read_segment_files";
+	size64_t maximum_segment_size       = 0;
+	size64_t segment_file_size          = 0;
+	uint32_t number_of_segments         = 0;
+	uint32_t segment_number             = 0;
+	uint8_t segment_file_flags          = 0;
+	int file_io_pool_entry              = 0;
+	int last_segment_file               = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_segment_scanner_t *segment_scanner = NULL;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - missing read IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure to read the device information section first so we
+	 * have the correct chunk size when reading Lx01 files.
+	 */
+	if( libewf_internal_handle_open_read_device_information(
+	     internal_handle,
+	     file_io_pool,
+	     segment_table,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read device information.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The first segment file is read before the others are scanned so that
+	 * the IO handle values needed to read the segment files are set
+	 */
+	if( ( internal_handle->segment_scan_number_of_threads > 0 )
+	 && ( number_of_segments > 2 ) )
+	{
+		if( libewf_segment_scanner_initialize(
+		     &segment_scanner,
+		     internal_handle->io_handle,
+		     LIBEWF_MAXIMUM_CACHE_ENTRIES_SEGMENT_FILES,
+		     internal_handle->segment_scan_number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment scanner.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		/* Scan no more segment files than fit in the segment files cache
+		 * so that they are not evicted before they are validated
+		 */
+		if( ( segment_scanner != NULL )
+		 && ( segment_number > 0 )
+		 && ( ( ( segment_number - 1 ) % LIBEWF_MAXIMUM_CACHE_ENTRIES_SEGMENT_FILES ) == 0 ) )
+		{
+			if( libewf_segment_scanner_scan(
+			     segment_scanner,
+			     segment_table,
+			     file_io_pool,
+			     segment_number,
+			     number_of_segments - segment_number,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to scan segment files.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( ( segment_number == 0 )
+		 && ( number_of_segments > 1 ) )
+		{
+			/* Round the maximum segment size to nearest number of KiB
+			 */
+			maximum_segment_size = ( segment_file_size >> 10 ) << 10;
+
+			if( libewf_segment_table_set_maximum_segment_size(
+			     segment_table,
+			     maximum_segment_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum segment size in segment table.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( segment_file->segment_number != ( segment_number + 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
+			 function,
+			 segment_file->segment_number,
+			 segment_number + 1 );
+
+			goto on_error;
+		}
+		if( segment_file->segment_number == 1 )
+		{
+			internal_handle->io_handle->segment_file_type  = segment_file->type;
+			internal_handle->io_handle->major_version      = segment_file->major_version;
+			internal_handle->io_handle->minor_version      = segment_file->minor_version;
+			internal_handle->io_handle->compression_method = segment_file->compression_method;
+
+			if( segment_file->major_version == 2 )
+			{
+				if( memory_copy(
+				     internal_handle->media_values->set_identifier,
+				     segment_file->set_identifier,
+				     16 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy segment file set identifier to media values.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		else
+		{
+			if( ( segment_file->major_version != internal_handle->io_handle->major_version )
+			 || ( segment_file->minor_version != internal_handle->io_handle->minor_version ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+				 "%s: segment file format version value mismatch.",
+				 function );
+
+				goto on_error;
+			}
+			if( internal_handle->io_handle->major_version == 2 )
+			{
+				if( segment_file->compression_method != internal_handle->io_handle->compression_method )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_INPUT,
+					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+					 "%s: segment file compression method value mismatch.",
+					 function );
+
+					goto on_error;
+				}
+				if( memory_compare(
+				     internal_handle->media_values->set_identifier,
+				     segment_file->set_identifier,
+				     16 ) != 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_INPUT,
+					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+					 "%s: segment file set identifier value mismatch.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_LAST ) != 0 )
+		{
+			last_segment_file = 1;
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED ) != 0 )
+		{
+/* TODO get key info */
+			internal_handle->io_handle->format       = LIBEWF_FORMAT_V2_ENCASE7;
+			internal_handle->io_handle->is_encrypted = 1;
+		}
+		if( libewf_internal_handle_open_read_segment_file_section_data(
+		     internal_handle,
+		     segment_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read section data from segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		/* The chunk size is known after the section data of the first segment file
+		 * has been read. An index file with a different chunk size is stale and
+		 * is ignored, the segment files are then read without the index file.
+		 */
+		if( ( segment_number == 0 )
+		 && ( internal_handle->io_handle->index_file != NULL )
+		 && ( internal_handle->index_file->chunk_size != internal_handle->media_values->chunk_size ) )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: index file chunk size: %" PRIu32 " does not match chunk size: %" PRIu32 ", ignoring index file.\n",
+				 function,
+				 internal_handle->index_file->chunk_size,
+				 internal_handle->media_values->chunk_size );
+			}
+#endif
+			internal_handle->io_handle->index_file = NULL;
+
+			if( libewf_index_file_close(
+			     internal_handle->index_file,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close index file.",
+				 function );
+
+				goto on_error;
+			}
+			segment_file_flags = segment_file->flags;
+
+			/* Remove the segment files that were read using the index file
+			 * from the cache so that they are read again
+			 */
+			if( libfcache_cache_empty(
+			     segment_table->segment_files_cache,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to empty segment files cache.",
+				 function );
+
+				goto on_error;
+			}
+			segment_table->current_segment_file = NULL;
+
+			if( libewf_segment_table_get_segment_file_by_index(
+			     segment_table,
+			     segment_number,
+			     file_io_pool,
+			     &segment_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+				 function,
+				 segment_number );
+
+				goto on_error;
+			}
+			if( segment_file == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing segment file: %" PRIu32 ".",
+				 function,
+				 segment_number );
+
+				goto on_error;
+			}
+			segment_file->flags |= segment_file_flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED;
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+			segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+		}
+		if( libewf_segment_table_set_segment_storage_media_size_by_index(
+		     segment_table,
+		     segment_number,
+		     segment_file->storage_media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		internal_handle->read_io_handle->storage_media_size_read += segment_file->storage_media_size;
+		internal_handle->read_io_handle->number_of_chunks_read   += segment_file->number_of_chunks;
+	}
+	if( last_segment_file == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing done section.",
+		 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( segment_scanner != NULL )
+	{
+		if( libewf_segment_scanner_free(
+		     &segment_scanner,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment scanner.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( segment_scanner != NULL )
+	{
+		libewf_segment_scanner_free(
+		 &segment_scanner,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+/* Reads the device information from the segment files
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_read_device_information(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t number_of_segments,
+     libcerror_error_t **error )
+{
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	libewf_segment_file_t *segment_file             = NULL;
+	libfcache_cache_t *sections_cache               = NULL;
+	static char *function                           = "libewf_internal_handle_open_read_device_information";
+	size64_t segment_file_size                      = 0;
+	ssize_t read_count                              = 0;
+	uint32_t segment_number                         = 0;
+	int file_io_pool_entry                          = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_get_segment_file_by_index(
+	     segment_table,
+	     segment_number,
+	     file_io_pool,
+	     &segment_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+		 function,
+		 segment_number );
+
+		goto on_error;
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing segment file: %" PRIu32 ".",
+		 function,
+		 segment_number );
+
+		goto on_error;
+	}
+	if( segment_file->major_version != 2 )
+	{
+		return( 1 );
+	}
+	if( segment_file->device_information_section_index == -1 )
+	{
+		/* Lx01 stores the device information in the last segment file
+		 */
+		segment_number = number_of_segments - 1;
+
+		if( libewf_segment_table_get_segment_file_by_index(
+		     segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+	}
+	if( segment_file->device_information_section_index == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: unable to locate a device information section.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_table_get_segment_by_index(
+	     segment_table,
+	     segment_number,
+	     &file_io_pool_entry,
+	     &segment_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+		 function,
+		 segment_number );
+
+		goto on_error;
+	}
+	if( libfcache_cache_initialize(
+	     &sections_cache,
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sections cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_get_element_value_by_index(
+	     segment_file->sections_list,
+	     (intptr_t *) file_io_pool,
+	     (libfdata_cache_t *) sections_cache,
+	     segment_file->device_information_section_index,
+	     (intptr_t **) &section_descriptor,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve section: %d from sections list.",
+		 function,
+		 segment_file->device_information_section_index );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_seek_offset(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     section_descriptor->start_offset,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to seek section: %d data offset: %" PRIu64 " (0x%08%" PRIx64 ").",
+		 function,
+		 segment_file->device_information_section_index,
+		 section_descriptor->start_offset );
+
+		goto on_error;
+	}
+	read_count = libewf_device_information_section_read_file_io_pool(
+		      section_descriptor,
+		      internal_handle->io_handle,
+		      file_io_pool,
+		      file_io_pool_entry,
+		      internal_handle->read_io_handle,
+		      internal_handle->media_values,
+		      internal_handle->header_values,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read device information section: %d.",
+		 function,
+		 segment_file->device_information_section_index );
+
+		goto on_error;
+	}
+	if( libfcache_cache_free(
+	     &sections_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sections cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle    = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_open_file_io_pool";
+	size64_t segment_file_size          = 0;
+	ssize_t read_count                  = 0;
+	int file_io_pool_entry              = 0;
+	int number_of_file_io_handles       = 0;
+	int result                          = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - hash sections value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - single files value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
+	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		if( libewf_read_io_handle_initialize(
+		     &( internal_handle->read_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		if( libewf_write_io_handle_initialize(
+		     &( internal_handle->write_io_handle ),
+		     internal_handle->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create write IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_chunk_table_initialize(
+	     &( internal_handle->chunk_table ),
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk table.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_cache_set_budget(
+	     internal_handle->chunk_table->chunk_cache,
+	     internal_handle->chunk_cache_budget,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk cache budget.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_header_values_initialize(
+	     &( internal_handle->header_values ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create header values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_hash_sections_initialize(
+	     &( internal_handle->hash_sections ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create hash sections.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_empty(
+	     internal_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sessions array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_empty(
+	     internal_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty tracks array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_range_list_empty(
+	     internal_handle->acquiry_errors,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty acquiry errors range list.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		if( libbfio_pool_get_number_of_handles(
+		     file_io_pool,
+		     &number_of_file_io_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve the number of handles in the pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_segment_file_initialize(
+		     &segment_file,
+		     internal_handle->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file.",
+			 function );
+
+			goto on_error;
+		}
+		for( file_io_pool_entry = 0;
+		     file_io_pool_entry < number_of_file_io_handles;
+		     file_io_pool_entry++ )
+		{
+			if( libbfio_pool_get_size(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &segment_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size of file IO pool entry: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			if( libbfio_pool_get_handle(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to retrieve file IO handle: %d from pool.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: processing file IO pool entry: %d.\n",
+				 function,
+				 file_io_pool_entry );
+			}
+#endif
+			read_count = libewf_segment_file_read_file_header_file_io_pool(
+				      segment_file,
+				      file_io_pool,
+				      file_io_pool_entry,
+				      error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment file header.",
+				 function );
+
+				goto on_error;
+			}
+			if( segment_file->segment_number == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_INVALID_DATA,
+				 "%s: invalid segment number: 0 in file IO pool entry: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			if( libewf_segment_table_append_segment_by_segment_file(
+			     segment_table,
+			     segment_file,
+			     file_io_pool_entry,
+			     segment_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append segment: %" PRIu32 " to segment table.",
+				 function,
+				 segment_file->segment_number );
+
+				goto on_error;
+			}
+		}
+		if( libewf_segment_file_free(
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment file.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( internal_handle->index_file != NULL )
+		 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+		{
+			result = libewf_index_file_open_read(
+			          internal_handle->index_file,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open index file.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				internal_handle->io_handle->index_file = internal_handle->index_file;
+			}
+		}
+		if( libewf_internal_handle_open_read_segment_files(
+		     internal_handle,
+		     file_io_pool,
+		     segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment files.",
+			 function );
+
+			if( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
+			{
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+		if( internal_handle->media_values == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing media values.",
+			 function );
+
+			goto on_error;
+		}
+/* TODO refactor */
+		if( internal_handle->single_files == NULL )
+		{
+			if( libewf_internal_handle_get_media_values(
+			     internal_handle,
+			     &( internal_handle->media_values->media_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine media values.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		if( internal_handle->write_io_handle->values_initialized == 0 )
+		{
+			if( libewf_write_io_handle_initialize_values(
+			     internal_handle->write_io_handle,
+			     internal_handle->io_handle,
+			     internal_handle->media_values,
+			     segment_table,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize write IO handle values.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libewf_write_io_handle_initialize_resume(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     segment_table,
+		     internal_handle->read_io_handle,
+		     &( internal_handle->current_offset ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle to resume.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_handle->io_handle->chunk_size   = internal_handle->media_values->chunk_size;
+	internal_handle->io_handle->access_flags = access_flags;
+
+	return( 1 );
+
+on_error:
+	if( internal_handle->io_handle->index_file != NULL )
+	{
+		libewf_index_file_close(
+		 internal_handle->index_file,
+		 NULL );
+
+		internal_handle->io_handle->index_file = NULL;
+	}
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &( internal_handle->single_files ),
+		 NULL );
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		libewf_hash_sections_free(
+		 &( internal_handle->hash_sections ),
+		 NULL );
+	}
+	if( internal_handle->header_values != NULL )
+	{
+		libfvalue_table_free(
+		 &( internal_handle->header_values ),
+		 NULL );
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		libewf_chunk_table_free(
+		 &( internal_handle->chunk_table ),
+		 NULL );
+	}
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libewf_write_io_handle_free(
+		 &( internal_handle->write_io_handle ),
+		 error );
+	}
+	if( internal_handle->read_io_handle != NULL )
+	{
+		libewf_read_io_handle_free(
+		 &( internal_handle->read_io_handle ),
+		 error );
+	}
+	return( -1 );
+}
+
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open_file_io_pool(
+     libewf_handle_t *handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_open_file_io_pool";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_WRITE_SUPPORT )
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported - compiled without zlib.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_open_file_io_pool(
+	          internal_handle,
+	          file_io_pool,
+	          access_flags,
+	          internal_handle->segment_table,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle using a file IO pool.",
+		 function );
+	}
+	else
+	{
+		internal_handle->file_io_pool = file_io_pool;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	internal_handle->file_io_pool = NULL;
+
+	return( -1 );
+}
+
+/* Closes a reader handle and detaches it from the image state of its parent handle
+ * Frees the parent handle when it was freed before its last reader handle
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_internal_handle_close_reader(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *parent_handle = NULL;
+	static char *function                   = "libewf_internal_handle_close_reader";
+	uint8_t free_parent_handle              = 0;
+	int result                              = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	parent_handle = internal_handle->parent_handle;
+
+	if( parent_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing parent handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle->read_io_handle != NULL )
+	{
+		if( libewf_read_io_handle_free(
+		     &( internal_handle->read_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     parent_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	parent_handle->number_of_reader_handles -= 1;
+
+	if( ( parent_handle->number_of_reader_handles == 0 )
+	 && ( parent_handle->free_pending != 0 ) )
+	{
+		free_parent_handle = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     parent_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		result = -1;
+	}
+	internal_handle->chunk_table_mutex = NULL;
+#endif
+	internal_handle->parent_handle  = NULL;
+	internal_handle->io_handle      = NULL;
+	internal_handle->media_values   = NULL;
+	internal_handle->sessions       = NULL;
+	internal_handle->tracks         = NULL;
+	internal_handle->acquiry_errors = NULL;
+	internal_handle->file_io_pool   = NULL;
+	internal_handle->segment_table  = NULL;
+	internal_handle->chunk_table    = NULL;
+	internal_handle->hash_sections  = NULL;
+	internal_handle->header_values  = NULL;
+	internal_handle->hash_values    = NULL;
+	internal_handle->single_files   = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( free_parent_handle != 0 )
+	{
+		parent_handle->free_pending = 0;
+
+		if( libewf_handle_free(
+		     (libewf_handle_t **) &parent_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parent handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Closes the EWF handle
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_handle_close(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_close";
+	ssize_t write_count                       = 0;
+	int number_of_reader_handles              = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->parent_handle != NULL )
+	{
+		if( libewf_internal_handle_close_reader(
+		     internal_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close reader handle.",
+			 function );
+
+			return( -1 );
+		}
+		return( 0 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	number_of_reader_handles = internal_handle->number_of_reader_handles;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	/* The image state cannot be closed while it is shared with reader handles
+	 */
+	if( number_of_reader_handles > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - image state is shared with reader handles.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->read_ahead != NULL )
+	{
+		if( libewf_read_ahead_free(
+		     &( internal_handle->read_ahead ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
+	{
+		write_count = libewf_internal_handle_write_finalize_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to finalize write.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->write_pipeline != NULL )
+	{
+		if( libewf_write_pipeline_free(
+		     &( internal_handle->write_pipeline ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write pipeline.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( internal_handle->file_io_pool_created_in_library != 0 )
+	{
+		if( libbfio_pool_close_all(
+		     internal_handle->file_io_pool,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close all file IO pool handles.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_pool_free(
+		     &( internal_handle->file_io_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO pool.",
+			 function );
+
+			result = -1;
+		}
+		internal_handle->file_io_pool_created_in_library = 0;
+	}
+	internal_handle->file_io_pool = NULL;
+
+	if( internal_handle->io_handle->index_file != NULL )
+	{
+		if( libewf_index_file_close(
+		     internal_handle->index_file,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close index file.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libewf_io_handle_clear(
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libewf_media_values_clear(
+	     internal_handle->media_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear media values.",
+		 function );
+
+		result = -1;
+	}
+	if( internal_handle->read_io_handle != NULL )
+	{
+		if( libewf_read_io_handle_free(
+		     &( internal_handle->read_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->write_io_handle != NULL )
+	{
+		if( libewf_write_io_handle_free(
+		     &( internal_handle->write_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* Free the chunk data if it could not be passed to libfcache_cache_set_value_by_index
+	 */
+	if( internal_handle->chunk_data != NULL )
+	{
+		if( libewf_chunk_data_free(
+		     &( internal_handle->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		if( libewf_chunk_table_free(
+		     &( internal_handle->chunk_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk table.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		if( libewf_hash_sections_free(
+		     &( internal_handle->hash_sections ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash sections.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->header_values != NULL )
+	{
+		if( libfvalue_table_free(
+		     &( internal_handle->header_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free header values.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->hash_values != NULL )
+	{
+		if( libfvalue_table_free(
+		     &( internal_handle->hash_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash values.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		if( libewf_single_files_free(
+		     &( internal_handle->single_files ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free single files.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcdata_array_empty(
+	     internal_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sessions array.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_array_empty(
+	     internal_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty tracks array.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_range_list_empty(
+	     internal_handle->acquiry_errors,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty acquiry errors range list.",
+		 function );
+
+		result = -1;
+	}
+	if( libewf_segment_table_clear(
+	     internal_handle->segment_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear segment table.",
+		 function );
+
+		result = -1;
+	}
+	if( libewf_io_handle_clear(
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_buffer_from_file_io_pool";
+	off64_t chunk_data_offset       = 0;
+	size64_t chunk_data_size        = 0;
+	size_t buffer_offset            = 0;
+	size_t read_size                = 0;
+	uint32_t chunk_data_flags       = 0;
+	int file_io_pool_entry          = 0;
+	int result                      = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	uint64_t chunk_index            = 0;
+	uint64_t number_of_sectors      = 0;
+	uint64_t start_sector           = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	internal_handle->io_handle->abort = 0;
+
+	if( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( ( internal_handle->read_ahead == NULL )
+	 && ( internal_handle->read_ahead_depth > 0 )
+	 && ( internal_handle->read_ahead_number_of_threads > 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 ) )
+	{
+		if( libewf_read_ahead_initialize(
+		     &( internal_handle->read_ahead ),
+		     internal_handle->io_handle,
+		     internal_handle->read_ahead_depth,
+		     internal_handle->read_ahead_number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read-ahead.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	while( buffer_size > 0 )
+	{
+		result = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_handle->read_ahead != NULL )
+		{
+			chunk_index = (uint64_t) internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+			if( libewf_read_ahead_update(
+			     internal_handle->read_ahead,
+			     internal_handle->chunk_table,
+			     file_io_pool,
+			     internal_handle->media_values,
+			     internal_handle->segment_table,
+			     chunk_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update read-ahead for chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			result = libewf_read_ahead_get_chunk_data(
+			          internal_handle->read_ahead,
+			          chunk_index,
+			          &chunk_data,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve read-ahead chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				chunk_data_offset = internal_handle->current_offset - chunk_data->range_start_offset;
+
+				if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+				{
+					start_sector      = chunk_data->range_start_offset / internal_handle->media_values->bytes_per_sector;
+					number_of_sectors = internal_handle->media_values->sectors_per_chunk;
+
+					if( ( start_sector + number_of_sectors ) > (uint64_t) internal_handle->media_values->number_of_sectors )
 					{
-						read_table_sections = 1;
+						number_of_sectors = (uint64_t) internal_handle->media_values->number_of_sectors - start_sector;
 					}
-					if( read_table_sections != 0 )
+					if( libewf_chunk_table_append_checksum_error(
+					     internal_handle->chunk_table,
+					     start_sector,
+					     number_of_sectors,
+					     error ) != 1 )
 					{
-						read_count = libewf_segment_file_read_table_section(
-							      segment_file,
-							      section,
-							      file_io_pool,
-							      file_io_pool_entry,
-							      internal_handle->media_values->chunk_size,
-							      error );
-					}
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+						 "%s: unable to append checksum error.",
+						 function );
 
-				case LIBEWF_SECTION_TYPE_ERROR_TABLE:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-						{
-							libcnotify_printf(
-							 "%s: found error section in EWF-S01 format.\n",
-							 function );
-						}
+						return( -1 );
 					}
+				}
+			}
+		}
 #endif
-					read_count = libewf_error2_section_read_file_io_pool(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      segment_file->major_version,
-						      internal_handle->acquiry_errors,
-						      error );
+		/* Chunk aligned reads of an entire chunk are unpacked directly into the buffer
+		 * unless the chunk data is already available
+		 */
+		if( ( result == 0 )
+		 && ( internal_handle->read_io_handle != NULL )
+		 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 )
+		 && ( ( internal_handle->current_offset % internal_handle->media_values->chunk_size ) == 0 )
+		 && ( buffer_size >= (size_t) internal_handle->media_values->chunk_size )
+		 && ( ( internal_handle->chunk_table->current_chunk_data == NULL )
+		  ||  ( internal_handle->current_offset != internal_handle->chunk_table->current_chunk_data->range_start_offset ) ) )
+		{
+			result = libewf_chunk_table_get_chunk_data_range_by_offset(
+			          internal_handle->chunk_table,
+			          file_io_pool,
+			          internal_handle->media_values,
+			          internal_handle->segment_table,
+			          internal_handle->current_offset,
+			          &file_io_pool_entry,
+			          &chunk_data_offset,
+			          &chunk_data_size,
+			          &chunk_data_flags,
+			          error );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk data range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 internal_handle->current_offset,
+				 internal_handle->current_offset );
 
-				case LIBEWF_SECTION_TYPE_SESSION_TABLE:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-						{
-							libcnotify_printf(
-							 "%s: found session section in EWF-S01 format.\n",
-							 function );
-						}
-					}
-#endif
-					read_count = libewf_session_section_read_file_io_pool(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      segment_file->major_version,
-						      internal_handle->media_values,
-						      internal_handle->sessions,
-						      internal_handle->tracks,
-						      error );
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				result = libewf_read_io_handle_read_chunk_data_to_buffer(
+				          internal_handle->read_io_handle,
+				          internal_handle->io_handle,
+				          file_io_pool,
+				          file_io_pool_entry,
+				          chunk_data_offset,
+				          chunk_data_size,
+				          chunk_data_flags,
+				          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				          buffer_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ") into buffer.",
+					 function,
+					 internal_handle->current_offset,
+					 internal_handle->current_offset );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+					return( -1 );
+				}
+			}
+			chunk_data_offset = 0;
 
-				case LIBEWF_SECTION_TYPE_INCREMENT_DATA:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+			if( result != 0 )
+			{
+				read_size = (size_t) internal_handle->media_values->chunk_size;
 
-				case LIBEWF_SECTION_TYPE_MD5_HASH:
-					read_count = libewf_md5_hash_section_read_file_io_pool(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      segment_file->major_version,
-						      internal_handle->hash_sections,
-						      error );
+				buffer_offset += read_size;
+				buffer_size   -= read_size;
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
+				internal_handle->current_offset += (off64_t) read_size;
+
+				if( internal_handle->io_handle->abort != 0 )
+				{
 					break;
+				}
+				continue;
+			}
+		}
+		if( result == 0 )
+		{
+			if( libewf_chunk_table_get_chunk_data_by_offset(
+			     internal_handle->chunk_table,
+			     internal_handle->io_handle,
+			     file_io_pool,
+			     internal_handle->media_values,
+			     internal_handle->segment_table,
+			     internal_handle->current_offset,
+			     &chunk_data_offset,
+			     &chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 internal_handle->current_offset,
+				 internal_handle->current_offset );
 
-				case LIBEWF_SECTION_TYPE_SHA1_HASH:
-					read_count = libewf_sha1_hash_section_read_file_io_pool(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      internal_handle->hash_sections,
-						      error );
+				return( -1 );
+			}
+		}
+		if( chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 internal_handle->current_offset,
+			 internal_handle->current_offset );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+			return( -1 );
+		}
+		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+			 function,
+			 chunk_data->chunk_index );
 
-				case LIBEWF_SECTION_TYPE_RESTART_DATA:
-					read_count = libewf_section_compressed_string_read(
-						      section,
-					              internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-					              internal_handle->io_handle->compression_method,
-						      &string_data,
-						      &string_data_size,
-						      error );
+			return( -1 );
+		}
+		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
 
-					if( read_count == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: unable to read restart data file object string.",
-						 function );
+		if( read_size > buffer_size )
+		{
+			read_size = buffer_size;
+		}
+		if( read_size == 0 )
+		{
+			break;
+		}
+		if( memory_copy(
+		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		     &( ( chunk_data->data )[ chunk_data_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+			 function,
+			 chunk_data->chunk_index );
 
-						goto on_error;
-					}
-					if( libewf_restart_data_parse(
-					     string_data,
-					     string_data_size,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-						 "%s: unable to parse restart data.",
-						 function );
+			return( -1 );
+		}
+		buffer_offset += read_size;
+		buffer_size   -= read_size;
 
-						goto on_error;
-					}
-					memory_free(
-					 string_data );
+		internal_handle->current_offset += (off64_t) read_size;
 
-					string_data = NULL;
+		if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+		chunk_data        = NULL;
+		chunk_data_offset = 0;
+	}
+	internal_handle->io_handle->abort = 0;
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+	return( (ssize_t) buffer_offset );
+}
 
-				case LIBEWF_SECTION_TYPE_ENCRYPTION_KEYS:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+/* Reads (media) data of a single chunk at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * The chunk table mutex is only held while the chunk table and chunk cache are accessed,
+ * the chunk data is read and unpacked without holding it
+ * This function is multi-thread safe acquire read lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_chunk_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_read_io_handle_t *read_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *cache_entry = NULL;
+	libewf_chunk_data_t *chunk_data         = NULL;
+	libewf_chunk_data_t *read_chunk_data    = NULL;
+	static char *function                   = "libewf_internal_handle_read_chunk_at_offset_from_file_io_pool";
+	size64_t packed_chunk_data_size         = 0;
+	size_t read_size                        = 0;
+	ssize_t read_count                      = 0;
+	off64_t chunk_data_offset               = 0;
+	off64_t packed_chunk_data_offset        = 0;
+	uint64_t chunk_index                    = 0;
+	uint32_t packed_chunk_data_flags        = 0;
+	int file_io_pool_entry                  = 0;
+	int result                              = 0;
 
-				case LIBEWF_SECTION_TYPE_MEMORY_EXTENTS_TABLE:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int chunk_table_mutex_grabbed           = 0;
 #endif
-					break;
 
-				case LIBEWF_SECTION_TYPE_NEXT:
-					/* Nothing to do for the next section
-					 */
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-				case LIBEWF_SECTION_TYPE_FINAL_INFORMATION:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
 
-				case LIBEWF_SECTION_TYPE_DONE:
-					/* Nothing to do for the done section
-					 */
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
 
-				case LIBEWF_SECTION_TYPE_ANALYTICAL_DATA:
-					read_count = libewf_section_compressed_string_read(
-						      section,
-					              internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-					              internal_handle->io_handle->compression_method,
-						      &string_data,
-						      &string_data_size,
-						      error );
+		return( -1 );
+	}
+	if( internal_handle->chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
+		 function );
 
-					if( read_count == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: unable to read analytical data file object string.",
-						 function );
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
 
-						goto on_error;
-					}
-					else if( read_count != 0 )
-					{
-						if( libewf_analytical_data_parse(
-						     string_data,
-						     string_data_size,
-						     error ) != 1 )
-						{
-							libcerror_error_set(
-							 error,
-							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-							 "%s: unable to parse analytical data.",
-							 function );
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
 
-							goto on_error;
-						}
-						memory_free(
-						 string_data );
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
 
-						string_data = NULL;
-					}
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+		return( -1 );
+	}
+	chunk_index = (uint64_t) offset / internal_handle->media_values->chunk_size;
 
-				case LIBEWF_SECTION_TYPE_SINGLE_FILES_DATA:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					if( ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
-					 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
-					{
-						if( libcnotify_verbose != 0 )
-						{
-							libcnotify_printf(
-							 "%s: found single files data section in none logical evidence format.\n",
-							 function );
-						}
-					}
-#endif
-					read_count = libewf_ltree_section_read_file_io_pool(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      segment_file->major_version,
-						      &single_files_section_data,
-						      &single_files_section_data_size,
-						      &single_files_data,
-						      &single_files_data_size,
-						      error );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
+		goto on_error;
+	}
+	chunk_table_mutex_grabbed = 1;
 #endif
-					break;
-			}
+	result = libewf_chunk_cache_get_chunk_data(
+	          internal_handle->chunk_table->chunk_cache,
+	          chunk_index,
+	          &chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data from cache.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		result = libewf_chunk_table_get_chunk_data_range_by_offset(
+		          internal_handle->chunk_table,
+		          file_io_pool,
+		          internal_handle->media_values,
+		          internal_handle->segment_table,
+		          offset,
+		          &file_io_pool_entry,
+		          &packed_chunk_data_offset,
+		          &packed_chunk_data_size,
+		          &packed_chunk_data_flags,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
 		}
-		else if( section->type_string_length == 4 )
+		/* Sparse chunks are handled by the chunk data cache
+		 */
+		if( ( packed_chunk_data_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
 		{
-			if( memory_compare(
-			     (void *) section->type_string,
-			     (void *) "data",
-			     4 ) == 0 )
+			if( libewf_chunk_table_get_segment_file_chunk_data_by_offset(
+			     internal_handle->chunk_table,
+			     internal_handle->io_handle,
+			     file_io_pool,
+			     internal_handle->chunk_table->chunk_data_cache,
+			     internal_handle->media_values,
+			     internal_handle->segment_table,
+			     offset,
+			     &chunk_data_offset,
+			     &chunk_data,
+			     0,
+			     error ) != 1 )
 			{
-#if defined( HAVE_VERBOSE_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-					{
-						libcnotify_printf(
-						 "%s: found data section in EWF-S01 format.\n",
-						 function );
-					}
-				}
-#endif
-				read_count = libewf_section_data_read(
-					      section,
-					      internal_handle->io_handle,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      internal_handle->media_values,
-				              &set_identifier_change,
-				              error );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment file chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
 
-				if( set_identifier_change != 0 )
-				{
-#if defined( HAVE_VERBOSE_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						libcnotify_printf(
-						 "%s: set identifier does not match.",
-						 function );
-					}
-#endif
-					segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED;
-				}
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
-#endif
+				goto on_error;
 			}
-			else if( memory_compare(
-				  (void *) section->type_string,
-				  (void *) "disk",
-				  4 ) == 0 )
-			{
-				read_count = libewf_segment_file_read_volume_section(
-					      segment_file,
-					      section,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      internal_handle->media_values,
-					      error );
+		}
+	}
+	if( chunk_data == NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		chunk_table_mutex_grabbed = 0;
 
-				initialize_chunk_values = 1;
+		if( libcthreads_mutex_release(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk table mutex.",
+			 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
+			goto on_error;
+		}
 #endif
+		/* Chunk aligned reads of an entire chunk are unpacked directly into the buffer
+		 */
+		if( ( read_io_handle != NULL )
+		 && ( ( offset % internal_handle->media_values->chunk_size ) == 0 )
+		 && ( buffer_size >= (size_t) internal_handle->media_values->chunk_size ) )
+		{
+			result = libewf_read_io_handle_read_chunk_data_to_buffer(
+			          read_io_handle,
+			          internal_handle->io_handle,
+			          file_io_pool,
+			          file_io_pool_entry,
+			          packed_chunk_data_offset,
+			          packed_chunk_data_size,
+			          packed_chunk_data_flags,
+			          buffer,
+			          buffer_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ") into buffer.",
+				 function,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				return( (ssize_t) internal_handle->media_values->chunk_size );
 			}
 		}
-		else if( section->type_string_length == 5 )
+		if( libewf_chunk_data_initialize(
+		     &read_chunk_data,
+		     internal_handle->media_values->chunk_size,
+		     0,
+		     error ) != 1 )
 		{
-			if( memory_compare(
-			     (void *) section->type_string,
-			     (void *) "xhash",
-			     5 ) == 0 )
-			{
-#if defined( HAVE_VERBOSE_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-					{
-						libcnotify_printf(
-						 "%s: found xhash section in EWF-S01 format.\n",
-						 function );
-					}
-				}
-#endif
-				read_count = libewf_section_compressed_string_read(
-					      section,
-				              internal_handle->io_handle,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      internal_handle->io_handle->compression_method,
-					      &string_data,
-					      &string_data_size,
-					      error );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
 
-				if( read_count == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read xhash string.",
-					 function );
+			goto on_error;
+		}
+		read_count = libewf_chunk_data_read_from_file_io_pool(
+		              read_chunk_data,
+		              file_io_pool,
+		              file_io_pool_entry,
+		              packed_chunk_data_offset,
+		              packed_chunk_data_size,
+		              packed_chunk_data_flags,
+		              error );
 
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					 if( libewf_debug_utf8_stream_print(
-					      "XHash",
-					      string_data,
-					      string_data_size,
-					      error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-						 "%s: unable to print xhash.",
-						 function );
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
 
-						goto on_error;
-					}
-				}
-#endif
-				if( internal_handle->hash_sections->xhash == NULL )
-				{
-					internal_handle->hash_sections->xhash      = string_data;
-					internal_handle->hash_sections->xhash_size = string_data_size;
-				}
-				else
-				{
-					memory_free(
-					 string_data );
-				}
-				string_data = NULL;
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
+			goto on_error;
+		}
+		if( libewf_chunk_data_unpack(
+		     read_chunk_data,
+		     internal_handle->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk table mutex.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_table_mutex_grabbed = 1;
 #endif
-			}
+		/* Another reader could have cached the same chunk in the meantime
+		 */
+		result = libewf_chunk_cache_get_entry_by_chunk_index(
+		          internal_handle->chunk_table->chunk_cache,
+		          chunk_index,
+		          &cache_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " cache entry.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
 		}
-		else if( section->type_string_length == 6 )
+		else if( ( result != 0 )
+		      && ( cache_entry->chunk_data != NULL ) )
 		{
-			if( memory_compare(
-			     (void *) section->type_string,
-			     (void *) "digest",
-			     6 ) == 0 )
+			if( libewf_chunk_data_free(
+			     &read_chunk_data,
+			     error ) != 1 )
 			{
-#if defined( HAVE_VERBOSE_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-					{
-						libcnotify_printf(
-						 "%s: found digest section in EWF-S01 format.\n",
-						 function );
-					}
-				}
-#endif
-				read_count = libewf_digest_section_read_file_io_pool(
-					      section,
-				              internal_handle->io_handle,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      internal_handle->hash_sections,
-					      error );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
-#endif
+				goto on_error;
 			}
-			else if( memory_compare(
-				  (void *) section->type_string,
-				  (void *) "header",
-				  6 ) == 0 )
+			chunk_data = cache_entry->chunk_data;
+		}
+		else
+		{
+			if( libewf_chunk_cache_insert_chunk_data(
+			     internal_handle->chunk_table->chunk_cache,
+			     chunk_index,
+			     read_chunk_data,
+			     error ) != 1 )
 			{
-				read_count = libewf_section_compressed_string_read(
-					      section,
-				              internal_handle->io_handle,
-					      file_io_pool,
-					      file_io_pool_entry,
-				              internal_handle->io_handle->compression_method,
-					      &string_data,
-					      &string_data_size,
-					      error );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert chunk: %" PRIu64 " data into cache.",
+				 function,
+				 chunk_index );
 
-				if( read_count == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read header file object string.",
-					 function );
+				goto on_error;
+			}
+			chunk_data      = read_chunk_data;
+			read_chunk_data = NULL;
+		}
+	}
+	if( libewf_chunk_table_update_chunk_data_by_offset(
+	     internal_handle->chunk_table,
+	     internal_handle->io_handle,
+	     internal_handle->media_values,
+	     offset,
+	     chunk_data,
+	     &chunk_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
 
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					if( libewf_debug_byte_stream_print(
-					     "Header",
-					     string_data,
-					     string_data_size,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-						 "%s: unable to print header.",
-						 function );
+		goto on_error;
+	}
+	if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+		 function,
+		 chunk_index );
 
-						goto on_error;
-					}
-				}
-#endif
-				if( header_sections->header == NULL )
-				{
-					header_sections->header      = string_data;
-					header_sections->header_size = string_data_size;
-				}
-				else
-				{
-					memory_free(
-					 string_data );
-				}
-				string_data = NULL;
+		goto on_error;
+	}
+	read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
 
-				header_sections->number_of_header_sections += 1;
+	if( read_size > buffer_size )
+	{
+		read_size = buffer_size;
+	}
+	if( read_size > 0 )
+	{
+		if( memory_copy(
+		     buffer,
+		     &( ( chunk_data->data )[ chunk_data_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+			 function,
+			 chunk_index );
 
-				header_section_found = 1;
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	chunk_table_mutex_grabbed = 0;
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
 #endif
-			}
-			else if( memory_compare(
-				  (void *) section->type_string,
-				  (void *) "table2",
-				  6 ) == 0 )
-			{
-				if( read_table_sections != 0 )
-				{
-					read_count = libewf_segment_file_read_table2_section(
-						      segment_file,
-						      section,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      error );
-				}
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
+	return( (ssize_t) read_size );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( chunk_table_mutex_grabbed != 0 )
+	{
+		libcthreads_mutex_release(
+		 internal_handle->chunk_table_mutex,
+		 NULL );
+	}
 #endif
-			}
-			else if( memory_compare(
-				  (void *) section->type_string,
-				  (void *) "volume",
-				  6 ) == 0 )
-			{
-				read_count = libewf_segment_file_read_volume_section(
-					      segment_file,
-					      section,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      internal_handle->media_values,
-					      error );
+	if( read_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &read_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
 
-				initialize_chunk_values = 1;
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
-#endif
-			}
-		}
-		else if( section->type_string_length == 7 )
-		{
-			if( memory_compare(
-			     (void *) section->type_string,
-			     (void *) "header2",
-			     7 ) == 0 )
-			{
-				read_count = libewf_section_compressed_string_read(
-					      section,
-				              internal_handle->io_handle,
-					      file_io_pool,
-					      file_io_pool_entry,
-				              internal_handle->io_handle->compression_method,
-					      &string_data,
-					      &string_data_size,
-					      error );
+/* Releases the read IO handle of the handle after a read at a specific offset used it
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_release_read_io_handle(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_release_read_io_handle";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->read_io_handle_in_use = 0;
+
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
 
-				if( read_count == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read header2 file object string.",
-					 function );
+		return( -1 );
+	}
+	return( 1 );
+}
 
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					if( libewf_debug_utf16_stream_print(
-					     "Header2",
-					     string_data,
-					     string_data_size,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-						 "%s: unable to print header2.",
-						 function );
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
 
-						goto on_error;
-					}
-				}
-#endif
-				if( header_sections->header2 == NULL )
-				{
-					header_sections->header2      = string_data;
-					header_sections->header2_size = string_data_size;
-				}
-				else
-				{
-					memory_free(
-					 string_data );
-				}
-				string_data = NULL;
+/* Reads (media) data at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * Unlike libewf_internal_handle_read_buffer_from_file_io_pool this function does not use
+ * or change the current offset and can be called by multiple readers at the same time
+ * This function is multi-thread safe acquire read lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_read_io_handle_t *read_io_handle = NULL;
+	static char *function                   = "libewf_internal_handle_read_buffer_at_offset_from_file_io_pool";
+	size_t buffer_offset                    = 0;
+	ssize_t read_count                      = 0;
+	uint8_t read_io_handle_created          = 0;
 
-				header_sections->number_of_header_sections += 1;
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-				header_section_found = 1;
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
-#endif
-			}
-			else if( memory_compare(
-				  (void *) section->type_string,
-				  (void *) "xheader",
-				  7 ) == 0 )
-			{
-				read_count = libewf_section_compressed_string_read(
-					      section,
-				              internal_handle->io_handle,
-					      file_io_pool,
-					      file_io_pool_entry,
-				              internal_handle->io_handle->compression_method,
-					      &string_data,
-					      &string_data_size,
-					      error );
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
 
-				if( read_count == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read xheader string.",
-					 function );
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
 
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					if( libewf_debug_utf8_stream_print(
-					     "XHeader",
-					     string_data,
-					     string_data_size,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-						 "%s: unable to print xheader.",
-						 function );
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
 
-						goto on_error;
-					}
-				}
-#endif
-				if( header_sections->xheader == NULL )
-				{
-					header_sections->xheader      = string_data;
-					header_sections->xheader_size = string_data_size;
-				}
-				else
-				{
-					memory_free(
-					 string_data );
-				}
-				string_data = NULL;
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
 
-				header_sections->number_of_header_sections += 1;
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
 
-				header_section_found = 1;
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( offset + buffer_size ) >= internal_handle->media_values->media_size )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - offset );
+	}
+	/* The packed chunk data buffer of a read IO handle cannot be shared by
+	 * concurrent reads, hence the read IO handle of the handle is used when
+	 * no other read at a specific offset uses it, such as on a reader handle,
+	 * otherwise the read uses its own read IO handle
+	 */
+	if( ( buffer_size >= (size_t) internal_handle->media_values->chunk_size )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 ) )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk table mutex.",
+			 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
-#endif
-			}
+			return( -1 );
 		}
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		if( internal_handle->read_io_handle_in_use == 0 )
 		{
-			if( known_section == 0 )
+			read_io_handle = internal_handle->read_io_handle;
+
+			if( read_io_handle != NULL )
 			{
-				if( segment_file->major_version == 1 )
-				{
-					libcnotify_printf(
-					 "%s: unsupported section type: %s.\n",
-					 function,
-					 (char *) section->type_string );
-				}
-				else if( segment_file->major_version == 2 )
-				{
-					libcnotify_printf(
-					 "%s: unsupported section type: 0x%08" PRIx32 ".\n",
-					 function,
-					 section->type );
-				}
+				internal_handle->read_io_handle_in_use = 1;
 			}
 		}
-#endif
-		if( read_count == -1 )
+		if( libcthreads_mutex_release(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
 		{
-			if( section->type_string_length > 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read section: %s.",
-				 function,
-				 (char *) section->type_string );
-			}
-			else
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read section: 0x%08" PRIx32 ".",
-				 function,
-				 section->type );
-			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk table mutex.",
+			 function );
+
 			goto on_error;
 		}
-		if( initialize_chunk_values != 0 )
+#else
+		read_io_handle = internal_handle->read_io_handle;
+#endif
+		if( read_io_handle == NULL )
 		{
-			if( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-			{
-				segment_file->io_handle->segment_file_type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
-				segment_file->io_handle->format            = LIBEWF_FORMAT_SMART;
-			}
-			if( libewf_media_values_calculate_chunk_size(
-			     internal_handle->media_values,
+			if( libewf_read_io_handle_initialize(
+			     &read_io_handle,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to calculate chunk size.",
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create read IO handle.",
 				 function );
 
 				goto on_error;
 			}
-/* TODO refactor */
-			internal_handle->io_handle->chunk_size = internal_handle->media_values->chunk_size;
-
-			/* Do a preliminary dection of the EWF format for reading the sector table section
-			 */
-			if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
-			{
-				if( header_sections->number_of_header_sections == 1 )
-				{
-					internal_handle->io_handle->format = LIBEWF_FORMAT_ENCASE1;
-				}
-				else if( internal_handle->media_values->error_granularity == 0 )
-				{
-					internal_handle->io_handle->format = LIBEWF_FORMAT_ENCASE2;
-				}
-			}
-			initialize_chunk_values = 0;
+			read_io_handle_created = 1;
 		}
 	}
-	if( header_section_found != 0 )
+	while( buffer_size > 0 )
 	{
-		if( libewf_header_sections_parse(
-		     header_sections,
-		     internal_handle->io_handle,
-		     internal_handle->header_values,
-		     &( internal_handle->io_handle->format ),
-		     error ) == -1 )
+		read_count = libewf_internal_handle_read_chunk_at_offset_from_file_io_pool(
+		              internal_handle,
+		              file_io_pool,
+		              read_io_handle,
+		              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		              buffer_size,
+		              offset,
+		              error );
+
+		if( read_count == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to parse header sections.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
 
 			goto on_error;
 		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset += (size_t) read_count;
+		buffer_size   -= (size_t) read_count;
+		offset        += (off64_t) read_count;
+
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
 	}
-	if( single_files_data != NULL )
+	if( read_io_handle_created != 0 )
 	{
-		if( libewf_single_files_initialize(
-		     &( internal_handle->single_files ),
+		read_io_handle_created = 0;
+
+		if( libewf_read_io_handle_free(
+		     &read_io_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create single files.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read IO handle.",
 			 function );
 
 			goto on_error;
 		}
-		if( libewf_single_files_read_data(
-		     internal_handle->single_files,
-		     single_files_data,
-		     single_files_data_size,
-		     &( internal_handle->media_values->media_size ),
-		     &( internal_handle->io_handle->format ),
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	else if( read_io_handle != NULL )
+	{
+		read_io_handle = NULL;
+
+		if( libewf_internal_handle_release_read_io_handle(
+		     internal_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to parse single files.",
+			 "%s: unable to release read IO handle.",
 			 function );
 
 			goto on_error;
 		}
-		memory_free(
-		 single_files_section_data );
+	}
+#endif
+	return( (ssize_t) buffer_offset );
 
-		single_files_section_data = NULL;
+on_error:
+	if( read_io_handle_created != 0 )
+	{
+		libewf_read_io_handle_free(
+		 &read_io_handle,
+		 NULL );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	else if( read_io_handle != NULL )
+	{
+		libewf_internal_handle_release_read_io_handle(
+		 internal_handle,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
 
-		if( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL )
-		{
-			if( internal_handle->io_handle->format == LIBEWF_FORMAT_LOGICAL_ENCASE7 )
-			{
-				internal_handle->io_handle->format = LIBEWF_FORMAT_V2_LOGICAL_ENCASE7;
-			}
-		}
-		internal_handle->media_values->number_of_sectors = internal_handle->media_values->media_size
-		                                                 / internal_handle->media_values->bytes_per_sector;
+/* Reads (media) data at the current offset into a buffer
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer";
+	ssize_t read_count                        = 0;
 
-		if( ( internal_handle->media_values->media_size % internal_handle->media_values->bytes_per_sector ) != 0 )
-		{
-			internal_handle->media_values->number_of_sectors += 1;
-		}
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
 	}
-	if( libewf_header_sections_free(
-	     &header_sections,
-	     error ) != 1 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free header sections.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfcache_cache_free(
-	     &sections_cache,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sections cache.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		goto on_error;
-	}
-	return( 1 );
-
-on_error:
-	if( internal_handle->single_files != NULL )
-	{
-		libewf_single_files_free(
-		 &( internal_handle->single_files ),
-		 NULL );
+		return( -1 );
 	}
-	if( single_files_section_data != NULL )
+#endif
+	/* A reader handle reads the shared image state concurrently with the other reader handles
+	 */
+	if( internal_handle->parent_handle != NULL )
 	{
-		memory_free(
-		 single_files_section_data );
+		read_count = libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+			      internal_handle,
+			      internal_handle->file_io_pool,
+			      buffer,
+			      buffer_size,
+			      internal_handle->current_offset,
+			      error );
+
+		if( read_count > 0 )
+		{
+			internal_handle->current_offset += (off64_t) read_count;
+		}
 	}
-	if( string_data != NULL )
+	else
 	{
-		memory_free(
-		 string_data );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk table mutex.",
+			 function );
+
+			libcthreads_read_write_lock_release_for_write(
+			 internal_handle->read_write_lock,
+			 NULL );
+
+			return( -1 );
+		}
+#endif
+		read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
+			      internal_handle,
+			      internal_handle->file_io_pool,
+			      buffer,
+			      buffer_size,
+			      error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk table mutex.",
+			 function );
+
+			read_count = -1;
+		}
+#endif
 	}
-	if( header_sections != NULL )
+	if( read_count == -1 )
 	{
-		libewf_header_sections_free(
-		 &header_sections,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
 	}
-	if( sections_cache != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		libfcache_cache_free(
-		 &sections_cache,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
 	}
-	return( -1 );
+#endif
+	return( read_count );
 }
 
-/* Opens the segment files for reading
- * Returns 1 if successful or -1 on error
+/* Reads (media) data at a specific offset
+ * Multiple threads can read at the same time, the chunk data is read and unpacked concurrently
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
  */
-int libewf_internal_handle_open_read_segment_files(
-     libewf_internal_handle_t *internal_handle,
-     libbfio_pool_t *file_io_pool,
-     libewf_segment_table_t *segment_table,
-     libcerror_error_t **error )
-{
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_open_read_segment_files";
-	size64_t maximum_segment_size       = 0;
-	size64_t segment_file_size          = 0;
-	uint32_t number_of_segments         = 0;
-	uint32_t segment_number             = 0;
-	int file_io_pool_entry              = 0;
-	int last_segment_file               = 0;
+ssize_t libewf_handle_read_buffer_at_offset(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer_at_offset";
+	ssize_t read_count                        = 0;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2810,321 +6669,122 @@ int libewf_internal_handle_open_read_segment_files(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-		return( -1 );
-	}
-	if( internal_handle->read_io_handle == NULL )
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - missing read IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( segment_table == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment table.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_table_get_number_of_segments(
-	     segment_table,
-	     &number_of_segments,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments from segment table.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	/* Make sure to read the device information section first so we
-	 * have the correct chunk size when reading Lx01 files.
-	 */
-	if( libewf_internal_handle_open_read_device_information(
-	     internal_handle,
-	     file_io_pool,
-	     segment_table,
-	     number_of_segments,
-	     error ) != 1 )
+#endif
+	read_count = libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read device information.",
-		 function );
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
 
-		return( -1 );
+		read_count = -1;
 	}
-	for( segment_number = 0;
-	     segment_number < number_of_segments;
-	     segment_number++ )
-	{
-		if( libewf_segment_table_get_segment_by_index(
-		     segment_table,
-		     segment_number,
-		     &file_io_pool_entry,
-		     &segment_file_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
-			 function,
-			 segment_number );
-
-			return( -1 );
-		}
-		if( ( segment_number == 0 )
-		 && ( number_of_segments > 1 ) )
-		{
-			/* Round the maximum segment size to nearest number of KiB
-			 */
-			maximum_segment_size = ( segment_file_size >> 10 ) << 10;
-
-			if( libewf_segment_table_set_maximum_segment_size(
-			     segment_table,
-			     maximum_segment_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set maximum segment size in segment table.",
-				 function );
-
-				return( -1 );
-			}
-		}
-		if( libewf_segment_table_get_segment_file_by_index(
-		     segment_table,
-		     segment_number,
-		     file_io_pool,
-		     &segment_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
-			 function,
-			 segment_number );
-
-			return( -1 );
-		}
-		if( segment_file == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
-
-			return( -1 );
-		}
-		if( segment_file->segment_number != ( segment_number + 1 ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_INPUT,
-			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
-			 function,
-			 segment_file->segment_number,
-			 segment_number + 1 );
-
-			return( -1 );
-		}
-		if( segment_file->segment_number == 1 )
-		{
-			internal_handle->io_handle->segment_file_type  = segment_file->type;
-			internal_handle->io_handle->major_version      = segment_file->major_version;
-			internal_handle->io_handle->minor_version      = segment_file->minor_version;
-			internal_handle->io_handle->compression_method = segment_file->compression_method;
-
-			if( segment_file->major_version == 2 )
-			{
-				if( memory_copy(
-				     internal_handle->media_values->set_identifier,
-				     segment_file->set_identifier,
-				     16 ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-					 "%s: unable to copy segment file set identifier to media values.",
-					 function );
-
-					return( -1 );
-				}
-			}
-		}
-		else
-		{
-			if( ( segment_file->major_version != internal_handle->io_handle->major_version )
-			 || ( segment_file->minor_version != internal_handle->io_handle->minor_version ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_INPUT,
-				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-				 "%s: segment file format version value mismatch.",
-				 function );
-
-				return( -1 );
-			}
-			if( internal_handle->io_handle->major_version == 2 )
-			{
-				if( segment_file->compression_method != internal_handle->io_handle->compression_method )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_INPUT,
-					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-					 "%s: segment file compression method value mismatch.",
-					 function );
-
-					return( -1 );
-				}
-				if( memory_compare(
-				     internal_handle->media_values->set_identifier,
-				     segment_file->set_identifier,
-				     16 ) != 0 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_INPUT,
-					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-					 "%s: segment file set identifier value mismatch.",
-					 function );
-
-					return( -1 );
-				}
-			}
-		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_LAST ) != 0 )
-		{
-			last_segment_file = 1;
-		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED ) != 0 )
-		{
-/* TODO get key info */
-			internal_handle->io_handle->format       = LIBEWF_FORMAT_V2_ENCASE7;
-			internal_handle->io_handle->is_encrypted = 1;
-		}
-		if( libewf_internal_handle_open_read_segment_file_section_data(
-		     internal_handle,
-		     segment_file,
-		     file_io_pool,
-		     file_io_pool_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read section data from segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
-
-			return( -1 );
-		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
-		{
-			segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
-		}
-		if( libewf_segment_table_set_segment_storage_media_size_by_index(
-		     segment_table,
-		     segment_number,
-		     segment_file->storage_media_size,
+	else
+	{
+		/* The current offset is updated for compatibility with libewf_handle_get_offset
+		 */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_handle->chunk_table_mutex,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
-			 function,
-			 segment_number );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk table mutex.",
+			 function );
 
-			return( -1 );
+			read_count = -1;
 		}
-		internal_handle->read_io_handle->storage_media_size_read += segment_file->storage_media_size;
-		internal_handle->read_io_handle->number_of_chunks_read   += segment_file->number_of_chunks;
+		else
+		{
+#endif
+			internal_handle->current_offset = offset + (off64_t) read_count;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			if( libcthreads_mutex_release(
+			     internal_handle->chunk_table_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release chunk table mutex.",
+				 function );
+
+				read_count = -1;
+			}
+		}
+#endif
 	}
-	if( last_segment_file == 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing done section.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			if( ( error != NULL )
-			 && ( *error != NULL ) )
-			{
-				libcnotify_print_error_backtrace(
-				 *error );
-			}
-		}
-#endif
-		libcerror_error_free(
-		 error );
-
-		segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+		return( -1 );
 	}
-	return( 1 );
+#endif
+	return( read_count );
 }
 
-/* Reads the device information from the segment files
+/* Creates the segment writer of the write IO handle if enabled and not yet created
+ * This function is not multi-thread safe acquire write lock before call
  * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_open_read_device_information(
+int libewf_internal_handle_initialize_segment_writer(
      libewf_internal_handle_t *internal_handle,
-     libbfio_pool_t *file_io_pool,
-     libewf_segment_table_t *segment_table,
-     uint32_t number_of_segments,
      libcerror_error_t **error )
 {
-	libewf_section_descriptor_t *section_descriptor = NULL;
-	libewf_segment_file_t *segment_file             = NULL;
-	libfcache_cache_t *sections_cache               = NULL;
-	static char *function                           = "libewf_internal_handle_open_read_device_information";
-	size64_t segment_file_size                      = 0;
-	ssize_t read_count                              = 0;
-	uint32_t segment_number                         = 0;
-	int file_io_pool_entry                          = 0;
+	static char *function = "libewf_internal_handle_initialize_segment_writer";
 
 	if( internal_handle == NULL )
 	{
@@ -3137,739 +6797,1279 @@ int libewf_internal_handle_open_read_device_information(
 
 		return( -1 );
 	}
-	if( number_of_segments == 0 )
+	if( internal_handle->write_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid number of segments value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_table_get_segment_file_by_index(
-	     segment_table,
-	     segment_number,
-	     file_io_pool,
-	     &segment_file,
-	     error ) != 1 )
+	if( ( internal_handle->write_io_handle->segment_writer == NULL )
+	 && ( internal_handle->segment_writer_buffer_size > 0 ) )
+	{
+		if( libewf_segment_writer_initialize(
+		     &( internal_handle->write_io_handle->segment_writer ),
+		     internal_handle->segment_writer_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment writer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Writes the oldest chunk queued in the write pipeline using a Basic File IO (bfio) pool
+ * Waits for the chunk to be packed if necessary
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 if no chunk was queued or -1 on error
+ */
+ssize_t libewf_internal_handle_write_queued_chunk_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_write_queued_chunk_to_file_io_pool";
+	size_t input_data_size          = 0;
+	ssize_t write_count             = 0;
+	uint64_t chunk_index            = 0;
+	int result                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_pipeline == NULL )
+	{
+		return( 0 );
+	}
+	result = libewf_write_pipeline_pop_chunk_data(
+	          internal_handle->write_pipeline,
+	          &chunk_index,
+	          &chunk_data,
+	          &input_data_size,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+		 "%s: unable to pop chunk data from write pipeline.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	write_count = libewf_write_io_handle_write_new_chunk(
+	               internal_handle->write_io_handle,
+	               internal_handle->io_handle,
+	               file_io_pool,
+	               internal_handle->media_values,
+	               internal_handle->segment_table,
+	               internal_handle->header_values,
+	               internal_handle->hash_values,
+	               internal_handle->hash_sections,
+	               internal_handle->sessions,
+	               internal_handle->tracks,
+	               internal_handle->acquiry_errors,
+	               chunk_index,
+	               chunk_data,
+	               input_data_size,
+	               error );
+
+	if( write_count <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write new chunk: %" PRIu64 ".",
 		 function,
-		 segment_number );
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( libewf_chunk_data_free(
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	return( write_count );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Writes all the chunks queued in the write pipeline using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_queued_chunks_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_write_queued_chunks_to_file_io_pool";
+	ssize_t total_write_count = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	ssize_t write_count       = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	while( ( internal_handle->write_pipeline != NULL )
+	    && ( internal_handle->write_pipeline->number_of_queued_entries > 0 ) )
+	{
+		write_count = libewf_internal_handle_write_queued_chunk_to_file_io_pool(
+		               internal_handle,
+		               file_io_pool,
+		               error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write queued chunk.",
+			 function );
+
+			return( -1 );
+		}
+		total_write_count += write_count;
+	}
+#endif
+	return( total_write_count );
+}
+
+/* Writes the current chunk data using a Basic File IO (bfio) pool
+ * When the write pipeline is enabled the chunk data is queued to be packed by a worker thread
+ * and written, in order, once the write pipeline is full or flushed
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_chunk_data_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint64_t chunk_index,
+         libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_write_chunk_data_to_file_io_pool";
+	size_t input_data_size    = 0;
+	ssize_t write_count       = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	ssize_t total_write_count = 0;
+	int result                = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( segment_file == NULL )
+	if( internal_handle->chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing segment file: %" PRIu32 ".",
-		 function,
-		 segment_number );
+		 "%s: invalid handle - missing chunk data.",
+		 function );
 
-		goto on_error;
-	}
-	if( segment_file->major_version != 2 )
-	{
-		return( 1 );
+		return( -1 );
 	}
-	if( segment_file->device_information_section_index == -1 )
-	{
-		/* Lx01 stores the device information in the last segment file
-		 */
-		segment_number = number_of_segments - 1;
+	input_data_size = internal_handle->chunk_data->data_size;
 
-		if( libewf_segment_table_get_segment_file_by_index(
-		     segment_table,
-		     segment_number,
-		     file_io_pool,
-		     &segment_file,
+	/* The chunk data is hashed before it is packed, since packing can replace the data
+	 */
+	if( internal_handle->write_io_handle->integrity_hash != NULL )
+	{
+		if( libewf_integrity_hash_update(
+		     internal_handle->write_io_handle->integrity_hash,
+		     internal_handle->chunk_data->data,
+		     input_data_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to update integrity hash with chunk: %" PRIu64 " data.",
 			 function,
-			 segment_number );
+			 chunk_index );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( segment_file == NULL )
+	}
+	if( libewf_internal_handle_initialize_segment_writer(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize segment writer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( ( internal_handle->write_pipeline == NULL )
+	 && ( internal_handle->write_pipeline_number_of_threads > 0 ) )
+	{
+		if( libewf_write_pipeline_initialize(
+		     &( internal_handle->write_pipeline ),
+		     internal_handle->io_handle,
+		     internal_handle->write_io_handle,
+		     internal_handle->write_pipeline_number_of_threads,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create write pipeline.",
+			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
-	if( segment_file->device_information_section_index == -1 )
+	if( internal_handle->write_pipeline != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: unable to locate a device information section.",
-		 function );
+		do
+		{
+			result = libewf_write_pipeline_push_chunk_data(
+			          internal_handle->write_pipeline,
+			          chunk_index,
+			          &( internal_handle->chunk_data ),
+			          input_data_size,
+			          error );
 
-		goto on_error;
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push chunk: %" PRIu64 " data onto write pipeline.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				/* The write pipeline is full, make room by writing the oldest chunk
+				 */
+				write_count = libewf_internal_handle_write_queued_chunk_to_file_io_pool(
+				               internal_handle,
+				               file_io_pool,
+				               error );
+
+				if( write_count < 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write queued chunk.",
+					 function );
+
+					return( -1 );
+				}
+				total_write_count += write_count;
+			}
+		}
+		while( result == 0 );
+
+		return( total_write_count );
 	}
-	if( libewf_segment_table_get_segment_by_index(
-	     segment_table,
-	     segment_number,
-	     &file_io_pool_entry,
-	     &segment_file_size,
+#endif
+	if( libewf_chunk_data_pack(
+	     internal_handle->chunk_data,
+	     internal_handle->io_handle,
+	     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+	     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+	     internal_handle->write_io_handle->pack_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data.",
 		 function,
-		 segment_number );
+		 chunk_index );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfcache_cache_initialize(
-	     &sections_cache,
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
-	     error ) != 1 )
+	write_count = libewf_write_io_handle_write_new_chunk(
+	               internal_handle->write_io_handle,
+	               internal_handle->io_handle,
+	               file_io_pool,
+	               internal_handle->media_values,
+	               internal_handle->segment_table,
+	               internal_handle->header_values,
+	               internal_handle->hash_values,
+	               internal_handle->hash_sections,
+	               internal_handle->sessions,
+	               internal_handle->tracks,
+	               internal_handle->acquiry_errors,
+	               chunk_index,
+	               internal_handle->chunk_data,
+	               input_data_size,
+	               error );
+
+	if( write_count <= 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sections cache.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write new chunk.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfdata_list_get_element_value_by_index(
-	     segment_file->sections_list,
-	     (intptr_t *) file_io_pool,
-	     (libfdata_cache_t *) sections_cache,
-	     segment_file->device_information_section_index,
-	     (intptr_t **) &section_descriptor,
-	     0,
+	if( libewf_chunk_data_free(
+	     &( internal_handle->chunk_data ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve section: %d from sections list.",
-		 function,
-		 segment_file->device_information_section_index );
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk data.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_segment_file_seek_offset(
-	     segment_file,
-	     file_io_pool,
-	     file_io_pool_entry,
-	     section_descriptor->start_offset,
-	     error ) == -1 )
+	return( write_count );
+}
+
+/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function             = "libewf_internal_handle_write_buffer_to_file_io_pool";
+	size_t buffer_offset              = 0;
+	size_t write_size                 = 0;
+	ssize_t write_count               = 0;
+	off64_t chunk_data_offset         = 0;
+	uint64_t chunk_index              = 0;
+	uint64_t number_of_chunks_written = 0;
+	int write_chunk                   = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to seek section: %d data offset: %" PRIu64 " (0x%08%" PRIx64 ").",
-		 function,
-		 segment_file->device_information_section_index,
-		 section_descriptor->start_offset );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	read_count = libewf_device_information_section_read_file_io_pool(
-		      section_descriptor,
-		      internal_handle->io_handle,
-		      file_io_pool,
-		      file_io_pool_entry,
-		      internal_handle->read_io_handle,
-		      internal_handle->media_values,
-		      internal_handle->header_values,
-		      error );
-
-	if( read_count == -1 )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read device information section: %d.",
-		 function,
-		 segment_file->device_information_section_index );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfcache_cache_free(
-	     &sections_cache,
-	     error ) != 1 )
+	if( internal_handle->current_offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sections cache.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	return( 1 );
-
-on_error:
-	if( sections_cache != NULL )
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
 	{
-		libfcache_cache_free(
-		 &sections_cache,
-		 NULL );
-	}
-	return( -1 );
-}
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
 
-/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
- * Returns 1 if successful or -1 on error
- */
-int libewf_internal_handle_open_file_io_pool(
-     libewf_internal_handle_t *internal_handle,
-     libbfio_pool_t *file_io_pool,
-     int access_flags,
-     libewf_segment_table_t *segment_table,
-     libcerror_error_t **error )
-{
-	libbfio_handle_t *file_io_handle    = NULL;
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_open_file_io_pool";
-	size64_t segment_file_size          = 0;
-	ssize_t read_count                  = 0;
-	int file_io_pool_entry              = 0;
-	int number_of_file_io_handles       = 0;
+			return( -1 );
+		}
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
 
-	if( internal_handle == NULL )
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->write_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing subhandle write.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->file_io_pool != NULL )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - file IO pool value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_table != NULL )
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk table value already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->hash_sections != NULL )
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	internal_handle->io_handle->abort = 0;
+
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	if( chunk_index >= (uint64_t) INT_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - hash sections value already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->single_files != NULL )
+	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
+	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
+
+	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - single files value already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data offset value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( file_io_pool == NULL )
+	number_of_chunks_written = internal_handle->write_io_handle->number_of_chunks_written;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->write_pipeline != NULL )
+	{
+		number_of_chunks_written += (uint64_t) internal_handle->write_pipeline->number_of_queued_entries;
+	}
+#endif
+	while( buffer_size > 0 )
+	{
+		if( chunk_index < number_of_chunks_written )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( internal_handle->write_io_handle->write_finalized != 0 )
+		{
+			break;
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			if( libewf_chunk_data_initialize(
+			     &( internal_handle->chunk_data ),
+			     internal_handle->media_values->chunk_size,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( chunk_data_offset > internal_handle->media_values->chunk_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk offset exceeds chunk data size.",
+			 function );
+
+			return( -1 );
+		}
+		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+
+		if( write_size > buffer_size )
+		{
+			write_size = buffer_size;
+		}
+		if( write_size == 0 )
+		{
+			break;
+		}
+		if( memory_copy(
+		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
+		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		     write_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy buffer to chunk data.",
+			 function );
+
+			return( -1 );
+		}
+		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
+
+		buffer_offset += write_size;
+		buffer_size   -= write_size;
+
+		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
+		{
+			write_chunk = 1;
+		}
+		else if( ( internal_handle->media_values->media_size != 0 )
+		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
+		{
+			write_chunk = 1;
+		}
+		else
+		{
+			write_chunk = 0;
+		}
+		if( write_chunk != 0 )
+		{
+			write_count = libewf_internal_handle_write_chunk_data_to_file_io_pool(
+			               internal_handle,
+			               file_io_pool,
+			               chunk_index,
+			               error );
+
+			if( write_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
+		chunk_index      += 1;
+		chunk_data_offset = 0;
+
+		internal_handle->current_offset += (off64_t) write_size;
+
+		if( ( internal_handle->media_values->media_size != 0 )
+		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	internal_handle->io_handle->abort = 0;
+
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes (media) data at the current offset
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file IO pool.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
-	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) ) )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported access flags.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
 	{
-		if( libewf_read_io_handle_initialize(
-		     &( internal_handle->read_io_handle ),
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create read IO handle.",
+			 "%s: unable to initialize write IO handle values.",
 			 function );
 
-			goto on_error;
+			write_count = -1;
 		}
 	}
-	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	if( write_count != -1 )
 	{
-		if( libewf_write_io_handle_initialize(
-		     &( internal_handle->write_io_handle ),
-		     internal_handle->io_handle,
-		     error ) != 1 )
+		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               buffer,
+		               buffer_size,
+		               error );
+
+		if( write_count == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create write IO handle.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to write buffer.",
 			 function );
 
-			goto on_error;
+			write_count = -1;
 		}
 	}
-	if( libewf_chunk_table_initialize(
-	     &( internal_handle->chunk_table ),
-	     internal_handle->io_handle,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk table.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_header_values_initialize(
-	     &( internal_handle->header_values ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create header values.",
-		 function );
+#endif
+	return( write_count );
+}
 
-		goto on_error;
-	}
-	if( libewf_hash_sections_initialize(
-	     &( internal_handle->hash_sections ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create hash sections.",
-		 function );
+/* Writes (media) data at a specific offset,
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer_at_offset(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer_at_offset";
+	ssize_t write_count                       = 0;
 
-		goto on_error;
-	}
-	if( libcdata_array_empty(
-	     internal_handle->sessions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty sessions array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->tracks,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty tracks array.",
-		 function );
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-		goto on_error;
-	}
-	if( libcdata_range_list_empty(
-	     internal_handle->acquiry_errors,
-	     NULL,
-	     error ) != 1 )
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty acquiry errors range list.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
-	{
-		if( libbfio_pool_get_number_of_handles(
-		     file_io_pool,
-		     &number_of_file_io_handles,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve the number of handles in the pool.",
-			 function );
-
-			goto on_error;
-		}
-		if( libewf_segment_file_initialize(
-		     &segment_file,
-		     internal_handle->io_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create segment file.",
-			 function );
-
-			goto on_error;
-		}
-		for( file_io_pool_entry = 0;
-		     file_io_pool_entry < number_of_file_io_handles;
-		     file_io_pool_entry++ )
-		{
-			if( libbfio_pool_get_size(
-			     file_io_pool,
-			     file_io_pool_entry,
-			     &segment_file_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve size of file IO pool entry: %d.",
-				 function,
-				 file_io_pool_entry );
-
-				goto on_error;
-			}
-			if( libbfio_pool_get_handle(
-			     file_io_pool,
-			     file_io_pool_entry,
-			     &file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to retrieve file IO handle: %d from pool.",
-				 function,
-				 file_io_pool_entry );
-
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: processing file IO pool entry: %d.\n",
-				 function,
-				 file_io_pool_entry );
-			}
-#endif
-			read_count = libewf_segment_file_read_file_header_file_io_pool(
-				      segment_file,
-				      file_io_pool,
-				      file_io_pool_entry,
-				      error );
-
-			if( read_count < 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read segment file header.",
-				 function );
-
-				goto on_error;
-			}
-			if( segment_file->segment_number == 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_INPUT,
-				 LIBCERROR_INPUT_ERROR_INVALID_DATA,
-				 "%s: invalid segment number: 0 in file IO pool entry: %d.",
-				 function,
-				 file_io_pool_entry );
-
-				goto on_error;
-			}
-			if( libewf_segment_table_append_segment_by_segment_file(
-			     segment_table,
-			     segment_file,
-			     file_io_pool_entry,
-			     segment_file_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append segment: %" PRIu32 " to segment table.",
-				 function,
-				 segment_file->segment_number );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-				goto on_error;
-			}
-		}
-		if( libewf_segment_file_free(
-		     &segment_file,
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free segment file.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
 			 function );
 
-			goto on_error;
+			write_count = -1;
 		}
-		if( libewf_internal_handle_open_read_segment_files(
+	}
+	if( write_count != -1 )
+	{
+		if( libewf_internal_handle_seek_offset(
 		     internal_handle,
-		     file_io_pool,
-		     segment_table,
-		     error ) != 1 )
+		     offset,
+		     SEEK_SET,
+		     error ) == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read segment files.",
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset.",
 			 function );
 
-			if( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
-			{
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				if( ( error != NULL )
-				 && ( *error != NULL ) )
-				{
-					libcnotify_print_error_backtrace(
-					 *error );
-				}
-			}
-#endif
-			libcerror_error_free(
-			 error );
+			write_count = -1;
 		}
-		if( internal_handle->media_values == NULL )
+	}
+	if( write_count != -1 )
+	{
+		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               buffer,
+		               buffer_size,
+		               error );
+
+		if( write_count == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid handle - missing media values.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to write buffer.",
 			 function );
 
-			goto on_error;
+			write_count = -1;
 		}
-/* TODO refactor */
-		if( internal_handle->single_files == NULL )
-		{
-			if( libewf_internal_handle_get_media_values(
-			     internal_handle,
-			     &( internal_handle->media_values->media_size ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine media values.",
-				 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-				goto on_error;
-			}
-		}
+		return( -1 );
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
-	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+#endif
+	return( write_count );
+}
+
+/* Retrieves a (media) data chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_data_chunk(
+     libewf_handle_t *handle,
+     libewf_data_chunk_t **data_chunk,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_data_chunk";
+	int result                                = 1;
+
+	if( handle == NULL )
 	{
-		if( internal_handle->write_io_handle->values_initialized == 0 )
-		{
-			if( libewf_write_io_handle_initialize_values(
-			     internal_handle->write_io_handle,
-			     internal_handle->io_handle,
-			     internal_handle->media_values,
-			     segment_table,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to initialize write IO handle values.",
-				 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-				goto on_error;
-			}
-		}
-		if( libewf_write_io_handle_initialize_resume(
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_chunk != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: data chunk value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
+	{
+		if( libewf_write_io_handle_initialize_values(
 		     internal_handle->write_io_handle,
 		     internal_handle->io_handle,
-		     file_io_pool,
 		     internal_handle->media_values,
-		     segment_table,
-		     internal_handle->read_io_handle,
-		     &( internal_handle->current_offset ),
+		     internal_handle->segment_table,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle to resume.",
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != -1 )
+	{
+		if( libewf_data_chunk_initialize(
+		     data_chunk,
+		     internal_handle->io_handle,
+		     internal_handle->write_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data chunk.",
 			 function );
 
-			goto on_error;
-		}
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
+	off64_t chunk_data_offset       = 0;
+	size_t read_count               = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
 	}
-	internal_handle->io_handle->chunk_size   = internal_handle->media_values->chunk_size;
-	internal_handle->io_handle->access_flags = access_flags;
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
 
-	return( 1 );
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
 
-on_error:
-	if( segment_file != NULL )
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
 	{
-		libewf_segment_file_free(
-		 &segment_file,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_handle->single_files != NULL )
+	if( internal_handle->media_values == NULL )
 	{
-		libewf_single_files_free(
-		 &( internal_handle->single_files ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_handle->hash_sections != NULL )
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
 	{
-		libewf_hash_sections_free(
-		 &( internal_handle->hash_sections ),
-		 NULL );
+		return( 0 );
 	}
-	if( internal_handle->header_values != NULL )
+	if( libewf_chunk_table_get_chunk_data_by_offset_no_cache(
+	     internal_handle->chunk_table,
+	     internal_handle->io_handle,
+	     file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->current_offset,
+	     &chunk_data_offset,
+	     &chunk_data,
+	     error ) != 1 )
 	{
-		libfvalue_table_free(
-		 &( internal_handle->header_values ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_handle->current_offset,
+		 internal_handle->current_offset );
+
+		goto on_error;
 	}
-	if( internal_handle->chunk_table != NULL )
+	if( chunk_data == NULL )
 	{
-		libewf_chunk_table_free(
-		 &( internal_handle->chunk_table ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_handle->current_offset,
+		 internal_handle->current_offset );
+
+		goto on_error;
 	}
-	if( internal_handle->write_io_handle != NULL )
+	/* data_chunk takes over management of chunk_data
+	 */
+	if( libewf_internal_data_chunk_set_chunk_data(
+	     internal_data_chunk,
+	     chunk_data,
+	     error ) != 1 )
 	{
-		libewf_write_io_handle_free(
-		 &( internal_handle->write_io_handle ),
-		 error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
+		 function,
+		 chunk_data->chunk_index );
+
+		goto on_error;
 	}
-	if( internal_handle->read_io_handle != NULL )
+	internal_handle->current_offset = chunk_data->range_end_offset;
+
+	read_count = (ssize_t) ( chunk_data->range_end_offset - chunk_data->range_start_offset );
+
+	return( read_count );
+
+on_error:
+	if( chunk_data != NULL )
 	{
-		libewf_read_io_handle_free(
-		 &( internal_handle->read_io_handle ),
-		 error );
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
 	}
 	return( -1 );
 }
 
-/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
- * Returns 1 if successful or -1 on error
+/* Reads a (media) data chunk at the current offset
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
  */
-int libewf_handle_open_file_io_pool(
-     libewf_handle_t *handle,
-     libbfio_pool_t *file_io_pool,
-     int access_flags,
-     libcerror_error_t **error )
+ssize_t libewf_handle_read_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_open_file_io_pool";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_read_data_chunk";
+	ssize_t read_count                        = 0;
 
 	if( handle == NULL )
 	{
@@ -3884,64 +8084,80 @@ int libewf_handle_open_file_io_pool(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool != NULL )
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - file IO pool value already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-#if !defined( HAVE_WRITE_SUPPORT )
-	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported - compiled without zlib.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab chunk table mutex.",
 		 function );
 
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
 		return( -1 );
 	}
 #endif
-	result = libewf_internal_handle_open_file_io_pool(
-	          internal_handle,
-	          file_io_pool,
-	          access_flags,
-	          internal_handle->segment_table,
-	          error );
+	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              (libewf_internal_data_chunk_t *) data_chunk,
+	              error );
 
-	if( result != 1 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open handle using a file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
 		 function );
+
+		read_count = -1;
 	}
-	else
+#endif
+	if( read_count < 0 )
 	{
-		internal_handle->file_io_pool = file_io_pool;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data chunk.",
+		 function );
+
+		read_count = -1;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -3955,34 +8171,28 @@ int libewf_handle_open_file_io_pool(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
 #endif
-	if( result != 1 )
-	{
-		goto on_error;
-	}
-	return( 1 );
-
-on_error:
-	internal_handle->file_io_pool = NULL;
-
-	return( -1 );
+	return( read_count );
 }
 
-/* Closes the EWF handle
- * Returns 0 if successful or -1 on error
+/* Writes a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
  */
-int libewf_handle_close(
-     libewf_handle_t *handle,
-     libcerror_error_t **error )
+ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_close";
-	ssize_t write_count                       = 0;
-	int result                                = 0;
+	static char *function        = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
+	size_t data_size             = 0;
+	ssize_t write_count          = 0;
+	uint64_t current_chunk_index = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3993,298 +8203,273 @@ int libewf_handle_close(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
+	if( internal_handle->chunk_data != NULL )
 	{
-		write_count = libewf_internal_handle_write_finalize_file_io_pool(
-		               internal_handle,
-		               internal_handle->file_io_pool,
-		               error );
-
-		if( write_count < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to finalize write.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	if( internal_handle->file_io_pool_created_in_library != 0 )
+	if( internal_handle->current_offset < 0 )
 	{
-		if( libbfio_pool_close_all(
-		     internal_handle->file_io_pool,
-		     error ) != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close all file IO pool handles.",
-			 function );
-
-			result = -1;
-		}
-		if( libbfio_pool_free(
-		     &( internal_handle->file_io_pool ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file IO pool.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
 
-			result = -1;
-		}
-		internal_handle->file_io_pool_created_in_library = 0;
+		return( -1 );
 	}
-	internal_handle->file_io_pool = NULL;
-
-	if( libewf_io_handle_clear(
-	     internal_handle->io_handle,
-	     error ) != 1 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libewf_media_values_clear(
-	     internal_handle->media_values,
-	     error ) != 1 )
+	if( internal_handle->media_values->chunk_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear media values.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( internal_handle->read_io_handle != NULL )
+	if( internal_handle->write_io_handle == NULL )
 	{
-		if( libewf_read_io_handle_free(
-		     &( internal_handle->read_io_handle ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free read IO handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	if( internal_handle->write_io_handle != NULL )
+	/* A data chunk contains packed data, the integrity hash requires the media data
+	 */
+	if( internal_handle->write_io_handle->integrity_hash_flags != 0 )
 	{
-		if( libewf_write_io_handle_free(
-		     &( internal_handle->write_io_handle ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free write IO handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: writing data chunks is not supported when integrity hashing is enabled.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	/* Free the chunk data if it could not be passed to libfcache_cache_set_value_by_index
-	 */
-	if( internal_handle->chunk_data != NULL )
+	if( internal_data_chunk == NULL )
 	{
-		if( libewf_chunk_data_free(
-		     &( internal_handle->chunk_data ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk data.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	if( internal_handle->chunk_table != NULL )
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
 	{
-		if( libewf_chunk_table_free(
-		     &( internal_handle->chunk_table ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk table.",
-			 function );
-
-			result = -1;
-		}
+		return( 0 );
 	}
-	if( internal_handle->hash_sections != NULL )
+	data_size = internal_data_chunk->data_size;
+
+	if( internal_handle->media_values->media_size != 0 )
 	{
-		if( libewf_hash_sections_free(
-		     &( internal_handle->hash_sections ),
-		     error ) != 1 )
+		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free hash sections.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: last data chunk size value out of bounds.",
 			 function );
 
-			result = -1;
+			return( -1 );
 		}
 	}
-	if( internal_handle->header_values != NULL )
+/* TODO remove need to calculate */
+	current_chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	internal_handle->current_offset = (off64_t) current_chunk_index * (off64_t) internal_handle->media_values->chunk_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
 	{
-		if( libfvalue_table_free(
-		     &( internal_handle->header_values ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free header values.",
-			 function );
+		libcnotify_printf(
+		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
+		 function,
+		 current_chunk_index,
+		 data_size );
+	}
+#endif
+	/* Chunks queued by a previous write buffer must be written first
+	 */
+	if( libewf_internal_handle_write_queued_chunks_to_file_io_pool(
+	     internal_handle,
+	     file_io_pool,
+	     error ) < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write queued chunks.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	if( internal_handle->hash_values != NULL )
+	if( current_chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
 	{
-		if( libfvalue_table_free(
-		     &( internal_handle->hash_values ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free hash values.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: chunk: %" PRIu64 " already exists.",
+		 function,
+		 current_chunk_index );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	if( internal_handle->single_files != NULL )
+	if( libewf_internal_handle_initialize_segment_writer(
+	     internal_handle,
+	     error ) != 1 )
 	{
-		if( libewf_single_files_free(
-		     &( internal_handle->single_files ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free single files.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize segment writer.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->sessions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+	write_count = libewf_write_io_handle_write_new_chunk(
+	               internal_handle->write_io_handle,
+	               internal_handle->io_handle,
+	               file_io_pool,
+	               internal_handle->media_values,
+	               internal_handle->segment_table,
+	               internal_handle->header_values,
+	               internal_handle->hash_values,
+	               internal_handle->hash_sections,
+	               internal_handle->sessions,
+	               internal_handle->tracks,
+	               internal_handle->acquiry_errors,
+	               current_chunk_index,
+	               internal_data_chunk->chunk_data,
+	               data_size,
+	               error );
+
+	if( write_count < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty sessions array.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk data.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->tracks,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+	internal_handle->current_offset += (off64_t) data_size;
+
+	return( write_count );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_data_chunk";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty tracks array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libcdata_range_list_empty(
-	     internal_handle->acquiry_errors,
-	     NULL,
-	     error ) != 1 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty acquiry errors range list.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libewf_segment_table_clear(
-	     internal_handle->segment_table,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear segment table.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libewf_io_handle_clear(
-	     internal_handle->io_handle,
-	     error ) != 1 )
+#endif
+	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               (libewf_internal_data_chunk_t *) data_chunk,
+	               error );
+
+	if( write_count < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data chunk.",
 		 function );
 
-		result = -1;
+		write_count = -1;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -4298,28 +8483,29 @@ int libewf_handle_close(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
 #endif
-	return( result );
+	return( write_count );
 }
 
-/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
  */
-ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
+ssize_t libewf_internal_handle_write_finalize_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
-         void *buffer,
-         size_t buffer_size,
          libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_buffer_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	size_t buffer_offset            = 0;
-	size_t read_size                = 0;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
+	size64_t segment_file_size          = 0;
+	ssize_t write_count                 = 0;
+	ssize_t write_finalize_count        = 0;
+	uint64_t chunk_index                = 0;
+	uint32_t number_of_segments         = 0;
+	int file_io_pool_entry              = -1;
 
 	if( internal_handle == NULL )
 	{
@@ -4343,189 +8529,439 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( internal_handle->current_offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle->write_finalized != 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		return( 0 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		write_count = libewf_internal_handle_write_chunk_data_to_file_io_pool(
+		               internal_handle,
+		               file_io_pool,
+		               chunk_index,
+		               error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	/* Write the chunks that are still queued in the write pipeline
+	 */
+	write_count = libewf_internal_handle_write_queued_chunks_to_file_io_pool(
+	               internal_handle,
+	               file_io_pool,
+	               error );
+
+	if( write_count < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write queued chunks.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	write_finalize_count += write_count;
+
+	if( libewf_write_io_handle_flush_segment_writer(
+	     internal_handle->write_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush segment writer.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	/* Check if all media data has been written
+	 */
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
-		 function );
-
-		return( -1 );
+		return( write_finalize_count );
 	}
-	if( buffer == NULL )
+	/* Store the digests of the media data before the hash and digest sections are written
+	 */
+	if( internal_handle->write_io_handle->integrity_hash != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
+		if( libewf_integrity_hash_finalize(
+		     internal_handle->write_io_handle->integrity_hash,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize integrity hash.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
+		if( internal_handle->hash_values == NULL )
+		{
+			if( libewf_hash_values_initialize(
+			     &( internal_handle->hash_values ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create hash values.",
+				 function );
+
+				return( -1 );
+			}
+			internal_handle->hash_values_parsed = 1;
+		}
+		if( libewf_integrity_hash_set_hashes(
+		     internal_handle->write_io_handle->integrity_hash,
+		     internal_handle->hash_sections,
+		     internal_handle->hash_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set integrity hashes.",
+			 function );
+
+			return( -1 );
+		}
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-	{
-		return( 0 );
-	}
-	internal_handle->io_handle->abort = 0;
-
-	if( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
-	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
-	}
-	while( buffer_size > 0 )
+	if( number_of_segments == 0 )
 	{
-		if( libewf_chunk_table_get_chunk_data_by_offset(
-		     internal_handle->chunk_table,
+		/* No segment file needs to be created
+		 */
+/* TODO clean up this logic: when is this triggered? */
+		if( internal_handle->media_values->media_size != 0 )
+		{
+			return( write_finalize_count );
+		}
+		/* Create the segment file if required
+		 */
+		if( libewf_write_io_handle_create_segment_file(
 		     internal_handle->io_handle,
 		     file_io_pool,
-		     internal_handle->media_values,
 		     internal_handle->segment_table,
-		     internal_handle->current_offset,
-		     &chunk_data_offset,
-		     &chunk_data,
+		     internal_handle->io_handle->segment_file_type,
+		     0,
+		     internal_handle->write_io_handle->maximum_number_of_segments,
+		     internal_handle->media_values->set_identifier,
+		     0,
+		     &file_io_pool_entry,
+		     &segment_file,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 internal_handle->current_offset,
-			 internal_handle->current_offset );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to create segment file: 0.",
+			 function );
 
 			return( -1 );
 		}
-		if( chunk_data == NULL )
+		write_count = libewf_segment_file_write_start(
+		               segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               &( internal_handle->write_io_handle->case_data ),
+		               &( internal_handle->write_io_handle->case_data_size ),
+		               &( internal_handle->write_io_handle->device_information ),
+		               &( internal_handle->write_io_handle->device_information_size ),
+		               &( internal_handle->write_io_handle->data_section ),
+		               internal_handle->media_values,
+		               internal_handle->header_values,
+		               internal_handle->write_io_handle->timestamp,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write segment file: 0 start.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	/* Check if the last segment file is still open for writing
+	 */
+	else if( internal_handle->write_io_handle->current_segment_file != NULL )
+	{
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     internal_handle->write_io_handle->current_segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
 			 function,
-			 internal_handle->current_offset,
-			 internal_handle->current_offset );
+			 internal_handle->write_io_handle->current_segment_number );
 
 			return( -1 );
 		}
-		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+		/* Check if chunks section needs to be corrected
+		 */
+		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
+		{
+			write_count = libewf_write_io_handle_write_chunks_section_end(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+			               internal_handle->write_io_handle->current_segment_file,
+			               error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write chunks section end: %" PRIu32 ".",
+				 function,
+				 internal_handle->write_io_handle->current_segment_number );
+
+				return( -1 );
+			}
+			write_finalize_count += write_count;
+		}
+		/* Close the segment file
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: closing last segment file: %" PRIu32 ".\n",
+			 function,
+			 internal_handle->write_io_handle->current_segment_number );
+		}
+#endif
+		write_count = libewf_segment_file_write_close(
+		               internal_handle->write_io_handle->current_segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
+		               1,
+		               internal_handle->hash_sections,
+		               internal_handle->hash_values,
+		               internal_handle->media_values,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               &( internal_handle->write_io_handle->data_section ),
+		               error );
+
+		if( write_count == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to close segment file: %" PRIu32 ".",
 			 function,
-			 chunk_data->chunk_index );
+			 internal_handle->write_io_handle->current_segment_number );
 
 			return( -1 );
 		}
-		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+		write_finalize_count += write_count;
 
-		if( read_size > buffer_size )
+		internal_handle->write_io_handle->current_segment_file = NULL;
+	}
+	/* Correct the media values if streamed write was used
+	 */
+	if( internal_handle->media_values->media_size == 0 )
+	{
+		/* Determine the media values
+		 */
+		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
+		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
+		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+
+		/* Flush the section write caches
+		 */
+		if( internal_handle->write_io_handle->case_data != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->case_data );
+
+			internal_handle->write_io_handle->case_data      = NULL;
+			internal_handle->write_io_handle->case_data_size = 0;
+		}
+		if( internal_handle->write_io_handle->device_information != NULL )
 		{
-			read_size = buffer_size;
+			memory_free(
+			 internal_handle->write_io_handle->device_information );
+
+			internal_handle->write_io_handle->device_information      = NULL;
+			internal_handle->write_io_handle->device_information_size = 0;
 		}
-		if( read_size == 0 )
+		if( internal_handle->write_io_handle->data_section != NULL )
 		{
-			break;
+			memory_free(
+			 internal_handle->write_io_handle->data_section );
+
+			internal_handle->write_io_handle->data_section = NULL;
 		}
-		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( ( chunk_data->data )[ chunk_data_offset ] ),
-		     read_size ) == NULL )
+		/* Correct the sections in the segment files
+		 */
+		if( libewf_write_io_handle_finalize_write_sections_corrections(
+		     internal_handle->write_io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     internal_handle->header_values,
+		     internal_handle->hash_values,
+		     internal_handle->hash_sections,
+		     internal_handle->sessions,
+		     internal_handle->tracks,
+		     internal_handle->acquiry_errors,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
-			 function,
-			 chunk_data->chunk_index );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sections corrections to segment files.",
+			 function );
 
 			return( -1 );
 		}
-		buffer_offset += read_size;
-		buffer_size   -= read_size;
-
-		internal_handle->current_offset += (off64_t) read_size;
-
-		if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-		{
-			break;
-		}
-		if( internal_handle->io_handle->abort != 0 )
-		{
-			break;
-		}
-		chunk_data        = NULL;
-		chunk_data_offset = 0;
 	}
-	internal_handle->io_handle->abort = 0;
+	internal_handle->write_io_handle->write_finalized = 1;
 
-	return( (ssize_t) buffer_offset );
+	return( write_finalize_count );
 }
 
-/* Reads (media) data at the current offset into a buffer
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
  */
-ssize_t libewf_handle_read_buffer(
+ssize_t libewf_handle_write_finalize(
          libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
          libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer";
-	ssize_t read_count                        = 0;
+	static char *function                     = "libewf_handle_write_finalize";
+	ssize_t write_count                       = 0;
 
 	if( handle == NULL )
 	{
@@ -4566,23 +9002,21 @@ ssize_t libewf_handle_read_buffer(
 		return( -1 );
 	}
 #endif
-	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-		      internal_handle->file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
+	write_count = libewf_internal_handle_write_finalize_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               error );
 
-	if( read_count == -1 )
+	if( write_count == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 "%s: unable to write finalize.",
 		 function );
 
-		read_count = -1;
+		write_count = -1;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -4599,24 +9033,22 @@ ssize_t libewf_handle_read_buffer(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( write_count );
 }
 
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+/* Seeks a certain offset of the (media) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
  */
-ssize_t libewf_handle_read_buffer_at_offset(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
+off64_t libewf_internal_handle_seek_offset(
+         libewf_internal_handle_t *internal_handle,
          off64_t offset,
+         int whence,
          libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer_at_offset";
-	ssize_t read_count                        = 0;
+	static char *function = "libewf_internal_handle_seek_offset";
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -4627,111 +9059,98 @@ ssize_t libewf_handle_read_buffer_at_offset(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
 
-	if( internal_handle->file_io_pool == NULL )
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->media_values->chunk_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libewf_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
 		 function );
 
-		read_count = -1;
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_handle->media_values->media_size;
 	}
-	if( read_count != -1 )
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
 	{
-		read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-		              internal_handle,
-		              internal_handle->file_io_pool,
-		              buffer,
-		              buffer_size,
-		              error );
-
-		if( read_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer.",
-			 function );
-
-			read_count = -1;
-		}
+		libcnotify_printf(
+		 "%s: seeking media data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+#endif
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( read_count );
+	internal_handle->current_offset = offset;
+
+	return( offset );
 }
 
-/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
  */
-ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         const void *buffer,
-         size_t buffer_size,
+off64_t libewf_handle_seek_offset(
+         libewf_handle_t *handle,
+         off64_t offset,
+         int whence,
          libcerror_error_t **error )
 {
-	static char *function     = "libewf_internal_handle_write_buffer_to_file_io_pool";
-	size_t buffer_offset      = 0;
-	size_t input_data_size    = 0;
-	size_t write_size         = 0;
-	ssize_t write_count       = 0;
-	off64_t chunk_data_offset = 0;
-	uint64_t chunk_index      = 0;
-	int write_chunk           = 0;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_seek_offset";
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -4742,348 +9161,240 @@ ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		if( internal_handle->chunk_data != NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
-			 function );
+#endif
+	offset = libewf_internal_handle_seek_offset(
+	          internal_handle,
+	          offset,
+	          whence,
+	          error );
 
-			return( -1 );
-		}
-	}
-	if( internal_handle->media_values == NULL )
+	if( offset == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
 		 function );
-
-		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle == NULL )
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (media) data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_offset(
+     libewf_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_offset";
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+#endif
+	*offset = internal_handle->current_offset;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
-	{
-		return( 0 );
-	}
-	internal_handle->io_handle->abort = 0;
+#endif
+	return( 1 );
+}
 
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
-	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
-	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+/* Sets the maximum number of (concurrent) open file handles
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_number_of_open_handles(
+     libewf_handle_t *handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+	int result                                = 1;
 
-	if( chunk_index >= (uint64_t) INT_MAX )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk index value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
-	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
+	if( internal_handle->parent_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk data offset value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - image state is shared with parent handle.",
 		 function );
 
 		return( -1 );
 	}
-	while( buffer_size > 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		if( internal_handle->write_io_handle->write_finalized != 0 )
-		{
-			break;
-		}
-		if( internal_handle->chunk_data == NULL )
-		{
-			if( libewf_chunk_data_initialize(
-			     &( internal_handle->chunk_data ),
-			     internal_handle->media_values->chunk_size,
-			     0,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
-
-				return( -1 );
-			}
-		}
-		if( internal_handle->chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		if( chunk_data_offset > internal_handle->media_values->chunk_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk offset exceeds chunk data size.",
-			 function );
-
-			return( -1 );
-		}
-		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
-
-		if( write_size > buffer_size )
-		{
-			write_size = buffer_size;
-		}
-		if( write_size == 0 )
-		{
-			break;
-		}
-		if( memory_copy(
-		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     write_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy buffer to chunk data.",
-			 function );
-
-			return( -1 );
-		}
-		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
-
-		buffer_offset += write_size;
-		buffer_size   -= write_size;
-
-		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
-		{
-			write_chunk = 1;
-		}
-		else if( ( internal_handle->media_values->media_size != 0 )
-		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
-		{
-			write_chunk = 1;
-		}
-		else
-		{
-			write_chunk = 0;
-		}
-		if( write_chunk != 0 )
-		{
-			input_data_size = internal_handle->chunk_data->data_size;
-
-			if( libewf_chunk_data_pack(
-			     internal_handle->chunk_data,
-			     internal_handle->io_handle,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-			     internal_handle->write_io_handle->pack_flags,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to pack chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
-
-				return( -1 );
-			}
-			write_count = libewf_write_io_handle_write_new_chunk(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-			               file_io_pool,
-			               internal_handle->media_values,
-			               internal_handle->segment_table,
-			               internal_handle->header_values,
-			               internal_handle->hash_values,
-			               internal_handle->hash_sections,
-			               internal_handle->sessions,
-			               internal_handle->tracks,
-			               internal_handle->acquiry_errors,
-			               chunk_index,
-			               internal_handle->chunk_data,
-			               input_data_size,
-			               error );
-
-			if( write_count <= 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write new chunk.",
-				 function );
-
-				return( -1 );
-			}
-			if( libewf_chunk_data_free(
-			     &( internal_handle->chunk_data ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free chunk data.",
-				 function );
-
-				return( -1 );
-			}
-		}
-		chunk_index      += 1;
-		chunk_data_offset = 0;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-		internal_handle->current_offset += (off64_t) write_size;
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+		result = libbfio_pool_set_maximum_number_of_open_handles(
+		          internal_handle->file_io_pool,
+		          maximum_number_of_open_handles,
+		          error );
 
-		if( ( internal_handle->media_values->media_size != 0 )
-		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
-		{
-			break;
-		}
-		if( internal_handle->io_handle->abort != 0 )
+		if( result != 1 )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in file IO pool.",
+			 function );
 		}
 	}
-	internal_handle->io_handle->abort = 0;
+	if( result == 1 )
+	{
+		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-	return( (ssize_t) buffer_offset );
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Writes (media) data at the current offset
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Sets the read-ahead depth
+ * The depth is the number of chunks that are read ahead when the media data is read sequentially,
+ * where 0 disables read-ahead
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_buffer(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_handle_set_read_ahead_depth(
+     libewf_handle_t *handle,
+     int depth,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_set_read_ahead_depth";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -5098,13 +9409,14 @@ ssize_t libewf_handle_write_buffer(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( ( depth < 0 )
+	 || ( depth > LIBEWF_READ_AHEAD_MAXIMUM_DEPTH ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid depth value out of bounds.",
 		 function );
 
 		return( -1 );
@@ -5123,47 +9435,123 @@ ssize_t libewf_handle_write_buffer(
 
 		return( -1 );
 	}
-#endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
+	/* The read-ahead is recreated on the next read
+	 */
+	if( internal_handle->read_ahead != NULL )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
+		result = libewf_read_ahead_free(
+		          &( internal_handle->read_ahead ),
+		          error );
+
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
 			 function );
-
-			write_count = -1;
 		}
 	}
-	if( write_count != -1 )
+#endif
+	if( result == 1 )
 	{
-		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-		               internal_handle,
-		               internal_handle->file_io_pool,
-		               buffer,
-		               buffer_size,
-		               error );
+		internal_handle->read_ahead_depth = depth;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-		if( write_count == -1 )
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the number of read-ahead worker threads
+ * Read-ahead is only used when the library was built with multi-thread support,
+ * where 0 disables read-ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_read_ahead_number_of_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_read_ahead_number_of_threads";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_READ_AHEAD_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	/* The read-ahead is recreated on the next read
+	 */
+	if( internal_handle->read_ahead != NULL )
+	{
+		result = libewf_read_ahead_free(
+		          &( internal_handle->read_ahead ),
+		          error );
+
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to write buffer.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
 			 function );
-
-			write_count = -1;
 		}
 	}
+#endif
+	if( result == 1 )
+	{
+		internal_handle->read_ahead_number_of_threads = number_of_threads;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -5179,24 +9567,21 @@ ssize_t libewf_handle_write_buffer(
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( result );
 }
 
-/* Writes (media) data at a specific offset,
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Sets the number of worker threads used to scan the segment files on open
+ * Scanning is only done in parallel when the library was built with multi-thread support,
+ * where 0 scans the segment files one at a time
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_buffer_at_offset(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libewf_handle_set_segment_scan_number_of_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer_at_offset";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_set_segment_scan_number_of_threads";
 
 	if( handle == NULL )
 	{
@@ -5211,13 +9596,89 @@ ssize_t libewf_handle_write_buffer_at_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_SEGMENT_SCANNER_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->segment_scan_number_of_threads = number_of_threads;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the number of write pipeline worker threads
+ * The write pipeline packs the chunks written with libewf_handle_write_buffer on worker threads
+ * and is only used when the library was built with multi-thread support,
+ * where 0 packs the chunks on the calling thread
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_write_pipeline_number_of_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_write_pipeline_number_of_threads";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_WRITE_PIPELINE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
 		 function );
 
 		return( -1 );
@@ -5236,64 +9697,42 @@ ssize_t libewf_handle_write_buffer_at_offset(
 
 		return( -1 );
 	}
-#endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
+	/* The write pipeline is recreated on the next write
+	 */
+	if( internal_handle->write_pipeline != NULL )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
+		if( internal_handle->write_pipeline->number_of_queued_entries > 0 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - write pipeline contains queued chunks.",
 			 function );
 
-			write_count = -1;
+			result = -1;
 		}
-	}
-	if( write_count != -1 )
-	{
-		if( libewf_internal_handle_seek_offset(
-		     internal_handle,
-		     offset,
-		     SEEK_SET,
-		     error ) == -1 )
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset.",
-			 function );
+			result = libewf_write_pipeline_free(
+			          &( internal_handle->write_pipeline ),
+			          error );
 
-			write_count = -1;
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free write pipeline.",
+				 function );
+			}
 		}
 	}
-	if( write_count != -1 )
+#endif
+	if( result == 1 )
 	{
-		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-		               internal_handle,
-		               internal_handle->file_io_pool,
-		               buffer,
-		               buffer_size,
-		               error );
-
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to write buffer.",
-			 function );
-
-			write_count = -1;
-		}
+		internal_handle->write_pipeline_number_of_threads = number_of_threads;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -5310,19 +9749,22 @@ ssize_t libewf_handle_write_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( result );
 }
 
-/* Retrieves a (media) data chunk
+/* Sets the segment writer buffer size
+ * The segment writer buffers the chunks written to the segment files into writes of
+ * the buffer size, which are done on a separate thread when the library was built
+ * with multi-thread support, where 0 writes every chunk directly
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_data_chunk(
+int libewf_handle_set_segment_writer_buffer_size(
      libewf_handle_t *handle,
-     libewf_data_chunk_t **data_chunk,
+     size_t buffer_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_data_chunk";
+	static char *function                     = "libewf_handle_set_segment_writer_buffer_size";
 	int result                                = 1;
 
 	if( handle == NULL )
@@ -5338,35 +9780,15 @@ int libewf_handle_get_data_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
-
-		return( -1 );
-	}
-	if( data_chunk == NULL )
+	if( ( buffer_size != 0 )
+	 && ( ( buffer_size < (size_t) LIBEWF_SEGMENT_WRITER_MINIMUM_BUFFER_SIZE )
+	  ||  ( buffer_size > (size_t) LIBEWF_SEGMENT_WRITER_MAXIMUM_BUFFER_SIZE ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
-		 function );
-
-		return( -1 );
-	}
-	if( *data_chunk != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: data chunk value already set.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
 		 function );
 
 		return( -1 );
@@ -5386,44 +9808,45 @@ int libewf_handle_get_data_chunk(
 		return( -1 );
 	}
 #endif
+	/* The segment writer is recreated on the next write
+	 */
 	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
+	 && ( internal_handle->write_io_handle->segment_writer != NULL ) )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
+		result = libewf_write_io_handle_flush_segment_writer(
+		          internal_handle->write_io_handle,
+		          error );
+
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush segment writer.",
 			 function );
-
-			result = -1;
 		}
-	}
-	if( result != -1 )
-	{
-		if( libewf_data_chunk_initialize(
-		     data_chunk,
-		     internal_handle->io_handle,
-		     internal_handle->write_io_handle,
-		     error ) != 1 )
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create data chunk.",
-			 function );
+			result = libewf_segment_writer_free(
+			          &( internal_handle->write_io_handle->segment_writer ),
+			          error );
 
-			result = -1;
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free segment writer.",
+				 function );
+			}
 		}
 	}
+	if( result == 1 )
+	{
+		internal_handle->segment_writer_buffer_size = buffer_size;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -5442,22 +9865,22 @@ int libewf_handle_get_data_chunk(
 	return( result );
 }
 
-/* Reads a (media) data chunk at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
+/* Sets the use direct IO value
+ * Direct IO bypasses the operating system page cache when reading and writing
+ * the segment files opened or created by the handle, where 0 uses buffered IO
+ * The value must be set before the handle is opened
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
-         libcerror_error_t **error )
+int libewf_handle_set_use_direct_io(
+     libewf_handle_t *handle,
+     uint8_t use_direct_io,
+     libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	size_t read_count               = 0;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_use_direct_io";
+	int result                                = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5468,6 +9891,8 @@ ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
 
 		return( -1 );
 	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
 	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -5479,123 +9904,77 @@ ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+#if !defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT )
+	if( use_direct_io != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: direct IO not supported.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+#endif
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#endif
+	if( internal_handle->file_io_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool already set.",
 		 function );
 
-		return( -1 );
-	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-	{
-		return( 0 );
-	}
-	if( libewf_chunk_table_get_chunk_data_by_offset_no_cache(
-	     internal_handle->chunk_table,
-	     internal_handle->io_handle,
-	     file_io_pool,
-	     internal_handle->media_values,
-	     internal_handle->segment_table,
-	     internal_handle->current_offset,
-	     &chunk_data_offset,
-	     &chunk_data,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 internal_handle->current_offset,
-		 internal_handle->current_offset );
-
-		goto on_error;
+		result = -1;
 	}
-	if( chunk_data == NULL )
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 internal_handle->current_offset,
-		 internal_handle->current_offset );
-
-		goto on_error;
+		internal_handle->io_handle->use_direct_io = use_direct_io;
 	}
-	/* data_chunk takes over management of chunk_data
-	 */
-	if( libewf_internal_data_chunk_set_chunk_data(
-	     internal_data_chunk,
-	     chunk_data,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
-		 function,
-		 chunk_data->chunk_index );
-
-		goto on_error;
-	}
-	internal_handle->current_offset = chunk_data->range_end_offset;
-
-	read_count = (ssize_t) ( chunk_data->range_end_offset - chunk_data->range_start_offset );
-
-	return( read_count );
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-on_error:
-	if( chunk_data != NULL )
-	{
-		libewf_chunk_data_free(
-		 &chunk_data,
-		 NULL );
+		return( -1 );
 	}
-	return( -1 );
+#endif
+	return( result );
 }
 
-/* Reads a (media) data chunk at the current offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
+/* Retrieves the chunk cache budget
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_read_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
+int libewf_handle_get_cache_budget(
+     libewf_handle_t *handle,
+     size64_t *budget,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_data_chunk";
-	ssize_t read_count                        = 0;
+	static char *function                     = "libewf_handle_get_cache_budget";
 
 	if( handle == NULL )
 	{
@@ -5610,19 +9989,19 @@ ssize_t libewf_handle_read_data_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( budget == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid budget.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5630,31 +10009,16 @@ ssize_t libewf_handle_read_data_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
-	              internal_handle,
-	              internal_handle->file_io_pool,
-	              (libewf_internal_data_chunk_t *) data_chunk,
-	              error );
-
-	if( read_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read data chunk.",
-		 function );
+	*budget = internal_handle->chunk_cache_budget;
 
-		read_count = -1;
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5662,31 +10026,30 @@ ssize_t libewf_handle_read_data_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( 1 );
 }
 
-/* Writes a (media) data chunk at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Sets the chunk cache budget
+ * The budget is the maximum number of bytes of chunk data that is cached,
+ * where 0 disables caching of chunk data between reads
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
-         libcerror_error_t **error )
+int libewf_handle_set_cache_budget(
+     libewf_handle_t *handle,
+     size64_t budget,
+     libcerror_error_t **error )
 {
-	static char *function        = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
-	size_t data_size             = 0;
-	ssize_t write_count          = 0;
-	uint64_t current_chunk_index = 0;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_cache_budget";
+	int result                                = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5697,175 +10060,263 @@ ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->parent_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - image state is shared with parent handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( budget > (size64_t) INT64_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid budget value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
 		 function );
 
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#endif
+	if( internal_handle->chunk_table != NULL )
+	{
+		result = libewf_chunk_cache_set_budget(
+		          internal_handle->chunk_table->chunk_cache,
+		          budget,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk cache budget.",
+			 function );
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->chunk_cache_budget = budget;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
 		 function );
 
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle == NULL )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_data_chunk == NULL )
+#endif
+	return( result );
+}
+
+/* Retrieves the number of chunk cache hits
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_number_of_cache_hits(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_number_of_cache_hits";
+	uint64_t safe_number_of_hits              = 0;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( number_of_hits == NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
 	}
-	data_size = internal_data_chunk->data_size;
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-	if( internal_handle->media_values->media_size != 0 )
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
 	{
-		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->chunk_table != NULL )
+	{
+		if( libewf_chunk_cache_get_number_of_hits(
+		     internal_handle->chunk_table->chunk_cache,
+		     &safe_number_of_hits,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: last data chunk size value out of bounds.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of chunk cache hits.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 	}
-/* TODO remove need to calculate */
-	current_chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
-
-	internal_handle->current_offset = (off64_t) current_chunk_index * (off64_t) internal_handle->media_values->chunk_size;
+	*number_of_hits = safe_number_of_hits;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
-		 function,
-		 current_chunk_index,
-		 data_size );
-	}
-#endif
-	if( current_chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: chunk: %" PRIu64 " already exists.",
-		 function,
-		 current_chunk_index );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 internal_handle->read_write_lock,
+		 NULL );
 
 		return( -1 );
 	}
-	write_count = libewf_write_io_handle_write_new_chunk(
-	               internal_handle->write_io_handle,
-	               internal_handle->io_handle,
-	               file_io_pool,
-	               internal_handle->media_values,
-	               internal_handle->segment_table,
-	               internal_handle->header_values,
-	               internal_handle->hash_values,
-	               internal_handle->hash_sections,
-	               internal_handle->sessions,
-	               internal_handle->tracks,
-	               internal_handle->acquiry_errors,
-	               current_chunk_index,
-	               internal_data_chunk->chunk_data,
-	               data_size,
-	               error );
-
-	if( write_count < 0 )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write chunk data.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset += (off64_t) data_size;
+#endif
+	return( 1 );
 
-	return( write_count );
-}
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 internal_handle->chunk_table_mutex,
+	 NULL );
 
-/* Writes a (media) data chunk at the current offset
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
- */
-ssize_t libewf_handle_write_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the number of chunk cache misses
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_number_of_cache_misses(
+     libewf_handle_t *handle,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_data_chunk";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_get_number_of_cache_misses";
+	uint64_t safe_number_of_misses            = 0;
 
 	if( handle == NULL )
 	{
@@ -5880,19 +10331,19 @@ ssize_t libewf_handle_write_data_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( number_of_misses == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5900,31 +10351,67 @@ ssize_t libewf_handle_write_data_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
 		 function );
 
+		libcthreads_read_write_lock_release_for_read(
+		 internal_handle->read_write_lock,
+		 NULL );
+
 		return( -1 );
 	}
 #endif
-	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               (libewf_internal_data_chunk_t *) data_chunk,
-	               error );
+	if( internal_handle->chunk_table != NULL )
+	{
+		if( libewf_chunk_cache_get_number_of_misses(
+		     internal_handle->chunk_table->chunk_cache,
+		     &safe_number_of_misses,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of chunk cache misses.",
+			 function );
 
-	if( write_count < 0 )
+			goto on_error;
+		}
+	}
+	*number_of_misses = safe_number_of_misses;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
 		 function );
 
-		write_count = -1;
+		libcthreads_read_write_lock_release_for_read(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5932,35 +10419,43 @@ ssize_t libewf_handle_write_data_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 internal_handle->chunk_table_mutex,
+	 NULL );
+
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+/* Sets the index filename
+ * The index file contains the sections and chunk tables of the segment files
+ * and is used, if valid, to open the segment files without reading their chunk tables
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_write_finalize_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libcerror_error_t **error )
+int libewf_handle_set_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
-	size64_t segment_file_size          = 0;
-	size_t input_data_size              = 0;
-	ssize_t write_count                 = 0;
-	ssize_t write_finalize_count        = 0;
-	uint64_t chunk_index                = 0;
-	uint32_t number_of_segments         = 0;
-	int file_io_pool_entry              = -1;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_index_filename";
+	int result                                = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5971,171 +10466,231 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: index filename cannot be changed.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+#endif
+	if( internal_handle->index_file == NULL )
 	{
-		if( internal_handle->chunk_data != NULL )
+		result = libewf_index_file_initialize(
+		          &( internal_handle->index_file ),
+		          error );
+
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create index file.",
 			 function );
+		}
+	}
+	if( result == 1 )
+	{
+		result = libewf_index_file_set_name(
+		          internal_handle->index_file,
+		          filename,
+		          filename_length,
+		          error );
 
-			return( -1 );
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set index filename.",
+			 function );
 		}
 	}
-	if( internal_handle->write_io_handle == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing write IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#endif
+	return( result );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the index filename
+ * The index file contains the sections and chunk tables of the segment files
+ * and is used, if valid, to open the segment files without reading their chunk tables
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_index_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_index_filename_wide";
+	int result                                = 1;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: index filename cannot be changed.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle->write_finalized != 0 )
-	{
-		return( 0 );
-	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+#endif
+	if( internal_handle->index_file == NULL )
 	{
-		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+		result = libewf_index_file_initialize(
+		          &( internal_handle->index_file ),
+		          error );
 
-		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create index file.",
+			 function );
 		}
-		input_data_size = internal_handle->chunk_data->data_size;
+	}
+	if( result == 1 )
+	{
+		result = libewf_index_file_set_name_wide(
+		          internal_handle->index_file,
+		          filename,
+		          filename_length,
+		          error );
 
-		if( libewf_chunk_data_pack(
-		     internal_handle->chunk_data,
-		     internal_handle->io_handle,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-		     internal_handle->write_io_handle->pack_flags,
-		     error ) != 1 )
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to pack chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set index filename.",
+			 function );
 		}
-		write_count = libewf_write_io_handle_write_new_chunk(
-			       internal_handle->write_io_handle,
-			       internal_handle->io_handle,
-			       file_io_pool,
-			       internal_handle->media_values,
-			       internal_handle->segment_table,
-			       internal_handle->header_values,
-			       internal_handle->hash_values,
-			       internal_handle->hash_sections,
-			       internal_handle->sessions,
-			       internal_handle->tracks,
-			       internal_handle->acquiry_errors,
-			       chunk_index,
-			       internal_handle->chunk_data,
-			       input_data_size,
-			       error );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-		if( write_count <= 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write new chunk.",
-			 function );
+		return( -1 );
+	}
+#endif
+	return( result );
+}
 
-			return( -1 );
-		}
-		write_finalize_count += write_count;
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Writes the index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_write_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_write_index_file";
+	size64_t segment_file_size          = 0;
+	uint32_t number_of_segments         = 0;
+	uint32_t segment_index              = 0;
+	int file_io_pool_entry              = 0;
 
-		if( libewf_chunk_data_free(
-		     &( internal_handle->chunk_data ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk data.",
-			 function );
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	/* Check if all media data has been written
-	 */
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	if( internal_handle->media_values == NULL )
 	{
-		return( write_finalize_count );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
 	}
 	if( libewf_segment_table_get_number_of_segments(
 	     internal_handle->segment_table,
@@ -6146,77 +10701,32 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments.",
+		 "%s: unable to retrieve number of segments from segment table.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_segments == 0 )
+	if( libewf_index_file_open_write(
+	     internal_handle->index_file,
+	     internal_handle->media_values->chunk_size,
+	     error ) != 1 )
 	{
-		/* No segment file needs to be created
-		 */
-/* TODO clean up this logic: when is this triggered? */
-		if( internal_handle->media_values->media_size != 0 )
-		{
-			return( write_finalize_count );
-		}
-		/* Create the segment file if required
-		 */
-		if( libewf_write_io_handle_create_segment_file(
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->segment_table,
-		     internal_handle->io_handle->segment_file_type,
-		     0,
-		     internal_handle->write_io_handle->maximum_number_of_segments,
-		     internal_handle->media_values->set_identifier,
-		     &file_io_pool_entry,
-		     &segment_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to create segment file: 0.",
-			 function );
-
-			return( -1 );
-		}
-		write_count = libewf_segment_file_write_start(
-		               segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               &( internal_handle->write_io_handle->case_data ),
-		               &( internal_handle->write_io_handle->case_data_size ),
-		               &( internal_handle->write_io_handle->device_information ),
-		               &( internal_handle->write_io_handle->device_information_size ),
-		               &( internal_handle->write_io_handle->data_section ),
-		               internal_handle->media_values,
-		               internal_handle->header_values,
-		               internal_handle->write_io_handle->timestamp,
-		               error );
-
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write segment file: 0 start.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file.",
+		 function );
 
-			return( -1 );
-		}
-		write_finalize_count += write_count;
+		return( -1 );
 	}
-	/* Check if the last segment file is still open for writing
-	 */
-	else if( internal_handle->write_io_handle->current_segment_file != NULL )
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
 	{
 		if( libewf_segment_table_get_segment_by_index(
 		     internal_handle->segment_table,
-		     internal_handle->write_io_handle->current_segment_number,
+		     segment_index,
 		     &file_io_pool_entry,
 		     &segment_file_size,
 		     error ) != 1 )
@@ -6227,154 +10737,93 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
 			 function,
-			 internal_handle->write_io_handle->current_segment_number );
-
-			return( -1 );
-		}
-		/* Check if chunks section needs to be corrected
-		 */
-		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
-		{
-			write_count = libewf_write_io_handle_write_chunks_section_end(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-				       file_io_pool,
-				       file_io_pool_entry,
-			               internal_handle->write_io_handle->current_segment_file,
-			               error );
+			 segment_index );
 
-			if( write_count == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write chunks section end: %" PRIu32 ".",
-				 function,
-				 internal_handle->write_io_handle->current_segment_number );
-
-				return( -1 );
-			}
-			write_finalize_count += write_count;
+			goto on_error;
 		}
-		/* Close the segment file
-		 */
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		if( libewf_segment_table_get_segment_file_by_index(
+		     internal_handle->segment_table,
+		     segment_index,
+		     internal_handle->file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
 		{
-			libcnotify_printf(
-			 "%s: closing last segment file: %" PRIu32 ".\n",
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
 			 function,
-			 internal_handle->write_io_handle->current_segment_number );
-		}
-#endif
-		write_count = libewf_segment_file_write_close(
-		               internal_handle->write_io_handle->current_segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
-		               1,
-		               internal_handle->hash_sections,
-		               internal_handle->hash_values,
-		               internal_handle->media_values,
-		               internal_handle->sessions,
-		               internal_handle->tracks,
-		               internal_handle->acquiry_errors,
-		               &( internal_handle->write_io_handle->data_section ),
-		               error );
+			 segment_index );
 
-		if( write_count == -1 )
+			goto on_error;
+		}
+		if( libewf_segment_file_write_index_segment(
+		     segment_file,
+		     internal_handle->file_io_pool,
+		     file_io_pool_entry,
+		     segment_file_size,
+		     internal_handle->index_file,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to close segment file: %" PRIu32 ".",
+			 "%s: unable to write segment file: %" PRIu32 " to index file.",
 			 function,
-			 internal_handle->write_io_handle->current_segment_number );
+			 segment_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		write_finalize_count += write_count;
-
-		internal_handle->write_io_handle->current_segment_file = NULL;
 	}
-	/* Correct the media values if streamed write was used
-	 */
-	if( internal_handle->media_values->media_size == 0 )
+	if( libewf_index_file_write_segments(
+	     internal_handle->index_file,
+	     error ) != 1 )
 	{
-		/* Determine the media values
-		 */
-		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
-		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
-		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
-
-		/* Flush the section write caches
-		 */
-		if( internal_handle->write_io_handle->case_data != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->case_data );
-
-			internal_handle->write_io_handle->case_data      = NULL;
-			internal_handle->write_io_handle->case_data_size = 0;
-		}
-		if( internal_handle->write_io_handle->device_information != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->device_information );
-
-			internal_handle->write_io_handle->device_information      = NULL;
-			internal_handle->write_io_handle->device_information_size = 0;
-		}
-		if( internal_handle->write_io_handle->data_section != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->data_section );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write segments to index file.",
+		 function );
 
-			internal_handle->write_io_handle->data_section = NULL;
-		}
-		/* Correct the sections in the segment files
-		 */
-		if( libewf_write_io_handle_finalize_write_sections_corrections(
-		     internal_handle->write_io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->header_values,
-		     internal_handle->hash_values,
-		     internal_handle->hash_sections,
-		     internal_handle->sessions,
-		     internal_handle->tracks,
-		     internal_handle->acquiry_errors,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write sections corrections to segment files.",
-			 function );
+		goto on_error;
+	}
+	if( libewf_index_file_close(
+	     internal_handle->index_file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	internal_handle->write_io_handle->write_finalized = 1;
+	return( 1 );
 
-	return( write_finalize_count );
+on_error:
+	libewf_index_file_close(
+	 internal_handle->index_file,
+	 NULL );
+
+	return( -1 );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+/* Writes the index file
+ * The index file is only written if it was not used when opening the handle
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_finalize(
-         libewf_handle_t *handle,
-         libcerror_error_t **error )
+int libewf_handle_write_index_file(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_finalize";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_write_index_file";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -6389,13 +10838,37 @@ ssize_t libewf_handle_write_finalize(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->file_io_pool == NULL )
+	 || ( internal_handle->read_io_handle == NULL )
+	 || ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - not opened for reading.",
 		 function );
 
 		return( -1 );
@@ -6414,24 +10887,60 @@ ssize_t libewf_handle_write_finalize(
 
 		return( -1 );
 	}
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
 #endif
-	write_count = libewf_internal_handle_write_finalize_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               error );
+	/* An index file that was used to open the handle matches the segment files
+	 */
+	if( internal_handle->io_handle->index_file == NULL )
+	{
+		result = libewf_internal_handle_write_index_file(
+		          internal_handle,
+		          error );
 
-	if( write_count == -1 )
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write index file.",
+			 function );
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write finalize.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
 		 function );
 
-		write_count = -1;
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
@@ -6446,22 +10955,21 @@ ssize_t libewf_handle_write_finalize(
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+/* Determine if the segment files are corrupted
+ * Returns 1 if corrupted, 0 if not or -1 on error
  */
-off64_t libewf_internal_handle_seek_offset(
-         libewf_internal_handle_t *internal_handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_segment_files_corrupted(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
 {
-	static char *function = "libewf_internal_handle_seek_offset";
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_segment_files_corrupted";
+	int result                                = 0;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -6472,96 +10980,136 @@ off64_t libewf_internal_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#endif
+	result = ( internal_handle->segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED ) != 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+#endif
+	return( result );
+}
+
+/* Determine if the segment files are encrypted
+ * Returns 1 if encrypted, 0 if not or -1 on error
+ */
+int libewf_handle_segment_files_encrypted(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_segment_files_encrypted";
+	int result                                = 0;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_handle->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_handle->media_values->media_size;
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		libcnotify_printf(
-		 "%s: seeking media data offset: %" PRIi64 ".\n",
-		 function,
-		 offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
 	}
 #endif
-	if( offset < 0 )
+	result = (int) internal_handle->io_handle->is_encrypted;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset = offset;
-
-	return( offset );
+#endif
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
+/* Retrieves the segment filename size
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if not set or -1 on error
  */
-off64_t libewf_handle_seek_offset(
-         libewf_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_get_segment_filename_size(
+     libewf_handle_t *handle,
+     size_t *filename_size,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_seek_offset";
+	static char *function                     = "libewf_handle_get_segment_filename_size";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -6576,19 +11124,8 @@ off64_t libewf_handle_seek_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6596,29 +11133,28 @@ off64_t libewf_handle_seek_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	offset = libewf_internal_handle_seek_offset(
-	          internal_handle,
-	          offset,
-	          whence,
+	result = libewf_segment_table_get_basename_size(
+	          internal_handle->segment_table,
+	          filename_size,
 	          error );
 
-	if( offset == -1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename size.",
 		 function );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6626,25 +11162,28 @@ off64_t libewf_handle_seek_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( result );
 }
 
-/* Retrieves the current offset of the (media) data
- * Returns 1 if successful or -1 on error
+/* Retrieves the segment filename
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if not set or -1 on error
  */
-int libewf_handle_get_offset(
+int libewf_handle_get_segment_filename(
      libewf_handle_t *handle,
-     off64_t *offset,
+     char *filename,
+     size_t filename_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_offset";
+	static char *function                     = "libewf_handle_get_segment_filename";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -6659,17 +11198,6 @@ int libewf_handle_get_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( offset == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
@@ -6685,8 +11213,21 @@ int libewf_handle_get_offset(
 		return( -1 );
 	}
 #endif
-	*offset = internal_handle->current_offset;
+	result = libewf_segment_table_get_basename(
+	          internal_handle->segment_table,
+	          filename,
+	          filename_size,
+	          error );
 
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename.",
+		 function );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -6702,20 +11243,21 @@ int libewf_handle_get_offset(
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Sets the maximum number of (concurrent) open file handles
+/* Sets the segment file
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_maximum_number_of_open_handles(
+int libewf_handle_set_segment_filename(
      libewf_handle_t *handle,
-     int maximum_number_of_open_handles,
+     const char *filename,
+     size_t filename_length,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
-	int result                                = 1;
+	static char *function                     = "libewf_handle_set_segment_filename";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -6730,6 +11272,17 @@ int libewf_handle_set_maximum_number_of_open_handles(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: segment filename cannot be changed.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -6745,26 +11298,20 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->file_io_pool != NULL )
-	{
-		result = libbfio_pool_set_maximum_number_of_open_handles(
-		          internal_handle->file_io_pool,
-		          maximum_number_of_open_handles,
-		          error );
+	result = libewf_segment_table_set_basename(
+	          internal_handle->segment_table,
+	          filename,
+	          filename_length,
+	          error );
 
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum number of open handles in file IO pool.",
-			 function );
-		}
-	}
-	if( result == 1 )
+	if( result != 1 )
 	{
-		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment table basename.",
+		 function );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -6784,15 +11331,19 @@ int libewf_handle_set_maximum_number_of_open_handles(
 	return( result );
 }
 
-/* Determine if the segment files are corrupted
- * Returns 1 if corrupted, 0 if not or -1 on error
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Retrieves the segment filename size
+ * The filename size includes the end of string character
+ * Returns 1 if successful, 0 if not set or -1 on error
  */
-int libewf_handle_segment_files_corrupted(
+int libewf_handle_get_segment_filename_size_wide(
      libewf_handle_t *handle,
+     size_t *filename_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_segment_files_corrupted";
+	static char *function                     = "libewf_handle_get_segment_filename_size_wide";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -6808,17 +11359,6 @@ int libewf_handle_segment_files_corrupted(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
@@ -6834,8 +11374,20 @@ int libewf_handle_segment_files_corrupted(
 		return( -1 );
 	}
 #endif
-	result = ( internal_handle->segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED ) != 0;
+	result = libewf_segment_table_get_basename_size_wide(
+	          internal_handle->segment_table,
+	          filename_size,
+	          error );
 
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename size.",
+		 function );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -6854,15 +11406,18 @@ int libewf_handle_segment_files_corrupted(
 	return( result );
 }
 
-/* Determine if the segment files are encrypted
- * Returns 1 if encrypted, 0 if not or -1 on error
+/* Retrieves the segment filename
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if not set or -1 on error
  */
-int libewf_handle_segment_files_encrypted(
+int libewf_handle_get_segment_filename_wide(
      libewf_handle_t *handle,
+     wchar_t *filename,
+     size_t filename_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_segment_files_encrypted";
+	static char *function                     = "libewf_handle_get_segment_filename_wide";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -6878,17 +11433,6 @@ int libewf_handle_segment_files_encrypted(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
@@ -6904,8 +11448,21 @@ int libewf_handle_segment_files_encrypted(
 		return( -1 );
 	}
 #endif
-	result = (int) internal_handle->io_handle->is_encrypted;
+	result = libewf_segment_table_get_basename_wide(
+	          internal_handle->segment_table,
+	          filename,
+	          filename_size,
+	          error );
 
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename.",
+		 function );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -6924,17 +11481,17 @@ int libewf_handle_segment_files_encrypted(
 	return( result );
 }
 
-/* Retrieves the segment filename size
- * The filename size should include the end of string character
- * Returns 1 if successful, 0 if not set or -1 on error
+/* Sets the segment file
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_segment_filename_size(
+int libewf_handle_set_segment_filename_wide(
      libewf_handle_t *handle,
-     size_t *filename_size,
+     const wchar_t *filename,
+     size_t filename_length,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename_size";
+	static char *function                     = "libewf_handle_set_segment_filename_wide";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -6950,8 +11507,19 @@ int libewf_handle_get_segment_filename_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: segment filename cannot be changed.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6959,28 +11527,29 @@ int libewf_handle_get_segment_filename_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	result = libewf_segment_table_get_basename_size(
+	result = libewf_segment_table_set_basename_wide(
 	          internal_handle->segment_table,
-	          filename_size,
+	          filename,
+	          filename_length,
 	          error );
 
-	if( result == -1 )
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment table basename.",
 		 function );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6988,7 +11557,7 @@ int libewf_handle_get_segment_filename_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -6997,33 +11566,54 @@ int libewf_handle_get_segment_filename_size(
 	return( result );
 }
 
-/* Retrieves the segment filename
- * The filename size should include the end of string character
- * Returns 1 if successful, 0 if not set or -1 on error
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Retrieves the maximum segment file size
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_segment_filename(
+int libewf_handle_get_maximum_segment_size(
      libewf_handle_t *handle,
-     char *filename,
-     size_t filename_size,
+     size64_t *maximum_segment_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_get_maximum_segment_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
 
-	if( handle == NULL )
+		return( -1 );
+	}
+	if( maximum_segment_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid maximum segment size.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
@@ -7039,21 +11629,8 @@ int libewf_handle_get_segment_filename(
 		return( -1 );
 	}
 #endif
-	result = libewf_segment_table_get_basename(
-	          internal_handle->segment_table,
-	          filename,
-	          filename_size,
-	          error );
+	*maximum_segment_size = internal_handle->segment_table->maximum_segment_size;
 
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename.",
-		 function );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -7069,21 +11646,23 @@ int libewf_handle_get_segment_filename(
 		return( -1 );
 	}
 #endif
-	return( result );
+	return( 1 );
 }
 
-/* Sets the segment file
+/* Sets the maximum segment file size
+ * A maximum segment file size of 0 represents the maximum possible size for the format
+ * If the maximum segment file size is smaller than the size needed to store a single chunk
+ * the size off the latter is enforced and not the maximum segment file size
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_segment_filename(
+int libewf_handle_set_maximum_segment_size(
      libewf_handle_t *handle,
-     const char *filename,
-     size_t filename_length,
+     size64_t maximum_segment_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_segment_filename";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_set_maximum_segment_size";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -7098,49 +11677,41 @@ int libewf_handle_set_segment_filename(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->write_io_handle == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: segment filename cannot be changed.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	result = libewf_segment_table_set_basename(
-	          internal_handle->segment_table,
-	          filename,
-	          filename_length,
-	          error );
-
-	if( result != 1 )
+	if( maximum_segment_size > (size64_t) INT64_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set segment table basename.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum segment size value exceeds maximum.",
 		 function );
+
+		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -7148,74 +11719,42 @@ int libewf_handle_set_segment_filename(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( result );
-}
-
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Retrieves the segment filename size
- * The filename size includes the end of string character
- * Returns 1 if successful, 0 if not set or -1 on error
- */
-int libewf_handle_get_segment_filename_size_wide(
-     libewf_handle_t *handle,
-     size_t *filename_size,
-     libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename_size_wide";
-	int result                                = 0;
-
-	if( handle == NULL )
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: maximum segment size cannot be changed.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	else if( maximum_segment_size > internal_handle->write_io_handle->maximum_segment_file_size )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment file size value out of bounds.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
-	result = libewf_segment_table_get_basename_size_wide(
-	          internal_handle->segment_table,
-	          filename_size,
-	          error );
-
-	if( result == -1 )
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename size.",
-		 function );
+		internal_handle->segment_table->maximum_segment_size = maximum_segment_size;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -7223,7 +11762,7 @@ int libewf_handle_get_segment_filename_size_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -7232,19 +11771,20 @@ int libewf_handle_get_segment_filename_size_wide(
 	return( result );
 }
 
-/* Retrieves the segment filename
- * The filename size should include the end of string character
- * Returns 1 if successful, 0 if not set or -1 on error
+/* Sets the preallocate segment files value
+ * Preallocating reserves the space of a new segment file when it is created
+ * to reduce fragmentation, where 0 represents no preallocation
+ * The space that is not used is released when the segment file is closed
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_segment_filename_wide(
+int libewf_handle_set_preallocate_segment_files(
      libewf_handle_t *handle,
-     wchar_t *filename,
-     size_t filename_size,
+     uint8_t preallocate_segment_files,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename_wide";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_set_preallocate_segment_files";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -7260,7 +11800,7 @@ int libewf_handle_get_segment_filename_wide(
 	internal_handle = (libewf_internal_handle_t *) handle;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -7268,29 +11808,31 @@ int libewf_handle_get_segment_filename_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	result = libewf_segment_table_get_basename_wide(
-	          internal_handle->segment_table,
-	          filename,
-	          filename_size,
-	          error );
-
-	if( result == -1 )
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: preallocate segment files cannot be changed.",
 		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->write_io_handle->preallocate_segment_files = preallocate_segment_files;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -7298,7 +11840,7 @@ int libewf_handle_get_segment_filename_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -7307,18 +11849,20 @@ int libewf_handle_get_segment_filename_wide(
 	return( result );
 }
 
-/* Sets the segment file
+/* Sets the chunks section alignment
+ * The chunk data of every chunks section starts at a multiple of the alignment
+ * in the segment file, such as the file system block size
+ * The alignment must be a power of 2, where 0 represents no alignment
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_segment_filename_wide(
+int libewf_handle_set_chunks_section_alignment(
      libewf_handle_t *handle,
-     const wchar_t *filename,
-     size_t filename_length,
+     uint32_t alignment,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_segment_filename_wide";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_set_chunks_section_alignment";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -7333,13 +11877,14 @@ int libewf_handle_set_segment_filename_wide(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->write_io_handle == NULL )
+	if( ( alignment > LIBEWF_MAXIMUM_CHUNKS_SECTION_ALIGNMENT )
+	 || ( ( alignment & ( alignment - 1 ) ) != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: segment filename cannot be changed.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported alignment.",
 		 function );
 
 		return( -1 );
@@ -7359,20 +11904,22 @@ int libewf_handle_set_segment_filename_wide(
 		return( -1 );
 	}
 #endif
-	result = libewf_segment_table_set_basename_wide(
-	          internal_handle->segment_table,
-	          filename,
-	          filename_length,
-	          error );
-
-	if( result != 1 )
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set segment table basename.",
+		 "%s: chunks section alignment cannot be changed.",
 		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->write_io_handle->chunks_section_alignment = alignment;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -7392,18 +11939,20 @@ int libewf_handle_set_segment_filename_wide(
 	return( result );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
-
-/* Retrieves the maximum segment file size
+/* Sets the deduplicate chunks value
+ * Deduplication stores the packed data of identical chunks in a chunks section only once,
+ * where 0 represents no deduplication
+ * It is only supported by the EWFX format
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_maximum_segment_size(
+int libewf_handle_set_deduplicate_chunks(
      libewf_handle_t *handle,
-     size64_t *maximum_segment_size,
+     uint8_t deduplicate_chunks,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_maximum_segment_size";
+	static char *function                     = "libewf_handle_set_deduplicate_chunks";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -7418,47 +11967,40 @@ int libewf_handle_get_maximum_segment_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
-		 function );
-
-		return( -1 );
-	}
-	if( maximum_segment_size == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid maximum segment size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+#endif
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: deduplicate chunks cannot be changed.",
 		 function );
 
-		return( -1 );
+		result = -1;
+	}
+	else
+	{
+		internal_handle->write_io_handle->deduplicate_chunks = deduplicate_chunks;
 	}
-#endif
-	*maximum_segment_size = internal_handle->segment_table->maximum_segment_size;
-
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -7466,28 +12008,28 @@ int libewf_handle_get_maximum_segment_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Sets the maximum segment file size
- * A maximum segment file size of 0 represents the maximum possible size for the format
- * If the maximum segment file size is smaller than the size needed to store a single chunk
- * the size off the latter is enforced and not the maximum segment file size
+/* Sets the integrity hash flags
+ * The flags define the digests libewf calculates of the media data while it is written,
+ * where 0 represents no integrity hashing
+ * The calculated digests are stored in the hash and digest sections when the write is finalized
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_maximum_segment_size(
+int libewf_handle_set_integrity_hash_flags(
      libewf_handle_t *handle,
-     size64_t maximum_segment_size,
+     uint8_t integrity_hash_flags,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_segment_size";
+	static char *function                     = "libewf_handle_set_integrity_hash_flags";
 	int result                                = 1;
 
 	if( handle == NULL )
@@ -7503,36 +12045,15 @@ int libewf_handle_set_maximum_segment_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->segment_table == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
-		 function );
-
-		return( -1 );
-	}
-	if( maximum_segment_size > (size64_t) INT64_MAX )
+	if( ( integrity_hash_flags & ~( LIBEWF_INTEGRITY_HASH_FLAG_MD5 | LIBEWF_INTEGRITY_HASH_FLAG_SHA1 | LIBEWF_INTEGRITY_HASH_FLAG_SHA256 ) ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid maximum segment size value exceeds maximum.",
-		 function );
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported integrity hash flags: 0x%02" PRIx8 ".",
+		 function,
+		 integrity_hash_flags );
 
 		return( -1 );
 	}
@@ -7559,25 +12080,14 @@ int libewf_handle_set_maximum_segment_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: maximum segment size cannot be changed.",
-		 function );
-
-		result = -1;
-	}
-	else if( maximum_segment_size > internal_handle->write_io_handle->maximum_segment_file_size )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid segment file size value out of bounds.",
+		 "%s: integrity hash flags cannot be changed.",
 		 function );
 
 		result = -1;
 	}
 	else
 	{
-		internal_handle->segment_table->maximum_segment_size = maximum_segment_size;
+		internal_handle->write_io_handle->integrity_hash_flags = integrity_hash_flags;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -7653,6 +12163,26 @@ int libewf_handle_get_filename_size(
 		 "%s: unable to retrieve file IO handle for current chunk.",
 		 function );
 	}
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT )
+	else if( ( result != 0 )
+	      && ( internal_handle->io_handle->use_direct_io != 0 ) )
+	{
+		result = libewf_direct_file_get_name_size(
+		          file_io_handle,
+		          filename_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename size.",
+			 function );
+		}
+	}
+#endif
 	else if( result != 0 )
 	{
 		result = libbfio_file_get_name_size(
@@ -7745,6 +12275,27 @@ int libewf_handle_get_filename(
 		 "%s: unable to retrieve file IO handle for current chunk.",
 		 function );
 	}
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT )
+	else if( ( result != 0 )
+	      && ( internal_handle->io_handle->use_direct_io != 0 ) )
+	{
+		result = libewf_direct_file_get_name(
+		          file_io_handle,
+		          filename,
+		          filename_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename.",
+			 function );
+		}
+	}
+#endif
 	else if( result != 0 )
 	{
 		result = libbfio_file_get_name(
@@ -7839,6 +12390,26 @@ int libewf_handle_get_filename_size_wide(
 		 "%s: unable to retrieve file IO handle for current chunk.",
 		 function );
 	}
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT )
+	else if( ( result != 0 )
+	      && ( internal_handle->io_handle->use_direct_io != 0 ) )
+	{
+		result = libewf_direct_file_get_name_size_wide(
+		          file_io_handle,
+		          filename_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename size.",
+			 function );
+		}
+	}
+#endif
 	else if( result != 0 )
 	{
 		result = libbfio_file_get_name_size_wide(
@@ -7931,6 +12502,27 @@ int libewf_handle_get_filename_wide(
 		 "%s: unable to retrieve file IO handle for current chunk.",
 		 function );
 	}
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT )
+	else if( ( result != 0 )
+	      && ( internal_handle->io_handle->use_direct_io != 0 ) )
+	{
+		result = libewf_direct_file_get_name_wide(
+		          file_io_handle,
+		          filename,
+		          filename_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename.",
+			 function );
+		}
+	}
+#endif
 	else if( result != 0 )
 	{
 		result = libbfio_file_get_name_wide(
@@ -12275,6 +16867,17 @@ int libewf_handle_set_read_zero_chunk_on_error(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( internal_handle->parent_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - image state is shared with parent handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -12358,6 +16961,17 @@ int libewf_handle_copy_media_values(
 	internal_destination_handle = (libewf_internal_handle_t *) destination_handle;
 	internal_source_handle      = (libewf_internal_handle_t *) source_handle;
 
+	if( internal_destination_handle->parent_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination handle - image state is shared with parent handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_source_handle->media_values == NULL )
 	{
 		libcerror_error_set(
@@ -12609,6 +17223,17 @@ int libewf_handle_append_acquiry_error(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( internal_handle->parent_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - image state is shared with parent handle.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -12710,6 +17335,23 @@ int libewf_handle_get_number_of_checksum_errors(
 
 		return( -1 );
 	}
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
 #endif
 	if( internal_handle->chunk_table != NULL )
 	{
@@ -12731,6 +17373,23 @@ int libewf_handle_get_number_of_checksum_errors(
 	*number_of_errors = number_of_elements;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
@@ -12749,6 +17408,10 @@ int libewf_handle_get_number_of_checksum_errors(
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 internal_handle->chunk_table_mutex,
+	 NULL );
+
 	libcthreads_read_write_lock_release_for_read(
 	 internal_handle->read_write_lock,
 	 NULL );
@@ -12808,6 +17471,23 @@ int libewf_handle_get_checksum_error(
 
 		return( -1 );
 	}
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
 #endif
 	result = libewf_chunk_table_get_checksum_error(
 	          internal_handle->chunk_table,
@@ -12827,6 +17507,23 @@ int libewf_handle_get_checksum_error(
 		 error_index );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
@@ -12870,6 +17567,17 @@ int libewf_handle_append_checksum_error(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( internal_handle->parent_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - image state is shared with parent handle.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -12884,6 +17592,23 @@ int libewf_handle_append_checksum_error(
 
 		return( -1 );
 	}
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
 #endif
 	result = libewf_chunk_table_append_checksum_error(
 	          internal_handle->chunk_table,
@@ -12901,6 +17626,23 @@ int libewf_handle_append_checksum_error(
 		 function );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
@@ -13128,6 +17870,17 @@ int libewf_handle_append_session(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( internal_handle->parent_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - image state is shared with parent handle.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -13386,6 +18139,17 @@ int libewf_handle_append_track(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( internal_handle->parent_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - image state is shared with parent handle.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -13539,6 +18303,17 @@ int libewf_handle_set_header_codepage(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( internal_handle->parent_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - image state is shared with parent handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -14659,6 +19434,17 @@ int libewf_handle_copy_header_values(
 	internal_destination_handle = (libewf_internal_handle_t *) destination_handle;
 	internal_source_handle      = (libewf_internal_handle_t *) source_handle;
 
+	if( internal_destination_handle->parent_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination handle - image state is shared with parent handle.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_source_handle->read_write_lock,
@@ -31,6 +31,7 @@
 #include "libewf_data_chunk.h"
 #include "libewf_extern.h"
 #include "libewf_hash_sections.h"
+#include "libewf_index_file.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
@@ -40,11 +41,13 @@
 #include "libewf_libfvalue.h"
 #include "libewf_io_handle.h"
 #include "libewf_media_values.h"
+#include "libewf_read_ahead.h"
 #include "libewf_read_io_handle.h"
 #include "libewf_segment_table.h"
 #include "libewf_single_files.h"
 #include "libewf_types.h"
 #include "libewf_write_io_handle.h"
+#include "libewf_write_pipeline.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -94,6 +97,30 @@ struct libewf_internal_handle
 	 */
 	int maximum_number_of_open_handles;
 
+	/* The read-ahead depth, which is the number of chunks to read ahead
+	 */
+	int read_ahead_depth;
+
+	/* The number of read-ahead worker threads
+	 */
+	int read_ahead_number_of_threads;
+
+	/* The number of segment file scanner worker threads
+	 */
+	int segment_scan_number_of_threads;
+
+	/* The number of write pipeline worker threads
+	 */
+	int write_pipeline_number_of_threads;
+
+	/* The segment writer buffer size, where 0 disables the segment writer
+	 */
+	size_t segment_writer_buffer_size;
+
+	/* The chunk cache budget, which is the maximum number of bytes of chunk data to cache
+	 */
+	size64_t chunk_cache_budget;
+
 	/* The current (storage media) offset
 	 */
 	off64_t current_offset;
@@ -138,7 +165,43 @@ struct libewf_internal_handle
 	 */
 	libewf_single_files_t *single_files;
 
+	/* The index file
+	 */
+	libewf_index_file_t *index_file;
+
+	/* The parent handle
+	 * This is set if the handle is a reader handle that shares the image state of the parent handle
+	 */
+	libewf_internal_handle_t *parent_handle;
+
+	/* The number of reader handles that share the image state
+	 */
+	int number_of_reader_handles;
+
+	/* Value to indicate the handle was freed while reader handles still shared its image state
+	 */
+	uint8_t free_pending;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The chunk read-ahead
+	 */
+	libewf_read_ahead_t *read_ahead;
+
+	/* The chunk write pipeline
+	 */
+	libewf_write_pipeline_t *write_pipeline;
+
+	/* The chunk table mutex
+	 * This serializes access to the chunk table, chunk cache and segment table
+	 * by readers that hold the read/write lock for reading
+	 */
+	libcthreads_mutex_t *chunk_table_mutex;
+
+	/* Value to indicate the read IO handle is in use by a read at a specific offset
+	 * This is protected by the chunk table mutex
+	 */
+	uint8_t read_io_handle_in_use;
+
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
@@ -161,6 +224,12 @@ int libewf_handle_clone(
      libewf_handle_t *source_handle,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_clone_reader(
+     libewf_handle_t **destination_handle,
+     libewf_handle_t *source_handle,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_signal_abort(
      libewf_handle_t *handle,
@@ -220,6 +289,10 @@ int libewf_handle_open_file_io_pool(
      int access_flags,
      libcerror_error_t **error );
 
+int libewf_internal_handle_close_reader(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_close(
      libewf_handle_t *handle,
@@ -232,6 +305,31 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
          size_t buffer_size,
          libcerror_error_t **error );
 
+ssize_t libewf_internal_handle_read_chunk_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_read_io_handle_t *read_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_internal_handle_release_read_io_handle(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+ssize_t libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_read_buffer(
          libewf_handle_t *handle,
@@ -247,6 +345,30 @@ ssize_t libewf_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+ssize_t libewf_internal_handle_write_queued_chunk_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+int libewf_internal_handle_initialize_segment_writer(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_write_queued_chunks_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_write_chunk_data_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint64_t chunk_index,
+         libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -334,6 +456,93 @@ int libewf_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_set_read_ahead_depth(
+     libewf_handle_t *handle,
+     int depth,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_read_ahead_number_of_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_segment_scan_number_of_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_write_pipeline_number_of_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_segment_writer_buffer_size(
+     libewf_handle_t *handle,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_use_direct_io(
+     libewf_handle_t *handle,
+     uint8_t use_direct_io,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_cache_budget(
+     libewf_handle_t *handle,
+     size64_t *budget,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_cache_budget(
+     libewf_handle_t *handle,
+     size64_t budget,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_cache_hits(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_cache_misses(
+     libewf_handle_t *handle,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libewf_internal_handle_write_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_write_index_file(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_segment_files_corrupted(
      libewf_handle_t *handle,
@@ -400,6 +609,30 @@ int libewf_handle_set_maximum_segment_size(
      size64_t maximum_segment_size,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_set_preallocate_segment_files(
+     libewf_handle_t *handle,
+     uint8_t preallocate_segment_files,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_chunks_section_alignment(
+     libewf_handle_t *handle,
+     uint32_t alignment,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_deduplicate_chunks(
+     libewf_handle_t *handle,
+     uint8_t deduplicate_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_integrity_hash_flags(
+     libewf_handle_t *handle,
+     uint8_t integrity_hash_flags,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_filename_size(
      libewf_handle_t *handle,
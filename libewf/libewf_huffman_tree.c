@@ -253,14 +253,19 @@ int libewf_huffman_tree_build(
      int number_of_code_sizes,
      libcerror_error_t **error )
 {
-	int *symbol_offsets   = NULL;
-	static char *function = "libewf_huffman_tree_build";
-	size_t array_size     = 0;
-	uint16_t symbol       = 0;
-	uint8_t bit_index     = 0;
-	uint8_t code_size     = 0;
-	int code_offset       = 0;
-	int left_value        = 0;
+	int *symbol_offsets    = NULL;
+	static char *function  = "libewf_huffman_tree_build";
+	size_t array_size      = 0;
+	uint32_t huffman_code  = 0;
+	uint32_t lookup_index  = 0;
+	uint32_t reversed_code = 0;
+	uint16_t symbol        = 0;
+	uint8_t bit_index      = 0;
+	uint8_t code_size      = 0;
+	int code_offset        = 0;
+	int code_size_index    = 0;
+	int left_value         = 0;
+	int symbol_index       = 0;
 
 	if( huffman_tree == NULL )
 	{
@@ -296,6 +301,20 @@ int libewf_huffman_tree_build(
 
 		return( -1 );
 	}
+	if( memory_set(
+	     huffman_tree->lookup_table,
+	     0,
+	     sizeof( uint16_t ) * ( 1 << LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_NUMBER_OF_BITS ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lookup table.",
+		 function );
+
+		goto on_error;
+	}
 	/* Determine the code size frequencies
 	 */
 	array_size = sizeof( int ) * ( huffman_tree->maximum_code_size + 1 );
@@ -434,6 +453,43 @@ int libewf_huffman_tree_build(
 
 		huffman_tree->symbols[ code_offset ] = symbol;
 	}
+	/* Fill the lookup table with the canonical codes that fit in the table
+	 * The codes are stored in reversed bit order since a back-to-front bit stream
+	 * provides the first bit of a code in the least significant bit
+	 */
+	for( bit_index = 1;
+	     bit_index <= huffman_tree->maximum_code_size;
+	     bit_index++ )
+	{
+		for( code_size_index = 0;
+		     code_size_index < huffman_tree->code_size_counts[ bit_index ];
+		     code_size_index++ )
+		{
+			if( bit_index <= LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_NUMBER_OF_BITS )
+			{
+				reversed_code = 0;
+
+				for( code_size = 0;
+				     code_size < bit_index;
+				     code_size++ )
+				{
+					reversed_code <<= 1;
+					reversed_code  |= ( huffman_code >> code_size ) & 0x00000001UL;
+				}
+				symbol = huffman_tree->symbols[ symbol_index ];
+
+				for( lookup_index = reversed_code;
+				     lookup_index < ( 1 << LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_NUMBER_OF_BITS );
+				     lookup_index += (uint32_t) 1 << bit_index )
+				{
+					huffman_tree->lookup_table[ lookup_index ] = (uint16_t) ( ( symbol << 4 ) | bit_index );
+				}
+			}
+			huffman_code++;
+			symbol_index++;
+		}
+		huffman_code <<= 1;
+	}
 	memory_free(
 	 symbol_offsets );
 
@@ -459,6 +515,7 @@ int libewf_huffman_tree_get_symbol_from_bit_stream(
 {
 	static char *function  = "libewf_huffman_tree_get_symbol_from_bit_stream";
 	uint32_t value_32bit   = 0;
+	uint16_t lookup_value  = 0;
 	uint16_t safe_symbol   = 0;
 	uint8_t bit_index      = 0;
 	int code_size_count    = 0;
@@ -500,43 +557,109 @@ int libewf_huffman_tree_get_symbol_from_bit_stream(
 
 		return( -1 );
 	}
-/* TODO get maximum_code_size of bits into local bit buffer */
-
-	for( bit_index = 1;
-	     bit_index <= huffman_tree->maximum_code_size;
-	     bit_index++ )
+	if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
 	{
-		if( libewf_bit_stream_get_value(
-		     bit_stream,
-		     1,
-		     &value_32bit,
-		     error ) != 1 )
+		if( bit_stream->bit_buffer_size < huffman_tree->maximum_code_size )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from bit stream.",
-			 function );
-
-			return( -1 );
+			if( libewf_bit_stream_fill_bit_buffer(
+			     bit_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to fill bit buffer.",
+				 function );
+
+				return( -1 );
+			}
 		}
-		huffman_code <<= 1;
-		huffman_code  |= (int) value_32bit;
+		lookup_value = huffman_tree->lookup_table[ bit_stream->bit_buffer & ( ( 1 << LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_NUMBER_OF_BITS ) - 1 ) ];
 
-		code_size_count = huffman_tree->code_size_counts[ bit_index ];
+		bit_index = (uint8_t) ( lookup_value & 0x000f );
 
-		if( ( huffman_code - code_size_count ) < first_huffman_code )
+		if( ( bit_index != 0 )
+		 && ( bit_index <= bit_stream->bit_buffer_size ) )
 		{
-			safe_symbol = huffman_tree->symbols[ first_index + ( huffman_code - first_huffman_code ) ];
+			safe_symbol = lookup_value >> 4;
 
 			result = 1;
-
-			break;
 		}
-		first_huffman_code  += code_size_count;
-		first_huffman_code <<= 1;
-		first_index         += code_size_count;
+		else
+		{
+			/* Codes larger than the lookup table are decoded from the bits in the bit buffer
+			 */
+			for( bit_index = 1;
+			     bit_index <= huffman_tree->maximum_code_size;
+			     bit_index++ )
+			{
+				if( bit_index > bit_stream->bit_buffer_size )
+				{
+					break;
+				}
+				huffman_code <<= 1;
+				huffman_code  |= (int) ( ( bit_stream->bit_buffer >> ( bit_index - 1 ) ) & 0x00000001UL );
+
+				code_size_count = huffman_tree->code_size_counts[ bit_index ];
+
+				if( ( huffman_code - code_size_count ) < first_huffman_code )
+				{
+					safe_symbol = huffman_tree->symbols[ first_index + ( huffman_code - first_huffman_code ) ];
+
+					result = 1;
+
+					break;
+				}
+				first_huffman_code  += code_size_count;
+				first_huffman_code <<= 1;
+				first_index         += code_size_count;
+			}
+		}
+		if( result == 1 )
+		{
+			bit_stream->bit_buffer     >>= bit_index;
+			bit_stream->bit_buffer_size -= bit_index;
+		}
+	}
+	else
+	{
+		for( bit_index = 1;
+		     bit_index <= huffman_tree->maximum_code_size;
+		     bit_index++ )
+		{
+			if( libewf_bit_stream_get_value(
+			     bit_stream,
+			     1,
+			     &value_32bit,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value from bit stream.",
+				 function );
+
+				return( -1 );
+			}
+			huffman_code <<= 1;
+			huffman_code  |= (int) value_32bit;
+
+			code_size_count = huffman_tree->code_size_counts[ bit_index ];
+
+			if( ( huffman_code - code_size_count ) < first_huffman_code )
+			{
+				safe_symbol = huffman_tree->symbols[ first_index + ( huffman_code - first_huffman_code ) ];
+
+				result = 1;
+
+				break;
+			}
+			first_huffman_code  += code_size_count;
+			first_huffman_code <<= 1;
+			first_index         += code_size_count;
+		}
 	}
 	if( result != 1 )
 	{
@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libewf_bit_stream.h"
+#include "libewf_definitions.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
@@ -47,6 +48,12 @@ struct libewf_huffman_tree
 	/* The code size counts array
 	 */
 	int *code_size_counts;
+
+	/* The lookup table, indexed by the next bits in a back-to-front bit stream
+	 * Each entry contains ( symbol << 4 ) | code size or 0 if the code is larger
+	 * than the lookup table
+	 */
+	uint16_t lookup_table[ 1 << LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_NUMBER_OF_BITS ];
 };
 
 int libewf_huffman_tree_initialize(
@@ -0,0 +1,1638 @@
+/*
+ * Index file functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_checksum.h"
+#include "libewf_definitions.h"
+#include "libewf_index_file.h"
+#include "libewf_index_segment.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+
+#include "ewf_index.h"
+
+const uint8_t ewf_index_file_signature[ 8 ] = { 0x45, 0x57, 0x46, 0x49, 0x4e, 0x44, 0x45, 0x58 };
+
+/* Creates an index file
+ * Make sure the value index_file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_initialize(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_initialize";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*index_file = memory_allocate_structure(
+	               libewf_index_file_t );
+
+	if( *index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *index_file,
+	     0,
+	     sizeof( libewf_index_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index file.",
+		 function );
+
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &( ( *index_file )->file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *index_file )->segments_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segments array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *index_file != NULL )
+	{
+		if( ( *index_file )->file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *index_file )->file_io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_free(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_free";
+	int result            = 1;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file != NULL )
+	{
+		if( ( *index_file )->access_flags != 0 )
+		{
+			if( libewf_index_file_close(
+			     *index_file,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close index file.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcdata_array_free(
+		     &( ( *index_file )->segments_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_index_segment_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segments array.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *index_file )->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+	}
+	return( result );
+}
+
+/* Sets the name of the index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_set_name(
+     libewf_index_file_t *index_file,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_set_name";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->access_flags != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_set_name(
+	     index_file->file_io_handle,
+	     name,
+	     name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the name of the index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_set_name_wide(
+     libewf_index_file_t *index_file,
+     const wchar_t *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_set_name_wide";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->access_flags != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_set_name_wide(
+	     index_file->file_io_handle,
+	     name,
+	     name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Opens the index file for reading
+ * Returns 1 if successful, 0 if the index file does not exist or is not valid or -1 on error
+ */
+int libewf_index_file_open_read(
+     libewf_index_file_t *index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_open_read";
+	int result            = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->access_flags != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file - already open.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_handle_exists(
+	          index_file->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if index file exists.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libbfio_handle_open(
+	     index_file->file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file.",
+		 function );
+
+		return( -1 );
+	}
+	index_file->access_flags = LIBBFIO_OPEN_READ;
+
+	result = libewf_index_file_read_file_io_handle(
+	          index_file,
+	          index_file->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index file.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libewf_index_file_close(
+		     index_file,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close index file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	libewf_index_file_close(
+	 index_file,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Opens the index file for writing
+ * The index file is truncated if it exists
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_open_write(
+     libewf_index_file_t *index_file,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_open_write";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->access_flags != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chunk size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_open(
+	     index_file->file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file.",
+		 function );
+
+		return( -1 );
+	}
+	index_file->access_flags       = LIBBFIO_OPEN_WRITE_TRUNCATE;
+	index_file->chunk_size         = chunk_size;
+	index_file->chunks_data_offset = (off64_t) sizeof( ewf_index_file_header_t );
+
+	return( 1 );
+}
+
+/* Closes the index file
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_index_file_close(
+     libewf_index_file_t *index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_close";
+	int result            = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->access_flags != 0 )
+	{
+		if( libbfio_handle_close(
+		     index_file->file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		index_file->access_flags = 0;
+	}
+	if( libcdata_array_empty(
+	     index_file->segments_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_index_segment_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty segments array.",
+		 function );
+
+		result = -1;
+	}
+	index_file->chunk_size         = 0;
+	index_file->chunks_data_offset = 0;
+
+	return( result );
+}
+
+/* Reads the index file header and segments
+ * Returns 1 if successful, 0 if the index file is not valid or -1 on error
+ */
+int libewf_index_file_read_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	ewf_index_file_header_t file_header;
+
+	libewf_index_segment_t *index_segment = NULL;
+	uint8_t *segments_data                = NULL;
+	static char *function                 = "libewf_index_file_read_file_io_handle";
+	size64_t file_size                    = 0;
+	size64_t segments_data_size           = 0;
+	size_t segments_data_offset           = 0;
+	ssize_t read_count                    = 0;
+	uint64_t index_file_offset            = 0;
+	uint32_t calculated_checksum          = 0;
+	uint32_t format_version               = 0;
+	uint32_t number_of_segments           = 0;
+	uint32_t segment_number               = 0;
+	uint32_t stored_checksum              = 0;
+	int entry_index                       = 0;
+	int result                            = 1;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_size < (size64_t) sizeof( ewf_index_file_header_t ) )
+	{
+		return( 0 );
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              (uint8_t *) &file_header,
+	              sizeof( ewf_index_file_header_t ),
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) sizeof( ewf_index_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     file_header.signature,
+	     ewf_index_file_signature,
+	     8 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header.checksum,
+	 stored_checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     (uint8_t *) &file_header,
+	     sizeof( ewf_index_file_header_t ) - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: header checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").\n",
+			 function,
+			 stored_checksum,
+			 calculated_checksum );
+		}
+#endif
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header.format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header.chunk_size,
+	 index_file->chunk_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header.number_of_segments,
+	 number_of_segments );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header.segments_data_checksum,
+	 stored_checksum );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 file_header.segments_data_offset,
+	 index_file_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 file_header.segments_data_size,
+	 segments_data_size );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: format version\t\t\t: %" PRIu32 "\n",
+		 function,
+		 format_version );
+
+		libcnotify_printf(
+		 "%s: chunk size\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 index_file->chunk_size );
+
+		libcnotify_printf(
+		 "%s: number of segments\t\t\t: %" PRIu32 "\n",
+		 function,
+		 number_of_segments );
+
+		libcnotify_printf(
+		 "%s: segments data offset\t\t: 0x%08" PRIx64 "\n",
+		 function,
+		 index_file_offset );
+
+		libcnotify_printf(
+		 "%s: segments data size\t\t\t: %" PRIu64 "\n",
+		 function,
+		 segments_data_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	if( ( format_version != LIBEWF_INDEX_FILE_FORMAT_VERSION )
+	 || ( index_file->chunk_size == 0 )
+	 || ( number_of_segments == 0 ) )
+	{
+		return( 0 );
+	}
+	if( ( index_file_offset < (uint64_t) sizeof( ewf_index_file_header_t ) )
+	 || ( index_file_offset > file_size )
+	 || ( segments_data_size > ( file_size - index_file_offset ) )
+	 || ( segments_data_size < (size64_t) sizeof( ewf_index_segment_t ) )
+	 || ( segments_data_size > (size64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		return( 0 );
+	}
+	segments_data = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * (size_t) segments_data_size );
+
+	if( segments_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segments data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              segments_data,
+	              (size_t) segments_data_size,
+	              (off64_t) index_file_offset,
+	              error );
+
+	if( read_count != (ssize_t) segments_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segments data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     segments_data,
+	     (size_t) segments_data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: segments data checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").\n",
+			 function,
+			 stored_checksum,
+			 calculated_checksum );
+		}
+#endif
+		result = 0;
+	}
+	for( segment_number = 1;
+	     ( result == 1 ) && ( segment_number <= number_of_segments );
+	     segment_number++ )
+	{
+		if( segments_data_offset >= (size_t) segments_data_size )
+		{
+			result = 0;
+
+			break;
+		}
+		if( libewf_index_segment_initialize(
+		     &index_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create index segment.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libewf_index_segment_read_data(
+		              index_segment,
+		              &( segments_data[ segments_data_offset ] ),
+		              (size_t) segments_data_size - segments_data_offset,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read index segment: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		segments_data_offset += (size_t) read_count;
+
+		/* The segments are stored in order of their segment number
+		 */
+		if( index_segment->segment_number != segment_number )
+		{
+			result = 0;
+
+			break;
+		}
+		if( libcdata_array_append_entry(
+		     index_file->segments_array,
+		     &entry_index,
+		     (intptr_t *) index_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append index segment: %" PRIu32 " to array.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		index_segment = NULL;
+	}
+	if( index_segment != NULL )
+	{
+		if( libewf_index_segment_free(
+		     &index_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index segment.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 segments_data );
+
+	return( result );
+
+on_error:
+	if( index_segment != NULL )
+	{
+		libewf_index_segment_free(
+		 &index_segment,
+		 NULL );
+	}
+	if( segments_data != NULL )
+	{
+		memory_free(
+		 segments_data );
+	}
+	libcdata_array_empty(
+	 index_file->segments_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_index_segment_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves a specific index segment
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_index_file_get_segment_by_number(
+     libewf_index_file_t *index_file,
+     uint32_t segment_number,
+     libewf_index_segment_t **index_segment,
+     libcerror_error_t **error )
+{
+	libewf_index_segment_t *safe_index_segment = NULL;
+	static char *function                      = "libewf_index_file_get_segment_by_number";
+	int number_of_segments                     = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_file->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_number == 0 )
+	 || ( segment_number > (uint32_t) number_of_segments ) )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     index_file->segments_array,
+	     (int) ( segment_number - 1 ),
+	     (intptr_t **) &safe_index_segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index segment: %" PRIu32 ".",
+		 function,
+		 segment_number );
+
+		return( -1 );
+	}
+	if( safe_index_segment == NULL )
+	{
+		return( 0 );
+	}
+	*index_segment = safe_index_segment;
+
+	return( 1 );
+}
+
+/* Appends an index segment
+ * The index segments must be appended in order of their segment number
+ * The index file takes over management of the index segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_append_segment(
+     libewf_index_file_t *index_file,
+     libewf_index_segment_t *index_segment,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_index_file_append_segment";
+	int entry_index        = 0;
+	int number_of_segments = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_file->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_segment->segment_number != (uint32_t) ( number_of_segments + 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid index segment - segment number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_append_entry(
+	     index_file->segments_array,
+	     &entry_index,
+	     (intptr_t *) index_segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append index segment to array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the chunks data of an index chunk group
+ * Returns 1 if successful, 0 if the chunks data is not available or not valid or -1 on error
+ */
+int libewf_index_file_read_chunks_data(
+     libewf_index_file_t *index_file,
+     libewf_index_chunk_group_t *index_chunk_group,
+     uint8_t *chunks_data,
+     size_t chunks_data_size,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_index_file_read_chunks_data";
+	ssize_t read_count           = 0;
+	uint32_t calculated_checksum = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->access_flags != LIBBFIO_OPEN_READ )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid index file - not open for reading.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunks_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunks_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunks data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( index_chunk_group->chunks_offset == 0 )
+	 || ( chunks_data_size != ( (size_t) index_chunk_group->number_of_chunks * sizeof( ewf_index_chunk_t ) ) ) )
+	{
+		return( 0 );
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              index_file->file_io_handle,
+	              chunks_data,
+	              chunks_data_size,
+	              index_chunk_group->chunks_offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunks data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 index_chunk_group->chunks_offset,
+		 index_chunk_group->chunks_offset );
+
+		return( -1 );
+	}
+	else if( read_count != (ssize_t) chunks_data_size )
+	{
+		return( 0 );
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     chunks_data,
+	     chunks_data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_chunk_group->chunks_checksum != calculated_checksum )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: chunks data checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").\n",
+			 function,
+			 index_chunk_group->chunks_checksum,
+			 calculated_checksum );
+		}
+#endif
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Writes the chunks data of an index chunk group
+ * Sets the chunks offset, number of chunks and checksum of the index chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_write_chunks_data(
+     libewf_index_file_t *index_file,
+     libewf_index_chunk_group_t *index_chunk_group,
+     const uint8_t *chunks_data,
+     size_t chunks_data_size,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_index_file_write_chunks_data";
+	ssize_t write_count          = 0;
+	uint32_t calculated_checksum = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->access_flags != LIBBFIO_OPEN_WRITE_TRUNCATE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid index file - not open for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunks_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunks_data_size == 0 )
+	 || ( chunks_data_size > (size_t) SSIZE_MAX )
+	 || ( ( chunks_data_size % sizeof( ewf_index_chunk_t ) ) != 0 )
+	 || ( ( chunks_data_size / sizeof( ewf_index_chunk_t ) ) > (size_t) UINT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunks data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     chunks_data,
+	     chunks_data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libbfio_handle_write_buffer_at_offset(
+	               index_file->file_io_handle,
+	               chunks_data,
+	               chunks_data_size,
+	               index_file->chunks_data_offset,
+	               error );
+
+	if( write_count != (ssize_t) chunks_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunks data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 index_file->chunks_data_offset,
+		 index_file->chunks_data_offset );
+
+		return( -1 );
+	}
+	index_chunk_group->chunks_offset    = index_file->chunks_data_offset;
+	index_chunk_group->number_of_chunks = (uint32_t) ( chunks_data_size / sizeof( ewf_index_chunk_t ) );
+	index_chunk_group->chunks_checksum  = calculated_checksum;
+
+	index_file->chunks_data_offset += (off64_t) chunks_data_size;
+
+	return( 1 );
+}
+
+/* Writes the segments and the header of the index file
+ * This function should be called after all the segments have been appended
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_write_segments(
+     libewf_index_file_t *index_file,
+     libcerror_error_t **error )
+{
+	ewf_index_file_header_t file_header;
+
+	libewf_index_segment_t *index_segment = NULL;
+	uint8_t *segments_data                = NULL;
+	static char *function                 = "libewf_index_file_write_segments";
+	size_t index_segment_data_size        = 0;
+	size_t segments_data_offset           = 0;
+	size_t segments_data_size             = 0;
+	ssize_t write_count                   = 0;
+	uint32_t calculated_checksum          = 0;
+	int number_of_segments                = 0;
+	int segment_index                     = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->access_flags != LIBBFIO_OPEN_WRITE_TRUNCATE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid index file - not open for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_file->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_segments == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing segments.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     index_file->segments_array,
+		     segment_index,
+		     (intptr_t **) &index_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve index segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( libewf_index_segment_get_data_size(
+		     index_segment,
+		     &index_segment_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve index segment: %d data size.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( index_segment_data_size > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE - segments_data_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segments data size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		segments_data_size += index_segment_data_size;
+	}
+	segments_data = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * segments_data_size );
+
+	if( segments_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segments data.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     index_file->segments_array,
+		     segment_index,
+		     (intptr_t **) &index_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve index segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		write_count = libewf_index_segment_write_data(
+		               index_segment,
+		               &( segments_data[ segments_data_offset ] ),
+		               segments_data_size - segments_data_offset,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write index segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		segments_data_offset += (size_t) write_count;
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     segments_data,
+	     segments_data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer_at_offset(
+	               index_file->file_io_handle,
+	               segments_data,
+	               segments_data_size,
+	               index_file->chunks_data_offset,
+	               error );
+
+	if( write_count != (ssize_t) segments_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write segments data.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 segments_data );
+
+	segments_data = NULL;
+
+	if( memory_set(
+	     &file_header,
+	     0,
+	     sizeof( ewf_index_file_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     file_header.signature,
+	     ewf_index_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header.format_version,
+	 LIBEWF_INDEX_FILE_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header.chunk_size,
+	 index_file->chunk_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header.number_of_segments,
+	 (uint32_t) number_of_segments );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header.segments_data_checksum,
+	 calculated_checksum );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header.segments_data_offset,
+	 (uint64_t) index_file->chunks_data_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header.segments_data_size,
+	 (uint64_t) segments_data_size );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     (uint8_t *) &file_header,
+	     sizeof( ewf_index_file_header_t ) - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header.checksum,
+	 calculated_checksum );
+
+	/* The header is written last so that an incomplete index file is not considered valid
+	 */
+	write_count = libbfio_handle_write_buffer_at_offset(
+	               index_file->file_io_handle,
+	               (uint8_t *) &file_header,
+	               sizeof( ewf_index_file_header_t ),
+	               0,
+	               error );
+
+	if( write_count != (ssize_t) sizeof( ewf_index_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( segments_data != NULL )
+	{
+		memory_free(
+		 segments_data );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,138 @@
+/*
+ * Index file functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_INDEX_FILE_H )
+#define _LIBEWF_INDEX_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_index_segment.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_index_file libewf_index_file_t;
+
+struct libewf_index_file
+{
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The access flags
+	 */
+	int access_flags;
+
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The segments array
+	 */
+	libcdata_array_t *segments_array;
+
+	/* The offset of the next chunks data to write
+	 */
+	off64_t chunks_data_offset;
+};
+
+int libewf_index_file_initialize(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_free(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_set_name(
+     libewf_index_file_t *index_file,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libewf_index_file_set_name_wide(
+     libewf_index_file_t *index_file,
+     const wchar_t *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libewf_index_file_open_read(
+     libewf_index_file_t *index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_open_write(
+     libewf_index_file_t *index_file,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
+int libewf_index_file_close(
+     libewf_index_file_t *index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_read_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_index_file_get_segment_by_number(
+     libewf_index_file_t *index_file,
+     uint32_t segment_number,
+     libewf_index_segment_t **index_segment,
+     libcerror_error_t **error );
+
+int libewf_index_file_append_segment(
+     libewf_index_file_t *index_file,
+     libewf_index_segment_t *index_segment,
+     libcerror_error_t **error );
+
+int libewf_index_file_read_chunks_data(
+     libewf_index_file_t *index_file,
+     libewf_index_chunk_group_t *index_chunk_group,
+     uint8_t *chunks_data,
+     size_t chunks_data_size,
+     libcerror_error_t **error );
+
+int libewf_index_file_write_chunks_data(
+     libewf_index_file_t *index_file,
+     libewf_index_chunk_group_t *index_chunk_group,
+     const uint8_t *chunks_data,
+     size_t chunks_data_size,
+     libcerror_error_t **error );
+
+int libewf_index_file_write_segments(
+     libewf_index_file_t *index_file,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_INDEX_FILE_H ) */
+
@@ -0,0 +1,724 @@
+/*
+ * Index segment functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_index_segment.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+
+#include "ewf_index.h"
+
+/* Creates an index segment
+ * Make sure the value index_segment is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_segment_initialize(
+     libewf_index_segment_t **index_segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_segment_initialize";
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_segment != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index segment value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*index_segment = memory_allocate_structure(
+	                  libewf_index_segment_t );
+
+	if( *index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *index_segment,
+	     0,
+	     sizeof( libewf_index_segment_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index segment.",
+		 function );
+
+		goto on_error;
+	}
+	( *index_segment )->device_information_section_index = -1;
+
+	return( 1 );
+
+on_error:
+	if( *index_segment != NULL )
+	{
+		memory_free(
+		 *index_segment );
+
+		*index_segment = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an index segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_segment_free(
+     libewf_index_segment_t **index_segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_segment_free";
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_segment != NULL )
+	{
+		if( ( *index_segment )->chunk_groups != NULL )
+		{
+			memory_free(
+			 ( *index_segment )->chunk_groups );
+		}
+		if( ( *index_segment )->section_offsets != NULL )
+		{
+			memory_free(
+			 ( *index_segment )->section_offsets );
+		}
+		memory_free(
+		 *index_segment );
+
+		*index_segment = NULL;
+	}
+	return( 1 );
+}
+
+/* Resizes the section offsets and chunk groups of an index segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_segment_resize(
+     libewf_index_segment_t *index_segment,
+     int number_of_sections,
+     int number_of_chunk_groups,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_segment_resize";
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_sections < 0 )
+	 || ( (size_t) number_of_sections > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( off64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sections value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunk_groups < 0 )
+	 || ( (size_t) number_of_chunk_groups > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_index_chunk_group_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunk groups value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_segment->section_offsets != NULL )
+	{
+		memory_free(
+		 index_segment->section_offsets );
+
+		index_segment->section_offsets = NULL;
+	}
+	index_segment->number_of_sections = 0;
+
+	if( index_segment->chunk_groups != NULL )
+	{
+		memory_free(
+		 index_segment->chunk_groups );
+
+		index_segment->chunk_groups = NULL;
+	}
+	index_segment->number_of_chunk_groups = 0;
+
+	if( number_of_sections > 0 )
+	{
+		index_segment->section_offsets = (off64_t *) memory_allocate(
+		                                              sizeof( off64_t ) * number_of_sections );
+
+		if( index_segment->section_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create section offsets.",
+			 function );
+
+			return( -1 );
+		}
+		index_segment->number_of_sections = number_of_sections;
+	}
+	if( number_of_chunk_groups > 0 )
+	{
+		index_segment->chunk_groups = (libewf_index_chunk_group_t *) memory_allocate(
+		                                                              sizeof( libewf_index_chunk_group_t ) * number_of_chunk_groups );
+
+		if( index_segment->chunk_groups == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create chunk groups.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     index_segment->chunk_groups,
+		     0,
+		     sizeof( libewf_index_chunk_group_t ) * number_of_chunk_groups ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear chunk groups.",
+			 function );
+
+			return( -1 );
+		}
+		index_segment->number_of_chunk_groups = number_of_chunk_groups;
+	}
+	return( 1 );
+}
+
+/* Reads an index segment
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_index_segment_read_data(
+         libewf_index_segment_t *index_segment,
+         const uint8_t *data,
+         size_t data_size,
+         libcerror_error_t **error )
+{
+	ewf_index_chunk_group_t *index_chunk_group = NULL;
+	static char *function                      = "libewf_index_segment_read_data";
+	size_t data_offset                         = 0;
+	uint32_t number_of_chunk_groups            = 0;
+	uint32_t number_of_sections                = 0;
+	uint32_t value_32bit                       = 0;
+	int chunk_group_index                      = 0;
+	int section_index                          = 0;
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( ewf_index_segment_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_index_segment_t *) data )->segment_file_size,
+	 index_segment->segment_file_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_index_segment_t *) data )->segment_number,
+	 index_segment->segment_number );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_index_segment_t *) data )->last_section_checksum,
+	 index_segment->last_section_checksum );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_index_segment_t *) data )->last_section_offset,
+	 index_segment->last_section_offset );
+
+	index_segment->type          = ( (ewf_index_segment_t *) data )->type;
+	index_segment->major_version = ( (ewf_index_segment_t *) data )->major_version;
+	index_segment->minor_version = ( (ewf_index_segment_t *) data )->minor_version;
+	index_segment->flags         = ( (ewf_index_segment_t *) data )->flags;
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (ewf_index_segment_t *) data )->compression_method,
+	 index_segment->compression_method );
+
+	if( memory_copy(
+	     index_segment->set_identifier,
+	     ( (ewf_index_segment_t *) data )->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_index_segment_t *) data )->device_information_section_index,
+	 value_32bit );
+
+	index_segment->device_information_section_index = (int) (int32_t) value_32bit;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_index_segment_t *) data )->number_of_sections,
+	 number_of_sections );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_index_segment_t *) data )->number_of_chunk_groups,
+	 number_of_chunk_groups );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_index_segment_t *) data )->storage_media_size,
+	 index_segment->storage_media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_index_segment_t *) data )->number_of_chunks,
+	 index_segment->number_of_chunks );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_index_segment_t *) data )->last_chunk_filled,
+	 index_segment->last_chunk_filled );
+
+	data_offset = sizeof( ewf_index_segment_t );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: segment number\t\t\t: %" PRIu32 "\n",
+		 function,
+		 index_segment->segment_number );
+
+		libcnotify_printf(
+		 "%s: segment file size\t\t\t: %" PRIu64 "\n",
+		 function,
+		 index_segment->segment_file_size );
+
+		libcnotify_printf(
+		 "%s: number of sections\t\t\t: %" PRIu32 "\n",
+		 function,
+		 number_of_sections );
+
+		libcnotify_printf(
+		 "%s: number of chunk groups\t\t: %" PRIu32 "\n",
+		 function,
+		 number_of_chunk_groups );
+
+		libcnotify_printf(
+		 "%s: number of chunks\t\t\t: %" PRIu64 "\n",
+		 function,
+		 index_segment->number_of_chunks );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	if( ( number_of_sections > (uint32_t) INT_MAX )
+	 || ( (size_t) number_of_sections > ( ( data_size - data_offset ) / sizeof( ewf_index_section_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sections value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunk_groups > (uint32_t) INT_MAX )
+	 || ( (size_t) number_of_chunk_groups > ( ( data_size - data_offset - ( number_of_sections * sizeof( ewf_index_section_t ) ) ) / sizeof( ewf_index_chunk_group_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunk groups value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_index_segment_resize(
+	     index_segment,
+	     (int) number_of_sections,
+	     (int) number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize index segment.",
+		 function );
+
+		return( -1 );
+	}
+	for( section_index = 0;
+	     section_index < index_segment->number_of_sections;
+	     section_index++ )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_index_section_t *) &( data[ data_offset ] ) )->offset,
+		 index_segment->section_offsets[ section_index ] );
+
+		data_offset += sizeof( ewf_index_section_t );
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < index_segment->number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		index_chunk_group = (ewf_index_chunk_group_t *) &( data[ data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_chunk_group->data_offset,
+		 index_segment->chunk_groups[ chunk_group_index ].data_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_chunk_group->data_size,
+		 index_segment->chunk_groups[ chunk_group_index ].data_size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_chunk_group->mapped_size,
+		 index_segment->chunk_groups[ chunk_group_index ].mapped_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_chunk_group->range_flags,
+		 index_segment->chunk_groups[ chunk_group_index ].range_flags );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_chunk_group->number_of_chunks,
+		 index_segment->chunk_groups[ chunk_group_index ].number_of_chunks );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_chunk_group->chunks_offset,
+		 index_segment->chunk_groups[ chunk_group_index ].chunks_offset );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_chunk_group->chunks_checksum,
+		 index_segment->chunk_groups[ chunk_group_index ].chunks_checksum );
+
+		data_offset += sizeof( ewf_index_chunk_group_t );
+	}
+	return( (ssize_t) data_offset );
+}
+
+/* Retrieves the size of the index segment data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_segment_get_data_size(
+     libewf_index_segment_t *index_segment,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_segment_get_data_size";
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	*data_size = sizeof( ewf_index_segment_t )
+	           + ( sizeof( ewf_index_section_t ) * index_segment->number_of_sections )
+	           + ( sizeof( ewf_index_chunk_group_t ) * index_segment->number_of_chunk_groups );
+
+	return( 1 );
+}
+
+/* Writes an index segment
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_index_segment_write_data(
+         libewf_index_segment_t *index_segment,
+         uint8_t *data,
+         size_t data_size,
+         libcerror_error_t **error )
+{
+	ewf_index_chunk_group_t *index_chunk_group = NULL;
+	static char *function                      = "libewf_index_segment_write_data";
+	size_t data_offset                         = 0;
+	size_t required_data_size                  = 0;
+	int chunk_group_index                      = 0;
+	int section_index                          = 0;
+
+	if( libewf_index_segment_get_data_size(
+	     index_segment,
+	     &required_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index segment data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < required_data_size )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     required_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_index_segment_t *) data )->segment_file_size,
+	 index_segment->segment_file_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_segment_t *) data )->segment_number,
+	 index_segment->segment_number );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_segment_t *) data )->last_section_checksum,
+	 index_segment->last_section_checksum );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_index_segment_t *) data )->last_section_offset,
+	 index_segment->last_section_offset );
+
+	( (ewf_index_segment_t *) data )->type          = index_segment->type;
+	( (ewf_index_segment_t *) data )->major_version = index_segment->major_version;
+	( (ewf_index_segment_t *) data )->minor_version = index_segment->minor_version;
+	( (ewf_index_segment_t *) data )->flags         = index_segment->flags;
+
+	byte_stream_copy_from_uint16_little_endian(
+	 ( (ewf_index_segment_t *) data )->compression_method,
+	 index_segment->compression_method );
+
+	if( memory_copy(
+	     ( (ewf_index_segment_t *) data )->set_identifier,
+	     index_segment->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_segment_t *) data )->device_information_section_index,
+	 (uint32_t) index_segment->device_information_section_index );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_segment_t *) data )->number_of_sections,
+	 (uint32_t) index_segment->number_of_sections );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_segment_t *) data )->number_of_chunk_groups,
+	 (uint32_t) index_segment->number_of_chunk_groups );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_index_segment_t *) data )->storage_media_size,
+	 index_segment->storage_media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_index_segment_t *) data )->number_of_chunks,
+	 index_segment->number_of_chunks );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_index_segment_t *) data )->last_chunk_filled,
+	 (uint64_t) index_segment->last_chunk_filled );
+
+	data_offset = sizeof( ewf_index_segment_t );
+
+	for( section_index = 0;
+	     section_index < index_segment->number_of_sections;
+	     section_index++ )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_index_section_t *) &( data[ data_offset ] ) )->offset,
+		 index_segment->section_offsets[ section_index ] );
+
+		data_offset += sizeof( ewf_index_section_t );
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < index_segment->number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		index_chunk_group = (ewf_index_chunk_group_t *) &( data[ data_offset ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 index_chunk_group->data_offset,
+		 index_segment->chunk_groups[ chunk_group_index ].data_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 index_chunk_group->data_size,
+		 index_segment->chunk_groups[ chunk_group_index ].data_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 index_chunk_group->mapped_size,
+		 index_segment->chunk_groups[ chunk_group_index ].mapped_size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 index_chunk_group->range_flags,
+		 index_segment->chunk_groups[ chunk_group_index ].range_flags );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 index_chunk_group->number_of_chunks,
+		 index_segment->chunk_groups[ chunk_group_index ].number_of_chunks );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 index_chunk_group->chunks_offset,
+		 index_segment->chunk_groups[ chunk_group_index ].chunks_offset );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 index_chunk_group->chunks_checksum,
+		 index_segment->chunk_groups[ chunk_group_index ].chunks_checksum );
+
+		data_offset += sizeof( ewf_index_chunk_group_t );
+	}
+	return( (ssize_t) data_offset );
+}
+
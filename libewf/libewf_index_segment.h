@@ -0,0 +1,180 @@
+/*
+ * Index segment functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_INDEX_SEGMENT_H )
+#define _LIBEWF_INDEX_SEGMENT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_index_chunk_group libewf_index_chunk_group_t;
+
+struct libewf_index_chunk_group
+{
+	/* The chunk group data offset
+	 */
+	off64_t data_offset;
+
+	/* The chunk group data size
+	 */
+	size64_t data_size;
+
+	/* The chunk group mapped size
+	 */
+	size64_t mapped_size;
+
+	/* The chunk group range flags
+	 */
+	uint32_t range_flags;
+
+	/* The number of chunks
+	 */
+	uint32_t number_of_chunks;
+
+	/* The offset of the chunks in the index file
+	 */
+	off64_t chunks_offset;
+
+	/* The checksum of the chunks data
+	 */
+	uint32_t chunks_checksum;
+};
+
+typedef struct libewf_index_segment libewf_index_segment_t;
+
+struct libewf_index_segment
+{
+	/* The segment file size
+	 */
+	size64_t segment_file_size;
+
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The checksum of the last section descriptor data
+	 */
+	uint32_t last_section_checksum;
+
+	/* The last section offset
+	 */
+	off64_t last_section_offset;
+
+	/* The segment file type
+	 */
+	uint8_t type;
+
+	/* The major version number
+	 */
+	uint8_t major_version;
+
+	/* The minor version number
+	 */
+	uint8_t minor_version;
+
+	/* The segment file flags
+	 */
+	uint8_t flags;
+
+	/* The compression method
+	 */
+	uint16_t compression_method;
+
+	/* The set identifier
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The device information section index
+	 */
+	int device_information_section_index;
+
+	/* The storage media size
+	 */
+	size64_t storage_media_size;
+
+	/* The number of chunks
+	 */
+	uint64_t number_of_chunks;
+
+	/* The last chunk that was filled
+	 */
+	int64_t last_chunk_filled;
+
+	/* The number of sections
+	 */
+	int number_of_sections;
+
+	/* The section descriptor offsets
+	 */
+	off64_t *section_offsets;
+
+	/* The number of chunk groups
+	 */
+	int number_of_chunk_groups;
+
+	/* The chunk groups
+	 */
+	libewf_index_chunk_group_t *chunk_groups;
+};
+
+int libewf_index_segment_initialize(
+     libewf_index_segment_t **index_segment,
+     libcerror_error_t **error );
+
+int libewf_index_segment_free(
+     libewf_index_segment_t **index_segment,
+     libcerror_error_t **error );
+
+int libewf_index_segment_resize(
+     libewf_index_segment_t *index_segment,
+     int number_of_sections,
+     int number_of_chunk_groups,
+     libcerror_error_t **error );
+
+ssize_t libewf_index_segment_read_data(
+         libewf_index_segment_t *index_segment,
+         const uint8_t *data,
+         size_t data_size,
+         libcerror_error_t **error );
+
+int libewf_index_segment_get_data_size(
+     libewf_index_segment_t *index_segment,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+ssize_t libewf_index_segment_write_data(
+         libewf_index_segment_t *index_segment,
+         uint8_t *data,
+         size_t data_size,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_INDEX_SEGMENT_H ) */
+
@@ -0,0 +1,1340 @@
+/*
+ * Integrity hash functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_hash_sections.h"
+#include "libewf_integrity_hash.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfvalue.h"
+#include "libewf_libhmac.h"
+#include "libewf_value_table.h"
+
+/* Creates an integrity hash
+ * Make sure the value integrity_hash is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_integrity_hash_initialize(
+     libewf_integrity_hash_t **integrity_hash,
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_integrity_hash_initialize";
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int buffer_index      = 0;
+#endif
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( *integrity_hash != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid integrity hash value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( flags == 0 )
+	 || ( ( flags & ~( LIBEWF_INTEGRITY_HASH_FLAG_MD5 | LIBEWF_INTEGRITY_HASH_FLAG_SHA1 | LIBEWF_INTEGRITY_HASH_FLAG_SHA256 ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags: 0x%02" PRIx8 ".",
+		 function,
+		 flags );
+
+		return( -1 );
+	}
+	*integrity_hash = memory_allocate_structure(
+	                   libewf_integrity_hash_t );
+
+	if( *integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create integrity hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *integrity_hash,
+	     0,
+	     sizeof( libewf_integrity_hash_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear integrity hash.",
+		 function );
+
+		memory_free(
+		 *integrity_hash );
+
+		*integrity_hash = NULL;
+
+		return( -1 );
+	}
+	if( ( flags & LIBEWF_INTEGRITY_HASH_FLAG_MD5 ) != 0 )
+	{
+		if( libhmac_md5_initialize(
+		     &( ( *integrity_hash )->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize MD5 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( flags & LIBEWF_INTEGRITY_HASH_FLAG_SHA1 ) != 0 )
+	{
+		if( libhmac_sha1_initialize(
+		     &( ( *integrity_hash )->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( flags & LIBEWF_INTEGRITY_HASH_FLAG_SHA256 ) != 0 )
+	{
+		if( libhmac_sha256_initialize(
+		     &( ( *integrity_hash )->sha256_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	for( buffer_index = 0;
+	     buffer_index < LIBEWF_INTEGRITY_HASH_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		( *integrity_hash )->buffers[ buffer_index ].data = (uint8_t *) memory_allocate(
+		                                                                 sizeof( uint8_t ) * LIBEWF_INTEGRITY_HASH_BUFFER_SIZE );
+
+		if( ( *integrity_hash )->buffers[ buffer_index ].data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer: %d data.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *integrity_hash )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *integrity_hash )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	/* A single hashing thread keeps the buffers hashed in the order they were submitted
+	 */
+	if( libcthreads_thread_pool_create(
+	     &( ( *integrity_hash )->thread_pool ),
+	     NULL,
+	     1,
+	     LIBEWF_INTEGRITY_HASH_NUMBER_OF_BUFFERS,
+	     (int (*)(intptr_t *, void *)) &libewf_integrity_hash_process_buffer_callback,
+	     (void *) *integrity_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	( *integrity_hash )->flags = flags;
+
+	return( 1 );
+
+on_error:
+	if( *integrity_hash != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *integrity_hash )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *integrity_hash )->condition ),
+			 NULL );
+		}
+		if( ( *integrity_hash )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *integrity_hash )->mutex ),
+			 NULL );
+		}
+		for( buffer_index = 0;
+		     buffer_index < LIBEWF_INTEGRITY_HASH_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			if( ( *integrity_hash )->buffers[ buffer_index ].data != NULL )
+			{
+				memory_free(
+				 ( *integrity_hash )->buffers[ buffer_index ].data );
+			}
+		}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+		if( ( *integrity_hash )->sha256_context != NULL )
+		{
+			libhmac_sha256_free(
+			 &( ( *integrity_hash )->sha256_context ),
+			 NULL );
+		}
+		if( ( *integrity_hash )->sha1_context != NULL )
+		{
+			libhmac_sha1_free(
+			 &( ( *integrity_hash )->sha1_context ),
+			 NULL );
+		}
+		if( ( *integrity_hash )->md5_context != NULL )
+		{
+			libhmac_md5_free(
+			 &( ( *integrity_hash )->md5_context ),
+			 NULL );
+		}
+		memory_free(
+		 *integrity_hash );
+
+		*integrity_hash = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an integrity hash
+ * Waits for the hashing thread to finish
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_integrity_hash_free(
+     libewf_integrity_hash_t **integrity_hash,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_integrity_hash_free";
+	int result            = 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int buffer_index      = 0;
+#endif
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( *integrity_hash != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *integrity_hash )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *integrity_hash )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *integrity_hash )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *integrity_hash )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		for( buffer_index = 0;
+		     buffer_index < LIBEWF_INTEGRITY_HASH_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			memory_free(
+			 ( *integrity_hash )->buffers[ buffer_index ].data );
+		}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+		if( ( *integrity_hash )->sha256_context != NULL )
+		{
+			if( libhmac_sha256_free(
+			     &( ( *integrity_hash )->sha256_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA256 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *integrity_hash )->sha1_context != NULL )
+		{
+			if( libhmac_sha1_free(
+			     &( ( *integrity_hash )->sha1_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA1 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *integrity_hash )->md5_context != NULL )
+		{
+			if( libhmac_md5_free(
+			     &( ( *integrity_hash )->md5_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free MD5 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *integrity_hash );
+
+		*integrity_hash = NULL;
+	}
+	return( result );
+}
+
+/* Calculates the integrity hash(es) of the data
+ * With multi-thread support this function is only called by the hashing thread
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_integrity_hash_calculate(
+     libewf_integrity_hash_t *integrity_hash,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_integrity_hash_calculate";
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( integrity_hash->md5_context != NULL )
+	{
+		if( libhmac_md5_update(
+		     integrity_hash->md5_context,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update MD5 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( integrity_hash->sha1_context != NULL )
+	{
+		if( libhmac_sha1_update(
+		     integrity_hash->sha1_context,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( integrity_hash->sha256_context != NULL )
+	{
+		if( libhmac_sha256_update(
+		     integrity_hash->sha256_context,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Calculates the integrity hash(es) of the data of an integrity hash buffer
+ * Callback function for the integrity hash thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_integrity_hash_process_buffer_callback(
+     libewf_integrity_hash_buffer_t *integrity_hash_buffer,
+     libewf_integrity_hash_t *integrity_hash )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_integrity_hash_process_buffer_callback";
+	uint8_t status           = LIBEWF_INTEGRITY_HASH_BUFFER_STATUS_FAILED;
+	int result               = 1;
+
+	if( integrity_hash_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_integrity_hash_calculate(
+	     integrity_hash,
+	     integrity_hash_buffer->data,
+	     integrity_hash_buffer->data_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate integrity hash(es) of buffer.",
+		 function );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		status = LIBEWF_INTEGRITY_HASH_BUFFER_STATUS_HASHED;
+	}
+	if( libcthreads_mutex_grab(
+	     integrity_hash->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	integrity_hash_buffer->status = status;
+
+	if( libcthreads_condition_broadcast(
+	     integrity_hash->condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     integrity_hash->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( error != NULL )
+	{
+		/* A failed buffer is reported when it is waited for
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Waits for an integrity hash buffer to be hashed and makes it available for filling
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_integrity_hash_wait_for_buffer(
+     libewf_integrity_hash_t *integrity_hash,
+     libewf_integrity_hash_buffer_t *integrity_hash_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_integrity_hash_wait_for_buffer";
+	uint8_t status        = 0;
+	int result            = 1;
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( integrity_hash_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     integrity_hash->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( integrity_hash_buffer->status == LIBEWF_INTEGRITY_HASH_BUFFER_STATUS_QUEUED )
+	{
+		if( libcthreads_condition_wait(
+		     integrity_hash->condition,
+		     integrity_hash->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	status = integrity_hash_buffer->status;
+
+	if( libcthreads_mutex_release(
+	     integrity_hash->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	if( status == LIBEWF_INTEGRITY_HASH_BUFFER_STATUS_EMPTY )
+	{
+		return( 1 );
+	}
+	integrity_hash_buffer->data_size = 0;
+	integrity_hash_buffer->status    = LIBEWF_INTEGRITY_HASH_BUFFER_STATUS_EMPTY;
+
+	if( status != LIBEWF_INTEGRITY_HASH_BUFFER_STATUS_HASHED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate integrity hash(es) of buffered data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Submits the buffer that is being filled for hashing and switches to the next buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_integrity_hash_submit_current_buffer(
+     libewf_integrity_hash_t *integrity_hash,
+     libcerror_error_t **error )
+{
+	libewf_integrity_hash_buffer_t *integrity_hash_buffer = NULL;
+	static char *function                                 = "libewf_integrity_hash_submit_current_buffer";
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	integrity_hash_buffer = &( integrity_hash->buffers[ integrity_hash->current_buffer_index ] );
+
+	if( integrity_hash_buffer->data_size == 0 )
+	{
+		return( 1 );
+	}
+	integrity_hash_buffer->status = LIBEWF_INTEGRITY_HASH_BUFFER_STATUS_QUEUED;
+
+	if( libcthreads_thread_pool_push(
+	     integrity_hash->thread_pool,
+	     (intptr_t *) integrity_hash_buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push buffer onto thread pool queue.",
+		 function );
+
+		integrity_hash_buffer->data_size = 0;
+		integrity_hash_buffer->status    = LIBEWF_INTEGRITY_HASH_BUFFER_STATUS_EMPTY;
+
+		return( -1 );
+	}
+	integrity_hash->current_buffer_index += 1;
+
+	if( integrity_hash->current_buffer_index >= LIBEWF_INTEGRITY_HASH_NUMBER_OF_BUFFERS )
+	{
+		integrity_hash->current_buffer_index = 0;
+	}
+	/* Make sure the next buffer was hashed before it is filled again
+	 */
+	if( libewf_integrity_hash_wait_for_buffer(
+	     integrity_hash,
+	     &( integrity_hash->buffers[ integrity_hash->current_buffer_index ] ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to wait for buffer: %d.",
+		 function,
+		 integrity_hash->current_buffer_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Updates the integrity hash(es) with the next part of the media data
+ * With multi-thread support the data is copied into a buffer that is hashed by
+ * the hashing thread, otherwise the data is hashed before returning
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_integrity_hash_update(
+     libewf_integrity_hash_t *integrity_hash,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function                                 = "libewf_integrity_hash_update";
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_integrity_hash_buffer_t *integrity_hash_buffer = NULL;
+	size_t copy_size                                      = 0;
+	size_t data_offset                                    = 0;
+#endif
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( integrity_hash->finalized != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid integrity hash - already finalized.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	while( data_offset < data_size )
+	{
+		integrity_hash_buffer = &( integrity_hash->buffers[ integrity_hash->current_buffer_index ] );
+
+		copy_size = LIBEWF_INTEGRITY_HASH_BUFFER_SIZE - integrity_hash_buffer->data_size;
+
+		if( copy_size > ( data_size - data_offset ) )
+		{
+			copy_size = data_size - data_offset;
+		}
+		if( memory_copy(
+		     &( ( integrity_hash_buffer->data )[ integrity_hash_buffer->data_size ] ),
+		     &( data[ data_offset ] ),
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to buffer.",
+			 function );
+
+			return( -1 );
+		}
+		integrity_hash_buffer->data_size += copy_size;
+		data_offset                      += copy_size;
+
+		if( integrity_hash_buffer->data_size == LIBEWF_INTEGRITY_HASH_BUFFER_SIZE )
+		{
+			if( libewf_integrity_hash_submit_current_buffer(
+			     integrity_hash,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to submit buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+#else
+	if( libewf_integrity_hash_calculate(
+	     integrity_hash,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate integrity hash(es).",
+		 function );
+
+		return( -1 );
+	}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+}
+
+/* Finalizes the integrity hash(es)
+ * Waits for the buffered data to be hashed and stores the calculated hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_integrity_hash_finalize(
+     libewf_integrity_hash_t *integrity_hash,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_integrity_hash_finalize";
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int buffer_index      = 0;
+	int result            = 1;
+#endif
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( integrity_hash->finalized != 0 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libewf_integrity_hash_submit_current_buffer(
+	     integrity_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to submit buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* Wait for all buffers, a failed buffer is reported after all buffers were hashed
+	 */
+	for( buffer_index = 0;
+	     buffer_index < LIBEWF_INTEGRITY_HASH_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		if( libewf_integrity_hash_wait_for_buffer(
+		     integrity_hash,
+		     &( integrity_hash->buffers[ buffer_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for buffer: %d.",
+			 function,
+			 buffer_index );
+
+			result = -1;
+		}
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	if( integrity_hash->md5_context != NULL )
+	{
+		if( libhmac_md5_finalize(
+		     integrity_hash->md5_context,
+		     integrity_hash->md5_hash,
+		     16,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize MD5 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( integrity_hash->sha1_context != NULL )
+	{
+		if( libhmac_sha1_finalize(
+		     integrity_hash->sha1_context,
+		     integrity_hash->sha1_hash,
+		     20,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA1 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( integrity_hash->sha256_context != NULL )
+	{
+		if( libhmac_sha256_finalize(
+		     integrity_hash->sha256_context,
+		     integrity_hash->sha256_hash,
+		     32,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	integrity_hash->finalized = 1;
+
+	return( 1 );
+}
+
+/* Sets a hash value from a calculated hash
+ * Replaces an existing hash value with the same identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_integrity_hash_set_hash_value(
+     libfvalue_table_t *hash_values,
+     const uint8_t *identifier,
+     size_t identifier_size,
+     const uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	uint8_t hash_string[ 65 ];
+
+	static char *function    = "libewf_integrity_hash_set_hash_value";
+	size_t hash_index        = 0;
+	size_t hash_string_index = 0;
+	uint8_t hash_digit       = 0;
+
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_size == 0 )
+	 || ( hash_size > 32 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( hash_index = 0;
+	     hash_index < hash_size;
+	     hash_index++ )
+	{
+		hash_digit = hash[ hash_index ] / 16;
+
+		if( hash_digit <= 9 )
+		{
+			hash_string[ hash_string_index++ ] = (uint8_t) '0' + hash_digit;
+		}
+		else
+		{
+			hash_string[ hash_string_index++ ] = (uint8_t) 'a' + ( hash_digit - 10 );
+		}
+		hash_digit = hash[ hash_index ] % 16;
+
+		if( hash_digit <= 9 )
+		{
+			hash_string[ hash_string_index++ ] = (uint8_t) '0' + hash_digit;
+		}
+		else
+		{
+			hash_string[ hash_string_index++ ] = (uint8_t) 'a' + ( hash_digit - 10 );
+		}
+	}
+	hash_string[ hash_string_index++ ] = 0;
+
+	if( libewf_value_table_set_value_by_identifier(
+	     hash_values,
+	     identifier,
+	     identifier_size,
+	     hash_string,
+	     hash_string_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set hash value: %s.",
+		 function,
+		 (char *) identifier );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the calculated hash(es) in the hash sections and hash values
+ * The calculated hash(es) replace hash(es) that were set before
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_integrity_hash_set_hashes(
+     libewf_integrity_hash_t *integrity_hash,
+     libewf_hash_sections_t *hash_sections,
+     libfvalue_table_t *hash_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_integrity_hash_set_hashes";
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( integrity_hash->finalized == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid integrity hash - not finalized.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_sections == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash sections.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( integrity_hash->flags & LIBEWF_INTEGRITY_HASH_FLAG_MD5 ) != 0 )
+	{
+		if( memory_copy(
+		     hash_sections->md5_hash,
+		     integrity_hash->md5_hash,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy MD5 hash.",
+			 function );
+
+			return( -1 );
+		}
+		hash_sections->md5_hash_set = 1;
+
+		if( memory_copy(
+		     hash_sections->md5_digest,
+		     integrity_hash->md5_hash,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy MD5 digest.",
+			 function );
+
+			return( -1 );
+		}
+		hash_sections->md5_digest_set = 1;
+
+		if( libewf_integrity_hash_set_hash_value(
+		     hash_values,
+		     (uint8_t *) "MD5",
+		     4,
+		     integrity_hash->md5_hash,
+		     16,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set MD5 hash value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( integrity_hash->flags & LIBEWF_INTEGRITY_HASH_FLAG_SHA1 ) != 0 )
+	{
+		if( memory_copy(
+		     hash_sections->sha1_hash,
+		     integrity_hash->sha1_hash,
+		     20 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy SHA1 hash.",
+			 function );
+
+			return( -1 );
+		}
+		hash_sections->sha1_hash_set = 1;
+
+		if( memory_copy(
+		     hash_sections->sha1_digest,
+		     integrity_hash->sha1_hash,
+		     20 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy SHA1 digest.",
+			 function );
+
+			return( -1 );
+		}
+		hash_sections->sha1_digest_set = 1;
+
+		if( libewf_integrity_hash_set_hash_value(
+		     hash_values,
+		     (uint8_t *) "SHA1",
+		     5,
+		     integrity_hash->sha1_hash,
+		     20,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set SHA1 hash value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The hash sections have no SHA256 hash so it is only stored as a hash value
+	 */
+	if( ( integrity_hash->flags & LIBEWF_INTEGRITY_HASH_FLAG_SHA256 ) != 0 )
+	{
+		if( libewf_integrity_hash_set_hash_value(
+		     hash_values,
+		     (uint8_t *) "SHA256",
+		     7,
+		     integrity_hash->sha256_hash,
+		     32,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set SHA256 hash value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,176 @@
+/*
+ * Integrity hash functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_INTEGRITY_HASH_H )
+#define _LIBEWF_INTEGRITY_HASH_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_hash_sections.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfvalue.h"
+#include "libewf_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_integrity_hash_buffer libewf_integrity_hash_buffer_t;
+
+struct libewf_integrity_hash_buffer
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The status
+	 */
+	uint8_t status;
+};
+
+typedef struct libewf_integrity_hash libewf_integrity_hash_t;
+
+struct libewf_integrity_hash
+{
+	/* The integrity hash flags
+	 */
+	uint8_t flags;
+
+	/* The MD5 context
+	 */
+	libhmac_md5_context_t *md5_context;
+
+	/* The SHA1 context
+	 */
+	libhmac_sha1_context_t *sha1_context;
+
+	/* The SHA256 context
+	 */
+	libhmac_sha256_context_t *sha256_context;
+
+	/* The calculated MD5 hash
+	 */
+	uint8_t md5_hash[ 16 ];
+
+	/* The calculated SHA1 hash
+	 */
+	uint8_t sha1_hash[ 20 ];
+
+	/* The calculated SHA256 hash
+	 */
+	uint8_t sha256_hash[ 32 ];
+
+	/* Value to indicate the hashes were finalized
+	 */
+	uint8_t finalized;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The buffers
+	 */
+	libewf_integrity_hash_buffer_t buffers[ LIBEWF_INTEGRITY_HASH_NUMBER_OF_BUFFERS ];
+
+	/* The index of the buffer that is being filled
+	 */
+	int current_buffer_index;
+
+	/* The hashing thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The buffers mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The buffers condition
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int libewf_integrity_hash_initialize(
+     libewf_integrity_hash_t **integrity_hash,
+     uint8_t flags,
+     libcerror_error_t **error );
+
+int libewf_integrity_hash_free(
+     libewf_integrity_hash_t **integrity_hash,
+     libcerror_error_t **error );
+
+int libewf_integrity_hash_calculate(
+     libewf_integrity_hash_t *integrity_hash,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_integrity_hash_process_buffer_callback(
+     libewf_integrity_hash_buffer_t *integrity_hash_buffer,
+     libewf_integrity_hash_t *integrity_hash );
+
+int libewf_integrity_hash_wait_for_buffer(
+     libewf_integrity_hash_t *integrity_hash,
+     libewf_integrity_hash_buffer_t *integrity_hash_buffer,
+     libcerror_error_t **error );
+
+int libewf_integrity_hash_submit_current_buffer(
+     libewf_integrity_hash_t *integrity_hash,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+int libewf_integrity_hash_update(
+     libewf_integrity_hash_t *integrity_hash,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_integrity_hash_finalize(
+     libewf_integrity_hash_t *integrity_hash,
+     libcerror_error_t **error );
+
+int libewf_integrity_hash_set_hash_value(
+     libfvalue_table_t *hash_values,
+     const uint8_t *identifier,
+     size_t identifier_size,
+     const uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+int libewf_integrity_hash_set_hashes(
+     libewf_integrity_hash_t *integrity_hash,
+     libewf_hash_sections_t *hash_sections,
+     libfvalue_table_t *hash_values,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_INTEGRITY_HASH_H ) */
+
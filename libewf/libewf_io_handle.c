@@ -24,9 +24,11 @@
 #include <types.h>
 
 #include "libewf_codepage.h"
+#include "libewf_compression_context.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
 
 /* Creates an IO handle
  * Make sure the value io_handle is referencing, is set to NULL
@@ -97,6 +99,21 @@ int libewf_io_handle_initialize(
 	( *io_handle )->zero_on_error      = 1;
 	( *io_handle )->header_codepage    = LIBEWF_CODEPAGE_ASCII;
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *io_handle )->compression_contexts_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize compression contexts mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
@@ -146,6 +163,21 @@ int libewf_io_handle_free(
 
 			result = -1;
 		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *io_handle )->compression_contexts_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression contexts mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *io_handle );
 
@@ -161,7 +193,12 @@ int libewf_io_handle_clear(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_io_handle_clear";
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_t *compression_contexts_mutex = NULL;
+#endif
+	static char *function                           = "libewf_io_handle_clear";
+	int compression_context_index                   = 0;
+	int result                                      = 1;
 
 	if( io_handle == NULL )
 	{
@@ -174,6 +211,28 @@ int libewf_io_handle_clear(
 
 		return( -1 );
 	}
+	for( compression_context_index = 0;
+	     compression_context_index < io_handle->number_of_compression_contexts;
+	     compression_context_index++ )
+	{
+		if( libewf_compression_context_free(
+		     &( io_handle->compression_contexts[ compression_context_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression context: %d.",
+			 function,
+			 compression_context_index );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	compression_contexts_mutex = io_handle->compression_contexts_mutex;
+#endif
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -186,8 +245,11 @@ int libewf_io_handle_clear(
 		 "%s: unable to clear IO handle.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	io_handle->compression_contexts_mutex = compression_contexts_mutex;
+#endif
 	io_handle->segment_file_type  = LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED;
 	io_handle->format             = LIBEWF_FORMAT_ENCASE6;
 	io_handle->major_version      = 1;
@@ -197,7 +259,7 @@ int libewf_io_handle_clear(
 	io_handle->zero_on_error      = 1;
 	io_handle->header_codepage    = LIBEWF_CODEPAGE_ASCII;
 
-	return( 1 );
+	return( result );
 }
 
 /* Clones the IO handle
@@ -267,7 +329,43 @@ int libewf_io_handle_clone(
 		goto on_error;
 	}
 	( *destination_io_handle )->zero_on_error = source_io_handle->zero_on_error;
+	( *destination_io_handle )->index_file    = NULL;
 
+	/* The compression contexts are not shared with the source IO handle
+	 */
+	if( memory_set(
+	     ( *destination_io_handle )->compression_contexts,
+	     0,
+	     sizeof( libewf_compression_context_t * ) * LIBEWF_IO_HANDLE_MAXIMUM_NUMBER_OF_COMPRESSION_CONTEXTS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear destination compression contexts.",
+		 function );
+
+		goto on_error;
+	}
+	( *destination_io_handle )->number_of_compression_contexts = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	( *destination_io_handle )->compression_contexts_mutex = NULL;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *destination_io_handle )->compression_contexts_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize destination compression contexts mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
@@ -281,3 +379,203 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves a compression context
+ * An unused compression context is reused, otherwise a new compression context is created
+ * The compression context should be released with libewf_io_handle_release_compression_context
+ * This function is multi-thread safe
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_handle_get_compression_context(
+     libewf_io_handle_t *io_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	libewf_compression_context_t *safe_compression_context = NULL;
+	static char *function                                  = "libewf_io_handle_get_compression_context";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->compression_contexts_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab compression contexts mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( io_handle->number_of_compression_contexts > 0 )
+	{
+		io_handle->number_of_compression_contexts -= 1;
+
+		safe_compression_context = io_handle->compression_contexts[ io_handle->number_of_compression_contexts ];
+
+		io_handle->compression_contexts[ io_handle->number_of_compression_contexts ] = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->compression_contexts_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release compression contexts mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( safe_compression_context == NULL )
+	{
+		if( libewf_compression_context_initialize(
+		     &safe_compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compression context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*compression_context = safe_compression_context;
+
+	return( 1 );
+
+on_error:
+	if( safe_compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &safe_compression_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases a compression context retrieved with libewf_io_handle_get_compression_context
+ * The compression context is kept for reuse or freed if the maximum number of unused
+ * compression contexts was reached
+ * This function is multi-thread safe
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_handle_release_compression_context(
+     libewf_io_handle_t *io_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_io_handle_release_compression_context";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->compression_contexts_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab compression contexts mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( io_handle->number_of_compression_contexts < LIBEWF_IO_HANDLE_MAXIMUM_NUMBER_OF_COMPRESSION_CONTEXTS )
+	{
+		io_handle->compression_contexts[ io_handle->number_of_compression_contexts ] = *compression_context;
+
+		io_handle->number_of_compression_contexts += 1;
+
+		*compression_context = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->compression_contexts_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release compression contexts mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( *compression_context != NULL )
+	{
+		if( libewf_compression_context_free(
+		     compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
@@ -25,7 +25,11 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_compression_context.h"
+#include "libewf_definitions.h"
+#include "libewf_index_file.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -79,6 +83,10 @@ struct libewf_io_handle
 	 */
 	uint8_t zero_on_error;
 
+	/* Value to indicate if segment files should be opened for direct IO
+	 */
+	uint8_t use_direct_io;
+
 	/* The header codepage
 	 */
 	int header_codepage;
@@ -86,6 +94,25 @@ struct libewf_io_handle
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The index file
+	 * This is a reference to the index file of the handle and is not managed by the IO handle
+	 */
+	libewf_index_file_t *index_file;
+
+	/* The unused compression contexts
+	 */
+	libewf_compression_context_t *compression_contexts[ LIBEWF_IO_HANDLE_MAXIMUM_NUMBER_OF_COMPRESSION_CONTEXTS ];
+
+	/* The number of unused compression contexts
+	 */
+	int number_of_compression_contexts;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The compression contexts mutex
+	 */
+	libcthreads_mutex_t *compression_contexts_mutex;
+#endif
 };
 
 int libewf_io_handle_initialize(
@@ -105,6 +132,16 @@ int libewf_io_handle_clone(
      libewf_io_handle_t *source_io_handle,
      libcerror_error_t **error );
 
+int libewf_io_handle_get_compression_context(
+     libewf_io_handle_t *io_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_io_handle_release_compression_context(
+     libewf_io_handle_t *io_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,916 @@
+/*
+ * Chunk read-ahead functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_table.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_media_values.h"
+#include "libewf_read_ahead.h"
+#include "libewf_segment_table.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a read-ahead
+ * Make sure the value read_ahead is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_initialize(
+     libewf_read_ahead_t **read_ahead,
+     libewf_io_handle_t *io_handle,
+     int depth,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_initialize";
+	size_t entries_size   = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read-ahead value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( depth <= 0 )
+	 || ( depth > LIBEWF_READ_AHEAD_MAXIMUM_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_READ_AHEAD_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*read_ahead = memory_allocate_structure(
+	               libewf_read_ahead_t );
+
+	if( *read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_ahead,
+	     0,
+	     sizeof( libewf_read_ahead_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read-ahead.",
+		 function );
+
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+
+		return( -1 );
+	}
+	/* An additional entry is used to hold the chunk that is currently being read
+	 */
+	( *read_ahead )->number_of_entries = depth + 1;
+
+	entries_size = sizeof( libewf_read_ahead_entry_t ) * ( *read_ahead )->number_of_entries;
+
+	( *read_ahead )->entries = (libewf_read_ahead_entry_t *) memory_allocate(
+	                                                          entries_size );
+
+	if( ( *read_ahead )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *read_ahead )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_ahead )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *read_ahead )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *read_ahead )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     ( *read_ahead )->number_of_entries,
+	     (int (*)(intptr_t *, void *)) &libewf_read_ahead_process_entry_callback,
+	     (void *) *read_ahead,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_ahead )->io_handle = io_handle;
+	( *read_ahead )->depth     = depth;
+
+	return( 1 );
+
+on_error:
+	if( *read_ahead != NULL )
+	{
+		if( ( *read_ahead )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *read_ahead )->condition ),
+			 NULL );
+		}
+		if( ( *read_ahead )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *read_ahead )->mutex ),
+			 NULL );
+		}
+		if( ( *read_ahead )->entries != NULL )
+		{
+			memory_free(
+			 ( *read_ahead )->entries );
+		}
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read-ahead
+ * Waits for the worker threads to finish
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_free(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		if( ( *read_ahead )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *read_ahead )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( entry_index = 0;
+		     entry_index < ( *read_ahead )->number_of_entries;
+		     entry_index++ )
+		{
+			if( ( *read_ahead )->entries[ entry_index ].chunk_data != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( ( *read_ahead )->entries[ entry_index ].chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free entry: %d chunk data.",
+					 function,
+					 entry_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *read_ahead )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *read_ahead )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *read_ahead )->entries );
+
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( result );
+}
+
+/* Reads and unpacks the chunk data of a read-ahead entry
+ * Callback function for the read-ahead thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_process_entry_callback(
+     libewf_read_ahead_entry_t *read_ahead_entry,
+     libewf_read_ahead_t *read_ahead )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_read_ahead_process_entry_callback";
+	ssize_t read_count              = 0;
+	uint8_t status                  = LIBEWF_READ_AHEAD_ENTRY_STATUS_FAILED;
+	int result                      = 1;
+
+	if( read_ahead_entry == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_data_initialize(
+	     &chunk_data,
+	     read_ahead->io_handle->chunk_size,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		read_count = libewf_chunk_data_read_from_file_io_pool(
+			      chunk_data,
+			      read_ahead_entry->file_io_pool,
+			      read_ahead_entry->file_io_pool_entry,
+			      read_ahead_entry->chunk_data_offset,
+			      read_ahead_entry->chunk_data_size,
+			      read_ahead_entry->chunk_data_flags,
+			      &error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 read_ahead_entry->chunk_index );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_chunk_data_unpack(
+		     chunk_data,
+		     read_ahead->io_handle,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 read_ahead_entry->chunk_index );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		chunk_data->chunk_index        = read_ahead_entry->chunk_index;
+		chunk_data->range_start_offset = read_ahead_entry->range_start_offset;
+		chunk_data->range_end_offset   = read_ahead_entry->range_end_offset;
+
+		status = LIBEWF_READ_AHEAD_ENTRY_STATUS_AVAILABLE;
+	}
+	else if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	read_ahead_entry->chunk_data = chunk_data;
+	read_ahead_entry->status     = status;
+
+	chunk_data = NULL;
+
+	if( libcthreads_condition_broadcast(
+	     read_ahead->condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( error != NULL )
+	{
+		/* A failed entry is read again by the caller
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Waits for a queued read-ahead entry to be processed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_wait_for_entry(
+     libewf_read_ahead_t *read_ahead,
+     libewf_read_ahead_entry_t *read_ahead_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_wait_for_entry";
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( read_ahead_entry->status == LIBEWF_READ_AHEAD_ENTRY_STATUS_QUEUED )
+	{
+		if( libcthreads_condition_wait(
+		     read_ahead->condition,
+		     read_ahead->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Updates the read-ahead with the index of the chunk that is being read
+ * When the chunks are read sequentially the following chunks are queued
+ * for reading and unpacking by the worker threads
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_update(
+     libewf_read_ahead_t *read_ahead,
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_read_ahead_entry_t *read_ahead_entry = NULL;
+	static char *function                       = "libewf_read_ahead_update";
+	off64_t range_start_offset                  = 0;
+	uint64_t last_read_ahead_chunk_index        = 0;
+	int result                                  = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_ahead->last_chunk_index_is_set != 0 )
+	 && ( chunk_index == read_ahead->last_chunk_index ) )
+	{
+		return( 1 );
+	}
+	if( ( read_ahead->last_chunk_index_is_set != 0 )
+	 && ( chunk_index == ( read_ahead->last_chunk_index + 1 ) ) )
+	{
+		if( read_ahead->number_of_sequential_reads < LIBEWF_READ_AHEAD_SEQUENTIAL_THRESHOLD )
+		{
+			read_ahead->number_of_sequential_reads += 1;
+		}
+	}
+	else
+	{
+		read_ahead->number_of_sequential_reads = 0;
+	}
+	read_ahead->last_chunk_index        = chunk_index;
+	read_ahead->last_chunk_index_is_set = 1;
+
+	if( ( read_ahead->number_of_sequential_reads < LIBEWF_READ_AHEAD_SEQUENTIAL_THRESHOLD )
+	 || ( chunk_index >= media_values->number_of_chunks ) )
+	{
+		return( 1 );
+	}
+	last_read_ahead_chunk_index = chunk_index + read_ahead->depth;
+
+	if( last_read_ahead_chunk_index >= media_values->number_of_chunks )
+	{
+		last_read_ahead_chunk_index = media_values->number_of_chunks - 1;
+	}
+	if( ( read_ahead->next_chunk_index <= chunk_index )
+	 || ( read_ahead->next_chunk_index > ( last_read_ahead_chunk_index + 1 ) ) )
+	{
+		read_ahead->next_chunk_index = chunk_index + 1;
+	}
+	while( read_ahead->next_chunk_index <= last_read_ahead_chunk_index )
+	{
+		read_ahead_entry = &( read_ahead->entries[ read_ahead->next_chunk_index % read_ahead->number_of_entries ] );
+
+		/* The entry can still be in use by a worker thread for a previously queued chunk
+		 */
+		if( libewf_read_ahead_wait_for_entry(
+		     read_ahead,
+		     read_ahead_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for read-ahead entry.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( read_ahead_entry->status == LIBEWF_READ_AHEAD_ENTRY_STATUS_AVAILABLE )
+		 && ( read_ahead_entry->chunk_index == read_ahead->next_chunk_index ) )
+		{
+			read_ahead->next_chunk_index += 1;
+
+			continue;
+		}
+		if( read_ahead_entry->chunk_data != NULL )
+		{
+			if( libewf_chunk_data_free(
+			     &( read_ahead_entry->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk: %" PRIu64 " data.",
+				 function,
+				 read_ahead_entry->chunk_index );
+
+				return( -1 );
+			}
+		}
+		read_ahead_entry->chunk_index = read_ahead->next_chunk_index;
+		read_ahead_entry->status      = LIBEWF_READ_AHEAD_ENTRY_STATUS_EMPTY;
+
+		range_start_offset = (off64_t) read_ahead->next_chunk_index * media_values->chunk_size;
+
+		read_ahead->next_chunk_index += 1;
+
+		result = libewf_chunk_table_get_chunk_data_range_by_offset(
+		          chunk_table,
+		          file_io_pool,
+		          media_values,
+		          segment_table,
+		          range_start_offset,
+		          &( read_ahead_entry->file_io_pool_entry ),
+		          &( read_ahead_entry->chunk_data_offset ),
+		          &( read_ahead_entry->chunk_data_size ),
+		          &( read_ahead_entry->chunk_data_flags ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+			 function,
+			 read_ahead_entry->chunk_index );
+
+			return( -1 );
+		}
+		/* Sparse and unavailable chunks are left to be read by the caller
+		 */
+		if( ( result == 0 )
+		 || ( read_ahead_entry->chunk_data_size == 0 )
+		 || ( ( read_ahead_entry->chunk_data_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 ) )
+		{
+			continue;
+		}
+		read_ahead_entry->file_io_pool       = file_io_pool;
+		read_ahead_entry->range_start_offset = range_start_offset;
+		read_ahead_entry->range_end_offset   = range_start_offset + media_values->chunk_size;
+
+		if( (size64_t) read_ahead_entry->range_end_offset > media_values->media_size )
+		{
+			read_ahead_entry->range_end_offset = (off64_t) media_values->media_size;
+		}
+		read_ahead_entry->status = LIBEWF_READ_AHEAD_ENTRY_STATUS_QUEUED;
+
+		if( libcthreads_thread_pool_push(
+		     read_ahead->thread_pool,
+		     (intptr_t *) read_ahead_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk: %" PRIu64 " onto thread pool queue.",
+			 function,
+			 read_ahead_entry->chunk_index );
+
+			read_ahead_entry->status = LIBEWF_READ_AHEAD_ENTRY_STATUS_EMPTY;
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the read-ahead chunk data of a specific chunk
+ * Waits for the chunk data if it is still being processed
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_read_ahead_get_chunk_data(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_read_ahead_entry_t *read_ahead_entry = NULL;
+	static char *function                       = "libewf_read_ahead_get_chunk_data";
+	int result                                  = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	read_ahead_entry = &( read_ahead->entries[ chunk_index % read_ahead->number_of_entries ] );
+
+	/* The status of the entry is changed by the worker threads while holding the mutex
+	 */
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_ahead_entry->status != LIBEWF_READ_AHEAD_ENTRY_STATUS_EMPTY )
+	 && ( read_ahead_entry->chunk_index == chunk_index ) )
+	{
+		while( read_ahead_entry->status == LIBEWF_READ_AHEAD_ENTRY_STATUS_QUEUED )
+		{
+			if( libcthreads_condition_wait(
+			     read_ahead->condition,
+			     read_ahead->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( ( result == 0 )
+		 && ( read_ahead_entry->status == LIBEWF_READ_AHEAD_ENTRY_STATUS_AVAILABLE ) )
+		{
+			*chunk_data = read_ahead_entry->chunk_data;
+
+			result = 1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
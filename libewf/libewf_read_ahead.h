@@ -0,0 +1,179 @@
+/*
+ * Chunk read-ahead functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_READ_AHEAD_H )
+#define _LIBEWF_READ_AHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_table.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_media_values.h"
+#include "libewf_segment_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_read_ahead_entry libewf_read_ahead_entry_t;
+
+struct libewf_read_ahead_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The file IO pool
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The (packed) chunk data offset
+	 */
+	off64_t chunk_data_offset;
+
+	/* The (packed) chunk data size
+	 */
+	size64_t chunk_data_size;
+
+	/* The (packed) chunk data range flags
+	 */
+	uint32_t chunk_data_flags;
+
+	/* The (media) range start offset
+	 */
+	off64_t range_start_offset;
+
+	/* The (media) range end offset
+	 */
+	off64_t range_end_offset;
+
+	/* The (unpacked) chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The status
+	 */
+	uint8_t status;
+};
+
+typedef struct libewf_read_ahead libewf_read_ahead_t;
+
+struct libewf_read_ahead
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The depth, which is the number of chunks to read ahead
+	 */
+	int depth;
+
+	/* The entries
+	 */
+	libewf_read_ahead_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The last requested chunk index
+	 */
+	uint64_t last_chunk_index;
+
+	/* Value to indicate the last requested chunk index is set
+	 */
+	uint8_t last_chunk_index_is_set;
+
+	/* The number of consecutive sequential chunk reads
+	 */
+	int number_of_sequential_reads;
+
+	/* The index of the next chunk to read ahead
+	 */
+	uint64_t next_chunk_index;
+
+	/* The worker thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The entries mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The entries condition
+	 */
+	libcthreads_condition_t *condition;
+};
+
+int libewf_read_ahead_initialize(
+     libewf_read_ahead_t **read_ahead,
+     libewf_io_handle_t *io_handle,
+     int depth,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_free(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_process_entry_callback(
+     libewf_read_ahead_entry_t *read_ahead_entry,
+     libewf_read_ahead_t *read_ahead );
+
+int libewf_read_ahead_wait_for_entry(
+     libewf_read_ahead_t *read_ahead,
+     libewf_read_ahead_entry_t *read_ahead_entry,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_update(
+     libewf_read_ahead_t *read_ahead,
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_get_chunk_data(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_READ_AHEAD_H ) */
+
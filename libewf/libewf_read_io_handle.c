@@ -20,9 +20,13 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
 #include <types.h>
 
+#include "libewf_checksum.h"
 #include "libewf_chunk_data.h"
+#include "libewf_compression_context.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
@@ -141,6 +145,11 @@ int libewf_read_io_handle_free(
 			memory_free(
 			 ( *read_io_handle )->device_information );
 		}
+		if( ( *read_io_handle )->packed_chunk_data != NULL )
+		{
+			memory_free(
+			 ( *read_io_handle )->packed_chunk_data );
+		}
 		memory_free(
 		 *read_io_handle );
 
@@ -228,3 +237,301 @@ on_error:
 	return( -1 );
 }
 
+/* Reads and unpacks the chunk data directly into a buffer
+ * This avoids the intermediate chunk data buffer for reads that cover an entire chunk
+ * The buffer size must be equal or greater than the chunk size
+ * Returns 1 if successful, 0 if the chunk data cannot be unpacked directly or -1 on error
+ */
+int libewf_read_io_handle_read_chunk_data_to_buffer(
+     libewf_read_io_handle_t *read_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t chunk_data_flags,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	uint8_t checksum_data[ 4 ];
+
+	libewf_compression_context_t *compression_context = NULL;
+	uint8_t *packed_chunk_data                        = NULL;
+	static char *function                             = "libewf_read_io_handle_read_chunk_data_to_buffer";
+	size_t data_size                                  = 0;
+	ssize_t read_count                                = 0;
+	uint32_t calculated_checksum                      = 0;
+	uint32_t stored_checksum                          = 0;
+	int result                                        = 0;
+
+	if( read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	data_size = (size_t) io_handle->chunk_size;
+
+	/* Sparse, pattern fill and encrypted chunks are unpacked by the chunk data
+	 */
+	if( ( buffer_size < data_size )
+	 || ( chunk_data_size == 0 )
+	 || ( chunk_data_size > (size64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	 || ( ( chunk_data_flags & ( LIBEWF_RANGE_FLAG_IS_SPARSE | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL | LIBEWF_RANGE_FLAG_IS_ENCRYPTED ) ) != 0 ) )
+	{
+		return( 0 );
+	}
+	if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		if( (size_t) chunk_data_size > read_io_handle->packed_chunk_data_size )
+		{
+			packed_chunk_data = (uint8_t *) memory_reallocate(
+			                                 read_io_handle->packed_chunk_data,
+			                                 sizeof( uint8_t ) * (size_t) chunk_data_size );
+
+			if( packed_chunk_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize packed chunk data.",
+				 function );
+
+				return( -1 );
+			}
+			read_io_handle->packed_chunk_data      = packed_chunk_data;
+			read_io_handle->packed_chunk_data_size = (size_t) chunk_data_size;
+		}
+		read_count = libbfio_pool_read_buffer_at_offset(
+			      file_io_pool,
+			      file_io_pool_entry,
+			      read_io_handle->packed_chunk_data,
+			      (size_t) chunk_data_size,
+			      chunk_data_offset,
+			      error );
+
+		if( read_count != (ssize_t) chunk_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data at offset: %" PRIi64 " (0x%08" PRIx64 ") in file IO pool entry: %d.",
+			 function,
+			 chunk_data_offset,
+			 chunk_data_offset,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		if( libewf_io_handle_get_compression_context(
+		     io_handle,
+		     &compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve compression context.",
+			 function );
+
+			return( -1 );
+		}
+		result = libewf_compression_context_decompress_data(
+		          compression_context,
+		          read_io_handle->packed_chunk_data,
+		          (size_t) chunk_data_size,
+		          io_handle->compression_method,
+		          buffer,
+		          &data_size,
+		          error );
+
+		if( libewf_io_handle_release_compression_context(
+		     io_handle,
+		     &compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release compression context.",
+			 function );
+
+			libewf_compression_context_free(
+			 &compression_context,
+			 NULL );
+
+			return( -1 );
+		}
+		/* Corrupted chunks are left to be unpacked by the chunk data
+		 */
+		if( result != 1 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcerror_error_free(
+				 error );
+			}
+			return( 0 );
+		}
+		if( data_size != (size_t) io_handle->chunk_size )
+		{
+			return( 0 );
+		}
+	}
+	else if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		if( chunk_data_size != (size64_t) ( data_size + 4 ) )
+		{
+			return( 0 );
+		}
+		read_count = libbfio_pool_read_buffer_at_offset(
+			      file_io_pool,
+			      file_io_pool_entry,
+			      buffer,
+			      data_size,
+			      chunk_data_offset,
+			      error );
+
+		if( read_count == (ssize_t) data_size )
+		{
+			read_count = libbfio_pool_read_buffer_at_offset(
+				      file_io_pool,
+				      file_io_pool_entry,
+				      checksum_data,
+				      4,
+				      chunk_data_offset + data_size,
+				      error );
+
+			if( read_count == 4 )
+			{
+				read_count = (ssize_t) chunk_data_size;
+			}
+		}
+		if( read_count != (ssize_t) chunk_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data at offset: %" PRIi64 " (0x%08" PRIx64 ") in file IO pool entry: %d.",
+			 function,
+			 chunk_data_offset,
+			 chunk_data_offset,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 checksum_data,
+		 stored_checksum );
+
+		if( libewf_checksum_calculate_adler32(
+		     &calculated_checksum,
+		     buffer,
+		     data_size,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate checksum.",
+			 function );
+
+			return( -1 );
+		}
+		/* Corrupted chunks are left to be unpacked by the chunk data
+		 */
+		if( stored_checksum != calculated_checksum )
+		{
+			return( 0 );
+		}
+	}
+	else
+	{
+		if( chunk_data_size != (size64_t) data_size )
+		{
+			return( 0 );
+		}
+		read_count = libbfio_pool_read_buffer_at_offset(
+			      file_io_pool,
+			      file_io_pool_entry,
+			      buffer,
+			      data_size,
+			      chunk_data_offset,
+			      error );
+
+		if( read_count != (ssize_t) data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data at offset: %" PRIi64 " (0x%08" PRIx64 ") in file IO pool entry: %d.",
+			 function,
+			 chunk_data_offset,
+			 chunk_data_offset,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
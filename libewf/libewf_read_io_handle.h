@@ -65,6 +65,14 @@ struct libewf_read_io_handle
         /* The (total) number of chunks read
          */
         uint64_t number_of_chunks_read;
+
+	/* The packed chunk data, used to unpack chunk data directly into a buffer
+	 */
+	uint8_t *packed_chunk_data;
+
+	/* The packed chunk data size
+	 */
+	size_t packed_chunk_data_size;
 };
 
 int libewf_read_io_handle_initialize(
@@ -80,6 +88,18 @@ int libewf_read_io_handle_clone(
      libewf_read_io_handle_t *source_read_io_handle,
      libcerror_error_t **error );
 
+int libewf_read_io_handle_read_chunk_data_to_buffer(
+     libewf_read_io_handle_t *read_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t chunk_data_flags,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -22,6 +22,7 @@
 #include <common.h>
 #include <byte_stream.h>
 #include <memory.h>
+#include <system_string.h>
 #include <types.h>
 
 #if defined( TIME_WITH_SYS_TIME )
@@ -34,14 +35,18 @@
 #endif
 
 #include "libewf_case_data.h"
+#include "libewf_checksum.h"
 #include "libewf_chunk_data.h"
 #include "libewf_debug.h"
 #include "libewf_definitions.h"
 #include "libewf_device_information.h"
 #include "libewf_digest_section.h"
 #include "libewf_error2_section.h"
+#include "libewf_file_allocation.h"
 #include "libewf_hash_values.h"
 #include "libewf_header_values.h"
+#include "libewf_index_file.h"
+#include "libewf_index_segment.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
@@ -56,6 +61,7 @@
 #include "libewf_section_descriptor.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_segment_writer.h"
 #include "libewf_session_section.h"
 #include "libewf_sha1_hash_section.h"
 #include "libewf_single_files.h"
@@ -64,6 +70,7 @@
 #include "libewf_volume_section.h"
 
 #include "ewf_file_header.h"
+#include "ewf_index.h"
 #include "ewf_section.h"
 #include "ewf_volume.h"
 
@@ -4229,12 +4236,15 @@ on_error:
 }
 
 /* Write a chunk of data to a segment file and update the chunk table
+ * If a segment writer is provided the chunk data is buffered by the segment writer
+ * and the segment file offset is updated before the data is actually written
  * Returns the number of bytes written or -1 on error
  */
 ssize_t libewf_segment_file_write_chunk_data(
          libewf_segment_file_t *segment_file,
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
+         libewf_segment_writer_t *segment_writer,
          uint64_t chunk_index,
          libewf_chunk_data_t *chunk_data,
          libcerror_error_t **error )
@@ -4404,12 +4414,23 @@ ssize_t libewf_segment_file_write_chunk_data(
 		 "\n" );
 	}
 #endif
-	write_count = libewf_chunk_data_write(
-	               chunk_data,
-	               file_io_pool,
-	               file_io_pool_entry,
-	               error );
-
+	if( segment_writer != NULL )
+	{
+		write_count = libewf_segment_writer_append_chunk_data(
+		               segment_writer,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               chunk_data,
+		               error );
+	}
+	else
+	{
+		write_count = libewf_chunk_data_write(
+		               chunk_data,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               error );
+	}
 	if( write_count != (ssize_t) chunk_write_size )
 	{
 		libcerror_error_set(
@@ -4878,6 +4899,173 @@ on_error:
 	return( -1 );
 }
 
+/* Releases the preallocated space of the segment file that was not used
+ * Returns 1 if successful, 0 if no space was released or -1 on error
+ */
+int libewf_segment_file_release_unused_space(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	system_character_t *filename     = NULL;
+	static char *function            = "libewf_segment_file_release_unused_space";
+	size_t filename_size             = 0;
+	int result                       = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_PREALLOCATED ) == 0 )
+	{
+		return( 0 );
+	}
+	segment_file->flags &= ~( LIBEWF_SEGMENT_FILE_FLAG_IS_PREALLOCATED );
+
+	/* A direct file IO handle truncates the file to its size when it is closed
+	 */
+	if( segment_file->io_handle->use_direct_io != 0 )
+	{
+		return( 0 );
+	}
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_get_name_size_wide(
+	          file_io_handle,
+	          &filename_size,
+	          error );
+#else
+	result = libbfio_file_get_name_size(
+	          file_io_handle,
+	          &filename_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( filename_size == 0 )
+	 || ( filename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	filename = system_string_allocate(
+	            filename_size );
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_get_name_wide(
+	          file_io_handle,
+	          filename,
+	          filename_size,
+	          error );
+#else
+	result = libbfio_file_get_name(
+	          file_io_handle,
+	          filename,
+	          filename_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_file_allocation_release_unused(
+	          filename,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to release unused space of file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	memory_free(
+	 filename );
+
+	return( result );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
+}
+
 /* Closes the segment file, necessary sections at the end of the segment file will be written
  * Returns the number of bytes written or -1 on error
  */
@@ -5313,6 +5501,22 @@ ssize_t libewf_segment_file_write_close(
 
 	segment_file->number_of_chunks = number_of_chunks_written_to_segment_file;
 
+	if( libewf_segment_file_release_unused_space(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to release unused space of segment file: %" PRIu16 ".",
+		 function,
+		 segment_file->segment_number );
+
+		goto on_error;
+	}
 	if( libbfio_pool_close(
 	     file_io_pool,
 	     file_io_pool_entry,
@@ -6119,128 +6323,955 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a segment file
- * Callback function for the segment files list
+/* Calculates the checksum of the last section descriptor
  * Returns 1 if successful or -1 on error
  */
-int libewf_segment_file_read_element_data(
-     libewf_io_handle_t *io_handle,
+int libewf_segment_file_calculate_last_section_checksum(
+     libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfdata_cache_t *segment_file_cache,
      int file_io_pool_entry,
-     off64_t segment_file_offset,
-     size64_t segment_file_size,
-     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     off64_t last_section_offset,
+     uint32_t *checksum,
      libcerror_error_t **error )
 {
-	libewf_section_descriptor_t *section_descriptor = NULL;
-	libewf_segment_file_t *segment_file             = NULL;
-	libfcache_cache_t *sections_cache               = NULL;
-	static char *function                           = "libewf_segment_file_read_element_data";
-	ssize_t read_count                              = 0;
-	off64_t section_data_offset                     = 0;
-	int element_index                               = 0;
-	int last_section                                = 0;
-	int number_of_sections                          = 0;
-	int result                                      = 0;
-	int section_index                               = 0;
+	uint8_t section_descriptor_data[ sizeof( ewf_section_descriptor_v1_t ) ];
 
-	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
-	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+	static char *function          = "libewf_segment_file_calculate_last_section_checksum";
+	size_t section_descriptor_size = 0;
+	ssize_t read_count             = 0;
 
-	if( io_handle == NULL )
+	if( segment_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 "%s: invalid segment file.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_file_initialize(
-	     &segment_file,
-	     io_handle,
-	     error ) != 1 )
+	if( segment_file->major_version == 1 )
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v1_t );
+	}
+	else if( segment_file->major_version == 2 )
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v2_t );
+	}
+	else
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment file.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid segment file - unsupported major version.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( segment_file_size == 0 )
+	if( checksum == NULL )
 	{
-		/* segment_file_size is 0 on write correction
-		 */
-		if( libbfio_pool_get_size(
-		     file_io_pool,
-		     file_io_pool_entry,
-		     &segment_file_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file size.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum.",
+		 function );
 
-			goto on_error;
-		}
+		return( -1 );
 	}
-	read_count = libewf_segment_file_read_file_header_file_io_pool(
-		      segment_file,
-		      file_io_pool,
-		      file_io_pool_entry,
-		      error );
+	read_count = libbfio_pool_read_buffer_at_offset(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              section_descriptor_data,
+	              section_descriptor_size,
+	              last_section_offset,
+	              error );
 
-/* TODO deal with corrupted header ? */
-	if( read_count == -1 )
+	if( read_count != (ssize_t) section_descriptor_size )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read segment file header.",
-		 function );
+		 "%s: unable to read last section descriptor data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 last_section_offset,
+		 last_section_offset );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+	if( libewf_checksum_calculate_adler32(
+	     checksum,
+	     section_descriptor_data,
+	     section_descriptor_size,
+	     1,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported segment file type.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
 		 function );
 
-		goto on_error;
-	}
-	if( ( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-	 && ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) )
-	{
-		segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+		return( -1 );
 	}
-	else if( ( io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED )
-	      && ( io_handle->segment_file_type != segment_file->type ) )
+	return( 1 );
+}
+
+/* Reads the sections and chunk groups of a segment file from an index segment
+ * Returns 1 if successful, 0 if the index segment does not match the segment file or -1 on error
+ */
+int libewf_segment_file_read_index_segment(
+     libewf_segment_file_t *segment_file,
+     libewf_index_segment_t *index_segment,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	libewf_index_chunk_group_t *index_chunk_group = NULL;
+	static char *function                         = "libewf_segment_file_read_index_segment";
+	size_t section_descriptor_size                = 0;
+	uint32_t last_section_checksum                = 0;
+	uint8_t segment_file_type                     = 0;
+	uint8_t index_segment_file_type               = 0;
+	int chunk_group_index                         = 0;
+	int element_index                             = 0;
+	int section_index                             = 0;
+
+	if( segment_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_INPUT,
-		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-		 "%s: segment file type value mismatch.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	/* The SMART segment file type is determined by the header values
+	 * and can therefore differ between reads of the same segment file
+	 */
+	segment_file_type       = segment_file->type;
+	index_segment_file_type = index_segment->type;
+
+	if( segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	{
+		segment_file_type = LIBEWF_SEGMENT_FILE_TYPE_EWF1;
+	}
+	if( index_segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	{
+		index_segment_file_type = LIBEWF_SEGMENT_FILE_TYPE_EWF1;
+	}
+	if( ( index_segment->segment_file_size != segment_file_size )
+	 || ( index_segment->segment_number != segment_file->segment_number )
+	 || ( index_segment_file_type != segment_file_type )
+	 || ( index_segment->major_version != segment_file->major_version )
+	 || ( index_segment->minor_version != segment_file->minor_version )
+	 || ( index_segment->compression_method != segment_file->compression_method )
+	 || ( index_segment->number_of_sections <= 0 ) )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     index_segment->set_identifier,
+	     segment_file->set_identifier,
+	     16 ) != 0 )
+	{
+		return( 0 );
+	}
+	if( segment_file->major_version == 1 )
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v1_t );
+	}
+	else
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v2_t );
+	}
+	if( ( index_segment->last_section_offset <= 0 )
+	 || ( (size64_t) index_segment->last_section_offset > ( segment_file_size - section_descriptor_size ) ) )
+	{
+		return( 0 );
+	}
+	if( libewf_segment_file_calculate_last_section_checksum(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     index_segment->last_section_offset,
+	     &last_section_checksum,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate last section checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( last_section_checksum != index_segment->last_section_checksum )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: last section checksum of segment file: %" PRIu32 " does not match index.\n",
+			 function,
+			 segment_file->segment_number );
+		}
+#endif
+		return( 0 );
+	}
+	for( section_index = 0;
+	     section_index < index_segment->number_of_sections;
+	     section_index++ )
+	{
+		if( libfdata_list_append_element(
+		     segment_file->sections_list,
+		     &element_index,
+		     file_io_pool_entry,
+		     index_segment->section_offsets[ section_index ],
+		     section_descriptor_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element to sections list.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < index_segment->number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		index_chunk_group = &( index_segment->chunk_groups[ chunk_group_index ] );
+
+		if( libfdata_list_append_element_with_mapped_size(
+		     segment_file->chunk_groups_list,
+		     &( segment_file->current_chunk_group_index ),
+		     file_io_pool_entry,
+		     index_chunk_group->data_offset,
+		     index_chunk_group->data_size,
+		     index_chunk_group->range_flags,
+		     index_chunk_group->mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element with mapped size to chunk groups list.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	segment_file->last_section_offset              = index_segment->last_section_offset;
+	segment_file->current_offset                   = index_segment->last_section_offset + section_descriptor_size;
+	segment_file->device_information_section_index = index_segment->device_information_section_index;
+	segment_file->flags                           |= index_segment->flags;
+	segment_file->storage_media_size               = index_segment->storage_media_size;
+	segment_file->number_of_chunks                 = index_segment->number_of_chunks;
+	segment_file->previous_last_chunk_filled       = index_segment->last_chunk_filled;
+	segment_file->last_chunk_filled                = index_segment->last_chunk_filled;
+
+	return( 1 );
+}
+
+/* Reads a chunk group from the index file
+ * Returns 1 if successful, 0 if the chunk group is not available in the index file or -1 on error
+ */
+int libewf_segment_file_read_index_chunk_group(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfdata_cache_t *cache,
+     int file_io_pool_entry,
+     off64_t chunk_group_data_offset,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group             = NULL;
+	libewf_index_chunk_group_t *index_chunk_group = NULL;
+	libewf_index_segment_t *index_segment         = NULL;
+	uint8_t *index_chunks_data                    = NULL;
+	static char *function                         = "libewf_segment_file_read_index_chunk_group";
+	size_t index_chunks_data_size                 = 0;
+	int element_index                             = 0;
+	int result                                    = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle->index_file == NULL )
+	{
+		return( 0 );
+	}
+	result = libewf_index_file_get_segment_by_number(
+	          segment_file->io_handle->index_file,
+	          segment_file->segment_number,
+	          &index_segment,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index segment: %" PRIu32 ".",
+		 function,
+		 segment_file->segment_number );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libfdata_list_element_get_element_index(
+	     element,
+	     &element_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk group list element index.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( element_index < 0 )
+	 || ( element_index >= index_segment->number_of_chunk_groups ) )
+	{
+		return( 0 );
+	}
+	index_chunk_group = &( index_segment->chunk_groups[ element_index ] );
+
+	if( ( index_chunk_group->data_offset != chunk_group_data_offset )
+	 || ( index_chunk_group->number_of_chunks == 0 )
+	 || ( (size_t) index_chunk_group->number_of_chunks > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( ewf_index_chunk_t ) ) ) )
+	{
+		return( 0 );
+	}
+	index_chunks_data_size = (size_t) index_chunk_group->number_of_chunks * sizeof( ewf_index_chunk_t );
+
+	index_chunks_data = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * index_chunks_data_size );
+
+	if( index_chunks_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index chunks data.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_index_file_read_chunks_data(
+	          segment_file->io_handle->index_file,
+	          index_chunk_group,
+	          index_chunks_data,
+	          index_chunks_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index chunks data.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libewf_chunk_group_initialize(
+		     &chunk_group,
+		     segment_file->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk group.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_chunk_group_fill_index(
+		     chunk_group,
+		     0,
+		     segment_file->io_handle->chunk_size,
+		     file_io_pool_entry,
+		     index_chunk_group->number_of_chunks,
+		     index_chunks_data,
+		     index_chunks_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill chunks list.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdata_list_element_set_element_value(
+		     element,
+		     (intptr_t *) file_io_pool,
+		     cache,
+		     (intptr_t *) chunk_group,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_group_free,
+		     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk group as element value.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_group = NULL;
+	}
+	memory_free(
+	 index_chunks_data );
+
+	return( result );
+
+on_error:
+	if( chunk_group != NULL )
+	{
+		libewf_chunk_group_free(
+		 &chunk_group,
+		 NULL );
+	}
+	if( index_chunks_data != NULL )
+	{
+		memory_free(
+		 index_chunks_data );
+	}
+	return( -1 );
+}
+
+/* Writes the sections and chunk groups of a segment file to the index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_write_index_segment(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libewf_index_file_t *index_file,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group             = NULL;
+	libewf_index_chunk_group_t *index_chunk_group = NULL;
+	libewf_index_segment_t *index_segment         = NULL;
+	uint8_t *index_chunks_data                    = NULL;
+	static char *function                         = "libewf_segment_file_write_index_segment";
+	size64_t element_size                         = 0;
+	size_t index_chunks_data_offset               = 0;
+	size_t index_chunks_data_size                 = 0;
+	off64_t element_offset                        = 0;
+	uint32_t element_flags                        = 0;
+	int chunk_group_index                         = 0;
+	int chunk_index                               = 0;
+	int element_file_io_pool_entry                = 0;
+	int number_of_chunk_groups                    = 0;
+	int number_of_chunks                          = 0;
+	int number_of_sections                        = 0;
+	int section_index                             = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sections.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunk groups.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_index_segment_initialize(
+	     &index_segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_index_segment_resize(
+	     index_segment,
+	     number_of_sections,
+	     number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize index segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     index_segment->set_identifier,
+	     segment_file->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		goto on_error;
+	}
+	index_segment->segment_file_size                = segment_file_size;
+	index_segment->segment_number                   = segment_file->segment_number;
+	index_segment->last_section_offset              = segment_file->last_section_offset;
+	index_segment->type                             = segment_file->type;
+	index_segment->major_version                    = segment_file->major_version;
+	index_segment->minor_version                    = segment_file->minor_version;
+	index_segment->flags                            = segment_file->flags & ~( LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN );
+	index_segment->compression_method               = segment_file->compression_method;
+	index_segment->device_information_section_index = segment_file->device_information_section_index;
+	index_segment->storage_media_size               = segment_file->storage_media_size;
+	index_segment->number_of_chunks                 = segment_file->number_of_chunks;
+	index_segment->last_chunk_filled                = segment_file->last_chunk_filled;
+
+	if( libewf_segment_file_calculate_last_section_checksum(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     segment_file->last_section_offset,
+	     &( index_segment->last_section_checksum ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate last section checksum.",
+		 function );
+
+		goto on_error;
+	}
+	for( section_index = 0;
+	     section_index < number_of_sections;
+	     section_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     segment_file->sections_list,
+		     section_index,
+		     &element_file_io_pool_entry,
+		     &( index_segment->section_offsets[ section_index ] ),
+		     &element_size,
+		     &element_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from sections list.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		index_chunk_group = &( index_segment->chunk_groups[ chunk_group_index ] );
+
+		if( libfdata_list_get_element_by_index(
+		     segment_file->chunk_groups_list,
+		     chunk_group_index,
+		     &element_file_io_pool_entry,
+		     &( index_chunk_group->data_offset ),
+		     &( index_chunk_group->data_size ),
+		     &( index_chunk_group->range_flags ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from chunk groups list.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+		if( libfdata_list_get_element_mapped_range(
+		     segment_file->chunk_groups_list,
+		     chunk_group_index,
+		     &element_offset,
+		     &( index_chunk_group->mapped_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk groups list element: %d mapped range.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+		if( libfdata_list_get_element_value_by_index(
+		     segment_file->chunk_groups_list,
+		     (intptr_t *) file_io_pool,
+		     (libfdata_cache_t *) segment_file->chunk_groups_cache,
+		     chunk_group_index,
+		     (intptr_t **) &chunk_group,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk group: %d.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+		if( chunk_group == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk group: %d.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+		if( libewf_chunk_group_get_number_of_chunks(
+		     chunk_group,
+		     &number_of_chunks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of chunks in chunk group: %d.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+		if( ( number_of_chunks <= 0 )
+		 || ( (size_t) number_of_chunks > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( ewf_index_chunk_t ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of chunks in chunk group: %d value out of bounds.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+		index_chunks_data_size = (size_t) number_of_chunks * sizeof( ewf_index_chunk_t );
+
+		index_chunks_data = (uint8_t *) memory_allocate(
+		                                 sizeof( uint8_t ) * index_chunks_data_size );
+
+		if( index_chunks_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create index chunks data.",
+			 function );
+
+			goto on_error;
+		}
+		index_chunks_data_offset = 0;
+
+		for( chunk_index = 0;
+		     chunk_index < number_of_chunks;
+		     chunk_index++ )
+		{
+			if( libewf_chunk_group_get_chunk_by_index(
+			     chunk_group,
+			     chunk_index,
+			     &element_file_io_pool_entry,
+			     &element_offset,
+			     &element_size,
+			     &element_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %d from chunk group.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			byte_stream_copy_from_uint64_little_endian(
+			 ( (ewf_index_chunk_t *) &( index_chunks_data[ index_chunks_data_offset ] ) )->chunk_data_offset,
+			 (uint64_t) element_offset );
+
+			byte_stream_copy_from_uint32_little_endian(
+			 ( (ewf_index_chunk_t *) &( index_chunks_data[ index_chunks_data_offset ] ) )->chunk_data_size,
+			 (uint32_t) element_size );
+
+			byte_stream_copy_from_uint32_little_endian(
+			 ( (ewf_index_chunk_t *) &( index_chunks_data[ index_chunks_data_offset ] ) )->range_flags,
+			 element_flags );
+
+			index_chunks_data_offset += sizeof( ewf_index_chunk_t );
+		}
+		if( libewf_index_file_write_chunks_data(
+		     index_file,
+		     index_chunk_group,
+		     index_chunks_data,
+		     index_chunks_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunks data of chunk group: %d.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+		memory_free(
+		 index_chunks_data );
+
+		index_chunks_data = NULL;
+	}
+	if( libewf_index_file_append_segment(
+	     index_file,
+	     index_segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append index segment.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( index_chunks_data != NULL )
+	{
+		memory_free(
+		 index_chunks_data );
+	}
+	if( index_segment != NULL )
+	{
+		libewf_index_segment_free(
+		 &index_segment,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the file header and section descriptors of a segment file
+ * The table sections are read as well if the chunk size is known
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_file_io_pool(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	libewf_index_segment_t *index_segment           = NULL;
+	libewf_io_handle_t *io_handle                   = NULL;
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	libfcache_cache_t *sections_cache               = NULL;
+	static char *function                           = "libewf_segment_file_read_file_io_pool";
+	ssize_t read_count                              = 0;
+	off64_t section_data_offset                     = 0;
+	off64_t segment_file_offset                     = 0;
+	int element_index                               = 0;
+	int last_section                                = 0;
+	int number_of_sections                          = 0;
+	int result                                      = 0;
+	int section_index                               = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle = segment_file->io_handle;
+
+	read_count = libewf_segment_file_read_file_header_file_io_pool(
+		      segment_file,
+		      file_io_pool,
+		      file_io_pool_entry,
+		      error );
+
+/* TODO deal with corrupted header ? */
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported segment file type.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	 && ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) )
+	{
+		segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+	}
+	else if( ( io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED )
+	      && ( io_handle->segment_file_type != segment_file->type ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: segment file type value mismatch.",
 		 function );
 
 		goto on_error;
@@ -6260,6 +7291,66 @@ int libewf_segment_file_read_element_data(
 			goto on_error;
 		}
 	}
+	if( io_handle->index_file != NULL )
+	{
+		/* Restore the sections and chunk groups from the index file
+		 * if it matches the segment file
+		 */
+		result = libewf_index_file_get_segment_by_number(
+		          io_handle->index_file,
+		          segment_file->segment_number,
+		          &index_segment,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve index segment: %" PRIu32 ".",
+			 function,
+			 segment_file->segment_number );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			result = libewf_segment_file_read_index_segment(
+			          segment_file,
+			          index_segment,
+			          file_io_pool,
+			          file_io_pool_entry,
+			          segment_file_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read index segment: %" PRIu32 ".",
+				 function,
+				 segment_file->segment_number );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				return( 1 );
+			}
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: index segment: %" PRIu32 " does not match segment file, ignoring index segment.\n",
+				 function,
+				 segment_file->segment_number );
+			}
+#endif
+		}
+	}
 	/* Read the section descriptors:
 	 * EWF version 1 read from front to back
 	 * EWF version 2 read from back to front
@@ -6686,6 +7777,108 @@ int libewf_segment_file_read_element_data(
 			goto on_error;
 		}
 	}
+	return( 1 );
+
+on_error:
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	if( section_descriptor != NULL )
+	{
+		libewf_section_descriptor_free(
+		 &section_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a segment file
+ * Callback function for the segment files list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_element_data(
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfdata_cache_t *segment_file_cache,
+     int file_io_pool_entry,
+     off64_t segment_file_offset LIBEWF_ATTRIBUTE_UNUSED,
+     size64_t segment_file_size,
+     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
+     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_file_read_element_data";
+
+	LIBEWF_UNREFERENCED_PARAMETER( segment_file_offset )
+	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
+	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( segment_file_size == 0 )
+	{
+		/* segment_file_size is 0 on write correction
+		 */
+		if( libbfio_pool_get_size(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file size.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_segment_file_read_file_io_pool(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     segment_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_list_element_set_element_value(
 	     element,
 	     (intptr_t *) file_io_pool,
@@ -6707,18 +7900,6 @@ int libewf_segment_file_read_element_data(
 	return( 1 );
 
 on_error:
-	if( sections_cache != NULL )
-	{
-		libfcache_cache_free(
-		 &sections_cache,
-		 NULL );
-	}
-	if( section_descriptor != NULL )
-	{
-		libewf_section_descriptor_free(
-		 &section_descriptor,
-		 NULL );
-	}
 	if( segment_file != NULL )
 	{
 		libewf_segment_file_free(
@@ -6905,6 +8086,33 @@ int libewf_segment_file_read_chunk_group_element_data(
 
 		return( -1 );
 	}
+	if( segment_file->io_handle->index_file != NULL )
+	{
+		result = libewf_segment_file_read_index_chunk_group(
+		          segment_file,
+		          file_io_pool,
+		          element,
+		          cache,
+		          file_io_pool_entry,
+		          chunk_group_data_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk group from index file.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			return( 1 );
+		}
+	}
 	if( libewf_section_descriptor_initialize(
 	     &section_descriptor,
 	     error ) != 1 )
@@ -7088,7 +8296,25 @@ int libewf_segment_file_read_chunk_group_element_data(
 
 #endif /* defined( HAVE_DEBUG_OUTPUT ) */
 
-	if( segment_file->major_version == 1 )
+	/* The table entries of a deduplicated EWFX chunks section can refer to preceding chunk data
+	 */
+	if( ( segment_file->major_version == 1 )
+	 && ( segment_file->io_handle->format == LIBEWF_FORMAT_EWFX ) )
+	{
+		result = libewf_chunk_group_fill_v1_with_references(
+			  chunk_group,
+			  chunk_index,
+			  segment_file->io_handle->chunk_size,
+			  file_io_pool_entry,
+			  section_descriptor,
+			  (off64_t) table_section->base_offset,
+			  table_section->number_of_entries,
+			  &( table_section->section_data[ table_section->entries_offset ] ),
+			  table_section->entries_size,
+			  table_section->entries_corrupted,
+			  error );
+	}
+	else if( segment_file->major_version == 1 )
 	{
 		result = libewf_chunk_group_fill_v1(
 			  chunk_group,
@@ -38,6 +38,8 @@
 #include "libewf_chunk_group.h"
 #include "libewf_hash_sections.h"
 #include "libewf_header_sections.h"
+#include "libewf_index_file.h"
+#include "libewf_index_segment.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
@@ -47,6 +49,7 @@
 #include "libewf_libfvalue.h"
 #include "libewf_media_values.h"
 #include "libewf_section_descriptor.h"
+#include "libewf_segment_writer.h"
 #include "libewf_single_files.h"
 
 #include "ewf_data.h"
@@ -334,6 +337,7 @@ ssize_t libewf_segment_file_write_chunk_data(
          libewf_segment_file_t *segment_file,
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
+         libewf_segment_writer_t *segment_writer,
          uint64_t chunk_index,
          libewf_chunk_data_t *chunk_data,
          libcerror_error_t **error );
@@ -346,6 +350,12 @@ ssize_t libewf_segment_file_write_hash_sections(
          libfvalue_table_t *hash_values,
          libcerror_error_t **error );
 
+int libewf_segment_file_release_unused_space(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
 ssize_t libewf_segment_file_write_close(
          libewf_segment_file_t *segment_file,
          libbfio_pool_t *file_io_pool,
@@ -390,6 +400,46 @@ int libewf_segment_file_write_sections_correction(
      ewf_data_t **data_section,
      libcerror_error_t **error );
 
+int libewf_segment_file_calculate_last_section_checksum(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t last_section_offset,
+     uint32_t *checksum,
+     libcerror_error_t **error );
+
+int libewf_segment_file_read_index_segment(
+     libewf_segment_file_t *segment_file,
+     libewf_index_segment_t *index_segment,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
+int libewf_segment_file_read_index_chunk_group(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfdata_cache_t *cache,
+     int file_io_pool_entry,
+     off64_t chunk_group_data_offset,
+     libcerror_error_t **error );
+
+int libewf_segment_file_write_index_segment(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libewf_index_file_t *index_file,
+     libcerror_error_t **error );
+
+int libewf_segment_file_read_file_io_pool(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
 int libewf_segment_file_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
@@ -0,0 +1,754 @@
+/*
+ * Segment file scanner functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_scanner.h"
+#include "libewf_segment_table.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a segment scanner
+ * Make sure the value segment_scanner is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_scanner_initialize(
+     libewf_segment_scanner_t **segment_scanner,
+     libewf_io_handle_t *io_handle,
+     int number_of_entries,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_scanner_initialize";
+	size_t entries_size   = 0;
+
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_scanner != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment scanner value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_entries <= 0 )
+	 || ( number_of_entries > LIBEWF_MAXIMUM_CACHE_ENTRIES_SEGMENT_FILES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_SEGMENT_SCANNER_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_scanner = memory_allocate_structure(
+	                    libewf_segment_scanner_t );
+
+	if( *segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment scanner.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_scanner,
+	     0,
+	     sizeof( libewf_segment_scanner_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment scanner.",
+		 function );
+
+		memory_free(
+		 *segment_scanner );
+
+		*segment_scanner = NULL;
+
+		return( -1 );
+	}
+	( *segment_scanner )->number_of_entries = number_of_entries;
+
+	entries_size = sizeof( libewf_segment_scanner_entry_t ) * number_of_entries;
+
+	( *segment_scanner )->entries = (libewf_segment_scanner_entry_t *) memory_allocate(
+	                                                                    entries_size );
+
+	if( ( *segment_scanner )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *segment_scanner )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *segment_scanner )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *segment_scanner )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *segment_scanner )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     number_of_entries,
+	     (int (*)(intptr_t *, void *)) &libewf_segment_scanner_process_entry_callback,
+	     (void *) *segment_scanner,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	( *segment_scanner )->io_handle = io_handle;
+
+	return( 1 );
+
+on_error:
+	if( *segment_scanner != NULL )
+	{
+		if( ( *segment_scanner )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *segment_scanner )->condition ),
+			 NULL );
+		}
+		if( ( *segment_scanner )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *segment_scanner )->mutex ),
+			 NULL );
+		}
+		if( ( *segment_scanner )->entries != NULL )
+		{
+			memory_free(
+			 ( *segment_scanner )->entries );
+		}
+		memory_free(
+		 *segment_scanner );
+
+		*segment_scanner = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment scanner
+ * Waits for the worker threads to finish
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_scanner_free(
+     libewf_segment_scanner_t **segment_scanner,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_scanner_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_scanner != NULL )
+	{
+		if( ( *segment_scanner )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *segment_scanner )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( entry_index = 0;
+		     entry_index < ( *segment_scanner )->number_of_entries;
+		     entry_index++ )
+		{
+			if( ( *segment_scanner )->entries[ entry_index ].segment_file != NULL )
+			{
+				if( libewf_segment_file_free(
+				     &( ( *segment_scanner )->entries[ entry_index ].segment_file ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free entry: %d segment file.",
+					 function,
+					 entry_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *segment_scanner )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *segment_scanner )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *segment_scanner )->entries );
+
+		memory_free(
+		 *segment_scanner );
+
+		*segment_scanner = NULL;
+	}
+	return( result );
+}
+
+/* Reads the file header and section descriptors of the segment file of a segment scanner entry
+ * Callback function for the segment scanner thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_scanner_process_entry_callback(
+     libewf_segment_scanner_entry_t *segment_scanner_entry,
+     libewf_segment_scanner_t *segment_scanner )
+{
+	libcerror_error_t *error            = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_scanner_process_entry_callback";
+	uint8_t status                      = LIBEWF_SEGMENT_SCANNER_ENTRY_STATUS_FAILED;
+	int result                          = 1;
+
+	if( segment_scanner_entry == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     segment_scanner->io_handle,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		if( libewf_segment_file_read_file_io_pool(
+		     segment_file,
+		     segment_scanner_entry->file_io_pool,
+		     segment_scanner_entry->file_io_pool_entry,
+		     segment_scanner_entry->segment_file_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment file: %" PRIu32 ".",
+			 function,
+			 segment_scanner_entry->segment_index );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		status = LIBEWF_SEGMENT_SCANNER_ENTRY_STATUS_AVAILABLE;
+	}
+	else if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( libcthreads_mutex_grab(
+	     segment_scanner->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	segment_scanner_entry->segment_file = segment_file;
+	segment_scanner_entry->status       = status;
+
+	segment_file = NULL;
+
+	segment_scanner->number_of_queued_entries -= 1;
+
+	if( libcthreads_condition_broadcast(
+	     segment_scanner->condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     segment_scanner->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( error != NULL )
+	{
+		/* The segment file of a failed entry is read again by the caller
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Scans a range of segment files
+ * The segment files are read by the worker threads and are then
+ * stored in the segment table in segment order
+ * Segment files that could not be read are left to be read by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_scanner_scan(
+     libewf_segment_scanner_t *segment_scanner,
+     libewf_segment_table_t *segment_table,
+     libbfio_pool_t *file_io_pool,
+     uint32_t first_segment_index,
+     uint32_t number_of_segments,
+     libcerror_error_t **error )
+{
+	libewf_segment_scanner_entry_t *segment_scanner_entry = NULL;
+	static char *function                                 = "libewf_segment_scanner_scan";
+	int entry_index                                       = 0;
+	int number_of_entries                                 = 0;
+	int result                                            = 1;
+
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_scanner->number_of_queued_entries != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment scanner - number of queued entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments > (uint32_t) segment_scanner->number_of_entries )
+	{
+		number_of_entries = segment_scanner->number_of_entries;
+	}
+	else
+	{
+		number_of_entries = (int) number_of_segments;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		segment_scanner_entry = &( segment_scanner->entries[ entry_index ] );
+
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     first_segment_index + entry_index,
+		     &( segment_scanner_entry->file_io_pool_entry ),
+		     &( segment_scanner_entry->segment_file_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 first_segment_index + entry_index );
+
+			result = -1;
+
+			break;
+		}
+		segment_scanner_entry->segment_index = first_segment_index + entry_index;
+		segment_scanner_entry->file_io_pool  = file_io_pool;
+		segment_scanner_entry->segment_file  = NULL;
+		segment_scanner_entry->status        = LIBEWF_SEGMENT_SCANNER_ENTRY_STATUS_QUEUED;
+
+		if( libcthreads_mutex_grab(
+		     segment_scanner->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			segment_scanner_entry->status = LIBEWF_SEGMENT_SCANNER_ENTRY_STATUS_EMPTY;
+
+			result = -1;
+
+			break;
+		}
+		segment_scanner->number_of_queued_entries += 1;
+
+		if( libcthreads_mutex_release(
+		     segment_scanner->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_thread_pool_push(
+		     segment_scanner->thread_pool,
+		     (intptr_t *) segment_scanner_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push segment: %" PRIu32 " onto thread pool.",
+			 function,
+			 first_segment_index + entry_index );
+
+			if( libcthreads_mutex_grab(
+			     segment_scanner->mutex,
+			     NULL ) != 1 )
+			{
+				return( -1 );
+			}
+			segment_scanner->number_of_queued_entries -= 1;
+
+			if( libcthreads_mutex_release(
+			     segment_scanner->mutex,
+			     NULL ) != 1 )
+			{
+				return( -1 );
+			}
+			segment_scanner_entry->status = LIBEWF_SEGMENT_SCANNER_ENTRY_STATUS_EMPTY;
+
+			result = -1;
+
+			break;
+		}
+	}
+	/* Wait for the queued entries even on error, since the worker threads reference them
+	 */
+	if( libcthreads_mutex_grab(
+	     segment_scanner->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( segment_scanner->number_of_queued_entries > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     segment_scanner->condition,
+		     segment_scanner->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 segment_scanner->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     segment_scanner->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* Merge the segment files into the segment table in segment order
+	 */
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		segment_scanner_entry = &( segment_scanner->entries[ entry_index ] );
+
+		if( ( result == 1 )
+		 && ( segment_scanner_entry->status == LIBEWF_SEGMENT_SCANNER_ENTRY_STATUS_AVAILABLE ) )
+		{
+			if( libewf_segment_table_set_segment_file_by_index(
+			     segment_table,
+			     segment_scanner_entry->segment_index,
+			     file_io_pool,
+			     segment_scanner_entry->segment_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment file: %" PRIu32 " in segment table.",
+				 function,
+				 segment_scanner_entry->segment_index );
+
+				result = -1;
+			}
+			else
+			{
+				/* The segment table now manages the segment file
+				 */
+				segment_scanner_entry->segment_file = NULL;
+			}
+		}
+		if( segment_scanner_entry->segment_file != NULL )
+		{
+			libewf_segment_file_free(
+			 &( segment_scanner_entry->segment_file ),
+			 NULL );
+		}
+		segment_scanner_entry->status = LIBEWF_SEGMENT_SCANNER_ENTRY_STATUS_EMPTY;
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
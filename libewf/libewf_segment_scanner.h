@@ -0,0 +1,133 @@
+/*
+ * Segment file scanner functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SEGMENT_SCANNER_H )
+#define _LIBEWF_SEGMENT_SCANNER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_segment_scanner_entry libewf_segment_scanner_entry_t;
+
+struct libewf_segment_scanner_entry
+{
+	/* The segment index
+	 */
+	uint32_t segment_index;
+
+	/* The file IO pool
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The segment file size
+	 */
+	size64_t segment_file_size;
+
+	/* The segment file
+	 */
+	libewf_segment_file_t *segment_file;
+
+	/* The status
+	 */
+	uint8_t status;
+};
+
+typedef struct libewf_segment_scanner libewf_segment_scanner_t;
+
+struct libewf_segment_scanner
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The entries
+	 */
+	libewf_segment_scanner_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The number of queued entries
+	 */
+	int number_of_queued_entries;
+
+	/* The worker thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The entries mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The entries condition
+	 */
+	libcthreads_condition_t *condition;
+};
+
+int libewf_segment_scanner_initialize(
+     libewf_segment_scanner_t **segment_scanner,
+     libewf_io_handle_t *io_handle,
+     int number_of_entries,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_segment_scanner_free(
+     libewf_segment_scanner_t **segment_scanner,
+     libcerror_error_t **error );
+
+int libewf_segment_scanner_process_entry_callback(
+     libewf_segment_scanner_entry_t *segment_scanner_entry,
+     libewf_segment_scanner_t *segment_scanner );
+
+int libewf_segment_scanner_scan(
+     libewf_segment_scanner_t *segment_scanner,
+     libewf_segment_table_t *segment_table,
+     libbfio_pool_t *file_io_pool,
+     uint32_t first_segment_index,
+     uint32_t number_of_segments,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SEGMENT_SCANNER_H ) */
+
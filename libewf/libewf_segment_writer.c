@@ -0,0 +1,898 @@
+/*
+ * Segment writer functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_segment_writer.h"
+
+/* Creates a segment writer
+ * Make sure the value segment_writer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_writer_initialize(
+     libewf_segment_writer_t **segment_writer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_writer_initialize";
+	int buffer_index      = 0;
+
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_writer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment writer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size < (size_t) LIBEWF_SEGMENT_WRITER_MINIMUM_BUFFER_SIZE )
+	 || ( buffer_size > (size_t) LIBEWF_SEGMENT_WRITER_MAXIMUM_BUFFER_SIZE )
+	 || ( buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_writer = memory_allocate_structure(
+	                   libewf_segment_writer_t );
+
+	if( *segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment writer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_writer,
+	     0,
+	     sizeof( libewf_segment_writer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment writer.",
+		 function );
+
+		memory_free(
+		 *segment_writer );
+
+		*segment_writer = NULL;
+
+		return( -1 );
+	}
+	for( buffer_index = 0;
+	     buffer_index < LIBEWF_SEGMENT_WRITER_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		( *segment_writer )->buffers[ buffer_index ].data = (uint8_t *) memory_allocate(
+		                                                                 sizeof( uint8_t ) * buffer_size );
+
+		if( ( *segment_writer )->buffers[ buffer_index ].data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer: %d data.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+		( *segment_writer )->buffers[ buffer_index ].file_io_pool_entry = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *segment_writer )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *segment_writer )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	/* A single writer thread keeps the buffers written in the order they were submitted
+	 */
+	if( libcthreads_thread_pool_create(
+	     &( ( *segment_writer )->thread_pool ),
+	     NULL,
+	     1,
+	     LIBEWF_SEGMENT_WRITER_NUMBER_OF_BUFFERS,
+	     (int (*)(intptr_t *, void *)) &libewf_segment_writer_process_buffer_callback,
+	     (void *) *segment_writer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	( *segment_writer )->buffer_size = buffer_size;
+
+	return( 1 );
+
+on_error:
+	if( *segment_writer != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *segment_writer )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *segment_writer )->condition ),
+			 NULL );
+		}
+		if( ( *segment_writer )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *segment_writer )->mutex ),
+			 NULL );
+		}
+#endif
+		for( buffer_index = 0;
+		     buffer_index < LIBEWF_SEGMENT_WRITER_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			if( ( *segment_writer )->buffers[ buffer_index ].data != NULL )
+			{
+				memory_free(
+				 ( *segment_writer )->buffers[ buffer_index ].data );
+			}
+		}
+		memory_free(
+		 *segment_writer );
+
+		*segment_writer = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment writer
+ * Waits for the writer thread to finish, data that was not flushed is discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_writer_free(
+     libewf_segment_writer_t **segment_writer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_writer_free";
+	int buffer_index      = 0;
+	int result            = 1;
+
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_writer != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *segment_writer )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *segment_writer )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *segment_writer )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *segment_writer )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+		for( buffer_index = 0;
+		     buffer_index < LIBEWF_SEGMENT_WRITER_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			memory_free(
+			 ( *segment_writer )->buffers[ buffer_index ].data );
+		}
+		memory_free(
+		 *segment_writer );
+
+		*segment_writer = NULL;
+	}
+	return( result );
+}
+
+/* Writes the data of a segment writer buffer to its file IO pool entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_writer_write_buffer(
+     libewf_segment_writer_buffer_t *segment_writer_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_writer_write_buffer";
+	ssize_t write_count   = 0;
+
+	if( segment_writer_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_writer_buffer->data_size == 0 )
+	{
+		return( 1 );
+	}
+	write_count = libbfio_pool_write_buffer(
+	               segment_writer_buffer->file_io_pool,
+	               segment_writer_buffer->file_io_pool_entry,
+	               segment_writer_buffer->data,
+	               segment_writer_buffer->data_size,
+	               error );
+
+	if( write_count != (ssize_t) segment_writer_buffer->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer of size: %" PRIzd " to file IO pool entry: %d.",
+		 function,
+		 segment_writer_buffer->data_size,
+		 segment_writer_buffer->file_io_pool_entry );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Writes the data of a segment writer buffer
+ * Callback function for the segment writer thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_writer_process_buffer_callback(
+     libewf_segment_writer_buffer_t *segment_writer_buffer,
+     libewf_segment_writer_t *segment_writer )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_segment_writer_process_buffer_callback";
+	uint8_t status           = LIBEWF_SEGMENT_WRITER_BUFFER_STATUS_FAILED;
+	int result               = 1;
+
+	if( segment_writer_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_writer_write_buffer(
+	     segment_writer_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		status = LIBEWF_SEGMENT_WRITER_BUFFER_STATUS_WRITTEN;
+	}
+	if( libcthreads_mutex_grab(
+	     segment_writer->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	segment_writer_buffer->status = status;
+
+	if( libcthreads_condition_broadcast(
+	     segment_writer->condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     segment_writer->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( error != NULL )
+	{
+		/* A failed buffer is reported when it is waited for
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Waits for a segment writer buffer to be written and makes it available for filling
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_writer_wait_for_buffer(
+     libewf_segment_writer_t *segment_writer,
+     libewf_segment_writer_buffer_t *segment_writer_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_writer_wait_for_buffer";
+	uint8_t status        = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int result            = 1;
+#endif
+
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_writer_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     segment_writer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( segment_writer_buffer->status == LIBEWF_SEGMENT_WRITER_BUFFER_STATUS_QUEUED )
+	{
+		if( libcthreads_condition_wait(
+		     segment_writer->condition,
+		     segment_writer->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	status = segment_writer_buffer->status;
+
+	if( libcthreads_mutex_release(
+	     segment_writer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+#else
+	status = segment_writer_buffer->status;
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	if( status == LIBEWF_SEGMENT_WRITER_BUFFER_STATUS_EMPTY )
+	{
+		return( 1 );
+	}
+	segment_writer_buffer->data_size = 0;
+	segment_writer_buffer->status    = LIBEWF_SEGMENT_WRITER_BUFFER_STATUS_EMPTY;
+
+	if( status != LIBEWF_SEGMENT_WRITER_BUFFER_STATUS_WRITTEN )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffered data to file IO pool entry: %d.",
+		 function,
+		 segment_writer_buffer->file_io_pool_entry );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Submits the buffer that is being filled for writing and switches to the next buffer
+ * Without multi-thread support the buffer is written before returning
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_writer_submit_current_buffer(
+     libewf_segment_writer_t *segment_writer,
+     libcerror_error_t **error )
+{
+	libewf_segment_writer_buffer_t *segment_writer_buffer = NULL;
+	static char *function                                 = "libewf_segment_writer_submit_current_buffer";
+
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	segment_writer_buffer = &( segment_writer->buffers[ segment_writer->current_buffer_index ] );
+
+	if( segment_writer_buffer->data_size == 0 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	segment_writer_buffer->status = LIBEWF_SEGMENT_WRITER_BUFFER_STATUS_QUEUED;
+
+	if( libcthreads_thread_pool_push(
+	     segment_writer->thread_pool,
+	     (intptr_t *) segment_writer_buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push buffer onto thread pool queue.",
+		 function );
+
+		segment_writer_buffer->data_size = 0;
+		segment_writer_buffer->status    = LIBEWF_SEGMENT_WRITER_BUFFER_STATUS_EMPTY;
+
+		return( -1 );
+	}
+#else
+	if( libewf_segment_writer_write_buffer(
+	     segment_writer_buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		segment_writer_buffer->data_size = 0;
+
+		return( -1 );
+	}
+	segment_writer_buffer->data_size = 0;
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	segment_writer->current_buffer_index += 1;
+
+	if( segment_writer->current_buffer_index >= LIBEWF_SEGMENT_WRITER_NUMBER_OF_BUFFERS )
+	{
+		segment_writer->current_buffer_index = 0;
+	}
+	/* Make sure the next buffer was written before it is filled again
+	 */
+	if( libewf_segment_writer_wait_for_buffer(
+	     segment_writer,
+	     &( segment_writer->buffers[ segment_writer->current_buffer_index ] ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to wait for buffer: %d.",
+		 function,
+		 segment_writer->current_buffer_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends chunk data to be written to a file IO pool entry
+ * The chunk data is copied into the current buffer, that is written when full or
+ * when the file IO pool entry changes. Chunk data that does not fit in a buffer
+ * is written directly after the buffered data was written.
+ * Returns the number of bytes appended or -1 on error
+ */
+ssize_t libewf_segment_writer_append_chunk_data(
+         libewf_segment_writer_t *segment_writer,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         libewf_chunk_data_t *chunk_data,
+         libcerror_error_t **error )
+{
+	libewf_segment_writer_buffer_t *segment_writer_buffer = NULL;
+	static char *function                                 = "libewf_segment_writer_append_chunk_data";
+	ssize_t write_count                                   = 0;
+	uint32_t chunk_write_size                             = 0;
+
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file IO pool entry value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_data_get_write_size(
+	     chunk_data,
+	     &chunk_write_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk write size.",
+		 function );
+
+		return( -1 );
+	}
+	segment_writer_buffer = &( segment_writer->buffers[ segment_writer->current_buffer_index ] );
+
+	if( ( segment_writer_buffer->data_size > 0 )
+	 && ( ( segment_writer_buffer->file_io_pool != file_io_pool )
+	  ||  ( segment_writer_buffer->file_io_pool_entry != file_io_pool_entry )
+	  ||  ( (size_t) chunk_write_size > ( segment_writer->buffer_size - segment_writer_buffer->data_size ) ) ) )
+	{
+		if( libewf_segment_writer_submit_current_buffer(
+		     segment_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to submit buffer.",
+			 function );
+
+			return( -1 );
+		}
+		segment_writer_buffer = &( segment_writer->buffers[ segment_writer->current_buffer_index ] );
+	}
+	if( (size_t) chunk_write_size > segment_writer->buffer_size )
+	{
+		if( libewf_segment_writer_flush(
+		     segment_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush segment writer.",
+			 function );
+
+			return( -1 );
+		}
+		write_count = libewf_chunk_data_write(
+		               chunk_data,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               error );
+
+		if( write_count != (ssize_t) chunk_write_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk data.",
+			 function );
+
+			return( -1 );
+		}
+		return( write_count );
+	}
+	write_count = libewf_chunk_data_copy_to_write_buffer(
+	               chunk_data,
+	               &( segment_writer_buffer->data[ segment_writer_buffer->data_size ] ),
+	               segment_writer->buffer_size - segment_writer_buffer->data_size,
+	               error );
+
+	if( write_count != (ssize_t) chunk_write_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk data to buffer.",
+		 function );
+
+		return( -1 );
+	}
+	segment_writer_buffer->file_io_pool       = file_io_pool;
+	segment_writer_buffer->file_io_pool_entry = file_io_pool_entry;
+	segment_writer_buffer->data_size         += (size_t) write_count;
+
+	return( write_count );
+}
+
+/* Writes all buffered data and waits for the writes to complete
+ * This must be called before the file IO pool is accessed by anything else
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_writer_flush(
+     libewf_segment_writer_t *segment_writer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_writer_flush";
+	int buffer_index      = 0;
+	int result            = 1;
+
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_writer_submit_current_buffer(
+	     segment_writer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to submit buffer.",
+		 function );
+
+		result = -1;
+	}
+	/* Wait for all the buffers, so that the file IO pool is no longer accessed by the writer thread
+	 */
+	for( buffer_index = 0;
+	     buffer_index < LIBEWF_SEGMENT_WRITER_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		if( libewf_segment_writer_wait_for_buffer(
+		     segment_writer,
+		     &( segment_writer->buffers[ buffer_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to wait for buffer: %d.",
+			 function,
+			 buffer_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
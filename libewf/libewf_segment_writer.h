@@ -0,0 +1,140 @@
+/*
+ * Segment writer functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SEGMENT_WRITER_H )
+#define _LIBEWF_SEGMENT_WRITER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_segment_writer_buffer libewf_segment_writer_buffer_t;
+
+struct libewf_segment_writer_buffer
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The file IO pool the data is written to
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The file IO pool entry the data is written to
+	 */
+	int file_io_pool_entry;
+
+	/* The status
+	 */
+	uint8_t status;
+};
+
+typedef struct libewf_segment_writer libewf_segment_writer_t;
+
+struct libewf_segment_writer
+{
+	/* The buffers
+	 */
+	libewf_segment_writer_buffer_t buffers[ LIBEWF_SEGMENT_WRITER_NUMBER_OF_BUFFERS ];
+
+	/* The size of a buffer
+	 */
+	size_t buffer_size;
+
+	/* The index of the buffer that is being filled
+	 */
+	int current_buffer_index;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The writer thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The buffers mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The buffers condition
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int libewf_segment_writer_initialize(
+     libewf_segment_writer_t **segment_writer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libewf_segment_writer_free(
+     libewf_segment_writer_t **segment_writer,
+     libcerror_error_t **error );
+
+int libewf_segment_writer_write_buffer(
+     libewf_segment_writer_buffer_t *segment_writer_buffer,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_segment_writer_process_buffer_callback(
+     libewf_segment_writer_buffer_t *segment_writer_buffer,
+     libewf_segment_writer_t *segment_writer );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+int libewf_segment_writer_wait_for_buffer(
+     libewf_segment_writer_t *segment_writer,
+     libewf_segment_writer_buffer_t *segment_writer_buffer,
+     libcerror_error_t **error );
+
+int libewf_segment_writer_submit_current_buffer(
+     libewf_segment_writer_t *segment_writer,
+     libcerror_error_t **error );
+
+ssize_t libewf_segment_writer_append_chunk_data(
+         libewf_segment_writer_t *segment_writer,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         libewf_chunk_data_t *chunk_data,
+         libcerror_error_t **error );
+
+int libewf_segment_writer_flush(
+     libewf_segment_writer_t *segment_writer,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SEGMENT_WRITER_H ) */
+
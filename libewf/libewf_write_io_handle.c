@@ -36,12 +36,16 @@
 
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_descriptor.h"
+#include "libewf_chunk_fingerprint_index.h"
 #include "libewf_chunk_table.h"
 #include "libewf_compression.h"
 #include "libewf_definitions.h"
+#include "libewf_direct_file_io_handle.h"
+#include "libewf_file_allocation.h"
 #include "libewf_filename.h"
 #include "libewf_header_sections.h"
 #include "libewf_header_values.h"
+#include "libewf_integrity_hash.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
@@ -50,11 +54,13 @@
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
+#include "libewf_libhmac.h"
 #include "libewf_media_values.h"
 #include "libewf_read_io_handle.h"
 #include "libewf_section.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_segment_writer.h"
 #include "libewf_unused.h"
 #include "libewf_write_io_handle.h"
 
@@ -224,6 +230,54 @@ int libewf_write_io_handle_free(
 			memory_free(
 			 ( *write_io_handle )->compressed_zero_byte_empty_block );
 		}
+		if( ( *write_io_handle )->segment_writer != NULL )
+		{
+			if( libewf_segment_writer_free(
+			     &( ( *write_io_handle )->segment_writer ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free segment writer.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *write_io_handle )->chunk_fingerprint_index != NULL )
+		{
+			if( libewf_chunk_fingerprint_index_free(
+			     &( ( *write_io_handle )->chunk_fingerprint_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk fingerprint index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *write_io_handle )->integrity_hash != NULL )
+		{
+			if( libewf_integrity_hash_free(
+			     &( ( *write_io_handle )->integrity_hash ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free integrity hash.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libcdata_array_free(
 		     &( ( *write_io_handle )->chunks_section ),
 		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_descriptor_free,
@@ -325,6 +379,9 @@ int libewf_write_io_handle_clone(
 	( *destination_write_io_handle )->chunks_section             = NULL;
 	( *destination_write_io_handle )->current_file_io_pool_entry = -1;
 	( *destination_write_io_handle )->current_segment_file       = NULL;
+	( *destination_write_io_handle )->segment_writer             = NULL;
+	( *destination_write_io_handle )->chunk_fingerprint_index    = NULL;
+	( *destination_write_io_handle )->integrity_hash             = NULL;
 
 	if( source_write_io_handle->case_data != NULL )
 	{
@@ -505,6 +562,46 @@ on_error:
 	return( -1 );
 }
 
+/* Writes the chunk data buffered by the segment writer, if any
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_flush_segment_writer(
+     libewf_write_io_handle_t *write_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_io_handle_flush_segment_writer";
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->segment_writer == NULL )
+	{
+		return( 1 );
+	}
+	if( libewf_segment_writer_flush(
+	     write_io_handle->segment_writer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Initializes the write IO handle value to start writing
  * Returns 1 if successful or -1 on error
  */
@@ -733,6 +830,57 @@ int libewf_write_io_handle_initialize_values(
 			goto on_error;
 		}
 	}
+	if( write_io_handle->deduplicate_chunks != 0 )
+	{
+		/* Only the EWFX format allows for multiple table entries that refer to the same chunk data
+		 */
+		if( io_handle->format != LIBEWF_FORMAT_EWFX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: format does not allow for chunk deduplication.",
+			 function );
+
+			goto on_error;
+		}
+		if( write_io_handle->chunk_fingerprint_index == NULL )
+		{
+			if( libewf_chunk_fingerprint_index_initialize(
+			     &( write_io_handle->chunk_fingerprint_index ),
+			     LIBEWF_CHUNK_FINGERPRINT_INDEX_NUMBER_OF_ENTRIES,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk fingerprint index.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( ( write_io_handle->integrity_hash_flags != 0 )
+	 && ( write_io_handle->integrity_hash == NULL ) )
+	{
+		if( libewf_integrity_hash_initialize(
+		     &( write_io_handle->integrity_hash ),
+		     write_io_handle->integrity_hash_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create integrity hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	io_handle->chunk_size = media_values->chunk_size;
 
 	if( ( write_io_handle->pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 )
@@ -2362,6 +2510,7 @@ int libewf_write_io_handle_test_chunks_section_full(
 }
 
 /* Creates a new segment file and opens it for writing
+ * A preallocation size of 0 represents that no space is preallocated
  * Returns 1 if successful or -1 on error
  */
 int libewf_write_io_handle_create_segment_file(
@@ -2372,6 +2521,7 @@ int libewf_write_io_handle_create_segment_file(
      uint32_t segment_number,
      uint32_t maximum_number_of_segments,
      const uint8_t *set_identifier,
+     size64_t preallocation_size,
      int *file_io_pool_entry,
      libewf_segment_file_t **segment_file,
      libcerror_error_t **error )
@@ -2381,7 +2531,9 @@ int libewf_write_io_handle_create_segment_file(
 	system_character_t *filename             = NULL;
 	static char *function                    = "libewf_write_io_handle_create_segment_file";
 	size_t filename_size                     = 0;
+	uint8_t is_preallocated                  = 0;
 	int bfio_access_flags                    = 0;
+	int result                               = 0;
 	int safe_file_io_pool_entry              = 0;
 
 	if( io_handle == NULL )
@@ -2481,47 +2633,74 @@ int libewf_write_io_handle_create_segment_file(
 		 filename );
 	}
 #endif
-	if( libbfio_file_initialize(
-	     &file_io_handle,
-	     error ) != 1 )
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT )
+	if( io_handle->use_direct_io != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO handle.",
-		 function );
-
-		goto on_error;
-	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libbfio_file_set_name_wide(
-	     file_io_handle,
-	     filename,
-	     filename_size,
-	     error ) != 1 )
+		result = libewf_direct_file_initialize_wide(
+		          &file_io_handle,
+		          filename,
+		          filename_size - 1,
+		          error );
 #else
-	if( libbfio_file_set_name(
-	     file_io_handle,
-	     filename,
-	     filename_size,
-	     error ) != 1 )
+		result = libewf_direct_file_initialize(
+		          &file_io_handle,
+		          filename,
+		          filename_size - 1,
+		          error );
 #endif
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set filename in file IO handle.",
-		 function );
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create direct file IO handle.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
-	memory_free(
-	 filename );
+	else
+#endif
+	{
+		if( libbfio_file_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
 
-	filename = NULL;
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libbfio_file_set_name_wide(
+		     file_io_handle,
+		     filename,
+		     filename_size,
+		     error ) != 1 )
+#else
+		if( libbfio_file_set_name(
+		     file_io_handle,
+		     filename,
+		     filename_size,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in file IO handle.",
+			 function );
 
+			goto on_error;
+		}
+	}
 	bfio_access_flags = LIBBFIO_OPEN_WRITE_TRUNCATE;
 
 	if( libbfio_pool_append_handle(
@@ -2558,6 +2737,45 @@ int libewf_write_io_handle_create_segment_file(
 
 		goto on_error;
 	}
+	if( preallocation_size > 0 )
+	{
+		result = libewf_file_allocation_preallocate(
+		          filename,
+		          preallocation_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to preallocate segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			is_preallocated = 1;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		else if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to preallocate: %" PRIu64 " bytes for segment file: %" PRIu32 ".\n",
+			 function,
+			 preallocation_size,
+			 segment_number );
+		}
+#endif
+	}
+	memory_free(
+	 filename );
+
+	filename = NULL;
+
 	if( libewf_segment_file_initialize(
 	     &safe_segment_file,
 	     io_handle,
@@ -2576,6 +2794,11 @@ int libewf_write_io_handle_create_segment_file(
 	safe_segment_file->segment_number = segment_number + 1;
 	safe_segment_file->flags         |= LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN;
 
+	if( is_preallocated != 0 )
+	{
+		safe_segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_PREALLOCATED;
+	}
+
 	if( ( segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
 	 || ( segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
 	 || ( segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART ) )
@@ -2936,6 +3159,171 @@ ssize_t libewf_write_io_handle_write_chunks_section_start(
 	return( write_count );
 }
 
+/* Writes padding after the start of the chunks section so that the chunk data
+ * starts at a multiple of the chunks section alignment
+ * No padding is written if it would not leave space for a chunk in the segment file
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_write_io_handle_write_chunks_section_padding(
+         libewf_write_io_handle_t *write_io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         int file_io_pool_entry,
+         libewf_segment_file_t *segment_file,
+         libcerror_error_t **error )
+{
+	uint8_t *padding_data = NULL;
+	static char *function = "libewf_write_io_handle_write_chunks_section_padding";
+	size_t padding_size   = 0;
+	ssize_t write_count   = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->chunks_section_alignment > LIBEWF_MAXIMUM_CHUNKS_SECTION_ALIGNMENT )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid write IO handle - chunks section alignment value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment file - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->chunks_section_alignment <= 1 )
+	{
+		return( 0 );
+	}
+	padding_size = (size_t) ( segment_file->current_offset % write_io_handle->chunks_section_alignment );
+
+	if( padding_size == 0 )
+	{
+		return( 0 );
+	}
+	padding_size = write_io_handle->chunks_section_alignment - padding_size;
+
+	if( write_io_handle->remaining_segment_file_size < (ssize64_t) ( padding_size + media_values->chunk_size + 4 ) )
+	{
+		return( 0 );
+	}
+	padding_data = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * padding_size );
+
+	if( padding_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create padding data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     padding_data,
+	     0,
+	     padding_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear padding data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: writing chunks section padding of size: %" PRIzu " at offset: %" PRIi64 " (0x%08" PRIx64 ").\n",
+		 function,
+		 padding_size,
+		 segment_file->current_offset,
+		 segment_file->current_offset );
+	}
+#endif
+	write_count = libbfio_pool_write_buffer(
+	               file_io_pool,
+	               file_io_pool_entry,
+	               padding_data,
+	               padding_size,
+	               error );
+
+	if( write_count != (ssize_t) padding_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write padding data.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 padding_data );
+
+	/* The padding is part of the chunks section
+	 */
+	segment_file->current_offset                += write_count;
+	write_io_handle->chunks_section_write_count += write_count;
+
+	return( write_count );
+
+on_error:
+	if( padding_data != NULL )
+	{
+		memory_free(
+		 padding_data );
+	}
+	return( -1 );
+}
+
 /* Writes the end of the chunks section
  * Returns the number of bytes written or -1 on error
  */
@@ -3040,6 +3428,21 @@ ssize_t libewf_write_io_handle_write_chunks_section_end(
 
 		return( -1 );
 	}
+	/* The buffered chunk data must be written before the end of the chunks section
+	 */
+	if( libewf_write_io_handle_flush_segment_writer(
+	     write_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush segment writer.",
+		 function );
+
+		return( -1 );
+	}
 	write_count = libewf_segment_file_write_chunks_section_end(
 		       segment_file,
 		       file_io_pool,
@@ -3102,6 +3505,8 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_segment_file(
 {
 	libewf_segment_file_t *safe_segment_file = NULL;
 	static char *function                    = "libewf_write_io_handle_write_new_chunk_create_segment_file";
+	size64_t preallocation_size              = 0;
+	size64_t remaining_media_size            = 0;
 	ssize_t write_count                      = 0;
 	int safe_file_io_pool_entry              = 0;
 
@@ -3184,6 +3589,25 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_segment_file(
 		 segment_number );
 	}
 #endif
+	/* Preallocate the space of a full segment file or of the remaining media data
+	 * if that is smaller, the space that is not used is released when the segment file is closed
+	 */
+	if( write_io_handle->preallocate_segment_files != 0 )
+	{
+		preallocation_size = segment_table->maximum_segment_size;
+
+		if( ( media_values->media_size != 0 )
+		 && ( write_io_handle->input_write_count >= 0 )
+		 && ( (size64_t) write_io_handle->input_write_count < media_values->media_size ) )
+		{
+			remaining_media_size = media_values->media_size - (size64_t) write_io_handle->input_write_count;
+
+			if( remaining_media_size < preallocation_size )
+			{
+				preallocation_size = remaining_media_size;
+			}
+		}
+	}
 	if( libewf_write_io_handle_create_segment_file(
 	     io_handle,
 	     file_io_pool,
@@ -3192,6 +3616,7 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_segment_file(
 	     segment_number,
 	     write_io_handle->maximum_number_of_segments,
 	     media_values->set_identifier,
+	     preallocation_size,
 	     &safe_file_io_pool_entry,
 	     &safe_segment_file,
 	     error ) != 1 )
@@ -3303,8 +3728,9 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_chunks_section(
          libewf_segment_file_t *segment_file,
          libcerror_error_t **error )
 {
-	static char *function = "libewf_write_io_handle_write_new_chunk_create_chunks_section";
-	ssize_t write_count   = 0;
+	static char *function     = "libewf_write_io_handle_write_new_chunk_create_chunks_section";
+	ssize_t total_write_count = 0;
+	ssize_t write_count       = 0;
 
 	if( write_io_handle == NULL )
 	{
@@ -3347,11 +3773,44 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_chunks_section(
 		 function );
 	}
 #endif
+	/* The offset of the chunks section is retrieved from the file IO pool
+	 */
+	if( libewf_write_io_handle_flush_segment_writer(
+	     write_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush segment writer.",
+		 function );
+
+		return( -1 );
+	}
 	write_io_handle->create_chunks_section               = 0;
 	write_io_handle->number_of_chunks_written_to_section = 0;
 	write_io_handle->chunks_section_write_count          = 0;
 	write_io_handle->chunks_section_padding_size         = 0;
 
+	/* The table entries of a chunks section can only refer to chunk data in the same chunks section
+	 */
+	if( write_io_handle->chunk_fingerprint_index != NULL )
+	{
+		if( libewf_chunk_fingerprint_index_empty(
+		     write_io_handle->chunk_fingerprint_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to empty chunk fingerprint index.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	/* Reserve space in the segment file for the end of the chunks section
 	 */
 	write_io_handle->remaining_segment_file_size -= write_io_handle->chunks_section_reserved_size;
@@ -3447,12 +3906,37 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_chunks_section(
 		return( -1 );
 	}
 	write_io_handle->remaining_segment_file_size -= write_count;
+	total_write_count                            += write_count;
 
-	return( write_count );
+	write_count = libewf_write_io_handle_write_chunks_section_padding(
+		       write_io_handle,
+		       file_io_pool,
+		       media_values,
+		       file_io_pool_entry,
+		       segment_file,
+		       error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunks section padding.",
+		 function );
+
+		return( -1 );
+	}
+	write_io_handle->remaining_segment_file_size -= write_count;
+	total_write_count                            += write_count;
+
+	return( total_write_count );
 }
 
-/* Creates a new chunks section
- * Returns the number of bytes written, 0 when no longer bytes can be written or -1 on error
+/* Creates a new chunk
+ * A chunk that is a duplicate of a chunk already stored is not written again,
+ * in which case the size of the chunk data it references is returned
+ * Returns the number of bytes written or -1 on error
  */
 ssize_t libewf_write_io_handle_write_new_chunk_create_chunk(
          libewf_write_io_handle_t *write_io_handle,
@@ -3464,11 +3948,18 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_chunk(
          size_t input_data_size,
          libcerror_error_t **error )
 {
+	uint8_t chunk_fingerprint[ LIBEWF_CHUNK_FINGERPRINT_SIZE ];
+
 	libewf_chunk_descriptor_t *chunk_descriptor = NULL;
 	static char *function                       = "libewf_write_io_handle_write_new_chunk_create_chunk";
 	ssize_t write_count                         = 0;
 	off64_t chunk_offset                        = 0;
+	off64_t stored_chunk_offset                 = 0;
+	uint32_t chunk_data_size                    = 0;
+	uint32_t stored_chunk_data_size             = 0;
+	uint32_t stored_range_flags                 = 0;
 	int entry_index                             = 0;
+	int result                                  = 0;
 
 	if( write_io_handle == NULL )
 	{
@@ -3492,38 +3983,144 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_chunk(
 
 		return( -1 );
 	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
 	chunk_offset = write_io_handle->current_segment_file->current_offset;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	/* Determine if the packed chunk data was already stored in the current chunks section
+	 */
+	if( write_io_handle->chunk_fingerprint_index != NULL )
 	{
-		libcnotify_printf(
-		 "%s: writing chunk: %" PRIu64 " data of size: %" PRIzd " to segment file: %" PRIu32 " at offset: 0x%08" PRIx64 ".\n",
-		 function,
-		 chunk_index,
-		 chunk_data->data_size,
-		 segment_file->segment_number,
-		 chunk_offset );
+		if( libhmac_sha256_calculate(
+		     chunk_data->data,
+		     chunk_data->data_size,
+		     chunk_fingerprint,
+		     LIBEWF_CHUNK_FINGERPRINT_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate chunk: %" PRIu64 " fingerprint.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		result = libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+		          write_io_handle->chunk_fingerprint_index,
+		          chunk_fingerprint,
+		          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+		          &stored_chunk_offset,
+		          &stored_chunk_data_size,
+		          &stored_range_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " by fingerprint.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		/* The stored chunk data also contains the checksum of uncompressed chunk data
+		 * hence the range flags must match as well
+		 */
+		else if( ( result != 0 )
+		      && ( stored_range_flags != chunk_data->range_flags ) )
+		{
+			result = 0;
+		}
 	}
+	if( result != 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: chunk: %" PRIu64 " data is a duplicate of data at offset: 0x%08" PRIx64 ".\n",
+			 function,
+			 chunk_index,
+			 stored_chunk_offset );
+		}
 #endif
-	write_count = libewf_segment_file_write_chunk_data(
-		       segment_file,
-		       file_io_pool,
-		       file_io_pool_entry,
-		       chunk_index,
-		       chunk_data,
-	               error );
-
-	if( write_count < 0 )
+		chunk_offset    = stored_chunk_offset;
+		chunk_data_size = stored_chunk_data_size;
+		write_count     = 0;
+	}
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write chunk data.",
-		 function );
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: writing chunk: %" PRIu64 " data of size: %" PRIzd " to segment file: %" PRIu32 " at offset: 0x%08" PRIx64 ".\n",
+			 function,
+			 chunk_index,
+			 chunk_data->data_size,
+			 segment_file->segment_number,
+			 chunk_offset );
+		}
+#endif
+		write_count = libewf_segment_file_write_chunk_data(
+			       segment_file,
+			       file_io_pool,
+			       file_io_pool_entry,
+			       write_io_handle->segment_writer,
+			       chunk_index,
+			       chunk_data,
+			       error );
 
-		goto on_error;
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk data.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_data_size = (uint32_t) ( write_count - chunk_data->padding_size );
+
+		if( write_io_handle->chunk_fingerprint_index != NULL )
+		{
+			if( libewf_chunk_fingerprint_index_set_chunk_by_fingerprint(
+			     write_io_handle->chunk_fingerprint_index,
+			     chunk_fingerprint,
+			     LIBEWF_CHUNK_FINGERPRINT_SIZE,
+			     chunk_offset,
+			     chunk_data_size,
+			     chunk_data->range_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set chunk: %" PRIu64 " by fingerprint.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
 	}
 	if( libewf_chunk_descriptor_initialize(
 	     &chunk_descriptor,
@@ -3539,7 +4136,7 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_chunk(
 		goto on_error;
 	}
 	chunk_descriptor->data_offset = chunk_offset;
-	chunk_descriptor->data_size   = (size64_t) write_count - chunk_data->padding_size;
+	chunk_descriptor->data_size   = (size64_t) chunk_data_size;
 	chunk_descriptor->range_flags = chunk_data->range_flags;
 
 	if( libcdata_array_append_entry(
@@ -3568,6 +4165,10 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_chunk(
 	write_io_handle->number_of_chunks_written_to_section      += 1;
 	write_io_handle->number_of_chunks_written                 += 1;
 
+	if( write_count == 0 )
+	{
+		return( (ssize_t) chunk_data_size );
+	}
 	return( write_count );
 
 on_error:
@@ -35,8 +35,10 @@
 #endif
 
 #include "libewf_chunk_data.h"
+#include "libewf_chunk_fingerprint_index.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
+#include "libewf_integrity_hash.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -48,6 +50,7 @@
 #include "libewf_read_io_handle.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_segment_writer.h"
 
 #include "ewf_data.h"
 #include "ewf_table.h"
@@ -144,6 +147,30 @@ struct libewf_write_io_handle
 	 */
 	uint32_t maximum_number_of_segments;
 
+	/* Value to indicate if the space of new segment files should be preallocated
+	 */
+	uint8_t preallocate_segment_files;
+
+	/* The alignment of the chunk data in a chunks section, where 0 represents no alignment
+	 */
+	uint32_t chunks_section_alignment;
+
+	/* Value to indicate if duplicate chunks should be stored only once
+	 */
+	uint8_t deduplicate_chunks;
+
+	/* The fingerprint index of the chunks written to the current chunks section
+	 */
+	libewf_chunk_fingerprint_index_t *chunk_fingerprint_index;
+
+	/* The integrity hash flags
+	 */
+	uint8_t integrity_hash_flags;
+
+	/* The integrity hash of the media data that is written
+	 */
+	libewf_integrity_hash_t *integrity_hash;
+
 	/* The group of chunks written to the current chunks section
 	 */
 	libewf_chunk_group_t *chunk_group;
@@ -219,6 +246,10 @@ struct libewf_write_io_handle
 	/* The size of the compressed zero byte empty block
 	 */
 	size_t compressed_zero_byte_empty_block_size;
+
+	/* The segment writer, that buffers chunk data into large writes
+	 */
+	libewf_segment_writer_t *segment_writer;
 };
 
 int libewf_write_io_handle_initialize(
@@ -235,6 +266,10 @@ int libewf_write_io_handle_clone(
      libewf_write_io_handle_t *source_write_io_handle,
      libcerror_error_t **error );
 
+int libewf_write_io_handle_flush_segment_writer(
+     libewf_write_io_handle_t *write_io_handle,
+     libcerror_error_t **error );
+
 int libewf_write_io_handle_initialize_values(
      libewf_write_io_handle_t *write_io_handle,
      libewf_io_handle_t *io_handle,
@@ -291,6 +326,7 @@ int libewf_write_io_handle_create_segment_file(
      uint32_t segment_number,
      uint32_t maximum_number_of_segments,
      const uint8_t *set_identifier,
+     size64_t preallocation_size,
      int *file_io_pool_entry,
      libewf_segment_file_t **segment_file,
      libcerror_error_t **error );
@@ -313,6 +349,14 @@ ssize_t libewf_write_io_handle_write_chunks_section_start(
          libewf_segment_file_t *segment_file,
          libcerror_error_t **error );
 
+ssize_t libewf_write_io_handle_write_chunks_section_padding(
+         libewf_write_io_handle_t *write_io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         int file_io_pool_entry,
+         libewf_segment_file_t *segment_file,
+         libcerror_error_t **error );
+
 ssize_t libewf_write_io_handle_write_chunks_section_end(
          libewf_write_io_handle_t *write_io_handle,
          libewf_io_handle_t *io_handle,
@@ -0,0 +1,756 @@
+/*
+ * Chunk write pipeline functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_write_io_handle.h"
+#include "libewf_write_pipeline.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a write pipeline
+ * Make sure the value write_pipeline is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_pipeline_initialize(
+     libewf_write_pipeline_t **write_pipeline,
+     libewf_io_handle_t *io_handle,
+     libewf_write_io_handle_t *write_io_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_pipeline_initialize";
+	size_t entries_size   = 0;
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_pipeline != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write pipeline value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_WRITE_PIPELINE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*write_pipeline = memory_allocate_structure(
+	                   libewf_write_pipeline_t );
+
+	if( *write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create write pipeline.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *write_pipeline,
+	     0,
+	     sizeof( libewf_write_pipeline_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear write pipeline.",
+		 function );
+
+		memory_free(
+		 *write_pipeline );
+
+		*write_pipeline = NULL;
+
+		return( -1 );
+	}
+	( *write_pipeline )->number_of_entries = number_of_threads * LIBEWF_WRITE_PIPELINE_NUMBER_OF_ENTRIES_PER_THREAD;
+
+	entries_size = sizeof( libewf_write_pipeline_entry_t ) * ( *write_pipeline )->number_of_entries;
+
+	( *write_pipeline )->entries = (libewf_write_pipeline_entry_t *) memory_allocate(
+	                                                                  entries_size );
+
+	if( ( *write_pipeline )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *write_pipeline )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *write_pipeline )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *write_pipeline )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *write_pipeline )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     ( *write_pipeline )->number_of_entries,
+	     (int (*)(intptr_t *, void *)) &libewf_write_pipeline_process_entry_callback,
+	     (void *) *write_pipeline,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	( *write_pipeline )->io_handle       = io_handle;
+	( *write_pipeline )->write_io_handle = write_io_handle;
+
+	return( 1 );
+
+on_error:
+	if( *write_pipeline != NULL )
+	{
+		if( ( *write_pipeline )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *write_pipeline )->condition ),
+			 NULL );
+		}
+		if( ( *write_pipeline )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *write_pipeline )->mutex ),
+			 NULL );
+		}
+		if( ( *write_pipeline )->entries != NULL )
+		{
+			memory_free(
+			 ( *write_pipeline )->entries );
+		}
+		memory_free(
+		 *write_pipeline );
+
+		*write_pipeline = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a write pipeline
+ * Waits for the worker threads to finish, chunk data that was not popped is discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_pipeline_free(
+     libewf_write_pipeline_t **write_pipeline,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_pipeline_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_pipeline != NULL )
+	{
+		if( ( *write_pipeline )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *write_pipeline )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( entry_index = 0;
+		     entry_index < ( *write_pipeline )->number_of_entries;
+		     entry_index++ )
+		{
+			if( ( *write_pipeline )->entries[ entry_index ].chunk_data != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( ( *write_pipeline )->entries[ entry_index ].chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free entry: %d chunk data.",
+					 function,
+					 entry_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *write_pipeline )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *write_pipeline )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *write_pipeline )->entries );
+
+		memory_free(
+		 *write_pipeline );
+
+		*write_pipeline = NULL;
+	}
+	return( result );
+}
+
+/* Packs the chunk data of a write pipeline entry
+ * Callback function for the write pipeline thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_pipeline_process_entry_callback(
+     libewf_write_pipeline_entry_t *write_pipeline_entry,
+     libewf_write_pipeline_t *write_pipeline )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_write_pipeline_process_entry_callback";
+	uint8_t status           = LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_FAILED;
+	int result               = 1;
+
+	if( write_pipeline_entry == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_data_pack(
+	     write_pipeline_entry->chunk_data,
+	     write_pipeline->io_handle,
+	     write_pipeline->write_io_handle->compressed_zero_byte_empty_block,
+	     write_pipeline->write_io_handle->compressed_zero_byte_empty_block_size,
+	     write_pipeline->write_io_handle->pack_flags,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data.",
+		 function,
+		 write_pipeline_entry->chunk_index );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		status = LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_PACKED;
+	}
+	if( libcthreads_mutex_grab(
+	     write_pipeline->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	write_pipeline_entry->status = status;
+
+	if( libcthreads_condition_broadcast(
+	     write_pipeline->condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     write_pipeline->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( error != NULL )
+	{
+		/* A failed entry is reported when it is popped
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Waits for a queued write pipeline entry to be processed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_pipeline_wait_for_entry(
+     libewf_write_pipeline_t *write_pipeline,
+     libewf_write_pipeline_entry_t *write_pipeline_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_pipeline_wait_for_entry";
+	int result            = 1;
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_pipeline_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     write_pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( write_pipeline_entry->status == LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_QUEUED )
+	{
+		if( libcthreads_condition_wait(
+		     write_pipeline->condition,
+		     write_pipeline->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     write_pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Pushes chunk data onto the write pipeline to be packed by a worker thread
+ * The write pipeline takes over management of the chunk data if successful
+ * Returns 1 if successful, 0 if the write pipeline is full or -1 on error
+ */
+int libewf_write_pipeline_push_chunk_data(
+     libewf_write_pipeline_t *write_pipeline,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error )
+{
+	libewf_write_pipeline_entry_t *write_pipeline_entry = NULL;
+	static char *function                               = "libewf_write_pipeline_push_chunk_data";
+	int entry_index                                     = 0;
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_pipeline->number_of_queued_entries >= write_pipeline->number_of_entries )
+	{
+		return( 0 );
+	}
+	entry_index = ( write_pipeline->first_entry_index + write_pipeline->number_of_queued_entries ) % write_pipeline->number_of_entries;
+
+	write_pipeline_entry = &( write_pipeline->entries[ entry_index ] );
+
+	write_pipeline_entry->chunk_index     = chunk_index;
+	write_pipeline_entry->chunk_data      = *chunk_data;
+	write_pipeline_entry->input_data_size = input_data_size;
+	write_pipeline_entry->status          = LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_QUEUED;
+
+	if( libcthreads_thread_pool_push(
+	     write_pipeline->thread_pool,
+	     (intptr_t *) write_pipeline_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push chunk: %" PRIu64 " onto thread pool queue.",
+		 function,
+		 chunk_index );
+
+		write_pipeline_entry->chunk_data = NULL;
+		write_pipeline_entry->status     = LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_EMPTY;
+
+		return( -1 );
+	}
+	write_pipeline->number_of_queued_entries += 1;
+
+	*chunk_data = NULL;
+
+	return( 1 );
+}
+
+/* Pops the oldest chunk data from the write pipeline
+ * Waits for the chunk data if it is still being packed
+ * The caller takes over management of the chunk data if successful
+ * Returns 1 if successful, 0 if the write pipeline is empty or -1 on error
+ */
+int libewf_write_pipeline_pop_chunk_data(
+     libewf_write_pipeline_t *write_pipeline,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *input_data_size,
+     libcerror_error_t **error )
+{
+	libewf_write_pipeline_entry_t *write_pipeline_entry = NULL;
+	static char *function                               = "libewf_write_pipeline_pop_chunk_data";
+	uint8_t status                                      = 0;
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_pipeline->number_of_queued_entries == 0 )
+	{
+		return( 0 );
+	}
+	write_pipeline_entry = &( write_pipeline->entries[ write_pipeline->first_entry_index ] );
+
+	if( libewf_write_pipeline_wait_for_entry(
+	     write_pipeline,
+	     write_pipeline_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to wait for write pipeline entry.",
+		 function );
+
+		return( -1 );
+	}
+	status = write_pipeline_entry->status;
+
+	*chunk_index     = write_pipeline_entry->chunk_index;
+	*chunk_data      = write_pipeline_entry->chunk_data;
+	*input_data_size = write_pipeline_entry->input_data_size;
+
+	write_pipeline_entry->chunk_data = NULL;
+	write_pipeline_entry->status     = LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_EMPTY;
+
+	write_pipeline->first_entry_index         = ( write_pipeline->first_entry_index + 1 ) % write_pipeline->number_of_entries;
+	write_pipeline->number_of_queued_entries -= 1;
+
+	if( status != LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_PACKED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data.",
+		 function,
+		 *chunk_index );
+
+		libewf_chunk_data_free(
+		 chunk_data,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,143 @@
+/*
+ * Chunk write pipeline functions
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_WRITE_PIPELINE_H )
+#define _LIBEWF_WRITE_PIPELINE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_write_io_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_write_pipeline_entry libewf_write_pipeline_entry_t;
+
+struct libewf_write_pipeline_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The (unpacked) input data size
+	 */
+	size_t input_data_size;
+
+	/* The status
+	 */
+	uint8_t status;
+};
+
+typedef struct libewf_write_pipeline libewf_write_pipeline_t;
+
+struct libewf_write_pipeline
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The write IO handle
+	 */
+	libewf_write_io_handle_t *write_io_handle;
+
+	/* The entries
+	 */
+	libewf_write_pipeline_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The index of the first (oldest) queued entry
+	 */
+	int first_entry_index;
+
+	/* The number of queued entries
+	 */
+	int number_of_queued_entries;
+
+	/* The worker thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The entries mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The entries condition
+	 */
+	libcthreads_condition_t *condition;
+};
+
+int libewf_write_pipeline_initialize(
+     libewf_write_pipeline_t **write_pipeline,
+     libewf_io_handle_t *io_handle,
+     libewf_write_io_handle_t *write_io_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_free(
+     libewf_write_pipeline_t **write_pipeline,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_process_entry_callback(
+     libewf_write_pipeline_entry_t *write_pipeline_entry,
+     libewf_write_pipeline_t *write_pipeline );
+
+int libewf_write_pipeline_wait_for_entry(
+     libewf_write_pipeline_t *write_pipeline,
+     libewf_write_pipeline_entry_t *write_pipeline_entry,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_push_chunk_data(
+     libewf_write_pipeline_t *write_pipeline,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_pop_chunk_data(
+     libewf_write_pipeline_t *write_pipeline,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *input_data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_WRITE_PIPELINE_H ) */
+
@@ -41,6 +41,10 @@
 #define EWF_TEST_CHECKSUM
  */
 
+/* The number of bytes in a block of the SIMD Adler-32 functions
+ */
+#define EWF_TEST_CHECKSUM_ADLER32_BLOCK_SIZE	32
+
 uint8_t ewf_test_checksum_uncompressed_byte_stream[ 7640 ] = {
 	0x09, 0x09, 0x20, 0x20, 0x20, 0x47, 0x4e, 0x55, 0x20, 0x4c, 0x45, 0x53, 0x53, 0x45, 0x52, 0x20,
 	0x47, 0x45, 0x4e, 0x45, 0x52, 0x41, 0x4c, 0x20, 0x50, 0x55, 0x42, 0x4c, 0x49, 0x43, 0x20, 0x4c,
@@ -523,15 +527,53 @@ uint8_t ewf_test_checksum_uncompressed_byte_stream[ 7640 ] = {
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
+/* Tests the libewf_checksum_get_simd_type function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_get_simd_type(
+     void )
+{
+	int simd_type = 0;
+
+	/* Test regular cases
+	 */
+	simd_type = libewf_checksum_get_simd_type();
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "simd_type",
+	 simd_type,
+	 -1 );
+
+	EWF_TEST_ASSERT_LESS_THAN_INT(
+	 "simd_type",
+	 simd_type,
+	 LIBEWF_CHECKSUM_SIMD_TYPE_NEON + 1 );
+
+	/* The detected type should not change between calls
+	 */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "simd_type",
+	 libewf_checksum_get_simd_type(),
+	 simd_type );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
 /* Tests the libewf_checksum_calculate_adler32 function
  * Returns 1 if successful or 0 if not
  */
 int ewf_test_checksum_calculate_adler32(
      void )
 {
-	libcerror_error_t *error = NULL;
-	uint32_t checksum        = 0;
-	int result               = 0;
+	libcerror_error_t *error   = NULL;
+	size_t buffer_offset       = 0;
+	size_t buffer_size         = 0;
+	uint32_t checksum          = 0;
+	uint32_t expected_checksum = 0;
+	int result                 = 0;
 
 	/* Test regular cases
 	 */
@@ -556,6 +598,54 @@ int ewf_test_checksum_calculate_adler32(
 	 "error",
 	 error );
 
+	/* Test sizes and offsets that do not align with the SIMD block size
+	 */
+	for( buffer_offset = 0;
+	     buffer_offset < 3;
+	     buffer_offset++ )
+	{
+		for( buffer_size = 0;
+		     buffer_size < 7600;
+		     buffer_size += 29 )
+		{
+			result = libewf_deflate_calculate_adler32(
+			          &expected_checksum,
+			          &( ewf_test_checksum_uncompressed_byte_stream[ buffer_offset ] ),
+			          buffer_size,
+			          0x0ff10ff1UL,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = libewf_checksum_calculate_adler32(
+			          &checksum,
+			          &( ewf_test_checksum_uncompressed_byte_stream[ buffer_offset ] ),
+			          buffer_size,
+			          0x0ff10ff1UL,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_EQUAL_UINT32(
+			 "checksum",
+			 checksum,
+			 expected_checksum );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
 	/* Test error cases
 	 */
 	result = libewf_checksum_calculate_adler32(
@@ -626,6 +716,94 @@ on_error:
 	return( 0 );
 }
 
+#if defined( HAVE_LIBEWF_CHECKSUM_NEON )
+
+/* Tests the libewf_checksum_calculate_adler32_neon function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_calculate_adler32_neon(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	size_t buffer_offset       = 0;
+	size_t buffer_size         = 0;
+	size_t number_of_blocks    = 0;
+	uint32_t checksum          = 0;
+	uint32_t expected_checksum = 0;
+	int result                 = 0;
+
+	/* Test sizes and offsets that do not align with the NEON block size
+	 * the remaining bytes are added using the scalar Adler-32
+	 */
+	for( buffer_offset = 0;
+	     buffer_offset < 3;
+	     buffer_offset++ )
+	{
+		for( buffer_size = 0;
+		     buffer_size < 7600;
+		     buffer_size += 29 )
+		{
+			result = libewf_deflate_calculate_adler32(
+			          &expected_checksum,
+			          &( ewf_test_checksum_uncompressed_byte_stream[ buffer_offset ] ),
+			          buffer_size,
+			          0x0ff10ff1UL,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			number_of_blocks = buffer_size / EWF_TEST_CHECKSUM_ADLER32_BLOCK_SIZE;
+			checksum         = 0x0ff10ff1UL;
+
+			if( number_of_blocks > 0 )
+			{
+				checksum = libewf_checksum_calculate_adler32_neon(
+				            &( ewf_test_checksum_uncompressed_byte_stream[ buffer_offset ] ),
+				            number_of_blocks,
+				            checksum );
+			}
+			result = libewf_deflate_calculate_adler32(
+			          &checksum,
+			          &( ewf_test_checksum_uncompressed_byte_stream[ buffer_offset + ( number_of_blocks * EWF_TEST_CHECKSUM_ADLER32_BLOCK_SIZE ) ] ),
+			          buffer_size - ( number_of_blocks * EWF_TEST_CHECKSUM_ADLER32_BLOCK_SIZE ),
+			          checksum,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_EQUAL_UINT32(
+			 "checksum",
+			 checksum,
+			 expected_checksum );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_NEON ) */
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -653,10 +831,22 @@ int main(
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
+	EWF_TEST_RUN(
+	 "libewf_checksum_get_simd_type",
+	 ewf_test_checksum_get_simd_type );
+
 	EWF_TEST_RUN(
 	 "libewf_checksum_calculate_adler32",
 	 ewf_test_checksum_calculate_adler32 );
 
+#if defined( HAVE_LIBEWF_CHECKSUM_NEON )
+
+	EWF_TEST_RUN(
+	 "libewf_checksum_calculate_adler32_neon",
+	 ewf_test_checksum_calculate_adler32_neon );
+
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_NEON ) */
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
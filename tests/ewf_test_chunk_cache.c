@@ -0,0 +1,1929 @@
+/*
+ * Library chunk_cache type test program
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_cache.h"
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Inserts test chunk data into a chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_chunk_cache_insert_test_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+
+	if( libewf_chunk_data_initialize(
+	     &chunk_data,
+	     512,
+	     1,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libewf_chunk_cache_insert_chunk_data(
+	     chunk_cache,
+	     chunk_index,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libewf_chunk_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 2;
+	int number_of_memset_fail_tests   = 2;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_initialize(
+	          NULL,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_cache = (libewf_chunk_cache_t *) 0x12345678UL;
+
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4096,
+	          &error );
+
+	chunk_cache = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_cache_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_chunk_cache_initialize(
+		          &chunk_cache,
+		          4096,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( chunk_cache != NULL )
+			{
+				libewf_chunk_cache_free(
+				 &chunk_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_cache",
+			 chunk_cache );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_cache_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_chunk_cache_initialize(
+		          &chunk_cache,
+		          4096,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( chunk_cache != NULL )
+			{
+				libewf_chunk_cache_free(
+				 &chunk_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_cache",
+			 chunk_cache );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_empty function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_empty(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	uint64_t chunk_index              = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( chunk_index = 0;
+	     chunk_index < 4;
+	     chunk_index++ )
+	{
+		result = ewf_test_chunk_cache_insert_test_chunk_data(
+		          chunk_cache,
+		          chunk_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_empty(
+	          chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->recent_queue.number_of_entries",
+	 chunk_cache->recent_queue.number_of_entries,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_cache->recent_queue.data_size",
+	 (uint64_t) chunk_cache->recent_queue.data_size,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache->buckets[ 0 ]",
+	 chunk_cache->buckets[ 0 ] );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_empty(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_get_budget and libewf_chunk_cache_set_budget functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_budget(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	size64_t budget                   = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_get_budget(
+	          chunk_cache,
+	          &budget,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "budget",
+	 (uint64_t) budget,
+	 (uint64_t) 4096 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_insert_test_chunk_data(
+	          chunk_cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_set_budget(
+	          chunk_cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->recent_queue.number_of_entries",
+	 chunk_cache->recent_queue.number_of_entries,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_cache->recent_queue.data_size",
+	 (uint64_t) chunk_cache->recent_queue.data_size,
+	 (uint64_t) 0 );
+
+	result = libewf_chunk_cache_get_budget(
+	          chunk_cache,
+	          &budget,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "budget",
+	 (uint64_t) budget,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_get_budget(
+	          NULL,
+	          &budget,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_budget(
+	          chunk_cache,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_set_budget(
+	          NULL,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_get_entry_by_chunk_index function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_get_entry_by_chunk_index(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_entry_t *entry = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Chunks 5 and 5 + LIBEWF_CHUNK_CACHE_NUMBER_OF_HASH_BUCKETS share the same hash table bucket
+	 */
+	result = ewf_test_chunk_cache_insert_test_chunk_data(
+	          chunk_cache,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_insert_test_chunk_data(
+	          chunk_cache,
+	          5 + LIBEWF_CHUNK_CACHE_NUMBER_OF_HASH_BUCKETS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          5,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "entry",
+	 entry );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "entry->chunk_index",
+	 entry->chunk_index,
+	 (uint64_t) 5 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	entry = NULL;
+
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          5 + LIBEWF_CHUNK_CACHE_NUMBER_OF_HASH_BUCKETS,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "entry",
+	 entry );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "entry->chunk_index",
+	 entry->chunk_index,
+	 (uint64_t) ( 5 + LIBEWF_CHUNK_CACHE_NUMBER_OF_HASH_BUCKETS ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	entry = NULL;
+
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          5 + ( 2 * LIBEWF_CHUNK_CACHE_NUMBER_OF_HASH_BUCKETS ),
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "entry",
+	 entry );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          NULL,
+	          5,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          5,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_remove_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_remove_entry(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_entry_t *entry = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	size_t data_size                  = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Chunk 0 is inserted first hence it is not at the start of the hash table bucket
+	 */
+	result = ewf_test_chunk_cache_insert_test_chunk_data(
+	          chunk_cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_insert_test_chunk_data(
+	          chunk_cache,
+	          LIBEWF_CHUNK_CACHE_NUMBER_OF_HASH_BUCKETS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          0,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "entry",
+	 entry );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_size = entry->data_size;
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_remove_entry(
+	          chunk_cache,
+	          entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->recent_queue.number_of_entries",
+	 chunk_cache->recent_queue.number_of_entries,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_cache->recent_queue.data_size",
+	 (uint64_t) chunk_cache->recent_queue.data_size,
+	 (uint64_t) data_size );
+
+	entry = NULL;
+
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          0,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          LIBEWF_CHUNK_CACHE_NUMBER_OF_HASH_BUCKETS,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "entry",
+	 entry );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_remove_entry(
+	          NULL,
+	          entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_remove_entry(
+	          chunk_cache,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_reclaim function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_reclaim(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_entry_t *entry = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	uint64_t chunk_index              = 0;
+	size_t data_size                  = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( chunk_index = 0;
+	     chunk_index < 4;
+	     chunk_index++ )
+	{
+		result = ewf_test_chunk_cache_insert_test_chunk_data(
+		          chunk_cache,
+		          chunk_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          0,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "entry",
+	 entry );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_size = entry->data_size;
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_reclaim(
+	          chunk_cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->recent_queue.number_of_entries",
+	 chunk_cache->recent_queue.number_of_entries,
+	 4 );
+
+	/* Shrink the budget without reclaiming to test that the least recently used chunks are evicted
+	 */
+	chunk_cache->budget = (size64_t) ( 2 * data_size );
+
+	result = libewf_chunk_cache_reclaim(
+	          chunk_cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->recent_queue.number_of_entries",
+	 chunk_cache->recent_queue.number_of_entries,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_cache->recent_queue.data_size",
+	 (uint64_t) chunk_cache->recent_queue.data_size,
+	 (uint64_t) ( 2 * data_size ) );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->ghost_queue.number_of_entries",
+	 chunk_cache->ghost_queue.number_of_entries,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_cache->ghost_queue.data_size",
+	 (uint64_t) chunk_cache->ghost_queue.data_size,
+	 (uint64_t) 0 );
+
+	/* The evicted chunk is kept as a ghost entry without chunk data
+	 */
+	entry = NULL;
+
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          0,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "entry",
+	 entry );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "entry->queue",
+	 entry->queue,
+	 LIBEWF_CHUNK_CACHE_QUEUE_GHOST );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "entry->chunk_data",
+	 entry->chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	entry = NULL;
+
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          3,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "entry",
+	 entry );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "entry->queue",
+	 entry->queue,
+	 LIBEWF_CHUNK_CACHE_QUEUE_RECENT );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reclaim space for an additional chunk
+	 */
+	result = libewf_chunk_cache_reclaim(
+	          chunk_cache,
+	          (size64_t) data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->recent_queue.number_of_entries",
+	 chunk_cache->recent_queue.number_of_entries,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->ghost_queue.number_of_entries",
+	 chunk_cache->ghost_queue.number_of_entries,
+	 3 );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_reclaim(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_get_chunk_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_get_chunk_data(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	libewf_chunk_data_t *chunk_data   = NULL;
+	uint64_t number_of_hits           = 0;
+	uint64_t number_of_misses         = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          LIBEWF_CHUNK_CACHE_DEFAULT_BUDGET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_insert_test_chunk_data(
+	          chunk_cache,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          5,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data = NULL;
+
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          6,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_number_of_hits(
+	          chunk_cache,
+	          &number_of_hits,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_number_of_misses(
+	          chunk_cache,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_get_chunk_data(
+	          NULL,
+	          5,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          5,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_number_of_hits(
+	          NULL,
+	          &number_of_hits,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_number_of_misses(
+	          chunk_cache,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_insert_chunk_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_insert_chunk_data(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	libewf_chunk_data_t *chunk_data   = NULL;
+	size64_t entry_size               = 0;
+	uint64_t chunk_index              = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	entry_size = sizeof( libewf_chunk_data_t ) + chunk_data->allocated_data_size;
+
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          8 * entry_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_insert_chunk_data(
+	          chunk_cache,
+	          0,
+	          chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The chunk cache now manages the chunk data
+	 */
+	chunk_data = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_cache->recent_queue.data_size",
+	 (uint64_t) chunk_cache->recent_queue.data_size,
+	 (uint64_t) entry_size );
+
+	/* Test if a sequential scan evicts chunk 0 from the recent queue into the ghost queue
+	 */
+	for( chunk_index = 1;
+	     chunk_index < 32;
+	     chunk_index++ )
+	{
+		result = ewf_test_chunk_cache_insert_test_chunk_data(
+		          chunk_cache,
+		          chunk_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->recent_queue.number_of_entries",
+	 chunk_cache->recent_queue.number_of_entries,
+	 8 );
+
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          0,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->ghost_queue.number_of_entries",
+	 chunk_cache->ghost_queue.number_of_entries,
+	 24 );
+
+	/* Test if chunk 0 is promoted to the frequent queue when it is read again
+	 */
+	result = ewf_test_chunk_cache_insert_test_chunk_data(
+	          chunk_cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->frequent_queue.number_of_entries",
+	 chunk_cache->frequent_queue.number_of_entries,
+	 1 );
+
+	/* Test if chunk 0 survives another sequential scan
+	 */
+	for( chunk_index = 100;
+	     chunk_index < 164;
+	     chunk_index++ )
+	{
+		result = ewf_test_chunk_cache_insert_test_chunk_data(
+		          chunk_cache,
+		          chunk_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          0,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->recent_queue.number_of_entries",
+	 chunk_cache->recent_queue.number_of_entries,
+	 7 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->frequent_queue.number_of_entries",
+	 chunk_cache->frequent_queue.number_of_entries,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = ewf_test_chunk_cache_insert_test_chunk_data(
+	          chunk_cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_insert_chunk_data(
+	          NULL,
+	          1,
+	          chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_insert_chunk_data(
+	          chunk_cache,
+	          1,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_initialize",
+	 ewf_test_chunk_cache_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_free",
+	 ewf_test_chunk_cache_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_empty",
+	 ewf_test_chunk_cache_empty );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_get_budget",
+	 ewf_test_chunk_cache_budget );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_get_entry_by_chunk_index",
+	 ewf_test_chunk_cache_get_entry_by_chunk_index );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_remove_entry",
+	 ewf_test_chunk_cache_remove_entry );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_reclaim",
+	 ewf_test_chunk_cache_reclaim );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_get_chunk_data",
+	 ewf_test_chunk_cache_get_chunk_data );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_insert_chunk_data",
+	 ewf_test_chunk_cache_insert_chunk_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -4024,6 +4024,221 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_chunk_data_copy_to_write_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_copy_to_write_buffer(
+     void )
+{
+	uint8_t buffer[ 516 ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	void *memset_result             = NULL;
+	ssize_t copy_count              = 0;
+	uint32_t checksum               = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memset_result = memory_set(
+	                 chunk_data->data,
+	                 'A',
+	                 512 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	chunk_data->data_size = 512;
+	chunk_data->checksum  = 0x12345678UL;
+
+	/* Test regular cases
+	 */
+	chunk_data->chunk_io_flags = 0;
+	chunk_data->range_flags    = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+
+	copy_count = libewf_chunk_data_copy_to_write_buffer(
+	              chunk_data,
+	              buffer,
+	              516,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "copy_count",
+	 copy_count,
+	 (ssize_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          chunk_data->data,
+	          512 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	chunk_data->chunk_io_flags = LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET;
+	chunk_data->range_flags    = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+
+	copy_count = libewf_chunk_data_copy_to_write_buffer(
+	              chunk_data,
+	              buffer,
+	              516,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "copy_count",
+	 copy_count,
+	 (ssize_t) 516 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( buffer[ 512 ] ),
+	 checksum );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 (uint32_t) 0x12345678UL );
+
+	/* Test error cases
+	 */
+	copy_count = libewf_chunk_data_copy_to_write_buffer(
+	              NULL,
+	              buffer,
+	              516,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "copy_count",
+	 copy_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	copy_count = libewf_chunk_data_copy_to_write_buffer(
+	              chunk_data,
+	              NULL,
+	              516,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "copy_count",
+	 copy_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	copy_count = libewf_chunk_data_copy_to_write_buffer(
+	              chunk_data,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "copy_count",
+	 copy_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	copy_count = libewf_chunk_data_copy_to_write_buffer(
+	              chunk_data,
+	              buffer,
+	              512,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "copy_count",
+	 copy_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_chunk_data_get_write_size function
  * Returns 1 if successful or 0 if not
  */
@@ -5005,6 +5220,10 @@ int main(
 	 "libewf_chunk_data_write",
 	 ewf_test_chunk_data_write );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_copy_to_write_buffer",
+	 ewf_test_chunk_data_copy_to_write_buffer );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_get_write_size",
 	 ewf_test_chunk_data_get_write_size );
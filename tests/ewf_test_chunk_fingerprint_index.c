@@ -0,0 +1,984 @@
+/*
+ * Library chunk_fingerprint_index type test program
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_fingerprint_index.h"
+#include "../libewf/libewf_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_chunk_fingerprint_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_fingerprint_index_initialize(
+     void )
+{
+	libcerror_error_t *error                                  = NULL;
+	libewf_chunk_fingerprint_index_t *chunk_fingerprint_index = NULL;
+	int result                                                = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests                           = 5;
+	int number_of_memset_fail_tests                           = 2;
+	int test_number                                           = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_fingerprint_index_initialize(
+	          &chunk_fingerprint_index,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_fingerprint_index",
+	 chunk_fingerprint_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_fingerprint_index_free(
+	          &chunk_fingerprint_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_fingerprint_index",
+	 chunk_fingerprint_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_fingerprint_index_initialize(
+	          NULL,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_fingerprint_index = (libewf_chunk_fingerprint_index_t *) 0x12345678UL;
+
+	result = libewf_chunk_fingerprint_index_initialize(
+	          &chunk_fingerprint_index,
+	          16,
+	          &error );
+
+	chunk_fingerprint_index = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_fingerprint_index_initialize(
+	          &chunk_fingerprint_index,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_fingerprint_index_initialize(
+	          &chunk_fingerprint_index,
+	          15,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_fingerprint_index_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_chunk_fingerprint_index_initialize(
+		          &chunk_fingerprint_index,
+		          16,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( chunk_fingerprint_index != NULL )
+			{
+				libewf_chunk_fingerprint_index_free(
+				 &chunk_fingerprint_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_fingerprint_index",
+			 chunk_fingerprint_index );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_fingerprint_index_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_chunk_fingerprint_index_initialize(
+		          &chunk_fingerprint_index,
+		          16,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( chunk_fingerprint_index != NULL )
+			{
+				libewf_chunk_fingerprint_index_free(
+				 &chunk_fingerprint_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_fingerprint_index",
+			 chunk_fingerprint_index );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_fingerprint_index != NULL )
+	{
+		libewf_chunk_fingerprint_index_free(
+		 &chunk_fingerprint_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_fingerprint_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_fingerprint_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_fingerprint_index_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_fingerprint_index_empty function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_fingerprint_index_empty(
+     void )
+{
+	uint8_t fingerprint[ LIBEWF_CHUNK_FINGERPRINT_SIZE ];
+
+	libcerror_error_t *error                                  = NULL;
+	libewf_chunk_fingerprint_index_t *chunk_fingerprint_index = NULL;
+	off64_t chunk_data_offset                                 = 0;
+	size_t byte_index                                         = 0;
+	uint32_t chunk_data_size                                  = 0;
+	uint32_t range_flags                                      = 0;
+	int result                                                = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_fingerprint_index_initialize(
+	          &chunk_fingerprint_index,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_fingerprint_index",
+	 chunk_fingerprint_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( byte_index = 0;
+	     byte_index < LIBEWF_CHUNK_FINGERPRINT_SIZE;
+	     byte_index++ )
+	{
+		fingerprint[ byte_index ] = 0xa5;
+	}
+	result = libewf_chunk_fingerprint_index_set_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          76,
+	          512,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_fingerprint_index_empty(
+	          chunk_fingerprint_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_fingerprint_index_empty(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_fingerprint_index_free(
+	          &chunk_fingerprint_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_fingerprint_index",
+	 chunk_fingerprint_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_fingerprint_index != NULL )
+	{
+		libewf_chunk_fingerprint_index_free(
+		 &chunk_fingerprint_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_fingerprint_index_get_chunk_by_fingerprint and
+ * libewf_chunk_fingerprint_index_set_chunk_by_fingerprint functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_fingerprint_index_get_set_chunk_by_fingerprint(
+     void )
+{
+	uint8_t colliding_fingerprint[ LIBEWF_CHUNK_FINGERPRINT_SIZE ];
+	uint8_t fingerprint[ LIBEWF_CHUNK_FINGERPRINT_SIZE ];
+
+	libcerror_error_t *error                                  = NULL;
+	libewf_chunk_fingerprint_index_t *chunk_fingerprint_index = NULL;
+	off64_t chunk_data_offset                                 = 0;
+	size_t byte_index                                         = 0;
+	uint32_t chunk_data_size                                  = 0;
+	uint32_t range_flags                                      = 0;
+	int result                                                = 0;
+
+	/* Initialize test
+	 */
+	for( byte_index = 0;
+	     byte_index < LIBEWF_CHUNK_FINGERPRINT_SIZE;
+	     byte_index++ )
+	{
+		fingerprint[ byte_index ]           = (uint8_t) byte_index;
+		colliding_fingerprint[ byte_index ] = (uint8_t) ( byte_index + 0x80 );
+	}
+	/* Both fingerprints map onto the same entry
+	 */
+	colliding_fingerprint[ 0 ] = fingerprint[ 0 ];
+
+	result = libewf_chunk_fingerprint_index_initialize(
+	          &chunk_fingerprint_index,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_fingerprint_index",
+	 chunk_fingerprint_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_fingerprint_index_set_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          76,
+	          512,
+	          LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) 76 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_data_size",
+	 chunk_data_size,
+	 (uint32_t) 512 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) LIBEWF_RANGE_FLAG_IS_COMPRESSED );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          colliding_fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A colliding fingerprint replaces the existing entry
+	 */
+	result = libewf_chunk_fingerprint_index_set_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          colliding_fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          1024,
+	          4096,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          colliding_fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) 1024 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_data_size",
+	 chunk_data_size,
+	 (uint32_t) 4096 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+	          NULL,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          NULL,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE - 1,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          NULL,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          &chunk_data_offset,
+	          NULL,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_fingerprint_index_get_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_fingerprint_index_set_chunk_by_fingerprint(
+	          NULL,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          76,
+	          512,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_fingerprint_index_set_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          NULL,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          76,
+	          512,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_fingerprint_index_set_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE - 1,
+	          76,
+	          512,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_fingerprint_index_set_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          -1,
+	          512,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_fingerprint_index_set_chunk_by_fingerprint(
+	          chunk_fingerprint_index,
+	          fingerprint,
+	          LIBEWF_CHUNK_FINGERPRINT_SIZE,
+	          76,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_fingerprint_index_free(
+	          &chunk_fingerprint_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_fingerprint_index",
+	 chunk_fingerprint_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_fingerprint_index != NULL )
+	{
+		libewf_chunk_fingerprint_index_free(
+		 &chunk_fingerprint_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_fingerprint_index_initialize",
+	 ewf_test_chunk_fingerprint_index_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_fingerprint_index_free",
+	 ewf_test_chunk_fingerprint_index_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_fingerprint_index_empty",
+	 ewf_test_chunk_fingerprint_index_empty );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_fingerprint_index_get_set_chunk_by_fingerprint",
+	 ewf_test_chunk_fingerprint_index_get_set_chunk_by_fingerprint );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
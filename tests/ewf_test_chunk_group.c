@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
 #include <types.h>
 
@@ -35,6 +36,7 @@
 #include "ewf_test_unused.h"
 
 #include "../libewf/libewf_chunk_group.h"
+#include "../libewf/libewf_definitions.h"
 #include "../libewf/libewf_section_descriptor.h"
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
@@ -790,10 +792,786 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_chunk_group_append_chunk function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_group_append_chunk(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_group_t *chunk_group = NULL;
+	libewf_io_handle_t *io_handle     = NULL;
+	size64_t chunk_data_size          = 0;
+	off64_t chunk_data_offset         = 0;
+	uint32_t range_flags              = 0;
+	int chunk_index                   = 0;
+	int file_io_pool_entry            = 0;
+	int number_of_chunks              = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_initialize(
+	          &chunk_group,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_group",
+	 chunk_group );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( chunk_index = 0;
+	     chunk_index < 100;
+	     chunk_index++ )
+	{
+		result = libewf_chunk_group_append_chunk(
+		          chunk_group,
+		          &number_of_chunks,
+		          3,
+		          (off64_t) ( 4096 + ( chunk_index * 512 ) ),
+		          512,
+		          LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "number_of_chunks",
+		 number_of_chunks,
+		 chunk_index );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_chunk_group_get_number_of_chunks(
+	          chunk_group,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_chunks",
+	 number_of_chunks,
+	 100 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_get_chunk_by_index(
+	          chunk_group,
+	          99,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) ( 4096 + ( 99 * 512 ) ) );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_data_size",
+	 (uint64_t) chunk_data_size,
+	 (uint64_t) 512 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) LIBEWF_RANGE_FLAG_IS_COMPRESSED );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_set_chunk_by_index(
+	          chunk_group,
+	          99,
+	          3,
+	          8192,
+	          1024,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_get_chunk_by_index(
+	          chunk_group,
+	          99,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) 8192 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_data_size",
+	 (uint64_t) chunk_data_size,
+	 (uint64_t) 1024 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_group_append_chunk(
+	          NULL,
+	          &number_of_chunks,
+	          3,
+	          0,
+	          512,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_append_chunk(
+	          chunk_group,
+	          &number_of_chunks,
+	          4,
+	          0,
+	          512,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_get_chunk_by_index(
+	          chunk_group,
+	          100,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_get_number_of_chunks(
+	          chunk_group,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_group_free(
+	          &chunk_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_group",
+	 chunk_group );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_group != NULL )
+	{
+		libewf_chunk_group_free(
+		 &chunk_group,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_chunk_group_fill_v1 function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_chunk_group_fill_v1(
+int ewf_test_chunk_group_fill_v1(
+     void )
+{
+	uint8_t table_entries_data[ 16 ];
+
+	libcerror_error_t *error                   = NULL;
+	libewf_chunk_group_t *chunk_group          = NULL;
+	libewf_io_handle_t *io_handle              = NULL;
+	libewf_section_descriptor_t *table_section = NULL;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_initialize(
+	          &chunk_group,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_group",
+	 chunk_group );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_section_descriptor_initialize(
+	          &table_section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "table_section",
+	 table_section );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+/* TODO implement */
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_group_fill_v1(
+	          NULL,
+	          0,
+	          0,
+	          0,
+	          table_section,
+	          0,
+	          0,
+	          table_entries_data,
+	          16,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_fill_v1(
+	          chunk_group,
+	          0,
+	          0,
+	          0,
+	          NULL,
+	          0,
+	          0,
+	          table_entries_data,
+	          16,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_fill_v1(
+	          chunk_group,
+	          0,
+	          0,
+	          0,
+	          table_section,
+	          -1,
+	          0,
+	          table_entries_data,
+	          16,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_fill_v1(
+	          chunk_group,
+	          0,
+	          0,
+	          0,
+	          table_section,
+	          0,
+	          0,
+	          NULL,
+	          16,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_fill_v1(
+	          chunk_group,
+	          0,
+	          0,
+	          0,
+	          table_section,
+	          0,
+	          0,
+	          table_entries_data,
+	          (size_t) SSIZE_MAX + 1,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_section_descriptor_free(
+	          &table_section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "table_section",
+	 table_section );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_free(
+	          &chunk_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_group",
+	 chunk_group );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( table_section != NULL )
+	{
+		libewf_section_descriptor_free(
+		 &table_section,
+		 NULL );
+	}
+	if( chunk_group != NULL )
+	{
+		libewf_chunk_group_free(
+		 &chunk_group,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_group_has_v1_references function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_group_has_v1_references(
+     void )
+{
+	uint8_t table_entries_data[ 12 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 0 ] ),
+	 100 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 4 ] ),
+	 200 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 8 ] ),
+	 0x80000000UL | 300 );
+
+	result = libewf_chunk_group_has_v1_references(
+	          32768,
+	          3,
+	          table_entries_data,
+	          12,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The compressed third entry refers to the chunk data of the first entry
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 8 ] ),
+	 0x80000000UL | 100 );
+
+	result = libewf_chunk_group_has_v1_references(
+	          32768,
+	          3,
+	          table_entries_data,
+	          12,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The third entry is beyond 2 GiB as in EnCase 6.7
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 0 ] ),
+	 0x7fff0000UL );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 4 ] ),
+	 0x7fff8000UL );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 8 ] ),
+	 0x80000000UL );
+
+	result = libewf_chunk_group_has_v1_references(
+	          32768,
+	          3,
+	          table_entries_data,
+	          12,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_group_has_v1_references(
+	          32768,
+	          3,
+	          NULL,
+	          12,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_has_v1_references(
+	          32768,
+	          3,
+	          table_entries_data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_has_v1_references(
+	          32768,
+	          4,
+	          table_entries_data,
+	          12,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_group_fill_v1_with_references function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_group_fill_v1_with_references(
      void )
 {
 	uint8_t table_entries_data[ 16 ];
@@ -802,6 +1580,7 @@ int ewf_test_chunk_group_fill_v1(
 	libewf_chunk_group_t *chunk_group          = NULL;
 	libewf_io_handle_t *io_handle              = NULL;
 	libewf_section_descriptor_t *table_section = NULL;
+	uint32_t table_entry_index                 = 0;
 	int result                                 = 0;
 
 	/* Initialize test
@@ -860,11 +1639,228 @@ int ewf_test_chunk_group_fill_v1(
 
 	/* Test regular cases
 	 */
-/* TODO implement */
+	/* The third entry refers to the chunk data of the first entry
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 0 ] ),
+	 100 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 4 ] ),
+	 200 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 8 ] ),
+	 100 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 12 ] ),
+	 0x80000000UL | 300 );
+
+	table_section->start_offset = 400;
+
+	result = libewf_chunk_group_fill_v1_with_references(
+	          chunk_group,
+	          0,
+	          0,
+	          0,
+	          table_section,
+	          0,
+	          4,
+	          table_entries_data,
+	          16,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_group->number_of_chunks",
+	 chunk_group->number_of_chunks,
+	 4 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_group->chunks_data_offset[ 2 ]",
+	 (int64_t) chunk_group->chunks_data_offset[ 2 ],
+	 (int64_t) 100 );
+
+	for( table_entry_index = 0;
+	     table_entry_index < 4;
+	     table_entry_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "chunk_group->chunks_data_size[ table_entry_index ]",
+		 chunk_group->chunks_data_size[ table_entry_index ],
+		 (uint32_t) 100 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "chunk_group->chunks_range_flags[ table_entry_index ] & LIBEWF_RANGE_FLAG_IS_CORRUPTED",
+		 chunk_group->chunks_range_flags[ table_entry_index ] & LIBEWF_RANGE_FLAG_IS_CORRUPTED,
+		 (uint32_t) 0 );
+	}
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_group->chunks_range_flags[ 3 ] & LIBEWF_RANGE_FLAG_IS_COMPRESSED",
+	 chunk_group->chunks_range_flags[ 3 ] & LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+	 (uint32_t) LIBEWF_RANGE_FLAG_IS_COMPRESSED );
+
+	result = libewf_chunk_group_empty(
+	          chunk_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The second entry refers to chunk data that was not stored by a preceding entry
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 4 ] ),
+	 50 );
+
+	result = libewf_chunk_group_fill_v1_with_references(
+	          chunk_group,
+	          0,
+	          0,
+	          0,
+	          table_section,
+	          0,
+	          4,
+	          table_entries_data,
+	          16,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_group->chunks_range_flags[ 1 ] & LIBEWF_RANGE_FLAG_IS_CORRUPTED",
+	 chunk_group->chunks_range_flags[ 1 ] & LIBEWF_RANGE_FLAG_IS_CORRUPTED,
+	 (uint32_t) LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_group->chunks_data_size[ 2 ]",
+	 chunk_group->chunks_data_size[ 2 ],
+	 (uint32_t) 200 );
+
+	result = libewf_chunk_group_empty(
+	          chunk_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The entries without references beyond 2 GiB use the full 32-bit offset as in EnCase 6.7
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 0 ] ),
+	 0x7fff0000UL );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 4 ] ),
+	 0x7fff8000UL );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 8 ] ),
+	 0x80000000UL );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( table_entries_data[ 12 ] ),
+	 0x80008000UL );
+
+	table_section->start_offset = (off64_t) 0x80010000UL;
+
+	result = libewf_chunk_group_fill_v1_with_references(
+	          chunk_group,
+	          0,
+	          32768,
+	          0,
+	          table_section,
+	          0,
+	          4,
+	          table_entries_data,
+	          16,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_group->number_of_chunks",
+	 chunk_group->number_of_chunks,
+	 4 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_group->chunks_data_offset[ 2 ]",
+	 (int64_t) chunk_group->chunks_data_offset[ 2 ],
+	 (int64_t) 0x80000000UL );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_group->chunks_data_offset[ 3 ]",
+	 (int64_t) chunk_group->chunks_data_offset[ 3 ],
+	 (int64_t) 0x80008000UL );
+
+	for( table_entry_index = 0;
+	     table_entry_index < 4;
+	     table_entry_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "chunk_group->chunks_data_size[ table_entry_index ]",
+		 chunk_group->chunks_data_size[ table_entry_index ],
+		 (uint32_t) 32768 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "chunk_group->chunks_range_flags[ table_entry_index ]",
+		 chunk_group->chunks_range_flags[ table_entry_index ],
+		 (uint32_t) LIBEWF_RANGE_FLAG_HAS_CHECKSUM );
+	}
+	result = libewf_chunk_group_empty(
+	          chunk_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test error cases
 	 */
-	result = libewf_chunk_group_fill_v1(
+	result = libewf_chunk_group_fill_v1_with_references(
 	          NULL,
 	          0,
 	          0,
@@ -889,7 +1885,7 @@ int ewf_test_chunk_group_fill_v1(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_chunk_group_fill_v1(
+	result = libewf_chunk_group_fill_v1_with_references(
 	          chunk_group,
 	          0,
 	          0,
@@ -914,7 +1910,7 @@ int ewf_test_chunk_group_fill_v1(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_chunk_group_fill_v1(
+	result = libewf_chunk_group_fill_v1_with_references(
 	          chunk_group,
 	          0,
 	          0,
@@ -939,7 +1935,7 @@ int ewf_test_chunk_group_fill_v1(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_chunk_group_fill_v1(
+	result = libewf_chunk_group_fill_v1_with_references(
 	          chunk_group,
 	          0,
 	          0,
@@ -964,7 +1960,7 @@ int ewf_test_chunk_group_fill_v1(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_chunk_group_fill_v1(
+	result = libewf_chunk_group_fill_v1_with_references(
 	          chunk_group,
 	          0,
 	          0,
@@ -989,6 +1985,56 @@ int ewf_test_chunk_group_fill_v1(
 	libcerror_error_free(
 	 &error );
 
+	result = libewf_chunk_group_fill_v1_with_references(
+	          chunk_group,
+	          0,
+	          0,
+	          0,
+	          table_section,
+	          0,
+	          0,
+	          table_entries_data,
+	          16,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_fill_v1_with_references(
+	          chunk_group,
+	          0,
+	          0,
+	          0,
+	          table_section,
+	          0,
+	          5,
+	          table_entries_data,
+	          16,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
 	/* Clean up
 	 */
 	result = libewf_section_descriptor_free(
@@ -1639,10 +2685,22 @@ int main(
 	 "libewf_chunk_group_clone",
 	 ewf_test_chunk_group_clone );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_group_append_chunk",
+	 ewf_test_chunk_group_append_chunk );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_group_fill_v1",
 	 ewf_test_chunk_group_fill_v1 );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_group_has_v1_references",
+	 ewf_test_chunk_group_has_v1_references );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_group_fill_v1_with_references",
+	 ewf_test_chunk_group_fill_v1_with_references );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_group_fill_v2",
 	 ewf_test_chunk_group_fill_v2 );
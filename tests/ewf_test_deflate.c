@@ -28,6 +28,11 @@
 #include <stdlib.h>
 #endif
 
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+#include <time.h>
+#include <zlib.h>
+#endif
+
 #include "ewf_test_libcerror.h"
 #include "ewf_test_libcnotify.h"
 #include "ewf_test_libewf.h"
@@ -42,6 +47,19 @@
 #define EWF_TEST_DEFLATE
  */
 
+/* Define to make ewf_test_deflate run the decompression benchmark
+#define EWF_TEST_DEFLATE_BENCHMARK
+ */
+
+/* The chunk size and number of chunks of the data compressed by zlib
+ */
+#define EWF_TEST_DEFLATE_CHUNK_SIZE			( 32 * 1024 )
+#define EWF_TEST_DEFLATE_NUMBER_OF_CHUNKS		64
+
+/* The number of iterations of the decompression benchmark
+ */
+#define EWF_TEST_DEFLATE_BENCHMARK_NUMBER_OF_ITERATIONS	16
+
 uint8_t ewf_test_deflate_compressed_data[ 2627 ] = {
 	0x78, 0xda, 0xbd, 0x59, 0x6d, 0x8f, 0xdb, 0xb8, 0x11, 0xfe, 0x7c, 0xfa, 0x15, 0xc4, 0x7e, 0xb9,
 	0x5d, 0xc0, 0x75, 0x5e, 0x7b, 0x45, 0x0f, 0x45, 0x81, 0xed, 0xde, 0x26, 0xdd, 0x62, 0x2f, 0x0d,
@@ -2681,6 +2699,443 @@ on_error:
 	return( 0 );
 }
 
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+
+/* Fills a buffer with text-like data
+ */
+void ewf_test_deflate_fill_buffer(
+      uint8_t *buffer,
+      size_t buffer_size,
+      uint32_t *seed )
+{
+	const char *words[ 16 ] = {
+		"the ", "evidence ", "file ", "of ", "a ", "segment ", "chunk ", "table ",
+		"section ", "and ", "with ", "media ", "data ", "is ", "stored ", "in " };
+
+	const char *word     = NULL;
+	size_t buffer_offset = 0;
+
+	while( buffer_offset < buffer_size )
+	{
+		*seed = ( *seed * 1103515245UL ) + 12345UL;
+
+		if( ( ( *seed >> 16 ) & 0x1f ) == 0 )
+		{
+			buffer[ buffer_offset++ ] = (uint8_t) ( 'A' + ( ( *seed >> 8 ) % 26 ) );
+
+			continue;
+		}
+		for( word = words[ ( *seed >> 24 ) & 0x0f ];
+		     ( *word != 0 ) && ( buffer_offset < buffer_size );
+		     word++ )
+		{
+			buffer[ buffer_offset++ ] = (uint8_t) *word;
+		}
+	}
+}
+
+/* Compresses the data per chunk using zlib
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_deflate_compress_chunks(
+     const uint8_t *data,
+     uint8_t *compressed_data,
+     size_t *compressed_data_sizes,
+     int compression_level )
+{
+	uLongf compressed_chunk_size  = 0;
+	size_t compressed_data_offset = 0;
+	int chunk_index               = 0;
+
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_DEFLATE_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		compressed_chunk_size = EWF_TEST_DEFLATE_CHUNK_SIZE + 1024;
+
+		if( compress2(
+		     &( compressed_data[ compressed_data_offset ] ),
+		     &compressed_chunk_size,
+		     &( data[ chunk_index * EWF_TEST_DEFLATE_CHUNK_SIZE ] ),
+		     (uLong) EWF_TEST_DEFLATE_CHUNK_SIZE,
+		     compression_level ) != Z_OK )
+		{
+			return( -1 );
+		}
+		compressed_data_sizes[ chunk_index ] = (size_t) compressed_chunk_size;
+		compressed_data_offset              += (size_t) compressed_chunk_size;
+	}
+	return( 1 );
+}
+
+/* Tests the libewf_deflate_decompress_zlib function on 32 KiB chunks compressed by zlib
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_decompress_zlib_compressed_chunks(
+     void )
+{
+	uint8_t *compressed_data      = NULL;
+	uint8_t *data                 = NULL;
+	uint8_t *uncompressed_data    = NULL;
+	libcerror_error_t *error      = NULL;
+	size_t *compressed_data_sizes = NULL;
+	size_t compressed_data_offset = 0;
+	size_t uncompressed_data_size = 0;
+	uint32_t seed                 = 1;
+	int chunk_index               = 0;
+	int compression_level         = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	data = (uint8_t *) memory_allocate(
+	                    EWF_TEST_DEFLATE_CHUNK_SIZE * EWF_TEST_DEFLATE_NUMBER_OF_CHUNKS );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	compressed_data = (uint8_t *) memory_allocate(
+	                               ( EWF_TEST_DEFLATE_CHUNK_SIZE + 1024 ) * EWF_TEST_DEFLATE_NUMBER_OF_CHUNKS );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data",
+	 compressed_data );
+
+	compressed_data_sizes = (size_t *) memory_allocate(
+	                                    sizeof( size_t ) * EWF_TEST_DEFLATE_NUMBER_OF_CHUNKS );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data_sizes",
+	 compressed_data_sizes );
+
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 EWF_TEST_DEFLATE_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "uncompressed_data",
+	 uncompressed_data );
+
+	ewf_test_deflate_fill_buffer(
+	 data,
+	 EWF_TEST_DEFLATE_CHUNK_SIZE * EWF_TEST_DEFLATE_NUMBER_OF_CHUNKS,
+	 &seed );
+
+	/* Test regular cases
+	 */
+	for( compression_level = 1;
+	     compression_level <= 9;
+	     compression_level += 4 )
+	{
+		result = ewf_test_deflate_compress_chunks(
+		          data,
+		          compressed_data,
+		          compressed_data_sizes,
+		          compression_level );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		compressed_data_offset = 0;
+
+		for( chunk_index = 0;
+		     chunk_index < EWF_TEST_DEFLATE_NUMBER_OF_CHUNKS;
+		     chunk_index++ )
+		{
+			uncompressed_data_size = EWF_TEST_DEFLATE_CHUNK_SIZE;
+
+			result = libewf_deflate_decompress_zlib(
+			          &( compressed_data[ compressed_data_offset ] ),
+			          compressed_data_sizes[ chunk_index ],
+			          uncompressed_data,
+			          &uncompressed_data_size,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_EQUAL_SIZE(
+			 "uncompressed_data_size",
+			 uncompressed_data_size,
+			 (size_t) EWF_TEST_DEFLATE_CHUNK_SIZE );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          uncompressed_data,
+			          &( data[ chunk_index * EWF_TEST_DEFLATE_CHUNK_SIZE ] ),
+			          EWF_TEST_DEFLATE_CHUNK_SIZE );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+
+			compressed_data_offset += compressed_data_sizes[ chunk_index ];
+		}
+	}
+	/* Clean up
+	 */
+	memory_free(
+	 uncompressed_data );
+
+	uncompressed_data = NULL;
+
+	memory_free(
+	 compressed_data_sizes );
+
+	compressed_data_sizes = NULL;
+
+	memory_free(
+	 compressed_data );
+
+	compressed_data = NULL;
+
+	memory_free(
+	 data );
+
+	data = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_data_sizes != NULL )
+	{
+		memory_free(
+		 compressed_data_sizes );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( 0 );
+}
+
+#if defined( EWF_TEST_DEFLATE_BENCHMARK )
+
+/* Benchmarks the libewf_deflate_decompress_zlib function against zlib uncompress
+ * on 32 KiB chunks
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_decompress_zlib_benchmark(
+     void )
+{
+	uint8_t *compressed_data      = NULL;
+	uint8_t *data                 = NULL;
+	uint8_t *uncompressed_data    = NULL;
+	libcerror_error_t *error      = NULL;
+	uLongf zlib_uncompressed_size = 0;
+	size_t *compressed_data_sizes = NULL;
+	size_t compressed_data_offset = 0;
+	size_t uncompressed_data_size = 0;
+	clock_t libewf_clock_ticks    = 0;
+	clock_t start_clock           = 0;
+	clock_t zlib_clock_ticks      = 0;
+	double number_of_mebibytes    = 0.0;
+	uint32_t seed                 = 1;
+	int chunk_index               = 0;
+	int compression_level         = 0;
+	int iteration                 = 0;
+	int result                    = 0;
+	int zlib_result               = 0;
+
+	data = (uint8_t *) memory_allocate(
+	                    EWF_TEST_DEFLATE_CHUNK_SIZE * EWF_TEST_DEFLATE_NUMBER_OF_CHUNKS );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	compressed_data = (uint8_t *) memory_allocate(
+	                               ( EWF_TEST_DEFLATE_CHUNK_SIZE + 1024 ) * EWF_TEST_DEFLATE_NUMBER_OF_CHUNKS );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data",
+	 compressed_data );
+
+	compressed_data_sizes = (size_t *) memory_allocate(
+	                                    sizeof( size_t ) * EWF_TEST_DEFLATE_NUMBER_OF_CHUNKS );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data_sizes",
+	 compressed_data_sizes );
+
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 EWF_TEST_DEFLATE_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "uncompressed_data",
+	 uncompressed_data );
+
+	ewf_test_deflate_fill_buffer(
+	 data,
+	 EWF_TEST_DEFLATE_CHUNK_SIZE * EWF_TEST_DEFLATE_NUMBER_OF_CHUNKS,
+	 &seed );
+
+	for( compression_level = 1;
+	     compression_level <= 9;
+	     compression_level += 4 )
+	{
+		result = ewf_test_deflate_compress_chunks(
+		          data,
+		          compressed_data,
+		          compressed_data_sizes,
+		          compression_level );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		start_clock = clock();
+
+		for( iteration = 0;
+		     iteration < EWF_TEST_DEFLATE_BENCHMARK_NUMBER_OF_ITERATIONS;
+		     iteration++ )
+		{
+			compressed_data_offset = 0;
+
+			for( chunk_index = 0;
+			     chunk_index < EWF_TEST_DEFLATE_NUMBER_OF_CHUNKS;
+			     chunk_index++ )
+			{
+				zlib_uncompressed_size = EWF_TEST_DEFLATE_CHUNK_SIZE;
+
+				zlib_result = uncompress(
+				               uncompressed_data,
+				               &zlib_uncompressed_size,
+				               &( compressed_data[ compressed_data_offset ] ),
+				               (uLong) compressed_data_sizes[ chunk_index ] );
+
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "zlib_result",
+				 zlib_result,
+				 Z_OK );
+
+				compressed_data_offset += compressed_data_sizes[ chunk_index ];
+			}
+		}
+		zlib_clock_ticks += clock() - start_clock;
+
+		start_clock = clock();
+
+		for( iteration = 0;
+		     iteration < EWF_TEST_DEFLATE_BENCHMARK_NUMBER_OF_ITERATIONS;
+		     iteration++ )
+		{
+			compressed_data_offset = 0;
+
+			for( chunk_index = 0;
+			     chunk_index < EWF_TEST_DEFLATE_NUMBER_OF_CHUNKS;
+			     chunk_index++ )
+			{
+				uncompressed_data_size = EWF_TEST_DEFLATE_CHUNK_SIZE;
+
+				result = libewf_deflate_decompress_zlib(
+				          &( compressed_data[ compressed_data_offset ] ),
+				          compressed_data_sizes[ chunk_index ],
+				          uncompressed_data,
+				          &uncompressed_data_size,
+				          &error );
+
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				compressed_data_offset += compressed_data_sizes[ chunk_index ];
+			}
+		}
+		libewf_clock_ticks += clock() - start_clock;
+	}
+	number_of_mebibytes = ( 3.0 * EWF_TEST_DEFLATE_BENCHMARK_NUMBER_OF_ITERATIONS * EWF_TEST_DEFLATE_NUMBER_OF_CHUNKS * EWF_TEST_DEFLATE_CHUNK_SIZE ) / ( 1024.0 * 1024.0 );
+
+	if( ( zlib_clock_ticks > 0 )
+	 && ( libewf_clock_ticks > 0 ) )
+	{
+		fprintf(
+		 stdout,
+		 "Decompressing 32 KiB chunks: libewf %.1f MiB/s, zlib %.1f MiB/s\n",
+		 number_of_mebibytes / ( (double) libewf_clock_ticks / CLOCKS_PER_SEC ),
+		 number_of_mebibytes / ( (double) zlib_clock_ticks / CLOCKS_PER_SEC ) );
+	}
+	memory_free(
+	 uncompressed_data );
+
+	uncompressed_data = NULL;
+
+	memory_free(
+	 compressed_data_sizes );
+
+	compressed_data_sizes = NULL;
+
+	memory_free(
+	 compressed_data );
+
+	compressed_data = NULL;
+
+	memory_free(
+	 data );
+
+	data = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_data_sizes != NULL )
+	{
+		memory_free(
+		 compressed_data_sizes );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( EWF_TEST_DEFLATE_BENCHMARK ) */
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -2740,6 +3195,22 @@ int main(
 	 "libewf_deflate_decompress_zlib",
 	 ewf_test_deflate_decompress_zlib );
 
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_decompress_zlib_compressed_chunks",
+	 ewf_test_deflate_decompress_zlib_compressed_chunks );
+
+#if defined( EWF_TEST_DEFLATE_BENCHMARK )
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_decompress_zlib_benchmark",
+	 ewf_test_deflate_decompress_zlib_benchmark );
+
+#endif /* defined( EWF_TEST_DEFLATE_BENCHMARK ) */
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
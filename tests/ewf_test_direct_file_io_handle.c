@@ -0,0 +1,1265 @@
+/*
+ * Library direct_file_io_handle type test program
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libbfio.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_direct_file_io_handle.h"
+
+#define EWF_TEST_DIRECT_FILE_IO_HANDLE_FILENAME		"ewf_test_direct_file_io_handle.raw"
+#define EWF_TEST_DIRECT_FILE_IO_HANDLE_FILE_SIZE	( ( 2 * LIBEWF_DIRECT_FILE_IO_HANDLE_BUFFER_SIZE ) + 12345 )
+#define EWF_TEST_DIRECT_FILE_IO_HANDLE_WRITE_SIZE	5000
+#define EWF_TEST_DIRECT_FILE_IO_HANDLE_READ_SIZE	777
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT )
+
+/* Tests the libewf_direct_file_io_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_direct_file_io_handle_initialize(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	int result                                     = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests                = 1;
+	int number_of_memset_fail_tests                = 1;
+	int test_number                                = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_direct_file_io_handle_initialize(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_handle->descriptor",
+	 file_io_handle->descriptor,
+	 -1 );
+
+	result = libewf_direct_file_io_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_direct_file_io_handle_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	file_io_handle = (libewf_direct_file_io_handle_t *) 0x12345678UL;
+
+	result = libewf_direct_file_io_handle_initialize(
+	          &file_io_handle,
+	          &error );
+
+	file_io_handle = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_direct_file_io_handle_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_direct_file_io_handle_initialize(
+		          &file_io_handle,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( file_io_handle != NULL )
+			{
+				libewf_direct_file_io_handle_free(
+				 &file_io_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "file_io_handle",
+			 file_io_handle );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_direct_file_io_handle_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_direct_file_io_handle_initialize(
+		          &file_io_handle,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( file_io_handle != NULL )
+			{
+				libewf_direct_file_io_handle_free(
+				 &file_io_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "file_io_handle",
+			 file_io_handle );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libewf_direct_file_io_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_direct_file_io_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_direct_file_io_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_direct_file_io_handle_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_direct_file_io_handle_clone function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_direct_file_io_handle_clone(
+     void )
+{
+	libcerror_error_t *error                                   = NULL;
+	libewf_direct_file_io_handle_t *destination_file_io_handle = NULL;
+	libewf_direct_file_io_handle_t *source_file_io_handle      = NULL;
+	int result                                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_direct_file_io_handle_initialize(
+	          &source_file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "source_file_io_handle",
+	 source_file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_direct_file_io_handle_set_name(
+	          source_file_io_handle,
+	          EWF_TEST_DIRECT_FILE_IO_HANDLE_FILENAME,
+	          34,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_direct_file_io_handle_clone(
+	          &destination_file_io_handle,
+	          source_file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "destination_file_io_handle",
+	 destination_file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "destination_file_io_handle->name_size",
+	 destination_file_io_handle->name_size,
+	 (size_t) 35 );
+
+	result = memory_compare(
+	          destination_file_io_handle->name,
+	          EWF_TEST_DIRECT_FILE_IO_HANDLE_FILENAME,
+	          35 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_direct_file_io_handle_free(
+	          &destination_file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "destination_file_io_handle",
+	 destination_file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_direct_file_io_handle_clone(
+	          &destination_file_io_handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "destination_file_io_handle",
+	 destination_file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_direct_file_io_handle_clone(
+	          NULL,
+	          source_file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	destination_file_io_handle = (libewf_direct_file_io_handle_t *) 0x12345678UL;
+
+	result = libewf_direct_file_io_handle_clone(
+	          &destination_file_io_handle,
+	          source_file_io_handle,
+	          &error );
+
+	destination_file_io_handle = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_direct_file_io_handle_free(
+	          &source_file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "source_file_io_handle",
+	 source_file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( destination_file_io_handle != NULL )
+	{
+		libewf_direct_file_io_handle_free(
+		 &destination_file_io_handle,
+		 NULL );
+	}
+	if( source_file_io_handle != NULL )
+	{
+		libewf_direct_file_io_handle_free(
+		 &source_file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_direct_file_io_handle_set_name function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_direct_file_io_handle_set_name(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	int result                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_direct_file_io_handle_initialize(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_direct_file_io_handle_set_name(
+	          file_io_handle,
+	          EWF_TEST_DIRECT_FILE_IO_HANDLE_FILENAME,
+	          34,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "file_io_handle->name_size",
+	 file_io_handle->name_size,
+	 (size_t) 35 );
+
+	/* Test error cases
+	 */
+	result = libewf_direct_file_io_handle_set_name(
+	          NULL,
+	          EWF_TEST_DIRECT_FILE_IO_HANDLE_FILENAME,
+	          34,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_direct_file_io_handle_set_name(
+	          file_io_handle,
+	          NULL,
+	          34,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_direct_file_io_handle_set_name(
+	          file_io_handle,
+	          EWF_TEST_DIRECT_FILE_IO_HANDLE_FILENAME,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_direct_file_io_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libewf_direct_file_io_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_direct_file_get_name_size and libewf_direct_file_get_name functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_direct_file_get_name(
+     void )
+{
+	char name[ 64 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	size_t name_size                 = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_direct_file_initialize(
+	          &file_io_handle,
+	          EWF_TEST_DIRECT_FILE_IO_HANDLE_FILENAME,
+	          34,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_direct_file_get_name_size(
+	          file_io_handle,
+	          &name_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "name_size",
+	 name_size,
+	 (size_t) 35 );
+
+	result = libewf_direct_file_get_name(
+	          file_io_handle,
+	          name,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = narrow_string_compare(
+	          name,
+	          EWF_TEST_DIRECT_FILE_IO_HANDLE_FILENAME,
+	          35 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_direct_file_get_name(
+	          file_io_handle,
+	          NULL,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_direct_file_get_name(
+	          file_io_handle,
+	          name,
+	          34,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_direct_file_io_handle_write and libewf_direct_file_io_handle_read functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_direct_file_io_handle_write_read(
+     void )
+{
+	uint8_t overwrite_data[ 10 ]                   = {
+		'o', 'v', 'e', 'r', 'w', 'r', 'i', 't', 't', 'n' };
+
+	libcerror_error_t *error                       = NULL;
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	uint8_t *expected_data                         = NULL;
+	uint8_t *file_data                             = NULL;
+	void *memcpy_result                            = NULL;
+	size64_t file_size                             = 0;
+	size_t data_offset                             = 0;
+	size_t read_size                               = 0;
+	size_t write_size                              = 0;
+	ssize_t read_count                             = 0;
+	ssize_t write_count                            = 0;
+	off64_t offset                                 = 0;
+	int result                                     = 0;
+
+	/* Initialize test
+	 */
+	expected_data = (uint8_t *) memory_allocate(
+	                             EWF_TEST_DIRECT_FILE_IO_HANDLE_FILE_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "expected_data",
+	 expected_data );
+
+	file_data = (uint8_t *) memory_allocate(
+	                         EWF_TEST_DIRECT_FILE_IO_HANDLE_FILE_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_data",
+	 file_data );
+
+	for( data_offset = 0;
+	     data_offset < EWF_TEST_DIRECT_FILE_IO_HANDLE_FILE_SIZE;
+	     data_offset++ )
+	{
+		expected_data[ data_offset ] = (uint8_t) ( data_offset % 253 );
+	}
+	result = libewf_direct_file_io_handle_initialize(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_direct_file_io_handle_set_name(
+	          file_io_handle,
+	          EWF_TEST_DIRECT_FILE_IO_HANDLE_FILENAME,
+	          34,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_direct_file_io_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_WRITE_TRUNCATE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_direct_file_io_handle_is_open(
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Write the data in pieces that are not aligned
+	 */
+	data_offset = 0;
+
+	while( data_offset < EWF_TEST_DIRECT_FILE_IO_HANDLE_FILE_SIZE )
+	{
+		write_size = EWF_TEST_DIRECT_FILE_IO_HANDLE_FILE_SIZE - data_offset;
+
+		if( write_size > EWF_TEST_DIRECT_FILE_IO_HANDLE_WRITE_SIZE )
+		{
+			write_size = EWF_TEST_DIRECT_FILE_IO_HANDLE_WRITE_SIZE;
+		}
+		write_count = libewf_direct_file_io_handle_write(
+		               file_io_handle,
+		               &( expected_data[ data_offset ] ),
+		               write_size,
+		               &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "write_count",
+		 write_count,
+		 (ssize_t) write_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		data_offset += write_size;
+	}
+	/* Overwrite data in a block that was already written to the file
+	 */
+	offset = libewf_direct_file_io_handle_seek_offset(
+	          file_io_handle,
+	          100,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 100 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	write_count = libewf_direct_file_io_handle_write(
+	               file_io_handle,
+	               overwrite_data,
+	               10,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 10 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memcpy_result = memory_copy(
+	                 &( expected_data[ 100 ] ),
+	                 overwrite_data,
+	                 10 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memcpy_result",
+	 memcpy_result );
+
+	result = libewf_direct_file_io_handle_close(
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Read the data back in pieces that are not aligned
+	 */
+	result = libewf_direct_file_io_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_direct_file_io_handle_get_size(
+	          file_io_handle,
+	          &file_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 (uint64_t) file_size,
+	 (uint64_t) EWF_TEST_DIRECT_FILE_IO_HANDLE_FILE_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_offset = 0;
+
+	while( data_offset < EWF_TEST_DIRECT_FILE_IO_HANDLE_FILE_SIZE )
+	{
+		read_size = EWF_TEST_DIRECT_FILE_IO_HANDLE_FILE_SIZE - data_offset;
+
+		if( read_size > EWF_TEST_DIRECT_FILE_IO_HANDLE_READ_SIZE )
+		{
+			read_size = EWF_TEST_DIRECT_FILE_IO_HANDLE_READ_SIZE;
+		}
+		read_count = libewf_direct_file_io_handle_read(
+		              file_io_handle,
+		              &( file_data[ data_offset ] ),
+		              read_size,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		data_offset += read_size;
+	}
+	result = memory_compare(
+	          file_data,
+	          expected_data,
+	          EWF_TEST_DIRECT_FILE_IO_HANDLE_FILE_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test reading at the end of the file
+	 */
+	read_count = libewf_direct_file_io_handle_read(
+	              file_io_handle,
+	              file_data,
+	              EWF_TEST_DIRECT_FILE_IO_HANDLE_READ_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	write_count = libewf_direct_file_io_handle_write(
+	               file_io_handle,
+	               overwrite_data,
+	               10,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_direct_file_io_handle_read(
+	              NULL,
+	              file_data,
+	              EWF_TEST_DIRECT_FILE_IO_HANDLE_READ_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_direct_file_io_handle_read(
+	              file_io_handle,
+	              NULL,
+	              EWF_TEST_DIRECT_FILE_IO_HANDLE_READ_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_direct_file_io_handle_seek_offset(
+	          file_io_handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_direct_file_io_handle_close(
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_direct_file_io_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	remove(
+	 EWF_TEST_DIRECT_FILE_IO_HANDLE_FILENAME );
+
+	memory_free(
+	 file_data );
+
+	file_data = NULL;
+
+	memory_free(
+	 expected_data );
+
+	expected_data = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libewf_direct_file_io_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	remove(
+	 EWF_TEST_DIRECT_FILE_IO_HANDLE_FILENAME );
+
+	if( file_data != NULL )
+	{
+		memory_free(
+		 file_data );
+	}
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_direct_file_io_handle_initialize",
+	 ewf_test_direct_file_io_handle_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_direct_file_io_handle_free",
+	 ewf_test_direct_file_io_handle_free );
+
+	EWF_TEST_RUN(
+	 "libewf_direct_file_io_handle_clone",
+	 ewf_test_direct_file_io_handle_clone );
+
+	EWF_TEST_RUN(
+	 "libewf_direct_file_io_handle_set_name",
+	 ewf_test_direct_file_io_handle_set_name );
+
+	EWF_TEST_RUN(
+	 "libewf_direct_file_get_name",
+	 ewf_test_direct_file_get_name );
+
+	/* TODO: add tests for libewf_direct_file_initialize */
+
+	EWF_TEST_RUN(
+	 "libewf_direct_file_io_handle_write_read",
+	 ewf_test_direct_file_io_handle_write_read );
+
+	/* libewf_direct_file_io_handle_open, libewf_direct_file_io_handle_close, libewf_direct_file_io_handle_seek_offset
+	 * libewf_direct_file_io_handle_is_open and libewf_direct_file_io_handle_get_size are tested by
+	 * ewf_test_direct_file_io_handle_write_read
+	 */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_DIRECT_FILE_IO_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,369 @@
+/*
+ * Library file_allocation functions test program
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_file_allocation.h"
+
+#define EWF_TEST_FILE_ALLOCATION_FILENAME	"ewf_test_file_allocation.raw"
+#define EWF_TEST_FILE_ALLOCATION_FILE_SIZE	4096
+#define EWF_TEST_FILE_ALLOCATION_SIZE		( 1024 * 1024 )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Creates the test file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_file_allocation_create_file(
+     void )
+{
+	uint8_t data[ EWF_TEST_FILE_ALLOCATION_FILE_SIZE ];
+
+	FILE *file_stream   = NULL;
+	size_t data_offset  = 0;
+	size_t write_count  = 0;
+
+	for( data_offset = 0;
+	     data_offset < EWF_TEST_FILE_ALLOCATION_FILE_SIZE;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( data_offset % 251 );
+	}
+	file_stream = file_stream_open(
+	               EWF_TEST_FILE_ALLOCATION_FILENAME,
+	               "wb" );
+
+	if( file_stream == NULL )
+	{
+		return( -1 );
+	}
+	write_count = file_stream_write(
+	               file_stream,
+	               data,
+	               EWF_TEST_FILE_ALLOCATION_FILE_SIZE );
+
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		return( -1 );
+	}
+	if( write_count != EWF_TEST_FILE_ALLOCATION_FILE_SIZE )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines the size of the test file
+ * Returns the size if successful or -1 on error
+ */
+off_t ewf_test_file_allocation_get_file_size(
+       void )
+{
+	FILE *file_stream = NULL;
+	off_t file_size   = 0;
+
+	file_stream = file_stream_open(
+	               EWF_TEST_FILE_ALLOCATION_FILENAME,
+	               "rb" );
+
+	if( file_stream == NULL )
+	{
+		return( -1 );
+	}
+	if( fseek(
+	     file_stream,
+	     0,
+	     SEEK_END ) != 0 )
+	{
+		file_stream_close(
+		 file_stream );
+
+		return( -1 );
+	}
+	file_size = (off_t) ftell(
+	                     file_stream );
+
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		return( -1 );
+	}
+	return( file_size );
+}
+
+/* Tests the libewf_file_allocation_preallocate function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_file_allocation_preallocate(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	off_t file_size          = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_file_allocation_create_file();
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libewf_file_allocation_preallocate(
+	          EWF_TEST_FILE_ALLOCATION_FILENAME,
+	          EWF_TEST_FILE_ALLOCATION_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Preallocation should not change the file size
+	 */
+	file_size = ewf_test_file_allocation_get_file_size();
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "file_size",
+	 (int64_t) file_size,
+	 (int64_t) EWF_TEST_FILE_ALLOCATION_FILE_SIZE );
+
+	result = libewf_file_allocation_preallocate(
+	          EWF_TEST_FILE_ALLOCATION_FILENAME,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_file_allocation_preallocate(
+	          NULL,
+	          EWF_TEST_FILE_ALLOCATION_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_file_allocation_preallocate(
+	          EWF_TEST_FILE_ALLOCATION_FILENAME,
+	          (size64_t) INT64_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	remove(
+	 EWF_TEST_FILE_ALLOCATION_FILENAME );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	remove(
+	 EWF_TEST_FILE_ALLOCATION_FILENAME );
+
+	return( 0 );
+}
+
+/* Tests the libewf_file_allocation_release_unused function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_file_allocation_release_unused(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	off_t file_size          = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_file_allocation_create_file();
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_file_allocation_preallocate(
+	          EWF_TEST_FILE_ALLOCATION_FILENAME,
+	          EWF_TEST_FILE_ALLOCATION_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_file_allocation_release_unused(
+	          EWF_TEST_FILE_ALLOCATION_FILENAME,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Releasing the unused space should not change the file size
+	 */
+	file_size = ewf_test_file_allocation_get_file_size();
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "file_size",
+	 (int64_t) file_size,
+	 (int64_t) EWF_TEST_FILE_ALLOCATION_FILE_SIZE );
+
+	/* Test error cases
+	 */
+	result = libewf_file_allocation_release_unused(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	remove(
+	 EWF_TEST_FILE_ALLOCATION_FILENAME );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	remove(
+	 EWF_TEST_FILE_ALLOCATION_FILENAME );
+
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+	EWF_TEST_RUN(
+	 "libewf_file_allocation_preallocate",
+	 ewf_test_file_allocation_preallocate );
+
+	EWF_TEST_RUN(
+	 "libewf_file_allocation_release_unused",
+	 ewf_test_file_allocation_release_unused );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+}
+
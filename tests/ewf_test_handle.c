@@ -59,6 +59,14 @@
 
 #define EWF_TEST_HANDLE_READ_BUFFER_SIZE	4096
 
+#define EWF_TEST_HANDLE_WRITE_FILENAME			"ewf_test_handle_write"
+#define EWF_TEST_HANDLE_WRITE_SEGMENT_FILENAME		"ewf_test_handle_write.e01"
+#define EWF_TEST_HANDLE_WRITE_BUFFER_SIZE		4096
+#define EWF_TEST_HANDLE_WRITE_CHUNK_SIZE		( 64 * 512 )
+#define EWF_TEST_HANDLE_WRITE_NUMBER_OF_CHUNKS		64
+#define EWF_TEST_HANDLE_WRITE_NUMBER_OF_PATTERNS	4
+#define EWF_TEST_HANDLE_WRITE_MEDIA_SIZE		( EWF_TEST_HANDLE_WRITE_NUMBER_OF_CHUNKS * EWF_TEST_HANDLE_WRITE_CHUNK_SIZE )
+
 #if !defined( LIBEWF_HAVE_BFIO )
 
 LIBEWF_EXTERN \
@@ -2331,9 +2339,9 @@ int ewf_test_handle_read_buffer_at_offset(
 
 #if defined( HAVE_EWF_TEST_RWLOCK )
 
-	/* Test libewf_handle_read_buffer_at_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
+	/* Test libewf_handle_read_buffer_at_offset with pthread_rwlock_rdlock failing in libcthreads_read_write_lock_grab_for_read
 	 */
-	ewf_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
+	ewf_test_pthread_rwlock_rdlock_attempts_before_fail = 0;
 
 	read_count = libewf_handle_read_buffer_at_offset(
 	              handle,
@@ -2342,9 +2350,9 @@ int ewf_test_handle_read_buffer_at_offset(
 	              0,
 	              &error );
 
-	if( ewf_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
+	if( ewf_test_pthread_rwlock_rdlock_attempts_before_fail != -1 )
 	{
-		ewf_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
+		ewf_test_pthread_rwlock_rdlock_attempts_before_fail = -1;
 	}
 	else
 	{
@@ -2360,7 +2368,7 @@ int ewf_test_handle_read_buffer_at_offset(
 		libcerror_error_free(
 		 &error );
 	}
-	/* Test libewf_handle_read_buffer_at_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
+	/* Test libewf_handle_read_buffer_at_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_read
 	 */
 	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
 
@@ -2402,21 +2410,29 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_data_chunk function
+/* Tests the libewf_handle_clone_reader function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_data_chunk(
+int ewf_test_handle_clone_reader(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error        = NULL;
-	libewf_data_chunk_t *data_chunk = NULL;
-	int result                      = 0;
+	uint8_t buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t reader_buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+
+	libcerror_error_t *error          = NULL;
+	libewf_handle_t *reader_handle    = NULL;
+	libewf_handle_t *reader_of_reader = NULL;
+	ssize_t read_count                = 0;
+	ssize_t reader_read_count         = 0;
+	off64_t offset                    = 0;
+	off64_t reader_offset             = 0;
+	int result                        = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_data_chunk(
+	result = libewf_handle_clone_reader(
+	          &reader_handle,
 	          handle,
-	          &data_chunk,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2424,16 +2440,74 @@ int ewf_test_handle_get_data_chunk(
 	 result,
 	 1 );
 
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "reader_handle",
+	 reader_handle );
+
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "data_chunk",
-	 data_chunk );
+	result = libewf_handle_get_offset(
+	          handle,
+	          &offset,
+	          &error );
 
-	result = libewf_data_chunk_free(
-	          &data_chunk,
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The reader handle has its own current offset
+	 */
+	reader_read_count = libewf_handle_read_buffer(
+	                     reader_handle,
+	                     reader_buffer,
+	                     EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	                     &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "reader_read_count",
+	 reader_read_count,
+	 read_count );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          reader_buffer,
+	          (size_t) read_count );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_handle_get_offset(
+	          reader_handle,
+	          &reader_offset,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2441,25 +2515,61 @@ int ewf_test_handle_get_data_chunk(
 	 result,
 	 1 );
 
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "reader_offset",
+	 reader_offset,
+	 (int64_t) reader_read_count );
+
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
+	reader_offset = libewf_handle_seek_offset(
+	                 handle,
+	                 offset,
+	                 SEEK_SET,
+	                 &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "reader_offset",
+	 (int64_t) reader_offset,
+	 (int64_t) offset );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A reader handle can be created from a reader handle
 	 */
-	result = libewf_handle_get_data_chunk(
-	          NULL,
-	          &data_chunk,
+	result = libewf_handle_clone_reader(
+	          &reader_of_reader,
+	          reader_handle,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "reader_of_reader",
+	 reader_of_reader );
 
 	EWF_TEST_ASSERT_IS_NULL(
-	 "data_chunk",
-	 data_chunk );
+	 "error",
+	 error );
+
+	/* The shared image state cannot be changed by a reader handle
+	 */
+	result = libewf_handle_set_maximum_number_of_open_handles(
+	          reader_handle,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2468,9 +2578,9 @@ int ewf_test_handle_get_data_chunk(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_data_chunk(
-	          handle,
-	          NULL,
+	result = libewf_handle_set_cache_budget(
+	          reader_handle,
+	          1024 * 1024,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2478,10 +2588,6 @@ int ewf_test_handle_get_data_chunk(
 	 result,
 	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "data_chunk",
-	 data_chunk );
-
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -2489,109 +2595,99 @@ int ewf_test_handle_get_data_chunk(
 	libcerror_error_free(
 	 &error );
 
-	return( 1 );
+	result = libewf_handle_set_read_zero_chunk_on_error(
+	          reader_handle,
+	          1,
+	          &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( data_chunk != NULL )
-	{
-		libewf_data_chunk_free(
-		 &data_chunk,
-		 NULL );
-	}
-	return( 0 );
-}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-/* Tests the libewf_handle_seek_offset function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_seek_offset(
-     libewf_handle_t *handle )
-{
-	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	off64_t offset           = 0;
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-	/* Test regular cases
-	 */
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_END,
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_header_codepage(
+	          reader_handle,
+	          LIBEWF_CODEPAGE_ASCII,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	size = (size64_t) offset;
+	libcerror_error_free(
+	 &error );
 
-	offset = libewf_handle_seek_offset(
+	/* The handle cannot be closed while it shares its image state
+	 */
+	result = libewf_handle_close(
 	          handle,
-	          1024,
-	          SEEK_SET,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 1024 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          -512,
-	          SEEK_CUR,
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_free(
+	          &reader_handle,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 512 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "reader_handle",
+	 reader_handle );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          (off64_t) ( size + 512 ),
-	          SEEK_SET,
-	          &error );
+	reader_read_count = libewf_handle_read_buffer_at_offset(
+	                     reader_of_reader,
+	                     reader_buffer,
+	                     EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	                     0,
+	                     &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) ( size + 512 ) );
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "reader_read_count",
+	 reader_read_count,
+	 read_count );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Reset offset to 0
-	 */
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_SET,
+	result = libewf_handle_free(
+	          &reader_of_reader,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -2599,16 +2695,15 @@ int ewf_test_handle_seek_offset(
 
 	/* Test error cases
 	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_clone_reader(
 	          NULL,
-	          0,
-	          SEEK_SET,
+	          handle,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2617,16 +2712,19 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libewf_handle_seek_offset(
+	reader_handle = (libewf_handle_t *) 0x12345678UL;
+
+	result = libewf_handle_clone_reader(
+	          &reader_handle,
 	          handle,
-	          -1,
-	          SEEK_SET,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	reader_handle = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2635,31 +2733,500 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          -1,
-	          SEEK_CUR,
+	result = libewf_handle_clone_reader(
+	          &reader_handle,
+	          NULL,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "reader_handle",
+	 reader_handle );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          (off64_t) ( -1 * ( size + 1 ) ),
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( reader_of_reader != NULL )
+	{
+		libewf_handle_free(
+		 &reader_of_reader,
+		 NULL );
+	}
+	if( reader_handle != NULL )
+	{
+		libewf_handle_free(
+		 &reader_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_data_chunk function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_data_chunk(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_data_chunk_t *data_chunk = NULL;
+	int result                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_data_chunk(
+	          handle,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	result = libewf_data_chunk_free(
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_data_chunk(
+	          NULL,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_data_chunk(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_seek_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_seek_offset(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	off64_t offset           = 0;
+
+	/* Test regular cases
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -512,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( size + 512 ),
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) ( size + 512 ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libewf_handle_seek_offset(
+	          NULL,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( -1 * ( size + 1 ) ),
 	          SEEK_END,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_RWLOCK )
+
+	/* Test libewf_handle_seek_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
+	 */
+	ewf_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	if( ewf_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test libewf_handle_seek_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
+	 */
+	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	if( ewf_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_unlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_offset(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_offset(
+	          handle,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_offset(
+	          NULL,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_offset(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_segment_filename_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_segment_filename_size(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error         = NULL;
+	size_t segment_filename_size     = 0;
+	int result                       = 0;
+	int segment_filename_size_is_set = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_segment_filename_size(
+	          handle,
+	          &segment_filename_size,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	segment_filename_size_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_segment_filename_size(
+	          NULL,
+	          &segment_filename_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2668,28 +3235,97 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-#if defined( HAVE_EWF_TEST_RWLOCK )
+	if( segment_filename_size_is_set != 0 )
+	{
+		result = libewf_handle_get_segment_filename_size(
+		          handle,
+		          NULL,
+		          &error );
 
-	/* Test libewf_handle_seek_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
-	 */
-	ewf_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_SET,
-	          &error );
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
 
-	if( ewf_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
 	{
-		ewf_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
+		libcerror_error_free(
+		 &error );
 	}
-	else
+	return( 0 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Tests the libewf_handle_get_segment_filename_size_wide function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_segment_filename_size_wide(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error              = NULL;
+	size_t segment_filename_size_wide     = 0;
+	int result                            = 0;
+	int segment_filename_size_wide_is_set = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_segment_filename_size_wide(
+	          handle,
+	          &segment_filename_size_wide,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	segment_filename_size_wide_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_segment_filename_size_wide(
+	          NULL,
+	          &segment_filename_size_wide,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( segment_filename_size_wide_is_set != 0 )
 	{
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 (int64_t) offset,
-		 (int64_t) -1 );
+		result = libewf_handle_get_segment_filename_size_wide(
+		          handle,
+		          NULL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
 
 		EWF_TEST_ASSERT_IS_NOT_NULL(
 		 "error",
@@ -2698,26 +3334,151 @@ int ewf_test_handle_seek_offset(
 		libcerror_error_free(
 		 &error );
 	}
-	/* Test libewf_handle_seek_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Tests the libewf_handle_get_maximum_segment_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_maximum_segment_size(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error      = NULL;
+	size64_t maximum_segment_size = 0;
+	int result                    = 0;
+
+	/* Test regular cases
 	 */
-	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
+	result = libewf_handle_get_maximum_segment_size(
+	          handle,
+	          &maximum_segment_size,
+	          &error );
 
-	offset = libewf_handle_seek_offset(
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_maximum_segment_size(
+	          NULL,
+	          &maximum_segment_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_maximum_segment_size(
 	          handle,
-	          0,
-	          SEEK_SET,
+	          NULL,
 	          &error );
 
-	if( ewf_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
 	{
-		ewf_test_pthread_rwlock_unlock_attempts_before_fail = -1;
+		libcerror_error_free(
+		 &error );
 	}
-	else
-	{
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 (int64_t) offset,
-		 (int64_t) -1 );
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_filename_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_filename_size(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size_t filename_size     = 0;
+	int filename_size_is_set = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_filename_size(
+	          handle,
+	          &filename_size,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	filename_size_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_filename_size(
+	          NULL,
+	          &filename_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( filename_size_is_set != 0 )
+	{
+		result = libewf_handle_get_filename_size(
+		          handle,
+		          NULL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
 
 		EWF_TEST_ASSERT_IS_NOT_NULL(
 		 "error",
@@ -2726,8 +3487,6 @@ int ewf_test_handle_seek_offset(
 		libcerror_error_free(
 		 &error );
 	}
-#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
-
 	return( 1 );
 
 on_error:
@@ -2739,37 +3498,42 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_offset function
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Tests the libewf_handle_get_filename_size_wide function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_offset(
+int ewf_test_handle_get_filename_size_wide(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	off64_t offset           = 0;
-	int result               = 0;
+	libcerror_error_t *error      = NULL;
+	size_t filename_size_wide     = 0;
+	int filename_size_wide_is_set = 0;
+	int result                    = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_offset(
+	result = libewf_handle_get_filename_size_wide(
 	          handle,
-	          &offset,
+	          &filename_size_wide,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT(
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
+	filename_size_wide_is_set = result;
+
 	/* Test error cases
 	 */
-	result = libewf_handle_get_offset(
+	result = libewf_handle_get_filename_size_wide(
 	          NULL,
-	          &offset,
+	          &filename_size_wide,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2784,23 +3548,25 @@ int ewf_test_handle_get_offset(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_offset(
-	          handle,
-	          NULL,
-	          &error );
-
-	EWF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	if( filename_size_wide_is_set != 0 )
+	{
+		result = libewf_handle_get_filename_size_wide(
+		          handle,
+		          NULL,
+		          &error );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
 
-	libcerror_error_free(
-	 &error );
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
 
+		libcerror_error_free(
+		 &error );
+	}
 	return( 1 );
 
 on_error:
@@ -2812,22 +3578,24 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_segment_filename_size function
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Tests the libewf_handle_get_file_io_handle function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_segment_filename_size(
+int ewf_test_handle_get_file_io_handle(
      libewf_handle_t *handle )
 {
+	libbfio_handle_t *file_io_handle = NULL;
 	libcerror_error_t *error         = NULL;
-	size_t segment_filename_size     = 0;
+	int file_io_handle_is_set        = 0;
 	int result                       = 0;
-	int segment_filename_size_is_set = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_segment_filename_size(
+	result = libewf_handle_get_file_io_handle(
 	          handle,
-	          &segment_filename_size,
+	          &file_io_handle,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2839,13 +3607,13 @@ int ewf_test_handle_get_segment_filename_size(
 	 "error",
 	 error );
 
-	segment_filename_size_is_set = result;
+	file_io_handle_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_segment_filename_size(
+	result = libewf_handle_get_file_io_handle(
 	          NULL,
-	          &segment_filename_size,
+	          &file_io_handle,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2860,9 +3628,9 @@ int ewf_test_handle_get_segment_filename_size(
 	libcerror_error_free(
 	 &error );
 
-	if( segment_filename_size_is_set != 0 )
+	if( file_io_handle_is_set != 0 )
 	{
-		result = libewf_handle_get_segment_filename_size(
+		result = libewf_handle_get_file_io_handle(
 		          handle,
 		          NULL,
 		          &error );
@@ -2890,24 +3658,24 @@ on_error:
 	return( 0 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Tests the libewf_handle_get_segment_filename_size_wide function
+/* Tests the libewf_handle_get_root_file_entry function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_segment_filename_size_wide(
+int ewf_test_handle_get_root_file_entry(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error              = NULL;
-	size_t segment_filename_size_wide     = 0;
-	int result                            = 0;
-	int segment_filename_size_wide_is_set = 0;
+	libcerror_error_t *error             = NULL;
+	libewf_file_entry_t *root_file_entry = NULL;
+	int result                           = 0;
+	int root_file_entry_is_set           = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_segment_filename_size_wide(
+#ifdef TODO
+/* TODO fix test */
+	result = libewf_handle_get_root_file_entry(
 	          handle,
-	          &segment_filename_size_wide,
+	          &root_file_entry,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2919,13 +3687,33 @@ int ewf_test_handle_get_segment_filename_size_wide(
 	 "error",
 	 error );
 
-	segment_filename_size_wide_is_set = result;
+	root_file_entry_is_set = result;
+
+	if( root_file_entry_is_set != 0 )
+	{
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "root_file_entry",
+		 root_file_entry );
+
+		result = libewf_file_entry_free(
+		          &root_file_entry,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+#endif
 	/* Test error cases
 	 */
-	result = libewf_handle_get_segment_filename_size_wide(
+	result = libewf_handle_get_root_file_entry(
 	          NULL,
-	          &segment_filename_size_wide,
+	          &root_file_entry,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2933,6 +3721,10 @@ int ewf_test_handle_get_segment_filename_size_wide(
 	 result,
 	 -1 );
 
+	EWF_TEST_ASSERT_IS_NULL(
+	 "root_file_entry",
+	 root_file_entry );
+
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -2940,9 +3732,9 @@ int ewf_test_handle_get_segment_filename_size_wide(
 	libcerror_error_free(
 	 &error );
 
-	if( segment_filename_size_wide_is_set != 0 )
+	if( root_file_entry_is_set != 0 )
 	{
-		result = libewf_handle_get_segment_filename_size_wide(
+		result = libewf_handle_get_root_file_entry(
 		          handle,
 		          NULL,
 		          &error );
@@ -2952,6 +3744,10 @@ int ewf_test_handle_get_segment_filename_size_wide(
 		 result,
 		 -1 );
 
+		EWF_TEST_ASSERT_IS_NULL(
+		 "root_file_entry",
+		 root_file_entry );
+
 		EWF_TEST_ASSERT_IS_NOT_NULL(
 		 "error",
 		 error );
@@ -2967,26 +3763,30 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( root_file_entry != NULL )
+	{
+		libewf_file_entry_free(
+		 &root_file_entry,
+		 NULL );
+	}
 	return( 0 );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
-
-/* Tests the libewf_handle_get_maximum_segment_size function
+/* Tests the libewf_handle_get_sectors_per_chunk function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_maximum_segment_size(
+int ewf_test_handle_get_sectors_per_chunk(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error      = NULL;
-	size64_t maximum_segment_size = 0;
-	int result                    = 0;
+	libcerror_error_t *error   = NULL;
+	uint32_t sectors_per_chunk = 0;
+	int result                 = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_maximum_segment_size(
+	result = libewf_handle_get_sectors_per_chunk(
 	          handle,
-	          &maximum_segment_size,
+	          &sectors_per_chunk,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3000,9 +3800,9 @@ int ewf_test_handle_get_maximum_segment_size(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_maximum_segment_size(
+	result = libewf_handle_get_sectors_per_chunk(
 	          NULL,
-	          &maximum_segment_size,
+	          &sectors_per_chunk,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3017,7 +3817,7 @@ int ewf_test_handle_get_maximum_segment_size(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_maximum_segment_size(
+	result = libewf_handle_get_sectors_per_chunk(
 	          handle,
 	          NULL,
 	          &error );
@@ -3045,40 +3845,37 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_filename_size function
+/* Tests the libewf_handle_get_bytes_per_sector function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_filename_size(
+int ewf_test_handle_get_bytes_per_sector(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	size_t filename_size     = 0;
-	int filename_size_is_set = 0;
-	int result               = 0;
+	libcerror_error_t *error  = NULL;
+	uint32_t bytes_per_sector = 0;
+	int result                = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_filename_size(
+	result = libewf_handle_get_bytes_per_sector(
 	          handle,
-	          &filename_size,
+	          &bytes_per_sector,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	filename_size_is_set = result;
-
 	/* Test error cases
 	 */
-	result = libewf_handle_get_filename_size(
+	result = libewf_handle_get_bytes_per_sector(
 	          NULL,
-	          &filename_size,
+	          &bytes_per_sector,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3093,25 +3890,23 @@ int ewf_test_handle_get_filename_size(
 	libcerror_error_free(
 	 &error );
 
-	if( filename_size_is_set != 0 )
-	{
-		result = libewf_handle_get_filename_size(
-		          handle,
-		          NULL,
-		          &error );
+	result = libewf_handle_get_bytes_per_sector(
+	          handle,
+	          NULL,
+	          &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -3123,42 +3918,37 @@ on_error:
 	return( 0 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Tests the libewf_handle_get_filename_size_wide function
+/* Tests the libewf_handle_get_number_of_sectors function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_filename_size_wide(
+int ewf_test_handle_get_number_of_sectors(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error      = NULL;
-	size_t filename_size_wide     = 0;
-	int filename_size_wide_is_set = 0;
-	int result                    = 0;
+	libcerror_error_t *error   = NULL;
+	uint64_t number_of_sectors = 0;
+	int result                 = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_filename_size_wide(
+	result = libewf_handle_get_number_of_sectors(
 	          handle,
-	          &filename_size_wide,
+	          &number_of_sectors,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	filename_size_wide_is_set = result;
-
 	/* Test error cases
 	 */
-	result = libewf_handle_get_filename_size_wide(
+	result = libewf_handle_get_number_of_sectors(
 	          NULL,
-	          &filename_size_wide,
+	          &number_of_sectors,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3173,25 +3963,23 @@ int ewf_test_handle_get_filename_size_wide(
 	libcerror_error_free(
 	 &error );
 
-	if( filename_size_wide_is_set != 0 )
-	{
-		result = libewf_handle_get_filename_size_wide(
-		          handle,
-		          NULL,
-		          &error );
+	result = libewf_handle_get_number_of_sectors(
+	          handle,
+	          NULL,
+	          &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -3203,42 +3991,37 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
-
-/* Tests the libewf_handle_get_file_io_handle function
+/* Tests the libewf_handle_get_chunk_size function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_file_io_handle(
+int ewf_test_handle_get_chunk_size(
      libewf_handle_t *handle )
 {
-	libbfio_handle_t *file_io_handle = NULL;
-	libcerror_error_t *error         = NULL;
-	int file_io_handle_is_set        = 0;
-	int result                       = 0;
+	libcerror_error_t *error = NULL;
+	size32_t chunk_size      = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_file_io_handle(
+	result = libewf_handle_get_chunk_size(
 	          handle,
-	          &file_io_handle,
+	          &chunk_size,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	file_io_handle_is_set = result;
-
 	/* Test error cases
 	 */
-	result = libewf_handle_get_file_io_handle(
+	result = libewf_handle_get_chunk_size(
 	          NULL,
-	          &file_io_handle,
+	          &chunk_size,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3253,25 +4036,23 @@ int ewf_test_handle_get_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
-	if( file_io_handle_is_set != 0 )
-	{
-		result = libewf_handle_get_file_io_handle(
-		          handle,
-		          NULL,
-		          &error );
+	result = libewf_handle_get_chunk_size(
+	          handle,
+	          NULL,
+	          &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -3283,62 +4064,37 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_root_file_entry function
+/* Tests the libewf_handle_get_error_granularity function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_root_file_entry(
+int ewf_test_handle_get_error_granularity(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error             = NULL;
-	libewf_file_entry_t *root_file_entry = NULL;
-	int result                           = 0;
-	int root_file_entry_is_set           = 0;
+	libcerror_error_t *error   = NULL;
+	uint32_t error_granularity = 0;
+	int result                 = 0;
 
 	/* Test regular cases
 	 */
-#ifdef TODO
-/* TODO fix test */
-	result = libewf_handle_get_root_file_entry(
+	result = libewf_handle_get_error_granularity(
 	          handle,
-	          &root_file_entry,
+	          &error_granularity,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	root_file_entry_is_set = result;
-
-	if( root_file_entry_is_set != 0 )
-	{
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "root_file_entry",
-		 root_file_entry );
-
-		result = libewf_file_entry_free(
-		          &root_file_entry,
-		          &error );
-
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
-
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
-#endif
 	/* Test error cases
 	 */
-	result = libewf_handle_get_root_file_entry(
+	result = libewf_handle_get_error_granularity(
 	          NULL,
-	          &root_file_entry,
+	          &error_granularity,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3346,10 +4102,6 @@ int ewf_test_handle_get_root_file_entry(
 	 result,
 	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "root_file_entry",
-	 root_file_entry );
-
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -3357,29 +4109,23 @@ int ewf_test_handle_get_root_file_entry(
 	libcerror_error_free(
 	 &error );
 
-	if( root_file_entry_is_set != 0 )
-	{
-		result = libewf_handle_get_root_file_entry(
-		          handle,
-		          NULL,
-		          &error );
+	result = libewf_handle_get_error_granularity(
+	          handle,
+	          NULL,
+	          &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "root_file_entry",
-		 root_file_entry );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -3388,30 +4134,24 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( root_file_entry != NULL )
-	{
-		libewf_file_entry_free(
-		 &root_file_entry,
-		 NULL );
-	}
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_sectors_per_chunk function
+/* Tests the libewf_handle_get_compression_method function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_sectors_per_chunk(
+int ewf_test_handle_get_compression_method(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error   = NULL;
-	uint32_t sectors_per_chunk = 0;
-	int result                 = 0;
+	libcerror_error_t *error    = NULL;
+	uint16_t compression_method = 0;
+	int result                  = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_sectors_per_chunk(
+	result = libewf_handle_get_compression_method(
 	          handle,
-	          &sectors_per_chunk,
+	          &compression_method,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3425,9 +4165,9 @@ int ewf_test_handle_get_sectors_per_chunk(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_sectors_per_chunk(
+	result = libewf_handle_get_compression_method(
 	          NULL,
-	          &sectors_per_chunk,
+	          &compression_method,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3442,7 +4182,7 @@ int ewf_test_handle_get_sectors_per_chunk(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_sectors_per_chunk(
+	result = libewf_handle_get_compression_method(
 	          handle,
 	          NULL,
 	          &error );
@@ -3470,21 +4210,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_bytes_per_sector function
+/* Tests the libewf_handle_get_media_size function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_bytes_per_sector(
+int ewf_test_handle_get_media_size(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error  = NULL;
-	uint32_t bytes_per_sector = 0;
-	int result                = 0;
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_bytes_per_sector(
+	result = libewf_handle_get_media_size(
 	          handle,
-	          &bytes_per_sector,
+	          &media_size,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3498,9 +4238,9 @@ int ewf_test_handle_get_bytes_per_sector(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_bytes_per_sector(
+	result = libewf_handle_get_media_size(
 	          NULL,
-	          &bytes_per_sector,
+	          &media_size,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3515,7 +4255,7 @@ int ewf_test_handle_get_bytes_per_sector(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_bytes_per_sector(
+	result = libewf_handle_get_media_size(
 	          handle,
 	          NULL,
 	          &error );
@@ -3543,21 +4283,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_number_of_sectors function
+/* Tests the libewf_handle_get_media_type function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_number_of_sectors(
+int ewf_test_handle_get_media_type(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error   = NULL;
-	uint64_t number_of_sectors = 0;
-	int result                 = 0;
+	libcerror_error_t *error = NULL;
+	uint8_t media_type       = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_number_of_sectors(
+	result = libewf_handle_get_media_type(
 	          handle,
-	          &number_of_sectors,
+	          &media_type,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3571,9 +4311,9 @@ int ewf_test_handle_get_number_of_sectors(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_number_of_sectors(
+	result = libewf_handle_get_media_type(
 	          NULL,
-	          &number_of_sectors,
+	          &media_type,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3588,7 +4328,7 @@ int ewf_test_handle_get_number_of_sectors(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_number_of_sectors(
+	result = libewf_handle_get_media_type(
 	          handle,
 	          NULL,
 	          &error );
@@ -3616,21 +4356,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_chunk_size function
+/* Tests the libewf_handle_get_media_flags function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_chunk_size(
+int ewf_test_handle_get_media_flags(
      libewf_handle_t *handle )
 {
 	libcerror_error_t *error = NULL;
-	size32_t chunk_size      = 0;
+	uint8_t media_flags      = 0;
 	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_chunk_size(
+	result = libewf_handle_get_media_flags(
 	          handle,
-	          &chunk_size,
+	          &media_flags,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3644,9 +4384,9 @@ int ewf_test_handle_get_chunk_size(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_chunk_size(
+	result = libewf_handle_get_media_flags(
 	          NULL,
-	          &chunk_size,
+	          &media_flags,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3661,7 +4401,7 @@ int ewf_test_handle_get_chunk_size(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_chunk_size(
+	result = libewf_handle_get_media_flags(
 	          handle,
 	          NULL,
 	          &error );
@@ -3689,21 +4429,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_error_granularity function
+/* Tests the libewf_handle_get_format function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_error_granularity(
+int ewf_test_handle_get_format(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error   = NULL;
-	uint32_t error_granularity = 0;
-	int result                 = 0;
+	libcerror_error_t *error = NULL;
+	uint8_t format           = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_error_granularity(
+	result = libewf_handle_get_format(
 	          handle,
-	          &error_granularity,
+	          &format,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3717,9 +4457,9 @@ int ewf_test_handle_get_error_granularity(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_error_granularity(
+	result = libewf_handle_get_format(
 	          NULL,
-	          &error_granularity,
+	          &format,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3734,7 +4474,7 @@ int ewf_test_handle_get_error_granularity(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_error_granularity(
+	result = libewf_handle_get_format(
 	          handle,
 	          NULL,
 	          &error );
@@ -3762,21 +4502,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_compression_method function
+/* Tests the libewf_handle_get_number_of_acquiry_errors function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_compression_method(
+int ewf_test_handle_get_number_of_acquiry_errors(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error    = NULL;
-	uint16_t compression_method = 0;
-	int result                  = 0;
+	libcerror_error_t *error          = NULL;
+	uint32_t number_of_acquiry_errors = 0;
+	int result                        = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_compression_method(
+	result = libewf_handle_get_number_of_acquiry_errors(
 	          handle,
-	          &compression_method,
+	          &number_of_acquiry_errors,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3790,9 +4530,9 @@ int ewf_test_handle_get_compression_method(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_compression_method(
+	result = libewf_handle_get_number_of_acquiry_errors(
 	          NULL,
-	          &compression_method,
+	          &number_of_acquiry_errors,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3807,7 +4547,7 @@ int ewf_test_handle_get_compression_method(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_compression_method(
+	result = libewf_handle_get_number_of_acquiry_errors(
 	          handle,
 	          NULL,
 	          &error );
@@ -3835,21 +4575,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_media_size function
+/* Tests the libewf_handle_get_number_of_checksum_errors function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_media_size(
+int ewf_test_handle_get_number_of_checksum_errors(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	size64_t media_size      = 0;
-	int result               = 0;
+	libcerror_error_t *error           = NULL;
+	uint32_t number_of_checksum_errors = 0;
+	int result                         = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_media_size(
+	result = libewf_handle_get_number_of_checksum_errors(
 	          handle,
-	          &media_size,
+	          &number_of_checksum_errors,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3863,9 +4603,9 @@ int ewf_test_handle_get_media_size(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_media_size(
+	result = libewf_handle_get_number_of_checksum_errors(
 	          NULL,
-	          &media_size,
+	          &number_of_checksum_errors,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3880,7 +4620,7 @@ int ewf_test_handle_get_media_size(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_media_size(
+	result = libewf_handle_get_number_of_checksum_errors(
 	          handle,
 	          NULL,
 	          &error );
@@ -3908,21 +4648,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_media_type function
+/* Tests the libewf_handle_get_number_of_sessions function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_media_type(
+int ewf_test_handle_get_number_of_sessions(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	uint8_t media_type       = 0;
-	int result               = 0;
+	libcerror_error_t *error    = NULL;
+	uint32_t number_of_sessions = 0;
+	int result                  = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_media_type(
+	result = libewf_handle_get_number_of_sessions(
 	          handle,
-	          &media_type,
+	          &number_of_sessions,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3936,9 +4676,9 @@ int ewf_test_handle_get_media_type(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_media_type(
+	result = libewf_handle_get_number_of_sessions(
 	          NULL,
-	          &media_type,
+	          &number_of_sessions,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3953,7 +4693,7 @@ int ewf_test_handle_get_media_type(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_media_type(
+	result = libewf_handle_get_number_of_sessions(
 	          handle,
 	          NULL,
 	          &error );
@@ -3981,21 +4721,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_media_flags function
+/* Tests the libewf_handle_get_number_of_tracks function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_media_flags(
+int ewf_test_handle_get_number_of_tracks(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	uint8_t media_flags      = 0;
-	int result               = 0;
+	libcerror_error_t *error  = NULL;
+	uint32_t number_of_tracks = 0;
+	int result                = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_media_flags(
+	result = libewf_handle_get_number_of_tracks(
 	          handle,
-	          &media_flags,
+	          &number_of_tracks,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -4009,9 +4749,9 @@ int ewf_test_handle_get_media_flags(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_media_flags(
+	result = libewf_handle_get_number_of_tracks(
 	          NULL,
-	          &media_flags,
+	          &number_of_tracks,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -4026,7 +4766,7 @@ int ewf_test_handle_get_media_flags(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_media_flags(
+	result = libewf_handle_get_number_of_tracks(
 	          handle,
 	          NULL,
 	          &error );
@@ -4054,21 +4794,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_format function
+/* Tests the libewf_handle_get_header_values_date_format function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_format(
+int ewf_test_handle_get_header_values_date_format(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	uint8_t format           = 0;
-	int result               = 0;
+	libcerror_error_t *error      = NULL;
+	int header_values_date_format = 0;
+	int result                    = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_format(
+	result = libewf_handle_get_header_values_date_format(
 	          handle,
-	          &format,
+	          &header_values_date_format,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -4082,9 +4822,9 @@ int ewf_test_handle_get_format(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_format(
+	result = libewf_handle_get_header_values_date_format(
 	          NULL,
-	          &format,
+	          &header_values_date_format,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -4099,7 +4839,7 @@ int ewf_test_handle_get_format(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_format(
+	result = libewf_handle_get_header_values_date_format(
 	          handle,
 	          NULL,
 	          &error );
@@ -4127,21 +4867,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_number_of_acquiry_errors function
+/* Tests the libewf_handle_get_number_of_header_values function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_number_of_acquiry_errors(
+int ewf_test_handle_get_number_of_header_values(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error          = NULL;
-	uint32_t number_of_acquiry_errors = 0;
-	int result                        = 0;
+	libcerror_error_t *error         = NULL;
+	uint32_t number_of_header_values = 0;
+	int result                       = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_number_of_acquiry_errors(
+	result = libewf_handle_get_number_of_header_values(
 	          handle,
-	          &number_of_acquiry_errors,
+	          &number_of_header_values,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -4155,9 +4895,9 @@ int ewf_test_handle_get_number_of_acquiry_errors(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_number_of_acquiry_errors(
+	result = libewf_handle_get_number_of_header_values(
 	          NULL,
-	          &number_of_acquiry_errors,
+	          &number_of_header_values,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -4172,7 +4912,7 @@ int ewf_test_handle_get_number_of_acquiry_errors(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_number_of_acquiry_errors(
+	result = libewf_handle_get_number_of_header_values(
 	          handle,
 	          NULL,
 	          &error );
@@ -4200,21 +4940,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_number_of_checksum_errors function
+/* Tests the libewf_handle_get_number_of_hash_values function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_number_of_checksum_errors(
+int ewf_test_handle_get_number_of_hash_values(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error           = NULL;
-	uint32_t number_of_checksum_errors = 0;
-	int result                         = 0;
+	libcerror_error_t *error       = NULL;
+	uint32_t number_of_hash_values = 0;
+	int result                     = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_number_of_checksum_errors(
+	result = libewf_handle_get_number_of_hash_values(
 	          handle,
-	          &number_of_checksum_errors,
+	          &number_of_hash_values,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -4228,9 +4968,9 @@ int ewf_test_handle_get_number_of_checksum_errors(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_number_of_checksum_errors(
+	result = libewf_handle_get_number_of_hash_values(
 	          NULL,
-	          &number_of_checksum_errors,
+	          &number_of_hash_values,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -4245,7 +4985,7 @@ int ewf_test_handle_get_number_of_checksum_errors(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_number_of_checksum_errors(
+	result = libewf_handle_get_number_of_hash_values(
 	          handle,
 	          NULL,
 	          &error );
@@ -4273,21 +5013,74 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_number_of_sessions function
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Fills a buffer with the chunk data pattern at a specific media offset
+ * The chunk data repeats every number of patterns chunks
+ */
+void ewf_test_handle_write_read_chunks_fill_buffer(
+      uint8_t *buffer,
+      size_t buffer_size,
+      size64_t media_offset )
+{
+	size64_t chunk_offset = 0;
+	size_t buffer_index   = 0;
+	uint8_t pattern       = 0;
+
+	pattern      = (uint8_t) ( ( media_offset / EWF_TEST_HANDLE_WRITE_CHUNK_SIZE ) % EWF_TEST_HANDLE_WRITE_NUMBER_OF_PATTERNS );
+	chunk_offset = media_offset % EWF_TEST_HANDLE_WRITE_CHUNK_SIZE;
+
+	for( buffer_index = 0;
+	     buffer_index < buffer_size;
+	     buffer_index++ )
+	{
+		buffer[ buffer_index ] = (uint8_t) ( ( ( pattern + 1 ) * 31 ) + ( ( chunk_offset + buffer_index ) % 251 ) );
+	}
+}
+
+/* Writes an image in the EWFX format with repeated chunk data, reads it back
+ * and compares the data
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_number_of_sessions(
-     libewf_handle_t *handle )
+int ewf_test_handle_write_read_chunks(
+     uint8_t deduplicate_chunks,
+     uint32_t chunks_section_alignment )
 {
-	libcerror_error_t *error    = NULL;
-	uint32_t number_of_sessions = 0;
-	int result                  = 0;
+	char *filenames[ 1 ]                       = { EWF_TEST_HANDLE_WRITE_SEGMENT_FILENAME };
+	libcerror_error_t *error                   = NULL;
+	libewf_handle_t *handle                    = NULL;
+	libewf_internal_handle_t *internal_handle  = NULL;
+	uint8_t *buffer                            = NULL;
+	uint8_t *expected_buffer                   = NULL;
+	off64_t chunk_data_offset                  = 0;
+	off64_t first_chunk_data_offset            = 0;
+	size64_t chunk_data_size                   = 0;
+	size64_t media_offset                      = 0;
+	ssize_t read_count                         = 0;
+	ssize_t write_count                        = 0;
+	uint32_t chunk_data_flags                  = 0;
+	uint32_t chunk_index                       = 0;
+	int file_io_pool_entry                     = 0;
+	int result                                 = 0;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * EWF_TEST_HANDLE_WRITE_BUFFER_SIZE );
 
-	/* Test regular cases
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	expected_buffer = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * EWF_TEST_HANDLE_WRITE_BUFFER_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "expected_buffer",
+	 expected_buffer );
+
+	/* Write the image
 	 */
-	result = libewf_handle_get_number_of_sessions(
-	          handle,
-	          &number_of_sessions,
+	result = libewf_handle_initialize(
+	          &handle,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -4295,72 +5088,49 @@ int ewf_test_handle_get_number_of_sessions(
 	 result,
 	 1 );
 
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libewf_handle_get_number_of_sessions(
-	          NULL,
-	          &number_of_sessions,
+	filenames[ 0 ] = EWF_TEST_HANDLE_WRITE_FILENAME;
+
+	result = libewf_handle_open(
+	          handle,
+	          filenames,
+	          1,
+	          LIBEWF_OPEN_WRITE,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	result = libewf_handle_get_number_of_sessions(
+	result = libewf_handle_set_format(
 	          handle,
-	          NULL,
+	          LIBEWF_FORMAT_EWFX,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
-
-/* Tests the libewf_handle_get_number_of_tracks function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_get_number_of_tracks(
-     libewf_handle_t *handle )
-{
-	libcerror_error_t *error  = NULL;
-	uint32_t number_of_tracks = 0;
-	int result                = 0;
-
-	/* Test regular cases
-	 */
-	result = libewf_handle_get_number_of_tracks(
+	result = libewf_handle_set_media_size(
 	          handle,
-	          &number_of_tracks,
+	          EWF_TEST_HANDLE_WRITE_MEDIA_SIZE,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -4372,68 +5142,86 @@ int ewf_test_handle_get_number_of_tracks(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libewf_handle_get_number_of_tracks(
-	          NULL,
-	          &number_of_tracks,
+	result = libewf_handle_set_deduplicate_chunks(
+	          handle,
+	          deduplicate_chunks,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	result = libewf_handle_get_number_of_tracks(
+	result = libewf_handle_set_chunks_section_alignment(
 	          handle,
-	          NULL,
+	          chunks_section_alignment,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	for( media_offset = 0;
+	     media_offset < EWF_TEST_HANDLE_WRITE_MEDIA_SIZE;
+	     media_offset += EWF_TEST_HANDLE_WRITE_BUFFER_SIZE )
+	{
+		ewf_test_handle_write_read_chunks_fill_buffer(
+		 buffer,
+		 EWF_TEST_HANDLE_WRITE_BUFFER_SIZE,
+		 media_offset );
 
-	return( 1 );
+		write_count = libewf_handle_write_buffer(
+		               handle,
+		               buffer,
+		               EWF_TEST_HANDLE_WRITE_BUFFER_SIZE,
+		               &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "write_count",
+		 write_count,
+		 (ssize_t) EWF_TEST_HANDLE_WRITE_BUFFER_SIZE );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 	}
-	return( 0 );
-}
+	write_count = libewf_handle_write_finalize(
+	               handle,
+	               &error );
 
-/* Tests the libewf_handle_get_header_values_date_format function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_get_header_values_date_format(
-     libewf_handle_t *handle )
-{
-	libcerror_error_t *error      = NULL;
-	int header_values_date_format = 0;
-	int result                    = 0;
+	EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
 
-	/* Test regular cases
-	 */
-	result = libewf_handle_get_header_values_date_format(
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_close(
 	          handle,
-	          &header_values_date_format,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_free(
+	          &handle,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -4445,114 +5233,176 @@ int ewf_test_handle_get_header_values_date_format(
 	 "error",
 	 error );
 
-	/* Test error cases
+	/* Read the image back
 	 */
-	result = libewf_handle_get_header_values_date_format(
-	          NULL,
-	          &header_values_date_format,
+	result = libewf_handle_initialize(
+	          &handle,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	filenames[ 0 ] = EWF_TEST_HANDLE_WRITE_SEGMENT_FILENAME;
 
-	result = libewf_handle_get_header_values_date_format(
+	result = libewf_handle_open(
 	          handle,
-	          NULL,
+	          filenames,
+	          1,
+	          LIBEWF_OPEN_READ,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	for( media_offset = 0;
+	     media_offset < EWF_TEST_HANDLE_WRITE_MEDIA_SIZE;
+	     media_offset += EWF_TEST_HANDLE_WRITE_BUFFER_SIZE )
+	{
+		ewf_test_handle_write_read_chunks_fill_buffer(
+		 expected_buffer,
+		 EWF_TEST_HANDLE_WRITE_BUFFER_SIZE,
+		 media_offset );
 
-	return( 1 );
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              EWF_TEST_HANDLE_WRITE_BUFFER_SIZE,
+		              &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) EWF_TEST_HANDLE_WRITE_BUFFER_SIZE );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          expected_buffer,
+		          EWF_TEST_HANDLE_WRITE_BUFFER_SIZE );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
 	}
-	return( 0 );
-}
+	/* Check where the chunk data was stored, chunks with the same index
+	 * modulo the pattern count contain the same data
+	 */
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-/* Tests the libewf_handle_get_number_of_header_values function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_get_number_of_header_values(
-     libewf_handle_t *handle )
-{
-	libcerror_error_t *error         = NULL;
-	uint32_t number_of_header_values = 0;
-	int result                       = 0;
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_HANDLE_WRITE_NUMBER_OF_CHUNKS;
+	     chunk_index += EWF_TEST_HANDLE_WRITE_NUMBER_OF_PATTERNS )
+	{
+		result = libewf_chunk_table_get_chunk_data_range_by_offset(
+		          internal_handle->chunk_table,
+		          internal_handle->file_io_pool,
+		          internal_handle->media_values,
+		          internal_handle->segment_table,
+		          (off64_t) chunk_index * EWF_TEST_HANDLE_WRITE_CHUNK_SIZE,
+		          &file_io_pool_entry,
+		          &chunk_data_offset,
+		          &chunk_data_size,
+		          &chunk_data_flags,
+		          &error );
 
-	/* Test regular cases
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( chunk_index == 0 )
+		{
+			first_chunk_data_offset = chunk_data_offset;
+
+			/* The chunk data of the first chunk starts a chunks section
+			 */
+			if( chunks_section_alignment > 1 )
+			{
+				EWF_TEST_ASSERT_EQUAL_INT64(
+				 "chunk_data_offset % chunks_section_alignment",
+				 (int64_t) ( chunk_data_offset % chunks_section_alignment ),
+				 (int64_t) 0 );
+			}
+		}
+		else if( deduplicate_chunks != 0 )
+		{
+			EWF_TEST_ASSERT_EQUAL_INT64(
+			 "chunk_data_offset",
+			 (int64_t) chunk_data_offset,
+			 (int64_t) first_chunk_data_offset );
+		}
+		else
+		{
+			EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+			 "chunk_data_offset",
+			 (int64_t) chunk_data_offset,
+			 (int64_t) first_chunk_data_offset );
+		}
+	}
+	/* Clean up
 	 */
-	result = libewf_handle_get_number_of_header_values(
+	result = libewf_handle_close(
 	          handle,
-	          &number_of_header_values,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 0 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libewf_handle_get_number_of_header_values(
-	          NULL,
-	          &number_of_header_values,
+	result = libewf_handle_free(
+	          &handle,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	remove(
+	 EWF_TEST_HANDLE_WRITE_SEGMENT_FILENAME );
 
-	result = libewf_handle_get_number_of_header_values(
-	          handle,
-	          NULL,
-	          &error );
+	memory_free(
+	 expected_buffer );
 
-	EWF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	expected_buffer = NULL;
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	memory_free(
+	 buffer );
 
-	libcerror_error_free(
-	 &error );
+	buffer = NULL;
 
 	return( 1 );
 
@@ -4562,82 +5412,94 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	remove(
+	 EWF_TEST_HANDLE_WRITE_SEGMENT_FILENAME );
+
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_number_of_hash_values function
+/* Tests writing and reading an image with chunk deduplication
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_number_of_hash_values(
-     libewf_handle_t *handle )
+int ewf_test_handle_write_read_deduplicate_chunks(
+     void )
 {
-	libcerror_error_t *error       = NULL;
-	uint32_t number_of_hash_values = 0;
-	int result                     = 0;
+	int result = 0;
 
-	/* Test regular cases
-	 */
-	result = libewf_handle_get_number_of_hash_values(
-	          handle,
-	          &number_of_hash_values,
-	          &error );
+	result = ewf_test_handle_write_read_chunks(
+	          0,
+	          0 );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
-
-	/* Test error cases
-	 */
-	result = libewf_handle_get_number_of_hash_values(
-	          NULL,
-	          &number_of_hash_values,
-	          &error );
+	result = ewf_test_handle_write_read_chunks(
+	          1,
+	          0 );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	return( 1 );
 
-	libcerror_error_free(
-	 &error );
+on_error:
+	return( 0 );
+}
 
-	result = libewf_handle_get_number_of_hash_values(
-	          handle,
-	          NULL,
-	          &error );
+/* Tests writing and reading an image with aligned chunks sections
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_write_read_aligned_chunks(
+     void )
+{
+	int result = 0;
+
+	result = ewf_test_handle_write_read_chunks(
+	          0,
+	          4096 );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	result = ewf_test_handle_write_read_chunks(
+	          1,
+	          4096 );
 
-	libcerror_error_free(
-	 &error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	return( 1 );
 
 on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
 	return( 0 );
 }
 
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -4703,6 +5565,18 @@ int main(
 	 "libewf_handle_clone",
 	 ewf_test_handle_clone );
 
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_handle_write_read_deduplicate_chunks",
+	 ewf_test_handle_write_read_deduplicate_chunks );
+
+	EWF_TEST_RUN(
+	 "libewf_handle_write_read_aligned_chunks",
+	 ewf_test_handle_write_read_aligned_chunks );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -4903,6 +5777,11 @@ int main(
 		 ewf_test_handle_read_buffer_at_offset,
 		 handle );
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_clone_reader",
+		 ewf_test_handle_clone_reader,
+		 handle );
+
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
 		/* TODO: add tests for libewf_internal_handle_write_buffer_to_file_io_pool */
@@ -0,0 +1,849 @@
+/*
+ * Library index_segment type test program
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_index_segment.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_index_segment_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_segment_initialize(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libewf_index_segment_t *index_segment = NULL;
+	int result                            = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests       = 1;
+	int number_of_memset_fail_tests       = 1;
+	int test_number                       = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_index_segment_initialize(
+	          &index_segment,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_segment",
+	 index_segment );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "index_segment->device_information_section_index",
+	 index_segment->device_information_section_index,
+	 -1 );
+
+	result = libewf_index_segment_free(
+	          &index_segment,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "index_segment",
+	 index_segment );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_index_segment_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	index_segment = (libewf_index_segment_t *) 0x12345678UL;
+
+	result = libewf_index_segment_initialize(
+	          &index_segment,
+	          &error );
+
+	index_segment = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_index_segment_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_index_segment_initialize(
+		          &index_segment,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( index_segment != NULL )
+			{
+				libewf_index_segment_free(
+				 &index_segment,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "index_segment",
+			 index_segment );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_index_segment_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_index_segment_initialize(
+		          &index_segment,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( index_segment != NULL )
+			{
+				libewf_index_segment_free(
+				 &index_segment,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "index_segment",
+			 index_segment );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_segment != NULL )
+	{
+		libewf_index_segment_free(
+		 &index_segment,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_segment_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_segment_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_index_segment_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_segment_resize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_segment_resize(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libewf_index_segment_t *index_segment = NULL;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_index_segment_initialize(
+	          &index_segment,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_segment",
+	 index_segment );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_index_segment_resize(
+	          index_segment,
+	          4,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "index_segment->number_of_sections",
+	 index_segment->number_of_sections,
+	 4 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "index_segment->number_of_chunk_groups",
+	 index_segment->number_of_chunk_groups,
+	 2 );
+
+	result = libewf_index_segment_resize(
+	          index_segment,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "index_segment->section_offsets",
+	 index_segment->section_offsets );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "index_segment->chunk_groups",
+	 index_segment->chunk_groups );
+
+	/* Test error cases
+	 */
+	result = libewf_index_segment_resize(
+	          NULL,
+	          4,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_segment_resize(
+	          index_segment,
+	          -1,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_segment_resize(
+	          index_segment,
+	          4,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_index_segment_free(
+	          &index_segment,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "index_segment",
+	 index_segment );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_segment != NULL )
+	{
+		libewf_index_segment_free(
+		 &index_segment,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_segment_write_data and libewf_index_segment_read_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_segment_write_and_read_data(
+     void )
+{
+	uint8_t data[ 512 ];
+
+	libcerror_error_t *error                = NULL;
+	libewf_index_segment_t *index_segment   = NULL;
+	libewf_index_segment_t *read_segment    = NULL;
+	size_t data_size                        = 0;
+	ssize_t read_count                      = 0;
+	ssize_t write_count                     = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_index_segment_initialize(
+	          &index_segment,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_segment",
+	 index_segment );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_segment_resize(
+	          index_segment,
+	          3,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	index_segment->segment_file_size                  = 1474560;
+	index_segment->segment_number                     = 2;
+	index_segment->last_section_checksum              = 0x12345678UL;
+	index_segment->last_section_offset                = 1474484;
+	index_segment->type                               = 1;
+	index_segment->major_version                      = 1;
+	index_segment->compression_method                 = 1;
+	index_segment->number_of_chunks                   = 40;
+	index_segment->last_chunk_filled                  = 79;
+	index_segment->section_offsets[ 0 ]               = 13;
+	index_segment->section_offsets[ 1 ]               = 89;
+	index_segment->section_offsets[ 2 ]               = 1474484;
+	index_segment->chunk_groups[ 0 ].data_offset      = 89;
+	index_segment->chunk_groups[ 0 ].data_size        = 1310796;
+	index_segment->chunk_groups[ 0 ].number_of_chunks = 40;
+	index_segment->chunk_groups[ 0 ].chunks_offset    = 64;
+	index_segment->chunk_groups[ 0 ].chunks_checksum  = 0x87654321UL;
+
+	result = libewf_index_segment_get_data_size(
+	          index_segment,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_LESS_THAN_UINT64(
+	 "data_size",
+	 (uint64_t) data_size,
+	 (uint64_t) sizeof( data ) + 1 );
+
+	result = libewf_index_segment_initialize(
+	          &read_segment,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_segment",
+	 read_segment );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	write_count = libewf_index_segment_write_data(
+	               index_segment,
+	               data,
+	               sizeof( data ),
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) data_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_index_segment_read_data(
+	              read_segment,
+	              data,
+	              data_size,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) data_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_segment->segment_file_size",
+	 read_segment->segment_file_size,
+	 (uint64_t) 1474560 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "read_segment->segment_number",
+	 read_segment->segment_number,
+	 (uint32_t) 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "read_segment->last_section_checksum",
+	 read_segment->last_section_checksum,
+	 (uint32_t) 0x12345678UL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_segment->device_information_section_index",
+	 read_segment->device_information_section_index,
+	 -1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "read_segment->last_chunk_filled",
+	 read_segment->last_chunk_filled,
+	 (int64_t) 79 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_segment->number_of_sections",
+	 read_segment->number_of_sections,
+	 3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "read_segment->section_offsets[ 2 ]",
+	 (int64_t) read_segment->section_offsets[ 2 ],
+	 (int64_t) 1474484 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_segment->number_of_chunk_groups",
+	 read_segment->number_of_chunk_groups,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_segment->chunk_groups[ 0 ].data_size",
+	 read_segment->chunk_groups[ 0 ].data_size,
+	 (uint64_t) 1310796 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "read_segment->chunk_groups[ 0 ].chunks_checksum",
+	 read_segment->chunk_groups[ 0 ].chunks_checksum,
+	 (uint32_t) 0x87654321UL );
+
+	/* Test error cases
+	 */
+	write_count = libewf_index_segment_write_data(
+	               NULL,
+	               data,
+	               sizeof( data ),
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_index_segment_write_data(
+	               index_segment,
+	               data,
+	               data_size - 1,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_index_segment_read_data(
+	              NULL,
+	              data,
+	              data_size,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_index_segment_read_data(
+	              read_segment,
+	              NULL,
+	              data_size,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_index_segment_read_data(
+	              read_segment,
+	              data,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with data that is too small to contain the section offsets and chunk groups
+	 */
+	read_count = libewf_index_segment_read_data(
+	              read_segment,
+	              data,
+	              data_size - 1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_index_segment_free(
+	          &read_segment,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_segment",
+	 read_segment );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_segment_free(
+	          &index_segment,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "index_segment",
+	 index_segment );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_segment != NULL )
+	{
+		libewf_index_segment_free(
+		 &read_segment,
+		 NULL );
+	}
+	if( index_segment != NULL )
+	{
+		libewf_index_segment_free(
+		 &index_segment,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_index_segment_initialize",
+	 ewf_test_index_segment_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_index_segment_free",
+	 ewf_test_index_segment_free );
+
+	EWF_TEST_RUN(
+	 "libewf_index_segment_resize",
+	 ewf_test_index_segment_resize );
+
+	EWF_TEST_RUN(
+	 "libewf_index_segment_write_data",
+	 ewf_test_index_segment_write_and_read_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -33,6 +33,7 @@
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
+#include "../libewf/libewf_io_handle.h"
 #include "../libewf/libewf_read_io_handle.h"
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
@@ -539,6 +540,237 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_read_io_handle_read_chunk_data_to_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_io_handle_read_chunk_data_to_buffer(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error                = NULL;
+	libewf_io_handle_t *io_handle           = NULL;
+	libewf_read_io_handle_t *read_io_handle = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->chunk_size = 32768;
+
+	result = libewf_read_io_handle_initialize(
+	          &read_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_io_handle",
+	 read_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test buffer too small to contain the chunk
+	 */
+	result = libewf_read_io_handle_read_chunk_data_to_buffer(
+	          read_io_handle,
+	          io_handle,
+	          NULL,
+	          0,
+	          0,
+	          512,
+	          0,
+	          buffer,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_read_io_handle_read_chunk_data_to_buffer(
+	          NULL,
+	          io_handle,
+	          NULL,
+	          0,
+	          0,
+	          512,
+	          0,
+	          buffer,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_io_handle_read_chunk_data_to_buffer(
+	          read_io_handle,
+	          NULL,
+	          NULL,
+	          0,
+	          0,
+	          512,
+	          0,
+	          buffer,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_io_handle_read_chunk_data_to_buffer(
+	          read_io_handle,
+	          io_handle,
+	          NULL,
+	          0,
+	          0,
+	          512,
+	          0,
+	          NULL,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_io_handle_read_chunk_data_to_buffer(
+	          read_io_handle,
+	          io_handle,
+	          NULL,
+	          0,
+	          0,
+	          512,
+	          0,
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_read_io_handle_free(
+	          &read_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_io_handle",
+	 read_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_io_handle != NULL )
+	{
+		libewf_read_io_handle_free(
+		 &read_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -570,6 +802,10 @@ int main(
 	 "libewf_read_io_handle_clone",
 	 ewf_test_read_io_handle_clone );
 
+	EWF_TEST_RUN(
+	 "libewf_read_io_handle_read_chunk_data_to_buffer",
+	 ewf_test_read_io_handle_read_chunk_data_to_buffer );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,790 @@
+/*
+ * Library segment_writer type test program
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_functions.h"
+#include "ewf_test_libbfio.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_segment_writer.h"
+
+#define EWF_TEST_SEGMENT_WRITER_BUFFER_SIZE		LIBEWF_SEGMENT_WRITER_MINIMUM_BUFFER_SIZE
+#define EWF_TEST_SEGMENT_WRITER_CHUNK_SIZE		16384
+#define EWF_TEST_SEGMENT_WRITER_LARGE_CHUNK_SIZE	( 2 * EWF_TEST_SEGMENT_WRITER_BUFFER_SIZE )
+#define EWF_TEST_SEGMENT_WRITER_NUMBER_OF_CHUNKS	6
+#define EWF_TEST_SEGMENT_WRITER_FILE_SIZE		( ( EWF_TEST_SEGMENT_WRITER_NUMBER_OF_CHUNKS * EWF_TEST_SEGMENT_WRITER_CHUNK_SIZE ) + EWF_TEST_SEGMENT_WRITER_LARGE_CHUNK_SIZE )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Creates chunk data filled with a test pattern
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_segment_writer_create_chunk_data(
+     libewf_chunk_data_t **chunk_data,
+     size32_t chunk_size,
+     uint8_t seed,
+     libcerror_error_t **error )
+{
+	size_t data_offset = 0;
+
+	if( libewf_chunk_data_initialize(
+	     chunk_data,
+	     chunk_size,
+	     0,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	for( data_offset = 0;
+	     data_offset < (size_t) chunk_size;
+	     data_offset++ )
+	{
+		( *chunk_data )->data[ data_offset ] = (uint8_t) ( seed + ( data_offset % 251 ) );
+	}
+	( *chunk_data )->data_size = (size_t) chunk_size;
+
+	return( 1 );
+}
+
+/* Tests the libewf_segment_writer_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_writer_initialize(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libewf_segment_writer_t *segment_writer = NULL;
+	int result                              = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests         = 3;
+	int number_of_memset_fail_tests         = 1;
+	int test_number                         = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_segment_writer_initialize(
+	          &segment_writer,
+	          EWF_TEST_SEGMENT_WRITER_BUFFER_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_writer",
+	 segment_writer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_writer_free(
+	          &segment_writer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_writer",
+	 segment_writer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_segment_writer_initialize(
+	          NULL,
+	          EWF_TEST_SEGMENT_WRITER_BUFFER_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	segment_writer = (libewf_segment_writer_t *) 0x12345678UL;
+
+	result = libewf_segment_writer_initialize(
+	          &segment_writer,
+	          EWF_TEST_SEGMENT_WRITER_BUFFER_SIZE,
+	          &error );
+
+	segment_writer = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_writer_initialize(
+	          &segment_writer,
+	          LIBEWF_SEGMENT_WRITER_MINIMUM_BUFFER_SIZE - 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_writer",
+	 segment_writer );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_writer_initialize(
+	          &segment_writer,
+	          (size_t) LIBEWF_SEGMENT_WRITER_MAXIMUM_BUFFER_SIZE + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_writer",
+	 segment_writer );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_segment_writer_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_segment_writer_initialize(
+		          &segment_writer,
+		          EWF_TEST_SEGMENT_WRITER_BUFFER_SIZE,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( segment_writer != NULL )
+			{
+				libewf_segment_writer_free(
+				 &segment_writer,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "segment_writer",
+			 segment_writer );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_segment_writer_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_segment_writer_initialize(
+		          &segment_writer,
+		          EWF_TEST_SEGMENT_WRITER_BUFFER_SIZE,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( segment_writer != NULL )
+			{
+				libewf_segment_writer_free(
+				 &segment_writer,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "segment_writer",
+			 segment_writer );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_writer != NULL )
+	{
+		libewf_segment_writer_free(
+		 &segment_writer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_writer_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_writer_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_segment_writer_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_writer_append_chunk_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_writer_append_chunk_data(
+     void )
+{
+	libbfio_pool_t *file_io_pool            = NULL;
+	libcerror_error_t *error                = NULL;
+	libewf_chunk_data_t *chunk_data         = NULL;
+	libewf_segment_writer_t *segment_writer = NULL;
+	uint8_t *expected_data                  = NULL;
+	uint8_t *file_data                      = NULL;
+	void *memcpy_result                     = NULL;
+	size_t expected_data_offset             = 0;
+	ssize_t write_count                     = 0;
+	int chunk_index                         = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	file_data = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * EWF_TEST_SEGMENT_WRITER_FILE_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_data",
+	 file_data );
+
+	expected_data = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * EWF_TEST_SEGMENT_WRITER_FILE_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "expected_data",
+	 expected_data );
+
+	result = ewf_test_open_file_io_pool(
+	          &file_io_pool,
+	          file_data,
+	          EWF_TEST_SEGMENT_WRITER_FILE_SIZE,
+	          LIBBFIO_OPEN_WRITE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_writer_initialize(
+	          &segment_writer,
+	          EWF_TEST_SEGMENT_WRITER_BUFFER_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_writer",
+	 segment_writer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The chunks do not all fit in a single buffer
+	 */
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_SEGMENT_WRITER_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		result = ewf_test_segment_writer_create_chunk_data(
+		          &chunk_data,
+		          EWF_TEST_SEGMENT_WRITER_CHUNK_SIZE,
+		          (uint8_t) chunk_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		memcpy_result = memory_copy(
+		                 &( expected_data[ expected_data_offset ] ),
+		                 chunk_data->data,
+		                 EWF_TEST_SEGMENT_WRITER_CHUNK_SIZE );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "memcpy_result",
+		 memcpy_result );
+
+		expected_data_offset += EWF_TEST_SEGMENT_WRITER_CHUNK_SIZE;
+
+		write_count = libewf_segment_writer_append_chunk_data(
+		               segment_writer,
+		               file_io_pool,
+		               0,
+		               chunk_data,
+		               &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "write_count",
+		 write_count,
+		 (ssize_t) EWF_TEST_SEGMENT_WRITER_CHUNK_SIZE );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_chunk_data_free(
+		          &chunk_data,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* A chunk that does not fit in a buffer is written directly after the buffered chunks
+	 */
+	result = ewf_test_segment_writer_create_chunk_data(
+	          &chunk_data,
+	          EWF_TEST_SEGMENT_WRITER_LARGE_CHUNK_SIZE,
+	          0x80,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memcpy_result = memory_copy(
+	                 &( expected_data[ expected_data_offset ] ),
+	                 chunk_data->data,
+	                 EWF_TEST_SEGMENT_WRITER_LARGE_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memcpy_result",
+	 memcpy_result );
+
+	write_count = libewf_segment_writer_append_chunk_data(
+	               segment_writer,
+	               file_io_pool,
+	               0,
+	               chunk_data,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) EWF_TEST_SEGMENT_WRITER_LARGE_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_writer_flush(
+	          segment_writer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          file_data,
+	          expected_data,
+	          EWF_TEST_SEGMENT_WRITER_FILE_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	write_count = libewf_segment_writer_append_chunk_data(
+	               NULL,
+	               file_io_pool,
+	               0,
+	               chunk_data,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_segment_writer_append_chunk_data(
+	               segment_writer,
+	               NULL,
+	               0,
+	               chunk_data,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_segment_writer_append_chunk_data(
+	               segment_writer,
+	               file_io_pool,
+	               -1,
+	               chunk_data,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_segment_writer_append_chunk_data(
+	               segment_writer,
+	               file_io_pool,
+	               0,
+	               NULL,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_writer_flush(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_writer_free(
+	          &segment_writer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_writer",
+	 segment_writer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_close_file_io_pool(
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 expected_data );
+
+	memory_free(
+	 file_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( segment_writer != NULL )
+	{
+		libewf_segment_writer_free(
+		 &segment_writer,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	if( file_data != NULL )
+	{
+		memory_free(
+		 file_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_segment_writer_initialize",
+	 ewf_test_segment_writer_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_writer_free",
+	 ewf_test_segment_writer_free );
+
+	/* TODO: add tests for libewf_segment_writer_write_buffer */
+
+	/* TODO: add tests for libewf_segment_writer_wait_for_buffer */
+
+	/* TODO: add tests for libewf_segment_writer_submit_current_buffer */
+
+	EWF_TEST_RUN(
+	 "libewf_segment_writer_append_chunk_data",
+	 ewf_test_segment_writer_append_chunk_data );
+
+	/* libewf_segment_writer_flush is tested by ewf_test_segment_writer_append_chunk_data */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,838 @@
+/*
+ * Tools chunk_hash_tree functions test program
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/chunk_hash_tree.h"
+
+/* SHA256 of "ab"
+ */
+uint8_t ewf_test_tools_chunk_hash_tree_leaf_hash0[ 32 ] = {
+	0xfb, 0x8e, 0x20, 0xfc, 0x2e, 0x4c, 0x3f, 0x24, 0x8c, 0x60, 0xc3, 0x9b, 0xd6, 0x52, 0xf3, 0xc1,
+	0x34, 0x72, 0x98, 0xbb, 0x97, 0x7b, 0x8b, 0x4d, 0x59, 0x03, 0xb8, 0x50, 0x55, 0x62, 0x06, 0x03 };
+
+/* SHA256 of "c"
+ */
+uint8_t ewf_test_tools_chunk_hash_tree_leaf_hash1[ 32 ] = {
+	0x2e, 0x7d, 0x2c, 0x03, 0xa9, 0x50, 0x7a, 0xe2, 0x65, 0xec, 0xf5, 0xb5, 0x35, 0x68, 0x85, 0xa5,
+	0x33, 0x93, 0xa2, 0x02, 0x9d, 0x24, 0x13, 0x94, 0x99, 0x72, 0x65, 0xa1, 0xa2, 0x5a, 0xef, 0xc6 };
+
+/* SHA256 of the leaf hashes
+ */
+uint8_t ewf_test_tools_chunk_hash_tree_root_hash[ 32 ] = {
+	0x11, 0x53, 0x23, 0xe5, 0x62, 0xc4, 0xa4, 0xfd, 0xf7, 0xce, 0xac, 0xed, 0xca, 0x66, 0x0d, 0xc4,
+	0xbb, 0xe1, 0x38, 0x9d, 0xab, 0x93, 0x23, 0xaa, 0xd0, 0x84, 0x40, 0x90, 0x7c, 0x74, 0x26, 0xd0 };
+
+/* Tests the chunk_hash_tree_calculate_leaf_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_chunk_hash_tree_calculate_leaf_size(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	size32_t leaf_size       = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = chunk_hash_tree_calculate_leaf_size(
+	          32768,
+	          &leaf_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "leaf_size",
+	 (uint32_t) leaf_size,
+	 (uint32_t) ( 32768 * CHUNK_HASH_TREE_NUMBER_OF_CHUNKS_PER_LEAF ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The number of chunks per leaf is reduced for chunks of 8 MiB or more
+	 */
+	result = chunk_hash_tree_calculate_leaf_size(
+	          8 * 1024 * 1024,
+	          &leaf_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "leaf_size",
+	 (uint32_t) leaf_size,
+	 (uint32_t) ( 8 * 1024 * 1024 * 128 ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = chunk_hash_tree_calculate_leaf_size(
+	          1024 * 1024 * 1024,
+	          &leaf_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "leaf_size",
+	 (uint32_t) leaf_size,
+	 (uint32_t) ( 1024 * 1024 * 1024 ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = chunk_hash_tree_calculate_leaf_size(
+	          0,
+	          &leaf_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = chunk_hash_tree_calculate_leaf_size(
+	          (size32_t) INT32_MAX + 1,
+	          &leaf_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = chunk_hash_tree_calculate_leaf_size(
+	          32768,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the chunk_hash_tree_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_chunk_hash_tree_initialize(
+     void )
+{
+	chunk_hash_tree_t *chunk_hash_tree = NULL;
+	libcerror_error_t *error           = NULL;
+	int result                         = 0;
+
+	/* Test regular cases
+	 */
+	result = chunk_hash_tree_initialize(
+	          &chunk_hash_tree,
+	          3,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_hash_tree",
+	 chunk_hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_hash_tree->number_of_leaves",
+	 chunk_hash_tree->number_of_leaves,
+	 (uint64_t) 2 );
+
+	result = chunk_hash_tree_free(
+	          &chunk_hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_hash_tree",
+	 chunk_hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = chunk_hash_tree_initialize(
+	          NULL,
+	          3,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_hash_tree = (chunk_hash_tree_t *) 0x12345678UL;
+
+	result = chunk_hash_tree_initialize(
+	          &chunk_hash_tree,
+	          3,
+	          2,
+	          &error );
+
+	chunk_hash_tree = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = chunk_hash_tree_initialize(
+	          &chunk_hash_tree,
+	          0,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = chunk_hash_tree_initialize(
+	          &chunk_hash_tree,
+	          3,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_hash_tree != NULL )
+	{
+		chunk_hash_tree_free(
+		 &chunk_hash_tree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the chunk_hash_tree_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_chunk_hash_tree_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = chunk_hash_tree_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the chunk_hash_tree_update and chunk_hash_tree_finalize functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_chunk_hash_tree_update(
+     void )
+{
+	uint8_t data[ 3 ] = {
+		'a', 'b', 'c' };
+
+	chunk_hash_tree_t *chunk_hash_tree = NULL;
+	libcerror_error_t *error           = NULL;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = chunk_hash_tree_initialize(
+	          &chunk_hash_tree,
+	          3,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_hash_tree",
+	 chunk_hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test finalize before all data was provided
+	 */
+	result = chunk_hash_tree_update(
+	          chunk_hash_tree,
+	          data,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = chunk_hash_tree_finalize(
+	          chunk_hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases, the remaining data spans a leaf boundary
+	 */
+	result = chunk_hash_tree_update(
+	          chunk_hash_tree,
+	          &( data[ 1 ] ),
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = chunk_hash_tree_finalize(
+	          chunk_hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = chunk_hash_tree_compare_leaf_hash(
+	          chunk_hash_tree,
+	          0,
+	          ewf_test_tools_chunk_hash_tree_leaf_hash0,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = chunk_hash_tree_compare_leaf_hash(
+	          chunk_hash_tree,
+	          1,
+	          ewf_test_tools_chunk_hash_tree_leaf_hash1,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = chunk_hash_tree_compare_leaf_hash(
+	          chunk_hash_tree,
+	          1,
+	          ewf_test_tools_chunk_hash_tree_leaf_hash0,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          chunk_hash_tree->root_hash,
+	          ewf_test_tools_chunk_hash_tree_root_hash,
+	          32 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = chunk_hash_tree_update(
+	          chunk_hash_tree,
+	          data,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = chunk_hash_tree_update(
+	          NULL,
+	          data,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = chunk_hash_tree_update(
+	          chunk_hash_tree,
+	          NULL,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = chunk_hash_tree_compare_leaf_hash(
+	          chunk_hash_tree,
+	          2,
+	          ewf_test_tools_chunk_hash_tree_leaf_hash0,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = chunk_hash_tree_free(
+	          &chunk_hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_hash_tree",
+	 chunk_hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_hash_tree != NULL )
+	{
+		chunk_hash_tree_free(
+		 &chunk_hash_tree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the chunk_hash_tree_get_leaf_range function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_chunk_hash_tree_get_leaf_range(
+     void )
+{
+	chunk_hash_tree_t *chunk_hash_tree = NULL;
+	libcerror_error_t *error           = NULL;
+	off64_t leaf_offset                = 0;
+	size32_t leaf_data_size            = 0;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = chunk_hash_tree_initialize(
+	          &chunk_hash_tree,
+	          3,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_hash_tree",
+	 chunk_hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = chunk_hash_tree_get_leaf_range(
+	          chunk_hash_tree,
+	          1,
+	          &leaf_offset,
+	          &leaf_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "leaf_offset",
+	 (int64_t) leaf_offset,
+	 (int64_t) 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "leaf_data_size",
+	 (uint32_t) leaf_data_size,
+	 (uint32_t) 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = chunk_hash_tree_get_leaf_range(
+	          NULL,
+	          1,
+	          &leaf_offset,
+	          &leaf_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = chunk_hash_tree_get_leaf_range(
+	          chunk_hash_tree,
+	          2,
+	          &leaf_offset,
+	          &leaf_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = chunk_hash_tree_get_leaf_range(
+	          chunk_hash_tree,
+	          1,
+	          NULL,
+	          &leaf_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = chunk_hash_tree_free(
+	          &chunk_hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_hash_tree",
+	 chunk_hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_hash_tree != NULL )
+	{
+		chunk_hash_tree_free(
+		 &chunk_hash_tree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "chunk_hash_tree_calculate_leaf_size",
+	 ewf_test_tools_chunk_hash_tree_calculate_leaf_size );
+
+	EWF_TEST_RUN(
+	 "chunk_hash_tree_initialize",
+	 ewf_test_tools_chunk_hash_tree_initialize );
+
+	EWF_TEST_RUN(
+	 "chunk_hash_tree_free",
+	 ewf_test_tools_chunk_hash_tree_free );
+
+	EWF_TEST_RUN(
+	 "chunk_hash_tree_update",
+	 ewf_test_tools_chunk_hash_tree_update );
+
+	EWF_TEST_RUN(
+	 "chunk_hash_tree_get_leaf_range",
+	 ewf_test_tools_chunk_hash_tree_get_leaf_range );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
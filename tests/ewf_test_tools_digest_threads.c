@@ -0,0 +1,691 @@
+/*
+ * Tools digest_threads functions test program
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/digest_threads.h"
+#include "../ewftools/storage_media_buffer.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#define EWF_TEST_DIGEST_THREADS_NUMBER_OF_BUFFERS	8
+
+/* The test digest context
+ */
+typedef struct ewf_test_digest_context ewf_test_digest_context_t;
+
+struct ewf_test_digest_context
+{
+	/* The sum of the bytes
+	 */
+	uint64_t sum;
+
+	/* The first byte of every buffer in the order the buffers were digested
+	 */
+	uint8_t order[ EWF_TEST_DIGEST_THREADS_NUMBER_OF_BUFFERS ];
+
+	/* The number of buffers
+	 */
+	int number_of_buffers;
+};
+
+/* Updates the test digest
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_digest_update(
+     ewf_test_digest_context_t *context,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	size_t buffer_offset = 0;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( context->number_of_buffers < EWF_TEST_DIGEST_THREADS_NUMBER_OF_BUFFERS )
+	{
+		context->order[ context->number_of_buffers ] = buffer[ 0 ];
+	}
+	context->number_of_buffers += 1;
+
+	for( buffer_offset = 0;
+	     buffer_offset < buffer_size;
+	     buffer_offset++ )
+	{
+		context->sum += buffer[ buffer_offset ];
+	}
+	return( 1 );
+}
+
+/* Marks the buffers that were passed on by the digest threads
+ * The storage media offset of the buffer is used as its index
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_digest_threads_buffer_done(
+     storage_media_buffer_t *storage_media_buffer,
+     uint8_t *buffers_done )
+{
+	/* Only the thread of the last digest passes the buffer on
+	 */
+	buffers_done[ storage_media_buffer->storage_media_offset ] += 1;
+
+	return( 1 );
+}
+
+/* Tests the digest_threads_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_threads_initialize(
+     void )
+{
+	uint8_t buffers_done[ EWF_TEST_DIGEST_THREADS_NUMBER_OF_BUFFERS ];
+
+	digest_threads_t *digest_threads = NULL;
+	libcerror_error_t *error         = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = digest_threads_initialize(
+	          &digest_threads,
+	          4,
+	          (int (*)(storage_media_buffer_t *, void *)) &ewf_test_digest_threads_buffer_done,
+	          (void *) buffers_done,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_threads",
+	 digest_threads );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_threads_free(
+	          &digest_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_threads",
+	 digest_threads );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = digest_threads_initialize(
+	          NULL,
+	          4,
+	          (int (*)(storage_media_buffer_t *, void *)) &ewf_test_digest_threads_buffer_done,
+	          (void *) buffers_done,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	digest_threads = (digest_threads_t *) 0x12345678UL;
+
+	result = digest_threads_initialize(
+	          &digest_threads,
+	          4,
+	          (int (*)(storage_media_buffer_t *, void *)) &ewf_test_digest_threads_buffer_done,
+	          (void *) buffers_done,
+	          &error );
+
+	digest_threads = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_threads_initialize(
+	          &digest_threads,
+	          0,
+	          (int (*)(storage_media_buffer_t *, void *)) &ewf_test_digest_threads_buffer_done,
+	          (void *) buffers_done,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_threads",
+	 digest_threads );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_threads_initialize(
+	          &digest_threads,
+	          4,
+	          NULL,
+	          (void *) buffers_done,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_threads",
+	 digest_threads );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test digest_threads_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = digest_threads_initialize(
+		          &digest_threads,
+		          4,
+		          (int (*)(storage_media_buffer_t *, void *)) &ewf_test_digest_threads_buffer_done,
+		          (void *) buffers_done,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( digest_threads != NULL )
+			{
+				digest_threads_free(
+				 &digest_threads,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "digest_threads",
+			 digest_threads );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_threads != NULL )
+	{
+		digest_threads_free(
+		 &digest_threads,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_threads_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_threads_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = digest_threads_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_threads_push_buffer and digest_threads_join functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_threads_push_buffer(
+     void )
+{
+	storage_media_buffer_t *buffers[ EWF_TEST_DIGEST_THREADS_NUMBER_OF_BUFFERS ];
+	uint8_t buffers_done[ EWF_TEST_DIGEST_THREADS_NUMBER_OF_BUFFERS ];
+
+	ewf_test_digest_context_t first_context;
+	ewf_test_digest_context_t second_context;
+
+	digest_threads_t *digest_threads = NULL;
+	libcerror_error_t *error         = NULL;
+	int buffer_index                 = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 buffers,
+	 0,
+	 sizeof( storage_media_buffer_t * ) * EWF_TEST_DIGEST_THREADS_NUMBER_OF_BUFFERS );
+
+	memory_set(
+	 buffers_done,
+	 0,
+	 sizeof( uint8_t ) * EWF_TEST_DIGEST_THREADS_NUMBER_OF_BUFFERS );
+
+	memory_set(
+	 &first_context,
+	 0,
+	 sizeof( ewf_test_digest_context_t ) );
+
+	memory_set(
+	 &second_context,
+	 0,
+	 sizeof( ewf_test_digest_context_t ) );
+
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_DIGEST_THREADS_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		result = storage_media_buffer_initialize(
+		          &( buffers[ buffer_index ] ),
+		          NULL,
+		          STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+		          512,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		memory_set(
+		 buffers[ buffer_index ]->raw_buffer,
+		 buffer_index + 1,
+		 512 );
+
+		buffers[ buffer_index ]->storage_media_offset = (off64_t) buffer_index;
+		buffers[ buffer_index ]->raw_buffer_data_size = 512;
+	}
+	result = digest_threads_initialize(
+	          &digest_threads,
+	          EWF_TEST_DIGEST_THREADS_NUMBER_OF_BUFFERS,
+	          (int (*)(storage_media_buffer_t *, void *)) &ewf_test_digest_threads_buffer_done,
+	          (void *) buffers_done,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_threads_append_digest(
+	          digest_threads,
+	          (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &ewf_test_digest_update,
+	          (intptr_t *) &first_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_threads_append_digest(
+	          digest_threads,
+	          (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &ewf_test_digest_update,
+	          (intptr_t *) &second_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_DIGEST_THREADS_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		result = digest_threads_push_buffer(
+		          digest_threads,
+		          buffers[ buffer_index ],
+		          256,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = digest_threads_join(
+	          digest_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Every digest is updated with the first 256 bytes of every buffer in the order the buffers were pushed
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "first_context.sum",
+	 first_context.sum,
+	 (uint64_t) 256 * 36 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "second_context.sum",
+	 second_context.sum,
+	 (uint64_t) 256 * 36 );
+
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_DIGEST_THREADS_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "first_context.order",
+		 (int) first_context.order[ buffer_index ],
+		 buffer_index + 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "second_context.order",
+		 (int) second_context.order[ buffer_index ],
+		 buffer_index + 1 );
+
+		/* Every buffer is passed on once
+		 */
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "buffers_done",
+		 (int) buffers_done[ buffer_index ],
+		 1 );
+	}
+	/* Test error cases
+	 */
+	result = digest_threads_push_buffer(
+	          NULL,
+	          buffers[ 0 ],
+	          256,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_threads_push_buffer(
+	          digest_threads,
+	          NULL,
+	          256,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_threads_join(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = digest_threads_free(
+	          &digest_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_DIGEST_THREADS_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		result = storage_media_buffer_free(
+		          &( buffers[ buffer_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_threads != NULL )
+	{
+		digest_threads_free(
+		 &digest_threads,
+		 NULL );
+	}
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_DIGEST_THREADS_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		if( buffers[ buffer_index ] != NULL )
+		{
+			storage_media_buffer_free(
+			 &( buffers[ buffer_index ] ),
+			 NULL );
+		}
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "digest_threads_initialize",
+	 ewf_test_tools_digest_threads_initialize );
+
+	EWF_TEST_RUN(
+	 "digest_threads_free",
+	 ewf_test_tools_digest_threads_free );
+
+	EWF_TEST_RUN(
+	 "digest_threads_push_buffer",
+	 ewf_test_tools_digest_threads_push_buffer );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+}
+
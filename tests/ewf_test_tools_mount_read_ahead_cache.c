@@ -0,0 +1,1206 @@
+/*
+ * Tools mount_read_ahead_cache functions test program
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcthreads.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/mount_read_ahead_cache.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#define EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE		512
+#define EWF_TEST_MOUNT_READ_AHEAD_CACHE_NUMBER_OF_BLOCKS	8
+
+/* The media size is not a multiple of the block size so that the last block is partial
+ */
+#define EWF_TEST_MOUNT_READ_AHEAD_CACHE_MEDIA_SIZE		( ( 10 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE ) + 100 )
+
+/* Fills a buffer with the test data at a specific media offset
+ */
+void ewf_test_mount_read_ahead_cache_fill_buffer(
+      uint8_t *buffer,
+      size_t buffer_size,
+      off64_t media_offset )
+{
+	size_t buffer_index = 0;
+
+	for( buffer_index = 0;
+	     buffer_index < buffer_size;
+	     buffer_index++ )
+	{
+		buffer[ buffer_index ] = (uint8_t) ( ( media_offset + buffer_index ) % 251 );
+	}
+}
+
+/* Reads the data of a pending block from the test data
+ * Callback function for the read thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_mount_read_ahead_cache_read_block(
+     mount_read_ahead_cache_block_t *block,
+     mount_read_ahead_cache_t *read_ahead_cache )
+{
+	size_t data_size = 0;
+	int result       = 1;
+
+	data_size = read_ahead_cache->block_size;
+
+	if( ( (size64_t) block->offset + data_size ) > read_ahead_cache->media_size )
+	{
+		data_size = (size_t) ( read_ahead_cache->media_size - block->offset );
+	}
+	ewf_test_mount_read_ahead_cache_fill_buffer(
+	 block->data,
+	 data_size,
+	 block->offset );
+
+	if( libcthreads_mutex_grab(
+	     read_ahead_cache->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	block->data_size = data_size;
+	block->state     = MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_VALID;
+
+	if( libcthreads_condition_broadcast(
+	     read_ahead_cache->condition,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead_cache->mutex,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	return( result );
+}
+
+/* Creates a read-ahead cache that reads the test data instead of an image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_mount_read_ahead_cache_initialize(
+     mount_read_ahead_cache_t **read_ahead_cache,
+     libcerror_error_t **error )
+{
+	size_t blocks_size = 0;
+	int block_index    = 0;
+
+	*read_ahead_cache = memory_allocate_structure(
+	                     mount_read_ahead_cache_t );
+
+	if( *read_ahead_cache == NULL )
+	{
+		return( -1 );
+	}
+	if( memory_set(
+	     *read_ahead_cache,
+	     0,
+	     sizeof( mount_read_ahead_cache_t ) ) == NULL )
+	{
+		memory_free(
+		 *read_ahead_cache );
+
+		*read_ahead_cache = NULL;
+
+		return( -1 );
+	}
+	( *read_ahead_cache )->media_size                  = EWF_TEST_MOUNT_READ_AHEAD_CACHE_MEDIA_SIZE;
+	( *read_ahead_cache )->block_size                  = EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE;
+	( *read_ahead_cache )->number_of_blocks            = EWF_TEST_MOUNT_READ_AHEAD_CACHE_NUMBER_OF_BLOCKS;
+	( *read_ahead_cache )->number_of_read_ahead_blocks = EWF_TEST_MOUNT_READ_AHEAD_CACHE_NUMBER_OF_BLOCKS / 2;
+
+	blocks_size = sizeof( mount_read_ahead_cache_block_t ) * EWF_TEST_MOUNT_READ_AHEAD_CACHE_NUMBER_OF_BLOCKS;
+
+	( *read_ahead_cache )->blocks = (mount_read_ahead_cache_block_t *) memory_allocate(
+	                                                                    blocks_size );
+
+	if( ( *read_ahead_cache )->blocks == NULL )
+	{
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *read_ahead_cache )->blocks,
+	     0,
+	     blocks_size ) == NULL )
+	{
+		goto on_error;
+	}
+	( *read_ahead_cache )->blocks_data = (uint8_t *) memory_allocate(
+	                                                  EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE * EWF_TEST_MOUNT_READ_AHEAD_CACHE_NUMBER_OF_BLOCKS );
+
+	if( ( *read_ahead_cache )->blocks_data == NULL )
+	{
+		goto on_error;
+	}
+	for( block_index = 0;
+	     block_index < EWF_TEST_MOUNT_READ_AHEAD_CACHE_NUMBER_OF_BLOCKS;
+	     block_index++ )
+	{
+		( *read_ahead_cache )->blocks[ block_index ].data  = &( ( ( *read_ahead_cache )->blocks_data )[ EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE * block_index ] );
+		( *read_ahead_cache )->blocks[ block_index ].state = MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_EMPTY;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_ahead_cache )->mutex ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *read_ahead_cache )->condition ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *read_ahead_cache )->read_thread_pool ),
+	     NULL,
+	     1,
+	     EWF_TEST_MOUNT_READ_AHEAD_CACHE_NUMBER_OF_BLOCKS,
+	     (int (*)(intptr_t *, void *)) &ewf_test_mount_read_ahead_cache_read_block,
+	     (void *) *read_ahead_cache,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( ( *read_ahead_cache )->condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &( ( *read_ahead_cache )->condition ),
+		 NULL );
+	}
+	if( ( *read_ahead_cache )->mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( ( *read_ahead_cache )->mutex ),
+		 NULL );
+	}
+	if( ( *read_ahead_cache )->blocks_data != NULL )
+	{
+		memory_free(
+		 ( *read_ahead_cache )->blocks_data );
+	}
+	if( ( *read_ahead_cache )->blocks != NULL )
+	{
+		memory_free(
+		 ( *read_ahead_cache )->blocks );
+	}
+	memory_free(
+	 *read_ahead_cache );
+
+	*read_ahead_cache = NULL;
+
+	return( -1 );
+}
+
+/* Tests the mount_read_ahead_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_mount_read_ahead_cache_initialize(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	mount_read_ahead_cache_t *read_ahead_cache = NULL;
+	int result                                 = 0;
+
+	/* Test error cases
+	 * The regular cases require an open handle
+	 */
+	result = mount_read_ahead_cache_initialize(
+	          NULL,
+	          (libewf_handle_t *) 0x12345678UL,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_ahead_cache = (mount_read_ahead_cache_t *) 0x12345678UL;
+
+	result = mount_read_ahead_cache_initialize(
+	          &read_ahead_cache,
+	          (libewf_handle_t *) 0x12345678UL,
+	          1024 * 1024,
+	          &error );
+
+	read_ahead_cache = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = mount_read_ahead_cache_initialize(
+	          &read_ahead_cache,
+	          NULL,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_ahead_cache",
+	 read_ahead_cache );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = mount_read_ahead_cache_initialize(
+	          &read_ahead_cache,
+	          (libewf_handle_t *) 0x12345678UL,
+	          (size64_t) MOUNT_READ_AHEAD_CACHE_MAXIMUM_SIZE + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_ahead_cache",
+	 read_ahead_cache );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the mount_read_ahead_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_mount_read_ahead_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = mount_read_ahead_cache_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the mount_read_ahead_cache_read_block_callback function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_mount_read_ahead_cache_read_block_callback(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	mount_read_ahead_cache_block_t *block      = NULL;
+	mount_read_ahead_cache_t *read_ahead_cache = NULL;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_mount_read_ahead_cache_initialize(
+	          &read_ahead_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_ahead_cache",
+	 read_ahead_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * A block that is not read since abort was signalled is marked empty
+	 */
+	read_ahead_cache->abort = 1;
+
+	block = &( read_ahead_cache->blocks[ 0 ] );
+
+	block->offset    = 0;
+	block->data_size = EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE;
+	block->state     = MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_PENDING;
+
+	result = mount_read_ahead_cache_read_block_callback(
+	          block,
+	          read_ahead_cache );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "block->state",
+	 block->state,
+	 MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_EMPTY );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "block->data_size",
+	 block->data_size,
+	 (size_t) 0 );
+
+	/* Test error cases
+	 */
+	result = mount_read_ahead_cache_read_block_callback(
+	          NULL,
+	          read_ahead_cache );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = mount_read_ahead_cache_read_block_callback(
+	          block,
+	          NULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Clean up
+	 */
+	result = mount_read_ahead_cache_free(
+	          &read_ahead_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_ahead_cache",
+	 read_ahead_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_ahead_cache != NULL )
+	{
+		mount_read_ahead_cache_free(
+		 &read_ahead_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the mount_read_ahead_cache_schedule_blocks function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_mount_read_ahead_cache_schedule_blocks(
+     void )
+{
+	uint8_t buffer[ 4 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE ];
+
+	mount_read_ahead_stream_t read_ahead_stream;
+
+	libcerror_error_t *error                   = NULL;
+	mount_read_ahead_cache_block_t *block      = NULL;
+	mount_read_ahead_cache_t *read_ahead_cache = NULL;
+	ssize_t read_count                         = 0;
+	int block_index                            = 0;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_mount_read_ahead_cache_initialize(
+	          &read_ahead_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_ahead_cache",
+	 read_ahead_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_grab(
+	          read_ahead_cache->mutex,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	memory_set(
+	 &read_ahead_stream,
+	 0,
+	 sizeof( mount_read_ahead_stream_t ) );
+
+	result = mount_read_ahead_cache_schedule_blocks(
+	          read_ahead_cache,
+	          &read_ahead_stream,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "read_ahead_stream.read_ahead_offset",
+	 (int64_t) read_ahead_stream.read_ahead_offset,
+	 (int64_t) ( 4 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE ) );
+
+	/* Only the number of read-ahead blocks are scheduled
+	 */
+	for( block_index = 0;
+	     block_index < EWF_TEST_MOUNT_READ_AHEAD_CACHE_NUMBER_OF_BLOCKS;
+	     block_index++ )
+	{
+		block = &( read_ahead_cache->blocks[ block_index ] );
+
+		if( block_index < 4 )
+		{
+			EWF_TEST_ASSERT_EQUAL_INT64(
+			 "block->offset",
+			 (int64_t) block->offset,
+			 (int64_t) ( block_index * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE ) );
+
+			EWF_TEST_ASSERT_NOT_EQUAL_INT(
+			 "block->state",
+			 block->state,
+			 MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_EMPTY );
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "block->state",
+			 block->state,
+			 MOUNT_READ_AHEAD_CACHE_BLOCK_STATE_EMPTY );
+		}
+	}
+	/* The blocks already scheduled by the stream are not scheduled again
+	 */
+	result = mount_read_ahead_cache_schedule_blocks(
+	          read_ahead_cache,
+	          &read_ahead_stream,
+	          EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "read_ahead_stream.read_ahead_offset",
+	 (int64_t) read_ahead_stream.read_ahead_offset,
+	 (int64_t) ( 5 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE ) );
+
+	result = libcthreads_mutex_release(
+	          read_ahead_cache->mutex,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Wait for the scheduled blocks to be read
+	 */
+	memory_set(
+	 &read_ahead_stream,
+	 0,
+	 sizeof( mount_read_ahead_stream_t ) );
+
+	read_count = mount_read_ahead_cache_read_buffer_at_offset(
+	              read_ahead_cache,
+	              &read_ahead_stream,
+	              buffer,
+	              4 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) ( 4 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test scheduling up to the end of the media
+	 */
+	result = libcthreads_mutex_grab(
+	          read_ahead_cache->mutex,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 &read_ahead_stream,
+	 0,
+	 sizeof( mount_read_ahead_stream_t ) );
+
+	result = mount_read_ahead_cache_schedule_blocks(
+	          read_ahead_cache,
+	          &read_ahead_stream,
+	          9 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "read_ahead_stream.read_ahead_offset",
+	 (int64_t) read_ahead_stream.read_ahead_offset,
+	 (int64_t) EWF_TEST_MOUNT_READ_AHEAD_CACHE_MEDIA_SIZE );
+
+	/* Blocks 9 and 10 are stored in the blocks 1 and 2, block 3 is not reused
+	 */
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "block->offset",
+	 (int64_t) read_ahead_cache->blocks[ 1 ].offset,
+	 (int64_t) ( 9 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE ) );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "block->offset",
+	 (int64_t) read_ahead_cache->blocks[ 2 ].offset,
+	 (int64_t) ( 10 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE ) );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "block->offset",
+	 (int64_t) read_ahead_cache->blocks[ 3 ].offset,
+	 (int64_t) ( 3 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE ) );
+
+	/* Test error cases
+	 */
+	result = mount_read_ahead_cache_schedule_blocks(
+	          NULL,
+	          &read_ahead_stream,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = mount_read_ahead_cache_schedule_blocks(
+	          read_ahead_cache,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = mount_read_ahead_cache_schedule_blocks(
+	          read_ahead_cache,
+	          &read_ahead_stream,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_mutex_release(
+	          read_ahead_cache->mutex,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = mount_read_ahead_cache_free(
+	          &read_ahead_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_ahead_cache",
+	 read_ahead_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_ahead_cache != NULL )
+	{
+		mount_read_ahead_cache_free(
+		 &read_ahead_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the mount_read_ahead_cache_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_mount_read_ahead_cache_read_buffer_at_offset(
+     void )
+{
+	uint8_t buffer[ 4 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE ];
+	uint8_t expected_buffer[ 4 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE ];
+
+	mount_read_ahead_stream_t read_ahead_stream;
+
+	libcerror_error_t *error                   = NULL;
+	mount_read_ahead_cache_t *read_ahead_cache = NULL;
+	ssize_t read_count                         = 0;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_mount_read_ahead_cache_initialize(
+	          &read_ahead_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_ahead_cache",
+	 read_ahead_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 &read_ahead_stream,
+	 0,
+	 sizeof( mount_read_ahead_stream_t ) );
+
+	/* Test regular cases
+	 * The first read is not cached and does not schedule read-ahead
+	 */
+	read_count = mount_read_ahead_cache_read_buffer_at_offset(
+	              read_ahead_cache,
+	              &read_ahead_stream,
+	              buffer,
+	              EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The second sequential read schedules the following blocks
+	 * and waits for the pending block
+	 */
+	read_count = mount_read_ahead_cache_read_buffer_at_offset(
+	              read_ahead_cache,
+	              &read_ahead_stream,
+	              buffer,
+	              EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	              EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	ewf_test_mount_read_ahead_cache_fill_buffer(
+	 expected_buffer,
+	 EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	 EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE );
+
+	result = memory_compare(
+	          buffer,
+	          expected_buffer,
+	          EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "read_ahead_stream.read_ahead_offset",
+	 (int64_t) read_ahead_stream.read_ahead_offset,
+	 (int64_t) ( 5 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE ) );
+
+	/* A non-sequential read that is partially cached only returns the cached leading part
+	 * The blocks 3 and 4 are cached, block 5 is not
+	 */
+	read_count = mount_read_ahead_cache_read_buffer_at_offset(
+	              read_ahead_cache,
+	              &read_ahead_stream,
+	              buffer,
+	              4 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	              3 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) ( 2 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_ahead_stream.number_of_sequential_reads",
+	 read_ahead_stream.number_of_sequential_reads,
+	 0 );
+
+	ewf_test_mount_read_ahead_cache_fill_buffer(
+	 expected_buffer,
+	 2 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	 3 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE );
+
+	result = memory_compare(
+	          buffer,
+	          expected_buffer,
+	          2 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* A sequential read near the end of the media is limited by the media size
+	 */
+	read_ahead_stream.next_offset                = 9 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE;
+	read_ahead_stream.read_ahead_offset          = 0;
+	read_ahead_stream.number_of_sequential_reads = 1;
+
+	read_count = mount_read_ahead_cache_read_buffer_at_offset(
+	              read_ahead_cache,
+	              &read_ahead_stream,
+	              buffer,
+	              4 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	              9 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) ( EWF_TEST_MOUNT_READ_AHEAD_CACHE_MEDIA_SIZE - ( 9 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE ) ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "read_ahead_stream.read_ahead_offset",
+	 (int64_t) read_ahead_stream.read_ahead_offset,
+	 (int64_t) EWF_TEST_MOUNT_READ_AHEAD_CACHE_MEDIA_SIZE );
+
+	ewf_test_mount_read_ahead_cache_fill_buffer(
+	 expected_buffer,
+	 (size_t) read_count,
+	 9 * EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE );
+
+	result = memory_compare(
+	          buffer,
+	          expected_buffer,
+	          (size_t) read_count );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	read_count = mount_read_ahead_cache_read_buffer_at_offset(
+	              read_ahead_cache,
+	              &read_ahead_stream,
+	              buffer,
+	              EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	              EWF_TEST_MOUNT_READ_AHEAD_CACHE_MEDIA_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = mount_read_ahead_cache_read_buffer_at_offset(
+	              NULL,
+	              &read_ahead_stream,
+	              buffer,
+	              EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = mount_read_ahead_cache_read_buffer_at_offset(
+	              read_ahead_cache,
+	              NULL,
+	              buffer,
+	              EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = mount_read_ahead_cache_read_buffer_at_offset(
+	              read_ahead_cache,
+	              &read_ahead_stream,
+	              NULL,
+	              EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = mount_read_ahead_cache_read_buffer_at_offset(
+	              read_ahead_cache,
+	              &read_ahead_stream,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = mount_read_ahead_cache_read_buffer_at_offset(
+	              read_ahead_cache,
+	              &read_ahead_stream,
+	              buffer,
+	              EWF_TEST_MOUNT_READ_AHEAD_CACHE_BLOCK_SIZE,
+	              -1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = mount_read_ahead_cache_free(
+	          &read_ahead_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_ahead_cache",
+	 read_ahead_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_ahead_cache != NULL )
+	{
+		mount_read_ahead_cache_free(
+		 &read_ahead_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "mount_read_ahead_cache_initialize",
+	 ewf_test_tools_mount_read_ahead_cache_initialize );
+
+	EWF_TEST_RUN(
+	 "mount_read_ahead_cache_free",
+	 ewf_test_tools_mount_read_ahead_cache_free );
+
+	EWF_TEST_RUN(
+	 "mount_read_ahead_cache_read_block_callback",
+	 ewf_test_tools_mount_read_ahead_cache_read_block_callback );
+
+	EWF_TEST_RUN(
+	 "mount_read_ahead_cache_schedule_blocks",
+	 ewf_test_tools_mount_read_ahead_cache_schedule_blocks );
+
+	EWF_TEST_RUN(
+	 "mount_read_ahead_cache_read_buffer_at_offset",
+	 ewf_test_tools_mount_read_ahead_cache_read_buffer_at_offset );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+}
+
@@ -0,0 +1,644 @@
+/*
+ * Tools storage_media_buffer_queue functions test program
+ *
+ * Copyright (C) 2006-2022, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/storage_media_buffer.h"
+#include "../ewftools/storage_media_buffer_queue.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Tests the storage_media_buffer_queue_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_storage_media_buffer_queue_initialize(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	storage_media_buffer_queue_t *queue = NULL;
+	int result                          = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 2;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = storage_media_buffer_queue_initialize(
+	          &queue,
+	          NULL,
+	          5,
+	          STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "queue",
+	 queue );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The number of slots is rounded up to a power of 2
+	 */
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "queue->number_of_slots",
+	 queue->number_of_slots,
+	 (size_t) 8 );
+
+	result = storage_media_buffer_queue_free(
+	          &queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "queue",
+	 queue );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = storage_media_buffer_queue_initialize(
+	          NULL,
+	          NULL,
+	          5,
+	          STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	queue = (storage_media_buffer_queue_t *) 0x12345678UL;
+
+	result = storage_media_buffer_queue_initialize(
+	          &queue,
+	          NULL,
+	          5,
+	          STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+	          512,
+	          &error );
+
+	queue = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_queue_initialize(
+	          &queue,
+	          NULL,
+	          -1,
+	          STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "queue",
+	 queue );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test storage_media_buffer_queue_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = storage_media_buffer_queue_initialize(
+		          &queue,
+		          NULL,
+		          5,
+		          STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+		          512,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( queue != NULL )
+			{
+				storage_media_buffer_queue_free(
+				 &queue,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "queue",
+			 queue );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the storage_media_buffer_queue_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_storage_media_buffer_queue_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = storage_media_buffer_queue_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the storage_media_buffer_queue_grab_buffers and storage_media_buffer_queue_release_buffers functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_storage_media_buffer_queue_grab_buffers(
+     void )
+{
+	storage_media_buffer_t *buffers[ STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_BATCH_SIZE ];
+
+	libcerror_error_t *error            = NULL;
+	storage_media_buffer_t *buffer      = NULL;
+	storage_media_buffer_queue_t *queue = NULL;
+	int number_of_grabbed_buffers       = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = storage_media_buffer_queue_initialize(
+	          &queue,
+	          NULL,
+	          5,
+	          STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "queue",
+	 queue );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = storage_media_buffer_queue_grab_buffers(
+	          queue,
+	          buffers,
+	          STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_BATCH_SIZE,
+	          &number_of_grabbed_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_grabbed_buffers",
+	 number_of_grabbed_buffers,
+	 5 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_queue_release_buffers(
+	          queue,
+	          buffers,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_queue_release_buffer(
+	          queue,
+	          buffers[ 3 ],
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_queue_release_buffer(
+	          queue,
+	          buffers[ 4 ],
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The buffers are grabbed in the order they were released
+	 */
+	result = storage_media_buffer_queue_grab_buffer(
+	          queue,
+	          &buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer",
+	 (int) ( buffer == buffers[ 0 ] ),
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_queue_release_buffer(
+	          queue,
+	          buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = storage_media_buffer_queue_grab_buffers(
+	          NULL,
+	          buffers,
+	          1,
+	          &number_of_grabbed_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_queue_grab_buffers(
+	          queue,
+	          NULL,
+	          1,
+	          &number_of_grabbed_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_queue_grab_buffers(
+	          queue,
+	          buffers,
+	          0,
+	          &number_of_grabbed_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_queue_grab_buffers(
+	          queue,
+	          buffers,
+	          STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_BATCH_SIZE + 1,
+	          &number_of_grabbed_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_queue_grab_buffers(
+	          queue,
+	          buffers,
+	          1,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_queue_release_buffers(
+	          NULL,
+	          buffers,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_queue_release_buffers(
+	          queue,
+	          NULL,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_queue_release_buffer(
+	          queue,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = storage_media_buffer_queue_free(
+	          &queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "queue",
+	 queue );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "storage_media_buffer_queue_initialize",
+	 ewf_test_tools_storage_media_buffer_queue_initialize );
+
+	EWF_TEST_RUN(
+	 "storage_media_buffer_queue_free",
+	 ewf_test_tools_storage_media_buffer_queue_free );
+
+	EWF_TEST_RUN(
+	 "storage_media_buffer_queue_grab_buffers",
+	 ewf_test_tools_storage_media_buffer_queue_grab_buffers );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+}
+
@@ -22,6 +22,7 @@
 #include <common.h>
 #include <file_stream.h>
 #include <memory.h>
+#include <system_string.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -327,6 +328,87 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the verification_handle_set_number_of_reader_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_verification_handle_set_number_of_reader_threads(
+     verification_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = verification_handle_set_number_of_reader_threads(
+	          handle,
+	          _SYSTEM_STRING( "8" ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "handle->number_of_reader_threads",
+	 handle->number_of_reader_threads,
+	 8 );
+
+	result = verification_handle_set_number_of_reader_threads(
+	          handle,
+	          _SYSTEM_STRING( "64" ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "handle->number_of_reader_threads",
+	 handle->number_of_reader_threads,
+	 8 );
+
+	handle->number_of_reader_threads = 0;
+
+	/* Test error cases
+	 */
+	result = verification_handle_set_number_of_reader_threads(
+	          NULL,
+	          _SYSTEM_STRING( "8" ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -380,6 +462,11 @@ int main(
 	 ewf_test_tools_verification_handle_signal_abort,
 	 verification_handle );
 
+	EWF_TEST_RUN_WITH_ARGS(
+	 "verification_handle_set_number_of_reader_threads",
+	 ewf_test_tools_verification_handle_set_number_of_reader_threads,
+	 verification_handle );
+
 	/* Clean up
 	 */
 	result = verification_handle_free(